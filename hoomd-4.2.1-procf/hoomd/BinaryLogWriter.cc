@@ -0,0 +1,361 @@
+//~ ########## Created by the Rheoinformatic research group ##########
+//~ HOOMD-blue:
+// Copyright (c) 2009-2023 The Regents of the University of Michigan.
+// Part of HOOMD-blue, released under the BSD 3-Clause License.
+//~
+//~ This file:
+//~ Written by the Rheoinformatic research group (2026)
+
+// ########## Created by Rheoinformatic //~ [RHEOINF] ##########
+
+/*! \file BinaryLogWriter.cc
+    \brief Defines the BinaryLogWriter class
+*/
+
+#include "BinaryLogWriter.h"
+#include "Filesystem.h"
+
+#include <limits>
+#include <pybind11/numpy.h>
+#include <pybind11/stl.h>
+#include <stdexcept>
+#include <unistd.h>
+
+using namespace std;
+
+namespace hoomd
+    {
+namespace
+    {
+//! Magic bytes at the start of every binary log file
+const char BINARY_LOG_MAGIC[8] = {'H', 'O', 'O', 'M', 'D', 'B', 'L', 'G'};
+
+//! Version of the file layout
+const uint32_t BINARY_LOG_VERSION = 1;
+
+//! Append the bytes of a trivially copyable value
+template<class T> void appendValue(std::string& out, const T& value)
+    {
+    out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+typedef pybind11::array_t<double, pybind11::array::c_style | pybind11::array::forcecast>
+    double_array;
+    } // end anonymous namespace
+
+/*! \param sysdef System definition
+    \param trigger Select the timesteps to log
+    \param fname File name to write
+    \param logger hoomd.logging.Logger with scalar and sequence quantities
+    \param mode 'w' to overwrite \a fname, 'a' to append to it
+    \param buffer_size Number of rows buffered before a block is written
+
+    No file operations are attempted until the first block is written.
+*/
+BinaryLogWriter::BinaryLogWriter(std::shared_ptr<SystemDefinition> sysdef,
+                                 std::shared_ptr<Trigger> trigger,
+                                 const std::string& fname,
+                                 pybind11::object logger,
+                                 const std::string& mode,
+                                 unsigned int buffer_size)
+    : Analyzer(sysdef, trigger), m_fname(fname), m_logger(logger), m_mode(mode),
+      m_buffer_size(buffer_size)
+    {
+    m_exec_conf->msg->notice(5) << "Constructing BinaryLogWriter: " << fname << " " << mode
+                                << endl;
+    if (m_mode != "w" && m_mode != "a")
+        {
+        throw runtime_error("BinaryLog: invalid mode " + m_mode + ", use 'w' or 'a'.");
+        }
+    setBufferSize(buffer_size);
+    }
+
+BinaryLogWriter::~BinaryLogWriter()
+    {
+    m_exec_conf->msg->notice(5) << "Destroying BinaryLogWriter" << endl;
+    try
+        {
+        flush();
+        }
+    catch (const std::exception& e)
+        {
+        m_exec_conf->msg->error() << "BinaryLog: " << e.what() << endl;
+        }
+    }
+
+void BinaryLogWriter::setBufferSize(unsigned int buffer_size)
+    {
+    if (buffer_size == 0)
+        {
+        throw runtime_error("BinaryLog: buffer_size must be positive.");
+        }
+    m_buffer_size = buffer_size;
+    }
+
+/*! Quantities such as the pressure tensor are only valid when the flags are requested, as
+    hoomd.write.HDF5Log does.
+*/
+PDataFlags BinaryLogWriter::getRequestedPDataFlags()
+    {
+    PDataFlags flags(0);
+    flags[pdata_flag::pressure_tensor] = 1;
+    flags[pdata_flag::rotational_kinetic_energy] = 1;
+    flags[pdata_flag::external_field_virial] = 1;
+    return flags;
+    }
+
+/*! \param log Nested dictionary returned by Logger.log(), leaves are (value, category) tuples
+    \param prefix Namespace of \a log
+    \param entries Flattened (name, value) pairs, in the logger order
+*/
+void BinaryLogWriter::flattenLog(const pybind11::dict& log,
+                                 const std::string& prefix,
+                                 std::vector<std::pair<std::string, pybind11::object>>& entries)
+    {
+    for (auto item : log)
+        {
+        std::string name = pybind11::str(item.first);
+        if (!prefix.empty())
+            name = prefix + "/" + name;
+
+        if (pybind11::isinstance<pybind11::dict>(item.second))
+            {
+            flattenLog(pybind11::reinterpret_borrow<pybind11::dict>(item.second), name, entries);
+            }
+        else
+            {
+            pybind11::tuple leaf = pybind11::reinterpret_borrow<pybind11::tuple>(item.second);
+            entries.push_back(std::make_pair(name, pybind11::object(leaf[0])));
+            }
+        }
+    }
+
+/*! \param entries Quantities of the first row
+
+    The columns and their shapes are fixed by the first row.
+*/
+void BinaryLogWriter::initializeColumns(
+    const std::vector<std::pair<std::string, pybind11::object>>& entries)
+    {
+    for (const auto& entry : entries)
+        {
+        if (entry.second.is_none())
+            {
+            throw runtime_error("BinaryLog: " + entry.first + " is not available.");
+            }
+
+        double_array value = double_array::ensure(entry.second);
+        if (!value)
+            {
+            throw runtime_error("BinaryLog: " + entry.first + " is not numeric.");
+            }
+
+        std::vector<uint32_t> shape;
+        for (int d = 0; d < (int)value.ndim(); d++)
+            shape.push_back((uint32_t)value.shape(d));
+
+        m_names.push_back(entry.first);
+        m_shapes.push_back(shape);
+        m_widths.push_back((size_t)value.size());
+        m_columns.push_back(std::vector<double>());
+        m_columns.back().reserve(m_buffer_size * value.size());
+        }
+    m_timesteps.reserve(m_buffer_size);
+    }
+
+/*! \param timestep Current time step of the simulation
+ */
+void BinaryLogWriter::analyze(uint64_t timestep)
+    {
+    Analyzer::analyze(timestep);
+
+    // evaluate the quantities on all ranks, some of them reduce over the ranks
+    std::vector<std::pair<std::string, pybind11::object>> entries;
+    entries.reserve(m_names.size());
+    flattenLog(m_logger.attr("log")().cast<pybind11::dict>(), "", entries);
+
+    if (!m_exec_conf->isRoot())
+        return;
+
+    if (m_names.empty())
+        initializeColumns(entries);
+
+    if (entries.size() != m_names.size())
+        {
+        throw runtime_error("BinaryLog: the logged quantities cannot change within a file.");
+        }
+
+    for (size_t c = 0; c < m_names.size(); c++)
+        {
+        if (entries[c].first != m_names[c])
+            {
+            throw runtime_error("BinaryLog: the logged quantities cannot change within a file.");
+            }
+
+        std::vector<double>& column = m_columns[c];
+        if (entries[c].second.is_none())
+            {
+            column.insert(column.end(), m_widths[c], std::numeric_limits<double>::quiet_NaN());
+            continue;
+            }
+
+        double_array value = double_array::ensure(entries[c].second);
+        if (!value || (size_t)value.size() != m_widths[c])
+            {
+            throw runtime_error("BinaryLog: the shape of " + m_names[c] + " changed.");
+            }
+        column.insert(column.end(), value.data(), value.data() + m_widths[c]);
+        }
+    m_timesteps.push_back(timestep);
+
+    if (m_timesteps.size() >= m_buffer_size)
+        flush();
+    }
+
+std::string BinaryLogWriter::makeHeader() const
+    {
+    std::string header(BINARY_LOG_MAGIC, sizeof(BINARY_LOG_MAGIC));
+    appendValue(header, BINARY_LOG_VERSION);
+    appendValue(header, (uint32_t)m_names.size());
+    for (size_t c = 0; c < m_names.size(); c++)
+        {
+        appendValue(header, (uint32_t)m_names[c].size());
+        header.append(m_names[c]);
+        appendValue(header, (uint32_t)m_shapes[c].size());
+        for (uint32_t extent : m_shapes[c])
+            appendValue(header, extent);
+        }
+    return header;
+    }
+
+/*! \param in File to read the blocks from
+    \param header_size Size of the header in bytes
+    \param file_size Size of the file in bytes
+    \returns The end of the last complete block (header_size when there is none)
+*/
+uint64_t BinaryLogWriter::findEndOfBlocks(std::ifstream& in,
+                                          uint64_t header_size,
+                                          uint64_t file_size) const
+    {
+    uint64_t row_size = sizeof(uint64_t);
+    for (size_t width : m_widths)
+        row_size += width * sizeof(double);
+
+    uint64_t end = header_size;
+    while (file_size - end >= sizeof(uint64_t))
+        {
+        uint64_t n_rows = 0;
+        in.seekg(end);
+        in.read(reinterpret_cast<char*>(&n_rows), sizeof(uint64_t));
+        uint64_t remaining = file_size - end - sizeof(uint64_t);
+        if (!in.good() || n_rows > remaining / row_size)
+            break;
+        end += sizeof(uint64_t) + n_rows * row_size;
+        }
+    return end;
+    }
+
+/*! In append mode, the header of an existing (non-empty) file must match the logged quantities.
+    A truncated last block (e.g. from a run that was killed while writing) is cut off before
+    appending, readers would otherwise stop at it and miss the appended blocks.
+*/
+void BinaryLogWriter::openFile()
+    {
+    std::string header = makeHeader();
+
+    bool append = false;
+    if (m_mode == "a" && filesystem::exists(m_fname))
+        {
+        ifstream in(m_fname.c_str(), ios::in | ios::binary);
+        std::string existing(header.size(), '\0');
+        in.read(&existing[0], header.size());
+        if (in.gcount() > 0)
+            {
+            if ((size_t)in.gcount() != header.size() || existing != header)
+                {
+                throw runtime_error("BinaryLog: " + m_fname
+                                    + " logs different quantities, cannot append.");
+                }
+            append = true;
+
+            in.seekg(0, ios::end);
+            uint64_t file_size = (uint64_t)in.tellg();
+            uint64_t end = findEndOfBlocks(in, header.size(), file_size);
+            in.close();
+            if (end < file_size)
+                {
+                m_exec_conf->msg->warning()
+                    << "BinaryLog: removing " << file_size - end
+                    << " bytes of a truncated block at the end of " << m_fname << endl;
+                if (truncate(m_fname.c_str(), (off_t)end) != 0)
+                    {
+                    throw runtime_error("BinaryLog: error truncating " + m_fname);
+                    }
+                }
+            }
+        }
+
+    m_exec_conf->msg->notice(3) << "BinaryLog: " << (append ? "appending to " : "writing ")
+                                << m_fname << endl;
+    m_file.open(m_fname.c_str(), append ? (ios::out | ios::binary | ios::app)
+                                        : (ios::out | ios::binary | ios::trunc));
+    if (!m_file.good())
+        {
+        throw runtime_error("BinaryLog: error opening " + m_fname);
+        }
+    if (!append)
+        m_file.write(header.data(), header.size());
+    }
+
+/*! The buffered rows are written as one block: the number of rows, the timesteps, and each
+    column in turn.
+*/
+void BinaryLogWriter::flush()
+    {
+    if (!m_exec_conf->isRoot() || m_timesteps.empty())
+        return;
+
+    if (!m_file.is_open())
+        openFile();
+
+    uint64_t n_rows = m_timesteps.size();
+    m_file.write(reinterpret_cast<const char*>(&n_rows), sizeof(uint64_t));
+    m_file.write(reinterpret_cast<const char*>(m_timesteps.data()), n_rows * sizeof(uint64_t));
+    for (const std::vector<double>& column : m_columns)
+        m_file.write(reinterpret_cast<const char*>(column.data()), column.size() * sizeof(double));
+    m_file.flush();
+    if (!m_file.good())
+        {
+        throw runtime_error("BinaryLog: error writing to " + m_fname);
+        }
+
+    m_timesteps.clear();
+    for (std::vector<double>& column : m_columns)
+        column.clear();
+    }
+
+namespace detail
+    {
+void export_BinaryLogWriter(pybind11::module& m)
+    {
+    pybind11::class_<BinaryLogWriter, Analyzer, std::shared_ptr<BinaryLogWriter>>(
+        m,
+        "BinaryLogWriter")
+        .def(pybind11::init<std::shared_ptr<SystemDefinition>,
+                            std::shared_ptr<Trigger>,
+                            const std::string&,
+                            pybind11::object,
+                            const std::string&,
+                            unsigned int>())
+        .def("flush", &BinaryLogWriter::flush)
+        .def("getColumnNames", &BinaryLogWriter::getColumnNames)
+        .def_property_readonly("filename", &BinaryLogWriter::getFilename)
+        .def_property_readonly("mode", &BinaryLogWriter::getMode)
+        .def_property("buffer_size",
+                      &BinaryLogWriter::getBufferSize,
+                      &BinaryLogWriter::setBufferSize);
+    }
+
+    } // end namespace detail
+
+    } // end namespace hoomd
@@ -0,0 +1,138 @@
+//~ ########## Created by the Rheoinformatic research group ##########
+//~ HOOMD-blue:
+// Copyright (c) 2009-2023 The Regents of the University of Michigan.
+// Part of HOOMD-blue, released under the BSD 3-Clause License.
+//~
+//~ This file:
+//~ Written by the Rheoinformatic research group (2026)
+
+// ########## Created by Rheoinformatic //~ [RHEOINF] ##########
+
+/*! \file BinaryLogWriter.h
+    \brief Declares the BinaryLogWriter class
+
+    BinaryLogWriter writes the scalar and small array quantities of a hoomd.logging.Logger to a
+    columnar binary time series. Rows are buffered in memory and appended to the file as blocks,
+    so a row costs a copy of a few doubles instead of formatting text.
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include "Analyzer.h"
+
+#include <fstream>
+#include <memory>
+#include <pybind11/pybind11.h>
+#include <string>
+#include <vector>
+
+#ifndef __BINARY_LOG_WRITER_H__
+#define __BINARY_LOG_WRITER_H__
+
+namespace hoomd
+    {
+//! Writes logged quantities to a columnar binary file
+/*! The file layout (native byte order) is
+    - header: magic "HOOMDBLG", uint32 version, uint32 number of columns, then for each column a
+      uint32 name length, the name, a uint32 number of dimensions and the uint32 extent of each
+      dimension (no dimensions for scalars)
+    - blocks: uint64 number of rows n, the n uint64 timesteps, then for each column the n rows of
+      float64 values
+
+    Every rank evaluates the logger (some quantities reduce over the ranks), only the root rank
+    buffers and writes. A block is appended when the buffer holds buffer_size rows, on flush(), and
+    on destruction. Readers ignore a truncated last block, appending removes it.
+
+    \ingroup analyzers
+*/
+class PYBIND11_EXPORT BinaryLogWriter : public Analyzer
+    {
+    public:
+    //! Construct the writer
+    BinaryLogWriter(std::shared_ptr<SystemDefinition> sysdef,
+                    std::shared_ptr<Trigger> trigger,
+                    const std::string& fname,
+                    pybind11::object logger,
+                    const std::string& mode,
+                    unsigned int buffer_size);
+
+    //! Destructor
+    ~BinaryLogWriter();
+
+    //! Buffer one row of the logged quantities
+    virtual void analyze(uint64_t timestep);
+
+    //! Write the buffered rows to the file
+    void flush();
+
+    //! Request the optional fields that logged quantities commonly need
+    virtual PDataFlags getRequestedPDataFlags();
+
+    //! Get the file name
+    std::string getFilename() const
+        {
+        return m_fname;
+        }
+
+    //! Get the file open mode
+    std::string getMode() const
+        {
+        return m_mode;
+        }
+
+    //! Get the number of rows buffered before a block is written
+    unsigned int getBufferSize() const
+        {
+        return m_buffer_size;
+        }
+
+    //! Set the number of rows buffered before a block is written
+    void setBufferSize(unsigned int buffer_size);
+
+    //! Get the column names (empty before the first row)
+    std::vector<std::string> getColumnNames() const
+        {
+        return m_names;
+        }
+
+    private:
+    std::string m_fname;                         //!< File name
+    pybind11::object m_logger;                   //!< hoomd.logging.Logger
+    std::string m_mode;                          //!< 'w' to overwrite or 'a' to append
+    unsigned int m_buffer_size;                  //!< Rows buffered before a block is written
+    std::vector<std::string> m_names;            //!< Column names (namespace joined with '/')
+    std::vector<std::vector<uint32_t>> m_shapes; //!< Shape of each column (empty for scalars)
+    std::vector<size_t> m_widths;                //!< Values per row of each column
+    std::vector<uint64_t> m_timesteps;           //!< Buffered timesteps
+    std::vector<std::vector<double>> m_columns;  //!< Buffered values of each column
+    std::ofstream m_file;                        //!< Output file (root rank, opened on first block)
+
+    //! Flatten the nested log dictionary into (name, value) pairs
+    void flattenLog(const pybind11::dict& log,
+                    const std::string& prefix,
+                    std::vector<std::pair<std::string, pybind11::object>>& entries);
+
+    //! Set the columns from the first row
+    void initializeColumns(const std::vector<std::pair<std::string, pybind11::object>>& entries);
+
+    //! Open the file, writing the header or checking the header of the file appended to
+    void openFile();
+
+    //! Find the end of the last complete block of a file appended to
+    uint64_t findEndOfBlocks(std::ifstream& in, uint64_t header_size, uint64_t file_size) const;
+
+    //! Serialize the file header
+    std::string makeHeader() const;
+    };
+
+namespace detail
+    {
+//! Export BinaryLogWriter to python
+void export_BinaryLogWriter(pybind11::module& m);
+    } // end namespace detail
+
+    } // end namespace hoomd
+
+#endif // __BINARY_LOG_WRITER_H__
@@ -1,6 +1,8 @@
 // Copyright (c) 2009-2023 The Regents of the University of Michigan.
 // Part of HOOMD-blue, released under the BSD 3-Clause License.
 
+// ########## Modified by Rheoinformatic //~ [RHEOINF] ##########
+
 /*! \file CellList.cc
     \brief Defines CellList
 */
@@ -10,6 +12,13 @@
 
 #include <algorithm>
 
+//~ add multi-threaded cell list build [RHEOINF]
+#ifdef ENABLE_TBB
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#endif
+//~
+
 using namespace std;
 
 namespace hoomd
@@ -403,6 +412,14 @@ void CellList::initializeCellAdj()
 
 void CellList::computeCellList()
     {
+    //~ use the multi-threaded build when threads are available [RHEOINF]
+    if (m_exec_conf->getNumThreads() > 1)
+        {
+        computeCellListParallel(m_exec_conf->getNumThreads());
+        return;
+        }
+    //~
+
     // acquire the particle data
     ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
     ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(),
@@ -546,6 +563,239 @@ void CellList::computeCellList()
         }
     }
 
+//~ add multi-threaded cell list build [RHEOINF]
+/*! \param n_chunks Number of contiguous particle chunks (one per thread)
+
+    Counting sort in three passes:
+     1. bin the particles of each chunk and count them per cell (one row of m_chunk_count per chunk)
+     2. for every cell, turn the chunk counts into exclusive prefix sums and store the total in
+        cell_size
+     3. scatter the particles of each chunk, starting at its offset in each cell
+
+    Passes 1 and 3 run over chunks, pass 2 over cells. The result and the condition flags are
+    identical to the serial build.
+*/
+void CellList::computeCellListParallel(unsigned int n_chunks)
+    {
+    // acquire the particle data
+    ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(),
+                                       access_location::host,
+                                       access_mode::read);
+    ArrayHandle<Scalar> h_charge(m_pdata->getCharges(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_body(m_pdata->getBodies(),
+                                     access_location::host,
+                                     access_mode::read);
+    const BoxDim& box = m_pdata->getBox();
+
+    // access the cell list data arrays
+    ArrayHandle<unsigned int> h_cell_size(m_cell_size,
+                                          access_location::host,
+                                          access_mode::overwrite);
+    ArrayHandle<Scalar4> h_xyzf(m_xyzf, access_location::host, access_mode::overwrite);
+    ArrayHandle<Scalar4> h_cell_orientation(m_orientation,
+                                            access_location::host,
+                                            access_mode::overwrite);
+    ArrayHandle<unsigned int> h_cell_idx(m_idx, access_location::host, access_mode::overwrite);
+    ArrayHandle<uint2> h_type_body(m_type_body, access_location::host, access_mode::overwrite);
+
+    // shorthand copies of the indexers
+    const Index3D ci = m_cell_indexer;
+    const Index2D cli = m_cell_list_indexer;
+    const unsigned int n_cells = m_cell_indexer.getNumElements();
+    const unsigned int N = m_pdata->getN();
+    const unsigned int n_tot_particles = N + m_pdata->getNGhosts();
+    const Scalar3 ghost_width = getGhostWidth();
+    const uchar3 periodic = box.getPeriodic();
+    const uint3 dim = m_dim;
+    const unsigned int NOT_BINNED = 0xffffffff;
+
+    // don't use more chunks than particles
+    n_chunks = std::max(1u, std::min(n_chunks, n_tot_particles));
+    const unsigned int chunk_size = (n_tot_particles + n_chunks - 1) / n_chunks;
+
+    if (m_particle_bin.size() < n_tot_particles)
+        m_particle_bin.resize(n_tot_particles);
+    m_chunk_count.assign(size_t(n_chunks) * n_cells, 0);
+
+    // per chunk condition flags, combined with max() as the serial build would leave them
+    std::vector<uint3> chunk_conditions(n_chunks, make_uint3(0, 0, 0));
+
+    // pass 1: bin and count
+    auto bin_chunk = [&](unsigned int chunk)
+        {
+        unsigned int* count = &m_chunk_count[size_t(chunk) * n_cells];
+        uint3& conditions = chunk_conditions[chunk];
+        const unsigned int n_end = std::min(n_tot_particles, (chunk + 1) * chunk_size);
+        for (unsigned int n = chunk * chunk_size; n < n_end; n++)
+            {
+            m_particle_bin[n] = NOT_BINNED;
+
+            Scalar3 p = make_scalar3(h_pos.data[n].x, h_pos.data[n].y, h_pos.data[n].z);
+            if (std::isnan(p.x) || std::isnan(p.y) || std::isnan(p.z))
+                {
+                conditions.y = n + 1;
+                continue;
+                }
+
+            // find the bin each particle belongs in
+            Scalar3 f = box.makeFraction(p, ghost_width);
+            int ib = (int)(f.x * dim.x);
+            int jb = (int)(f.y * dim.y);
+            int kb = (int)(f.z * dim.z);
+
+            // check if the particle is inside the unit cell + ghost layer in all dimensions
+            if ((f.x < Scalar(-0.00001) || f.x >= Scalar(1.00001))
+                || (f.y < Scalar(-0.00001) || f.y >= Scalar(1.00001))
+                || (f.z < Scalar(-0.00001) || f.z >= Scalar(1.00001)))
+                {
+                // if a ghost particle is out of bounds, silently ignore it
+                if (n < N)
+                    conditions.z = n + 1;
+                continue;
+                }
+
+            // need to handle the case where the particle is exactly at the box hi
+            if (ib == (int)dim.x && periodic.x)
+                ib = 0;
+            if (jb == (int)dim.y && periodic.y)
+                jb = 0;
+            if (kb == (int)dim.z && periodic.z)
+                kb = 0;
+
+            // all particles should be in a valid cell
+            if (ib < 0 || ib >= (int)dim.x || jb < 0 || jb >= (int)dim.y || kb < 0
+                || kb >= (int)dim.z)
+                {
+                // but ghost particles that are out of range should not produce an error
+                if (n < N)
+                    conditions.z = n + 1;
+                continue;
+                }
+
+            unsigned int bin = ci(ib, jb, kb);
+            m_particle_bin[n] = bin;
+            count[bin]++;
+            }
+        };
+
+    // pass 2: exclusive prefix sum over the chunks of each cell
+    auto scan_cells = [&](unsigned int cell_begin, unsigned int cell_end)
+        {
+        for (unsigned int bin = cell_begin; bin < cell_end; bin++)
+            {
+            unsigned int total = 0;
+            for (unsigned int chunk = 0; chunk < n_chunks; chunk++)
+                {
+                unsigned int& c = m_chunk_count[size_t(chunk) * n_cells + bin];
+                unsigned int cur = c;
+                c = total;
+                total += cur;
+                }
+            h_cell_size.data[bin] = total;
+            }
+        };
+
+    // pass 3: scatter
+    auto scatter_chunk = [&](unsigned int chunk)
+        {
+        unsigned int* offsets = &m_chunk_count[size_t(chunk) * n_cells];
+        uint3& conditions = chunk_conditions[chunk];
+        const unsigned int n_end = std::min(n_tot_particles, (chunk + 1) * chunk_size);
+        for (unsigned int n = chunk * chunk_size; n < n_end; n++)
+            {
+            unsigned int bin = m_particle_bin[n];
+            if (bin == NOT_BINNED)
+                continue;
+
+            // setup the flag value to store
+            Scalar flag;
+            if (m_flag_charge)
+                flag = h_charge.data[n];
+            else if (m_flag_type)
+                flag = h_pos.data[n].w;
+            else
+                flag = __int_as_scalar(n);
+
+            unsigned int offset = offsets[bin]++;
+            if (offset < m_Nmax)
+                {
+                if (m_compute_xyzf)
+                    {
+                    h_xyzf.data[cli(offset, bin)]
+                        = make_scalar4(h_pos.data[n].x, h_pos.data[n].y, h_pos.data[n].z, flag);
+                    }
+
+                if (m_compute_type_body)
+                    {
+                    h_type_body.data[cli(offset, bin)]
+                        = make_uint2(__scalar_as_int(h_pos.data[n].w), h_body.data[n]);
+                    }
+
+                if (m_compute_orientation)
+                    {
+                    h_cell_orientation.data[cli(offset, bin)] = h_orientation.data[n];
+                    }
+
+                if (m_compute_idx)
+                    {
+                    h_cell_idx.data[cli(offset, bin)] = n;
+                    }
+                }
+            else
+                {
+                conditions.x = max((unsigned int)conditions.x, offset + 1);
+                }
+            }
+        };
+
+#ifdef ENABLE_TBB
+    m_exec_conf->getTaskArena()->execute(
+        [&]
+        {
+            tbb::parallel_for(tbb::blocked_range<unsigned int>(0, n_chunks, 1),
+                              [&](const tbb::blocked_range<unsigned int>& r)
+                              {
+                                  for (unsigned int chunk = r.begin(); chunk != r.end(); chunk++)
+                                      bin_chunk(chunk);
+                              });
+            tbb::parallel_for(tbb::blocked_range<unsigned int>(0, n_cells),
+                              [&](const tbb::blocked_range<unsigned int>& r)
+                              { scan_cells(r.begin(), r.end()); });
+            tbb::parallel_for(tbb::blocked_range<unsigned int>(0, n_chunks, 1),
+                              [&](const tbb::blocked_range<unsigned int>& r)
+                              {
+                                  for (unsigned int chunk = r.begin(); chunk != r.end(); chunk++)
+                                      scatter_chunk(chunk);
+                              });
+        });
+#else
+    for (unsigned int chunk = 0; chunk < n_chunks; chunk++)
+        bin_chunk(chunk);
+    scan_cells(0, n_cells);
+    for (unsigned int chunk = 0; chunk < n_chunks; chunk++)
+        scatter_chunk(chunk);
+#endif
+
+    // combine the condition flags
+    uint3 conditions = make_uint3(0, 0, 0);
+    for (unsigned int chunk = 0; chunk < n_chunks; chunk++)
+        {
+        conditions.x = max(conditions.x, chunk_conditions[chunk].x);
+        conditions.y = max(conditions.y, chunk_conditions[chunk].y);
+        conditions.z = max(conditions.z, chunk_conditions[chunk].z);
+        }
+
+        {
+        // write out conditions
+        ArrayHandle<uint3> h_conditions(m_conditions,
+                                        access_location::host,
+                                        access_mode::overwrite);
+        *h_conditions.data = conditions;
+        }
+    }
+//~
+
 bool CellList::checkConditions()
     {
     bool result = false;
@@ -1,6 +1,8 @@
 // Copyright (c) 2009-2023 The Regents of the University of Michigan.
 // Part of HOOMD-blue, released under the BSD 3-Clause License.
 
+// ########## Modified by Rheoinformatic //~ [RHEOINF] ##########
+
 #include "GlobalArray.h"
 #include "HOOMDMath.h"
 
@@ -9,6 +11,7 @@
 
 #include <hoomd/extern/nano-signal-slot/nano_signal_slot.hpp>
 #include <memory>
+#include <vector> //~ [RHEOINF]
 
 /*! \file CellList.h
     \brief Declares the CellList class
@@ -95,6 +98,15 @@ namespace hoomd
     Condition flags are to be set during the computeCellList() call and will be checked by compute()
    which will then take the appropriate action. If possible, flags 1 and 2 should be set to the
    index of the particle causing the flag plus 1.
+
+    //~ add multi-threaded cell list build [RHEOINF]
+    <b>Multi-threaded build:</b>
+    With TBB and more than one thread, the CPU build is a counting sort over contiguous chunks of
+   particles: each chunk bins its particles and counts them per cell, a prefix sum over the chunks
+   gives every chunk its write offset in each cell, and each chunk then scatters its particles.
+   Chunks are in particle order, so the members of each cell are stored in increasing particle
+   index exactly as in the serial build, and the condition flags take the same values.
+    //~
 */
 class PYBIND11_EXPORT CellList : public Compute
     {
@@ -414,6 +426,14 @@ class PYBIND11_EXPORT CellList : public Compute
     //! Compute the cell list
     virtual void computeCellList();
 
+    //~ add multi-threaded cell list build [RHEOINF]
+    std::vector<unsigned int> m_particle_bin; //!< Bin of each particle (or NOT_BINNED)
+    std::vector<unsigned int> m_chunk_count;  //!< Per chunk cell counts, then write offsets
+
+    //! Compute the cell list with a multi-threaded counting sort
+    void computeCellListParallel(unsigned int n_chunks);
+    //~
+
     //! Check the status of the conditions
     bool checkConditions();
 
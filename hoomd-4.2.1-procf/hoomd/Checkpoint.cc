@@ -0,0 +1,448 @@
+//~ ########## Created by the Rheoinformatic research group ##########
+//~ HOOMD-blue:
+// Copyright (c) 2009-2023 The Regents of the University of Michigan.
+// Part of HOOMD-blue, released under the BSD 3-Clause License.
+//~
+//~ This file:
+//~ Written by the Rheoinformatic research group (2026)
+
+// ########## Created by Rheoinformatic //~ [RHEOINF] ##########
+
+/*! \file Checkpoint.cc
+    \brief Defines the CheckpointFile class
+*/
+
+#include "Checkpoint.h"
+
+#ifdef ENABLE_MPI
+#include "DomainDecomposition.h"
+#endif
+
+#include <cstring>
+#include <fstream>
+#include <pybind11/stl.h>
+
+using namespace std;
+
+namespace hoomd
+    {
+namespace
+    {
+//! Magic bytes at the start of every checkpoint file
+const char CHECKPOINT_MAGIC[8] = {'H', 'O', 'O', 'M', 'D', 'C', 'K', 'P'};
+
+//! Version of the file layout
+const uint32_t CHECKPOINT_VERSION = 1;
+    } // end anonymous namespace
+
+/*! \param sysdef System definition to write from or restore into
+    \param fname File name (one file per rank)
+*/
+CheckpointFile::CheckpointFile(std::shared_ptr<SystemDefinition> sysdef, const std::string& fname)
+    : m_sysdef(sysdef), m_pdata(sysdef->getParticleData()),
+      m_exec_conf(sysdef->getParticleData()->getExecConf()), m_fname(fname), m_timestep(0)
+    {
+    }
+
+pybind11::bytes CheckpointFile::getSection(const std::string& name) const
+    {
+    auto it = m_sections.find(name);
+    if (it == m_sections.end())
+        {
+        throw std::runtime_error("Checkpoint " + m_fname + " has no section " + name + ".");
+        }
+    return pybind11::bytes(it->second);
+    }
+
+std::vector<std::string> CheckpointFile::getSectionNames() const
+    {
+    std::vector<std::string> names;
+    for (const auto& section : m_sections)
+        names.push_back(section.first);
+    return names;
+    }
+
+/*! \param particles Output vector, resized to the number of local particles
+ */
+void CheckpointFile::packParticles(std::vector<detail::pdata_element>& particles)
+    {
+    unsigned int N = m_pdata->getN();
+    particles.resize(N);
+
+    ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar4> h_vel(m_pdata->getVelocities(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar3> h_accel(m_pdata->getAccelerations(),
+                                 access_location::host,
+                                 access_mode::read);
+    ArrayHandle<Scalar> h_charge(m_pdata->getCharges(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar> h_diameter(m_pdata->getDiameters(),
+                                   access_location::host,
+                                   access_mode::read);
+    ArrayHandle<int3> h_image(m_pdata->getImages(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_body(m_pdata->getBodies(),
+                                     access_location::host,
+                                     access_mode::read);
+    ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(),
+                                       access_location::host,
+                                       access_mode::read);
+    ArrayHandle<Scalar4> h_angmom(m_pdata->getAngularMomentumArray(),
+                                  access_location::host,
+                                  access_mode::read);
+    ArrayHandle<Scalar3> h_inertia(m_pdata->getMomentsOfInertiaArray(),
+                                   access_location::host,
+                                   access_mode::read);
+    ArrayHandle<unsigned int> h_tag(m_pdata->getTags(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar4> h_net_force(m_pdata->getNetForce(),
+                                     access_location::host,
+                                     access_mode::read);
+    ArrayHandle<Scalar4> h_net_torque(m_pdata->getNetTorqueArray(),
+                                      access_location::host,
+                                      access_mode::read);
+    ArrayHandle<Scalar> h_net_virial(m_pdata->getNetVirial(),
+                                     access_location::host,
+                                     access_mode::read);
+    ArrayHandle<Scalar> h_net_virial_ind(m_pdata->getNetVirialInd(),
+                                         access_location::host,
+                                         access_mode::read);
+    size_t net_virial_pitch = m_pdata->getNetVirial().getPitch();
+    size_t net_virial_ind_pitch = m_pdata->getNetVirialInd().getPitch();
+
+    for (unsigned int i = 0; i < N; ++i)
+        {
+        detail::pdata_element& p = particles[i];
+        // zero the padding so that identical states give identical files
+        memset(&p, 0, sizeof(detail::pdata_element));
+        p.pos = h_pos.data[i];
+        p.vel = h_vel.data[i];
+        p.accel = h_accel.data[i];
+        p.charge = h_charge.data[i];
+        p.diameter = h_diameter.data[i];
+        p.image = h_image.data[i];
+        p.body = h_body.data[i];
+        p.orientation = h_orientation.data[i];
+        p.angmom = h_angmom.data[i];
+        p.inertia = h_inertia.data[i];
+        p.tag = h_tag.data[i];
+        p.net_force = h_net_force.data[i];
+        p.net_torque = h_net_torque.data[i];
+        for (unsigned int j = 0; j < 6; ++j)
+            p.net_virial[j] = h_net_virial.data[net_virial_pitch * j + i];
+        for (unsigned int j = 0; j < 5; ++j)
+            p.net_virial_ind[j] = h_net_virial_ind.data[net_virial_ind_pitch * j + i];
+        }
+    }
+
+/*! \param particles Particles to restore, in the local order they had when written
+
+    With domain decomposition the local particles are removed and the saved ones appended, which
+    keeps the saved order. Without it, the saved particles overwrite the arrays in place.
+*/
+void CheckpointFile::restoreParticles(const std::vector<detail::pdata_element>& particles)
+    {
+#ifdef ENABLE_MPI
+    if (m_sysdef->isDomainDecomposed())
+        {
+        m_pdata->removeAllGhostParticles();
+
+            {
+            ArrayHandle<unsigned int> h_comm_flags(m_pdata->getCommFlags(),
+                                                   access_location::host,
+                                                   access_mode::overwrite);
+            for (unsigned int i = 0; i < m_pdata->getN(); ++i)
+                h_comm_flags.data[i] = 1;
+            }
+
+        std::vector<detail::pdata_element> removed;
+        std::vector<unsigned int> comm_flags;
+        m_pdata->removeParticles(removed, comm_flags);
+        m_pdata->addParticles(particles);
+        return;
+        }
+#endif
+
+    unsigned int N = m_pdata->getN();
+    if (particles.size() != N)
+        {
+        throw std::runtime_error("Checkpoint " + m_fname + " holds "
+                                 + std::to_string(particles.size()) + " particles, the system has "
+                                 + std::to_string(N) + ".");
+        }
+
+        {
+        ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(),
+                                   access_location::host,
+                                   access_mode::overwrite);
+        ArrayHandle<Scalar4> h_vel(m_pdata->getVelocities(),
+                                   access_location::host,
+                                   access_mode::overwrite);
+        ArrayHandle<Scalar3> h_accel(m_pdata->getAccelerations(),
+                                     access_location::host,
+                                     access_mode::overwrite);
+        ArrayHandle<Scalar> h_charge(m_pdata->getCharges(),
+                                     access_location::host,
+                                     access_mode::overwrite);
+        ArrayHandle<Scalar> h_diameter(m_pdata->getDiameters(),
+                                       access_location::host,
+                                       access_mode::overwrite);
+        ArrayHandle<int3> h_image(m_pdata->getImages(),
+                                  access_location::host,
+                                  access_mode::overwrite);
+        ArrayHandle<unsigned int> h_body(m_pdata->getBodies(),
+                                         access_location::host,
+                                         access_mode::overwrite);
+        ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(),
+                                           access_location::host,
+                                           access_mode::overwrite);
+        ArrayHandle<Scalar4> h_angmom(m_pdata->getAngularMomentumArray(),
+                                      access_location::host,
+                                      access_mode::overwrite);
+        ArrayHandle<Scalar3> h_inertia(m_pdata->getMomentsOfInertiaArray(),
+                                       access_location::host,
+                                       access_mode::overwrite);
+        ArrayHandle<unsigned int> h_tag(m_pdata->getTags(),
+                                        access_location::host,
+                                        access_mode::overwrite);
+        ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(),
+                                         access_location::host,
+                                         access_mode::readwrite);
+        ArrayHandle<Scalar4> h_net_force(m_pdata->getNetForce(),
+                                         access_location::host,
+                                         access_mode::overwrite);
+        ArrayHandle<Scalar4> h_net_torque(m_pdata->getNetTorqueArray(),
+                                          access_location::host,
+                                          access_mode::overwrite);
+        ArrayHandle<Scalar> h_net_virial(m_pdata->getNetVirial(),
+                                         access_location::host,
+                                         access_mode::overwrite);
+        ArrayHandle<Scalar> h_net_virial_ind(m_pdata->getNetVirialInd(),
+                                             access_location::host,
+                                             access_mode::overwrite);
+        size_t net_virial_pitch = m_pdata->getNetVirial().getPitch();
+        size_t net_virial_ind_pitch = m_pdata->getNetVirialInd().getPitch();
+
+        for (unsigned int i = 0; i < N; ++i)
+            {
+            const detail::pdata_element& p = particles[i];
+            if (p.tag >= m_pdata->getRTags().getNumElements())
+                {
+                throw std::runtime_error("Checkpoint " + m_fname + " holds an invalid tag.");
+                }
+            h_pos.data[i] = p.pos;
+            h_vel.data[i] = p.vel;
+            h_accel.data[i] = p.accel;
+            h_charge.data[i] = p.charge;
+            h_diameter.data[i] = p.diameter;
+            h_image.data[i] = p.image;
+            h_body.data[i] = p.body;
+            h_orientation.data[i] = p.orientation;
+            h_angmom.data[i] = p.angmom;
+            h_inertia.data[i] = p.inertia;
+            h_tag.data[i] = p.tag;
+            h_rtag.data[p.tag] = i;
+            h_net_force.data[i] = p.net_force;
+            h_net_torque.data[i] = p.net_torque;
+            for (unsigned int j = 0; j < 6; ++j)
+                h_net_virial.data[net_virial_pitch * j + i] = p.net_virial[j];
+            for (unsigned int j = 0; j < 5; ++j)
+                h_net_virial_ind.data[net_virial_ind_pitch * j + i] = p.net_virial_ind[j];
+            }
+        }
+
+    // particle order changed: groups, force computes and neighbor lists rebuild their indices
+    m_pdata->notifyParticleSort();
+    }
+
+/*! \param timestep Current timestep
+ */
+void CheckpointFile::write(uint64_t timestep)
+    {
+    m_timestep = timestep;
+
+    std::vector<detail::pdata_element> particles;
+    packParticles(particles);
+
+    ofstream file(m_fname.c_str(), ios::out | ios::binary | ios::trunc);
+    if (!file.good())
+        {
+        throw std::runtime_error("Unable to open checkpoint file " + m_fname + " for writing.");
+        }
+
+    detail::CheckpointBuffer buf;
+    buf.writeArray(CHECKPOINT_MAGIC, 8);
+    buf.write(CHECKPOINT_VERSION);
+    buf.write((uint32_t)sizeof(Scalar));
+    buf.write((uint32_t)sizeof(detail::pdata_element));
+    buf.write((uint32_t)m_exec_conf->getRank());
+    buf.write((uint32_t)m_exec_conf->getNRanks());
+    buf.write(timestep);
+    buf.write((uint8_t)m_pdata->isAccelSet());
+
+    // the exact global box (tilt accumulated by BoxShearUpdater included)
+    const BoxDim& box = m_pdata->getGlobalBox();
+    buf.write(box.getL());
+    buf.write(box.getTiltFactorXY());
+    buf.write(box.getTiltFactorXZ());
+    buf.write(box.getTiltFactorYZ());
+
+    // domain boundaries, which the LoadBalancer may have moved
+    for (unsigned int dim = 0; dim < 3; ++dim)
+        {
+        std::vector<Scalar> cum_frac;
+#ifdef ENABLE_MPI
+        if (m_pdata->getDomainDecomposition())
+            cum_frac = m_pdata->getDomainDecomposition()->getCumulativeFractions(dim);
+#endif
+        buf.write((uint32_t)cum_frac.size());
+        buf.writeArray(cum_frac.data(), cum_frac.size());
+        }
+
+    buf.write((uint64_t)particles.size());
+    buf.writeArray(particles.data(), particles.size());
+
+    buf.write((uint32_t)m_sections.size());
+    for (const auto& section : m_sections)
+        {
+        buf.write((uint32_t)section.first.size());
+        buf.writeArray(section.first.data(), section.first.size());
+        buf.write((uint64_t)section.second.size());
+        buf.writeArray(section.second.data(), section.second.size());
+        }
+
+    file.write(buf.str().data(), buf.str().size());
+    file.close();
+    if (!file.good())
+        {
+        throw std::runtime_error("Error writing checkpoint file " + m_fname + ".");
+        }
+    }
+
+void CheckpointFile::read()
+    {
+    ifstream file(m_fname.c_str(), ios::in | ios::binary);
+    if (!file.good())
+        {
+        throw std::runtime_error("Unable to open checkpoint file " + m_fname + " for reading.");
+        }
+    std::string data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    detail::CheckpointBuffer buf(data);
+
+    char magic[8];
+    buf.readArray(magic, 8);
+    if (memcmp(magic, CHECKPOINT_MAGIC, 8) != 0)
+        {
+        throw std::runtime_error(m_fname + " is not a checkpoint file.");
+        }
+
+    uint32_t version, scalar_size, element_size, rank, n_ranks;
+    buf.read(version);
+    buf.read(scalar_size);
+    buf.read(element_size);
+    buf.read(rank);
+    buf.read(n_ranks);
+    if (version != CHECKPOINT_VERSION || scalar_size != sizeof(Scalar)
+        || element_size != sizeof(detail::pdata_element))
+        {
+        throw std::runtime_error("Checkpoint " + m_fname
+                                 + " was written by an incompatible build of HOOMD-blue.");
+        }
+    if (rank != m_exec_conf->getRank() || n_ranks != m_exec_conf->getNRanks())
+        {
+        throw std::runtime_error("Checkpoint " + m_fname + " was written by rank "
+                                 + std::to_string(rank) + " of " + std::to_string(n_ranks)
+                                 + " ranks, restart with the same number of ranks.");
+        }
+
+    buf.read(m_timestep);
+    uint8_t accel_set;
+    buf.read(accel_set);
+
+    Scalar3 L;
+    Scalar xy, xz, yz;
+    buf.read(L);
+    buf.read(xy);
+    buf.read(xz);
+    buf.read(yz);
+    BoxDim box(L);
+    box.setTiltFactors(xy, xz, yz);
+
+    std::vector<Scalar> cum_frac[3];
+    for (unsigned int dim = 0; dim < 3; ++dim)
+        {
+        uint32_t n;
+        buf.read(n);
+        cum_frac[dim].resize(n);
+        buf.readArray(cum_frac[dim].data(), n);
+        }
+
+    uint64_t N;
+    buf.read(N);
+    std::vector<detail::pdata_element> particles(N);
+    buf.readArray(particles.data(), N);
+
+    m_sections.clear();
+    uint32_t n_sections;
+    buf.read(n_sections);
+    for (uint32_t s = 0; s < n_sections; ++s)
+        {
+        uint32_t name_size;
+        buf.read(name_size);
+        std::string name(name_size, '\0');
+        buf.readArray(&name[0], name_size);
+        uint64_t size;
+        buf.read(size);
+        std::string section(size, '\0');
+        buf.readArray(&section[0], size);
+        m_sections[name] = section;
+        }
+
+#ifdef ENABLE_MPI
+    if (m_sysdef->isDomainDecomposed())
+        {
+        // bonded groups are owned by the rank of their particles and are not stored here
+        if (m_sysdef->getBondData()->getNGlobal() || m_sysdef->getAngleData()->getNGlobal()
+            || m_sysdef->getDihedralData()->getNGlobal()
+            || m_sysdef->getImproperData()->getNGlobal()
+            || m_sysdef->getConstraintData()->getNGlobal()
+            || m_sysdef->getPairData()->getNGlobal())
+            {
+            throw std::runtime_error(
+                "Checkpoints do not support bonded groups with domain decomposition.");
+            }
+
+        std::shared_ptr<DomainDecomposition> decomposition = m_pdata->getDomainDecomposition();
+        for (unsigned int dim = 0; dim < 3; ++dim)
+            {
+            if (cum_frac[dim].size() != decomposition->getCumulativeFractions(dim).size())
+                {
+                throw std::runtime_error("Checkpoint " + m_fname
+                                         + " was written with a different domain decomposition.");
+                }
+            decomposition->setCumulativeFractions(dim, cum_frac[dim], 0);
+            }
+        }
+#endif
+
+    // setting the global box also recomputes the local box from the restored fractions
+    m_pdata->setGlobalBox(box);
+    restoreParticles(particles);
+    if (accel_set)
+        m_pdata->notifyAccelSet();
+    }
+
+namespace detail
+    {
+void export_CheckpointFile(pybind11::module& m)
+    {
+    pybind11::class_<CheckpointFile, std::shared_ptr<CheckpointFile>>(m, "CheckpointFile")
+        .def(pybind11::init<std::shared_ptr<SystemDefinition>, const std::string&>())
+        .def("write", &CheckpointFile::write)
+        .def("read", &CheckpointFile::read)
+        .def("setSection", &CheckpointFile::setSection)
+        .def("getSection", &CheckpointFile::getSection)
+        .def("hasSection", &CheckpointFile::hasSection)
+        .def("getSectionNames", &CheckpointFile::getSectionNames)
+        .def("getTimestep", &CheckpointFile::getTimestep);
+    }
+    } // end namespace detail
+
+    } // end namespace hoomd
@@ -0,0 +1,169 @@
+//~ ########## Created by the Rheoinformatic research group ##########
+//~ HOOMD-blue:
+// Copyright (c) 2009-2023 The Regents of the University of Michigan.
+// Part of HOOMD-blue, released under the BSD 3-Clause License.
+//~
+//~ This file:
+//~ Written by the Rheoinformatic research group (2026)
+
+// ########## Created by Rheoinformatic //~ [RHEOINF] ##########
+
+/*! \file Checkpoint.h
+    \brief Declares the binary per-rank checkpoint file
+
+    A checkpoint stores, for every MPI rank, the local particles exactly as they sit in memory
+    (packed pdata_element records in local index order), the exact global box, the domain
+    decomposition boundaries, and a list of named sections. Each section holds the serialized
+    state of one object (a force compute, a neighbor list, ...). Restoring a checkpoint at the
+    same rank count puts every rank back into the same memory layout, so that the continued run
+    is bit-for-bit identical to the run that wrote it.
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include "ParticleData.h"
+#include "SystemDefinition.h"
+
+#include <map>
+#include <memory>
+#include <pybind11/pybind11.h>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#ifndef __CHECKPOINT_H__
+#define __CHECKPOINT_H__
+
+namespace hoomd
+    {
+namespace detail
+    {
+//! Byte stream used to serialize object state into a checkpoint section
+/*! Values are copied verbatim (native byte order), so a section can only be read back by a
+    build with the same Scalar precision on the same architecture. CheckpointFile checks both.
+*/
+class CheckpointBuffer
+    {
+    public:
+    //! Constructor for writing
+    CheckpointBuffer() : m_pos(0) { }
+
+    //! Constructor for reading
+    explicit CheckpointBuffer(const std::string& data) : m_data(data), m_pos(0) { }
+
+    //! Append a trivially copyable value
+    template<class T> void write(const T& value)
+        {
+        writeArray(&value, 1);
+        }
+
+    //! Append \a n trivially copyable values
+    template<class T> void writeArray(const T* data, size_t n)
+        {
+        m_data.append(reinterpret_cast<const char*>(data), n * sizeof(T));
+        }
+
+    //! Read a trivially copyable value
+    template<class T> void read(T& value)
+        {
+        readArray(&value, 1);
+        }
+
+    //! Read \a n trivially copyable values
+    template<class T> void readArray(T* data, size_t n)
+        {
+        size_t bytes = n * sizeof(T);
+        if (m_pos + bytes > m_data.size())
+            {
+            throw std::runtime_error("Checkpoint section is truncated.");
+            }
+        m_data.copy(reinterpret_cast<char*>(data), bytes, m_pos);
+        m_pos += bytes;
+        }
+
+    //! Get the serialized bytes
+    const std::string& str() const
+        {
+        return m_data;
+        }
+
+    private:
+    std::string m_data; //!< Serialized bytes
+    size_t m_pos;       //!< Read position
+    };
+
+    } // end namespace detail
+
+//! Binary checkpoint file written and read by every rank
+/*! The file layout is
+    - header: magic, version, sizeof(Scalar), sizeof(pdata_element), rank, number of ranks,
+      timestep, accel_set flag
+    - global box: L (3 Scalars) and tilt factors xy, xz, yz
+    - cumulative domain fractions in x, y and z (count followed by values)
+    - number of local particles followed by their pdata_element records in local order
+    - number of sections, each a name and a byte string
+
+    write() and read() are collective when the system is domain decomposed.
+*/
+class PYBIND11_EXPORT CheckpointFile
+    {
+    public:
+    //! Constructor
+    CheckpointFile(std::shared_ptr<SystemDefinition> sysdef, const std::string& fname);
+
+    //! Write the local state and all sections
+    void write(uint64_t timestep);
+
+    //! Read the file and restore the box, domain decomposition and local particles
+    void read();
+
+    //! Set the contents of a named section
+    void setSection(const std::string& name, pybind11::bytes data)
+        {
+        m_sections[name] = std::string(data);
+        }
+
+    //! Get the contents of a named section
+    pybind11::bytes getSection(const std::string& name) const;
+
+    //! Test if a named section is present
+    bool hasSection(const std::string& name) const
+        {
+        return m_sections.count(name) > 0;
+        }
+
+    //! Get the names of all sections
+    std::vector<std::string> getSectionNames() const;
+
+    //! Get the timestep stored in the file (valid after read())
+    uint64_t getTimestep() const
+        {
+        return m_timestep;
+        }
+
+    private:
+    std::shared_ptr<SystemDefinition> m_sysdef;        //!< System definition
+    std::shared_ptr<ParticleData> m_pdata;             //!< Particle data
+    std::shared_ptr<const ExecutionConfiguration> m_exec_conf; //!< Execution configuration
+    std::string m_fname;                               //!< File name
+    uint64_t m_timestep;                               //!< Timestep stored in the file
+    std::map<std::string, std::string> m_sections;     //!< Named object state
+
+    //! Pack all local particles in local index order
+    void packParticles(std::vector<detail::pdata_element>& particles);
+
+    //! Replace all local particles, keeping the given order
+    void restoreParticles(const std::vector<detail::pdata_element>& particles);
+    };
+
+namespace detail
+    {
+//! Export CheckpointFile to python
+void export_CheckpointFile(pybind11::module& m);
+    } // end namespace detail
+
+    } // end namespace hoomd
+
+#endif // __CHECKPOINT_H__
@@ -14,6 +14,7 @@
 
 #include <algorithm>
 #include <cstddef>
+#include <cstring> //~ [RHEOINF]
 #include <pybind11/stl.h>
 
 using namespace std;
@@ -1195,6 +1196,14 @@ Communicator::Communicator(std::shared_ptr<SystemDefinition> sysdef,
       m_tag_reverse(m_exec_conf), m_netforce_reverse_copybuf(m_exec_conf),
       m_netforce_reverse_recvbuf(m_exec_conf), m_r_ghost_max(Scalar(0.0)), m_ghosts_added(0),
       m_has_ghost_particles(false), m_last_flags(0), m_comm_pending(false),
+      m_overlap_ghost_update(false), //~ add ghost update overlap callbacks [RHEOINF]
+      m_compact_ghosts(false), m_ghost_velocity_float(false), //~ add compact ghost payloads [RHEOINF]
+      m_velocity_float_copybuf(m_exec_conf), m_velocity_float_recvbuf(m_exec_conf), //~ [RHEOINF]
+      //~ add neighborhood collective ghost updates [RHEOINF]
+      m_neighbor_collectives(false), m_nc_plan_valid(false), m_nc_request_valid(false),
+      m_nc_comm(MPI_COMM_NULL), m_nc_request(MPI_REQUEST_NULL), m_ghost_origin(m_exec_conf),
+      m_origin_copybuf(m_exec_conf), m_nc_record_size(0),
+      //~
       m_bond_comm(*this, m_sysdef->getBondData()), m_angle_comm(*this, m_sysdef->getAngleData()),
       m_dihedral_comm(*this, m_sysdef->getDihedralData()),
       m_improper_comm(*this, m_sysdef->getImproperData()),
@@ -1389,6 +1398,13 @@ Communicator::~Communicator()
         }
 
     MPI_Type_free(&m_mpi_pdata_element);
+
+    //~ add neighborhood collective ghost updates [RHEOINF]
+    if (m_nc_request != MPI_REQUEST_NULL)
+        MPI_Request_free(&m_nc_request);
+    if (m_nc_comm != MPI_COMM_NULL)
+        MPI_Comm_free(&m_nc_comm);
+    //~
     }
 
 void Communicator::updateMeshDefinition()
@@ -1526,11 +1542,34 @@ void Communicator::communicate(uint64_t timestep)
     m_flags = CommFlags(0);
     m_requested_flags.emit_accumulate([&](CommFlags f) { m_flags |= f; }, timestep);
 
+    bool migrate_request = false;
+    bool migrate_checked = false; //~ [RHEOINF]
     if (!m_force_migrate && !m_compute_callbacks.empty() && m_has_ghost_particles)
         {
+        //~ overlap the obligatory update if no compute callback moves local particles [RHEOINF]
+        // the distance check only reads local particles: if no compute callback moves them on this
+        // step, it can run first, so overlap subscribers know the neighbor list is still valid
+        if (!m_overlap_callbacks.empty())
+            {
+            bool callbacks_move = false;
+            m_compute_callbacks_move_particles.emit_accumulate(
+                [&](bool r) { callbacks_move = callbacks_move || r; },
+                timestep);
+            if (!callbacks_move)
+                {
+                m_migrate_requests.emit_accumulate(
+                    [&](bool r) { migrate_request = migrate_request || r; },
+                    timestep);
+                migrate_checked = true;
+                m_overlap_ghost_update = !migrate_request;
+                }
+            }
+        //~
+
         // do an obligatory update before determining whether to migrate
         beginUpdateGhosts(timestep);
         finishUpdateGhosts(timestep);
+        m_overlap_ghost_update = false; //~ [RHEOINF]
 
         // call subscribers after ghost update, but before distance check
         m_compute_callbacks.emit(timestep);
@@ -1539,8 +1578,7 @@ void Communicator::communicate(uint64_t timestep)
         // we will make sure that they are inside by doing a second migrate if necessary
         }
 
-    bool migrate_request = false;
-    if (!m_force_migrate)
+    if (!m_force_migrate && !migrate_checked) //~ skip a check that already ran [RHEOINF]
         {
         // distance check, may not be called directly after particle reorder (such as
         // due to SFCPackUpdater running before)
@@ -1553,9 +1591,13 @@ void Communicator::communicate(uint64_t timestep)
     // Update ghosts if we are not migrating
     if (!migrate && m_compute_callbacks.empty())
         {
+        //~ local particles are final at this point: let subscribers overlap with the update [RHEOINF]
+        m_overlap_ghost_update = !m_overlap_callbacks.empty();
+        //~
         beginUpdateGhosts(timestep);
 
         finishUpdateGhosts(timestep);
+        m_overlap_ghost_update = false; //~ [RHEOINF]
         }
 
     // Check if migration of particles is requested
@@ -1824,6 +1866,20 @@ void Communicator::exchangeGhosts()
     // resize and reset plans
     m_plan.resize(m_pdata->getN());
 
+    //~ every local particle is owned by this rank [RHEOINF]
+    m_nc_plan_valid = false;
+    if (m_neighbor_collectives)
+        {
+        m_ghost_origin.resize(m_pdata->getN());
+        ArrayHandle<unsigned int> h_ghost_origin(m_ghost_origin,
+                                                 access_location::host,
+                                                 access_mode::overwrite);
+        std::fill(h_ghost_origin.data,
+                  h_ghost_origin.data + m_pdata->getN(),
+                  m_exec_conf->getRank());
+        }
+    //~
+
         {
         ArrayHandle<unsigned int> h_plan(m_plan, access_location::host, access_mode::readwrite);
 
@@ -1966,6 +2022,32 @@ void Communicator::exchangeGhosts()
             m_orientation_copybuf.resize(max_copy_ghosts);
             }
 
+        //~ add compact ghost payloads [RHEOINF]
+        const bool compact = m_compact_ghosts && flags[comm_flag::position];
+        unsigned int n_charge_send = 0;
+        unsigned int n_diameter_send = 0;
+        //~
+
+        //~ forward the owning rank of every ghost [RHEOINF]
+        if (m_neighbor_collectives)
+            {
+            m_origin_copybuf.resize(max_copy_ghosts);
+            ArrayHandle<unsigned int> h_plan(m_plan, access_location::host, access_mode::read);
+            ArrayHandle<unsigned int> h_ghost_origin(m_ghost_origin,
+                                                     access_location::host,
+                                                     access_mode::read);
+            ArrayHandle<unsigned int> h_origin_copybuf(m_origin_copybuf,
+                                                       access_location::host,
+                                                       access_mode::overwrite);
+            unsigned int n_copy = 0;
+            for (unsigned int idx = 0; idx < max_copy_ghosts; idx++)
+                {
+                if (h_plan.data[idx] & (1 << dir))
+                    h_origin_copybuf.data[n_copy++] = h_ghost_origin.data[idx];
+                }
+            }
+        //~
+
             {
             // we fill all fields, but send only those that are requested by the CommFlags bitset
             ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(),
@@ -2048,7 +2130,30 @@ void Communicator::exchangeGhosts()
                     m_num_copy_ghosts[dir]++;
                     }
                 }
+
+            //~ send diameters and charges of types with a single value once per type [RHEOINF]
+            if (compact)
+                {
+                if (flags[comm_flag::charge])
+                    n_charge_send = packTypeConstantField(h_charge_copybuf.data,
+                                                          h_pos_copybuf.data,
+                                                          m_num_copy_ghosts[dir],
+                                                          m_charge_type_sendbuf);
+                if (flags[comm_flag::diameter])
+                    n_diameter_send = packTypeConstantField(h_diameter_copybuf.data,
+                                                            h_pos_copybuf.data,
+                                                            m_num_copy_ghosts[dir],
+                                                            m_diameter_type_sendbuf);
+                }
+            //~
             }
+        //~ without compaction, every ghost value is sent [RHEOINF]
+        if (!compact)
+            {
+            n_charge_send = m_num_copy_ghosts[dir];
+            n_diameter_send = m_num_copy_ghosts[dir];
+            }
+        //~
         unsigned int send_neighbor = m_decomposition->getNeighborRank(dir);
 
         // we receive from the direction opposite to the one we send to
@@ -2090,6 +2195,8 @@ void Communicator::exchangeGhosts()
 
         // resize plan array
         m_plan.resize(m_pdata->getN() + m_pdata->getNGhosts());
+        if (m_neighbor_collectives)
+            m_ghost_origin.resize(m_pdata->getN() + m_pdata->getNGhosts()); //~ [RHEOINF]
 
             // exchange particle data, write directly to the particle data arrays
             {
@@ -2207,8 +2314,31 @@ void Communicator::exchangeGhosts()
 
             if (flags[comm_flag::charge])
                 {
+                //~ add compact ghost payloads [RHEOINF]
+                if (compact)
+                    {
+                    m_charge_type_recvbuf.resize(m_charge_type_sendbuf.size());
+                    MPI_Isend(m_charge_type_sendbuf.data(),
+                              int(m_charge_type_sendbuf.size() * sizeof(Scalar)),
+                              MPI_BYTE,
+                              send_neighbor,
+                              10,
+                              m_mpi_comm,
+                              &req);
+                    m_reqs.push_back(req);
+                    MPI_Irecv(m_charge_type_recvbuf.data(),
+                              int(m_charge_type_recvbuf.size() * sizeof(Scalar)),
+                              MPI_BYTE,
+                              recv_neighbor,
+                              10,
+                              m_mpi_comm,
+                              &req);
+                    m_reqs.push_back(req);
+                    }
+                //~
                 MPI_Isend(h_charge_copybuf.data,
-                          int(m_num_copy_ghosts[dir] * sizeof(Scalar)),
+                          /*int(m_num_copy_ghosts[dir] * sizeof(Scalar)),*/
+                          int(n_charge_send * sizeof(Scalar)), //~ [RHEOINF]
                           MPI_BYTE,
                           send_neighbor,
                           4,
@@ -2227,8 +2357,31 @@ void Communicator::exchangeGhosts()
 
             if (flags[comm_flag::diameter])
                 {
+                //~ add compact ghost payloads [RHEOINF]
+                if (compact)
+                    {
+                    m_diameter_type_recvbuf.resize(m_diameter_type_sendbuf.size());
+                    MPI_Isend(m_diameter_type_sendbuf.data(),
+                              int(m_diameter_type_sendbuf.size() * sizeof(Scalar)),
+                              MPI_BYTE,
+                              send_neighbor,
+                              11,
+                              m_mpi_comm,
+                              &req);
+                    m_reqs.push_back(req);
+                    MPI_Irecv(m_diameter_type_recvbuf.data(),
+                              int(m_diameter_type_recvbuf.size() * sizeof(Scalar)),
+                              MPI_BYTE,
+                              recv_neighbor,
+                              11,
+                              m_mpi_comm,
+                              &req);
+                    m_reqs.push_back(req);
+                    }
+                //~
                 MPI_Isend(h_diameter_copybuf.data,
-                          int(m_num_copy_ghosts[dir] * sizeof(Scalar)),
+                          /*int(m_num_copy_ghosts[dir] * sizeof(Scalar)),*/
+                          int(n_diameter_send * sizeof(Scalar)), //~ [RHEOINF]
                           MPI_BYTE,
                           send_neighbor,
                           5,
@@ -2325,8 +2478,52 @@ void Communicator::exchangeGhosts()
                 m_reqs.push_back(req);
                 }
 
+            //~ add neighborhood collective ghost updates [RHEOINF]
+            if (m_neighbor_collectives)
+                {
+                ArrayHandle<unsigned int> h_origin_copybuf(m_origin_copybuf,
+                                                           access_location::host,
+                                                           access_mode::read);
+                ArrayHandle<unsigned int> h_ghost_origin(m_ghost_origin,
+                                                         access_location::host,
+                                                         access_mode::readwrite);
+                MPI_Isend(h_origin_copybuf.data,
+                          int(m_num_copy_ghosts[dir] * sizeof(unsigned int)),
+                          MPI_BYTE,
+                          send_neighbor,
+                          12,
+                          m_mpi_comm,
+                          &req);
+                m_reqs.push_back(req);
+                MPI_Irecv(h_ghost_origin.data + start_idx,
+                          int(m_num_recv_ghosts[dir] * sizeof(unsigned int)),
+                          MPI_BYTE,
+                          recv_neighbor,
+                          12,
+                          m_mpi_comm,
+                          &req);
+                m_reqs.push_back(req);
+                }
+            //~
+
             m_stats.resize(m_reqs.size());
             MPI_Waitall((unsigned int)m_reqs.size(), &m_reqs.front(), &m_stats.front());
+
+            //~ restore the per type values of the received ghosts [RHEOINF]
+            if (compact)
+                {
+                if (flags[comm_flag::charge])
+                    unpackTypeConstantField(h_charge.data + start_idx,
+                                            h_pos.data + start_idx,
+                                            m_num_recv_ghosts[dir],
+                                            m_charge_type_recvbuf);
+                if (flags[comm_flag::diameter])
+                    unpackTypeConstantField(h_diameter.data + start_idx,
+                                            h_pos.data + start_idx,
+                                            m_num_recv_ghosts[dir],
+                                            m_diameter_type_recvbuf);
+                }
+            //~
             }
 
         // wrap particle positions
@@ -2381,6 +2578,11 @@ void Communicator::exchangeGhosts()
 
     m_ghosts_added = m_pdata->getNGhosts();
 
+    //~ register the ghosts with their owners for the per step collective [RHEOINF]
+    if (m_neighbor_collectives)
+        setupNeighborCollectiveGhosts();
+    //~
+
     // exchange ghost constraints along with ghost particles
     m_constraint_comm.exchangeGhostGroups(m_plan, mask);
 
@@ -2656,10 +2858,28 @@ void Communicator::beginUpdateGhosts(uint64_t timestep)
     // to send to neighboring processors
     m_exec_conf->msg->notice(7) << "Communicator: update ghosts" << std::endl;
 
+    //~ add neighborhood collective ghost updates [RHEOINF]
+    if (m_neighbor_collectives && m_nc_plan_valid)
+        {
+        updateGhostsNeighborCollective(timestep);
+        return;
+        }
+    //~
+
     // update data in these arrays
 
     unsigned int num_tot_recv_ghosts = 0; // total number of ghosts received
 
+    //~ count the stages for the overlap callbacks [RHEOINF]
+    unsigned int n_stages = 0;
+    for (unsigned int dir = 0; dir < 6; dir++)
+        {
+        if (isCommunicating(dir))
+            n_stages++;
+        }
+    unsigned int stage = 0;
+    //~
+
     for (unsigned int dir = 0; dir < 6; dir++)
         {
         if (!isCommunicating(dir))
@@ -2709,6 +2929,25 @@ void Communicator::beginUpdateGhosts(uint64_t timestep)
                                              access_location::host,
                                              access_mode::read);
 
+            //~ add single precision ghost velocities [RHEOINF]
+            if (m_ghost_velocity_float)
+                {
+                if (m_velocity_float_copybuf.size() < m_num_copy_ghosts[dir])
+                    m_velocity_float_copybuf.resize(m_num_copy_ghosts[dir]);
+                ArrayHandle<float3> h_velocity_float_copybuf(m_velocity_float_copybuf,
+                                                             access_location::host,
+                                                             access_mode::overwrite);
+                for (unsigned int ghost_idx = 0; ghost_idx < m_num_copy_ghosts[dir];
+                     ghost_idx++)
+                    {
+                    unsigned int idx = h_rtag.data[h_copy_ghosts.data[ghost_idx]];
+                    const Scalar4& v = h_vel.data[idx];
+                    h_velocity_float_copybuf.data[ghost_idx]
+                        = make_float3(float(v.x), float(v.y), float(v.z));
+                    }
+                }
+            else
+            //~
             // copy velocity of ghost particles
             for (unsigned int ghost_idx = 0; ghost_idx < m_num_copy_ghosts[dir]; ghost_idx++)
                 {
@@ -2763,12 +3002,18 @@ void Communicator::beginUpdateGhosts(uint64_t timestep)
 
         num_tot_recv_ghosts += m_num_recv_ghosts[dir];
 
+        //~ post all fields of this direction, then wait once (optionally overlapping) [RHEOINF]
+        m_reqs.clear();
+        //~
+
         // only non-permanent fields (position, velocity, orientation) need to be considered here
         // charge, body, image and diameter are not updated between neighbor list builds
         if (flags[comm_flag::position])
             {
-            m_reqs.resize(2);
-            m_stats.resize(2);
+            /*m_reqs.resize(2);
+            m_stats.resize(2);*/
+            size_t req = m_reqs.size(); //~ [RHEOINF]
+            m_reqs.resize(req + 2);     //~ [RHEOINF]
 
             ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(),
                                        access_location::host,
@@ -2784,21 +3029,55 @@ void Communicator::beginUpdateGhosts(uint64_t timestep)
                       send_neighbor,
                       1,
                       m_mpi_comm,
-                      &m_reqs[0]);
+                      &m_reqs[req]); //~ [RHEOINF]
             MPI_Irecv(h_pos.data + start_idx,
                       (unsigned int)(m_num_recv_ghosts[dir] * sizeof(Scalar4)),
                       MPI_BYTE,
                       recv_neighbor,
                       1,
                       m_mpi_comm,
-                      &m_reqs[1]);
-            MPI_Waitall(2, &m_reqs.front(), &m_stats.front());
+                      &m_reqs[req + 1]); //~ [RHEOINF]
+            /*MPI_Waitall(2, &m_reqs.front(), &m_stats.front());*/
             }
 
+        //~ add single precision ghost velocities [RHEOINF]
+        if (flags[comm_flag::velocity] && m_ghost_velocity_float)
+            {
+            size_t req = m_reqs.size();
+            m_reqs.resize(req + 2);
+
+            if (m_velocity_float_recvbuf.size() < m_num_recv_ghosts[dir])
+                m_velocity_float_recvbuf.resize(m_num_recv_ghosts[dir]);
+            ArrayHandle<float3> h_velocity_float_copybuf(m_velocity_float_copybuf,
+                                                         access_location::host,
+                                                         access_mode::read);
+            ArrayHandle<float3> h_velocity_float_recvbuf(m_velocity_float_recvbuf,
+                                                         access_location::host,
+                                                         access_mode::overwrite);
+
+            MPI_Isend(h_velocity_float_copybuf.data,
+                      (unsigned int)(m_num_copy_ghosts[dir] * sizeof(float3)),
+                      MPI_BYTE,
+                      send_neighbor,
+                      2,
+                      m_mpi_comm,
+                      &m_reqs[req]);
+            MPI_Irecv(h_velocity_float_recvbuf.data,
+                      (unsigned int)(m_num_recv_ghosts[dir] * sizeof(float3)),
+                      MPI_BYTE,
+                      recv_neighbor,
+                      2,
+                      m_mpi_comm,
+                      &m_reqs[req + 1]);
+            }
+        else
+        //~
         if (flags[comm_flag::velocity])
             {
-            m_reqs.resize(2);
-            m_stats.resize(2);
+            /*m_reqs.resize(2);
+            m_stats.resize(2);*/
+            size_t req = m_reqs.size(); //~ [RHEOINF]
+            m_reqs.resize(req + 2);     //~ [RHEOINF]
 
             ArrayHandle<Scalar4> h_vel(m_pdata->getVelocities(),
                                        access_location::host,
@@ -2814,21 +3093,23 @@ void Communicator::beginUpdateGhosts(uint64_t timestep)
                       send_neighbor,
                       2,
                       m_mpi_comm,
-                      &m_reqs[0]);
+                      &m_reqs[req]); //~ [RHEOINF]
             MPI_Irecv(h_vel.data + start_idx,
                       (unsigned int)(m_num_recv_ghosts[dir] * sizeof(Scalar4)),
                       MPI_BYTE,
                       recv_neighbor,
                       2,
                       m_mpi_comm,
-                      &m_reqs[1]);
-            MPI_Waitall(2, &m_reqs.front(), &m_stats.front());
+                      &m_reqs[req + 1]); //~ [RHEOINF]
+            /*MPI_Waitall(2, &m_reqs.front(), &m_stats.front());*/
             }
 
         if (flags[comm_flag::orientation])
             {
-            m_reqs.resize(2);
-            m_stats.resize(2);
+            /*m_reqs.resize(2);
+            m_stats.resize(2);*/
+            size_t req = m_reqs.size(); //~ [RHEOINF]
+            m_reqs.resize(req + 2);     //~ [RHEOINF]
 
             ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(),
                                                access_location::host,
@@ -2844,16 +3125,48 @@ void Communicator::beginUpdateGhosts(uint64_t timestep)
                       send_neighbor,
                       3,
                       m_mpi_comm,
-                      &m_reqs[0]);
+                      &m_reqs[req]); //~ [RHEOINF]
             MPI_Irecv(h_orientation.data + start_idx,
                       (unsigned int)(m_num_recv_ghosts[dir] * sizeof(Scalar4)),
                       MPI_BYTE,
                       recv_neighbor,
                       3,
                       m_mpi_comm,
-                      &m_reqs[1]);
-            MPI_Waitall(2, &m_reqs.front(), &m_stats.front());
+                      &m_reqs[req + 1]); //~ [RHEOINF]
+            /*MPI_Waitall(2, &m_reqs.front(), &m_stats.front());*/
+            }
+
+        //~ overlap computation on local particles with the transfers, then wait [RHEOINF]
+        if (m_overlap_ghost_update)
+            m_overlap_callbacks.emit(timestep, stage, n_stages);
+        stage++;
+
+        if (!m_reqs.empty())
+            {
+            m_stats.resize(m_reqs.size());
+            MPI_Waitall((unsigned int)m_reqs.size(), &m_reqs.front(), &m_stats.front());
             }
+        //~
+
+        //~ unpack single precision ghost velocities, keeping the mass sent with the ghosts [RHEOINF]
+        if (flags[comm_flag::velocity] && m_ghost_velocity_float)
+            {
+            ArrayHandle<Scalar4> h_vel(m_pdata->getVelocities(),
+                                       access_location::host,
+                                       access_mode::readwrite);
+            ArrayHandle<float3> h_velocity_float_recvbuf(m_velocity_float_recvbuf,
+                                                         access_location::host,
+                                                         access_mode::read);
+            for (unsigned int ghost_idx = 0; ghost_idx < m_num_recv_ghosts[dir]; ghost_idx++)
+                {
+                const float3& v = h_velocity_float_recvbuf.data[ghost_idx];
+                Scalar4& vel = h_vel.data[start_idx + ghost_idx];
+                vel.x = Scalar(v.x);
+                vel.y = Scalar(v.y);
+                vel.z = Scalar(v.z);
+                }
+            }
+        //~
 
         // wrap particle positions (only if copying positions)
         //~ and update the velocity for particles wrapped across y-boundary [RHEOINF]
@@ -2884,6 +3197,393 @@ void Communicator::beginUpdateGhosts(uint64_t timestep)
         } // end dir loop
     }
 
+//~ add compact ghost payloads [RHEOINF]
+/*! \param values Field values of the ghosts to send, compacted in place
+    \param postype Positions and types of the same ghosts
+    \param n Number of ghosts
+    \param type_table Output: for every type, its value and a flag (1) if its ghosts differ
+    \returns The number of values left in \a values (those of the flagged types, in order)
+*/
+unsigned int Communicator::packTypeConstantField(Scalar* values,
+                                                 const Scalar4* postype,
+                                                 unsigned int n,
+                                                 std::vector<Scalar>& type_table)
+    {
+    const unsigned int n_types = m_pdata->getNTypes();
+    type_table.assign(2 * n_types, Scalar(0.0));
+    std::vector<char> seen(n_types, 0);
+
+    for (unsigned int i = 0; i < n; ++i)
+        {
+        const unsigned int type = __scalar_as_int(postype[i].w);
+        if (!seen[type])
+            {
+            seen[type] = 1;
+            type_table[2 * type] = values[i];
+            }
+        else if (values[i] != type_table[2 * type])
+            {
+            type_table[2 * type + 1] = Scalar(1.0);
+            }
+        }
+
+    unsigned int n_packed = 0;
+    for (unsigned int i = 0; i < n; ++i)
+        {
+        const unsigned int type = __scalar_as_int(postype[i].w);
+        if (type_table[2 * type + 1] != Scalar(0.0))
+            values[n_packed++] = values[i];
+        }
+    return n_packed;
+    }
+
+/*! \param values Received field values: the packed values on input, one value per ghost on output
+    \param postype Positions and types of the received ghosts
+    \param n Number of received ghosts
+    \param type_table Table received from packTypeConstantField() on the sending rank
+
+    The packed values are expanded back to front so that no value is overwritten before it is read.
+*/
+void Communicator::unpackTypeConstantField(Scalar* values,
+                                           const Scalar4* postype,
+                                           unsigned int n,
+                                           const std::vector<Scalar>& type_table)
+    {
+    unsigned int n_packed = 0;
+    for (unsigned int i = 0; i < n; ++i)
+        {
+        const unsigned int type = __scalar_as_int(postype[i].w);
+        if (type_table[2 * type + 1] != Scalar(0.0))
+            n_packed++;
+        }
+
+    for (unsigned int i = n; i-- > 0;)
+        {
+        const unsigned int type = __scalar_as_int(postype[i].w);
+        if (type_table[2 * type + 1] != Scalar(0.0))
+            values[i] = values[--n_packed];
+        else
+            values[i] = type_table[2 * type];
+        }
+    }
+//~
+
+//~ add neighborhood collective ghost updates [RHEOINF]
+/*! \param neighbor_collectives True to update ghosts with a neighborhood collective
+
+    The direct plan is built at the next ghost exchange; until then the ghosts are updated
+    direction by direction.
+*/
+void Communicator::setNeighborCollectives(bool neighbor_collectives)
+    {
+#if MPI_VERSION >= 3
+    if (neighbor_collectives != m_neighbor_collectives)
+        {
+        m_neighbor_collectives = neighbor_collectives;
+        m_nc_plan_valid = false;
+        if (m_neighbor_collectives)
+            forceMigrate();
+        }
+#else
+    if (neighbor_collectives)
+        {
+        m_exec_conf->msg->warning()
+            << "Neighborhood collectives require MPI 3, ghosts are updated direction by direction"
+            << std::endl;
+        }
+#endif
+    }
+
+/*! Called at the end of exchangeGhosts(). Ghosts are grouped by their owning rank (a neighbor
+    in the distributed graph); each rank then sends to every owner the tags of the ghosts it holds
+    from it, and the owner stores these tags in the same order. After
+    this, a ghost update is one MPI_Neighbor_alltoallv of packed records.
+*/
+void Communicator::setupNeighborCollectiveGhosts()
+    {
+#if MPI_VERSION >= 3
+    if (m_nc_comm == MPI_COMM_NULL)
+        {
+        // symmetric graph of the unique neighbor ranks (the domain grid is periodic)
+        ArrayHandle<unsigned int> h_unique_neighbors(m_unique_neighbors,
+                                                     access_location::host,
+                                                     access_mode::read);
+        std::vector<int> neighbors(m_n_unique_neigh);
+        m_nc_slot.clear();
+        for (unsigned int ineigh = 0; ineigh < m_n_unique_neigh; ineigh++)
+            {
+            neighbors[ineigh] = int(h_unique_neighbors.data[ineigh]);
+            m_nc_slot[h_unique_neighbors.data[ineigh]] = int(ineigh);
+            }
+        MPI_Dist_graph_create_adjacent(m_mpi_comm,
+                                       int(m_n_unique_neigh),
+                                       neighbors.data(),
+                                       MPI_UNWEIGHTED,
+                                       int(m_n_unique_neigh),
+                                       neighbors.data(),
+                                       MPI_UNWEIGHTED,
+                                       MPI_INFO_NULL,
+                                       0,
+                                       &m_nc_comm);
+        }
+
+    const unsigned int N = m_pdata->getN();
+    const unsigned int n_ghosts = m_pdata->getNGhosts();
+    const unsigned int n_neigh = m_n_unique_neigh;
+
+    // group the ghosts by owner (counting sort)
+    m_nc_recv_counts.assign(n_neigh, 0);
+    m_nc_recv_displs.assign(n_neigh, 0);
+    m_nc_recv_idx.resize(n_ghosts);
+    std::vector<unsigned int> request_tags(n_ghosts);
+        {
+        ArrayHandle<unsigned int> h_ghost_origin(m_ghost_origin,
+                                                 access_location::host,
+                                                 access_mode::read);
+        ArrayHandle<unsigned int> h_tag(m_pdata->getTags(),
+                                        access_location::host,
+                                        access_mode::read);
+
+        std::vector<int> slot(n_ghosts);
+        for (unsigned int g = 0; g < n_ghosts; g++)
+            {
+            auto it = m_nc_slot.find(h_ghost_origin.data[N + g]);
+            if (it == m_nc_slot.end())
+                {
+                throw std::runtime_error("Communicator: ghost owner is not a neighbor rank.");
+                }
+            slot[g] = it->second;
+            m_nc_recv_counts[slot[g]]++;
+            }
+        for (unsigned int ineigh = 1; ineigh < n_neigh; ineigh++)
+            m_nc_recv_displs[ineigh] = m_nc_recv_displs[ineigh - 1] + m_nc_recv_counts[ineigh - 1];
+
+        std::vector<int> offset(m_nc_recv_displs);
+        for (unsigned int g = 0; g < n_ghosts; g++)
+            {
+            const int k = offset[slot[g]]++;
+            m_nc_recv_idx[k] = N + g;
+            request_tags[k] = h_tag.data[N + g];
+            }
+        }
+
+    // tell every owner how many and which particles to send
+    m_nc_send_counts.assign(n_neigh, 0);
+    m_nc_send_displs.assign(n_neigh, 0);
+    MPI_Neighbor_alltoall(m_nc_recv_counts.data(),
+                          1,
+                          MPI_INT,
+                          m_nc_send_counts.data(),
+                          1,
+                          MPI_INT,
+                          m_nc_comm);
+    for (unsigned int ineigh = 1; ineigh < n_neigh; ineigh++)
+        m_nc_send_displs[ineigh] = m_nc_send_displs[ineigh - 1] + m_nc_send_counts[ineigh - 1];
+    const unsigned int n_send
+        = n_neigh ? m_nc_send_displs[n_neigh - 1] + m_nc_send_counts[n_neigh - 1] : 0;
+
+    m_nc_send_tags.resize(n_send);
+    MPI_Neighbor_alltoallv(request_tags.data(),
+                           m_nc_recv_counts.data(),
+                           m_nc_recv_displs.data(),
+                           MPI_UNSIGNED,
+                           m_nc_send_tags.data(),
+                           m_nc_send_counts.data(),
+                           m_nc_send_displs.data(),
+                           MPI_UNSIGNED,
+                           m_nc_comm);
+
+    m_nc_plan_valid = true;
+    m_nc_request_valid = false;
+#endif
+    }
+
+/*! \param timestep Current time step
+
+    Packs position, velocity and orientation (as requested by the flags) of the particles in
+    m_nc_send_tags into one record per ghost, exchanges the records with a single neighborhood
+    collective and unpacks them into the ghost slots. Received positions are wrapped into the
+    shifted box once, which gives the same position (and y-image velocity correction) as the
+    direction by direction update.
+*/
+void Communicator::updateGhostsNeighborCollective(uint64_t timestep)
+    {
+#if MPI_VERSION >= 3
+    CommFlags flags = getFlags();
+    const bool float_vel = m_ghost_velocity_float;
+    const size_t pos_size = flags[comm_flag::position] ? sizeof(Scalar4) : 0;
+    const size_t vel_size
+        = flags[comm_flag::velocity] ? (float_vel ? sizeof(float3) : sizeof(Scalar4)) : 0;
+    const size_t orientation_size = flags[comm_flag::orientation] ? sizeof(Scalar4) : 0;
+    const unsigned int record_size = (unsigned int)(pos_size + vel_size + orientation_size);
+
+    if (record_size == 0)
+        {
+        if (m_overlap_ghost_update)
+            m_overlap_callbacks.emit(timestep, 0, 1);
+        return;
+        }
+
+    const unsigned int n_neigh = m_n_unique_neigh;
+    const size_t n_send = m_nc_send_tags.size();
+    const size_t n_recv = m_nc_recv_idx.size();
+
+    // (re)build the byte counts and the persistent request when the plan or the record changed
+    if (!m_nc_request_valid || record_size != m_nc_record_size)
+        {
+        if (m_nc_request != MPI_REQUEST_NULL)
+            MPI_Request_free(&m_nc_request);
+
+        m_nc_sendbuf.resize(n_send * record_size);
+        m_nc_recvbuf.resize(n_recv * record_size);
+        m_nc_send_bytes.resize(n_neigh);
+        m_nc_send_byte_displs.resize(n_neigh);
+        m_nc_recv_bytes.resize(n_neigh);
+        m_nc_recv_byte_displs.resize(n_neigh);
+        for (unsigned int ineigh = 0; ineigh < n_neigh; ineigh++)
+            {
+            m_nc_send_bytes[ineigh] = m_nc_send_counts[ineigh] * int(record_size);
+            m_nc_send_byte_displs[ineigh] = m_nc_send_displs[ineigh] * int(record_size);
+            m_nc_recv_bytes[ineigh] = m_nc_recv_counts[ineigh] * int(record_size);
+            m_nc_recv_byte_displs[ineigh] = m_nc_recv_displs[ineigh] * int(record_size);
+            }
+
+#if MPI_VERSION >= 4
+        MPI_Neighbor_alltoallv_init(m_nc_sendbuf.data(),
+                                    m_nc_send_bytes.data(),
+                                    m_nc_send_byte_displs.data(),
+                                    MPI_BYTE,
+                                    m_nc_recvbuf.data(),
+                                    m_nc_recv_bytes.data(),
+                                    m_nc_recv_byte_displs.data(),
+                                    MPI_BYTE,
+                                    m_nc_comm,
+                                    MPI_INFO_NULL,
+                                    &m_nc_request);
+#endif
+        m_nc_record_size = record_size;
+        m_nc_request_valid = true;
+        }
+
+        // pack the records
+        {
+        ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(),
+                                         access_location::host,
+                                         access_mode::read);
+        ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(),
+                                   access_location::host,
+                                   access_mode::read);
+        ArrayHandle<Scalar4> h_vel(m_pdata->getVelocities(),
+                                   access_location::host,
+                                   access_mode::read);
+        ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(),
+                                           access_location::host,
+                                           access_mode::read);
+        for (size_t k = 0; k < n_send; k++)
+            {
+            // look up by tag, the local order may change between ghost exchanges
+            const unsigned int idx = h_rtag.data[m_nc_send_tags[k]];
+            assert(idx < m_pdata->getN());
+            char* record = m_nc_sendbuf.data() + k * record_size;
+            if (pos_size)
+                {
+                memcpy(record, &h_pos.data[idx], pos_size);
+                record += pos_size;
+                }
+            if (vel_size)
+                {
+                if (float_vel)
+                    {
+                    const Scalar4& v = h_vel.data[idx];
+                    float3 vf = make_float3(float(v.x), float(v.y), float(v.z));
+                    memcpy(record, &vf, vel_size);
+                    }
+                else
+                    {
+                    memcpy(record, &h_vel.data[idx], vel_size);
+                    }
+                record += vel_size;
+                }
+            if (orientation_size)
+                memcpy(record, &h_orientation.data[idx], orientation_size);
+            }
+        }
+
+#if MPI_VERSION >= 4
+    MPI_Start(&m_nc_request);
+#else
+    MPI_Ineighbor_alltoallv(m_nc_sendbuf.data(),
+                            m_nc_send_bytes.data(),
+                            m_nc_send_byte_displs.data(),
+                            MPI_BYTE,
+                            m_nc_recvbuf.data(),
+                            m_nc_recv_bytes.data(),
+                            m_nc_recv_byte_displs.data(),
+                            MPI_BYTE,
+                            m_nc_comm,
+                            &m_nc_request);
+#endif
+
+    // local particles are final: run the getGhostUpdateOverlapSignal() slots during the collective
+    if (m_overlap_ghost_update)
+        m_overlap_callbacks.emit(timestep, 0, 1);
+
+    MPI_Wait(&m_nc_request, MPI_STATUS_IGNORE);
+
+        // unpack into the ghost slots
+        {
+        ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(),
+                                   access_location::host,
+                                   access_mode::readwrite);
+        ArrayHandle<Scalar4> h_vel(m_pdata->getVelocities(),
+                                   access_location::host,
+                                   access_mode::readwrite);
+        ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(),
+                                           access_location::host,
+                                           access_mode::readwrite);
+        const BoxDim shifted_box = getShiftedBox();
+        for (size_t k = 0; k < n_recv; k++)
+            {
+            const unsigned int idx = m_nc_recv_idx[k];
+            const char* record = m_nc_recvbuf.data() + k * record_size;
+            if (pos_size)
+                {
+                memcpy(&h_pos.data[idx], record, pos_size);
+                record += pos_size;
+                }
+            if (vel_size)
+                {
+                if (float_vel)
+                    {
+                    float3 vf;
+                    memcpy(&vf, record, vel_size);
+                    h_vel.data[idx].x = Scalar(vf.x);
+                    h_vel.data[idx].y = Scalar(vf.y);
+                    h_vel.data[idx].z = Scalar(vf.z);
+                    }
+                else
+                    {
+                    memcpy(&h_vel.data[idx], record, vel_size);
+                    }
+                record += vel_size;
+                }
+            if (orientation_size)
+                memcpy(&h_orientation.data[idx], record, orientation_size);
+
+            // wrap particles received across a global boundary
+            //~ and update the velocity of particles wrapped across the y-boundary [RHEOINF]
+            if (pos_size)
+                {
+                int3 img = make_int3(0, 0, 0);
+                shifted_box.wrap(h_pos.data[idx], img);
+                h_vel.data[idx].x -= (img.y * m_SR);
+                }
+            }
+        }
+#endif
+    }
+//~
+
 void Communicator::updateNetForce(uint64_t timestep)
     {
     CommFlags flags = getFlags();
@@ -3551,7 +4251,18 @@ void export_Communicator(pybind11::module& m)
         .def(pybind11::init<std::shared_ptr<SystemDefinition>,
                             std::shared_ptr<DomainDecomposition>>())
         .def("addMeshDefinition", &Communicator::addMeshDefinition)
-        .def_property_readonly("domain_decomposition", &Communicator::getDomainDecomposition);
+        .def_property_readonly("domain_decomposition", &Communicator::getDomainDecomposition)
+        //~ add compact ghost payloads [RHEOINF]
+        .def_property("compact_ghosts",
+                      &Communicator::getCompactGhosts,
+                      &Communicator::setCompactGhosts)
+        .def_property("ghost_velocity_float",
+                      &Communicator::getGhostVelocityFloat,
+                      &Communicator::setGhostVelocityFloat)
+        .def_property("neighbor_collectives",
+                      &Communicator::getNeighborCollectives,
+                      &Communicator::setNeighborCollectives);
+        //~
     }
     } // end namespace detail
 
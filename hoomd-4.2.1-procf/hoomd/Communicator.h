@@ -22,6 +22,7 @@
 #include "ParticleData.h"
 
 #include <hoomd/extern/nano-signal-slot/nano_signal_slot.hpp>
+#include <map>    //~ [RHEOINF]
 #include <memory>
 
 #ifndef __HIPCC__
@@ -234,6 +235,41 @@ class PYBIND11_EXPORT Communicator
         return m_compute_callbacks;
         }
 
+    //~ add ghost update overlap callbacks [RHEOINF]
+    //! Subscribe to call-backs that overlap computation with the ghost update
+    /*!
+     * On steps without particle migration, the CPU ghost update emits this signal once per
+     * communicating direction, after that direction's non-blocking sends and receives are posted
+     * and before they are waited on. Subscribers may read (but not write) the data of local
+     * particles; ghost particle data is not current until the update completes. With compute
+     * callbacks, the update before them only emits the signal on steps where none of them moves
+     * local particles (see getComputeCallbackMovesParticlesSignal()).
+     *
+     * The arguments are the time step, the stage, and the number of stages of this update.
+     *
+     * \return A Nano::Signal object reference to be used for connect and disconnect calls.
+     */
+    Nano::Signal<void(uint64_t timestep, unsigned int stage, unsigned int n_stages)>&
+    getGhostUpdateOverlapSignal()
+        {
+        return m_overlap_callbacks;
+        }
+
+    //! Subscribe to list of functions that tell if a compute callback moves local particles
+    /*!
+     * Subscribers of getComputeCallbackSignal() that may change the positions or velocities of
+     * local particles (e.g. the rigid body update) connect here and return true on the steps
+     * where they do. Otherwise, the migration check runs before the update ahead of the compute
+     * callbacks and that update emits getGhostUpdateOverlapSignal().
+     *
+     * \return A Nano::Signal object reference to be used for connect and disconnect calls.
+     */
+    Nano::Signal<bool(uint64_t timestep)>& getComputeCallbackMovesParticlesSignal()
+        {
+        return m_compute_callbacks_move_particles;
+        }
+    //~
+
     //! Get the ghost communication flags
     CommFlags getFlags()
         {
@@ -398,6 +434,55 @@ class PYBIND11_EXPORT Communicator
         }
     //~
 
+    //~ add compact ghost payloads [RHEOINF]
+    //! Send ghost diameters and charges only for the types whose values vary
+    /*! When enabled, exchangeGhosts() sends, per direction and field, a table with one value per
+        type and a flag for the types whose ghosts do not all share that value; only the ghosts of
+        flagged types are sent individually. Requires ghost positions (for the types).
+    */
+    void setCompactGhosts(bool compact_ghosts)
+        {
+        m_compact_ghosts = compact_ghosts;
+        }
+
+    //! Test if ghost diameters and charges are sent per type
+    bool getCompactGhosts()
+        {
+        return m_compact_ghosts;
+        }
+
+    //! Send ghost velocities in single precision in the per step ghost update
+    /*! Only the x, y, z components are sent (3 floats instead of a Scalar4); the mass of a ghost
+        is sent with full precision when ghosts are exchanged.
+    */
+    void setGhostVelocityFloat(bool ghost_velocity_float)
+        {
+        m_ghost_velocity_float = ghost_velocity_float;
+        }
+
+    //! Test if ghost velocities are sent in single precision
+    bool getGhostVelocityFloat()
+        {
+        return m_ghost_velocity_float;
+        }
+    //~
+
+    //~ add neighborhood collective ghost updates [RHEOINF]
+    //! Update ghosts with one MPI-3 neighborhood collective instead of six exchanges
+    /*! When enabled, exchangeGhosts() (still direction by direction) also records the owning rank
+        of every ghost and registers the ghost tags with their owners. The per step ghost update
+        then sends every ghost directly from its owner over a distributed graph of the (up to 26)
+        neighbor ranks with a single MPI_Neighbor_alltoallv (persistent with MPI 4).
+    */
+    void setNeighborCollectives(bool neighbor_collectives);
+
+    //! Test if ghosts are updated with neighborhood collectives
+    bool getNeighborCollectives()
+        {
+        return m_neighbor_collectives;
+        }
+    //~
+
     protected:
         Scalar m_SR; //~ add shear rate [RHEOINF]
     //! Helper class to perform the communication tasks related to bonded groups
@@ -598,10 +683,73 @@ class PYBIND11_EXPORT Communicator
     Nano::Signal<void(const GlobalArray<unsigned int>&)>
         m_comm_callbacks; //!< List of functions that are called after the compute callbacks
 
+    //~ add ghost update overlap callbacks [RHEOINF]
+    Nano::Signal<void(uint64_t timestep, unsigned int stage, unsigned int n_stages)>
+        m_overlap_callbacks; //!< List of functions called while ghost updates are in flight
+
+    Nano::Signal<bool(uint64_t timestep)>
+        m_compute_callbacks_move_particles; //!< List of functions telling if compute callbacks
+                                            //!< move local particles
+    //~
+
     CommFlags m_flags;      //!< The ghost communication flags
     CommFlags m_last_flags; //!< Flags of last ghost exchange
 
     bool m_comm_pending;             //!< If true, a communication is in process
+    bool m_overlap_ghost_update; //!< True if the ghost update emits m_overlap_callbacks [RHEOINF]
+
+    //~ add compact ghost payloads [RHEOINF]
+    bool m_compact_ghosts;                      //!< True if diameter/charge are sent per type
+    bool m_ghost_velocity_float;                //!< True if ghost updates send float velocities
+    std::vector<Scalar> m_charge_type_sendbuf;   //!< Per-type charge table (value, varying flag)
+    std::vector<Scalar> m_charge_type_recvbuf;   //!< Received per-type charge table
+    std::vector<Scalar> m_diameter_type_sendbuf; //!< Per-type diameter table (value, varying flag)
+    std::vector<Scalar> m_diameter_type_recvbuf; //!< Received per-type diameter table
+    GlobalVector<float3> m_velocity_float_copybuf; //!< Single precision ghost velocities (send)
+    GlobalVector<float3> m_velocity_float_recvbuf; //!< Single precision ghost velocities (receive)
+
+    //! Compact a ghost field in place, keeping only the values of types that vary
+    unsigned int packTypeConstantField(Scalar* values,
+                                       const Scalar4* postype,
+                                       unsigned int n,
+                                       std::vector<Scalar>& type_table);
+
+    //! Expand a ghost field compacted by packTypeConstantField() in place
+    void unpackTypeConstantField(Scalar* values,
+                                 const Scalar4* postype,
+                                 unsigned int n,
+                                 const std::vector<Scalar>& type_table);
+    //~
+
+    //~ add neighborhood collective ghost updates [RHEOINF]
+    bool m_neighbor_collectives;              //!< True if ghosts are updated with a collective
+    bool m_nc_plan_valid;                     //!< True if the direct ghost plan is current
+    bool m_nc_request_valid;                  //!< True if m_nc_request matches the buffers
+    MPI_Comm m_nc_comm;                       //!< Distributed graph of the neighbor ranks
+    MPI_Request m_nc_request;                 //!< (Persistent) neighborhood collective request
+    std::map<unsigned int, int> m_nc_slot;    //!< Neighbor rank -> position in m_nc_comm
+    GlobalVector<unsigned int> m_ghost_origin; //!< Owning rank of every particle and ghost
+    GlobalVector<unsigned int> m_origin_copybuf; //!< Buffer for owning ranks to be copied
+    std::vector<unsigned int> m_nc_send_tags; //!< Tags of the particles to send, grouped by neighbor
+    std::vector<unsigned int> m_nc_recv_idx;  //!< Ghost indices received, grouped by neighbor
+    std::vector<int> m_nc_send_counts;        //!< Particles sent to each neighbor
+    std::vector<int> m_nc_send_displs;        //!< Offsets of m_nc_send_counts
+    std::vector<int> m_nc_recv_counts;        //!< Ghosts received from each neighbor
+    std::vector<int> m_nc_recv_displs;        //!< Offsets of m_nc_recv_counts
+    std::vector<int> m_nc_send_bytes;         //!< Bytes sent to each neighbor
+    std::vector<int> m_nc_send_byte_displs;   //!< Offsets of m_nc_send_bytes
+    std::vector<int> m_nc_recv_bytes;         //!< Bytes received from each neighbor
+    std::vector<int> m_nc_recv_byte_displs;   //!< Offsets of m_nc_recv_bytes
+    std::vector<char> m_nc_sendbuf;           //!< Packed ghost records (send)
+    std::vector<char> m_nc_recvbuf;           //!< Packed ghost records (receive)
+    unsigned int m_nc_record_size;            //!< Bytes per ghost record of the current request
+
+    //! Build the direct (owner to ghost) plan after a ghost exchange
+    void setupNeighborCollectiveGhosts();
+
+    //! Update the ghosts with one neighborhood collective
+    void updateGhostsNeighborCollective(uint64_t timestep);
+    //~
     std::vector<MPI_Request> m_reqs; //!< Container for all MPI communication requests
     std::vector<MPI_Status> m_stats; //!< Container for all MPI communication statuses
 
@@ -735,6 +883,7 @@ class PYBIND11_EXPORT Communicator
         {
         removeGhostParticleTags();
         m_has_ghost_particles = false;
+        m_nc_plan_valid = false; //~ add neighborhood collective ghost updates [RHEOINF]
         }
     };
 
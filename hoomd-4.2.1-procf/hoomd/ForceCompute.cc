@@ -8,11 +8,13 @@
 */
 
 #include "ForceCompute.h"
+#include "Checkpoint.h" //~ add checkpoint state [RHEOINF]
 
 #ifdef ENABLE_MPI
 #include "Communicator.h"
 #endif
 
+#include <chrono> //~ [RHEOINF]
 #include <iostream>
 using namespace std;
 
@@ -615,7 +617,17 @@ void ForceCompute::compute(uint64_t timestep)
     // flags do not match
     if (m_particles_sorted || shouldCompute(timestep) || m_pdata->getFlags() != m_computed_flags)
         {
-        computeForces(timestep);
+        //~ time the force computation for cost-weighted load balancing [RHEOINF]
+        if (m_sysdef->getForceComputeTiming())
+            {
+            auto start = std::chrono::steady_clock::now();
+            computeForces(timestep);
+            std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+            m_sysdef->addForceComputeTime(elapsed.count());
+            }
+        else
+        //~
+            computeForces(timestep);
         }
 
     m_particles_sorted = false;
@@ -749,6 +761,111 @@ Scalar ForceCompute::getEnergy(unsigned int tag)
     return result;
     }
 
+//~ add checkpoint state [RHEOINF]
+pybind11::bytes ForceCompute::getCheckpointState()
+    {
+    detail::CheckpointBuffer buf;
+    writeCheckpointState(buf);
+    return pybind11::bytes(buf.str());
+    }
+
+/*! \param state Bytes returned by getCheckpointState() on the same rank
+ */
+void ForceCompute::setCheckpointState(pybind11::bytes state)
+    {
+    detail::CheckpointBuffer buf((std::string)state);
+    readCheckpointState(buf);
+    }
+
+/*! The forces are stored by local index, so the section is only meaningful for the particle
+    order restored by CheckpointFile. The compute bookkeeping is stored with the arrays so that
+    the first compute() after a restart skips (or repeats) the evaluation exactly as the run that
+    wrote the checkpoint would have.
+*/
+void ForceCompute::writeCheckpointState(detail::CheckpointBuffer& buf)
+    {
+    unsigned int N = m_pdata->getN();
+    buf.write(N);
+    buf.write(m_last_computed);
+    buf.write((uint8_t)m_first_compute);
+    buf.write((uint32_t)m_computed_flags.to_ulong());
+    buf.writeArray(m_external_virial, 6);
+    buf.write(m_external_energy);
+
+    ArrayHandle<Scalar4> h_force(m_force, access_location::host, access_mode::read);
+    ArrayHandle<Scalar4> h_torque(m_torque, access_location::host, access_mode::read);
+    ArrayHandle<Scalar> h_virial(m_virial, access_location::host, access_mode::read);
+    ArrayHandle<Scalar> h_virial_ind(m_virial_ind, access_location::host, access_mode::read);
+    buf.writeArray(h_force.data, N);
+    buf.writeArray(h_torque.data, N);
+    for (unsigned int j = 0; j < 6; ++j)
+        buf.writeArray(h_virial.data + j * m_virial_pitch, N);
+    for (unsigned int j = 0; j < 5; ++j)
+        buf.writeArray(h_virial_ind.data + j * m_virial_ind_pitch, N);
+    }
+
+/*! With domain decomposition the section is consumed but not applied: the forced migration in
+    Integrator::prepRun() sorts the particles and every force is recomputed, in the original run
+    and in the restarted one alike.
+*/
+void ForceCompute::readCheckpointState(detail::CheckpointBuffer& buf)
+    {
+    unsigned int N;
+    uint64_t last_computed;
+    uint8_t first_compute;
+    uint32_t computed_flags;
+    Scalar external_virial[6];
+    Scalar external_energy;
+    buf.read(N);
+    buf.read(last_computed);
+    buf.read(first_compute);
+    buf.read(computed_flags);
+    buf.readArray(external_virial, 6);
+    buf.read(external_energy);
+
+    std::vector<Scalar4> force(N), torque(N);
+    std::vector<Scalar> virial(6 * N), virial_ind(5 * N);
+    buf.readArray(force.data(), N);
+    buf.readArray(torque.data(), N);
+    buf.readArray(virial.data(), 6 * N);
+    buf.readArray(virial_ind.data(), 5 * N);
+
+    if (m_sysdef->isDomainDecomposed())
+        return;
+
+    if (N != m_pdata->getN())
+        {
+        throw std::runtime_error("Checkpointed forces do not match the number of particles.");
+        }
+
+        {
+        ArrayHandle<Scalar4> h_force(m_force, access_location::host, access_mode::overwrite);
+        ArrayHandle<Scalar4> h_torque(m_torque, access_location::host, access_mode::overwrite);
+        ArrayHandle<Scalar> h_virial(m_virial, access_location::host, access_mode::overwrite);
+        ArrayHandle<Scalar> h_virial_ind(m_virial_ind,
+                                         access_location::host,
+                                         access_mode::overwrite);
+        std::copy(force.begin(), force.end(), h_force.data);
+        std::copy(torque.begin(), torque.end(), h_torque.data);
+        for (unsigned int j = 0; j < 6; ++j)
+            std::copy(virial.begin() + j * N,
+                      virial.begin() + (j + 1) * N,
+                      h_virial.data + j * m_virial_pitch);
+        for (unsigned int j = 0; j < 5; ++j)
+            std::copy(virial_ind.begin() + j * N,
+                      virial_ind.begin() + (j + 1) * N,
+                      h_virial_ind.data + j * m_virial_ind_pitch);
+        }
+
+    std::copy(external_virial, external_virial + 6, m_external_virial);
+    m_external_energy = external_energy;
+    m_last_computed = last_computed;
+    m_first_compute = first_compute;
+    m_computed_flags = PDataFlags(computed_flags);
+    m_particles_sorted = false;
+    }
+//~
+
 namespace detail
     {
 void export_ForceCompute(pybind11::module& m)
@@ -766,7 +883,11 @@ void export_ForceCompute(pybind11::module& m)
         .def("getEnergies", &ForceCompute::getEnergiesPython)
         .def("getForces", &ForceCompute::getForcesPython)
         .def("getTorques", &ForceCompute::getTorquesPython)
-        .def("getVirials", &ForceCompute::getVirialsPython);
+        .def("getVirials", &ForceCompute::getVirialsPython)
+        //~ add checkpoint state [RHEOINF]
+        .def("getCheckpointState", &ForceCompute::getCheckpointState)
+        .def("setCheckpointState", &ForceCompute::setCheckpointState);
+        //~
     }
     } // end namespace detail
 
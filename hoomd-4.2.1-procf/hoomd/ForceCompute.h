@@ -35,6 +35,13 @@
 
 namespace hoomd
     {
+//~ add checkpoint state [RHEOINF]
+namespace detail
+    {
+class CheckpointBuffer;
+    } // end namespace detail
+//~
+
 //! Handy structure for passing the force arrays around
 /*! \c fx, \c fy, \c fz have length equal to the number of particles and store the x,y,z
     components of the force on that particle. \a pe is also included as the potential energy
@@ -132,6 +139,14 @@ class PYBIND11_EXPORT ForceCompute : public Compute
     pybind11::object getVirialsIndPython();
     //~
 
+    //~ add checkpoint state [RHEOINF]
+    //! Serialize the per-particle force arrays for a checkpoint
+    pybind11::bytes getCheckpointState();
+
+    //! Restore the state serialized by getCheckpointState()
+    void setCheckpointState(pybind11::bytes state);
+    //~
+
     //! Easy access to the torque on a single particle
     Scalar4 getTorque(unsigned int tag);
 
@@ -227,6 +242,16 @@ class PYBIND11_EXPORT ForceCompute : public Compute
     //! Reallocate internal arrays
     void reallocate();
 
+    //~ add checkpoint state [RHEOINF]
+    //! Append the state of this force to a checkpoint section
+    /*! Derived classes with additional state override this and call the base class first.
+     */
+    virtual void writeCheckpointState(detail::CheckpointBuffer& buf);
+
+    //! Read the state written by writeCheckpointState()
+    virtual void readCheckpointState(detail::CheckpointBuffer& buf);
+    //~
+
     //! Update GPU memory hints
     void updateGPUAdvice();
 
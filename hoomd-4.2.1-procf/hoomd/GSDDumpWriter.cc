@@ -1,6 +1,8 @@
 // Copyright (c) 2009-2023 The Regents of the University of Michigan.
 // Part of HOOMD-blue, released under the BSD 3-Clause License.
 
+// ########## Modified by Rheoinformatic //~ [RHEOINF] ##########
+
 #include "GSDDumpWriter.h"
 #include "Filesystem.h"
 #include "GSD.h"
@@ -75,6 +77,9 @@ GSDDumpWriter::GSDDumpWriter(std::shared_ptr<SystemDefinition> sysdef,
     m_dynamic[gsd_flag::particles_position] = true;
     m_dynamic[gsd_flag::particles_orientation] = true;
 
+    m_main_trigger = trigger; //~ [RHEOINF]
+    m_main_group = group;     //~ [RHEOINF]
+
     initFileIO();
     }
 
@@ -220,6 +225,8 @@ void GSDDumpWriter::setDynamic(pybind11::object dynamic)
 
 void GSDDumpWriter::flush()
     {
+    waitForPendingFrames(); //~ write the queued frames first [RHEOINF]
+
     if (m_exec_conf->isRoot())
         {
         m_exec_conf->msg->notice(5) << "GSD: flush gsd file " << m_fname << endl;
@@ -230,6 +237,8 @@ void GSDDumpWriter::flush()
 
 void GSDDumpWriter::setMaximumWriteBufferSize(uint64_t size)
     {
+    waitForPendingFrames(); //~ [RHEOINF]
+
     if (m_exec_conf->isRoot())
         {
         int retval = gsd_set_maximum_write_buffer_size(&m_handle, size);
@@ -243,6 +252,8 @@ void GSDDumpWriter::setMaximumWriteBufferSize(uint64_t size)
 
 uint64_t GSDDumpWriter::getMaximumWriteBufferSize()
     {
+    waitForPendingFrames(); //~ [RHEOINF]
+
     if (m_exec_conf->isRoot())
         {
         return gsd_get_maximum_write_buffer_size(&m_handle);
@@ -327,6 +338,14 @@ GSDDumpWriter::~GSDDumpWriter()
     {
     m_exec_conf->msg->notice(5) << "Destroying GSDDumpWriter" << endl;
 
+    //~ write the queued frames before closing the file [RHEOINF]
+    stopWriterThread();
+    if (!m_writer_error.empty())
+        {
+        m_exec_conf->msg->error() << "GSD: " << m_writer_error << endl;
+        }
+    //~
+
     if (m_exec_conf->isRoot())
         {
         m_exec_conf->msg->notice(5) << "GSD: close gsd file " << m_fname << endl;
@@ -358,6 +377,7 @@ void GSDDumpWriter::analyze(uint64_t timestep)
     // truncate the file if requested
     if (m_truncate)
         {
+        waitForPendingFrames(); //~ [RHEOINF]
         if (m_exec_conf->isRoot())
             {
             m_exec_conf->msg->notice(10) << "GSD: truncating file" << endl;
@@ -368,6 +388,26 @@ void GSDDumpWriter::analyze(uint64_t timestep)
         m_nframes = 0;
         }
 
+    //~ select the particles and fields of the groups active at this step [RHEOINF]
+    // the constructor group and fields are restored on every exit path, also when writing throws
+    struct RestoreSelection
+        {
+        GSDDumpWriter& writer;
+        std::bitset<n_gsd_flags> main_dynamic;
+
+        ~RestoreSelection()
+            {
+            writer.m_group = writer.m_main_group;
+            writer.m_dynamic = main_dynamic;
+            }
+        } restore_selection {*this, m_dynamic};
+
+    if (!m_output_groups.empty())
+        {
+        selectFrameParticles(timestep);
+        }
+    //~
+
     populateLocalFrame(m_local_frame, timestep);
     auto log_data = getLogData();
     write(m_local_frame, log_data);
@@ -376,7 +416,11 @@ void GSDDumpWriter::analyze(uint64_t timestep)
 void GSDDumpWriter::write(GSDDumpWriter::GSDFrame& frame, pybind11::dict log_data)
     {
 #ifdef ENABLE_MPI
-    if (m_sysdef->isDomainDecomposed())
+    if (m_sysdef->isDomainDecomposed() && m_parallel_write) //~ [RHEOINF]
+        {
+        writeFrameParallel(frame, log_data); //~ write the particle data collectively [RHEOINF]
+        }
+    else if (m_sysdef->isDomainDecomposed()) //~ [RHEOINF]
         {
         gatherGlobalFrame(frame);
 
@@ -388,6 +432,13 @@ void GSDDumpWriter::write(GSDDumpWriter::GSDFrame& frame, pybind11::dict log_dat
             writeMomenta(m_global_frame);
             writeLogQuantities(log_data);
             }
+
+        //~ keep the non-default map the same on all ranks (used by populateLocalFrame) [RHEOINF]
+        if (m_nframes == 0)
+            {
+            bcast(m_nondefault, 0, m_exec_conf->getMPICommunicator());
+            }
+        //~
         }
     else
 #endif
@@ -398,6 +449,14 @@ void GSDDumpWriter::write(GSDDumpWriter::GSDFrame& frame, pybind11::dict log_dat
         writeMomenta(frame);
         writeLogQuantities(log_data);
         }
+
+    //~ record which particles the frame contains [RHEOINF]
+    if (!m_output_groups.empty() && m_exec_conf->isRoot())
+        {
+        writeFrameSelection();
+        }
+    //~
+
     // topology is only meaningful if this is the all group
     if (m_group->getNumMembersGlobal() == m_pdata->getNGlobal()
         && (m_write_topology || m_nframes == 0))
@@ -416,13 +475,405 @@ void GSDDumpWriter::write(GSDDumpWriter::GSDFrame& frame, pybind11::dict log_dat
     if (m_exec_conf->isRoot())
         {
         m_exec_conf->msg->notice(10) << "GSD: ending frame" << endl;
+        /* int retval = gsd_end_frame(&m_handle);
+        GSDUtils::checkError(retval, m_fname); */ //~ [RHEOINF]
+        endFrame(); //~ or hand the frame to the background writer [RHEOINF]
+        }
+    m_writing_parallel_frame = false; //~ [RHEOINF]
+
+    m_nframes++;
+    }
+
+//~ add quantization [RHEOINF]
+/*! \param tolerance Maximum absolute error of a quantity (0 to write full precision)
+    \returns Quantization step: the largest power of two not above 2 * tolerance
+
+    With a power of two step, the rounded values have trailing zero mantissa bits in float32 (they
+    compress well) and rounding changes a value by at most step / 2 <= tolerance.
+*/
+Scalar GSDDumpWriter::quantizationStep(Scalar tolerance)
+    {
+    if (!(tolerance > Scalar(0.0)))
+        {
+        return Scalar(0.0);
+        }
+    return std::exp2(std::floor(std::log2(Scalar(2.0) * tolerance)));
+    }
+
+void GSDDumpWriter::setPositionTolerance(Scalar tolerance)
+    {
+    if (tolerance < Scalar(0.0))
+        {
+        throw std::invalid_argument("GSD: position_tolerance must be non-negative");
+        }
+    m_position_tolerance = tolerance;
+    m_position_step = quantizationStep(tolerance);
+    }
+
+void GSDDumpWriter::setVelocityTolerance(Scalar tolerance)
+    {
+    if (tolerance < Scalar(0.0))
+        {
+        throw std::invalid_argument("GSD: velocity_tolerance must be non-negative");
+        }
+    m_velocity_tolerance = tolerance;
+    m_velocity_step = quantizationStep(tolerance);
+    }
+//~
+
+//~ add output groups [RHEOINF]
+/*! \param group Particles to write
+    \param trigger Steps to write them on
+    \param dynamic Fields to write in every frame that contains the group (see setDynamic())
+
+    The writer runs when any group's trigger fires. Topology is only written as selected by the
+    constructor's dynamic fields.
+*/
+void GSDDumpWriter::addOutputGroup(std::shared_ptr<ParticleGroup> group,
+                                   std::shared_ptr<Trigger> trigger,
+                                   pybind11::object dynamic)
+    {
+    if (m_output_groups.size() >= m_max_output_groups)
+        {
+        throw std::invalid_argument("GSD: too many output groups");
+        }
+
+    // reuse the parsing in setDynamic()
+    std::bitset<n_gsd_flags> main_dynamic = m_dynamic;
+    bool main_write_topology = m_write_topology;
+    setDynamic(dynamic);
+    m_output_groups.push_back(OutputGroup {group, trigger, m_dynamic});
+    m_dynamic = main_dynamic;
+    m_write_topology = main_write_topology;
+
+    setMainTrigger(m_main_trigger);
+    }
+
+/*! The analyzer trigger fires when the main trigger or any output group trigger fires.
+ */
+void GSDDumpWriter::setMainTrigger(std::shared_ptr<Trigger> trigger)
+    {
+    m_main_trigger = trigger;
+    if (m_output_groups.empty())
+        {
+        m_trigger = trigger;
+        return;
+        }
+
+    std::vector<std::shared_ptr<Trigger>> triggers {trigger};
+    for (const auto& output_group : m_output_groups)
+        {
+        triggers.push_back(output_group.trigger);
+        }
+    m_trigger = std::make_shared<OrTrigger>(triggers);
+    }
+
+/*! \param timestep Current time step
+
+    The frame holds the union of the active groups (in ascending tag order) and writes the union
+    of their dynamic fields. particles/N is written in every frame. A frame with other groups than
+    frame 0 also writes every field that is non-default in frame 0: readers take missing chunks
+    from frame 0, which has a different number of rows.
+*/
+void GSDDumpWriter::selectFrameParticles(uint64_t timestep)
+    {
+    std::vector<std::shared_ptr<ParticleGroup>> sources;
+    std::bitset<n_gsd_flags> frame_dynamic;
+    uint64_t mask = 0;
+
+    if ((*m_main_trigger)(timestep))
+        {
+        mask |= 1;
+        frame_dynamic |= m_dynamic;
+        sources.push_back(m_main_group);
+        }
+    for (size_t i = 0; i < m_output_groups.size(); i++)
+        {
+        if ((*m_output_groups[i].trigger)(timestep))
+            {
+            mask |= uint64_t(1) << (i + 1);
+            frame_dynamic |= m_output_groups[i].dynamic;
+            sources.push_back(m_output_groups[i].group);
+            }
+        }
+
+    // analyze() called directly (no trigger): write the constructor group
+    if (sources.empty())
+        {
+        mask = 1;
+        frame_dynamic = m_dynamic;
+        sources.push_back(m_main_group);
+        }
+
+    if (sources.size() == 1)
+        {
+        m_group = sources[0];
+        }
+    else
+        {
+        // cache the union groups, rebuild them when the member tags of a source group change
+        // (a dynamic filter may select other particles without changing the group size)
+        std::vector<unsigned int> source_tags;
+        for (const auto& source : sources)
+            {
+            unsigned int n_members = source->getNumMembersGlobal();
+            for (unsigned int i = 0; i < n_members; i++)
+                {
+                source_tags.push_back(source->getMemberTag(i));
+                }
+            }
+        auto& entry = m_union_groups[mask];
+        if (!entry.group || entry.source_tags != source_tags)
+            {
+            std::shared_ptr<ParticleGroup> group = sources[0];
+            for (size_t i = 1; i < sources.size(); i++)
+                {
+                group = ParticleGroup::groupUnion(group, sources[i]);
+                }
+            entry.source_tags = std::move(source_tags);
+            entry.group = group;
+            }
+        m_group = entry.group;
+        }
+    m_frame_mask = mask;
+
+    frame_dynamic[gsd_flag::particles_N] = true;
+    if (m_nframes == 0)
+        {
+        m_frame0_mask = mask;
+        m_frame0_mask_known = true;
+        }
+    else if (!m_frame0_mask_known || mask != m_frame0_mask)
+        {
+        std::bitset<n_gsd_flags> particle_fields;
+        particle_fields.set();
+        particle_fields[gsd_flag::configuration_box] = false;
+        particle_fields[gsd_flag::particles_types] = false;
+        frame_dynamic |= particle_fields;
+        }
+    m_dynamic = frame_dynamic;
+    }
+
+/*! Writes log/gsd_groups/active (1 for each group in the frame, group 0 is the constructor group)
+    and log/gsd_groups/tag (the tags of the particles in the frame, one per row of the particle
+    chunks).
+*/
+void GSDDumpWriter::writeFrameSelection()
+    {
+    std::vector<uint8_t> active(m_output_groups.size() + 1);
+    for (size_t i = 0; i < active.size(); i++)
+        {
+        active[i] = (m_frame_mask >> i) & 1;
+        }
+
+    // the group member tags are known on every rank: no communication needed
+    uint32_t N = m_group->getNumMembersGlobal();
+    std::vector<uint32_t> tags(N);
+    for (unsigned int i = 0; i < N; i++)
+        {
+        tags[i] = m_group->getMemberTag(i);
+        }
+
+    m_exec_conf->msg->notice(10) << "GSD: writing log/gsd_groups" << endl;
+    int retval = writeChunk("log/gsd_groups/active",
+                            GSD_TYPE_UINT8,
+                            active.size(),
+                            1,
+                            0,
+                            (void*)active.data());
+    GSDUtils::checkError(retval, m_fname);
+    retval = writeChunk("log/gsd_groups/tag", GSD_TYPE_UINT32, N, 1, 0, (void*)tags.data());
+    GSDUtils::checkError(retval, m_fname);
+    }
+//~
+
+//~ add asynchronous writes [RHEOINF]
+/*! \param async_write True to write frames from a background thread
+
+    Only rank 0 writes to the file, so only rank 0 runs the background thread. Disabling async
+    writes waits for the queued frames.
+*/
+void GSDDumpWriter::setAsyncWrite(bool async_write)
+    {
+    if (async_write == m_async_write)
+        return;
+
+    if (!async_write)
+        stopWriterThread();
+    m_async_write = async_write;
+    if (m_async_write && m_exec_conf->isRoot())
+        startWriterThread();
+    }
+
+/*! \param name Chunk name
+    \param type Chunk data type
+    \param N Number of rows
+    \param M Number of columns
+    \param flags Chunk flags (unused, must be 0)
+    \param data Chunk data (N*M elements of type)
+
+    \returns The gsd_write_chunk return value, or GSD_SUCCESS when the chunk is recorded
+
+    In async mode, the data is copied: the caller may reuse its buffers as soon as this returns.
+*/
+int GSDDumpWriter::writeChunk(const char* name,
+                              gsd_type type,
+                              uint64_t N,
+                              uint32_t M,
+                              uint8_t flags,
+                              const void* data)
+    {
+    if (!m_async_write || m_writing_parallel_frame)
+        {
+        return gsd_write_chunk(&m_handle, name, type, N, M, flags, data);
+        }
+
+    if (m_n_pending == m_pending.size())
+        {
+        m_pending.emplace_back();
+        }
+    GSDChunk& chunk = m_pending[m_n_pending++];
+    chunk.name = name;
+    chunk.type = type;
+    chunk.N = N;
+    chunk.M = M;
+    chunk.flags = flags;
+    const char* bytes = static_cast<const char*>(data);
+    chunk.data.assign(bytes, bytes + N * M * gsd_sizeof_type(type));
+    return GSD_SUCCESS;
+    }
+
+/*! Ends the frame directly, or queues the recorded chunks for the background writer. Waits while
+    m_max_queued_frames frames are already queued, so at most one frame is written while the next
+    one is recorded.
+*/
+void GSDDumpWriter::endFrame()
+    {
+    if (!m_async_write || m_writing_parallel_frame)
+        {
         int retval = gsd_end_frame(&m_handle);
         GSDUtils::checkError(retval, m_fname);
+        return;
         }
 
-    m_nframes++;
+    m_pending.resize(m_n_pending);
+        {
+        std::unique_lock<std::mutex> lock(m_queue_mutex);
+        m_queue_cv.wait(lock, [this] { return m_queue.size() < m_max_queued_frames; });
+        m_queue.push_back(std::move(m_pending));
+
+        // reuse the buffers of a written frame
+        if (!m_recycled.empty())
+            {
+            m_pending = std::move(m_recycled.back());
+            m_recycled.pop_back();
+            }
+        else
+            {
+            m_pending = std::vector<GSDChunk>();
+            }
+        m_n_pending = 0;
+        }
+    m_queue_cv.notify_all();
+    checkWriterError();
+    }
+
+void GSDDumpWriter::startWriterThread()
+    {
+    m_stop_writer = false;
+    m_writer_thread = std::thread(&GSDDumpWriter::writerThreadLoop, this);
+    }
+
+void GSDDumpWriter::stopWriterThread()
+    {
+    if (!m_writer_thread.joinable())
+        return;
+
+        {
+        std::lock_guard<std::mutex> lock(m_queue_mutex);
+        m_stop_writer = true;
+        }
+    m_queue_cv.notify_all();
+    m_writer_thread.join();
     }
 
+/*! Writes queued frames in order until stopWriterThread() is called and the queue is empty. The
+    background thread is the only one to access m_handle while it runs (the main thread calls
+    waitForPendingFrames() before any other file operation).
+*/
+void GSDDumpWriter::writerThreadLoop()
+    {
+    while (true)
+        {
+        std::vector<GSDChunk> frame;
+            {
+            std::unique_lock<std::mutex> lock(m_queue_mutex);
+            m_queue_cv.wait(lock, [this] { return m_stop_writer || !m_queue.empty(); });
+            if (m_queue.empty())
+                return;
+            frame = std::move(m_queue.front());
+            m_queue.pop_front();
+            m_writer_busy = true;
+            }
+        m_queue_cv.notify_all();
+
+        std::string error;
+        try
+            {
+            for (const GSDChunk& chunk : frame)
+                {
+                int retval = gsd_write_chunk(&m_handle,
+                                             chunk.name.c_str(),
+                                             chunk.type,
+                                             chunk.N,
+                                             chunk.M,
+                                             chunk.flags,
+                                             chunk.data.data());
+                GSDUtils::checkError(retval, m_fname);
+                }
+            int retval = gsd_end_frame(&m_handle);
+            GSDUtils::checkError(retval, m_fname);
+            }
+        catch (const std::exception& e)
+            {
+            error = e.what();
+            }
+
+            {
+            std::lock_guard<std::mutex> lock(m_queue_mutex);
+            if (m_writer_error.empty())
+                m_writer_error = error;
+            m_recycled.push_back(std::move(frame));
+            m_writer_busy = false;
+            }
+        m_queue_cv.notify_all();
+        }
+    }
+
+void GSDDumpWriter::waitForPendingFrames()
+    {
+    if (m_writer_thread.joinable())
+        {
+        std::unique_lock<std::mutex> lock(m_queue_mutex);
+        m_queue_cv.wait(lock, [this] { return m_queue.empty() && !m_writer_busy; });
+        }
+    checkWriterError();
+    }
+
+void GSDDumpWriter::checkWriterError()
+    {
+    std::string error;
+        {
+        std::lock_guard<std::mutex> lock(m_queue_mutex);
+        error.swap(m_writer_error);
+        }
+    if (!error.empty())
+        {
+        throw std::runtime_error("GSD: background write failed: " + error);
+        }
+    }
+//~
+
 void GSDDumpWriter::writeTypeMapping(std::string chunk, std::vector<std::string> type_mapping)
     {
     int max_len = 0;
@@ -437,13 +888,12 @@ void GSDDumpWriter::writeTypeMapping(std::string chunk, std::vector<std::string>
         std::vector<char> types(max_len * type_mapping.size());
         for (unsigned int i = 0; i < type_mapping.size(); i++)
             strncpy(&types[max_len * i], type_mapping[i].c_str(), max_len);
-        int retval = gsd_write_chunk(&m_handle,
-                                     chunk.c_str(),
-                                     GSD_TYPE_UINT8,
-                                     type_mapping.size(),
-                                     max_len,
-                                     0,
-                                     (void*)&types[0]);
+        int retval = writeChunk(chunk.c_str(), //~ [RHEOINF]
+                                GSD_TYPE_UINT8,
+                                type_mapping.size(),
+                                max_len,
+                                0,
+                                (void*)&types[0]);
         GSDUtils::checkError(retval, m_fname);
         }
     }
@@ -455,26 +905,24 @@ void GSDDumpWriter::writeFrameHeader(const GSDDumpWriter::GSDFrame& frame)
     {
     int retval;
     m_exec_conf->msg->notice(10) << "GSD: writing configuration/step" << endl;
-    retval = gsd_write_chunk(&m_handle,
-                             "configuration/step",
-                             GSD_TYPE_UINT64,
-                             1,
-                             1,
-                             0,
-                             (void*)&frame.timestep);
+    retval = writeChunk("configuration/step", //~ [RHEOINF]
+                        GSD_TYPE_UINT64,
+                        1,
+                        1,
+                        0,
+                        (void*)&frame.timestep);
     GSDUtils::checkError(retval, m_fname);
 
     if (m_nframes == 0)
         {
         m_exec_conf->msg->notice(10) << "GSD: writing configuration/dimensions" << endl;
         uint8_t dimensions = (uint8_t)m_sysdef->getNDimensions();
-        retval = gsd_write_chunk(&m_handle,
-                                 "configuration/dimensions",
-                                 GSD_TYPE_UINT8,
-                                 1,
-                                 1,
-                                 0,
-                                 (void*)&dimensions);
+        retval = writeChunk("configuration/dimensions", //~ [RHEOINF]
+                            GSD_TYPE_UINT8,
+                            1,
+                            1,
+                            0,
+                            (void*)&dimensions);
         GSDUtils::checkError(retval, m_fname);
         }
 
@@ -488,13 +936,12 @@ void GSDDumpWriter::writeFrameHeader(const GSDDumpWriter::GSDFrame& frame)
         box_a[3] = (float)frame.global_box.getTiltFactorXY();
         box_a[4] = (float)frame.global_box.getTiltFactorXZ();
         box_a[5] = (float)frame.global_box.getTiltFactorYZ();
-        retval = gsd_write_chunk(&m_handle,
-                                 "configuration/box",
-                                 GSD_TYPE_FLOAT,
-                                 6,
-                                 1,
-                                 0,
-                                 (void*)box_a);
+        retval = writeChunk("configuration/box", //~ [RHEOINF]
+                            GSD_TYPE_FLOAT,
+                            6,
+                            1,
+                            0,
+                            (void*)box_a);
         GSDUtils::checkError(retval, m_fname);
         }
 
@@ -502,7 +949,7 @@ void GSDDumpWriter::writeFrameHeader(const GSDDumpWriter::GSDFrame& frame)
         {
         m_exec_conf->msg->notice(10) << "GSD: writing particles/N" << endl;
         uint32_t N = m_group->getNumMembersGlobal();
-        retval = gsd_write_chunk(&m_handle, "particles/N", GSD_TYPE_UINT32, 1, 1, 0, (void*)&N);
+        retval = writeChunk("particles/N", GSD_TYPE_UINT32, 1, 1, 0, (void*)&N); //~ [RHEOINF]
         GSDUtils::checkError(retval, m_fname);
         }
     }
@@ -525,13 +972,12 @@ void GSDDumpWriter::writeAttributes(const GSDDumpWriter::GSDFrame& frame)
         assert(frame.particle_data.type.size() == N);
 
         m_exec_conf->msg->notice(10) << "GSD: writing particles/typeid" << endl;
-        retval = gsd_write_chunk(&m_handle,
-                                 "particles/typeid",
-                                 GSD_TYPE_UINT32,
-                                 N,
-                                 1,
-                                 0,
-                                 (void*)frame.particle_data.type.data());
+        retval = writeChunk("particles/typeid", //~ [RHEOINF]
+                            GSD_TYPE_UINT32,
+                            N,
+                            1,
+                            0,
+                            (void*)frame.particle_data.type.data());
         GSDUtils::checkError(retval, m_fname);
         if (m_nframes == 0)
             m_nondefault["particles/typeid"] = true;
@@ -542,13 +988,12 @@ void GSDDumpWriter::writeAttributes(const GSDDumpWriter::GSDFrame& frame)
         assert(frame.particle_data.mass.size() == N);
 
         m_exec_conf->msg->notice(10) << "GSD: writing particles/mass" << endl;
-        retval = gsd_write_chunk(&m_handle,
-                                 "particles/mass",
-                                 GSD_TYPE_FLOAT,
-                                 N,
-                                 1,
-                                 0,
-                                 (void*)frame.particle_data.mass.data());
+        retval = writeChunk("particles/mass", //~ [RHEOINF]
+                            GSD_TYPE_FLOAT,
+                            N,
+                            1,
+                            0,
+                            (void*)frame.particle_data.mass.data());
         GSDUtils::checkError(retval, m_fname);
         if (m_nframes == 0)
             m_nondefault["particles/mass"] = true;
@@ -559,13 +1004,12 @@ void GSDDumpWriter::writeAttributes(const GSDDumpWriter::GSDFrame& frame)
         assert(frame.particle_data.charge.size() == N);
 
         m_exec_conf->msg->notice(10) << "GSD: writing particles/charge" << endl;
-        retval = gsd_write_chunk(&m_handle,
-                                 "particles/charge",
-                                 GSD_TYPE_FLOAT,
-                                 N,
-                                 1,
-                                 0,
-                                 (void*)frame.particle_data.charge.data());
+        retval = writeChunk("particles/charge", //~ [RHEOINF]
+                            GSD_TYPE_FLOAT,
+                            N,
+                            1,
+                            0,
+                            (void*)frame.particle_data.charge.data());
         GSDUtils::checkError(retval, m_fname);
         if (m_nframes == 0)
             m_nondefault["particles/charge"] = true;
@@ -578,13 +1022,12 @@ void GSDDumpWriter::writeAttributes(const GSDDumpWriter::GSDFrame& frame)
             assert(frame.particle_data.diameter.size() == N);
 
             m_exec_conf->msg->notice(10) << "GSD: writing particles/diameter" << endl;
-            retval = gsd_write_chunk(&m_handle,
-                                     "particles/diameter",
-                                     GSD_TYPE_FLOAT,
-                                     N,
-                                     1,
-                                     0,
-                                     (void*)frame.particle_data.diameter.data());
+            retval = writeChunk("particles/diameter", //~ [RHEOINF]
+                                GSD_TYPE_FLOAT,
+                                N,
+                                1,
+                                0,
+                                (void*)frame.particle_data.diameter.data());
             GSDUtils::checkError(retval, m_fname);
             if (m_nframes == 0)
                 m_nondefault["particles/diameter"] = true;
@@ -596,13 +1039,12 @@ void GSDDumpWriter::writeAttributes(const GSDDumpWriter::GSDFrame& frame)
         assert(frame.particle_data.body.size() == N);
 
         m_exec_conf->msg->notice(10) << "GSD: writing particles/body" << endl;
-        retval = gsd_write_chunk(&m_handle,
-                                 "particles/body",
-                                 GSD_TYPE_INT32,
-                                 N,
-                                 1,
-                                 0,
-                                 (void*)frame.particle_data.body.data());
+        retval = writeChunk("particles/body", //~ [RHEOINF]
+                            GSD_TYPE_INT32,
+                            N,
+                            1,
+                            0,
+                            (void*)frame.particle_data.body.data());
         GSDUtils::checkError(retval, m_fname);
         if (m_nframes == 0)
             m_nondefault["particles/body"] = true;
@@ -613,13 +1055,12 @@ void GSDDumpWriter::writeAttributes(const GSDDumpWriter::GSDFrame& frame)
         assert(frame.particle_data.inertia.size() == N);
 
         m_exec_conf->msg->notice(10) << "GSD: writing particles/moment_inertia" << endl;
-        retval = gsd_write_chunk(&m_handle,
-                                 "particles/moment_inertia",
-                                 GSD_TYPE_FLOAT,
-                                 N,
-                                 3,
-                                 0,
-                                 (void*)frame.particle_data.inertia.data());
+        retval = writeChunk("particles/moment_inertia", //~ [RHEOINF]
+                            GSD_TYPE_FLOAT,
+                            N,
+                            3,
+                            0,
+                            (void*)frame.particle_data.inertia.data());
         GSDUtils::checkError(retval, m_fname);
         if (m_nframes == 0)
             m_nondefault["particles/moment_inertia"] = true;
@@ -638,13 +1079,12 @@ void GSDDumpWriter::writeProperties(const GSDDumpWriter::GSDFrame& frame)
         assert(frame.particle_data.pos.size() == N);
 
         m_exec_conf->msg->notice(10) << "GSD: writing particles/position" << endl;
-        retval = gsd_write_chunk(&m_handle,
-                                 "particles/position",
-                                 GSD_TYPE_FLOAT,
-                                 N,
-                                 3,
-                                 0,
-                                 (void*)frame.particle_data.pos.data());
+        retval = writeChunk("particles/position", //~ [RHEOINF]
+                            GSD_TYPE_FLOAT,
+                            N,
+                            3,
+                            0,
+                            (void*)frame.particle_data.pos.data());
         GSDUtils::checkError(retval, m_fname);
         if (m_nframes == 0)
             m_nondefault["particles/position"] = true;
@@ -655,13 +1095,12 @@ void GSDDumpWriter::writeProperties(const GSDDumpWriter::GSDFrame& frame)
         assert(frame.particle_data.orientation.size() == N);
 
         m_exec_conf->msg->notice(10) << "GSD: writing particles/orientation" << endl;
-        retval = gsd_write_chunk(&m_handle,
-                                 "particles/orientation",
-                                 GSD_TYPE_FLOAT,
-                                 N,
-                                 4,
-                                 0,
-                                 (void*)frame.particle_data.orientation.data());
+        retval = writeChunk("particles/orientation", //~ [RHEOINF]
+                            GSD_TYPE_FLOAT,
+                            N,
+                            4,
+                            0,
+                            (void*)frame.particle_data.orientation.data());
         GSDUtils::checkError(retval, m_fname);
         if (m_nframes == 0)
             m_nondefault["particles/orientation"] = true;
@@ -680,13 +1119,12 @@ void GSDDumpWriter::writeMomenta(const GSDDumpWriter::GSDFrame& frame)
         assert(frame.particle_data.vel.size() == N);
 
         m_exec_conf->msg->notice(10) << "GSD: writing particles/velocity" << endl;
-        retval = gsd_write_chunk(&m_handle,
-                                 "particles/velocity",
-                                 GSD_TYPE_FLOAT,
-                                 N,
-                                 3,
-                                 0,
-                                 (void*)frame.particle_data.vel.data());
+        retval = writeChunk("particles/velocity", //~ [RHEOINF]
+                            GSD_TYPE_FLOAT,
+                            N,
+                            3,
+                            0,
+                            (void*)frame.particle_data.vel.data());
         GSDUtils::checkError(retval, m_fname);
         if (m_nframes == 0)
             m_nondefault["particles/velocity"] = true;
@@ -697,13 +1135,12 @@ void GSDDumpWriter::writeMomenta(const GSDDumpWriter::GSDFrame& frame)
         assert(frame.particle_data.angmom.size() == N);
 
         m_exec_conf->msg->notice(10) << "GSD: writing particles/angmom" << endl;
-        retval = gsd_write_chunk(&m_handle,
-                                 "particles/angmom",
-                                 GSD_TYPE_FLOAT,
-                                 N,
-                                 4,
-                                 0,
-                                 (void*)frame.particle_data.angmom.data());
+        retval = writeChunk("particles/angmom", //~ [RHEOINF]
+                            GSD_TYPE_FLOAT,
+                            N,
+                            4,
+                            0,
+                            (void*)frame.particle_data.angmom.data());
         GSDUtils::checkError(retval, m_fname);
         if (m_nframes == 0)
             m_nondefault["particles/angmom"] = true;
@@ -714,13 +1151,12 @@ void GSDDumpWriter::writeMomenta(const GSDDumpWriter::GSDFrame& frame)
         assert(frame.particle_data.image.size() == N);
 
         m_exec_conf->msg->notice(10) << "GSD: writing particles/image" << endl;
-        retval = gsd_write_chunk(&m_handle,
-                                 "particles/image",
-                                 GSD_TYPE_INT32,
-                                 N,
-                                 3,
-                                 0,
-                                 (void*)frame.particle_data.image.data());
+        retval = writeChunk("particles/image", //~ [RHEOINF]
+                            GSD_TYPE_INT32,
+                            N,
+                            3,
+                            0,
+                            (void*)frame.particle_data.image.data());
         GSDUtils::checkError(retval, m_fname);
         if (m_nframes == 0)
             m_nondefault["particles/image"] = true;
@@ -747,116 +1183,108 @@ void GSDDumpWriter::writeTopology(BondData::Snapshot& bond,
         {
         m_exec_conf->msg->notice(10) << "GSD: writing bonds/N" << endl;
         uint32_t N = bond.size;
-        int retval = gsd_write_chunk(&m_handle, "bonds/N", GSD_TYPE_UINT32, 1, 1, 0, (void*)&N);
+        int retval = writeChunk("bonds/N", GSD_TYPE_UINT32, 1, 1, 0, (void*)&N); //~ [RHEOINF]
         GSDUtils::checkError(retval, m_fname);
 
         writeTypeMapping("bonds/types", bond.type_mapping);
 
         m_exec_conf->msg->notice(10) << "GSD: writing bonds/typeid" << endl;
-        retval = gsd_write_chunk(&m_handle,
-                                 "bonds/typeid",
-                                 GSD_TYPE_UINT32,
-                                 N,
-                                 1,
-                                 0,
-                                 (void*)&bond.type_id[0]);
+        retval = writeChunk("bonds/typeid", //~ [RHEOINF]
+                            GSD_TYPE_UINT32,
+                            N,
+                            1,
+                            0,
+                            (void*)&bond.type_id[0]);
         GSDUtils::checkError(retval, m_fname);
 
         m_exec_conf->msg->notice(10) << "GSD: writing bonds/group" << endl;
-        retval = gsd_write_chunk(&m_handle,
-                                 "bonds/group",
-                                 GSD_TYPE_UINT32,
-                                 N,
-                                 2,
-                                 0,
-                                 (void*)&bond.groups[0]);
+        retval = writeChunk("bonds/group", //~ [RHEOINF]
+                            GSD_TYPE_UINT32,
+                            N,
+                            2,
+                            0,
+                            (void*)&bond.groups[0]);
         GSDUtils::checkError(retval, m_fname);
         }
     if (angle.size > 0)
         {
         m_exec_conf->msg->notice(10) << "GSD: writing angles/N" << endl;
         uint32_t N = angle.size;
-        int retval = gsd_write_chunk(&m_handle, "angles/N", GSD_TYPE_UINT32, 1, 1, 0, (void*)&N);
+        int retval = writeChunk("angles/N", GSD_TYPE_UINT32, 1, 1, 0, (void*)&N); //~ [RHEOINF]
         GSDUtils::checkError(retval, m_fname);
 
         writeTypeMapping("angles/types", angle.type_mapping);
 
         m_exec_conf->msg->notice(10) << "GSD: writing angles/typeid" << endl;
-        retval = gsd_write_chunk(&m_handle,
-                                 "angles/typeid",
-                                 GSD_TYPE_UINT32,
-                                 N,
-                                 1,
-                                 0,
-                                 (void*)&angle.type_id[0]);
+        retval = writeChunk("angles/typeid", //~ [RHEOINF]
+                            GSD_TYPE_UINT32,
+                            N,
+                            1,
+                            0,
+                            (void*)&angle.type_id[0]);
         GSDUtils::checkError(retval, m_fname);
 
         m_exec_conf->msg->notice(10) << "GSD: writing angles/group" << endl;
-        retval = gsd_write_chunk(&m_handle,
-                                 "angles/group",
-                                 GSD_TYPE_UINT32,
-                                 N,
-                                 3,
-                                 0,
-                                 (void*)&angle.groups[0]);
+        retval = writeChunk("angles/group", //~ [RHEOINF]
+                            GSD_TYPE_UINT32,
+                            N,
+                            3,
+                            0,
+                            (void*)&angle.groups[0]);
         GSDUtils::checkError(retval, m_fname);
         }
     if (dihedral.size > 0)
         {
         m_exec_conf->msg->notice(10) << "GSD: writing dihedrals/N" << endl;
         uint32_t N = dihedral.size;
-        int retval = gsd_write_chunk(&m_handle, "dihedrals/N", GSD_TYPE_UINT32, 1, 1, 0, (void*)&N);
+        int retval = writeChunk("dihedrals/N", GSD_TYPE_UINT32, 1, 1, 0, (void*)&N); //~ [RHEOINF]
         GSDUtils::checkError(retval, m_fname);
 
         writeTypeMapping("dihedrals/types", dihedral.type_mapping);
 
         m_exec_conf->msg->notice(10) << "GSD: writing dihedrals/typeid" << endl;
-        retval = gsd_write_chunk(&m_handle,
-                                 "dihedrals/typeid",
-                                 GSD_TYPE_UINT32,
-                                 N,
-                                 1,
-                                 0,
-                                 (void*)&dihedral.type_id[0]);
+        retval = writeChunk("dihedrals/typeid", //~ [RHEOINF]
+                            GSD_TYPE_UINT32,
+                            N,
+                            1,
+                            0,
+                            (void*)&dihedral.type_id[0]);
         GSDUtils::checkError(retval, m_fname);
 
         m_exec_conf->msg->notice(10) << "GSD: writing dihedrals/group" << endl;
-        retval = gsd_write_chunk(&m_handle,
-                                 "dihedrals/group",
-                                 GSD_TYPE_UINT32,
-                                 N,
-                                 4,
-                                 0,
-                                 (void*)&dihedral.groups[0]);
+        retval = writeChunk("dihedrals/group", //~ [RHEOINF]
+                            GSD_TYPE_UINT32,
+                            N,
+                            4,
+                            0,
+                            (void*)&dihedral.groups[0]);
         GSDUtils::checkError(retval, m_fname);
         }
     if (improper.size > 0)
         {
         m_exec_conf->msg->notice(10) << "GSD: writing impropers/N" << endl;
         uint32_t N = improper.size;
-        int retval = gsd_write_chunk(&m_handle, "impropers/N", GSD_TYPE_UINT32, 1, 1, 0, (void*)&N);
+        int retval = writeChunk("impropers/N", GSD_TYPE_UINT32, 1, 1, 0, (void*)&N); //~ [RHEOINF]
         GSDUtils::checkError(retval, m_fname);
 
         writeTypeMapping("impropers/types", improper.type_mapping);
 
         m_exec_conf->msg->notice(10) << "GSD: writing impropers/typeid" << endl;
-        retval = gsd_write_chunk(&m_handle,
-                                 "impropers/typeid",
-                                 GSD_TYPE_UINT32,
-                                 N,
-                                 1,
-                                 0,
-                                 (void*)&improper.type_id[0]);
+        retval = writeChunk("impropers/typeid", //~ [RHEOINF]
+                            GSD_TYPE_UINT32,
+                            N,
+                            1,
+                            0,
+                            (void*)&improper.type_id[0]);
         GSDUtils::checkError(retval, m_fname);
 
         m_exec_conf->msg->notice(10) << "GSD: writing impropers/group" << endl;
-        retval = gsd_write_chunk(&m_handle,
-                                 "impropers/group",
-                                 GSD_TYPE_UINT32,
-                                 N,
-                                 4,
-                                 0,
-                                 (void*)&improper.groups[0]);
+        retval = writeChunk("impropers/group", //~ [RHEOINF]
+                            GSD_TYPE_UINT32,
+                            N,
+                            4,
+                            0,
+                            (void*)&improper.groups[0]);
         GSDUtils::checkError(retval, m_fname);
         }
 
@@ -865,7 +1293,7 @@ void GSDDumpWriter::writeTopology(BondData::Snapshot& bond,
         m_exec_conf->msg->notice(10) << "GSD: writing constraints/N" << endl;
         uint32_t N = constraint.size;
         int retval
-            = gsd_write_chunk(&m_handle, "constraints/N", GSD_TYPE_UINT32, 1, 1, 0, (void*)&N);
+            = writeChunk("constraints/N", GSD_TYPE_UINT32, 1, 1, 0, (void*)&N); //~ [RHEOINF]
         GSDUtils::checkError(retval, m_fname);
 
         m_exec_conf->msg->notice(10) << "GSD: writing constraints/value" << endl;
@@ -875,24 +1303,22 @@ void GSDDumpWriter::writeTopology(BondData::Snapshot& bond,
             for (unsigned int i = 0; i < N; i++)
                 data[i] = float(constraint.val[i]);
 
-            retval = gsd_write_chunk(&m_handle,
-                                     "constraints/value",
-                                     GSD_TYPE_FLOAT,
-                                     N,
-                                     1,
-                                     0,
-                                     (void*)&data[0]);
+            retval = writeChunk("constraints/value", //~ [RHEOINF]
+                                GSD_TYPE_FLOAT,
+                                N,
+                                1,
+                                0,
+                                (void*)&data[0]);
             GSDUtils::checkError(retval, m_fname);
             }
 
         m_exec_conf->msg->notice(10) << "GSD: writing constraints/group" << endl;
-        retval = gsd_write_chunk(&m_handle,
-                                 "constraints/group",
-                                 GSD_TYPE_UINT32,
-                                 N,
-                                 2,
-                                 0,
-                                 (void*)&constraint.groups[0]);
+        retval = writeChunk("constraints/group", //~ [RHEOINF]
+                            GSD_TYPE_UINT32,
+                            N,
+                            2,
+                            0,
+                            (void*)&constraint.groups[0]);
         GSDUtils::checkError(retval, m_fname);
         }
 
@@ -900,29 +1326,27 @@ void GSDDumpWriter::writeTopology(BondData::Snapshot& bond,
         {
         m_exec_conf->msg->notice(10) << "GSD: writing pairs/N" << endl;
         uint32_t N = pair.size;
-        int retval = gsd_write_chunk(&m_handle, "pairs/N", GSD_TYPE_UINT32, 1, 1, 0, (void*)&N);
+        int retval = writeChunk("pairs/N", GSD_TYPE_UINT32, 1, 1, 0, (void*)&N); //~ [RHEOINF]
         GSDUtils::checkError(retval, m_fname);
 
         writeTypeMapping("pairs/types", pair.type_mapping);
 
         m_exec_conf->msg->notice(10) << "GSD: writing pairs/typeid" << endl;
-        retval = gsd_write_chunk(&m_handle,
-                                 "pairs/typeid",
-                                 GSD_TYPE_UINT32,
-                                 N,
-                                 1,
-                                 0,
-                                 (void*)&pair.type_id[0]);
+        retval = writeChunk("pairs/typeid", //~ [RHEOINF]
+                            GSD_TYPE_UINT32,
+                            N,
+                            1,
+                            0,
+                            (void*)&pair.type_id[0]);
         GSDUtils::checkError(retval, m_fname);
 
         m_exec_conf->msg->notice(10) << "GSD: writing pairs/group" << endl;
-        retval = gsd_write_chunk(&m_handle,
-                                 "pairs/group",
-                                 GSD_TYPE_UINT32,
-                                 N,
-                                 2,
-                                 0,
-                                 (void*)&pair.groups[0]);
+        retval = writeChunk("pairs/group", //~ [RHEOINF]
+                            GSD_TYPE_UINT32,
+                            N,
+                            2,
+                            0,
+                            (void*)&pair.groups[0]);
         GSDUtils::checkError(retval, m_fname);
         }
     }
@@ -1015,7 +1439,7 @@ void GSDDumpWriter::writeLogQuantities(pybind11::dict dict)
             }
 
         int retval
-            = gsd_write_chunk(&m_handle, name.c_str(), type, N, (uint32_t)M, 0, (void*)arr.data());
+            = writeChunk(name.c_str(), type, N, (uint32_t)M, 0, (void*)arr.data()); //~ [RHEOINF]
         GSDUtils::checkError(retval, m_fname);
         }
     }
@@ -1081,6 +1505,7 @@ void GSDDumpWriter::populateLocalFrame(GSDDumpWriter::GSDFrame& frame, uint64_t
                                         access_mode::read);
 
         m_index.resize(0);
+        m_group_index.resize(0); //~ [RHEOINF]
 
         for (unsigned int group_tag_index = 0; group_tag_index < N; group_tag_index++)
             {
@@ -1093,6 +1518,7 @@ void GSDDumpWriter::populateLocalFrame(GSDDumpWriter::GSDFrame& frame, uint64_t
 
             frame.particle_tags.push_back(h_tag.data[index]);
             m_index.push_back(index);
+            m_group_index.push_back(group_tag_index); //~ row in the chunks [RHEOINF]
             }
         }
 
@@ -1132,6 +1558,16 @@ void GSDDumpWriter::populateLocalFrame(GSDDumpWriter::GSDFrame& frame, uint64_t
 
             frame.global_box.wrap(position, image);
 
+            //~ round to the quantization grid, wrap again if rounding reached the box edge [RHEOINF]
+            if (m_position_step > Scalar(0.0))
+                {
+                position.x = quantizeValue(position.x, m_position_step);
+                position.y = quantizeValue(position.y, m_position_step);
+                position.z = quantizeValue(position.z, m_position_step);
+                frame.global_box.wrap(position, image);
+                }
+            //~
+
             if (m_dynamic[gsd_flag::particles_position] || m_nframes == 0)
                 {
                 if (position != vec3<Scalar>(0, 0, 0))
@@ -1206,6 +1642,18 @@ void GSDDumpWriter::populateLocalFrame(GSDDumpWriter::GSDFrame& frame, uint64_t
             vec3<float> velocity = vec3<float>(static_cast<float>(h_velocity_mass.data[index].x),
                                                static_cast<float>(h_velocity_mass.data[index].y),
                                                static_cast<float>(h_velocity_mass.data[index].z));
+            //~ round to the quantization grid [RHEOINF]
+            if (m_velocity_step > Scalar(0.0))
+                {
+                velocity = vec3<float>(
+                    static_cast<float>(
+                        quantizeValue(h_velocity_mass.data[index].x, m_velocity_step)),
+                    static_cast<float>(
+                        quantizeValue(h_velocity_mass.data[index].y, m_velocity_step)),
+                    static_cast<float>(
+                        quantizeValue(h_velocity_mass.data[index].z, m_velocity_step)));
+                }
+            //~
             float mass = static_cast<float>(h_velocity_mass.data[index].w);
 
             if (m_dynamic[gsd_flag::particles_mass] || m_nframes == 0)
@@ -1526,6 +1974,158 @@ void GSDDumpWriter::gatherGlobalFrame(const GSDFrame& local_frame)
         }
     }
 
+//~ add parallel writes [RHEOINF]
+/*! \param local_frame Frame with the particles local to this rank, in ascending tag order
+    \param log_data Logged quantities to write (rank 0)
+
+    Rank 0 writes the frame header, type names, and logged quantities through the gsd handle as
+    usual. For each per-particle chunk, rank 0 reserves the space at the end of the file
+    (gsd_reserve_chunk) and all ranks write their particles into it with one collective MPI-IO
+    write. The index written by gsd_end_frame() is the same as for a gathered frame, so the file
+    is readable by any gsd reader.
+
+    The frame is written synchronously, also with async_write.
+*/
+void GSDDumpWriter::writeFrameParallel(const GSDFrame& local_frame, pybind11::dict log_data)
+    {
+    // rank 0 uses the gsd handle directly: the background writer must be idle
+    waitForPendingFrames();
+    m_writing_parallel_frame = true;
+
+    const SnapshotParticleData<float>& pdata = local_frame.particle_data;
+    const std::bitset<n_gsd_flags>& present = local_frame.particle_data_present;
+
+    if (m_exec_conf->isRoot())
+        {
+        writeFrameHeader(local_frame);
+        if (m_dynamic[gsd_flag::particles_types] || m_nframes == 0)
+            {
+            writeTypeMapping("particles/types", pdata.type_mapping);
+            }
+        }
+
+    MPI_File fh;
+    int err = MPI_File_open(m_exec_conf->getMPICommunicator(),
+                            m_fname.c_str(),
+                            MPI_MODE_WRONLY,
+                            MPI_INFO_NULL,
+                            &fh);
+    if (err != MPI_SUCCESS)
+        {
+        throw std::runtime_error("GSD: error opening " + m_fname + " with MPI-IO");
+        }
+
+    // same chunk order as writeAttributes(), writeProperties(), and writeMomenta()
+    if (present[gsd_flag::particles_type])
+        writeParticleChunkParallel(fh, "particles/typeid", GSD_TYPE_UINT32, 1, pdata.type.data());
+    if (present[gsd_flag::particles_mass])
+        writeParticleChunkParallel(fh, "particles/mass", GSD_TYPE_FLOAT, 1, pdata.mass.data());
+    if (present[gsd_flag::particles_charge])
+        writeParticleChunkParallel(fh, "particles/charge", GSD_TYPE_FLOAT, 1, pdata.charge.data());
+    if (m_write_diameter && present[gsd_flag::particles_diameter])
+        writeParticleChunkParallel(fh,
+                                   "particles/diameter",
+                                   GSD_TYPE_FLOAT,
+                                   1,
+                                   pdata.diameter.data());
+    if (present[gsd_flag::particles_body])
+        writeParticleChunkParallel(fh, "particles/body", GSD_TYPE_INT32, 1, pdata.body.data());
+    if (present[gsd_flag::particles_inertia])
+        writeParticleChunkParallel(fh,
+                                   "particles/moment_inertia",
+                                   GSD_TYPE_FLOAT,
+                                   3,
+                                   pdata.inertia.data());
+    if (present[gsd_flag::particles_position])
+        writeParticleChunkParallel(fh, "particles/position", GSD_TYPE_FLOAT, 3, pdata.pos.data());
+    if (present[gsd_flag::particles_orientation])
+        writeParticleChunkParallel(fh,
+                                   "particles/orientation",
+                                   GSD_TYPE_FLOAT,
+                                   4,
+                                   pdata.orientation.data());
+    if (present[gsd_flag::particles_velocity])
+        writeParticleChunkParallel(fh, "particles/velocity", GSD_TYPE_FLOAT, 3, pdata.vel.data());
+    if (present[gsd_flag::particles_angmom])
+        writeParticleChunkParallel(fh,
+                                   "particles/angmom",
+                                   GSD_TYPE_FLOAT,
+                                   4,
+                                   pdata.angmom.data());
+    if (present[gsd_flag::particles_image])
+        writeParticleChunkParallel(fh, "particles/image", GSD_TYPE_INT32, 3, pdata.image.data());
+
+    // closing the file completes the writes before rank 0 writes the index
+    MPI_File_close(&fh);
+
+    if (m_exec_conf->isRoot())
+        {
+        writeLogQuantities(log_data);
+        }
+    }
+
+/*! \param fh File opened with MPI-IO on all ranks
+    \param name Chunk name
+    \param type Chunk data type
+    \param M Number of columns
+    \param data Local rows of the chunk, in ascending tag order (one per local group member)
+
+    Row i of the chunk holds group member i, so each local particle goes to the row stored in
+    m_group_index (by populateLocalFrame()). The rows are scattered through the chunk, and a file
+    view with an indexed datatype writes them in one collective call.
+*/
+void GSDDumpWriter::writeParticleChunkParallel(MPI_File fh,
+                                               const char* name,
+                                               gsd_type type,
+                                               uint32_t M,
+                                               const void* data)
+    {
+    MPI_Comm mpi_comm = m_exec_conf->getMPICommunicator();
+    uint64_t N = m_group->getNumMembersGlobal();
+
+    int64_t location = 0;
+    if (m_exec_conf->isRoot())
+        {
+        m_exec_conf->msg->notice(10) << "GSD: writing " << name << " (MPI-IO)" << endl;
+        int retval = gsd_reserve_chunk(&m_handle, name, type, N, M, 0, &location);
+        GSDUtils::checkError(retval, m_fname);
+        }
+    MPI_Bcast(&location, 1, MPI_INT64_T, 0, mpi_comm);
+
+    MPI_Datatype row_type;
+    MPI_Type_contiguous((int)(M * gsd_sizeof_type(type)), MPI_BYTE, &row_type);
+    MPI_Type_commit(&row_type);
+
+    int n_local = (int)m_group_index.size();
+    MPI_Datatype file_type = row_type;
+    if (n_local > 0)
+        {
+        MPI_Type_create_indexed_block(n_local, 1, m_group_index.data(), row_type, &file_type);
+        MPI_Type_commit(&file_type);
+        }
+
+    MPI_File_set_view(fh, (MPI_Offset)location, MPI_BYTE, file_type, "native", MPI_INFO_NULL);
+    MPI_Status status;
+    int err = MPI_File_write_all(fh, data, n_local, row_type, &status);
+
+    if (n_local > 0)
+        {
+        MPI_Type_free(&file_type);
+        }
+    MPI_Type_free(&row_type);
+
+    if (err != MPI_SUCCESS)
+        {
+        throw std::runtime_error(std::string("GSD: error writing ") + name + " to " + m_fname
+                                 + " with MPI-IO");
+        }
+
+    // all ranks track the non-default chunks (see populateLocalFrame())
+    if (m_nframes == 0)
+        m_nondefault[name] = true;
+    }
+//~
+
 #endif
 
 namespace detail
@@ -1553,6 +2153,21 @@ void export_GSDDumpWriter(pybind11::module& m)
                       &GSDDumpWriter::getWriteDiameter,
                       &GSDDumpWriter::setWriteDiameter)
         .def("flush", &GSDDumpWriter::flush)
+        .def_property("async_write", &GSDDumpWriter::getAsyncWrite, &GSDDumpWriter::setAsyncWrite)
+        .def("wait_for_pending_frames", &GSDDumpWriter::waitForPendingFrames)
+        .def_property("trigger",
+                      &GSDDumpWriter::getMainTrigger,
+                      &GSDDumpWriter::setMainTrigger) //~ [RHEOINF]
+        .def("add_output_group", &GSDDumpWriter::addOutputGroup) //~ [RHEOINF]
+        .def_property("position_tolerance",
+                      &GSDDumpWriter::getPositionTolerance,
+                      &GSDDumpWriter::setPositionTolerance) //~ [RHEOINF]
+        .def_property("velocity_tolerance",
+                      &GSDDumpWriter::getVelocityTolerance,
+                      &GSDDumpWriter::setVelocityTolerance) //~ [RHEOINF]
+        .def_property("parallel_write",
+                      &GSDDumpWriter::getParallelWrite,
+                      &GSDDumpWriter::setParallelWrite) //~ [RHEOINF]
         .def_property("maximum_write_buffer_size",
                       &GSDDumpWriter::getMaximumWriteBufferSize,
                       &GSDDumpWriter::setMaximumWriteBufferSize);
@@ -1,6 +1,8 @@
 // Copyright (c) 2009-2023 The Regents of the University of Michigan.
 // Part of HOOMD-blue, released under the BSD 3-Clause License.
 
+// ########## Modified by Rheoinformatic //~ [RHEOINF] ##########
+
 #pragma once
 
 #include "Analyzer.h"
@@ -8,8 +10,15 @@
 #include "SharedSignal.h"
 
 #include "hoomd/extern/gsd.h"
+#include <cmath>              //~ [RHEOINF]
+#include <condition_variable> //~ [RHEOINF]
+#include <deque>              //~ [RHEOINF]
+#include <map>                //~ [RHEOINF]
 #include <memory>
+#include <mutex> //~ [RHEOINF]
 #include <string>
+#include <thread> //~ [RHEOINF]
+#include <vector> //~ [RHEOINF]
 
 /*! \file GSDDumpWriter.h
     \brief Declares the GSDDumpWriter class
@@ -30,6 +39,17 @@ namespace hoomd
 
     The file is not opened until the first call to analyze().
 
+    //~ With async writes, rank 0 records the chunks of each frame in memory and a background
+    //~ thread writes them to the file, so the simulation continues during the file I/O. [RHEOINF]
+
+    //~ With parallel writes (domain decomposition), every rank writes its own particles to the
+    //~ per-particle chunks with collective MPI-IO. Rank 0 writes the other chunks and the index, and
+    //~ the particle data is never gathered to rank 0. [RHEOINF]
+
+    //~ Output groups add (group, trigger, dynamic) sets to the same file. Each frame holds the
+    //~ union of the groups whose trigger fires (the constructor group with the main trigger is
+    //~ group 0), and log/gsd_groups/* chunks record which groups and tags it contains. [RHEOINF]
+
     \ingroup analyzers
 */
 class PYBIND11_EXPORT GSDDumpWriter : public Analyzer
@@ -128,6 +148,70 @@ class PYBIND11_EXPORT GSDDumpWriter : public Analyzer
     /// Get the maximum write buffer size (in bytes)
     uint64_t getMaximumWriteBufferSize();
 
+    //~ add asynchronous writes [RHEOINF]
+    /// Write frames from a background thread
+    void setAsyncWrite(bool async_write);
+
+    /// Check if frames are written from a background thread
+    bool getAsyncWrite()
+        {
+        return m_async_write;
+        }
+
+    /// Wait until the background thread has written all queued frames
+    void waitForPendingFrames();
+    //~
+
+    //~ add parallel writes [RHEOINF]
+    /// Write the per-particle chunks collectively with MPI-IO
+    void setParallelWrite(bool parallel_write)
+        {
+        m_parallel_write = parallel_write;
+        }
+
+    /// Check if the per-particle chunks are written collectively with MPI-IO
+    bool getParallelWrite()
+        {
+        return m_parallel_write;
+        }
+    //~
+
+    //~ add output groups [RHEOINF]
+    /// Add a group of particles written (with its dynamic fields) when its trigger fires
+    void addOutputGroup(std::shared_ptr<ParticleGroup> group,
+                        std::shared_ptr<Trigger> trigger,
+                        pybind11::object dynamic);
+
+    /// Get the trigger of the constructor group
+    std::shared_ptr<Trigger> getMainTrigger()
+        {
+        return m_main_trigger;
+        }
+
+    /// Set the trigger of the constructor group
+    void setMainTrigger(std::shared_ptr<Trigger> trigger);
+    //~
+
+    //~ add quantization [RHEOINF]
+    /// Set the maximum rounding error of written positions (0: full precision)
+    void setPositionTolerance(Scalar tolerance);
+
+    /// Get the maximum rounding error of written positions
+    Scalar getPositionTolerance()
+        {
+        return m_position_tolerance;
+        }
+
+    /// Set the maximum rounding error of written velocities (0: full precision)
+    void setVelocityTolerance(Scalar tolerance);
+
+    /// Get the maximum rounding error of written velocities
+    Scalar getVelocityTolerance()
+        {
+        return m_velocity_tolerance;
+        }
+    //~
+
     protected:
     gsd_handle m_handle; //!< Handle to the file
 
@@ -218,12 +302,48 @@ class PYBIND11_EXPORT GSDDumpWriter : public Analyzer
     /// Populate local frame with data.
     void populateLocalFrame(GSDFrame& frame, uint64_t timestep);
 
+    //~ add asynchronous writes [RHEOINF]
+    /// A chunk recorded for the background writer
+    struct GSDChunk
+        {
+        std::string name;
+        gsd_type type;
+        uint64_t N;
+        uint32_t M;
+        uint8_t flags;
+        std::vector<char> data;
+        };
+
+    /// Write a chunk to the file, or record it for the background writer in async mode
+    int writeChunk(const char* name,
+                   gsd_type type,
+                   uint64_t N,
+                   uint32_t M,
+                   uint8_t flags,
+                   const void* data);
+
+    /// End the frame, or hand the recorded frame to the background writer in async mode
+    void endFrame();
+    //~
+
 #ifdef ENABLE_MPI
     /// Copy of the state properties on all ranks, in ascending tag order globally.
     GSDFrame m_global_frame;
     GatherTagOrder m_gather_tag_order;
 
     void gatherGlobalFrame(const GSDFrame& local_frame);
+
+    //~ add parallel writes [RHEOINF]
+    /// Write a frame with every rank writing its own particles (collective)
+    void writeFrameParallel(const GSDFrame& local_frame, pybind11::dict log_data);
+
+    /// Write the local slice of a per-particle chunk at its tag ordered offsets (collective)
+    void writeParticleChunkParallel(MPI_File fh,
+                                    const char* name,
+                                    gsd_type type,
+                                    uint32_t M,
+                                    const void* data);
+    //~
 #endif
 
     private:
@@ -254,6 +374,96 @@ class PYBIND11_EXPORT GSDDumpWriter : public Analyzer
     /// Working array to sort local particles by tag
     std::vector<unsigned int> m_index;
 
+    //~ add asynchronous writes [RHEOINF]
+    bool m_async_write = false; //!< True when frames are written by the background thread
+
+    /// Frames queued while the background thread writes another (bounded double buffering)
+    static const unsigned int m_max_queued_frames = 1;
+
+    std::vector<GSDChunk> m_pending;                 //!< Chunks of the frame being recorded
+    size_t m_n_pending = 0;                          //!< Number of chunks recorded in m_pending
+    std::deque<std::vector<GSDChunk>> m_queue;       //!< Frames waiting for the writer thread
+    std::vector<std::vector<GSDChunk>> m_recycled;   //!< Written frames (reuse their buffers)
+    std::thread m_writer_thread;                     //!< Background writer
+    std::mutex m_queue_mutex;                        //!< Protects the queue and the flags below
+    std::condition_variable m_queue_cv;              //!< Signals queue changes
+    bool m_writer_busy = false;                      //!< True while a frame is being written
+    bool m_stop_writer = false;                      //!< Request the writer thread to exit
+    std::string m_writer_error;                      //!< First error in the writer thread
+
+    /// Start the background writer
+    void startWriterThread();
+
+    /// Write all queued frames and stop the background writer
+    void stopWriterThread();
+
+    /// Main loop of the background writer
+    void writerThreadLoop();
+
+    /// Raise errors from the background writer on the calling thread
+    void checkWriterError();
+    //~
+
+    //~ add parallel writes [RHEOINF]
+    bool m_parallel_write = false;          //!< True to write particle data with MPI-IO
+    bool m_writing_parallel_frame = false;  //!< True while rank 0 writes a parallel frame
+
+    /// Index of each local particle in the group (its row in the per-particle chunks)
+    std::vector<int> m_group_index;
+    //~
+
+    //~ add output groups [RHEOINF]
+    /// Particles written with their own trigger and dynamic fields
+    struct OutputGroup
+        {
+        std::shared_ptr<ParticleGroup> group;
+        std::shared_ptr<Trigger> trigger;
+        std::bitset<n_gsd_flags> dynamic;
+        };
+
+    /// Maximum number of output groups (the groups in a frame are stored as bits of a uint64_t)
+    static const unsigned int m_max_output_groups = 63;
+
+    std::vector<OutputGroup> m_output_groups;     //!< Groups added to the constructor group
+    std::shared_ptr<Trigger> m_main_trigger;      //!< Trigger of the constructor group
+    std::shared_ptr<ParticleGroup> m_main_group;  //!< The constructor group
+    uint64_t m_frame_mask = 1;                    //!< Groups in the current frame (bit 0: main)
+    uint64_t m_frame0_mask = 1;                   //!< Groups in frame 0
+    bool m_frame0_mask_known = false;             //!< False when appending to an existing file
+
+    /// Union of several groups, with the member tags of the groups it was built from
+    struct UnionGroup
+        {
+        std::vector<unsigned int> source_tags;
+        std::shared_ptr<ParticleGroup> group;
+        };
+
+    /// Union groups by group mask
+    std::map<uint64_t, UnionGroup> m_union_groups;
+
+    /// Set m_group and m_dynamic to the particles and fields of the frame at \a timestep
+    void selectFrameParticles(uint64_t timestep);
+
+    /// Write the groups and tags of the particles in the current frame
+    void writeFrameSelection();
+    //~
+
+    //~ add quantization [RHEOINF]
+    Scalar m_position_tolerance = 0.0; //!< Maximum rounding error of positions
+    Scalar m_velocity_tolerance = 0.0; //!< Maximum rounding error of velocities
+    Scalar m_position_step = 0.0;      //!< Position quantization step (0: off)
+    Scalar m_velocity_step = 0.0;      //!< Velocity quantization step (0: off)
+
+    /// Largest power of two step with a rounding error within \a tolerance
+    static Scalar quantizationStep(Scalar tolerance);
+
+    /// Round \a x to the nearest multiple of \a step
+    static Scalar quantizeValue(Scalar x, Scalar step)
+        {
+        return step * std::round(x / step);
+        }
+    //~
+
     //! Write a type mapping out to the file
     void writeTypeMapping(std::string chunk, std::vector<std::string> type_mapping);
 
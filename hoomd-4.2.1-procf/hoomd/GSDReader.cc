@@ -1,11 +1,15 @@
 // Copyright (c) 2009-2023 The Regents of the University of Michigan.
 // Part of HOOMD-blue, released under the BSD 3-Clause License.
 
+// ########## Modified by Rheoinformatic //~ [RHEOINF] ##########
+
 #include "GSDReader.h"
 #include "ExecutionConfiguration.h"
 #include "GSD.h"
 #include "SnapshotSystemData.h"
+#include "SystemDefinition.h" //~ [RHEOINF]
 #include "hoomd/extern/gsd.h"
+#include <algorithm> //~ [RHEOINF]
 #include <sstream>
 #include <string.h>
 
@@ -15,10 +19,116 @@ using namespace hoomd::detail;
 
 namespace hoomd
     {
+//~ per-particle chunks read by GSDReader::readParticlesDistributed() [RHEOINF]
+namespace
+    {
+//! Per-particle chunk read in slabs
+struct GSDParticleChunk
+    {
+    const char* name; //!< Chunk name
+    unsigned int M;   //!< Number of columns (all per-particle chunks have 4 byte values)
+    };
+
+//! Index of each chunk in gsd_particle_chunks
+enum gsd_particle_chunk_index
+    {
+    chunk_typeid = 0,
+    chunk_mass,
+    chunk_charge,
+    chunk_diameter,
+    chunk_body,
+    chunk_moment_inertia,
+    chunk_position,
+    chunk_orientation,
+    chunk_velocity,
+    chunk_angmom,
+    chunk_image,
+    n_gsd_particle_chunks
+    };
+
+//! The chunks read by GSDReader::readParticles()
+const GSDParticleChunk gsd_particle_chunks[n_gsd_particle_chunks]
+    = {{"particles/typeid", 1},
+       {"particles/mass", 1},
+       {"particles/charge", 1},
+       {"particles/diameter", 1},
+       {"particles/body", 1},
+       {"particles/moment_inertia", 3},
+       {"particles/position", 3},
+       {"particles/orientation", 4},
+       {"particles/velocity", 3},
+       {"particles/angmom", 4},
+       {"particles/image", 3}};
+
+//! Copy the rows of one chunk into the particles
+/*! \param c Chunk index
+    \param data Rows of the chunk, one per particle
+    \param particles Particles to fill
+*/
+void unpackParticleChunk(unsigned int c,
+                         const char* data,
+                         std::vector<detail::pdata_element>& particles)
+    {
+    const size_t row_bytes = gsd_particle_chunks[c].M * 4;
+    for (size_t i = 0; i < particles.size(); i++)
+        {
+        detail::pdata_element& p = particles[i];
+        const char* row = data + i * row_bytes;
+        float f[4];
+        int32_t v[4];
+        memcpy(f, row, row_bytes);
+        memcpy(v, row, row_bytes);
+
+        switch (c)
+            {
+        case chunk_typeid:
+            p.pos.w = __int_as_scalar(v[0]);
+            break;
+        case chunk_mass:
+            p.vel.w = f[0];
+            break;
+        case chunk_charge:
+            p.charge = f[0];
+            break;
+        case chunk_diameter:
+            p.diameter = f[0];
+            break;
+        case chunk_body:
+            p.body = (unsigned int)v[0];
+            break;
+        case chunk_moment_inertia:
+            p.inertia = make_scalar3(f[0], f[1], f[2]);
+            break;
+        case chunk_position:
+            p.pos.x = f[0];
+            p.pos.y = f[1];
+            p.pos.z = f[2];
+            break;
+        case chunk_orientation:
+            p.orientation = make_scalar4(f[0], f[1], f[2], f[3]);
+            break;
+        case chunk_velocity:
+            p.vel.x = f[0];
+            p.vel.y = f[1];
+            p.vel.z = f[2];
+            break;
+        case chunk_angmom:
+            p.angmom = make_scalar4(f[0], f[1], f[2], f[3]);
+            break;
+        case chunk_image:
+            p.image = make_int3(v[0], v[1], v[2]);
+            break;
+            }
+        }
+    }
+    } // end anonymous namespace
+//~
+
 /*! \param exec_conf The execution configuration
     \param name File name to read
     \param frame Frame index to read from the file
     \param from_end Count frames back from the end of the file
+    \param distributed Leave the particles for readParticlesDistributed() [RHEOINF]
 
     The GSDReader constructor opens the GSD file, initializes an empty snapshot, and reads the file
    into memory (on the root rank).
@@ -26,10 +136,20 @@ namespace hoomd
 GSDReader::GSDReader(std::shared_ptr<const ExecutionConfiguration> exec_conf,
                      const std::string& name,
                      const uint64_t frame,
-                     bool from_end)
-    : m_exec_conf(exec_conf), m_timestep(0), m_name(name), m_frame(frame)
+                     //~ add distributed read [RHEOINF]
+                     //~ bool from_end)
+                     bool from_end,
+                     bool distributed)
+    //~ : m_exec_conf(exec_conf), m_timestep(0), m_name(name), m_frame(frame)
+    : m_exec_conf(exec_conf), m_timestep(0), m_name(name), m_frame(frame),
+      m_distributed(distributed), m_n_particles(0)
+    //~
     {
     m_snapshot = std::shared_ptr<SnapshotSystemData<float>>(new SnapshotSystemData<float>);
+    //~ add distributed read [RHEOINF]
+    if (m_distributed)
+        m_topology = std::shared_ptr<SnapshotSystemData<float>>(new SnapshotSystemData<float>);
+    //~
 
 #ifdef ENABLE_MPI
     // if we are not the root processor, do not perform file I/O
@@ -73,8 +193,22 @@ GSDReader::GSDReader(std::shared_ptr<const ExecutionConfiguration> exec_conf,
         }
 
     readHeader();
-    readParticles();
-    readTopology();
+    //~ add distributed read [RHEOINF]
+    //~ readParticles();
+    //~ readTopology();
+    if (m_distributed)
+        {
+        m_snapshot->particle_data.type_mapping = readTypes(m_frame, "particles/types");
+        findParticleChunks();
+        readTopology();
+        splitTopology();
+        }
+    else
+        {
+        readParticles();
+        readTopology();
+        }
+    //~
     }
 
 GSDReader::~GSDReader()
@@ -210,7 +344,12 @@ void GSDReader::readHeader()
         s << "Cannot read a file with 0 particles.";
         throw runtime_error(s.str());
         }
-    m_snapshot->particle_data.resize(N);
+    //~ add distributed read [RHEOINF]
+    //~ m_snapshot->particle_data.resize(N);
+    m_n_particles = N;
+    if (!m_distributed)
+        m_snapshot->particle_data.resize(N);
+    //~
     }
 
 /*! Read the same data chunks for particles
@@ -314,6 +453,310 @@ void GSDReader::readTopology()
         }
     }
 
+//~ add distributed read [RHEOINF]
+/*! Find the per-particle chunks of the frame with the same rules as readChunk(): fall back to
+    frame 0, and keep the default when the chunk is missing or its N does not match.
+*/
+void GSDReader::findParticleChunks()
+    {
+    m_particle_chunks.assign(n_gsd_particle_chunks, gsd_index_entry());
+
+    for (unsigned int c = 0; c < n_gsd_particle_chunks; c++)
+        {
+        const char* name = gsd_particle_chunks[c].name;
+        const struct gsd_index_entry* entry = gsd_find_chunk(&m_handle, m_frame, name);
+        if (entry == NULL && m_frame != 0)
+            entry = gsd_find_chunk(&m_handle, 0, name);
+
+        if (entry == NULL || entry->N != m_n_particles)
+            {
+            m_exec_conf->msg->notice(10) << "data.gsd_snapshot: chunk not found " << name << endl;
+            continue;
+            }
+
+        size_t expected_size = size_t(m_n_particles) * gsd_particle_chunks[c].M * 4;
+        size_t actual_size = entry->N * entry->M * gsd_sizeof_type((enum gsd_type)entry->type);
+        if (actual_size != expected_size)
+            {
+            std::ostringstream s;
+            s << "Expecting " << expected_size << " bytes in " << name << " but found "
+              << actual_size << ".";
+            throw runtime_error(s.str());
+            }
+
+        m_particle_chunks[c] = *entry;
+        }
+    }
+
+/*! The system definition is constructed before the particles are read, so bonded groups cannot
+    be placed on their ranks yet. Keep them in m_topology until readParticlesDistributed() and
+    leave only the type names in the snapshot.
+*/
+void GSDReader::splitTopology()
+    {
+    std::swap(m_topology->bond_data, m_snapshot->bond_data);
+    m_snapshot->bond_data.type_mapping = m_topology->bond_data.type_mapping;
+    std::swap(m_topology->angle_data, m_snapshot->angle_data);
+    m_snapshot->angle_data.type_mapping = m_topology->angle_data.type_mapping;
+    std::swap(m_topology->dihedral_data, m_snapshot->dihedral_data);
+    m_snapshot->dihedral_data.type_mapping = m_topology->dihedral_data.type_mapping;
+    std::swap(m_topology->improper_data, m_snapshot->improper_data);
+    m_snapshot->improper_data.type_mapping = m_topology->improper_data.type_mapping;
+    std::swap(m_topology->constraint_data, m_snapshot->constraint_data);
+    std::swap(m_topology->pair_data, m_snapshot->pair_data);
+    m_snapshot->pair_data.type_mapping = m_topology->pair_data.type_mapping;
+    }
+
+/*! \param sysdef System definition constructed from getSnapshot()
+
+    Rank r of P reads rows [N r / P, N (r + 1) / P) of each per-particle chunk in the frame with
+    one collective MPI-IO read per chunk. The particles start from the GSD schema defaults, keep
+    their row as their tag, and are placed on their domains with the same rules as
+    ParticleData::initializeFromSnapshot(). One MPI_Alltoallv sends them to their ranks. The
+    topology read by the root rank is set last, once the particles are local.
+*/
+void GSDReader::readParticlesDistributed(std::shared_ptr<SystemDefinition> sysdef)
+    {
+    if (!m_distributed || !m_topology)
+        {
+        throw runtime_error("GSDReader was not opened for a distributed read, or already read.");
+        }
+
+    std::shared_ptr<ParticleData> pdata = sysdef->getParticleData();
+    unsigned int N = m_n_particles;
+    std::vector<gsd_index_entry> chunks(m_particle_chunks);
+    chunks.resize(n_gsd_particle_chunks);
+    unsigned int rank = 0;
+    unsigned int n_ranks = 1;
+
+#ifdef ENABLE_MPI
+    const MPI_Comm mpi_comm = m_exec_conf->getMPICommunicator();
+    rank = m_exec_conf->getRank();
+    n_ranks = m_exec_conf->getNRanks();
+    bcast(N, 0, mpi_comm);
+    MPI_Bcast(chunks.data(),
+              (int)(chunks.size() * sizeof(gsd_index_entry)),
+              MPI_BYTE,
+              0,
+              mpi_comm);
+#endif
+
+    // contiguous slab of rows read by this rank
+    const uint64_t first = uint64_t(N) * rank / n_ranks;
+    const unsigned int n_slab = (unsigned int)(uint64_t(N) * (rank + 1) / n_ranks - first);
+
+    // defaults per the GSD HOOMD schema (value initialization zeroes the rest)
+    std::vector<detail::pdata_element> slab(n_slab);
+    for (unsigned int i = 0; i < n_slab; i++)
+        {
+        detail::pdata_element& p = slab[i];
+        p.pos = make_scalar4(0, 0, 0, __int_as_scalar(0));
+        p.vel = make_scalar4(0, 0, 0, 1);
+        p.diameter = 1;
+        p.body = NO_BODY;
+        p.orientation = make_scalar4(1, 0, 0, 0);
+        p.tag = (unsigned int)(first + i);
+        }
+
+#ifdef ENABLE_MPI
+    MPI_File fh;
+    int err = MPI_File_open(mpi_comm, m_name.c_str(), MPI_MODE_RDONLY, MPI_INFO_NULL, &fh);
+    if (err != MPI_SUCCESS)
+        {
+        throw std::runtime_error("GSD: error opening " + m_name + " with MPI-IO");
+        }
+#endif
+
+    std::vector<char> buffer;
+    for (unsigned int c = 0; c < n_gsd_particle_chunks; c++)
+        {
+        if (chunks[c].N == 0)
+            continue;
+
+        m_exec_conf->msg->notice(7) << "data.gsd_snapshot: reading chunk "
+                                    << gsd_particle_chunks[c].name << " (distributed)" << endl;
+        const size_t row_bytes = gsd_particle_chunks[c].M * 4;
+        buffer.resize(std::max(size_t(n_slab) * row_bytes, size_t(1)));
+
+#ifdef ENABLE_MPI
+        MPI_Datatype row_type;
+        MPI_Type_contiguous((int)row_bytes, MPI_BYTE, &row_type);
+        MPI_Type_commit(&row_type);
+        MPI_Status status;
+        err = MPI_File_read_at_all(fh,
+                                   (MPI_Offset)(chunks[c].location + first * row_bytes),
+                                   buffer.data(),
+                                   (int)n_slab,
+                                   row_type,
+                                   &status);
+        MPI_Type_free(&row_type);
+        if (err != MPI_SUCCESS)
+            {
+            MPI_File_close(&fh);
+            throw std::runtime_error(std::string("GSD: error reading ")
+                                     + gsd_particle_chunks[c].name + " from " + m_name
+                                     + " with MPI-IO");
+            }
+#else
+        // a single rank reads the whole chunk
+        int retval = gsd_read_chunk(&m_handle, buffer.data(), &chunks[c]);
+        GSDUtils::checkError(retval, m_name);
+#endif
+
+        unpackParticleChunk(c, buffer.data(), slab);
+        }
+
+#ifdef ENABLE_MPI
+    MPI_File_close(&fh);
+#endif
+    std::vector<char>().swap(buffer);
+
+    // validate the type ids on all ranks, so that all of them throw together
+    unsigned int max_typeid = 0;
+    for (unsigned int i = 0; i < n_slab; i++)
+        max_typeid = std::max(max_typeid, (unsigned int)__scalar_as_int(slab[i].pos.w));
+#ifdef ENABLE_MPI
+    MPI_Allreduce(MPI_IN_PLACE, &max_typeid, 1, MPI_UNSIGNED, MPI_MAX, mpi_comm);
+#endif
+    if (N != 0 && max_typeid >= pdata->getNTypes())
+        {
+        std::ostringstream s;
+        s << "Particle typeid " << max_typeid << " is invalid in a system with "
+          << pdata->getNTypes() << " types.";
+        throw runtime_error(s.str());
+        }
+
+    std::vector<detail::pdata_element> local;
+#ifdef ENABLE_MPI
+    std::shared_ptr<DomainDecomposition> decomposition = pdata->getDomainDecomposition();
+    if (decomposition)
+        {
+        // place the particles in domains
+        std::vector<unsigned int> dest(n_slab);
+        unsigned int n_out_of_bounds = 0;
+            {
+            ArrayHandle<unsigned int> h_cart_ranks(decomposition->getCartRanks(),
+                                                   access_location::host,
+                                                   access_mode::read);
+            const Index3D& di = decomposition->getDomainIndexer();
+            const BoxDim& box = pdata->getGlobalBox();
+            BoxDim global_box = box;
+
+            for (unsigned int idx = 0; idx < n_slab; idx++)
+                {
+                detail::pdata_element& p = slab[idx];
+                Scalar3 pos = make_scalar3(p.pos.x, p.pos.y, p.pos.z);
+                Scalar3 f = box.makeFraction(pos);
+                int i = int(f.x * ((Scalar)di.getW()));
+                int j = int(f.y * ((Scalar)di.getH()));
+                int k = int(f.z * ((Scalar)di.getD()));
+
+                // wrap particles that are exactly on a boundary
+                char3 flags = make_char3(0, 0, 0);
+                if (i == (int)di.getW())
+                    flags.x = 1;
+                if (j == (int)di.getH())
+                    flags.y = 1;
+                if (k == (int)di.getD())
+                    flags.z = 1;
+
+                uchar3 periodic = make_uchar3(flags.x, flags.y, flags.z);
+                global_box.setPeriodic(periodic);
+                global_box.wrap(pos, p.image, flags);
+                p.pos.x = pos.x;
+                p.pos.y = pos.y;
+                p.pos.z = pos.z;
+
+                dest[idx] = decomposition->placeParticle(global_box, pos, h_cart_ranks.data);
+                if (dest[idx] >= n_ranks)
+                    {
+                    if (n_out_of_bounds == 0)
+                        {
+                        m_exec_conf->msg->errorAllRanks()
+                            << "init.*: Particle " << p.tag << " out of bounds at x: " << pos.x
+                            << " y: " << pos.y << " z: " << pos.z << std::endl;
+                        }
+                    n_out_of_bounds++;
+                    dest[idx] = rank;
+                    }
+                }
+            }
+
+        MPI_Allreduce(MPI_IN_PLACE, &n_out_of_bounds, 1, MPI_UNSIGNED, MPI_SUM, mpi_comm);
+        if (n_out_of_bounds > 0)
+            {
+            std::ostringstream s;
+            s << "init.*: " << n_out_of_bounds << " particles are out of bounds.";
+            throw std::runtime_error(s.str());
+            }
+
+        // sort the particles by destination rank, keeping the tag order
+        std::vector<int> send_counts(n_ranks, 0);
+        std::vector<int> send_displs(n_ranks, 0);
+        std::vector<int> recv_counts(n_ranks, 0);
+        std::vector<int> recv_displs(n_ranks, 0);
+        for (unsigned int idx = 0; idx < n_slab; idx++)
+            send_counts[dest[idx]]++;
+        for (unsigned int r = 1; r < n_ranks; r++)
+            send_displs[r] = send_displs[r - 1] + send_counts[r - 1];
+
+        std::vector<detail::pdata_element> send_buf(n_slab);
+            {
+            std::vector<int> offset(send_displs);
+            for (unsigned int idx = 0; idx < n_slab; idx++)
+                send_buf[offset[dest[idx]]++] = slab[idx];
+            }
+        std::vector<detail::pdata_element>().swap(slab);
+
+        MPI_Alltoall(send_counts.data(), 1, MPI_INT, recv_counts.data(), 1, MPI_INT, mpi_comm);
+        for (unsigned int r = 1; r < n_ranks; r++)
+            recv_displs[r] = recv_displs[r - 1] + recv_counts[r - 1];
+        local.resize(recv_displs[n_ranks - 1] + recv_counts[n_ranks - 1]);
+
+        MPI_Datatype element_type;
+        MPI_Type_contiguous((int)sizeof(detail::pdata_element), MPI_BYTE, &element_type);
+        MPI_Type_commit(&element_type);
+        MPI_Alltoallv(send_buf.data(),
+                      send_counts.data(),
+                      send_displs.data(),
+                      element_type,
+                      local.data(),
+                      recv_counts.data(),
+                      recv_displs.data(),
+                      element_type,
+                      mpi_comm);
+        MPI_Type_free(&element_type);
+        }
+    else
+#endif
+        {
+        local.swap(slab);
+        }
+
+    pdata->initializeFromLocalParticles(local, N);
+
+    // set the bonded groups now that their members are local
+    bool has_topology = m_topology->bond_data.size > 0 || m_topology->angle_data.size > 0
+                        || m_topology->dihedral_data.size > 0
+                        || m_topology->improper_data.size > 0
+                        || m_topology->constraint_data.size > 0
+                        || m_topology->pair_data.size > 0;
+#ifdef ENABLE_MPI
+    bcast(has_topology, 0, mpi_comm);
+#endif
+    if (has_topology)
+        {
+        sysdef->getBondData()->initializeFromSnapshot(m_topology->bond_data);
+        sysdef->getAngleData()->initializeFromSnapshot(m_topology->angle_data);
+        sysdef->getDihedralData()->initializeFromSnapshot(m_topology->dihedral_data);
+        sysdef->getImproperData()->initializeFromSnapshot(m_topology->improper_data);
+        sysdef->getConstraintData()->initializeFromSnapshot(m_topology->constraint_data);
+        sysdef->getPairData()->initializeFromSnapshot(m_topology->pair_data);
+        }
+    m_topology.reset();
+    }
+//~
+
 pybind11::list GSDReader::readTypeShapesPy(uint64_t frame)
     {
     std::vector<std::string> type_mapping = this->readTypes(frame, "particles/type_shapes");
@@ -332,6 +775,14 @@ void export_GSDReader(pybind11::module& m)
                             const string&,
                             const uint64_t,
                             bool>())
+        //~ add distributed read [RHEOINF]
+        .def(pybind11::init<std::shared_ptr<const ExecutionConfiguration>,
+                            const string&,
+                            const uint64_t,
+                            bool,
+                            bool>())
+        .def("readParticlesDistributed", &GSDReader::readParticlesDistributed)
+        //~
         .def("getTimeStep", &GSDReader::getTimeStep)
         .def("getSnapshot", &GSDReader::getSnapshot)
         .def("clearSnapshot", &GSDReader::clearSnapshot)
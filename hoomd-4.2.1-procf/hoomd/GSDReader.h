@@ -1,6 +1,8 @@
 // Copyright (c) 2009-2023 The Regents of the University of Michigan.
 // Part of HOOMD-blue, released under the BSD 3-Clause License.
 
+// ########## Modified by Rheoinformatic //~ [RHEOINF] ##########
+
 #ifdef __HIPCC__
 #error This header cannot be compiled by nvcc
 #endif
@@ -8,6 +10,7 @@
 #include "ParticleData.h"
 #include "hoomd/extern/gsd.h"
 #include <string>
+#include <vector> //~ [RHEOINF]
 
 #include <pybind11/numpy.h>
 #include <pybind11/pybind11.h>
@@ -19,11 +22,18 @@ namespace hoomd
     {
 //! Forward declarations
 template<class Real> struct SnapshotSystemData;
+class SystemDefinition; //~ [RHEOINF]
 
 //! Reads a GSD input file
 /*! Read an input GSD file and generate a system snapshot. GSDReader can read any frame from a GSD
     file into the snapshot. For information on the GSD specification, see http://gsd.readthedocs.io/
 
+    Distributed read [RHEOINF]: with \a distributed set, the root rank reads only the header, the
+    type names, and the topology, so the snapshot has no particles. After the SystemDefinition is
+    constructed from it (with its domain decomposition), readParticlesDistributed() reads the
+    particles: every rank reads a contiguous slab of rows of each particle chunk and sends each
+    particle to the rank that owns it. No rank ever holds all particles.
+
     \ingroup data_structs
 */
 class PYBIND11_EXPORT GSDReader
@@ -33,7 +43,11 @@ class PYBIND11_EXPORT GSDReader
     GSDReader(std::shared_ptr<const ExecutionConfiguration> exec_conf,
               const std::string& name,
               const uint64_t frame,
-              bool from_end);
+              //~ add distributed read [RHEOINF]
+              //~ bool from_end);
+              bool from_end,
+              bool distributed = false);
+    //~
 
     //! Destructor
     ~GSDReader();
@@ -85,6 +99,11 @@ class PYBIND11_EXPORT GSDReader
 
     pybind11::list readTypeShapesPy(uint64_t frame);
 
+    //~ add distributed read [RHEOINF]
+    //! Read the particles in slabs on all ranks and place them on their domains (collective)
+    void readParticlesDistributed(std::shared_ptr<SystemDefinition> sysdef);
+    //~
+
     private:
     std::shared_ptr<const ExecutionConfiguration> m_exec_conf; //!< The execution configuration
     uint64_t m_timestep;                                       //!< Timestep at the selected frame
@@ -93,6 +112,19 @@ class PYBIND11_EXPORT GSDReader
     std::shared_ptr<SnapshotSystemData<float>> m_snapshot;     //!< The snapshot to read
     gsd_handle m_handle;                                       //!< Handle to the file
 
+    //~ add distributed read [RHEOINF]
+    bool m_distributed;          //!< True when the particles are read by readParticlesDistributed()
+    unsigned int m_n_particles;  //!< Number of particles in the frame (root rank)
+    std::vector<gsd_index_entry> m_particle_chunks; //!< Per-particle chunks (N = 0 when absent)
+    std::shared_ptr<SnapshotSystemData<float>> m_topology; //!< Topology to set after the particles
+
+    //! Find the per-particle chunks of the frame
+    void findParticleChunks();
+
+    //! Move the bonded groups out of the snapshot, keeping the type names
+    void splitTopology();
+    //~
+
     //! Helper function to read a type list from the file
     std::vector<std::string> readTypes(uint64_t frame, const char* name);
 
@@ -914,6 +914,11 @@ CommFlags Integrator::determineFlags(uint64_t timestep)
     return flags;
     }
 
+//~ [RHEOINF]
+/*! ForceCompute::preCompute() does not move particles, so this callback does not connect to
+    Communicator::getComputeCallbackMovesParticlesSignal().
+*/
+//~
 void Integrator::computeCallback(uint64_t timestep)
     {
     // pre-compute all active forces
@@ -1,6 +1,8 @@
 // Copyright (c) 2009-2023 The Regents of the University of Michigan.
 // Part of HOOMD-blue, released under the BSD 3-Clause License.
 
+// ########## Modified by Rheoinformatic //~ [RHEOINF] ##########
+
 /*! \file LoadBalancer.cc
     \brief Defines the LoadBalancer class
 */
@@ -34,6 +36,9 @@ LoadBalancer::LoadBalancer(std::shared_ptr<SystemDefinition> sysdef,
 #endif
       m_max_imbalance(Scalar(1.0)), m_recompute_max_imbalance(true), m_needs_migrate(false),
       m_needs_recount(false), m_tolerance(Scalar(1.05)), m_maxiter(1), m_max_scale(Scalar(0.05)),
+      m_weighting(weighting::particles),
+      m_type_weights(m_pdata->getNTypes(), Scalar(1.0)), //~ [RHEOINF]
+      m_time_weight(Scalar(1.0)), m_W_own(Scalar(0.0)), m_W_total(Scalar(0.0)), //~ [RHEOINF]
       m_N_own(m_pdata->getN()), m_max_max_imbalance(1.0), m_total_max_imbalance(0.0), m_n_calls(0),
       m_n_iterations(0), m_n_rebalances(0)
     {
@@ -64,8 +69,60 @@ LoadBalancer::LoadBalancer(std::shared_ptr<SystemDefinition> sysdef,
 LoadBalancer::~LoadBalancer()
     {
     m_exec_conf->msg->notice(5) << "Destroying LoadBalancer" << endl;
+
+    //~ stop timing the force computations [RHEOINF]
+    if (m_weighting == weighting::time)
+        m_sysdef->setForceComputeTiming(false);
+    //~
+    }
+
+//~ add cost-weighted load balancing [RHEOINF]
+void LoadBalancer::setWeighting(const std::string& name)
+    {
+    if (name == "particles")
+        m_weighting = weighting::particles;
+    else if (name == "time")
+        m_weighting = weighting::time;
+    else if (name == "type")
+        m_weighting = weighting::type;
+    else
+        throw std::invalid_argument("LoadBalancer: unknown weighting " + name);
+
+    // time the force computations only when they are used
+    m_sysdef->setForceComputeTiming(m_weighting == weighting::time);
+    if (m_weighting == weighting::time && m_exec_conf->isCUDAEnabled())
+        {
+        m_exec_conf->msg->warning()
+            << "LoadBalancer: GPU kernels run asynchronously, the measured force compute time "
+               "does not reflect the load"
+            << endl;
+        }
+    }
+
+std::string LoadBalancer::getWeighting() const
+    {
+    if (m_weighting == weighting::time)
+        return "time";
+    else if (m_weighting == weighting::type)
+        return "type";
+    return "particles";
     }
 
+void LoadBalancer::setTypeWeights(const std::string& type_name, Scalar weight)
+    {
+    unsigned int typ = m_pdata->getTypeByName(type_name);
+    if (weight <= Scalar(0.0))
+        throw std::invalid_argument("LoadBalancer: type weights must be positive");
+    m_type_weights[typ] = weight;
+    }
+
+Scalar LoadBalancer::getTypeWeights(const std::string& type_name)
+    {
+    unsigned int typ = m_pdata->getTypeByName(type_name);
+    return m_type_weights[typ];
+    }
+//~
+
 /*!
  * \param timestep Current time step of the simulation
  *
@@ -84,6 +141,12 @@ void LoadBalancer::update(uint64_t timestep)
     // no adjustment has been made yet, so set m_N_own to the number of particles on the rank
     resetNOwn(m_pdata->getN());
 
+    //~ measure the load of the rank [RHEOINF]
+    const bool weighted = (m_weighting != weighting::particles);
+    if (weighted)
+        initializeWeights();
+    //~
+
     // figure out which rank is the reduction root for broadcasting
     const Index3D& di = m_decomposition->getDomainIndexer();
     unsigned int reduce_root(0);
@@ -140,16 +203,25 @@ void LoadBalancer::update(uint64_t timestep)
                 }
 
             vector<unsigned int> N_i;
+            vector<Scalar> W_i; //~ [RHEOINF]
             bool adjusted = false;
 
             // reduce the number of particles in the slice along dim
-            bool active = reduce(N_i, dim, reduce_root);
+            /* bool active = reduce(N_i, dim, reduce_root); */ //~ [RHEOINF]
+            //~ or the load, when weighted [RHEOINF]
+            bool active = weighted ? reduceWeights(W_i, dim, reduce_root)
+                                   : reduce(N_i, dim, reduce_root);
+            //~
 
             // attempt an adjustment
             vector<Scalar> cum_frac = m_decomposition->getCumulativeFractions(dim);
             if (active)
                 {
-                adjusted = adjust(cum_frac, N_i, L_i, min_frac_i);
+                /* adjusted = adjust(cum_frac, N_i, L_i, min_frac_i); */ //~ [RHEOINF]
+                //~ balance the load, when weighted [RHEOINF]
+                adjusted = weighted ? adjust(cum_frac, W_i, m_W_total, L_i, min_frac_i)
+                                    : adjust(cum_frac, N_i, L_i, min_frac_i);
+                //~
                 }
 
             // broadcast if an adjustment has been made on the root
@@ -167,9 +239,18 @@ void LoadBalancer::update(uint64_t timestep)
         // force a particle migration if one is needed
         if (m_needs_migrate)
             {
+            //~ the measured cost moves with the particles [RHEOINF]
+            Scalar W_own = (m_weighting == weighting::time) ? getWOwn() : Scalar(0.0);
+            //~
             m_comm->forceMigrate();
             m_comm->communicate(timestep);
             resetNOwn(m_pdata->getN());
+            //~ update the load of the rank (spread the received cost evenly) [RHEOINF]
+            if (m_weighting == weighting::time && m_pdata->getN() > 0)
+                m_time_weight = W_own / Scalar(m_pdata->getN());
+            if (weighted)
+                resetWOwn(computeLocalWeight());
+            //~
             m_needs_migrate = false;
 
             // increment the number of rebalances actually performed
@@ -189,8 +270,16 @@ Scalar LoadBalancer::getMaxImbalance()
     {
     if (m_recompute_max_imbalance)
         {
-        Scalar cur_imb = Scalar(getNOwn())
-                         / (Scalar(m_pdata->getNGlobal()) / Scalar(m_exec_conf->getNRanks()));
+        /* Scalar cur_imb = Scalar(getNOwn())
+                         / (Scalar(m_pdata->getNGlobal()) / Scalar(m_exec_conf->getNRanks())); */ //~ [RHEOINF]
+        //~ imbalance of the load, when weighted [RHEOINF]
+        Scalar cur_imb;
+        if (m_weighting != weighting::particles)
+            cur_imb = getWOwn() / (m_W_total / Scalar(m_exec_conf->getNRanks()));
+        else
+            cur_imb = Scalar(getNOwn())
+                      / (Scalar(m_pdata->getNGlobal()) / Scalar(m_exec_conf->getNRanks()));
+        //~
         Scalar max_imb(0.0);
         MPI_Allreduce(&cur_imb, &max_imb, 1, MPI_HOOMD_SCALAR, MPI_MAX, m_mpi_comm);
 
@@ -333,11 +422,36 @@ bool LoadBalancer::adjust(vector<Scalar>& cum_frac_i,
                           Scalar L_i,
                           Scalar min_frac_i)
     {
+    //~ the particle count is the load [RHEOINF]
+    vector<Scalar> W_i(N_i.begin(), N_i.end());
+    return adjust(cum_frac_i, W_i, Scalar(m_pdata->getNGlobal()), L_i, min_frac_i);
+    //~
+    }
+
+//~ balance a general load per slice [RHEOINF]
+/*!
+ * \param cum_frac_i The cumulative fraction array to write output into
+ * \param W_i The reduced load along the dimension
+ * \param W_total The total load
+ * \param L_i The global box length along the dimension
+ * \param min_frac_i The minimum fractional width of a domain
+ *
+ * \returns true if an adjustment occurred
+ */
+bool LoadBalancer::adjust(vector<Scalar>& cum_frac_i,
+                          const vector<Scalar>& W_i,
+                          Scalar W_total,
+                          Scalar L_i,
+                          Scalar min_frac_i)
+    {
+    const vector<Scalar>& N_i = W_i;
+    //~
     if (N_i.size() == 1)
         return false;
 
     // target particles per rank is uniform distribution
-    const Scalar target = Scalar(m_pdata->getNGlobal()) / Scalar(N_i.size());
+    /* const Scalar target = Scalar(m_pdata->getNGlobal()) / Scalar(N_i.size()); */ //~ [RHEOINF]
+    const Scalar target = W_total / Scalar(N_i.size()); //~ target load per slice [RHEOINF]
 
     // make the minimum domain slightly bigger so that the optimization won't fail at equality
     const Scalar min_domain_size = Scalar(1.00001) * min_frac_i * L_i;
@@ -604,6 +718,182 @@ void LoadBalancer::computeOwnedParticles()
     resetNOwn(N_own);
     }
 
+//~ add cost-weighted load balancing [RHEOINF]
+/*!
+ * With weighting "time", the force compute time measured on this rank since the last balancing is
+ * divided evenly among its particles. If any rank has no measurement yet (first call), all
+ * particles get unit weight, i.e. the first balancing uses the particle count.
+ */
+void LoadBalancer::initializeWeights()
+    {
+    if (m_weighting == weighting::time)
+        {
+        const double t = m_sysdef->getForceComputeTime();
+        int measured = (t > 0.0 || m_pdata->getN() == 0) ? 1 : 0;
+        int all_measured = 0;
+        MPI_Allreduce(&measured, &all_measured, 1, MPI_INT, MPI_MIN, m_mpi_comm);
+
+        if (all_measured && m_pdata->getN() > 0)
+            m_time_weight = Scalar(t / double(m_pdata->getN()));
+        else
+            m_time_weight = Scalar(1.0);
+        m_sysdef->resetForceComputeTime();
+        }
+
+    resetWOwn(computeLocalWeight());
+    MPI_Allreduce(&m_W_own, &m_W_total, 1, MPI_HOOMD_SCALAR, MPI_SUM, m_mpi_comm);
+    }
+
+Scalar LoadBalancer::computeLocalWeight()
+    {
+    if (m_weighting == weighting::time)
+        return m_time_weight * Scalar(m_pdata->getN());
+
+    ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
+    Scalar W(0.0);
+    for (unsigned int cur_p = 0; cur_p < m_pdata->getN(); ++cur_p)
+        W += getParticleWeight(h_pos.data[cur_p]);
+    return W;
+    }
+
+/*!
+ * \param W_i Vector holding the total load in each slice (will be allocated on call)
+ * \param dim The dimension of the slices (x=0, y=1, z=2)
+ * \param reduce_root The rank to perform the reduction on
+ * \returns true if the current rank holds the active \a W_i
+ *
+ * Same as reduce(), for the load of each rank.
+ */
+bool LoadBalancer::reduceWeights(std::vector<Scalar>& W_i,
+                                 unsigned int dim,
+                                 unsigned int reduce_root)
+    {
+    const Index3D& di = m_decomposition->getDomainIndexer();
+    std::vector<Scalar> W_per_rank(di.getNumElements());
+
+    Scalar W_own = getWOwn();
+    MPI_Gather(&W_own,
+               1,
+               MPI_HOOMD_SCALAR,
+               &W_per_rank[0],
+               1,
+               MPI_HOOMD_SCALAR,
+               reduce_root,
+               m_mpi_comm);
+
+    if (m_exec_conf->getRank() != reduce_root)
+        return false;
+
+    if (dim > 2)
+        throw runtime_error("Unknown dimension for load reduction.");
+
+    ArrayHandle<unsigned int> h_cart_ranks_inv(m_decomposition->getInverseCartRanks(),
+                                               access_location::host,
+                                               access_mode::read);
+    const unsigned int n_slices = (dim == 0) ? di.getW() : ((dim == 1) ? di.getH() : di.getD());
+    W_i.assign(n_slices, Scalar(0.0));
+    for (unsigned int cur_rank = 0; cur_rank < di.getNumElements(); ++cur_rank)
+        {
+        const uint3 grid_pos = di.getTriple(h_cart_ranks_inv.data[cur_rank]);
+        const unsigned int slice = (dim == 0) ? grid_pos.x : ((dim == 1) ? grid_pos.y : grid_pos.z);
+        W_i[slice] += W_per_rank[cur_rank];
+        }
+
+    return true;
+    }
+
+/*!
+ * \param weights Map holding the summed weight of the particles leaving to each neighbor rank
+ *
+ * Same as countParticlesOffRank(), summing particle weights instead of counting.
+ */
+void LoadBalancer::countWeightOffRank(std::map<unsigned int, Scalar>& weights)
+    {
+    ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_cart_ranks(m_decomposition->getCartRanks(),
+                                           access_location::host,
+                                           access_mode::read);
+
+    const BoxDim& box = m_pdata->getBox();
+    const Index3D& di = m_decomposition->getDomainIndexer();
+    const uint3 rank_pos = m_decomposition->getGridPos();
+
+    for (unsigned int cur_p = 0; cur_p < m_pdata->getN(); ++cur_p)
+        {
+        const Scalar4 cur_postype = h_pos.data[cur_p];
+        const Scalar3 f
+            = box.makeFraction(make_scalar3(cur_postype.x, cur_postype.y, cur_postype.z));
+
+        // the particle moves at most one domain along each direction
+        const int3 shift = make_int3((f.x >= Scalar(1.0)) - (f.x < Scalar(0.0)),
+                                     (f.y >= Scalar(1.0)) - (f.y < Scalar(0.0)),
+                                     (f.z >= Scalar(1.0)) - (f.z < Scalar(0.0)));
+        if (!shift.x && !shift.y && !shift.z)
+            continue;
+
+        const int i = ((int)rank_pos.x + shift.x + (int)di.getW()) % (int)di.getW();
+        const int j = ((int)rank_pos.y + shift.y + (int)di.getH()) % (int)di.getH();
+        const int k = ((int)rank_pos.z + shift.z + (int)di.getD()) % (int)di.getD();
+        weights[h_cart_ranks.data[di(i, j, k)]] += getParticleWeight(cur_postype);
+        }
+    }
+
+/*!
+ * Same as computeOwnedParticles(), exchanging the weight of the particles that leave the rank.
+ */
+void LoadBalancer::computeOwnedWeight()
+    {
+    if (!m_needs_recount)
+        return;
+
+    ArrayHandle<unsigned int> h_unique_neigh(m_comm->getUniqueNeighbors(),
+                                             access_location::host,
+                                             access_mode::read);
+    const unsigned int n_neigh = m_comm->getNUniqueNeighbors();
+
+    std::map<unsigned int, Scalar> weights;
+    for (unsigned int i = 0; i < n_neigh; ++i)
+        {
+        weights[h_unique_neigh.data[i]] = Scalar(0.0);
+        }
+    countWeightOffRank(weights);
+
+    std::vector<MPI_Request> req(2 * n_neigh);
+    std::vector<Scalar> W_send(n_neigh), W_recv(n_neigh);
+    unsigned int nreq = 0;
+    for (unsigned int cur_neigh = 0; cur_neigh < n_neigh; ++cur_neigh)
+        {
+        unsigned int neigh_rank = h_unique_neigh.data[cur_neigh];
+        W_send[cur_neigh] = weights[neigh_rank];
+
+        MPI_Isend(&W_send[cur_neigh],
+                  1,
+                  MPI_HOOMD_SCALAR,
+                  neigh_rank,
+                  1,
+                  m_mpi_comm,
+                  &req[nreq++]);
+        MPI_Irecv(&W_recv[cur_neigh],
+                  1,
+                  MPI_HOOMD_SCALAR,
+                  neigh_rank,
+                  1,
+                  m_mpi_comm,
+                  &req[nreq++]);
+        }
+    MPI_Waitall(nreq, req.data(), MPI_STATUSES_IGNORE);
+
+    // the load of the particles on the rank, plus received, minus sent
+    Scalar W_own = computeLocalWeight();
+    for (unsigned int cur_neigh = 0; cur_neigh < n_neigh; ++cur_neigh)
+        {
+        W_own += W_recv[cur_neigh] - W_send[cur_neigh];
+        }
+
+    resetWOwn(W_own);
+    }
+//~
+
 #endif // ENABLE_MPI
 
 /*!
@@ -628,7 +918,10 @@ void export_LoadBalancer(pybind11::module& m)
                       &LoadBalancer::setMaxIterations)
         .def_property("x", &LoadBalancer::getEnableX, &LoadBalancer::setEnableX)
         .def_property("y", &LoadBalancer::getEnableY, &LoadBalancer::setEnableY)
-        .def_property("z", &LoadBalancer::getEnableZ, &LoadBalancer::setEnableZ);
+        .def_property("z", &LoadBalancer::getEnableZ, &LoadBalancer::setEnableZ)
+        .def_property("weighting", &LoadBalancer::getWeighting, &LoadBalancer::setWeighting)
+        .def("setTypeWeights", &LoadBalancer::setTypeWeights)
+        .def("getTypeWeights", &LoadBalancer::getTypeWeights);
     }
 
     } // end namespace detail
@@ -1,6 +1,8 @@
 // Copyright (c) 2009-2023 The Regents of the University of Michigan.
 // Part of HOOMD-blue, released under the BSD 3-Clause License.
 
+// ########## Modified by Rheoinformatic //~ [RHEOINF] ##########
+
 /*! \file LoadBalancer.h
     \brief Declares an updater that changes the MPI domain decomposition to balance the load
 */
@@ -37,6 +39,11 @@ namespace hoomd
  * Constraints are satisfied by solving a least-squares problem with box constraints, where the cost
  * function is the deviation of the domain sizes from the proposed rescaled width.
  *
+ * //~ The load can also be a cost weight per particle instead of the particle count [RHEOINF]:
+ * either the force compute time measured on the rank since the last balancing, divided evenly among
+ * its particles ("time"), or a user weight per particle type ("type"). The imbalance is then the
+ * load of a rank divided by the average load per rank.
+ *
  * \ingroup updaters
  */
 class PYBIND11_EXPORT LoadBalancer : public Tuner
@@ -136,6 +143,24 @@ class PYBIND11_EXPORT LoadBalancer : public Tuner
         return m_enable_z;
         }
 
+    //~ add cost-weighted load balancing [RHEOINF]
+    //! Set the load measure
+    /*!
+     * \param weighting "particles" (count), "time" (measured force compute time) or "type" (type
+     * weights)
+     */
+    void setWeighting(const std::string& name);
+
+    //! Get the load measure
+    std::string getWeighting() const;
+
+    //! Set the cost weight of a particle type (used with weighting "type")
+    void setTypeWeights(const std::string& type_name, Scalar weight);
+
+    //! Get the cost weight of a particle type
+    Scalar getTypeWeights(const std::string& type_name);
+    //~
+
     //! Take one timestep forward
     virtual void update(uint64_t timestep);
 
@@ -195,6 +220,53 @@ class PYBIND11_EXPORT LoadBalancer : public Tuner
         m_recompute_max_imbalance = true;
         m_needs_recount = false;
         }
+
+    //~ add cost-weighted load balancing [RHEOINF]
+    //! Set up the per particle weights and the total load at the start of a balancing step
+    void initializeWeights();
+
+    //! Sum the weights of the particles owned by the rank
+    Scalar computeLocalWeight();
+
+    //! Cost weight of a particle owned by this rank
+    Scalar getParticleWeight(const Scalar4& postype) const
+        {
+        if (m_weighting == weighting::type)
+            return m_type_weights[__scalar_as_int(postype.w)];
+        return m_time_weight;
+        }
+
+    //! Reduce the load per rank down to one dimension
+    bool reduceWeights(std::vector<Scalar>& W_i, unsigned int dim, unsigned int reduce_root);
+
+    //! Adjust the partitioning along a single dimension for a load per slice
+    bool adjust(std::vector<Scalar>& cum_frac_i,
+                const std::vector<Scalar>& W_i,
+                Scalar W_total,
+                Scalar L_i,
+                Scalar min_domain_frac);
+
+    //! Sum the weights of the particles that have gone off the rank
+    void countWeightOffRank(std::map<unsigned int, Scalar>& weights);
+
+    //! Compute the load of each rank after an adjustment
+    void computeOwnedWeight();
+
+    //! Gets the load owned by the rank, updating if necessary
+    Scalar getWOwn()
+        {
+        computeOwnedWeight();
+        return m_W_own;
+        }
+
+    //! Force a reset of the load owned by the rank without counting
+    void resetWOwn(Scalar W)
+        {
+        m_W_own = W;
+        m_recompute_max_imbalance = true;
+        m_needs_recount = false;
+        }
+    //~
 #endif // ENABLE_MPI
 
     Scalar m_max_imbalance;         //!< Maximum imbalance
@@ -211,6 +283,21 @@ class PYBIND11_EXPORT LoadBalancer : public Tuner
 
     const Scalar m_max_scale; //!< Maximum fraction to rescale either direction (5%)
 
+    //~ add cost-weighted load balancing [RHEOINF]
+    //! Load measure used for balancing
+    enum class weighting
+        {
+        particles, //!< Number of particles
+        time,      //!< Measured force compute time
+        type       //!< Weight per particle type
+        };
+    weighting m_weighting;              //!< Current load measure
+    std::vector<Scalar> m_type_weights; //!< Cost weight per particle type
+    Scalar m_time_weight;               //!< Measured cost of one particle on this rank
+    Scalar m_W_own;                     //!< Load owned by this rank
+    Scalar m_W_total;                   //!< Load summed over all ranks
+    //~
+
     private:
     unsigned int m_N_own; //!< Number of particles owned by this rank
 
@@ -1425,6 +1425,95 @@ void ParticleData::initializeFromSnapshot(const SnapshotParticleData<Real>& snap
         }
     }
 
+//~ initialize without a global snapshot [RHEOINF]
+/*! \param in Particles owned by this rank (positions inside the local box, unique tags)
+    \param nglobal Global number of particles, tags span [0, nglobal)
+
+    Used by GSDReader::readParticlesDistributed(), which places the particles on their ranks
+    itself, so no rank ever holds the global particle data. The tag set and reverse lookup tags
+    are set up for \a nglobal particles as in initializeFromSnapshot(). The type mapping must
+    already be set.
+
+    \post the particle data arrays hold \a in, in the given order
+*/
+void ParticleData::initializeFromLocalParticles(const std::vector<detail::pdata_element>& in,
+                                                unsigned int nglobal)
+    {
+    m_exec_conf->msg->notice(4) << "ParticleData: initializing from local particles" << std::endl;
+
+    removeAllGhostParticles();
+
+    m_tag_set.clear();
+    while (!m_recycled_tags.empty())
+        m_recycled_tags.pop();
+
+    m_rtag.resize(nglobal);
+
+        {
+        ArrayHandle<unsigned int> h_rtag(getRTags(), access_location::host, access_mode::overwrite);
+        for (unsigned int tag = 0; tag < nglobal; tag++)
+            h_rtag.data[tag] = NOT_LOCAL;
+        }
+
+    for (unsigned int tag = 0; tag < nglobal; tag++)
+        {
+        m_tag_set.insert(tag);
+        }
+    m_invalid_cached_tags = true;
+
+    resize((unsigned int)in.size());
+
+        {
+        ArrayHandle<Scalar4> h_pos(m_pos, access_location::host, access_mode::overwrite);
+        ArrayHandle<Scalar4> h_vel(m_vel, access_location::host, access_mode::overwrite);
+        ArrayHandle<Scalar3> h_accel(m_accel, access_location::host, access_mode::overwrite);
+        ArrayHandle<int3> h_image(m_image, access_location::host, access_mode::overwrite);
+        ArrayHandle<Scalar> h_charge(m_charge, access_location::host, access_mode::overwrite);
+        ArrayHandle<Scalar> h_diameter(m_diameter, access_location::host, access_mode::overwrite);
+        ArrayHandle<unsigned int> h_body(m_body, access_location::host, access_mode::overwrite);
+        ArrayHandle<Scalar4> h_orientation(m_orientation,
+                                           access_location::host,
+                                           access_mode::overwrite);
+        ArrayHandle<Scalar4> h_angmom(m_angmom, access_location::host, access_mode::overwrite);
+        ArrayHandle<Scalar3> h_inertia(m_inertia, access_location::host, access_mode::overwrite);
+        ArrayHandle<unsigned int> h_tag(m_tag, access_location::host, access_mode::overwrite);
+        ArrayHandle<unsigned int> h_comm_flag(m_comm_flags,
+                                              access_location::host,
+                                              access_mode::overwrite);
+        ArrayHandle<unsigned int> h_rtag(m_rtag, access_location::host, access_mode::readwrite);
+
+        for (unsigned int idx = 0; idx < m_nparticles; idx++)
+            {
+            const detail::pdata_element& p = in[idx];
+            h_pos.data[idx] = p.pos;
+            h_vel.data[idx] = p.vel;
+            h_accel.data[idx] = p.accel;
+            h_charge.data[idx] = p.charge;
+            h_diameter.data[idx] = p.diameter;
+            h_image.data[idx] = p.image;
+            h_tag.data[idx] = p.tag;
+            h_rtag.data[p.tag] = idx;
+            h_body.data[idx] = p.body;
+            h_orientation.data[idx] = p.orientation;
+            h_angmom.data[idx] = p.angmom;
+            h_inertia.data[idx] = p.inertia;
+
+            h_comm_flag.data[idx] = 0; // initialize with zero
+            }
+        }
+
+    // the caller provides no accelerations
+    m_accel_set = false;
+
+    setNGlobal(nglobal);
+
+    notifyParticleSort();
+
+    m_origin = make_scalar3(0, 0, 0);
+    m_o_image = make_int3(0, 0, 0);
+    }
+//~
+
 //! take a particle data snapshot
 /* \param snapshot The snapshot to write to
    \returns a map to lookup the snapshot index from a particle tag
@@ -1159,6 +1159,12 @@ class PYBIND11_EXPORT ParticleData
     void initializeFromSnapshot(const SnapshotParticleData<Real>& snapshot,
                                 bool ignore_bodies = false);
 
+    //~ initialize without a global snapshot [RHEOINF]
+    //! Initialize from the local particles of every rank
+    void initializeFromLocalParticles(const std::vector<detail::pdata_element>& in,
+                                      unsigned int nglobal);
+    //~
+
     //! Take a snapshot
     template<class Real> void takeSnapshot(SnapshotParticleData<Real>& snapshot);
 
@@ -1,6 +1,8 @@
 // Copyright (c) 2009-2023 The Regents of the University of Michigan.
 // Part of HOOMD-blue, released under the BSD 3-Clause License.
 
+// ########## Modified by Rheoinformatic //~ [RHEOINF] ##########
+
 /*! \file RNGIdentifiers.h
     \brief Define constants to use in seeding separate RNG streams across different classes in the
     code
@@ -70,6 +72,7 @@ struct RNGIdentifier
     static const uint8_t HPMCShapeMoveUpdateOrder = 44;
     static const uint8_t BussiThermostat = 45;
     static const uint8_t ConstantPressure = 46;
+    static const uint8_t PoreSizeAnalyzer = 47; //~ add PoreSizeAnalyzer [RHEOINF]
     };
 
     } // namespace hoomd
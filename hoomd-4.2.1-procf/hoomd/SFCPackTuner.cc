@@ -1,6 +1,8 @@
 // Copyright (c) 2009-2023 The Regents of the University of Michigan.
 // Part of HOOMD-blue, released under the BSD 3-Clause License.
 
+// ########## Modified by Rheoinformatic //~ [RHEOINF] ##########
+
 /*! \file SFCPackTuner.cc
     \brief Defines the SFCPackTuner class
 */
@@ -14,6 +16,14 @@
 #include <math.h>
 #include <stdexcept>
 
+//~ parallel binning and sort [RHEOINF]
+#ifdef ENABLE_TBB
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/parallel_sort.h>
+#endif
+//~
+
 using namespace std;
 
 namespace hoomd
@@ -22,7 +32,11 @@ namespace hoomd
  */
 SFCPackTuner::SFCPackTuner(std::shared_ptr<SystemDefinition> sysdef,
                            std::shared_ptr<Trigger> trigger)
-    : Tuner(sysdef, trigger), m_last_grid(0), m_last_dim(0)
+    : Tuner(sysdef, trigger), m_last_grid(0), m_last_dim(0),
+      //~ add type-major ordering and adaptive sorting [RHEOINF]
+      m_type_major(false), m_adaptive(false), m_num_sorts(0), m_adaptive_started(false),
+      m_last_check_step(0), m_best_step_time(-1.0), m_lost_time(0.0), m_sort_time(0.0)
+    //~
     {
     m_exec_conf->msg->notice(5) << "Constructing SFCPackTuner" << endl;
 
@@ -81,6 +95,13 @@ SFCPackTuner::~SFCPackTuner()
 void SFCPackTuner::update(uint64_t timestep)
     {
     Updater::update(timestep);
+
+    //~ in adaptive mode the trigger only schedules a check [RHEOINF]
+    if (m_adaptive && !checkAdaptive(timestep))
+        return;
+    auto sort_start = std::chrono::steady_clock::now();
+    //~
+
     m_exec_conf->msg->notice(6) << "SFCPackTuner: particle sort" << std::endl;
 
 #ifdef ENABLE_MPI
@@ -114,8 +135,101 @@ void SFCPackTuner::update(uint64_t timestep)
         m_comm->communicate(timestep);
         }
 #endif
+
+    //~ record the cost of the sort and restart the measurement [RHEOINF]
+    m_num_sorts++;
+    if (m_adaptive)
+        {
+        auto sort_end = std::chrono::steady_clock::now();
+        m_sort_time = std::chrono::duration<double>(sort_end - sort_start).count();
+        m_best_step_time = -1.0;
+        m_lost_time = 0.0;
+        m_last_check_step = timestep;
+        m_last_check_time = sort_end;
+        }
+    //~
     }
 
+//~ add type-major ordering and adaptive sorting [RHEOINF]
+/*! \param type_major Set to true to group the particles by type before the SFC order
+ */
+void SFCPackTuner::setTypeMajor(bool type_major)
+    {
+    if (type_major && m_exec_conf->isCUDAEnabled())
+        {
+        m_exec_conf->msg->warning()
+            << "sorter: type-major ordering is not implemented on the GPU, ignoring." << endl;
+        }
+    m_type_major = type_major;
+    }
+
+/*! \param timestep Current time step
+    \returns true if the particles should be sorted now
+
+    The first check always sorts. After that, the wall time per step since the previous check is
+    compared with the fastest time per step seen since the last sort, and the difference is
+    accumulated as time lost to the particles unsorting. Sorting pays off once the time lost is
+    larger than what the last sort cost. The decision is made collectively on all ranks, since the
+    sort migrates particles.
+*/
+bool SFCPackTuner::checkAdaptive(uint64_t timestep)
+    {
+    auto now = std::chrono::steady_clock::now();
+    bool sort = false;
+
+    if (!m_adaptive_started)
+        {
+        m_adaptive_started = true;
+        sort = true;
+        }
+    else if (timestep > m_last_check_step)
+        {
+        uint64_t n_steps = timestep - m_last_check_step;
+        double step_time
+            = std::chrono::duration<double>(now - m_last_check_time).count() / double(n_steps);
+
+        if (m_best_step_time < 0.0 || step_time < m_best_step_time)
+            m_best_step_time = step_time;
+
+        m_lost_time += (step_time - m_best_step_time) * double(n_steps);
+        sort = m_lost_time > m_sort_time;
+        }
+
+    m_last_check_step = timestep;
+    m_last_check_time = now;
+
+#ifdef ENABLE_MPI
+    if (m_sysdef->isDomainDecomposed())
+        {
+        int sort_int = sort ? 1 : 0;
+        MPI_Allreduce(MPI_IN_PLACE,
+                      &sort_int,
+                      1,
+                      MPI_INT,
+                      MPI_LOR,
+                      m_exec_conf->getMPICommunicator());
+        sort = sort_int != 0;
+        }
+#endif
+
+    return sort;
+    }
+
+/*! Sort the first N entries of m_particle_bins. The keys are unique, so the parallel sort gives
+    the same order as the serial one.
+*/
+void SFCPackTuner::sortParticleBins()
+    {
+    const unsigned int N = m_pdata->getN();
+#ifdef ENABLE_TBB
+    m_exec_conf->getTaskArena()->execute(
+        [&] { tbb::parallel_sort(m_particle_bins.begin(), m_particle_bins.begin() + N); });
+#else
+    sort(m_particle_bins.begin(), m_particle_bins.begin() + N);
+#endif
+    }
+//~
+
 void SFCPackTuner::applySortOrder()
     {
     assert(m_pdata);
@@ -501,8 +615,20 @@ void SFCPackTuner::getSortedOrder2D()
                                    access_location::host,
                                    access_mode::read);
 
+        //~ group by type in type-major mode, highest type id first [RHEOINF]
+        const unsigned int ntypes = m_pdata->getNTypes();
+        const bool type_major = m_type_major;
+
         // for each particle
+#ifdef ENABLE_TBB
+        m_exec_conf->getTaskArena()->execute([&] {
+        tbb::parallel_for(tbb::blocked_range<unsigned int>(0, m_pdata->getN()),
+                          [&](const tbb::blocked_range<unsigned int>& r) {
+        for (unsigned int n = r.begin(); n != r.end(); n++)
+#else
         for (unsigned int n = 0; n < m_pdata->getN(); n++)
+#endif
+            //~
             {
             // find the bin each particle belongs in
             Scalar3 p = make_scalar3(h_pos.data[n].x, h_pos.data[n].y, h_pos.data[n].z);
@@ -524,12 +650,23 @@ void SFCPackTuner::getSortedOrder2D()
             // record its bin
             unsigned int bin = ib * m_grid + jb;
 
-            m_particle_bins[n] = std::pair<unsigned int, unsigned int>(bin, n);
+            /*m_particle_bins[n] = std::pair<unsigned int, unsigned int>(bin, n);*/
+            //~ prefix the bin with the type rank in type-major mode [RHEOINF]
+            uint64_t key = bin;
+            if (type_major)
+                key |= uint64_t(ntypes - 1 - __scalar_as_int(h_pos.data[n].w)) << 32;
+            m_particle_bins[n] = std::pair<uint64_t, unsigned int>(key, n);
             }
+#ifdef ENABLE_TBB
+        });
+        });
+#endif
+        //~
         }
 
     // sort the tuples
-    sort(m_particle_bins.begin(), m_particle_bins.begin() + m_pdata->getN());
+    /*sort(m_particle_bins.begin(), m_particle_bins.begin() + m_pdata->getN());*/
+    sortParticleBins(); //~ parallel sort [RHEOINF]
 
     // translate the sorted order
     for (unsigned int j = 0; j < m_pdata->getN(); j++)
@@ -608,8 +745,20 @@ void SFCPackTuner::getSortedOrder3D()
                                                 access_location::host,
                                                 access_mode::read);
 
+    //~ group by type in type-major mode, highest type id first [RHEOINF]
+    const unsigned int ntypes = m_pdata->getNTypes();
+    const bool type_major = m_type_major;
+
     // for each particle
+#ifdef ENABLE_TBB
+    m_exec_conf->getTaskArena()->execute([&] {
+    tbb::parallel_for(tbb::blocked_range<unsigned int>(0, m_pdata->getN()),
+                      [&](const tbb::blocked_range<unsigned int>& r) {
+    for (unsigned int n = r.begin(); n != r.end(); n++)
+#else
     for (unsigned int n = 0; n < m_pdata->getN(); n++)
+#endif
+        //~
         {
         Scalar3 p = make_scalar3(h_pos.data[n].x, h_pos.data[n].y, h_pos.data[n].z);
         Scalar3 f = box.makeFraction(p, make_scalar3(0.0, 0.0, 0.0));
@@ -636,11 +785,22 @@ void SFCPackTuner::getSortedOrder3D()
         // record its bin
         unsigned int bin = ib * (m_grid * m_grid) + jb * m_grid + kb;
 
-        m_particle_bins[n] = std::pair<unsigned int, unsigned int>(h_traversal_order.data[bin], n);
+        /*m_particle_bins[n] = std::pair<unsigned int, unsigned int>(h_traversal_order.data[bin], n);*/
+        //~ prefix the hilbert index with the type rank in type-major mode [RHEOINF]
+        uint64_t key = h_traversal_order.data[bin];
+        if (type_major)
+            key |= uint64_t(ntypes - 1 - __scalar_as_int(h_pos.data[n].w)) << 32;
+        m_particle_bins[n] = std::pair<uint64_t, unsigned int>(key, n);
         }
+#ifdef ENABLE_TBB
+    });
+    });
+#endif
+    //~
 
     // sort the tuples
-    sort(m_particle_bins.begin(), m_particle_bins.begin() + m_pdata->getN());
+    /*sort(m_particle_bins.begin(), m_particle_bins.begin() + m_pdata->getN());*/
+    sortParticleBins(); //~ parallel sort [RHEOINF]
 
     // translate the sorted order
     for (unsigned int j = 0; j < m_pdata->getN(); j++)
@@ -689,7 +849,12 @@ void export_SFCPackTuner(pybind11::module& m)
     {
     pybind11::class_<SFCPackTuner, Tuner, std::shared_ptr<SFCPackTuner>>(m, "SFCPackTuner")
         .def(pybind11::init<std::shared_ptr<SystemDefinition>, std::shared_ptr<Trigger>>())
-        .def_property("grid", &SFCPackTuner::getGrid, &SFCPackTuner::setGridPython);
+        .def_property("grid", &SFCPackTuner::getGrid, &SFCPackTuner::setGridPython)
+        //~ add type-major ordering and adaptive sorting [RHEOINF]
+        .def_property("type_major", &SFCPackTuner::getTypeMajor, &SFCPackTuner::setTypeMajor)
+        .def_property("adaptive", &SFCPackTuner::getAdaptive, &SFCPackTuner::setAdaptive)
+        .def_property_readonly("num_sorts", &SFCPackTuner::getNumSorts);
+        //~
     }
 
     } // end namespace detail
@@ -1,6 +1,8 @@
 // Copyright (c) 2009-2023 The Regents of the University of Michigan.
 // Part of HOOMD-blue, released under the BSD 3-Clause License.
 
+// ########## Modified by Rheoinformatic //~ [RHEOINF] ##########
+
 /*! \file SFCPackTuner.h
     \brief Declares the SFCPackTuner class
 */
@@ -12,8 +14,10 @@
 #include "GPUVector.h"
 #include "Tuner.h"
 
+#include <chrono> //~ [RHEOINF]
 #include <memory>
 #include <pybind11/pybind11.h>
+#include <stdint.h> //~ [RHEOINF]
 #include <utility>
 #include <vector>
 
@@ -43,6 +47,22 @@ namespace hoomd
    based on the order in which those bins appear along a hilbert curve. It is very efficient, even
    when the box size changes often as the grid dimension is kept constant.
 
+    //~ add type-major ordering, parallel sort and adaptive sorting [RHEOINF]
+    With TBB enabled, the binning and the sort run in parallel in the execution configuration's
+   task arena. Each particle's sort key is unique (bin, index), so the result does not depend on
+   the number of threads.
+
+    Type-major ordering (setTypeMajor()) groups the particles by type, highest type id first, and
+   orders each group along the hilbert curve. In the colloid templates the solvent is type 0, so
+   the colloids (which have the large cutoffs and most neighbors) end up in one contiguous block
+   in their own SFC order, followed by the solvent.
+
+    In adaptive mode (setAdaptive()) the trigger only schedules checks. At each check the wall
+   time per step since the previous check (dominated by the force loop) is compared with the
+   fastest time per step measured since the last sort. The slow down is accumulated, and the
+   particles are sorted once the accumulated time lost exceeds the measured cost of one sort.
+    //~
+
     \ingroup updaters
 */
 class PYBIND11_EXPORT SFCPackTuner : public Tuner
@@ -80,12 +100,60 @@ class PYBIND11_EXPORT SFCPackTuner : public Tuner
         return m_grid;
         }
 
+    //~ add type-major ordering and adaptive sorting [RHEOINF]
+    //! Set whether the particles are grouped by type (highest type id first) before the SFC order
+    void setTypeMajor(bool type_major);
+
+    //! Get whether the particles are grouped by type
+    bool getTypeMajor()
+        {
+        return m_type_major;
+        }
+
+    //! Set whether the sort is triggered by the measured slow down instead of every trigger
+    void setAdaptive(bool adaptive)
+        {
+        m_adaptive = adaptive;
+        m_adaptive_started = false;
+        }
+
+    //! Get whether adaptive sorting is enabled
+    bool getAdaptive()
+        {
+        return m_adaptive;
+        }
+
+    //! Get the number of sorts performed
+    uint64_t getNumSorts()
+        {
+        return m_num_sorts;
+        }
+    //~
+
     protected:
     unsigned int m_grid;                      //!< Grid dimension to use
     unsigned int m_last_grid;                 //!< The last value of MMax
     unsigned int m_last_dim;                  //!< Check the last dimension we ran at
     GPUArray<unsigned int> m_traversal_order; //!< Generated traversal order of bins
 
+    //~ add type-major ordering and adaptive sorting [RHEOINF]
+    bool m_type_major;       //!< True if particles are grouped by type before the SFC order
+    bool m_adaptive;         //!< True if sorts are triggered by the measured slow down
+    uint64_t m_num_sorts;    //!< Number of sorts performed
+    bool m_adaptive_started; //!< True once the first adaptive check has been made
+    uint64_t m_last_check_step;                                  //!< Step of the last check
+    std::chrono::steady_clock::time_point m_last_check_time;     //!< Wall time of the last check
+    double m_best_step_time; //!< Fastest time per step since the last sort (s), < 0 if unset
+    double m_lost_time;      //!< Accumulated time lost to unsorting since the last sort (s)
+    double m_sort_time;      //!< Wall time taken by the last sort (s)
+
+    //! Decide whether to sort at this adaptive check
+    bool checkAdaptive(uint64_t timestep);
+
+    //! Sort the (key, index) pairs of the first N particles
+    void sortParticleBins();
+    //~
+
     //! Helper function that actually performs the sort
     virtual void getSortedOrder2D();
     //! Helper function that actually performs the sort
@@ -112,7 +180,9 @@ class PYBIND11_EXPORT SFCPackTuner : public Tuner
 
     private:
     std::vector<unsigned int> m_sort_order; //!< Generated sort order of the particles
-    std::vector<std::pair<unsigned int, unsigned int>> m_particle_bins; //!< Binned particles
+    /*std::vector<std::pair<unsigned int, unsigned int>> m_particle_bins; //!< Binned particles*/
+    std::vector<std::pair<uint64_t, unsigned int>>
+        m_particle_bins; //!< Binned particles (64-bit key: type rank, bin) [RHEOINF]
     std::shared_ptr<Trigger> m_trigger;
 
 #ifdef ENABLE_MPI
@@ -1,6 +1,8 @@
 // Copyright (c) 2009-2023 The Regents of the University of Michigan.
 // Part of HOOMD-blue, released under the BSD 3-Clause License.
 
+// ########## Modified by Rheoinformatic //~ [RHEOINF] ##########
+
 /*! \file SystemDefinition.h
     \brief Defines the SystemDefinition class
  */
@@ -216,6 +218,39 @@ class PYBIND11_EXPORT SystemDefinition
         }
 #endif
 
+    //~ add force compute timing for cost-weighted load balancing [RHEOINF]
+    //! Enable / disable timing of ForceCompute::computeForces on this rank
+    void setForceComputeTiming(bool enable)
+        {
+        m_force_compute_timing = enable;
+        m_force_compute_time = 0.0;
+        }
+
+    //! Check if the force computations are timed
+    bool getForceComputeTiming() const
+        {
+        return m_force_compute_timing;
+        }
+
+    //! Add wall time (in seconds) spent computing forces on this rank
+    void addForceComputeTime(double seconds)
+        {
+        m_force_compute_time += seconds;
+        }
+
+    //! Get the wall time (in seconds) spent computing forces since the last reset
+    double getForceComputeTime() const
+        {
+        return m_force_compute_time;
+        }
+
+    //! Reset the force compute time
+    void resetForceComputeTime()
+        {
+        m_force_compute_time = 0.0;
+        }
+    //~
+
     //! Return a snapshot of the current system data
     template<class Real> std::shared_ptr<SnapshotSystemData<Real>> takeSnapshot();
 
@@ -237,6 +272,9 @@ class PYBIND11_EXPORT SystemDefinition
     std::shared_ptr<mpcd::ParticleData> m_mpcd_data; //!< MPCD particle data
 #endif
 
+    bool m_force_compute_timing = false; //!< True if the force computations are timed [RHEOINF]
+    double m_force_compute_time = 0.0;   //!< Force compute wall time (s) [RHEOINF]
+
 #ifdef ENABLE_MPI
     /// The system communicator
     std::weak_ptr<Communicator> m_communicator;
@@ -1,6 +1,8 @@
 # Copyright (c) 2009-2023 The Regents of the University of Michigan.
 # Part of HOOMD-blue, released under the BSD 3-Clause License.
 
+###### Modified by Rheoinformatic ##~ [RHEOINF] ######
+
 """MPI communicator.
 
 When compiled without MPI support, `Communicator` acts as if there is one MPI
@@ -39,6 +41,12 @@ class Communicator(object):
           simulations using mpi4py.
         ranks_per_partition (int): (MPI) Number of ranks to include in a
           partition.
+        compact_ghosts (bool): (MPI) Send ghost diameters and charges once per
+          type for types whose ghosts share one value. [RHEOINF]
+        ghost_velocity_float (bool): (MPI) Send ghost velocities in single
+          precision in the per step ghost update. [RHEOINF]
+        neighbor_collectives (bool): (MPI) Update ghosts with one MPI-3
+          neighborhood collective per step. [RHEOINF]
 
 
     The `Communicator` class initializes MPI communications for a
@@ -63,9 +71,44 @@ class Communicator(object):
     .. code-block:: python
 
         communicator = simulation.device.communicator
+
+    Attributes:
+        compact_ghosts (bool): When `True`, ghost particle diameters and charges
+          are sent as one value per type, plus individual values only for the
+          types whose ghosts do not all share that value (e.g. polydisperse
+          colloids). The values received are identical. Only the CPU
+          communicator supports it. [RHEOINF]
+
+        ghost_velocity_float (bool): When `True`, the per step ghost update
+          sends the velocity of each ghost as three single precision floats
+          instead of a full precision 4-vector. Ghost velocities are then
+          rounded to single precision (e.g. in the DPD drag force), local
+          velocities are unchanged. Only the CPU communicator supports it.
+          [RHEOINF]
+
+        neighbor_collectives (bool): When `True`, the per step ghost update
+          exchanges the ghost positions, velocities and orientations of all
+          neighbor domains with a single ``MPI_Neighbor_alltoallv`` (persistent
+          with MPI 4) instead of one exchange per direction. The ghost exchange
+          after a neighbor list rebuild stays direction by direction and
+          records the owner of every ghost. Only the CPU communicator
+          supports it; without MPI 3 it is ignored with a warning. [RHEOINF]
+
+    These options are read when the simulation state is created. [RHEOINF]
     """
 
-    def __init__(self, mpi_comm=None, ranks_per_partition=None):
+    def __init__(self,
+                 mpi_comm=None,
+                 ranks_per_partition=None,
+                 compact_ghosts=False,
+                 ghost_velocity_float=False,
+                 neighbor_collectives=False): ##~ add ghost options [RHEOINF]
+
+        ##~ add ghost payload options [RHEOINF]
+        self.compact_ghosts = bool(compact_ghosts)
+        self.ghost_velocity_float = bool(ghost_velocity_float)
+        self.neighbor_collectives = bool(neighbor_collectives)
+        ##~
 
         # check ranks_per_partition
         if ranks_per_partition is not None:
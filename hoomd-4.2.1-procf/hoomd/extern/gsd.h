@@ -1,6 +1,8 @@
 // Copyright (c) 2016-2023 The Regents of the University of Michigan
 // Part of GSD, released under the BSD 2-Clause License.
 
+// ########## Modified by Rheoinformatic //~ [RHEOINF] ##########
+
 #ifndef GSD_H
 #define GSD_H
 
@@ -529,6 +531,42 @@ extern "C"
                         uint8_t flags,
                         const void* data);
 
+    //~ reserve space for data written by other processes [RHEOINF]
+    /** Add a data chunk to the current frame without writing its data.
+
+        @param handle Handle to an open GSD file.
+        @param name Name of the data chunk.
+        @param type type ID that identifies the type of data in the chunk.
+        @param N Number of rows in the data.
+        @param M Number of columns in the data.
+        @param flags set to 0, non-zero values reserved for future use.
+        @param location Set to the file offset where the caller must write the
+                        `N * M * gsd_sizeof_type(type)` bytes of the chunk.
+
+        @pre *handle* was opened by gsd_open().
+        @pre *name* is a unique name for data chunks in the given frame.
+
+        @post The index is present in the buffer and the chunk occupies the end of the file.
+
+        @note The caller must write the data (e.g. with MPI-IO) before the index is written to the
+        file by gsd_end_frame() or gsd_flush().
+
+        @return
+          - GSD_SUCCESS (0) on success. Negative value on failure:
+          - GSD_ERROR_INVALID_ARGUMENT: *handle* or *location* is NULL, *M* == 0, or *flags* != 0.
+          - GSD_ERROR_FILE_MUST_BE_WRITABLE: The file was opened read-only.
+          - GSD_ERROR_NAMELIST_FULL: The file cannot store any additional unique chunk names.
+          - GSD_ERROR_MEMORY_ALLOCATION_FAILED: failed to allocate memory.
+    */
+    int gsd_reserve_chunk(struct gsd_handle* handle,
+                          const char* name,
+                          enum gsd_type type,
+                          uint64_t N,
+                          uint32_t M,
+                          uint8_t flags,
+                          int64_t* location);
+    //~
+
     /** Find a chunk in the GSD file.
 
         @param handle Handle to an open GSD file
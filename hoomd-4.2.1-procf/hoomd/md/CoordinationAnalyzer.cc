@@ -0,0 +1,233 @@
+//~ ########## Created by the Rheoinformatic research group ##########
+//~ HOOMD-blue:
+// Copyright (c) 2009-2023 The Regents of the University of Michigan.
+// Part of HOOMD-blue, released under the BSD 3-Clause License.
+//~
+//~ This file:
+//~ Written by the Rheoinformatic research group (2026)
+
+// ########## Created by Rheoinformatic //~ [RHEOINF] ##########
+
+/*! \file CoordinationAnalyzer.cc
+    \brief Defines the CoordinationAnalyzer class
+*/
+
+#include "CoordinationAnalyzer.h"
+
+#include <algorithm>
+#include <cstring>
+#include <pybind11/stl.h>
+#include <stdexcept>
+
+using namespace std;
+
+namespace hoomd
+    {
+namespace md
+    {
+/*! \param sysdef System definition
+    \param trigger Select the timesteps to accumulate
+    \param nlist Neighbor list to take the pairs from
+    \param gap Surface-surface distance below which two particles are in contact
+    \param max_z Last bin of the histogram
+    \param types Indices of the selected types (all types when empty)
+*/
+CoordinationAnalyzer::CoordinationAnalyzer(std::shared_ptr<SystemDefinition> sysdef,
+                                           std::shared_ptr<Trigger> trigger,
+                                           std::shared_ptr<NeighborList> nlist,
+                                           Scalar gap,
+                                           unsigned int max_z,
+                                           const std::vector<unsigned int>& types)
+    : NeighborListPairAnalyzer(sysdef, trigger, nlist, types, "Coordination", true), m_gap(gap),
+      m_max_z(max_z), m_z_avg(0.0), m_n_frames(0)
+    {
+    m_exec_conf->msg->notice(5) << "Constructing CoordinationAnalyzer" << endl;
+
+    if (!m_nlist)
+        {
+        throw runtime_error("Coordination: a neighbor list is required.");
+        }
+    if (m_max_z == 0)
+        {
+        throw runtime_error("Coordination: max_z must be positive.");
+        }
+
+    m_hist.assign(m_max_z + 1, 0.0);
+    updateSearchRange();
+    }
+
+CoordinationAnalyzer::~CoordinationAnalyzer()
+    {
+    m_exec_conf->msg->notice(5) << "Destroying CoordinationAnalyzer" << endl;
+    }
+
+/*! h_ij < gap implies r_ij < gap + d_max. The range is set on construction and extended if the
+    diameters grow.
+*/
+void CoordinationAnalyzer::updateSearchRange()
+    {
+    extendSearchRange(m_gap + m_pdata->getMaxDiameter());
+    }
+
+/*! \param timestep Current time step
+
+    All ranks must call this method.
+*/
+void CoordinationAnalyzer::computeCoordination(uint64_t timestep)
+    {
+    updateSearchRange();
+    computeNeighborList(timestep);
+
+    const unsigned int N = m_pdata->getN();
+    if (m_z.getNumElements() < N)
+        {
+        GlobalArray<unsigned int> z(m_pdata->getMaxN(), m_exec_conf);
+        m_z.swap(z);
+        }
+
+    ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar> h_diameter(m_pdata->getDiameters(),
+                                   access_location::host,
+                                   access_mode::read);
+    ArrayHandle<unsigned int> h_n_neigh(m_nlist->getNNeighArray(),
+                                        access_location::host,
+                                        access_mode::read);
+    ArrayHandle<unsigned int> h_nlist(m_nlist->getNListArray(),
+                                      access_location::host,
+                                      access_mode::read);
+    ArrayHandle<size_t> h_head_list(m_nlist->getHeadList(),
+                                    access_location::host,
+                                    access_mode::read);
+    ArrayHandle<unsigned int> h_z(m_z, access_location::host, access_mode::overwrite);
+
+    memset(h_z.data, 0, sizeof(unsigned int) * m_z.getNumElements());
+
+    const BoxDim& box = m_pdata->getBox();
+    const bool full = m_nlist->getStorageMode() == NeighborList::full;
+
+    for (unsigned int i = 0; i < N; i++)
+        {
+        const Scalar3 pos_i = make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
+        if (!m_include[__scalar_as_int(h_pos.data[i].w)])
+            continue;
+        const size_t head_i = h_head_list.data[i];
+
+        for (unsigned int k = 0; k < h_n_neigh.data[i]; k++)
+            {
+            const unsigned int j = h_nlist.data[head_i + k];
+            if (!m_include[__scalar_as_int(h_pos.data[j].w)])
+                continue;
+
+            Scalar3 dx = pos_i - make_scalar3(h_pos.data[j].x, h_pos.data[j].y, h_pos.data[j].z);
+            dx = box.minImage(dx);
+            const Scalar contact
+                = Scalar(0.5) * (h_diameter.data[i] + h_diameter.data[j]) + m_gap;
+            if (dot(dx, dx) >= contact * contact)
+                continue;
+
+            h_z.data[i]++;
+            if (!full && j < N)
+                h_z.data[j]++;
+            }
+        }
+    }
+
+/*! \param timestep Current time step of the simulation
+ */
+void CoordinationAnalyzer::analyze(uint64_t timestep)
+    {
+    Analyzer::analyze(timestep);
+
+    computeCoordination(timestep);
+
+    ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_z(m_z, access_location::host, access_mode::read);
+
+    // the sum of Z and the number of selected particles
+    unsigned long long totals[2] = {0, 0};
+    for (unsigned int i = 0; i < m_pdata->getN(); i++)
+        {
+        if (!m_include[__scalar_as_int(h_pos.data[i].w)])
+            continue;
+        const unsigned int z = h_z.data[i];
+        m_hist[std::min(z, m_max_z)] += 1.0;
+        totals[0] += z;
+        totals[1]++;
+        }
+#ifdef ENABLE_MPI
+    if (m_sysdef->isDomainDecomposed())
+        {
+        MPI_Allreduce(MPI_IN_PLACE,
+                      totals,
+                      2,
+                      MPI_UNSIGNED_LONG_LONG,
+                      MPI_SUM,
+                      m_exec_conf->getMPICommunicator());
+        }
+#endif
+    m_z_avg = totals[1] > 0 ? Scalar(double(totals[0]) / double(totals[1])) : Scalar(0.0);
+    m_n_frames++;
+    }
+
+void CoordinationAnalyzer::reset()
+    {
+    std::fill(m_hist.begin(), m_hist.end(), 0.0);
+    m_n_frames = 0;
+    }
+
+/*! All ranks must call this method.
+ */
+pybind11::array_t<double> CoordinationAnalyzer::getHistogram()
+    {
+    std::vector<double> hist = m_hist;
+#ifdef ENABLE_MPI
+    if (m_sysdef->isDomainDecomposed())
+        {
+        MPI_Allreduce(MPI_IN_PLACE,
+                      hist.data(),
+                      (int)hist.size(),
+                      MPI_DOUBLE,
+                      MPI_SUM,
+                      m_exec_conf->getMPICommunicator());
+        }
+#endif
+    double total = 0.0;
+    for (double h : hist)
+        total += h;
+
+    pybind11::array_t<double> result(hist.size());
+    double* data = result.mutable_data();
+    for (size_t k = 0; k < hist.size(); k++)
+        {
+        data[k] = total > 0.0 ? hist[k] / total : 0.0;
+        }
+    return result;
+    }
+
+namespace detail
+    {
+void export_CoordinationAnalyzer(pybind11::module& m)
+    {
+    pybind11::class_<CoordinationAnalyzer, Analyzer, std::shared_ptr<CoordinationAnalyzer>>(
+        m,
+        "CoordinationAnalyzer")
+        .def(pybind11::init<std::shared_ptr<SystemDefinition>,
+                            std::shared_ptr<Trigger>,
+                            std::shared_ptr<NeighborList>,
+                            Scalar,
+                            unsigned int,
+                            const std::vector<unsigned int>&>())
+        .def("reset", &CoordinationAnalyzer::reset)
+        .def("computeCoordination", &CoordinationAnalyzer::computeCoordination)
+        .def("getHistogram", &CoordinationAnalyzer::getHistogram)
+        .def_property_readonly("z_avg", &CoordinationAnalyzer::getZAvg)
+        .def_property_readonly("n_frames", &CoordinationAnalyzer::getNFrames)
+        .def_property_readonly("gap", &CoordinationAnalyzer::getGap)
+        .def_property_readonly("max_z", &CoordinationAnalyzer::getMaxZ);
+
+    export_LocalCoordinationData<HOOMDHostBuffer>(m, "LocalCoordinationDataHost");
+    }
+
+    } // end namespace detail
+    } // end namespace md
+    } // end namespace hoomd
@@ -0,0 +1,177 @@
+//~ ########## Created by the Rheoinformatic research group ##########
+//~ HOOMD-blue:
+// Copyright (c) 2009-2023 The Regents of the University of Michigan.
+// Part of HOOMD-blue, released under the BSD 3-Clause License.
+//~
+//~ This file:
+//~ Written by the Rheoinformatic research group (2026)
+
+// ########## Created by Rheoinformatic //~ [RHEOINF] ##########
+
+/*! \file CoordinationAnalyzer.h
+    \brief Declares the CoordinationAnalyzer class
+
+    CoordinationAnalyzer counts the contacts of every particle from a NeighborList during the
+    simulation, so the coordination number distribution no longer needs an O(N^2) pass over stored
+    frames, and the mean coordination number can drive triggers (e.g. at gelation).
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include "NeighborListPairAnalyzer.h"
+#include "hoomd/PythonLocalDataAccess.h"
+
+#include <memory>
+#include <pybind11/numpy.h>
+#include <pybind11/pybind11.h>
+#include <vector>
+
+#ifndef __COORDINATION_ANALYZER_H__
+#define __COORDINATION_ANALYZER_H__
+
+namespace hoomd
+    {
+namespace md
+    {
+//! Counts the contacts of every particle and accumulates the coordination number distribution
+/*! Two particles i and j of the selected types are in contact when their surface-surface distance
+    h_ij = r_ij - (d_i + d_j)/2 is below the gap cutoff. The coordination number Z_i of each local
+    particle is kept in a per-particle array (zero for particles of other types) that Python reads
+    through LocalCoordinationData.
+
+    The pairs come from a NeighborList: CoordinationAnalyzer adds gap + d_max to the r_cut matrix
+    of the selected type pairs (see NeighborListPairAnalyzer), so the list (usually the one a pair
+    force already builds) holds every contact. With a half list, a local-local pair adds a contact to both particles; a pair with a
+    ghost is held by both ranks and adds to the local particle only.
+
+    Each call to analyze() updates Z_i, the mean <Z> of the frame, and the histogram of Z (the
+    last bin collects Z >= max_z), which is summed over the ranks when read.
+
+    \ingroup analyzers
+*/
+class PYBIND11_EXPORT CoordinationAnalyzer : public NeighborListPairAnalyzer
+    {
+    public:
+    //! Construct the analyzer
+    CoordinationAnalyzer(std::shared_ptr<SystemDefinition> sysdef,
+                         std::shared_ptr<Trigger> trigger,
+                         std::shared_ptr<NeighborList> nlist,
+                         Scalar gap,
+                         unsigned int max_z,
+                         const std::vector<unsigned int>& types);
+
+    //! Destructor
+    virtual ~CoordinationAnalyzer();
+
+    //! Add the current frame to the histogram
+    virtual void analyze(uint64_t timestep);
+
+    //! Count the contacts of every local particle in the current configuration
+    void computeCoordination(uint64_t timestep);
+
+    //! Clear the accumulated histogram
+    void reset();
+
+    //! Get the per-particle coordination numbers
+    const GlobalArray<unsigned int>& getCoordinationArray() const
+        {
+        return m_z;
+        }
+
+    //! Get the fraction of the selected particles with each Z, averaged over the frames
+    pybind11::array_t<double> getHistogram();
+
+    //! Get the mean coordination number of the last frame
+    Scalar getZAvg() const
+        {
+        return m_z_avg;
+        }
+
+    //! Get the number of frames accumulated since the last reset
+    uint64_t getNFrames() const
+        {
+        return m_n_frames;
+        }
+
+    //! Get the surface-surface distance below which two particles are in contact
+    Scalar getGap() const
+        {
+        return m_gap;
+        }
+
+    //! Get the last bin of the histogram
+    unsigned int getMaxZ() const
+        {
+        return m_max_z;
+        }
+
+    protected:
+    Scalar m_gap;                  //!< Contact cutoff in h_ij
+    unsigned int m_max_z;          //!< Last bin of the histogram
+    GlobalArray<unsigned int> m_z; //!< Coordination number of each local particle
+    Scalar m_z_avg;                //!< Mean Z of the last frame
+    std::vector<double> m_hist;    //!< Number of particles with each Z
+    uint64_t m_n_frames;           //!< Frames accumulated since the last reset
+
+    //! Extend the search range when the particle diameters grow
+    void updateSearchRange();
+    };
+
+/** Make the coordination numbers available to python via zero-copy access
+ *
+ * */
+template<class Output>
+class PYBIND11_EXPORT LocalCoordinationData
+    : public LocalDataAccess<Output, CoordinationAnalyzer>
+    {
+    public:
+    LocalCoordinationData(CoordinationAnalyzer& data, size_t N_particles)
+        : LocalDataAccess<Output, CoordinationAnalyzer>(data), m_z_handle(),
+          m_N_particles(N_particles)
+        {
+        }
+
+    virtual ~LocalCoordinationData() = default;
+
+    Output getCoordination()
+        {
+        return this->template getBuffer<unsigned int, unsigned int>(
+            m_z_handle,
+            &CoordinationAnalyzer::getCoordinationArray,
+            {m_N_particles},
+            false);
+        }
+
+    protected:
+    void clear()
+        {
+        m_z_handle.reset(nullptr);
+        }
+
+    private:
+    std::unique_ptr<ArrayHandle<unsigned int>> m_z_handle;
+    size_t m_N_particles;
+    };
+
+namespace detail
+    {
+//! Export CoordinationAnalyzer to python
+void export_CoordinationAnalyzer(pybind11::module& m);
+
+template<class Output> void export_LocalCoordinationData(pybind11::module& m, std::string name)
+    {
+    pybind11::class_<LocalCoordinationData<Output>,
+                     std::shared_ptr<LocalCoordinationData<Output>>>(m, name.c_str())
+        .def(pybind11::init<CoordinationAnalyzer&, size_t>())
+        .def("getCoordination", &LocalCoordinationData<Output>::getCoordination)
+        .def("enter", &LocalCoordinationData<Output>::enter)
+        .def("exit", &LocalCoordinationData<Output>::exit);
+    };
+    } // end namespace detail
+
+    } // end namespace md
+    } // end namespace hoomd
+
+#endif // __COORDINATION_ANALYZER_H__
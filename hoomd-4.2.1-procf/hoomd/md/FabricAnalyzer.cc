@@ -0,0 +1,188 @@
+//~ ########## Created by the Rheoinformatic research group ##########
+//~ HOOMD-blue:
+// Copyright (c) 2009-2023 The Regents of the University of Michigan.
+// Part of HOOMD-blue, released under the BSD 3-Clause License.
+//~
+//~ This file:
+//~ Written by the Rheoinformatic research group (2026)
+
+// ########## Created by Rheoinformatic //~ [RHEOINF] ##########
+
+/*! \file FabricAnalyzer.cc
+    \brief Defines the FabricAnalyzer class
+*/
+
+#include "FabricAnalyzer.h"
+
+#include <pybind11/stl.h>
+#include <stdexcept>
+
+using namespace std;
+
+namespace hoomd
+    {
+namespace md
+    {
+/*! \param sysdef System definition
+    \param trigger Select the timesteps to accumulate
+    \param nlist Neighbor list to take the pairs from
+    \param gap Surface-surface distance below which two particles are in contact
+    \param types Indices of the selected types (all types when empty)
+*/
+FabricAnalyzer::FabricAnalyzer(std::shared_ptr<SystemDefinition> sysdef,
+                               std::shared_ptr<Trigger> trigger,
+                               std::shared_ptr<NeighborList> nlist,
+                               Scalar gap,
+                               const std::vector<unsigned int>& types)
+    : NeighborListPairAnalyzer(sysdef, trigger, nlist, types, "Fabric", true), m_gap(gap),
+      m_rxy(0.0), m_sum_contacts(0.0), m_n_frames(0)
+    {
+    m_exec_conf->msg->notice(5) << "Constructing FabricAnalyzer" << endl;
+
+    if (!m_nlist)
+        {
+        throw runtime_error("Fabric: a neighbor list is required.");
+        }
+
+    for (unsigned int k = 0; k < 6; k++)
+        m_sum_nn[k] = 0.0;
+    updateSearchRange();
+    }
+
+FabricAnalyzer::~FabricAnalyzer()
+    {
+    m_exec_conf->msg->notice(5) << "Destroying FabricAnalyzer" << endl;
+    }
+
+/*! h_ij < gap implies r_ij < gap + d_max. The range is set on construction and extended if the
+    diameters grow.
+*/
+void FabricAnalyzer::updateSearchRange()
+    {
+    extendSearchRange(m_gap + m_pdata->getMaxDiameter());
+    }
+
+/*! \param timestep Current time step of the simulation
+ */
+void FabricAnalyzer::analyze(uint64_t timestep)
+    {
+    Analyzer::analyze(timestep);
+
+    updateSearchRange();
+    computeNeighborList(timestep);
+
+    ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar> h_diameter(m_pdata->getDiameters(),
+                                   access_location::host,
+                                   access_mode::read);
+    ArrayHandle<unsigned int> h_n_neigh(m_nlist->getNNeighArray(),
+                                        access_location::host,
+                                        access_mode::read);
+    ArrayHandle<unsigned int> h_nlist(m_nlist->getNListArray(),
+                                      access_location::host,
+                                      access_mode::read);
+    ArrayHandle<size_t> h_head_list(m_nlist->getHeadList(),
+                                    access_location::host,
+                                    access_mode::read);
+
+    // the minimum image in the tilted box is the Lees-Edwards image
+    const BoxDim& box = m_pdata->getBox();
+    const bool full = m_nlist->getStorageMode() == NeighborList::full;
+    const unsigned int N = m_pdata->getN();
+
+    // sum of n n (xx, xy, xz, yy, yz, zz), the number of contacts, and of selected particles
+    double sums[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+    for (unsigned int i = 0; i < N; i++)
+        {
+        const Scalar3 pos_i = make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
+        if (!m_include[__scalar_as_int(h_pos.data[i].w)])
+            continue;
+        sums[7] += 1.0;
+        const size_t head_i = h_head_list.data[i];
+
+        for (unsigned int k = 0; k < h_n_neigh.data[i]; k++)
+            {
+            const unsigned int j = h_nlist.data[head_i + k];
+            if (!m_include[__scalar_as_int(h_pos.data[j].w)])
+                continue;
+
+            Scalar3 dx = pos_i - make_scalar3(h_pos.data[j].x, h_pos.data[j].y, h_pos.data[j].z);
+            dx = box.minImage(dx);
+            const Scalar rsq = dot(dx, dx);
+            const Scalar contact
+                = Scalar(0.5) * (h_diameter.data[i] + h_diameter.data[j]) + m_gap;
+            if (rsq >= contact * contact || rsq == Scalar(0.0))
+                continue;
+
+            // count each contact once over the ranks and the two entries of a full list
+            const double weight = (full || j >= N) ? 0.5 : 1.0;
+            const double w_rsq = weight / double(rsq);
+            sums[0] += w_rsq * dx.x * dx.x;
+            sums[1] += w_rsq * dx.x * dx.y;
+            sums[2] += w_rsq * dx.x * dx.z;
+            sums[3] += w_rsq * dx.y * dx.y;
+            sums[4] += w_rsq * dx.y * dx.z;
+            sums[5] += w_rsq * dx.z * dx.z;
+            sums[6] += weight;
+            }
+        }
+#ifdef ENABLE_MPI
+    if (m_sysdef->isDomainDecomposed())
+        {
+        MPI_Allreduce(MPI_IN_PLACE,
+                      sums,
+                      8,
+                      MPI_DOUBLE,
+                      MPI_SUM,
+                      m_exec_conf->getMPICommunicator());
+        }
+#endif
+
+    for (unsigned int k = 0; k < 6; k++)
+        m_sum_nn[k] += sums[k];
+    m_sum_contacts += sums[6];
+    m_rxy = sums[7] > 0.0 ? Scalar(sums[1] / sums[7]) : Scalar(0.0);
+    m_n_frames++;
+    }
+
+void FabricAnalyzer::reset()
+    {
+    for (unsigned int k = 0; k < 6; k++)
+        m_sum_nn[k] = 0.0;
+    m_sum_contacts = 0.0;
+    m_n_frames = 0;
+    }
+
+pybind11::array_t<double> FabricAnalyzer::getFabricTensor() const
+    {
+    pybind11::array_t<double> result(6);
+    double* data = result.mutable_data();
+    for (unsigned int k = 0; k < 6; k++)
+        {
+        data[k] = m_sum_contacts > 0.0 ? m_sum_nn[k] / m_sum_contacts : 0.0;
+        }
+    return result;
+    }
+
+namespace detail
+    {
+void export_FabricAnalyzer(pybind11::module& m)
+    {
+    pybind11::class_<FabricAnalyzer, Analyzer, std::shared_ptr<FabricAnalyzer>>(m,
+                                                                                "FabricAnalyzer")
+        .def(pybind11::init<std::shared_ptr<SystemDefinition>,
+                            std::shared_ptr<Trigger>,
+                            std::shared_ptr<NeighborList>,
+                            Scalar,
+                            const std::vector<unsigned int>&>())
+        .def("reset", &FabricAnalyzer::reset)
+        .def("getFabricTensor", &FabricAnalyzer::getFabricTensor)
+        .def_property_readonly("rxy", &FabricAnalyzer::getRxy)
+        .def_property_readonly("n_contacts", &FabricAnalyzer::getNContacts)
+        .def_property_readonly("n_frames", &FabricAnalyzer::getNFrames)
+        .def_property_readonly("gap", &FabricAnalyzer::getGap);
+    }
+
+    } // end namespace detail
+    } // end namespace md
+    } // end namespace hoomd
@@ -0,0 +1,126 @@
+//~ ########## Created by the Rheoinformatic research group ##########
+//~ HOOMD-blue:
+// Copyright (c) 2009-2023 The Regents of the University of Michigan.
+// Part of HOOMD-blue, released under the BSD 3-Clause License.
+//~
+//~ This file:
+//~ Written by the Rheoinformatic research group (2026)
+
+// ########## Created by Rheoinformatic //~ [RHEOINF] ##########
+
+/*! \file FabricAnalyzer.h
+    \brief Declares the FabricAnalyzer class
+
+    FabricAnalyzer accumulates the fabric tensor of the contacts from a NeighborList during the
+    simulation, so the contact anisotropy of a sheared suspension can be followed at every trigger
+    without storing the positions.
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include "NeighborListPairAnalyzer.h"
+
+#include <memory>
+#include <pybind11/numpy.h>
+#include <pybind11/pybind11.h>
+#include <vector>
+
+#ifndef __FABRIC_ANALYZER_H__
+#define __FABRIC_ANALYZER_H__
+
+namespace hoomd
+    {
+namespace md
+    {
+//! Accumulates the fabric tensor of the contacts between the selected particles
+/*! Two particles i and j of the selected types are in contact when their surface-surface distance
+    h_ij = r_ij - (d_i + d_j)/2 is below the gap cutoff. Each contact adds the orientation tensor
+    n n of its unit vector n = r_ij / r_ij, with r_ij the minimum image in the current box. The
+    sheared boxes of hoomd.update.BoxShear are tilted (Lees-Edwards) boxes, so the minimum image
+    across the y faces includes the xy shift and no strain needs to be tracked.
+
+    Each call to analyze() sums n n and the number of contacts over the ranks and stores
+
+        R_xy = sum_contacts n_x n_y / N
+
+    of the frame, with N the number of selected particles (the normalization of the fabric_tensor
+    routine of the shear analysis scripts). The fabric tensor <n n> = sum n n / N_c, averaged over
+    the contacts of all frames since the last reset, is returned as its 6 independent components
+    (xx, xy, xz, yy, yz, zz).
+
+    The pairs come from a NeighborList: FabricAnalyzer adds gap + d_max to the r_cut matrix of the
+    selected type pairs (see NeighborListPairAnalyzer), so the list (usually the one a pair force
+    already builds) holds every contact. A pair is held by both ranks when j is a ghost, and twice
+    in a full list, so each entry is weighted to count every contact once.
+
+    \ingroup analyzers
+*/
+class PYBIND11_EXPORT FabricAnalyzer : public NeighborListPairAnalyzer
+    {
+    public:
+    //! Construct the analyzer
+    FabricAnalyzer(std::shared_ptr<SystemDefinition> sysdef,
+                   std::shared_ptr<Trigger> trigger,
+                   std::shared_ptr<NeighborList> nlist,
+                   Scalar gap,
+                   const std::vector<unsigned int>& types);
+
+    //! Destructor
+    virtual ~FabricAnalyzer();
+
+    //! Add the contacts of the current frame
+    virtual void analyze(uint64_t timestep);
+
+    //! Clear the accumulated sums
+    void reset();
+
+    //! Get the fabric tensor (xx, xy, xz, yy, yz, zz) averaged over the accumulated contacts
+    pybind11::array_t<double> getFabricTensor() const;
+
+    //! Get R_xy of the last frame
+    Scalar getRxy() const
+        {
+        return m_rxy;
+        }
+
+    //! Get the mean number of contacts per frame
+    Scalar getNContacts() const
+        {
+        return m_n_frames > 0 ? Scalar(m_sum_contacts / double(m_n_frames)) : Scalar(0.0);
+        }
+
+    //! Get the number of frames accumulated since the last reset
+    uint64_t getNFrames() const
+        {
+        return m_n_frames;
+        }
+
+    //! Get the surface-surface distance below which two particles are in contact
+    Scalar getGap() const
+        {
+        return m_gap;
+        }
+
+    protected:
+    Scalar m_gap;          //!< Contact cutoff in h_ij
+    Scalar m_rxy;          //!< R_xy of the last frame
+    double m_sum_nn[6];    //!< Sum of n n over the contacts of all frames
+    double m_sum_contacts; //!< Number of contacts of all frames
+    uint64_t m_n_frames;   //!< Frames accumulated since the last reset
+
+    //! Extend the search range when the particle diameters grow
+    void updateSearchRange();
+    };
+
+namespace detail
+    {
+//! Export FabricAnalyzer to python
+void export_FabricAnalyzer(pybind11::module& m);
+    } // end namespace detail
+
+    } // end namespace md
+    } // end namespace hoomd
+
+#endif // __FABRIC_ANALYZER_H__
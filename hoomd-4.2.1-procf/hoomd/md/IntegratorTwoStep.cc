@@ -28,6 +28,10 @@ IntegratorTwoStep::IntegratorTwoStep(std::shared_ptr<SystemDefinition> sysdef, S
         {
         m_comm->getComputeCallbackSignal()
             .connect<IntegratorTwoStep, &IntegratorTwoStep::updateRigidBodies>(this);
+        //~ add ghost update overlap [RHEOINF]
+        m_comm->getComputeCallbackMovesParticlesSignal()
+            .connect<IntegratorTwoStep, &IntegratorTwoStep::rigidBodiesMoveParticles>(this);
+        //~
         }
 #endif
     }
@@ -41,6 +45,10 @@ IntegratorTwoStep::~IntegratorTwoStep()
         {
         m_comm->getComputeCallbackSignal()
             .disconnect<IntegratorTwoStep, &IntegratorTwoStep::updateRigidBodies>(this);
+        //~ add ghost update overlap [RHEOINF]
+        m_comm->getComputeCallbackMovesParticlesSignal()
+            .disconnect<IntegratorTwoStep, &IntegratorTwoStep::rigidBodiesMoveParticles>(this);
+        //~
         }
 #endif
     }
@@ -322,6 +330,18 @@ void IntegratorTwoStep::updateRigidBodies(uint64_t timestep)
         }
     }
 
+//~ add ghost update overlap [RHEOINF]
+#ifdef ENABLE_MPI
+/*! updateRigidBodies() places the constituent particles of local bodies, so the ghost update ahead
+    of it cannot be overlapped with computation on local particles.
+*/
+bool IntegratorTwoStep::rigidBodiesMoveParticles(uint64_t timestep)
+    {
+    return bool(m_rigid_bodies);
+    }
+#endif
+//~
+
 void IntegratorTwoStep::startAutotuning()
     {
     Integrator::startAutotuning();
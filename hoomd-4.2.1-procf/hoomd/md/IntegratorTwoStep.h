@@ -95,6 +95,11 @@ class PYBIND11_EXPORT IntegratorTwoStep : public Integrator
     /// Updates the rigid body constituent particles
     virtual void updateRigidBodies(uint64_t timestep);
 
+#ifdef ENABLE_MPI
+    /// Tell the Communicator if updateRigidBodies() moves local particles [RHEOINF]
+    bool rigidBodiesMoveParticles(uint64_t timestep);
+#endif
+
     /// Start autotuning kernel launch parameters
     virtual void startAutotuning();
 
@@ -16,6 +16,7 @@
 #include "hoomd/Compute.h"
 
 #include "hoomd/HOOMDMPI.h"
+#include "hoomd/Checkpoint.h" //~ add checkpoint state [RHEOINF]
 
 #include <memory>
 
@@ -258,6 +259,42 @@ class Lifetime : public Compute
     	    }
     #endif
         }
+    //~ add checkpoint state [RHEOINF]
+    //! Append the bond tracking state of this rank to a checkpoint section
+    /*! Bond_check is filled and emptied within one force evaluation, so only the per-pair
+        counters and the events not yet written to the history files are stored.
+    */
+    void writeCheckpointState(hoomd::detail::CheckpointBuffer& buf)
+        {
+        buf.write((uint32_t)track_size);
+        buf.writeArray(Bond_track.data(), Bond_track.size());
+        buf.write((uint64_t)Bond_broke.size());
+        buf.writeArray(Bond_broke.data(), Bond_broke.size());
+        buf.write((uint64_t)Bond_formed.size());
+        buf.writeArray(Bond_formed.data(), Bond_formed.size());
+        }
+
+    //! Read the state written by writeCheckpointState()
+    void readCheckpointState(hoomd::detail::CheckpointBuffer& buf)
+        {
+        uint32_t saved_track_size;
+        buf.read(saved_track_size);
+        if (saved_track_size != track_size)
+            {
+            throw runtime_error("Checkpointed bond lifetimes do not match this system.");
+            }
+        buf.readArray(Bond_track.data(), track_size);
+
+        uint64_t n_broke, n_formed;
+        buf.read(n_broke);
+        Bond_broke.resize(n_broke);
+        buf.readArray(Bond_broke.data(), n_broke);
+        buf.read(n_formed);
+        Bond_formed.resize(n_formed);
+        buf.readArray(Bond_formed.data(), n_formed);
+        }
+    //~
+
     unsigned int num_colloid;         //!< the number of colloid particles
     unsigned int num_solvent;         //!< the number of solvent particles
     unsigned int num_slot;            //!< number of j colloids able to pair with a colloid particle i
@@ -0,0 +1,436 @@
+//~ ########## Created by the Rheoinformatic research group ##########
+//~ HOOMD-blue:
+// Copyright (c) 2009-2023 The Regents of the University of Michigan.
+// Part of HOOMD-blue, released under the BSD 3-Clause License.
+//~
+//~ This file:
+//~ Written by the Rheoinformatic research group (2026)
+
+// ########## Created by Rheoinformatic //~ [RHEOINF] ##########
+
+/*! \file MSDAnalyzer.cc
+    \brief Defines the MSDAnalyzer class
+*/
+
+#include "MSDAnalyzer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <pybind11/stl.h>
+#include <stdexcept>
+
+using namespace std;
+
+namespace hoomd
+    {
+namespace md
+    {
+/*! \param sysdef System definition
+    \param trigger Select the frames
+    \param block_size Number of frames kept per level (p)
+    \param n_levels Largest number of levels
+    \param subtract_affine Set to true to subtract the affine shear displacement
+    \param types Indices of the selected types (all types when empty)
+*/
+MSDAnalyzer::MSDAnalyzer(std::shared_ptr<SystemDefinition> sysdef,
+                         std::shared_ptr<Trigger> trigger,
+                         unsigned int block_size,
+                         unsigned int n_levels,
+                         bool subtract_affine,
+                         const std::vector<unsigned int>& types)
+    : Analyzer(sysdef, trigger), m_p(block_size), m_n_levels(n_levels),
+      m_subtract_affine(subtract_affine), m_frame(0), m_n_frames(0), m_n_flips(0),
+      m_home_set(false), m_first_timestep(0), m_first_strain(0.0)
+    {
+    m_exec_conf->msg->notice(5) << "Constructing MSDAnalyzer" << endl;
+
+    if (m_p < 2)
+        {
+        throw runtime_error("MSD: block_size must be at least 2.");
+        }
+    if (m_n_levels == 0)
+        {
+        throw runtime_error("MSD: n_levels must be positive.");
+        }
+
+    m_include.assign(m_pdata->getNTypes(), types.empty());
+    for (unsigned int type : types)
+        {
+        if (type >= m_pdata->getNTypes())
+            {
+            throw runtime_error("MSD: invalid particle type.");
+            }
+        m_include[type] = true;
+        }
+
+    m_n_bins = m_n_levels * (m_p - 1);
+    const size_t n_values = size_t(m_pdata->getNTypes()) * m_n_bins;
+    m_count.assign(n_values, 0.0);
+    m_sum_r2.assign(n_values, 0.0);
+    m_sum_r4.assign(n_values, 0.0);
+    m_lag_sum.assign(m_n_bins, 0.0);
+    m_lag_count.assign(m_n_bins, 0.0);
+
+    m_xy_last = m_pdata->getGlobalBox().getTiltFactorXY();
+    m_pdata->getBoxChangeSignal().connect<MSDAnalyzer, &MSDAnalyzer::slotBoxChanged>(this);
+    }
+
+MSDAnalyzer::~MSDAnalyzer()
+    {
+    m_exec_conf->msg->notice(5) << "Destroying MSDAnalyzer" << endl;
+    m_pdata->getBoxChangeSignal().disconnect<MSDAnalyzer, &MSDAnalyzer::slotBoxChanged>(this);
+    }
+
+/*! hoomd.update.BoxShear grows the xy tilt by gammadot dt every step and, with flip=True, shifts
+    it by -1 (or +1) when it passes 1/2. A jump of more than 1/2 between two box changes is taken
+    as a flip and undone, so m_xy_last + m_n_flips is the accumulated strain.
+*/
+void MSDAnalyzer::slotBoxChanged()
+    {
+    const double xy = m_pdata->getGlobalBox().getTiltFactorXY();
+    const double delta = xy - m_xy_last;
+    if (delta < -0.5)
+        m_n_flips += (long long)std::round(-delta);
+    else if (delta > 0.5)
+        m_n_flips -= (long long)std::round(delta);
+    m_xy_last = xy;
+    }
+
+/*! The unwrapped position of each local particle of a selected type is sent to the home rank of
+    the particle, tag % (number of ranks). The home particles are fixed by the first frame.
+*/
+void MSDAnalyzer::gatherHomePositions()
+    {
+    const unsigned int n_ranks = m_sysdef->isDomainDecomposed() ? m_exec_conf->getNRanks() : 1;
+
+    // lattice vectors of the global box, with the xy tilt replaced by the accumulated strain
+    const BoxDim& box = m_pdata->getGlobalBox();
+    const Scalar3 L = box.getL();
+    const double strain = m_xy_last + double(m_n_flips);
+    const double3 a1 = make_double3(L.x, 0.0, 0.0);
+    const double3 a2 = make_double3(strain * L.y, L.y, 0.0);
+    const double3 a3
+        = make_double3(box.getTiltFactorXZ() * L.z, box.getTiltFactorYZ() * L.z, L.z);
+
+    std::vector<std::vector<Entry>> send(n_ranks);
+        {
+        ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(),
+                                   access_location::host,
+                                   access_mode::read);
+        ArrayHandle<int3> h_image(m_pdata->getImages(), access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_tag(m_pdata->getTags(),
+                                        access_location::host,
+                                        access_mode::read);
+
+        for (unsigned int i = 0; i < m_pdata->getN(); i++)
+            {
+            const unsigned int type = __scalar_as_int(h_pos.data[i].w);
+            if (!m_include[type])
+                continue;
+
+            const int3 img = h_image.data[i];
+            Entry e;
+            e.tag = h_tag.data[i];
+            e.type = type;
+            e.x = h_pos.data[i].x + img.x * a1.x + img.y * a2.x + img.z * a3.x;
+            e.y = h_pos.data[i].y + img.y * a2.y + img.z * a3.y;
+            e.z = h_pos.data[i].z + img.z * a3.z;
+            send[e.tag % n_ranks].push_back(e);
+            }
+        }
+
+    std::vector<Entry> recv;
+#ifdef ENABLE_MPI
+    if (n_ranks > 1)
+        {
+        MPI_Comm mpi_comm = m_exec_conf->getMPICommunicator();
+        std::vector<int> send_bytes(n_ranks), recv_bytes(n_ranks);
+        std::vector<int> send_displ(n_ranks), recv_displ(n_ranks);
+        std::vector<Entry> send_buf;
+        for (unsigned int r = 0; r < n_ranks; r++)
+            {
+            send_displ[r] = int(send_buf.size() * sizeof(Entry));
+            send_bytes[r] = int(send[r].size() * sizeof(Entry));
+            send_buf.insert(send_buf.end(), send[r].begin(), send[r].end());
+            }
+        MPI_Alltoall(send_bytes.data(), 1, MPI_INT, recv_bytes.data(), 1, MPI_INT, mpi_comm);
+
+        size_t n_recv_bytes = 0;
+        for (unsigned int r = 0; r < n_ranks; r++)
+            {
+            recv_displ[r] = int(n_recv_bytes);
+            n_recv_bytes += recv_bytes[r];
+            }
+        recv.resize(n_recv_bytes / sizeof(Entry));
+        MPI_Alltoallv(send_buf.data(),
+                      send_bytes.data(),
+                      send_displ.data(),
+                      MPI_BYTE,
+                      recv.data(),
+                      recv_bytes.data(),
+                      recv_displ.data(),
+                      MPI_BYTE,
+                      mpi_comm);
+        }
+    else
+#endif
+        {
+        recv.swap(send[0]);
+        }
+
+    if (!m_home_set)
+        {
+        std::sort(recv.begin(),
+                  recv.end(),
+                  [](const Entry& a, const Entry& b) { return a.tag < b.tag; });
+        m_home_tags.resize(recv.size());
+        m_home_types.resize(recv.size());
+        for (size_t s = 0; s < recv.size(); s++)
+            {
+            m_home_tags[s] = recv[s].tag;
+            m_home_types[s] = recv[s].type;
+            }
+        m_current.resize(recv.size() * 3);
+        m_home_set = true;
+        }
+
+    if (recv.size() != m_home_tags.size())
+        {
+        throw runtime_error("MSD: the number of particles of the selected types changed.");
+        }
+    for (const Entry& e : recv)
+        {
+        auto it = std::lower_bound(m_home_tags.begin(), m_home_tags.end(), e.tag);
+        if (it == m_home_tags.end() || *it != e.tag)
+            {
+            throw runtime_error("MSD: the particles of the selected types changed.");
+            }
+        const size_t s = it - m_home_tags.begin();
+        m_current[3 * s] = e.x;
+        m_current[3 * s + 1] = e.y;
+        m_current[3 * s + 2] = e.z;
+        }
+    }
+
+/*! \param l Level
+    \param timestep Current timestep
+    \param strain Current accumulated strain
+
+    Level l keeps p - 1 frames, the k-th latest is k p^l frames old.
+*/
+void MSDAnalyzer::updateLevel(unsigned int l, uint64_t timestep, double strain)
+    {
+    Level& level = m_levels[l];
+    const unsigned int n_slots = m_p - 1;
+    const size_t n_home = m_home_tags.size();
+
+    for (unsigned int k = 1; k <= level.n_filled; k++)
+        {
+        const unsigned int slot = (level.head + n_slots - k) % n_slots;
+        const unsigned int bin = l * (m_p - 1) + (k - 1);
+        const double* old = level.pos.data() + slot * n_home * 3;
+        const double d_strain = m_subtract_affine ? strain - level.strain[slot] : 0.0;
+
+        for (size_t s = 0; s < n_home; s++)
+            {
+            double dx = m_current[3 * s] - old[3 * s];
+            const double dy = m_current[3 * s + 1] - old[3 * s + 1];
+            const double dz = m_current[3 * s + 2] - old[3 * s + 2];
+            // the affine displacement of u_x = gammadot y, with y averaged over the interval
+            dx -= d_strain * 0.5 * (m_current[3 * s + 1] + old[3 * s + 1]);
+
+            const double r2 = dx * dx + dy * dy + dz * dz;
+            const size_t idx = size_t(m_home_types[s]) * m_n_bins + bin;
+            m_count[idx] += 1.0;
+            m_sum_r2[idx] += r2;
+            m_sum_r4[idx] += r2 * r2;
+            }
+
+        m_lag_sum[bin] += double(timestep - level.timestep[slot]);
+        m_lag_count[bin] += 1.0;
+        }
+
+    std::copy(m_current.begin(), m_current.end(), level.pos.begin() + level.head * n_home * 3);
+    level.timestep[level.head] = timestep;
+    level.strain[level.head] = strain;
+    level.head = (level.head + 1) % n_slots;
+    level.n_filled = std::min(level.n_filled + 1, n_slots);
+    }
+
+/*! \param timestep Current time step of the simulation
+ */
+void MSDAnalyzer::analyze(uint64_t timestep)
+    {
+    Analyzer::analyze(timestep);
+
+    gatherHomePositions();
+    const double strain = m_xy_last + double(m_n_flips);
+    if (m_frame == 0)
+        {
+        m_first = m_current;
+        m_first_timestep = timestep;
+        m_first_strain = strain;
+        }
+
+    // level l takes the frames whose index is a multiple of p^l
+    uint64_t stride = 1;
+    for (unsigned int l = 0; l < m_n_levels; l++)
+        {
+        if (m_frame % stride != 0)
+            break;
+
+        if (l == m_levels.size())
+            {
+            // level 0 starts on the first frame, the others when the frame index reaches p^l
+            if (l > 0 && m_frame < stride)
+                break;
+
+            const size_t n_slots = m_p - 1;
+            m_levels.push_back(Level());
+            Level& level = m_levels.back();
+            level.pos.resize(n_slots * m_current.size());
+            level.timestep.resize(n_slots);
+            level.strain.resize(n_slots);
+
+            // the first frame is a time origin of every level
+            if (l > 0)
+                {
+                std::copy(m_first.begin(), m_first.end(), level.pos.begin());
+                level.timestep[0] = m_first_timestep;
+                level.strain[0] = m_first_strain;
+                level.head = 1 % n_slots;
+                level.n_filled = 1;
+                }
+            }
+        updateLevel(l, timestep, strain);
+
+        if (stride > std::numeric_limits<uint64_t>::max() / m_p)
+            break;
+        stride *= m_p;
+        }
+
+    m_frame++;
+    m_n_frames++;
+    }
+
+void MSDAnalyzer::reset()
+    {
+    std::fill(m_count.begin(), m_count.end(), 0.0);
+    std::fill(m_sum_r2.begin(), m_sum_r2.end(), 0.0);
+    std::fill(m_sum_r4.begin(), m_sum_r4.end(), 0.0);
+    std::fill(m_lag_sum.begin(), m_lag_sum.end(), 0.0);
+    std::fill(m_lag_count.begin(), m_lag_count.end(), 0.0);
+    m_n_frames = 0;
+    }
+
+/*! All ranks must call this method.
+ */
+void MSDAnalyzer::reduceSums(std::vector<double>& count,
+                             std::vector<double>& sum_r2,
+                             std::vector<double>& sum_r4)
+    {
+    count = m_count;
+    sum_r2 = m_sum_r2;
+    sum_r4 = m_sum_r4;
+#ifdef ENABLE_MPI
+    if (m_sysdef->isDomainDecomposed())
+        {
+        MPI_Comm mpi_comm = m_exec_conf->getMPICommunicator();
+        MPI_Allreduce(MPI_IN_PLACE, count.data(), (int)count.size(), MPI_DOUBLE, MPI_SUM, mpi_comm);
+        MPI_Allreduce(MPI_IN_PLACE,
+                      sum_r2.data(),
+                      (int)sum_r2.size(),
+                      MPI_DOUBLE,
+                      MPI_SUM,
+                      mpi_comm);
+        MPI_Allreduce(MPI_IN_PLACE,
+                      sum_r4.data(),
+                      (int)sum_r4.size(),
+                      MPI_DOUBLE,
+                      MPI_SUM,
+                      mpi_comm);
+        }
+#endif
+    }
+
+/*! Every rank runs the same frame schedule, so the lags are the same on all ranks.
+ */
+pybind11::array_t<double> MSDAnalyzer::getLagSteps() const
+    {
+    pybind11::array_t<double> result(m_n_bins);
+    double* data = result.mutable_data();
+    for (unsigned int b = 0; b < m_n_bins; b++)
+        {
+        data[b] = m_lag_count[b] > 0.0 ? m_lag_sum[b] / m_lag_count[b]
+                                       : std::numeric_limits<double>::quiet_NaN();
+        }
+    return result;
+    }
+
+pybind11::array_t<double> MSDAnalyzer::getLagCounts() const
+    {
+    return pybind11::array_t<double>(m_lag_count.size(), m_lag_count.data());
+    }
+
+pybind11::array_t<double> MSDAnalyzer::getMSD()
+    {
+    std::vector<double> count, sum_r2, sum_r4;
+    reduceSums(count, sum_r2, sum_r4);
+
+    pybind11::array_t<double> result(
+        std::vector<size_t> {(size_t)m_pdata->getNTypes(), (size_t)m_n_bins});
+    double* data = result.mutable_data();
+    for (size_t k = 0; k < count.size(); k++)
+        {
+        data[k] = count[k] > 0.0 ? sum_r2[k] / count[k] : std::numeric_limits<double>::quiet_NaN();
+        }
+    return result;
+    }
+
+/*! alpha_2 = d <dr^4> / ((d + 2) <dr^2>^2) - 1 in d dimensions.
+ */
+pybind11::array_t<double> MSDAnalyzer::getNonGaussian()
+    {
+    std::vector<double> count, sum_r2, sum_r4;
+    reduceSums(count, sum_r2, sum_r4);
+
+    const double d = m_sysdef->getNDimensions();
+    pybind11::array_t<double> result(
+        std::vector<size_t> {(size_t)m_pdata->getNTypes(), (size_t)m_n_bins});
+    double* data = result.mutable_data();
+    for (size_t k = 0; k < count.size(); k++)
+        {
+        const double r2 = count[k] > 0.0 ? sum_r2[k] / count[k] : 0.0;
+        data[k] = r2 > 0.0 ? d * (sum_r4[k] / count[k]) / ((d + 2.0) * r2 * r2) - 1.0
+                           : std::numeric_limits<double>::quiet_NaN();
+        }
+    return result;
+    }
+
+namespace detail
+    {
+void export_MSDAnalyzer(pybind11::module& m)
+    {
+    pybind11::class_<MSDAnalyzer, Analyzer, std::shared_ptr<MSDAnalyzer>>(m, "MSDAnalyzer")
+        .def(pybind11::init<std::shared_ptr<SystemDefinition>,
+                            std::shared_ptr<Trigger>,
+                            unsigned int,
+                            unsigned int,
+                            bool,
+                            const std::vector<unsigned int>&>())
+        .def("reset", &MSDAnalyzer::reset)
+        .def("getLagSteps", &MSDAnalyzer::getLagSteps)
+        .def("getLagCounts", &MSDAnalyzer::getLagCounts)
+        .def("getMSD", &MSDAnalyzer::getMSD)
+        .def("getNonGaussian", &MSDAnalyzer::getNonGaussian)
+        .def_property_readonly("n_frames", &MSDAnalyzer::getNFrames)
+        .def_property_readonly("block_size", &MSDAnalyzer::getBlockSize)
+        .def_property_readonly("n_levels", &MSDAnalyzer::getNLevels)
+        .def_property_readonly("subtract_affine", &MSDAnalyzer::getSubtractAffine)
+        .def_property_readonly("strain", &MSDAnalyzer::getStrain);
+    }
+
+    } // end namespace detail
+    } // end namespace md
+    } // end namespace hoomd
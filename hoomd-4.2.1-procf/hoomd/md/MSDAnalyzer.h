@@ -0,0 +1,191 @@
+//~ ########## Created by the Rheoinformatic research group ##########
+//~ HOOMD-blue:
+// Copyright (c) 2009-2023 The Regents of the University of Michigan.
+// Part of HOOMD-blue, released under the BSD 3-Clause License.
+//~
+//~ This file:
+//~ Written by the Rheoinformatic research group (2026)
+
+// ########## Created by Rheoinformatic //~ [RHEOINF] ##########
+
+/*! \file MSDAnalyzer.h
+    \brief Declares the MSDAnalyzer class
+
+    MSDAnalyzer accumulates the mean-squared displacement and the non-Gaussian parameter of every
+    particle type with the order-n (multiple-tau) scheme of Frenkel and Smit, so long-time
+    dynamics no longer need every frame stored and an O(frames^2) pass after the run.
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include "hoomd/Analyzer.h"
+
+#include <memory>
+#include <pybind11/numpy.h>
+#include <pybind11/pybind11.h>
+#include <vector>
+
+#ifndef __MSD_ANALYZER_H__
+#define __MSD_ANALYZER_H__
+
+namespace hoomd
+    {
+namespace md
+    {
+//! Accumulates the MSD and the non-Gaussian parameter per type with a multiple-tau scheme
+/*! Frames are the timesteps on which analyze() is called. Level l of the correlator keeps the
+    unwrapped positions of the last p - 1 frames (p is the block size) whose index is a multiple of
+    p^l, so level l measures the lags k p^l frames, k = 1 .. p-1. The lags are log spaced and the
+    memory is N (p - 1) (number of levels) positions, instead of one position per frame. Level l
+    is allocated when the frame index first reaches p^l and starts with the first frame, which is a
+    multiple of every p^l, so every level keeps it as a time origin.
+
+    For each lag and type, the sums of |dr|^2 and |dr|^4 and the number of displacements are
+    accumulated, giving MSD = <dr^2> and alpha_2 = d <dr^4> / ((d + 2) <dr^2>^2) - 1.
+
+    <b>Unwrapped positions:</b> r + i_x a_1 + i_y a_2 + i_z a_3 from the particle images and the
+    lattice vectors of the global box. Under shear with a deforming box (hoomd.update.BoxShear),
+    the xy tilt is the accumulated strain gamma. MSDAnalyzer tracks it on every box change and
+    undoes the flips by one box length (flip=True), so the unwrapped positions stay continuous.
+    The affine displacement (gamma(t) - gamma(t0)) (y(t) + y(t0))/2 of the flow u_x = gammadot y
+    is subtracted from the x displacement when subtract_affine is set.
+
+    <b>MPI:</b> the correlator of a particle lives on its home rank, tag % (number of ranks). On
+    each frame, every rank sends the unwrapped positions of its local particles to their home
+    ranks, so particles migrating between domains keep their history.
+
+    \ingroup analyzers
+*/
+class PYBIND11_EXPORT MSDAnalyzer : public Analyzer
+    {
+    public:
+    //! Construct the analyzer
+    MSDAnalyzer(std::shared_ptr<SystemDefinition> sysdef,
+                std::shared_ptr<Trigger> trigger,
+                unsigned int block_size,
+                unsigned int n_levels,
+                bool subtract_affine,
+                const std::vector<unsigned int>& types);
+
+    //! Destructor
+    virtual ~MSDAnalyzer();
+
+    //! Add the current frame to the correlator
+    virtual void analyze(uint64_t timestep);
+
+    //! Clear the accumulated sums (the stored positions are kept)
+    void reset();
+
+    //! Get the mean lag of each correlator bin, in timesteps (NaN for empty bins)
+    pybind11::array_t<double> getLagSteps() const;
+
+    //! Get the number of time origins of each correlator bin
+    pybind11::array_t<double> getLagCounts() const;
+
+    //! Get the MSD, shape (number of types, number of bins)
+    pybind11::array_t<double> getMSD();
+
+    //! Get the non-Gaussian parameter, shape (number of types, number of bins)
+    pybind11::array_t<double> getNonGaussian();
+
+    //! Get the number of frames added since the last reset
+    uint64_t getNFrames() const
+        {
+        return m_n_frames;
+        }
+
+    //! Get the number of frames kept per level
+    unsigned int getBlockSize() const
+        {
+        return m_p;
+        }
+
+    //! Get the largest number of levels
+    unsigned int getNLevels() const
+        {
+        return m_n_levels;
+        }
+
+    //! Test if the affine shear displacement is subtracted
+    bool getSubtractAffine() const
+        {
+        return m_subtract_affine;
+        }
+
+    //! Get the accumulated strain (xy tilt without flips)
+    Scalar getStrain() const
+        {
+        return Scalar(m_xy_last + m_n_flips);
+        }
+
+    private:
+    //! Unwrapped position of one particle sent to its home rank
+    struct Entry
+        {
+        unsigned int tag;  //!< Particle tag
+        unsigned int type; //!< Particle type
+        double x;          //!< Unwrapped position
+        double y;
+        double z;
+        };
+
+    //! Frames kept by one level of the correlator
+    struct Level
+        {
+        std::vector<double> pos;         //!< Positions, p - 1 frames of n_home * 3 values
+        std::vector<uint64_t> timestep;  //!< Timestep of each frame
+        std::vector<double> strain;      //!< Strain of each frame
+        unsigned int head = 0;           //!< Next frame to overwrite
+        unsigned int n_filled = 0;       //!< Number of frames stored
+        };
+
+    unsigned int m_p;                    //!< Block size (frames per level)
+    unsigned int m_n_levels;             //!< Largest number of levels
+    bool m_subtract_affine;              //!< True to subtract the affine shear displacement
+    std::vector<bool> m_include;         //!< True for the selected types
+    unsigned int m_n_bins;               //!< Number of lags, n_levels * (p - 1)
+    uint64_t m_frame;                    //!< Frames added since construction
+    uint64_t m_n_frames;                 //!< Frames added since the last reset
+    double m_xy_last;                    //!< xy tilt at the last box change
+    long long m_n_flips;                 //!< Net number of tilt flips undone
+    bool m_home_set;                     //!< True once the home particles are known
+    std::vector<unsigned int> m_home_tags;  //!< Sorted tags of the home particles
+    std::vector<unsigned int> m_home_types; //!< Types of the home particles
+    std::vector<double> m_current;       //!< Unwrapped positions of the home particles
+    std::vector<Level> m_levels;         //!< Allocated levels
+    std::vector<double> m_first;         //!< Unwrapped positions of the first frame
+    uint64_t m_first_timestep;           //!< Timestep of the first frame
+    double m_first_strain;               //!< Strain of the first frame
+    std::vector<double> m_count;         //!< Number of displacements per (type, bin)
+    std::vector<double> m_sum_r2;        //!< Sum of |dr|^2 per (type, bin)
+    std::vector<double> m_sum_r4;        //!< Sum of |dr|^4 per (type, bin)
+    std::vector<double> m_lag_sum;       //!< Sum of the lags (timesteps) per bin
+    std::vector<double> m_lag_count;     //!< Number of lag samples per bin
+
+    //! Track the accumulated strain through tilt flips
+    void slotBoxChanged();
+
+    //! Gather the unwrapped positions of the home particles into m_current
+    void gatherHomePositions();
+
+    //! Correlate the current frame with the frames of one level and store it there
+    void updateLevel(unsigned int l, uint64_t timestep, double strain);
+
+    //! Sum the accumulators over the ranks
+    void reduceSums(std::vector<double>& count,
+                    std::vector<double>& sum_r2,
+                    std::vector<double>& sum_r4);
+    };
+
+namespace detail
+    {
+//! Export MSDAnalyzer to python
+void export_MSDAnalyzer(pybind11::module& m);
+    } // end namespace detail
+
+    } // end namespace md
+    } // end namespace hoomd
+
+#endif // __MSD_ANALYZER_H__
@@ -1,13 +1,17 @@
 // Copyright (c) 2009-2023 The Regents of the University of Michigan.
 // Part of HOOMD-blue, released under the BSD 3-Clause License.
 
+// ########## Modified by Rheoinformatic //~ [RHEOINF] ##########
+
 #ifdef ENABLE_MPI
 #include "hoomd/Communicator.h"
 #endif
 
 #include "NeighborList.h"
 #include "hoomd/BondedGroupData.h"
+#include "hoomd/Checkpoint.h" //~ add checkpoint state [RHEOINF]
 
+#include <algorithm> //~ sort neighbors for the compressed nlist [RHEOINF]
 #include <iostream>
 #include <stdexcept>
 
@@ -52,6 +56,19 @@ NeighborList::NeighborList(std::shared_ptr<SystemDefinition> sysdef, Scalar r_bu
 
     m_n_particles_changed = false;
 
+    //~ compressed nlist storage is off by default [RHEOINF]
+    m_compressed = false;
+    m_nlist_compressed_size = 0;
+    m_nlist_uncompressed_size = 0;
+    //~
+    m_build_skipped = false; //~ add neighbor list free pair evaluation [RHEOINF]
+    //~ interior/boundary classification is off by default [RHEOINF]
+    m_classify_requests = 0;
+    m_n_interior = 0;
+    m_n_classified = 0;
+    m_build_count = 0;
+    //~
+
     // initialize box length at last update
     m_last_L = m_pdata->getGlobalBox().getNearestPlaneDistance();
     m_last_L_local = m_pdata->getBox().getNearestPlaneDistance();
@@ -376,7 +393,8 @@ void NeighborList::compute(uint64_t timestep)
         }
 
     // skip if we shouldn't compute this step
-    if (!shouldCompute(timestep) && !m_force_update)
+    if (!shouldCompute(timestep) && !m_force_update
+        && !m_build_skipped) //~ build a list skipped by trackDisplacements [RHEOINF]
         return;
 
     // when the number of particles or bonds in the system changes, rebuild the exclusion list
@@ -393,7 +411,7 @@ void NeighborList::compute(uint64_t timestep)
         }
 
     // take care of some updates if things have changed since construction
-    if (m_force_update)
+    if (m_force_update || m_build_skipped) //~ add m_build_skipped [RHEOINF]
         {
         // build the head list since some sort of change (like a particle sort) happened
         buildHeadList();
@@ -403,7 +421,7 @@ void NeighborList::compute(uint64_t timestep)
         }
 
     // check if the list needs to be updated and update it
-    if (needsUpdating(timestep))
+    if (needsUpdating(timestep) || m_build_skipped) //~ add m_build_skipped [RHEOINF]
         {
         // check simulation box size is OK
         checkBoxSize();
@@ -429,10 +447,120 @@ void NeighborList::compute(uint64_t timestep)
         if (m_exclusions_set)
             filterNlist();
 
+        //~ add compressed nlist storage [RHEOINF]
+        if (m_compressed)
+            compressNlist();
+        //~
+
+        //~ add interior/boundary classification [RHEOINF]
+        if (m_classify_requests > 0)
+            classifyInterior();
+        m_build_count++;
+        //~
+
         setLastUpdatedPos();
         m_has_been_updated_once = true;
+        m_build_skipped = false; //~ [RHEOINF]
+        }
+    }
+
+//~ add neighbor list free pair evaluation [RHEOINF]
+/*! \param timestep Current time step
+
+    Performs the same bookkeeping as compute() up to the point where the list would be built: the
+    r_cut matrix is updated, the displacement check is run and, if it triggers, the current
+    positions are recorded as the reference for the next check. The skipped build is remembered so
+    that a later compute() on the same list still builds it.
+*/
+void NeighborList::trackDisplacements(uint64_t timestep)
+    {
+    Compute::compute(timestep);
+    if (m_rcut_changed)
+        {
+        updateRList();
+#ifdef ENABLE_MPI
+        if (m_sysdef->isDomainDecomposed())
+            {
+            m_comm->communicate(timestep);
+            }
+#endif
+        }
+
+    if (!shouldCompute(timestep) && !m_force_update)
+        return;
+
+    if (needsUpdating(timestep))
+        {
+        checkBoxSize();
+        setLastUpdatedPos();
+        m_build_skipped = true;
+        }
+    }
+//~
+
+//~ add interior/boundary classification for ghost update overlap [RHEOINF]
+/*! \param timestep Current time step
+
+    The classification made at the last build can be used on this step if nothing has asked for a
+    rebuild: the rebuild check for \a timestep has already run (with MPI, the Communicator runs it
+    before every ghost update to decide on migration) and returned false, and no forced update,
+    r_cut change or skipped build is pending.
+*/
+bool NeighborList::isInteriorCurrent(uint64_t timestep)
+    {
+    return m_classify_requests > 0 && m_has_been_updated_once && m_n_classified == m_pdata->getN()
+           && !m_rcut_changed && !m_force_update && !m_build_skipped && !m_n_particles_changed
+           && !m_topology_changed && m_last_checked_tstep == timestep && !m_last_check_result;
+    }
+
+/*! Fills m_interior_order with the indices of the local particles that have no ghost neighbors,
+    followed by the indices of the particles that have at least one. Both runs keep the particle
+    order, so memory access in the pair loop stays as local as in the sorted particle data.
+*/
+void NeighborList::classifyInterior()
+    {
+    const unsigned int N = m_pdata->getN();
+    if (m_interior_order.getNumElements() < N)
+        {
+        GlobalArray<unsigned int> interior_order(m_pdata->getMaxN(), m_exec_conf);
+        m_interior_order.swap(interior_order);
+        TAG_ALLOCATION(m_interior_order);
+        }
+
+    ArrayHandle<size_t> h_head_list(m_head_list, access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_n_neigh(m_n_neigh, access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_nlist(m_nlist, access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_interior_order(m_interior_order,
+                                               access_location::host,
+                                               access_mode::overwrite);
+
+    // interior particles fill the array from the front, boundary particles are appended after
+    std::vector<unsigned int> boundary;
+    unsigned int n_interior = 0;
+    for (unsigned int i = 0; i < N; ++i)
+        {
+        const size_t head_i = h_head_list.data[i];
+        const unsigned int n_neigh = h_n_neigh.data[i];
+        bool interior = true;
+        for (unsigned int k = 0; k < n_neigh; ++k)
+            {
+            if (h_nlist.data[head_i + k] >= N)
+                {
+                interior = false;
+                break;
+                }
+            }
+        if (interior)
+            h_interior_order.data[n_interior++] = i;
+        else
+            boundary.push_back(i);
         }
+    std::copy(boundary.begin(), boundary.end(), h_interior_order.data + n_interior);
+
+    m_n_interior = n_interior;
+    m_n_classified = N;
     }
+//~
 
 /*! \param r_buff New buffer radius to set
     \note Changing the buffer radius does NOT immediately update the neighborlist.
@@ -1535,6 +1663,123 @@ void NeighborList::filterNlist()
         }
     }
 
+//~ add compressed nlist storage [RHEOINF]
+/*! \param compressed Set to true to maintain a delta encoded copy of the neighbor list
+
+    The compressed copy is only read by the CPU pair potentials, so it is refused when the
+    simulation runs on a GPU.
+*/
+void NeighborList::setCompressed(bool compressed)
+    {
+    if (compressed && m_exec_conf->isCUDAEnabled())
+        {
+        m_exec_conf->msg->warning()
+            << "nlist: compressed neighbor list storage is only available on the CPU, ignoring"
+            << endl;
+        compressed = false;
+        }
+
+    if (compressed != m_compressed)
+        {
+        m_compressed = compressed;
+        forceUpdate();
+        }
+
+    if (!m_compressed)
+        {
+        // release the memory held by the compressed copy
+        GlobalArray<uint16_t> nlist_compressed;
+        m_nlist_compressed.swap(nlist_compressed);
+        GlobalArray<size_t> head_list_compressed;
+        m_head_list_compressed.swap(head_list_compressed);
+        m_nlist_compressed_size = 0;
+        m_nlist_uncompressed_size = 0;
+        }
+    }
+
+/*! Encodes the 32-bit neighbor list into m_nlist_compressed. The neighbors of each particle are
+    sorted by index and written as 16-bit differences (see NeighborListCompression.h). The
+    compressed head list is computed in a first pass so that the storage can be sized exactly.
+*/
+void NeighborList::compressNlist()
+    {
+    const unsigned int N = m_pdata->getN();
+
+    if (m_head_list_compressed.getNumElements() < m_head_list.getNumElements())
+        {
+        GlobalArray<size_t> head_list_compressed(m_head_list.getNumElements(), m_exec_conf);
+        m_head_list_compressed.swap(head_list_compressed);
+        TAG_ALLOCATION(m_head_list_compressed);
+        }
+
+    ArrayHandle<size_t> h_head_list(m_head_list, access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_n_neigh(m_n_neigh, access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_nlist(m_nlist, access_location::host, access_mode::readwrite);
+
+    // first pass: sort each particle's neighbors and count the encoded words
+    size_t total_words = 0;
+    size_t total_neigh = 0;
+        {
+        ArrayHandle<size_t> h_head_list_compressed(m_head_list_compressed,
+                                                   access_location::host,
+                                                   access_mode::overwrite);
+        for (unsigned int i = 0; i < N; ++i)
+            {
+            unsigned int* neigh = h_nlist.data + h_head_list.data[i];
+            const unsigned int n_neigh = h_n_neigh.data[i];
+            std::sort(neigh, neigh + n_neigh);
+
+            h_head_list_compressed.data[i] = total_words;
+            uint32_t prev = i;
+            for (unsigned int k = 0; k < n_neigh; ++k)
+                {
+                total_words += detail::nlistEncodedLength(detail::nlistZigZagEncode(neigh[k] - prev));
+                prev = neigh[k];
+                }
+            total_neigh += n_neigh;
+            }
+        }
+
+    // amortized resizing of the compressed storage (growth factor: 9/8), as in resizeNlist()
+    if (total_words > m_nlist_compressed.getNumElements())
+        {
+        size_t alloc_size = total_words + total_words / 8 + 1;
+        m_exec_conf->msg->notice(6) << "nlist: (Re-)allocating compressed neighbor list, new size "
+                                    << alloc_size << " words" << endl;
+        if (m_nlist_compressed.isNull())
+            {
+            GlobalArray<uint16_t> nlist_compressed(alloc_size, m_exec_conf);
+            m_nlist_compressed.swap(nlist_compressed);
+            TAG_ALLOCATION(m_nlist_compressed);
+            }
+        else
+            {
+            m_nlist_compressed.resize(alloc_size);
+            }
+        }
+
+    // second pass: encode
+        {
+        ArrayHandle<size_t> h_head_list_compressed(m_head_list_compressed,
+                                                   access_location::host,
+                                                   access_mode::read);
+        ArrayHandle<uint16_t> h_nlist_compressed(m_nlist_compressed,
+                                                 access_location::host,
+                                                 access_mode::overwrite);
+        for (unsigned int i = 0; i < N; ++i)
+            {
+            detail::nlistEncode(h_nlist_compressed.data + h_head_list_compressed.data[i],
+                                i,
+                                h_nlist.data + h_head_list.data[i],
+                                h_n_neigh.data[i]);
+            }
+        }
+
+    m_nlist_compressed_size = total_words;
+    m_nlist_uncompressed_size = total_neigh;
+    }
+//~
+
 /*!
  * Iterates through each particle, and calculates a running sum of the starting index for that
  * particle in the flat array of neighbors.
@@ -1985,6 +2230,152 @@ Scalar NeighborList::getRCut(pybind11::tuple types)
     return h_rcut_base.data[m_typpair_idx(typ1, typ2)];
     }
 
+//~ add checkpoint state [RHEOINF]
+/*! The list is stored by local index, together with everything needsUpdating() consults, so a
+    restarted run rebuilds the list on the same steps as the run that wrote the checkpoint and
+    walks the neighbors in the same order in between.
+*/
+pybind11::bytes NeighborList::getCheckpointState()
+    {
+    hoomd::detail::CheckpointBuffer buf;
+    unsigned int N = m_pdata->getN();
+    unsigned int n_types = m_pdata->getNTypes();
+    buf.write(N);
+    buf.write(n_types);
+
+        {
+        ArrayHandle<unsigned int> h_Nmax(m_Nmax, access_location::host, access_mode::read);
+        ArrayHandle<size_t> h_head_list(m_head_list, access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_n_neigh(m_n_neigh, access_location::host, access_mode::read);
+        ArrayHandle<Scalar4> h_last_pos(m_last_pos, access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_nlist(m_nlist, access_location::host, access_mode::read);
+
+        size_t nlist_size = 0;
+        for (unsigned int i = 0; i < N; ++i)
+            nlist_size = std::max(nlist_size, h_head_list.data[i] + h_n_neigh.data[i]);
+
+        buf.writeArray(h_Nmax.data, n_types);
+        buf.writeArray(h_head_list.data, N);
+        buf.writeArray(h_n_neigh.data, N);
+        buf.writeArray(h_last_pos.data, N);
+        buf.write((uint64_t)nlist_size);
+        buf.writeArray(h_nlist.data, nlist_size);
+        }
+
+    buf.write(m_last_L);
+    buf.write(m_last_L_local);
+    buf.write(m_last_updated_tstep);
+    buf.write(m_last_checked_tstep);
+    buf.write((uint8_t)m_last_check_result);
+    buf.write((uint8_t)m_has_been_updated_once);
+    buf.write((uint8_t)m_build_skipped);
+    buf.write(m_updates);
+    buf.write(m_forced_updates);
+    buf.write(m_dangerous_updates);
+    buf.write(m_build_count);
+    buf.write((uint64_t)m_update_periods.size());
+    buf.writeArray(m_update_periods.data(), m_update_periods.size());
+    buf.write(m_last_computed);
+    buf.write((uint8_t)m_first_compute);
+    return pybind11::bytes(buf.str());
+    }
+
+/*! With domain decomposition the state is not applied: the ghost exchange forced by
+    Integrator::prepRun() rebuilds the list, in the original run and in the restarted one alike.
+*/
+void NeighborList::setCheckpointState(pybind11::bytes state)
+    {
+    if (m_sysdef->isDomainDecomposed())
+        return;
+
+    hoomd::detail::CheckpointBuffer buf((std::string)state);
+    unsigned int N, n_types;
+    buf.read(N);
+    buf.read(n_types);
+    if (N != m_pdata->getN() || n_types != m_pdata->getNTypes())
+        {
+        throw std::runtime_error("Checkpointed neighbor list does not match this system.");
+        }
+
+    // bring the cutoffs and exclusions up to date, as the first compute() would
+    if (m_rcut_changed)
+        updateRList();
+
+    if (m_n_particles_changed || m_topology_changed)
+        {
+        resizeAndClearExclusions();
+        m_n_particles_changed = false;
+        m_topology_changed = false;
+
+        for (const std::string& exclusion : m_exclusions)
+            {
+            setSingleExclusion(exclusion);
+            }
+        }
+
+        {
+        ArrayHandle<unsigned int> h_Nmax(m_Nmax, access_location::host, access_mode::overwrite);
+        buf.readArray(h_Nmax.data, n_types);
+        }
+        {
+        ArrayHandle<size_t> h_head_list(m_head_list, access_location::host, access_mode::overwrite);
+        buf.readArray(h_head_list.data, N);
+        }
+        {
+        ArrayHandle<unsigned int> h_n_neigh(m_n_neigh,
+                                            access_location::host,
+                                            access_mode::overwrite);
+        ArrayHandle<Scalar4> h_last_pos(m_last_pos,
+                                        access_location::host,
+                                        access_mode::overwrite);
+        buf.readArray(h_n_neigh.data, N);
+        buf.readArray(h_last_pos.data, N);
+        }
+
+    uint64_t nlist_size;
+    buf.read(nlist_size);
+    resizeNlist(nlist_size);
+        {
+        ArrayHandle<unsigned int> h_nlist(m_nlist, access_location::host, access_mode::overwrite);
+        buf.readArray(h_nlist.data, nlist_size);
+        }
+
+    if (m_exclusions_set)
+        updateExListIdx();
+
+    uint8_t last_check_result, has_been_updated_once, build_skipped, first_compute;
+    uint64_t n_update_periods;
+    buf.read(m_last_L);
+    buf.read(m_last_L_local);
+    buf.read(m_last_updated_tstep);
+    buf.read(m_last_checked_tstep);
+    buf.read(last_check_result);
+    buf.read(has_been_updated_once);
+    buf.read(build_skipped);
+    buf.read(m_updates);
+    buf.read(m_forced_updates);
+    buf.read(m_dangerous_updates);
+    buf.read(m_build_count);
+    buf.read(n_update_periods);
+    m_update_periods.resize(n_update_periods);
+    buf.readArray(m_update_periods.data(), n_update_periods);
+    buf.read(m_last_computed);
+    buf.read(first_compute);
+    m_last_check_result = last_check_result;
+    m_has_been_updated_once = has_been_updated_once;
+    m_build_skipped = build_skipped;
+    m_first_compute = first_compute;
+
+    // the derived copies are functions of the list
+    if (m_compressed)
+        compressNlist();
+    if (m_classify_requests > 0)
+        classifyInterior();
+
+    m_force_update = false;
+    }
+//~
+
 namespace detail
     {
 void export_NeighborList(pybind11::module& m)
@@ -1996,6 +2387,12 @@ void export_NeighborList(pybind11::module& m)
                       &NeighborList::getRebuildCheckDelay,
                       &NeighborList::setRebuildCheckDelay)
         .def_property("check_dist", &NeighborList::getDistCheck, &NeighborList::setDistCheck)
+        .def_property("compressed",
+                      &NeighborList::getCompressed,
+                      &NeighborList::setCompressed) //~ add compressed nlist storage [RHEOINF]
+        .def("getCompressedNListBytes",
+             &NeighborList::getCompressedNListBytes) //~ add compressed nlist storage [RHEOINF]
+        .def("getNListBytes", &NeighborList::getNListBytes) //~ add compressed nlist storage [RHEOINF]
         .def("setStorageMode", &NeighborList::setStorageMode)
         .def_property("exclusions", &NeighborList::getExclusions, &NeighborList::setExclusions)
         .def("addMesh", &NeighborList::AddMesh)
@@ -2012,7 +2409,11 @@ void export_NeighborList(pybind11::module& m)
         .def("getPairList", &NeighborList::getPairListPython)
         .def("setRCut", &NeighborList::setRCutPython)
         .def("getRCut", &NeighborList::getRCut)
-        .def("compute", &NeighborList::compute);
+        .def("compute", &NeighborList::compute)
+        //~ add checkpoint state [RHEOINF]
+        .def("getCheckpointState", &NeighborList::getCheckpointState)
+        .def("setCheckpointState", &NeighborList::setCheckpointState);
+        //~
 
     pybind11::enum_<NeighborList::storageMode>(nlist, "storageMode")
         .value("half", NeighborList::storageMode::half)
@@ -1,6 +1,8 @@
 // Copyright (c) 2009-2023 The Regents of the University of Michigan.
 // Part of HOOMD-blue, released under the BSD 3-Clause License.
 
+// ########## Modified by Rheoinformatic //~ [RHEOINF] ##########
+
 #include "hoomd/Compute.h"
 #include "hoomd/GPUFlags.h"
 #include "hoomd/GPUVector.h"
@@ -8,6 +10,7 @@
 #include "hoomd/Index1D.h"
 #include "hoomd/MeshDefinition.h"
 #include "hoomd/PythonLocalDataAccess.h"
+#include "NeighborListCompression.h" //~ add compressed nlist storage [RHEOINF]
 
 #include <hoomd/extern/nano-signal-slot/nano_signal_slot.hpp>
 #include <memory>
@@ -235,6 +238,22 @@ class PYBIND11_EXPORT NeighborList : public Compute
         forceUpdate();
         }
 
+    //~ add compressed nlist storage [RHEOINF]
+    //! Enable/disable the compressed (16-bit delta encoded) copy of the neighbor list
+    /*! \param compressed Set to true to maintain the compressed copy
+
+        The compressed copy is rebuilt after every neighbor list build and is read by the CPU pair
+        potentials instead of the 32-bit list. It is not available on the GPU.
+    */
+    void setCompressed(bool compressed);
+
+    //! Test if the compressed copy of the neighbor list is maintained
+    bool getCompressed()
+        {
+        return m_compressed;
+        }
+    //~
+
     // @}
     //! \name Get properties
     // @{
@@ -311,6 +330,32 @@ class PYBIND11_EXPORT NeighborList : public Compute
         return m_head_list;
         }
 
+    //~ add compressed nlist storage [RHEOINF]
+    //! Get the compressed neighbor list (only valid when getCompressed() is true)
+    const GlobalArray<uint16_t>& getNListCompressedArray() const
+        {
+        return m_nlist_compressed;
+        }
+
+    //! Get the head list into the compressed neighbor list
+    const GlobalArray<size_t>& getHeadListCompressed() const
+        {
+        return m_head_list_compressed;
+        }
+
+    //! Get the number of bytes used by the compressed neighbor list in the last build
+    size_t getCompressedNListBytes() const
+        {
+        return m_nlist_compressed_size * sizeof(uint16_t);
+        }
+
+    //! Get the number of bytes the same neighbors occupy in the 32-bit neighbor list
+    size_t getNListBytes() const
+        {
+        return m_nlist_uncompressed_size * sizeof(unsigned int);
+        }
+    //~
+
     //! Get the number of exclusions array
     const GlobalArray<unsigned int>& getNExArray()
         {
@@ -401,6 +446,58 @@ class PYBIND11_EXPORT NeighborList : public Compute
     //! Computes the NeighborList if it needs updating
     void compute(uint64_t timestep);
 
+    //~ add neighbor list free pair evaluation [RHEOINF]
+    //! Run the rebuild check without building the list
+    /*! Used by pair forces that search a cell list directly instead of reading the neighbor list.
+        The displacement check (and with it the MPI migration criterion) keeps working, while the
+        list itself is only built if another consumer calls compute() on the same step.
+    */
+    void trackDisplacements(uint64_t timestep);
+    //~
+
+    //~ add interior/boundary classification for ghost update overlap [RHEOINF]
+    //! Request or release the interior/boundary classification of local particles
+    /*! After each build, local particles whose neighbors are all local (interior) are listed
+        before those with at least one ghost neighbor (boundary) in getInteriorOrder(). Pair
+        forces use it to compute interior particles while the ghost update is in flight. Several
+        forces may share the list, so the classification runs while any of them requests it.
+    */
+    void setClassifyInterior(bool classify)
+        {
+        if (classify)
+            {
+            if (m_classify_requests == 0)
+                forceUpdate();
+            m_classify_requests++;
+            }
+        else if (m_classify_requests > 0)
+            {
+            m_classify_requests--;
+            }
+        }
+
+    //! Get the local particle indices ordered interior first, then boundary
+    const GlobalArray<unsigned int>& getInteriorOrder() const
+        {
+        return m_interior_order;
+        }
+
+    //! Get the number of interior particles found in the last build
+    unsigned int getNInterior() const
+        {
+        return m_n_interior;
+        }
+
+    //! Test if the last build, and its classification, is still valid on this step
+    bool isInteriorCurrent(uint64_t timestep);
+
+    //! Get the number of builds of the list
+    uint64_t getBuildCount() const
+        {
+        return m_build_count;
+        }
+    //~
+
     //! Forces a full update of the list on the next call to compute()
     void forceUpdate()
         {
@@ -457,6 +554,14 @@ class PYBIND11_EXPORT NeighborList : public Compute
     /// Get the global pair list from Python
     pybind11::object getPairListPython(uint64_t timestep);
 
+    //~ add checkpoint state [RHEOINF]
+    //! Serialize the list and its rebuild bookkeeping for a checkpoint
+    pybind11::bytes getCheckpointState();
+
+    //! Restore the state serialized by getCheckpointState()
+    void setCheckpointState(pybind11::bytes state);
+    //~
+
     /// Validate that types are within Ntypes
     void validateTypes(unsigned int typ1, unsigned int typ2, std::string action);
 
@@ -492,6 +597,22 @@ class PYBIND11_EXPORT NeighborList : public Compute
     Scalar3 m_last_L_local;              //!< Local Box lengths at last update
 
     GlobalArray<size_t> m_head_list; //!< Indexes for particles to read from the neighbor list
+
+    //~ add compressed nlist storage [RHEOINF]
+    bool m_compressed;                          //!< True if the compressed copy is maintained
+    GlobalArray<uint16_t> m_nlist_compressed;   //!< Delta encoded neighbor list
+    GlobalArray<size_t> m_head_list_compressed; //!< Indexes into the compressed neighbor list
+    size_t m_nlist_compressed_size;             //!< Words used in m_nlist_compressed
+    size_t m_nlist_uncompressed_size;           //!< Neighbors stored in the last build
+    //~
+    bool m_build_skipped; //!< True if trackDisplacements() passed a rebuild [RHEOINF]
+    //~ add interior/boundary classification for ghost update overlap [RHEOINF]
+    unsigned int m_classify_requests;          //!< Number of requests for the classification
+    GlobalArray<unsigned int> m_interior_order; //!< Local indices, interior particles first
+    unsigned int m_n_interior;                 //!< Number of interior particles
+    unsigned int m_n_classified;               //!< Number of local particles classified
+    uint64_t m_build_count;                    //!< Number of builds of the list
+    //~
     GlobalArray<unsigned int>
         m_Nmax; //!< Holds the maximum number of neighbors for each particle type
     GlobalArray<unsigned int>
@@ -542,6 +663,12 @@ class PYBIND11_EXPORT NeighborList : public Compute
     //! Filter the neighbor list of excluded particles
     virtual void filterNlist();
 
+    //! Build the compressed copy of the neighbor list
+    virtual void compressNlist(); //~ add compressed nlist storage [RHEOINF]
+
+    //! Sort local particles into interior and boundary ones
+    void classifyInterior(); //~ add interior/boundary classification [RHEOINF]
+
     //! Build the head list to allocated memory
     virtual void buildHeadList();
 
@@ -0,0 +1,128 @@
+//~ ########## Created by the Rheoinformatic research group ##########
+//~ HOOMD-blue:
+// Copyright (c) 2009-2023 The Regents of the University of Michigan.
+// Part of HOOMD-blue, released under the BSD 3-Clause License.
+//~
+//~ This file:
+//~ Written by the Rheoinformatic research group (2026)
+
+// ########## Created by Rheoinformatic //~ [RHEOINF] ##########
+
+/*! \file NeighborListCompression.h
+    \brief Delta encoding of neighbor indices into 16-bit words
+
+    The compressed neighbor list stores, for each particle i, its neighbors in ascending index
+    order as a stream of signed differences (zig-zag encoded) from the previous neighbor, starting
+    from i itself. After a spatial sort (SFCPackTuner) neighbors have nearby indices, so almost
+    every difference fits in a single 16-bit word. Differences that do not fit are written as the
+    escape word 0xFFFF followed by the low and high halves of the 32-bit zig-zag value.
+*/
+
+#ifndef __NEIGHBORLIST_COMPRESSION_H__
+#define __NEIGHBORLIST_COMPRESSION_H__
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+namespace hoomd
+    {
+namespace md
+    {
+namespace detail
+    {
+//! Escape word that marks a 32-bit delta stored in the next two words
+const uint16_t NLIST_COMPRESSION_ESCAPE = 0xFFFF;
+
+//! Map a signed difference onto an unsigned value (small magnitudes -> small values)
+/*! Differences are taken modulo 2^32, so every pair of 32-bit indices round-trips exactly.
+ */
+inline uint32_t nlistZigZagEncode(uint32_t delta)
+    {
+    return (delta << 1) ^ (uint32_t)((int32_t)delta >> 31);
+    }
+
+//! Inverse of nlistZigZagEncode
+inline uint32_t nlistZigZagDecode(uint32_t z)
+    {
+    return (z >> 1) ^ (0u - (z & 1u));
+    }
+
+//! Number of 16-bit words needed to store one delta
+inline unsigned int nlistEncodedLength(uint32_t z)
+    {
+    return (z < NLIST_COMPRESSION_ESCAPE) ? 1 : 3;
+    }
+
+//! Encode a sorted run of neighbor indices of particle \a i
+/*! \param out Output stream of 16-bit words (must hold enough space, see nlistEncodedLength)
+    \param i Index of the particle owning the list
+    \param neigh Neighbor indices, sorted in ascending order
+    \param n Number of neighbors
+    \returns Number of words written
+*/
+inline size_t nlistEncode(uint16_t* out, unsigned int i, const unsigned int* neigh, unsigned int n)
+    {
+    size_t w = 0;
+    uint32_t prev = i;
+    for (unsigned int k = 0; k < n; ++k)
+        {
+        uint32_t z = nlistZigZagEncode(neigh[k] - prev);
+        if (z < NLIST_COMPRESSION_ESCAPE)
+            {
+            out[w++] = (uint16_t)z;
+            }
+        else
+            {
+            out[w++] = NLIST_COMPRESSION_ESCAPE;
+            out[w++] = (uint16_t)(z & 0xFFFF);
+            out[w++] = (uint16_t)(z >> 16);
+            }
+        prev = neigh[k];
+        }
+    return w;
+    }
+
+//! Sequential decoder for the neighbors of a single particle
+/*! Usage:
+    \code
+    NeighborListDecoder decoder(h_nlist_compressed.data + h_head_list_compressed.data[i], i);
+    for (unsigned int k = 0; k < n_neigh; k++)
+        unsigned int j = decoder.next();
+    \endcode
+*/
+class NeighborListDecoder
+    {
+    public:
+    //! Constructor
+    /*! \param data Start of the compressed stream for particle \a i (may be null if unused)
+        \param i Index of the particle owning the list
+    */
+    NeighborListDecoder(const uint16_t* data, unsigned int i) : m_data(data), m_prev(i) { }
+
+    //! Decode the next neighbor index
+    inline unsigned int next()
+        {
+        uint32_t z = *m_data++;
+        if (z == NLIST_COMPRESSION_ESCAPE)
+            {
+            z = (uint32_t)m_data[0] | ((uint32_t)m_data[1] << 16);
+            m_data += 2;
+            }
+        m_prev += nlistZigZagDecode(z);
+        return m_prev;
+        }
+
+    private:
+    const uint16_t* m_data; //!< Current read position in the stream
+    uint32_t m_prev;        //!< Previously decoded index (starts at the owning particle)
+    };
+
+    } // end namespace detail
+    } // end namespace md
+    } // end namespace hoomd
+
+#endif // __NEIGHBORLIST_COMPRESSION_H__
@@ -0,0 +1,164 @@
+//~ ########## Created by the Rheoinformatic research group ##########
+//~ HOOMD-blue:
+// Copyright (c) 2009-2023 The Regents of the University of Michigan.
+// Part of HOOMD-blue, released under the BSD 3-Clause License.
+//~
+//~ This file:
+//~ Written by the Rheoinformatic research group (2026)
+
+// ########## Created by Rheoinformatic //~ [RHEOINF] ##########
+
+/*! \file NeighborListPairAnalyzer.cc
+    \brief Defines the NeighborListPairAnalyzer class
+*/
+
+#include "NeighborListPairAnalyzer.h"
+
+#ifdef ENABLE_MPI
+#include "hoomd/Communicator.h"
+#endif
+
+#include <stdexcept>
+
+using namespace std;
+
+namespace hoomd
+    {
+namespace md
+    {
+/*! \param sysdef System definition
+    \param trigger Select the timesteps to analyze
+    \param nlist Neighbor list to take the pairs from (may be null)
+    \param types Indices of the selected types (all types when empty)
+    \param name Name used in messages
+    \param ghost_diameters Set to true to request the diameters of the ghost particles
+*/
+NeighborListPairAnalyzer::NeighborListPairAnalyzer(std::shared_ptr<SystemDefinition> sysdef,
+                                                   std::shared_ptr<Trigger> trigger,
+                                                   std::shared_ptr<NeighborList> nlist,
+                                                   const std::vector<unsigned int>& types,
+                                                   const std::string& name,
+                                                   bool ghost_diameters)
+    : Analyzer(sysdef, trigger), m_name(name), m_nlist(nlist), m_attached(false),
+      m_r_search(0.0), m_ghost_diameters(ghost_diameters)
+    {
+    if (m_exec_conf->isCUDAEnabled())
+        {
+        throw runtime_error(m_name + ": only the CPU implementation is available.");
+        }
+
+    const unsigned int n_types = m_pdata->getNTypes();
+    m_include.assign(n_types, types.empty());
+    for (unsigned int type : types)
+        {
+        if (type >= n_types)
+            {
+            throw runtime_error(m_name + ": invalid particle type.");
+            }
+        m_include[type] = true;
+        }
+
+    // no pairs until the derived class sets the search range
+    if (m_nlist)
+        {
+        m_r_cut = std::make_shared<GlobalArray<Scalar>>(n_types * n_types, m_exec_conf);
+            {
+            ArrayHandle<Scalar> h_r_cut(*m_r_cut, access_location::host, access_mode::overwrite);
+            for (unsigned int k = 0; k < n_types * n_types; k++)
+                h_r_cut.data[k] = Scalar(0.0);
+            }
+        m_nlist->addRCutMatrix(m_r_cut);
+        m_attached = true;
+        }
+
+#ifdef ENABLE_MPI
+    if (m_sysdef->isDomainDecomposed())
+        {
+        auto comm_weak = m_sysdef->getCommunicator();
+        assert(comm_weak.lock());
+        m_comm = comm_weak.lock();
+
+        m_comm->getCommFlagsRequestSignal()
+            .connect<NeighborListPairAnalyzer, &NeighborListPairAnalyzer::getRequestedCommFlags>(
+                this);
+        }
+#endif
+    }
+
+NeighborListPairAnalyzer::~NeighborListPairAnalyzer()
+    {
+    notifyDetach();
+
+#ifdef ENABLE_MPI
+    if (m_comm)
+        {
+        m_comm->getCommFlagsRequestSignal()
+            .disconnect<NeighborListPairAnalyzer,
+                        &NeighborListPairAnalyzer::getRequestedCommFlags>(this);
+        }
+#endif
+    }
+
+/*! \param r_search New search range
+    \returns True if the search range grew
+
+    The range only grows: a smaller \a r_search is ignored. Growing it after the first frame warns
+    that pairs beyond the old range may be missing from the frame that triggered it, the list is
+    rebuilt with the new range on its next build.
+*/
+bool NeighborListPairAnalyzer::extendSearchRange(Scalar r_search)
+    {
+    if (r_search <= m_r_search)
+        return false;
+
+    if (m_r_search > Scalar(0.0))
+        {
+        m_exec_conf->msg->warning()
+            << m_name << ": the particle diameters grew, the search range is extended to "
+            << r_search << ". Pairs beyond the old range may be missing from this frame." << endl;
+        }
+    m_r_search = r_search;
+
+    if (m_nlist)
+        {
+        // only the pairs of the selected types need to be in the list
+        ArrayHandle<Scalar> h_r_cut(*m_r_cut, access_location::host, access_mode::overwrite);
+        const Index2D typpair_idx = m_nlist->getTypePairIndexer();
+        for (unsigned int a = 0; a < m_include.size(); a++)
+            for (unsigned int b = 0; b < m_include.size(); b++)
+                h_r_cut.data[typpair_idx(a, b)]
+                    = (m_include[a] && m_include[b]) ? m_r_search : Scalar(0.0);
+        }
+    if (m_attached)
+        m_nlist->notifyRCutMatrixChange();
+    return true;
+    }
+
+/*! \param timestep Current time step
+
+    Lists with exclusions are rejected, the excluded pairs would be missing.
+*/
+void NeighborListPairAnalyzer::computeNeighborList(uint64_t timestep)
+    {
+    if (m_nlist->getExclusionsSet())
+        {
+        throw runtime_error(m_name + ": the neighbor list excludes pairs.");
+        }
+    m_nlist->compute(timestep);
+    }
+
+#ifdef ENABLE_MPI
+/*! \param timestep Current time step
+ */
+CommFlags NeighborListPairAnalyzer::getRequestedCommFlags(uint64_t timestep)
+    {
+    CommFlags flags(0);
+    flags[comm_flag::position] = 1;
+    if (m_ghost_diameters)
+        flags[comm_flag::diameter] = 1;
+    return flags;
+    }
+#endif
+
+    } // end namespace md
+    } // end namespace hoomd
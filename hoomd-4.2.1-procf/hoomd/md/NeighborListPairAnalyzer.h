@@ -0,0 +1,102 @@
+//~ ########## Created by the Rheoinformatic research group ##########
+//~ HOOMD-blue:
+// Copyright (c) 2009-2023 The Regents of the University of Michigan.
+// Part of HOOMD-blue, released under the BSD 3-Clause License.
+//~
+//~ This file:
+//~ Written by the Rheoinformatic research group (2026)
+
+// ########## Created by Rheoinformatic //~ [RHEOINF] ##########
+
+/*! \file NeighborListPairAnalyzer.h
+    \brief Declares the NeighborListPairAnalyzer class
+
+    NeighborListPairAnalyzer is the base of the analyzers that take the pairs of the selected types
+    from a NeighborList shared with the pair forces. It owns the hookup to the list: the r_cut
+    matrix of the search range, the ghost communication flags, and the type selection.
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include "NeighborList.h"
+#include "hoomd/Analyzer.h"
+
+#include <memory>
+#include <pybind11/pybind11.h>
+#include <string>
+#include <vector>
+
+#ifndef __NEIGHBOR_LIST_PAIR_ANALYZER_H__
+#define __NEIGHBOR_LIST_PAIR_ANALYZER_H__
+
+namespace hoomd
+    {
+namespace md
+    {
+//! Base class of the analyzers that read pairs from a shared neighbor list
+/*! The analyzer adds an r_cut matrix to the neighbor list that holds the search range for the
+    pairs of the selected types and 0 for all other pairs, so the list (usually the one a pair
+    force already builds) holds every pair the analyzer needs. Derived classes set the range with
+    extendSearchRange(), on construction and whenever it may have grown (e.g. the particle
+    diameters), and build the list with computeNeighborList() before reading it. The matrix is
+    removed from the list when the analyzer is detached.
+
+    The neighbor list may be null for analyzers that can find the pairs on their own; the type
+    selection and the communication flags are kept then, and the search range only recorded.
+
+    With domain decomposition, the positions (and diameters, if requested) of the ghost particles
+    are requested from the Communicator.
+
+    \ingroup analyzers
+*/
+class PYBIND11_EXPORT NeighborListPairAnalyzer : public Analyzer
+    {
+    public:
+    //! Construct the analyzer
+    NeighborListPairAnalyzer(std::shared_ptr<SystemDefinition> sysdef,
+                             std::shared_ptr<Trigger> trigger,
+                             std::shared_ptr<NeighborList> nlist,
+                             const std::vector<unsigned int>& types,
+                             const std::string& name,
+                             bool ghost_diameters);
+
+    //! Destructor
+    virtual ~NeighborListPairAnalyzer();
+
+    //! Remove the search range from the neighbor list
+    virtual void notifyDetach()
+        {
+        if (m_attached)
+            m_nlist->removeRCutMatrix(m_r_cut);
+        m_attached = false;
+        }
+
+    protected:
+    std::string m_name;                           //!< Name used in messages
+    std::shared_ptr<NeighborList> m_nlist;        //!< Neighbor list the pairs come from
+    std::shared_ptr<GlobalArray<Scalar>> m_r_cut; //!< Search range added to m_nlist
+    bool m_attached;                              //!< True while m_r_cut is in m_nlist
+    std::vector<bool> m_include;                  //!< True for the selected types
+    Scalar m_r_search;                            //!< Search range of the selected type pairs
+    bool m_ghost_diameters;                       //!< True to request the ghost diameters
+
+    //! Extend the search range of the selected type pairs
+    bool extendSearchRange(Scalar r_search);
+
+    //! Build the neighbor list for the current time step
+    void computeNeighborList(uint64_t timestep);
+
+#ifdef ENABLE_MPI
+    std::shared_ptr<Communicator> m_comm; //!< Communicator (domain decomposition only)
+
+    //! Request the ghost fields read in the pair loop
+    CommFlags getRequestedCommFlags(uint64_t timestep);
+#endif
+    };
+
+    } // end namespace md
+    } // end namespace hoomd
+
+#endif // __NEIGHBOR_LIST_PAIR_ANALYZER_H__
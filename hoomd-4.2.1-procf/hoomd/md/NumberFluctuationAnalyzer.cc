@@ -0,0 +1,310 @@
+//~ ########## Created by the Rheoinformatic research group ##########
+//~ HOOMD-blue:
+// Copyright (c) 2009-2023 The Regents of the University of Michigan.
+// Part of HOOMD-blue, released under the BSD 3-Clause License.
+//~
+//~ This file:
+//~ Written by the Rheoinformatic research group (2026)
+
+// ########## Created by Rheoinformatic //~ [RHEOINF] ##########
+
+/*! \file NumberFluctuationAnalyzer.cc
+    \brief Defines the NumberFluctuationAnalyzer class
+*/
+
+#include "NumberFluctuationAnalyzer.h"
+
+#ifdef ENABLE_TBB
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#endif
+
+#include <algorithm>
+#include <cmath>
+#include <pybind11/stl.h>
+#include <stdexcept>
+
+using namespace std;
+
+namespace hoomd
+    {
+namespace md
+    {
+/*! \param sysdef System definition
+    \param trigger Select the timesteps to analyze
+    \param grid_spacing Target cell width of the count grid
+    \param window_widths Widths of the windows
+    \param types Indices of the selected types (all types when empty)
+*/
+NumberFluctuationAnalyzer::NumberFluctuationAnalyzer(std::shared_ptr<SystemDefinition> sysdef,
+                                                     std::shared_ptr<Trigger> trigger,
+                                                     Scalar grid_spacing,
+                                                     const std::vector<Scalar>& window_widths,
+                                                     const std::vector<unsigned int>& types)
+    : Analyzer(sysdef, trigger), m_grid_spacing(grid_spacing), m_widths(window_widths),
+      m_dim(make_uint3(0, 0, 0))
+    {
+    m_exec_conf->msg->notice(5) << "Constructing NumberFluctuationAnalyzer" << endl;
+
+    if (m_exec_conf->isCUDAEnabled())
+        {
+        throw runtime_error("NumberFluctuation: only the CPU implementation is available.");
+        }
+    if (m_grid_spacing <= Scalar(0.0))
+        {
+        throw runtime_error("NumberFluctuation: grid_spacing must be positive.");
+        }
+    if (m_widths.empty())
+        {
+        throw runtime_error("NumberFluctuation: at least one window width is required.");
+        }
+    for (Scalar w : m_widths)
+        {
+        if (w <= Scalar(0.0))
+            {
+            throw runtime_error("NumberFluctuation: window widths must be positive.");
+            }
+        }
+
+    m_include.assign(m_pdata->getNTypes(), types.empty());
+    for (unsigned int type : types)
+        {
+        if (type >= m_pdata->getNTypes())
+            {
+            throw runtime_error("NumberFluctuation: invalid particle type.");
+            }
+        m_include[type] = true;
+        }
+    m_volume.assign(m_widths.size(), 0.0);
+    m_mean.assign(m_widths.size(), 0.0);
+    m_variance.assign(m_widths.size(), 0.0);
+    }
+
+NumberFluctuationAnalyzer::~NumberFluctuationAnalyzer()
+    {
+    m_exec_conf->msg->notice(5) << "Destroying NumberFluctuationAnalyzer" << endl;
+    }
+
+/*! A periodic prefix sum along one axis splits into q whole periods and a remainder r < n,
+    S(q n + r) = q S(n) + S(r), and the three axes combine as a product of these splits.
+*/
+double NumberFluctuationAnalyzer::periodicSum(unsigned int a, unsigned int b, unsigned int c) const
+    {
+    const unsigned int q[3] = {a / m_dim.x, b / m_dim.y, c / m_dim.z};
+    const unsigned int r[3] = {a % m_dim.x, b % m_dim.y, c % m_dim.z};
+    const unsigned int n[3] = {m_dim.x, m_dim.y, m_dim.z};
+    const size_t stride_y = m_dim.z + 1;
+    const size_t stride_x = size_t(m_dim.y + 1) * stride_y;
+
+    double sum = 0.0;
+    for (unsigned int ia = 0; ia < 2; ia++)
+        {
+        const unsigned int wa = ia ? q[0] : 1;
+        if (wa == 0)
+            continue;
+        const size_t ka = (ia ? n[0] : r[0]) * stride_x;
+        for (unsigned int ib = 0; ib < 2; ib++)
+            {
+            const unsigned int wb = ib ? q[1] : 1;
+            if (wb == 0)
+                continue;
+            const size_t kb = ka + (ib ? n[1] : r[1]) * stride_y;
+            for (unsigned int ic = 0; ic < 2; ic++)
+                {
+                const unsigned int wc = ic ? q[2] : 1;
+                if (wc == 0)
+                    continue;
+                sum += double(wa * wb * wc) * m_table[kb + (ic ? n[2] : r[2])];
+                }
+            }
+        }
+    return sum;
+    }
+
+/*! \param timestep Current time step of the simulation
+ */
+void NumberFluctuationAnalyzer::analyze(uint64_t timestep)
+    {
+    Analyzer::analyze(timestep);
+
+    const BoxDim& box = m_pdata->getGlobalBox();
+    const Scalar3 L = box.getL();
+    const bool twod = m_sysdef->getNDimensions() == 2;
+    auto n_cells = [&](Scalar length)
+    { return max(1u, (unsigned int)lround(length / m_grid_spacing)); };
+    m_dim = make_uint3(n_cells(L.x), n_cells(L.y), twod ? 1 : n_cells(L.z));
+    const size_t n_grid = size_t(m_dim.x) * m_dim.y * m_dim.z;
+
+    // count the local particles in the grid of the global box
+    auto cell = [](Scalar f, unsigned int n)
+    { return min((unsigned int)(max(f, Scalar(0.0)) * n), n - 1); };
+    m_grid.assign(n_grid, 0);
+        {
+        ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(),
+                                   access_location::host,
+                                   access_mode::read);
+        for (unsigned int i = 0; i < m_pdata->getN(); i++)
+            {
+            if (!m_include[__scalar_as_int(h_pos.data[i].w)])
+                continue;
+            const Scalar3 f
+                = box.makeFraction(make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z));
+            m_grid[(size_t(cell(f.x, m_dim.x)) * m_dim.y + cell(f.y, m_dim.y)) * m_dim.z
+                   + cell(f.z, m_dim.z)]++;
+            }
+        }
+    unsigned int rank = 0, n_ranks = 1;
+#ifdef ENABLE_MPI
+    if (m_sysdef->isDomainDecomposed())
+        {
+        MPI_Allreduce(MPI_IN_PLACE,
+                      m_grid.data(),
+                      (int)n_grid,
+                      MPI_UNSIGNED,
+                      MPI_SUM,
+                      m_exec_conf->getMPICommunicator());
+        rank = m_exec_conf->getRank();
+        n_ranks = m_exec_conf->getNRanks();
+        }
+#endif
+
+    // summed-area table with a zero first plane along each axis
+    const size_t stride_y = m_dim.z + 1;
+    const size_t stride_x = size_t(m_dim.y + 1) * stride_y;
+    m_table.assign(size_t(m_dim.x + 1) * stride_x, 0);
+    for (unsigned int a = 0; a < m_dim.x; a++)
+        for (unsigned int b = 0; b < m_dim.y; b++)
+            for (unsigned int c = 0; c < m_dim.z; c++)
+                m_table[(a + 1) * stride_x + (b + 1) * stride_y + c + 1]
+                    = m_grid[(size_t(a) * m_dim.y + b) * m_dim.z + c];
+    for (size_t k = stride_x; k < m_table.size(); k++)
+        m_table[k] += m_table[k - stride_x];
+    for (size_t k = 0; k < m_table.size(); k++)
+        if ((k % stride_x) >= stride_y)
+            m_table[k] += m_table[k - stride_y];
+    for (size_t k = 0; k < m_table.size(); k++)
+        if (k % stride_y != 0)
+            m_table[k] += m_table[k - 1];
+
+    // window size in cells along each axis
+    const size_t n_widths = m_widths.size();
+    std::vector<uint3> size(n_widths);
+    for (size_t w = 0; w < n_widths; w++)
+        {
+        auto n_window = [&](Scalar length, unsigned int n)
+        { return min(n, max(1u, (unsigned int)lround(m_widths[w] * n / length))); };
+        size[w] = make_uint3(n_window(L.x, m_dim.x),
+                             n_window(L.y, m_dim.y),
+                             twod ? 1 : n_window(L.z, m_dim.z));
+        m_volume[w]
+            = box.getVolume(twod) * double(size[w].x) * size[w].y * size[w].z / double(n_grid);
+        }
+
+    // sums of N and N^2 per width over the windows at the cells a = rank, rank + n_ranks, ...
+    const unsigned int n_rows = m_dim.x > rank ? (m_dim.x - rank + n_ranks - 1) / n_ranks : 0;
+    std::vector<double> row_sums(size_t(n_rows) * n_widths * 2, 0.0);
+    auto count_windows = [&](unsigned int begin, unsigned int end)
+    {
+        for (unsigned int row = begin; row < end; row++)
+            {
+            const unsigned int a = rank + row * n_ranks;
+            double* sums = row_sums.data() + size_t(row) * n_widths * 2;
+            for (size_t w = 0; w < n_widths; w++)
+                {
+                const uint3 s = size[w];
+                for (unsigned int b = 0; b < m_dim.y; b++)
+                    for (unsigned int c = 0; c < m_dim.z; c++)
+                        {
+                        const double n_window = periodicSum(a + s.x, b + s.y, c + s.z)
+                                                - periodicSum(a, b + s.y, c + s.z)
+                                                - periodicSum(a + s.x, b, c + s.z)
+                                                - periodicSum(a + s.x, b + s.y, c)
+                                                + periodicSum(a, b, c + s.z)
+                                                + periodicSum(a, b + s.y, c)
+                                                + periodicSum(a + s.x, b, c)
+                                                - periodicSum(a, b, c);
+                        sums[2 * w] += n_window;
+                        sums[2 * w + 1] += n_window * n_window;
+                        }
+                }
+            }
+    };
+
+#ifdef ENABLE_TBB
+    m_exec_conf->getTaskArena()->execute(
+        [&]
+        {
+            tbb::parallel_for(tbb::blocked_range<unsigned int>(0, n_rows),
+                              [&](const tbb::blocked_range<unsigned int>& r)
+                              { count_windows(r.begin(), r.end()); });
+        });
+#else
+    count_windows(0, n_rows);
+#endif
+
+    std::vector<double> sums(n_widths * 2, 0.0);
+    for (unsigned int row = 0; row < n_rows; row++)
+        for (size_t k = 0; k < sums.size(); k++)
+            sums[k] += row_sums[size_t(row) * sums.size() + k];
+#ifdef ENABLE_MPI
+    if (m_sysdef->isDomainDecomposed())
+        {
+        MPI_Allreduce(MPI_IN_PLACE,
+                      sums.data(),
+                      (int)sums.size(),
+                      MPI_DOUBLE,
+                      MPI_SUM,
+                      m_exec_conf->getMPICommunicator());
+        }
+#endif
+
+    for (size_t w = 0; w < n_widths; w++)
+        {
+        m_mean[w] = sums[2 * w] / double(n_grid);
+        m_variance[w] = max(sums[2 * w + 1] / double(n_grid) - m_mean[w] * m_mean[w], 0.0);
+        }
+    }
+
+pybind11::array_t<double> NumberFluctuationAnalyzer::getWindowVolumes() const
+    {
+    return pybind11::array_t<double>(m_volume.size(), m_volume.data());
+    }
+
+pybind11::array_t<double> NumberFluctuationAnalyzer::getMean() const
+    {
+    return pybind11::array_t<double>(m_mean.size(), m_mean.data());
+    }
+
+pybind11::array_t<double> NumberFluctuationAnalyzer::getVariance() const
+    {
+    return pybind11::array_t<double>(m_variance.size(), m_variance.data());
+    }
+
+pybind11::array_t<unsigned int> NumberFluctuationAnalyzer::getGridSize() const
+    {
+    const unsigned int dim[3] = {m_dim.x, m_dim.y, m_dim.z};
+    return pybind11::array_t<unsigned int>(3, dim);
+    }
+
+namespace detail
+    {
+void export_NumberFluctuationAnalyzer(pybind11::module& m)
+    {
+    pybind11::class_<NumberFluctuationAnalyzer,
+                     Analyzer,
+                     std::shared_ptr<NumberFluctuationAnalyzer>>(m, "NumberFluctuationAnalyzer")
+        .def(pybind11::init<std::shared_ptr<SystemDefinition>,
+                            std::shared_ptr<Trigger>,
+                            Scalar,
+                            const std::vector<Scalar>&,
+                            const std::vector<unsigned int>&>())
+        .def("getWindowVolumes", &NumberFluctuationAnalyzer::getWindowVolumes)
+        .def("getMean", &NumberFluctuationAnalyzer::getMean)
+        .def("getVariance", &NumberFluctuationAnalyzer::getVariance)
+        .def("getGridSize", &NumberFluctuationAnalyzer::getGridSize)
+        .def_property_readonly("grid_spacing", &NumberFluctuationAnalyzer::getGridSpacing);
+    }
+
+    } // end namespace detail
+    } // end namespace md
+    } // end namespace hoomd
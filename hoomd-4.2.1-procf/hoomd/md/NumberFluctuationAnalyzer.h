@@ -0,0 +1,115 @@
+//~ ########## Created by the Rheoinformatic research group ##########
+//~ HOOMD-blue:
+// Copyright (c) 2009-2023 The Regents of the University of Michigan.
+// Part of HOOMD-blue, released under the BSD 3-Clause License.
+//~
+//~ This file:
+//~ Written by the Rheoinformatic research group (2026)
+
+// ########## Created by Rheoinformatic //~ [RHEOINF] ##########
+
+/*! \file NumberFluctuationAnalyzer.h
+    \brief Declares the NumberFluctuationAnalyzer class
+
+    NumberFluctuationAnalyzer computes the variance of the number of particles in cubic windows of
+    several sizes during the simulation from a summed-area table of a fine count grid, so each
+    window costs a few table lookups instead of a new histogram of the stored frames per size.
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include "hoomd/Analyzer.h"
+
+#include <memory>
+#include <pybind11/numpy.h>
+#include <pybind11/pybind11.h>
+#include <vector>
+
+#ifndef __NUMBER_FLUCTUATION_ANALYZER_H__
+#define __NUMBER_FLUCTUATION_ANALYZER_H__
+
+namespace hoomd
+    {
+namespace md
+    {
+//! Computes the number fluctuations of the selected particles in windows of several sizes
+/*! The global box is divided into a grid of n_x x n_y x n_z cells of about grid_spacing along
+    each lattice vector, in fractional coordinates, so the cells of a tilted box are its sheared
+    images. Each rank counts its local particles of the selected types in the grid, the grids are
+    summed over the ranks, and every rank builds the summed-area table
+
+        S(a, b, c) = sum of the counts of the cells i < a, j < b, k < c.
+
+    A window of k_x x k_y x k_z cells at any cell, wrapped around the periodic box, is then counted
+    from 8 corners of S, with the periodic wrap split into whole periods, at a cost that does not
+    depend on the window size. For each window width w the number of cells per axis is
+    k_a = round(w / (L_a / n_a)), between 1 and n_a.
+
+    Each call to analyze() counts the windows at all n_x n_y n_z cells for every width and stores
+    the mean <N> and variance <N^2> - <N>^2 of the counts of the frame. The window positions are
+    split over the ranks by the first cell index and computed in parallel with TBB when
+    available, and the sums are added over the ranks.
+
+    \ingroup analyzers
+*/
+class PYBIND11_EXPORT NumberFluctuationAnalyzer : public Analyzer
+    {
+    public:
+    //! Construct the analyzer
+    NumberFluctuationAnalyzer(std::shared_ptr<SystemDefinition> sysdef,
+                              std::shared_ptr<Trigger> trigger,
+                              Scalar grid_spacing,
+                              const std::vector<Scalar>& window_widths,
+                              const std::vector<unsigned int>& types);
+
+    //! Destructor
+    virtual ~NumberFluctuationAnalyzer();
+
+    //! Count the windows of the current frame
+    virtual void analyze(uint64_t timestep);
+
+    //! Get the volume of the windows of each width in the last frame
+    pybind11::array_t<double> getWindowVolumes() const;
+
+    //! Get the mean number of particles in the windows of each width in the last frame
+    pybind11::array_t<double> getMean() const;
+
+    //! Get the variance of the number of particles in the windows of each width in the last frame
+    pybind11::array_t<double> getVariance() const;
+
+    //! Get the number of cells of the grid along each lattice vector in the last frame
+    pybind11::array_t<unsigned int> getGridSize() const;
+
+    //! Get the target cell width of the grid
+    Scalar getGridSpacing() const
+        {
+        return m_grid_spacing;
+        }
+
+    private:
+    Scalar m_grid_spacing;             //!< Target cell width of the grid
+    std::vector<Scalar> m_widths;      //!< Window widths
+    std::vector<bool> m_include;       //!< True for the selected types
+    uint3 m_dim;                       //!< Number of cells along each lattice vector
+    std::vector<unsigned int> m_grid;  //!< Counts of the cells
+    std::vector<unsigned int> m_table; //!< Summed-area table of m_grid
+    std::vector<double> m_volume;      //!< Window volume per width
+    std::vector<double> m_mean;        //!< Mean count per width
+    std::vector<double> m_variance;    //!< Variance of the count per width
+
+    //! Sum of the counts of the cells i < a, j < b, k < c of the periodic grid (a, b, c < 2 n)
+    double periodicSum(unsigned int a, unsigned int b, unsigned int c) const;
+    };
+
+namespace detail
+    {
+//! Export NumberFluctuationAnalyzer to python
+void export_NumberFluctuationAnalyzer(pybind11::module& m);
+    } // end namespace detail
+
+    } // end namespace md
+    } // end namespace hoomd
+
+#endif // __NUMBER_FLUCTUATION_ANALYZER_H__
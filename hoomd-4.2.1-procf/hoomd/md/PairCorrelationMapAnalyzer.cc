@@ -0,0 +1,291 @@
+//~ ########## Created by the Rheoinformatic research group ##########
+//~ HOOMD-blue:
+// Copyright (c) 2009-2023 The Regents of the University of Michigan.
+// Part of HOOMD-blue, released under the BSD 3-Clause License.
+//~
+//~ This file:
+//~ Written by the Rheoinformatic research group (2026)
+
+// ########## Created by Rheoinformatic //~ [RHEOINF] ##########
+
+/*! \file PairCorrelationMapAnalyzer.cc
+    \brief Defines the PairCorrelationMapAnalyzer class
+*/
+
+#include "PairCorrelationMapAnalyzer.h"
+
+#include <cmath>
+#include <pybind11/stl.h>
+#include <stdexcept>
+
+using namespace std;
+
+namespace hoomd
+    {
+namespace md
+    {
+/*! \param sysdef System definition
+    \param trigger Select the timesteps to accumulate
+    \param nlist Neighbor list to take the pairs from
+    \param r_max Half width of the maps
+    \param bins Number of bins along each axis of a map
+    \param slice_width Half thickness of the slices
+    \param types Indices of the selected types (all types when empty)
+    \param phase_bins Number of phase bins per oscillation period
+    \param period Oscillation period in time steps (0 without phase binning)
+    \param t_start Time step of phase 0
+*/
+PairCorrelationMapAnalyzer::PairCorrelationMapAnalyzer(std::shared_ptr<SystemDefinition> sysdef,
+                                                       std::shared_ptr<Trigger> trigger,
+                                                       std::shared_ptr<NeighborList> nlist,
+                                                       Scalar r_max,
+                                                       unsigned int bins,
+                                                       Scalar slice_width,
+                                                       const std::vector<unsigned int>& types,
+                                                       unsigned int phase_bins,
+                                                       uint64_t period,
+                                                       uint64_t t_start)
+    : NeighborListPairAnalyzer(sysdef, trigger, nlist, types, "PairCorrelationMap", false),
+      m_r_max(r_max), m_bins(bins), m_slice_width(slice_width), m_phase_bins(phase_bins),
+      m_period(period), m_t_start(t_start), m_n_frames(0)
+    {
+    m_exec_conf->msg->notice(5) << "Constructing PairCorrelationMapAnalyzer" << endl;
+
+    if (!m_nlist)
+        {
+        throw runtime_error("PairCorrelationMap: a neighbor list is required.");
+        }
+    if (m_sysdef->getNDimensions() != 3)
+        {
+        throw runtime_error("PairCorrelationMap: the system must be 3D.");
+        }
+    if (m_r_max <= Scalar(0.0) || m_bins == 0)
+        {
+        throw runtime_error("PairCorrelationMap: r_max and bins must be positive.");
+        }
+    if (m_slice_width <= Scalar(0.0))
+        {
+        throw runtime_error("PairCorrelationMap: slice_width must be positive.");
+        }
+    if (m_phase_bins == 0 || (m_phase_bins > 1 && m_period == 0))
+        {
+        throw runtime_error("PairCorrelationMap: phase binning requires a positive period.");
+        }
+    reset();
+
+    // a pair in any of the slices is within sqrt(2 r_max^2 + slice_width^2)
+    extendSearchRange(sqrt(Scalar(2.0) * m_r_max * m_r_max + m_slice_width * m_slice_width));
+    }
+
+PairCorrelationMapAnalyzer::~PairCorrelationMapAnalyzer()
+    {
+    m_exec_conf->msg->notice(5) << "Destroying PairCorrelationMapAnalyzer" << endl;
+    }
+
+/*! \param timestep Current time step of the simulation
+ */
+void PairCorrelationMapAnalyzer::analyze(uint64_t timestep)
+    {
+    Analyzer::analyze(timestep);
+
+    if (timestep < m_t_start)
+        return;
+
+    // minimum image pairs only
+    const BoxDim& global_box = m_pdata->getGlobalBox();
+    const Scalar3 npd = global_box.getNearestPlaneDistance();
+    if (m_r_search * Scalar(2.0) > npd.x || m_r_search * Scalar(2.0) > npd.y
+        || m_r_search * Scalar(2.0) > npd.z)
+        {
+        throw runtime_error("PairCorrelationMap: the search range is larger than half the box.");
+        }
+    computeNeighborList(timestep);
+
+    const unsigned int phase
+        = m_period > 0
+              ? (unsigned int)(((timestep - m_t_start) % m_period) * m_phase_bins / m_period)
+              : 0;
+
+    ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_n_neigh(m_nlist->getNNeighArray(),
+                                        access_location::host,
+                                        access_mode::read);
+    ArrayHandle<unsigned int> h_nlist(m_nlist->getNListArray(),
+                                      access_location::host,
+                                      access_mode::read);
+    ArrayHandle<size_t> h_head_list(m_nlist->getHeadList(),
+                                    access_location::host,
+                                    access_mode::read);
+
+    // the minimum image in the tilted box is the Lees-Edwards image
+    const BoxDim& box = m_pdata->getBox();
+    const bool full = m_nlist->getStorageMode() == NeighborList::full;
+    const unsigned int N = m_pdata->getN();
+    const double bin_size = 2.0 * m_r_max / m_bins;
+    const size_t map_size = size_t(m_bins) * m_bins;
+
+    // add the pair at (u, v) and its reverse at (-u, -v) to a map
+    auto add_pair = [&](unsigned int plane, double u, double v, double weight)
+    {
+        if (fabs(u) >= m_r_max || fabs(v) >= m_r_max)
+            return;
+        double* map = m_counts.data() + (size_t(plane) * m_phase_bins + phase) * map_size;
+        const unsigned int a = min((unsigned int)((u + m_r_max) / bin_size), m_bins - 1);
+        const unsigned int b = min((unsigned int)((v + m_r_max) / bin_size), m_bins - 1);
+        map[size_t(a) * m_bins + b] += weight;
+        map[size_t(m_bins - 1 - a) * m_bins + (m_bins - 1 - b)] += weight;
+    };
+
+    double n_sel = 0.0;
+    for (unsigned int i = 0; i < N; i++)
+        {
+        const Scalar3 pos_i = make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
+        if (!m_include[__scalar_as_int(h_pos.data[i].w)])
+            continue;
+        n_sel += 1.0;
+        const size_t head_i = h_head_list.data[i];
+
+        for (unsigned int k = 0; k < h_n_neigh.data[i]; k++)
+            {
+            const unsigned int j = h_nlist.data[head_i + k];
+            if (!m_include[__scalar_as_int(h_pos.data[j].w)])
+                continue;
+
+            Scalar3 dx = make_scalar3(h_pos.data[j].x, h_pos.data[j].y, h_pos.data[j].z) - pos_i;
+            dx = box.minImage(dx);
+            if (dot(dx, dx) == Scalar(0.0))
+                continue;
+
+            // count each pair once over the ranks and the two entries of a full list
+            const double weight = (full || j >= N) ? 0.5 : 1.0;
+            if (fabs(dx.z) <= m_slice_width)
+                add_pair(0, dx.x, dx.y, weight);
+            if (fabs(dx.y) <= m_slice_width)
+                add_pair(1, dx.x, dx.z, weight);
+            if (fabs(dx.x) <= m_slice_width)
+                add_pair(2, dx.y, dx.z, weight);
+            }
+        }
+#ifdef ENABLE_MPI
+    if (m_sysdef->isDomainDecomposed())
+        {
+        MPI_Allreduce(MPI_IN_PLACE,
+                      &n_sel,
+                      1,
+                      MPI_DOUBLE,
+                      MPI_SUM,
+                      m_exec_conf->getMPICommunicator());
+        }
+#endif
+
+    // ordered pairs of an ideal gas in one bin of a slice
+    const double volume = global_box.getVolume();
+    m_norm[phase] += n_sel * n_sel / volume * bin_size * bin_size * 2.0 * m_slice_width;
+    m_phase_frames[phase] += 1.0;
+    m_n_frames++;
+    }
+
+void PairCorrelationMapAnalyzer::reset()
+    {
+    m_counts.assign(size_t(3) * m_phase_bins * m_bins * m_bins, 0.0);
+    m_norm.assign(m_phase_bins, 0.0);
+    m_phase_frames.assign(m_phase_bins, 0.0);
+    m_n_frames = 0;
+    }
+
+std::vector<double> PairCorrelationMapAnalyzer::reduceCounts()
+    {
+    std::vector<double> total(m_counts);
+#ifdef ENABLE_MPI
+    if (m_sysdef->isDomainDecomposed())
+        {
+        MPI_Allreduce(MPI_IN_PLACE,
+                      total.data(),
+                      (int)total.size(),
+                      MPI_DOUBLE,
+                      MPI_SUM,
+                      m_exec_conf->getMPICommunicator());
+        }
+#endif
+    return total;
+    }
+
+pybind11::array_t<double> PairCorrelationMapAnalyzer::getBinCenters() const
+    {
+    pybind11::array_t<double> result(m_bins);
+    double* data = result.mutable_data();
+    const double bin_size = 2.0 * m_r_max / m_bins;
+    for (unsigned int b = 0; b < m_bins; b++)
+        data[b] = -m_r_max + (b + 0.5) * bin_size;
+    return result;
+    }
+
+/*! Ratio of the summed pair counts to the summed ideal gas counts of the frames in each phase bin.
+ */
+pybind11::array_t<double> PairCorrelationMapAnalyzer::getMaps()
+    {
+    const std::vector<double> total = reduceCounts();
+    pybind11::array_t<double> result(std::vector<size_t> {3, m_phase_bins, m_bins, m_bins});
+    double* data = result.mutable_data();
+    const size_t map_size = size_t(m_bins) * m_bins;
+    for (size_t k = 0; k < total.size(); k++)
+        {
+        const double norm = m_norm[(k / map_size) % m_phase_bins];
+        data[k] = norm > 0.0 ? total[k] / norm : 0.0;
+        }
+    return result;
+    }
+
+/*! Mean number of ordered pairs per frame in each bin.
+ */
+pybind11::array_t<double> PairCorrelationMapAnalyzer::getPairCounts()
+    {
+    const std::vector<double> total = reduceCounts();
+    pybind11::array_t<double> result(std::vector<size_t> {3, m_phase_bins, m_bins, m_bins});
+    double* data = result.mutable_data();
+    const size_t map_size = size_t(m_bins) * m_bins;
+    for (size_t k = 0; k < total.size(); k++)
+        {
+        const double frames = m_phase_frames[(k / map_size) % m_phase_bins];
+        data[k] = frames > 0.0 ? total[k] / frames : 0.0;
+        }
+    return result;
+    }
+
+pybind11::array_t<double> PairCorrelationMapAnalyzer::getPhaseFrames() const
+    {
+    return pybind11::array_t<double>(m_phase_frames.size(), m_phase_frames.data());
+    }
+
+namespace detail
+    {
+void export_PairCorrelationMapAnalyzer(pybind11::module& m)
+    {
+    pybind11::class_<PairCorrelationMapAnalyzer,
+                     Analyzer,
+                     std::shared_ptr<PairCorrelationMapAnalyzer>>(m, "PairCorrelationMapAnalyzer")
+        .def(pybind11::init<std::shared_ptr<SystemDefinition>,
+                            std::shared_ptr<Trigger>,
+                            std::shared_ptr<NeighborList>,
+                            Scalar,
+                            unsigned int,
+                            Scalar,
+                            const std::vector<unsigned int>&,
+                            unsigned int,
+                            uint64_t,
+                            uint64_t>())
+        .def("reset", &PairCorrelationMapAnalyzer::reset)
+        .def("getBinCenters", &PairCorrelationMapAnalyzer::getBinCenters)
+        .def("getMaps", &PairCorrelationMapAnalyzer::getMaps)
+        .def("getPairCounts", &PairCorrelationMapAnalyzer::getPairCounts)
+        .def("getPhaseFrames", &PairCorrelationMapAnalyzer::getPhaseFrames)
+        .def_property_readonly("n_frames", &PairCorrelationMapAnalyzer::getNFrames)
+        .def_property_readonly("r_max", &PairCorrelationMapAnalyzer::getRMax)
+        .def_property_readonly("bins", &PairCorrelationMapAnalyzer::getBins)
+        .def_property_readonly("slice_width", &PairCorrelationMapAnalyzer::getSliceWidth)
+        .def_property_readonly("phase_bins", &PairCorrelationMapAnalyzer::getPhaseBins);
+    }
+
+    } // end namespace detail
+    } // end namespace md
+    } // end namespace hoomd
@@ -0,0 +1,152 @@
+//~ ########## Created by the Rheoinformatic research group ##########
+//~ HOOMD-blue:
+// Copyright (c) 2009-2023 The Regents of the University of Michigan.
+// Part of HOOMD-blue, released under the BSD 3-Clause License.
+//~
+//~ This file:
+//~ Written by the Rheoinformatic research group (2026)
+
+// ########## Created by Rheoinformatic //~ [RHEOINF] ##########
+
+/*! \file PairCorrelationMapAnalyzer.h
+    \brief Declares the PairCorrelationMapAnalyzer class
+
+    PairCorrelationMapAnalyzer accumulates 2D maps of the pair separations in the xy, xz, and yz
+    planes from a neighbor list during the simulation, so the anisotropy of the structure under
+    shear no longer needs every frame stored and a loop over all pairs after the run.
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include "NeighborListPairAnalyzer.h"
+
+#include <memory>
+#include <pybind11/numpy.h>
+#include <pybind11/pybind11.h>
+#include <vector>
+
+#ifndef __PAIR_CORRELATION_MAP_ANALYZER_H__
+#define __PAIR_CORRELATION_MAP_ANALYZER_H__
+
+namespace hoomd
+    {
+namespace md
+    {
+//! Accumulates the pair correlation of the selected particles in slices through three planes
+/*! For every ordered pair i, j of the selected types with the minimum image separation
+    d = r_j - r_i in the (possibly tilted) box, the pair is binned in
+
+    - the xy map at (d_x, d_y) when |d_z| <= slice_width
+    - the xz map at (d_x, d_z) when |d_y| <= slice_width
+    - the yz map at (d_y, d_z) when |d_x| <= slice_width
+
+    Each map has bins x bins square bins covering [-r_max, r_max) in both directions. The search
+    range sqrt(2 r_max^2 + slice_width^2) is added to the neighbor list for the selected type
+    pairs (see NeighborListPairAnalyzer). Half lists hold local-local pairs once and local-ghost
+    pairs on both ranks, full lists hold every pair twice, so those entries are weighted by 1/2.
+
+    Under oscillatory shear with the given period (in time steps), each frame is added to the
+    phase bin floor(phase_bins ((t - t_start) mod period) / period), frames before t_start are
+    skipped. With one phase bin all frames are accumulated together.
+
+    The pair correlation of a bin is the number of pairs divided by the number expected in an ideal
+    gas of the same density, sum over the frames of N^2 / V times the bin volume
+    bin_size^2 2 slice_width.
+
+    \ingroup analyzers
+*/
+class PYBIND11_EXPORT PairCorrelationMapAnalyzer : public NeighborListPairAnalyzer
+    {
+    public:
+    //! Construct the analyzer
+    PairCorrelationMapAnalyzer(std::shared_ptr<SystemDefinition> sysdef,
+                               std::shared_ptr<Trigger> trigger,
+                               std::shared_ptr<NeighborList> nlist,
+                               Scalar r_max,
+                               unsigned int bins,
+                               Scalar slice_width,
+                               const std::vector<unsigned int>& types,
+                               unsigned int phase_bins,
+                               uint64_t period,
+                               uint64_t t_start);
+
+    //! Destructor
+    virtual ~PairCorrelationMapAnalyzer();
+
+    //! Add the pairs of the current frame
+    virtual void analyze(uint64_t timestep);
+
+    //! Clear the accumulated maps
+    void reset();
+
+    //! Get the separations at the bin centers along each axis of a map
+    pybind11::array_t<double> getBinCenters() const;
+
+    //! Get the pair correlation maps (3, phase_bins, bins, bins) of the xy, xz, and yz planes
+    pybind11::array_t<double> getMaps();
+
+    //! Get the accumulated pair counts (3, phase_bins, bins, bins)
+    pybind11::array_t<double> getPairCounts();
+
+    //! Get the number of frames accumulated in each phase bin
+    pybind11::array_t<double> getPhaseFrames() const;
+
+    //! Get the number of frames accumulated since the last reset
+    uint64_t getNFrames() const
+        {
+        return m_n_frames;
+        }
+
+    //! Get the half width of the maps
+    Scalar getRMax() const
+        {
+        return m_r_max;
+        }
+
+    //! Get the number of bins along each axis of a map
+    unsigned int getBins() const
+        {
+        return m_bins;
+        }
+
+    //! Get the half thickness of the slices
+    Scalar getSliceWidth() const
+        {
+        return m_slice_width;
+        }
+
+    //! Get the number of phase bins
+    unsigned int getPhaseBins() const
+        {
+        return m_phase_bins;
+        }
+
+    private:
+    Scalar m_r_max;            //!< Half width of the maps
+    unsigned int m_bins;       //!< Number of bins along each axis
+    Scalar m_slice_width;      //!< Half thickness of the slices
+    unsigned int m_phase_bins; //!< Number of phase bins
+    uint64_t m_period;         //!< Oscillation period in time steps
+    uint64_t m_t_start;        //!< Time step of phase 0
+
+    std::vector<double> m_counts;       //!< Pair counts of this rank per plane, phase, and bin
+    std::vector<double> m_norm;         //!< Sum of N^2 / V times the bin volume per phase
+    std::vector<double> m_phase_frames; //!< Frames per phase
+    uint64_t m_n_frames;                //!< Frames accumulated since the last reset
+
+    //! Sum the counts of all ranks
+    std::vector<double> reduceCounts();
+    };
+
+namespace detail
+    {
+//! Export PairCorrelationMapAnalyzer to python
+void export_PairCorrelationMapAnalyzer(pybind11::module& m);
+    } // end namespace detail
+
+    } // end namespace md
+    } // end namespace hoomd
+
+#endif // __PAIR_CORRELATION_MAP_ANALYZER_H__
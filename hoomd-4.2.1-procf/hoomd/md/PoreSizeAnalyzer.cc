@@ -0,0 +1,625 @@
+//~ ########## Created by the Rheoinformatic research group ##########
+//~ HOOMD-blue:
+// Copyright (c) 2009-2023 The Regents of the University of Michigan.
+// Part of HOOMD-blue, released under the BSD 3-Clause License.
+//~
+//~ This file:
+//~ Written by the Rheoinformatic research group (2026)
+
+// ########## Created by Rheoinformatic //~ [RHEOINF] ##########
+
+/*! \file PoreSizeAnalyzer.cc
+    \brief Defines the PoreSizeAnalyzer class
+*/
+
+#include "PoreSizeAnalyzer.h"
+#include "hoomd/RNGIdentifiers.h"
+#include "hoomd/RandomNumbers.h"
+
+#ifdef ENABLE_TBB
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#endif
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <pybind11/stl.h>
+#include <stdexcept>
+
+using namespace std;
+
+namespace hoomd
+    {
+namespace md
+    {
+namespace
+    {
+// values stored per probe: probe x, y, z, pore center x, y, z, Torquato and Gubbins diameters
+const unsigned int n_probe_values = 8;
+
+// random draws per probe before giving up on finding the void
+const unsigned int max_draws = 100000;
+
+//! Sphere surface near a point
+struct SurfaceHit
+    {
+    double s;       //!< Distance from the point to the surface, negative inside the sphere
+    vec3<double> n; //!< Unit vector from the center of the sphere to the point
+    };
+
+//! Finds the nearest sphere surfaces to points in the periodic box
+class SurfaceSearch
+    {
+    public:
+    SurfaceSearch(const hoomd::detail::AABBTree& tree,
+                  const std::vector<vec3<double>>& centers,
+                  const std::vector<double>& radii,
+                  const BoxDim& box)
+        : m_tree(tree), m_centers(centers), m_radii(radii), m_box(box)
+        {
+        // the image of the box itself first, so the bound is tight for the others
+        m_images.push_back(vec3<double>(0, 0, 0));
+        for (int i = -1; i <= 1; i++)
+            for (int j = -1; j <= 1; j++)
+                for (int k = -1; k <= 1; k++)
+                    {
+                    if (i == 0 && j == 0 && k == 0)
+                        continue;
+                    m_images.push_back(double(i) * vec3<double>(box.getLatticeVector(0))
+                                       + double(j) * vec3<double>(box.getLatticeVector(1))
+                                       + double(k) * vec3<double>(box.getLatticeVector(2)));
+                    }
+        }
+
+    //! Find the k <= 3 nearest surfaces to q, sorted by distance
+    /*! \returns the number of surfaces found
+
+        With k = 1 the search stops at the first sphere that contains q.
+    */
+    unsigned int nearest(const vec3<double>& q, unsigned int k, SurfaceHit* hits) const
+        {
+        const vec3<double> p(m_box.minImage(make_scalar3(Scalar(q.x), Scalar(q.y), Scalar(q.z))));
+        unsigned int n = 0;
+        for (const vec3<double>& image : m_images)
+            {
+            const vec3<double> p_image = p + image;
+            for (unsigned int node = 0; node < m_tree.getNumNodes(); node++)
+                {
+                // the distance to the box of a node bounds the distance to its surfaces
+                const hoomd::detail::AABB& aabb = m_tree.getNodeAABB(node);
+                const vec3<double> lower(aabb.getLower());
+                const vec3<double> upper(aabb.getUpper());
+                const double dx = std::max(std::max(lower.x - p_image.x, p_image.x - upper.x), 0.0);
+                const double dy = std::max(std::max(lower.y - p_image.y, p_image.y - upper.y), 0.0);
+                const double dz = std::max(std::max(lower.z - p_image.z, p_image.z - upper.z), 0.0);
+                const double bound = n == k ? hits[k - 1].s : std::numeric_limits<double>::max();
+                if (bound <= 0.0 || dx * dx + dy * dy + dz * dz >= bound * bound)
+                    {
+                    if (bound <= 0.0 && k == 1)
+                        return n;
+                    node += m_tree.getNodeSkip(node);
+                    continue;
+                    }
+                if (!m_tree.isNodeLeaf(node))
+                    continue;
+
+                for (unsigned int j = 0; j < m_tree.getNodeNumParticles(node); j++)
+                    {
+                    const unsigned int idx = m_tree.getNodeParticle(node, j);
+                    const vec3<double> d = p_image - m_centers[idx];
+                    const double r = sqrt(dot(d, d));
+                    SurfaceHit hit;
+                    hit.s = r - m_radii[idx];
+                    hit.n = r > 0.0 ? d / r : vec3<double>(1, 0, 0);
+
+                    // insert into the sorted hits
+                    unsigned int pos = n < k ? n++ : k;
+                    while (pos > 0 && hits[pos - 1].s > hit.s)
+                        {
+                        if (pos < k)
+                            hits[pos] = hits[pos - 1];
+                        pos--;
+                        }
+                    if (pos < k)
+                        hits[pos] = hit;
+                    }
+                }
+            }
+        return n;
+        }
+
+    //! Distance from q to the nearest surface
+    double distance(const vec3<double>& q) const
+        {
+        SurfaceHit hit;
+        return nearest(q, 1, &hit) > 0 ? hit.s : std::numeric_limits<double>::max();
+        }
+
+    private:
+    const hoomd::detail::AABBTree& m_tree;
+    const std::vector<vec3<double>>& m_centers;
+    const std::vector<double>& m_radii;
+    const BoxDim& m_box;
+    std::vector<vec3<double>> m_images; //!< Lattice translations to the 26 neighboring images
+    };
+
+//! Climb to a local maximum of the radius of the empty spheres that contain p
+/*! \param search Nearest surface search
+    \param p Probe point in the void
+    \param delta_p Distance from p to the nearest surface
+    \param lattice Unit vectors of the 26 lattice directions
+    \param center Center of a sphere that contains p on input, of the local maximum on output
+    \returns the radius of the sphere
+*/
+double climbSphere(const SurfaceSearch& search,
+                   const vec3<double>& p,
+                   double delta_p,
+                   const std::vector<vec3<double>>& lattice,
+                   vec3<double>& center)
+    {
+    double delta = search.distance(center);
+    double step = 0.5 * delta_p;
+    const double tolerance = 1e-3 * delta_p;
+
+    SurfaceHit hits[3];
+    std::vector<vec3<double>> directions;
+    for (unsigned int iteration = 0; step > tolerance && iteration < 1000; iteration++)
+        {
+        // ascent directions where one, two, or three surfaces are the nearest
+        const unsigned int n = search.nearest(center, 3, hits);
+        directions.assign(lattice.begin(), lattice.end());
+        for (unsigned int a = 0; a < n; a++)
+            {
+            directions.push_back(hits[a].n);
+            for (unsigned int b = a + 1; b < n; b++)
+                directions.push_back(hits[a].n + hits[b].n);
+            }
+        if (n == 3)
+            {
+            const vec3<double> ridge = cross(hits[0].n - hits[1].n, hits[0].n - hits[2].n);
+            directions.push_back(ridge);
+            directions.push_back(-ridge);
+            }
+
+        double best = delta;
+        vec3<double> best_center = center;
+        for (const vec3<double>& u : directions)
+            {
+            const double norm = sqrt(dot(u, u));
+            if (norm < 1e-12)
+                continue;
+            const vec3<double> trial = center + (step / norm) * u;
+            const double delta_trial = search.distance(trial);
+            const vec3<double> dp = trial - p;
+            if (delta_trial > best && dot(dp, dp) <= delta_trial * delta_trial)
+                {
+                best = delta_trial;
+                best_center = trial;
+                }
+            }
+
+        if (best > delta)
+            {
+            delta = best;
+            center = best_center;
+            }
+        else
+            {
+            step *= 0.5;
+            }
+        }
+    return delta;
+    }
+
+//! Center and radius of the largest empty sphere that contains p
+/*! The constrained maximum can have several local maxima, so the search also starts from the six
+    points p +- delta_p / 2 along the axes, which are inside spheres that contain p.
+*/
+double largestSphere(const SurfaceSearch& search,
+                     const vec3<double>& p,
+                     double delta_p,
+                     const std::vector<vec3<double>>& lattice,
+                     vec3<double>& center)
+    {
+    const vec3<double> axes[6] = {vec3<double>(1, 0, 0),
+                                  vec3<double>(-1, 0, 0),
+                                  vec3<double>(0, 1, 0),
+                                  vec3<double>(0, -1, 0),
+                                  vec3<double>(0, 0, 1),
+                                  vec3<double>(0, 0, -1)};
+    center = p;
+    double delta = climbSphere(search, p, delta_p, lattice, center);
+    for (const vec3<double>& axis : axes)
+        {
+        vec3<double> start = p + (0.5 * delta_p) * axis;
+        const double delta_start = climbSphere(search, p, delta_p, lattice, start);
+        if (delta_start > delta)
+            {
+            delta = delta_start;
+            center = start;
+            }
+        }
+    return delta;
+    }
+    } // end anonymous namespace
+
+/*! \param sysdef System definition
+    \param trigger Select the timesteps to sample
+    \param n_probes Number of probes per frame
+    \param bins Number of bins of the histograms
+    \param d_max Largest diameter in the histograms
+    \param types Indices of the selected types (all types when empty)
+*/
+PoreSizeAnalyzer::PoreSizeAnalyzer(std::shared_ptr<SystemDefinition> sysdef,
+                                   std::shared_ptr<Trigger> trigger,
+                                   unsigned int n_probes,
+                                   unsigned int bins,
+                                   Scalar d_max,
+                                   const std::vector<unsigned int>& types)
+    : Analyzer(sysdef, trigger), m_n_probes(n_probes), m_bins(bins), m_d_max(d_max),
+      m_sum_torquato(0.0), m_sum_gubbins(0.0), m_n_samples(0.0), m_n_drawn(0.0), m_n_frames(0)
+    {
+    m_exec_conf->msg->notice(5) << "Constructing PoreSizeAnalyzer" << endl;
+
+    if (m_exec_conf->isCUDAEnabled())
+        {
+        throw runtime_error("PoreSize: only the CPU implementation is available.");
+        }
+    if (m_sysdef->getNDimensions() != 3)
+        {
+        throw runtime_error("PoreSize: only 3D systems are supported.");
+        }
+    if (m_n_probes == 0 || m_bins == 0)
+        {
+        throw runtime_error("PoreSize: n_probes and bins must be positive.");
+        }
+    if (!(m_d_max > Scalar(0.0)))
+        {
+        throw runtime_error("PoreSize: d_max must be positive.");
+        }
+
+    m_include.assign(m_pdata->getNTypes(), types.empty());
+    for (unsigned int type : types)
+        {
+        if (type >= m_pdata->getNTypes())
+            {
+            throw runtime_error("PoreSize: invalid particle type.");
+            }
+        m_include[type] = true;
+        }
+    m_hist_torquato.assign(m_bins, 0.0);
+    m_hist_gubbins.assign(m_bins, 0.0);
+    }
+
+PoreSizeAnalyzer::~PoreSizeAnalyzer()
+    {
+    m_exec_conf->msg->notice(5) << "Destroying PoreSizeAnalyzer" << endl;
+    }
+
+void PoreSizeAnalyzer::buildTree()
+    {
+    std::vector<double> local;
+        {
+        ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(),
+                                   access_location::host,
+                                   access_mode::read);
+        ArrayHandle<Scalar> h_diameter(m_pdata->getDiameters(),
+                                       access_location::host,
+                                       access_mode::read);
+        for (unsigned int i = 0; i < m_pdata->getN(); i++)
+            {
+            if (!m_include[__scalar_as_int(h_pos.data[i].w)])
+                continue;
+            local.push_back(h_pos.data[i].x);
+            local.push_back(h_pos.data[i].y);
+            local.push_back(h_pos.data[i].z);
+            local.push_back(0.5 * h_diameter.data[i]);
+            }
+        }
+
+    std::vector<double> spheres;
+#ifdef ENABLE_MPI
+    if (m_sysdef->isDomainDecomposed())
+        {
+        // every rank samples probes anywhere in the box, so it needs all spheres
+        const int n_ranks = m_exec_conf->getNRanks();
+        int n_local = (int)local.size();
+        std::vector<int> counts(n_ranks), offsets(n_ranks, 0);
+        MPI_Allgather(&n_local,
+                      1,
+                      MPI_INT,
+                      counts.data(),
+                      1,
+                      MPI_INT,
+                      m_exec_conf->getMPICommunicator());
+        for (int r = 1; r < n_ranks; r++)
+            offsets[r] = offsets[r - 1] + counts[r - 1];
+        spheres.resize(offsets[n_ranks - 1] + counts[n_ranks - 1]);
+        MPI_Allgatherv(local.data(),
+                       n_local,
+                       MPI_DOUBLE,
+                       spheres.data(),
+                       counts.data(),
+                       offsets.data(),
+                       MPI_DOUBLE,
+                       m_exec_conf->getMPICommunicator());
+        }
+    else
+#endif
+        {
+        spheres.swap(local);
+        }
+
+    const unsigned int n = (unsigned int)(spheres.size() / 4);
+    m_centers.resize(n);
+    m_radii.resize(n);
+    m_aabbs.resize(n);
+    for (unsigned int j = 0; j < n; j++)
+        {
+        m_centers[j] = vec3<double>(spheres[4 * j], spheres[4 * j + 1], spheres[4 * j + 2]);
+        m_radii[j] = spheres[4 * j + 3];
+        m_aabbs[j] = hoomd::detail::AABB(vec3<Scalar>(m_centers[j]), Scalar(m_radii[j]));
+        }
+    if (n > 0)
+        m_tree.buildTree(m_aabbs.data(), n);
+    }
+
+/*! \param timestep Current time step of the simulation
+ */
+void PoreSizeAnalyzer::analyze(uint64_t timestep)
+    {
+    Analyzer::analyze(timestep);
+
+    if (m_pdata->getNTypes() != m_include.size())
+        {
+        throw runtime_error("PoreSize: the number of particle types changed.");
+        }
+
+    buildTree();
+    if (m_centers.empty())
+        {
+        throw runtime_error("PoreSize: there are no particles of the selected types.");
+        }
+
+    const BoxDim& box = m_pdata->getGlobalBox();
+    const SurfaceSearch search(m_tree, m_centers, m_radii, box);
+    std::vector<vec3<double>> lattice;
+    for (int i = -1; i <= 1; i++)
+        for (int j = -1; j <= 1; j++)
+            for (int k = -1; k <= 1; k++)
+                if (i != 0 || j != 0 || k != 0)
+                    lattice.push_back(vec3<double>(i, j, k) / sqrt(double(i * i + j * j + k * k)));
+
+    // the probes of this rank
+    unsigned int first = 0, last = m_n_probes;
+#ifdef ENABLE_MPI
+    if (m_sysdef->isDomainDecomposed())
+        {
+        const uint64_t rank = m_exec_conf->getRank();
+        const uint64_t n_ranks = m_exec_conf->getNRanks();
+        first = (unsigned int)(rank * m_n_probes / n_ranks);
+        last = (unsigned int)((rank + 1) * m_n_probes / n_ranks);
+        }
+#endif
+    const unsigned int n_local = last - first;
+    m_probes.assign(size_t(n_local) * n_probe_values, 0.0);
+    std::vector<unsigned int> draws(n_local, 0);
+    const uint16_t seed = m_sysdef->getSeed();
+
+    auto sample = [&](unsigned int begin, unsigned int end)
+    {
+        for (unsigned int k = begin; k < end; k++)
+            {
+            RandomGenerator rng(Seed(RNGIdentifier::PoreSizeAnalyzer, timestep, seed),
+                                Counter(first + k));
+            UniformDistribution<Scalar> uniform(Scalar(0.0), Scalar(1.0));
+
+            double* probe = &m_probes[size_t(k) * n_probe_values];
+            vec3<double> p;
+            double delta_p = -1.0;
+            while (delta_p <= 0.0 && draws[k] < max_draws)
+                {
+                const Scalar3 f = make_scalar3(uniform(rng), uniform(rng), uniform(rng));
+                p = vec3<double>(box.makeCoordinates(f));
+                delta_p = search.distance(p);
+                draws[k]++;
+                }
+            if (delta_p <= 0.0)
+                {
+                for (unsigned int v = 0; v < n_probe_values; v++)
+                    probe[v] = std::numeric_limits<double>::quiet_NaN();
+                continue;
+                }
+
+            vec3<double> center;
+            const double delta_c = largestSphere(search, p, delta_p, lattice, center);
+            probe[0] = p.x;
+            probe[1] = p.y;
+            probe[2] = p.z;
+            probe[3] = center.x;
+            probe[4] = center.y;
+            probe[5] = center.z;
+            probe[6] = 2.0 * delta_p;
+            probe[7] = 2.0 * delta_c;
+            }
+    };
+
+#ifdef ENABLE_TBB
+    m_exec_conf->getTaskArena()->execute(
+        [&]
+        {
+            tbb::parallel_for(tbb::blocked_range<unsigned int>(0, n_local),
+                              [&](const tbb::blocked_range<unsigned int>& r)
+                              { sample(r.begin(), r.end()); });
+        });
+#else
+    sample(0, n_local);
+#endif
+
+    // histograms and sums of the frame: Torquato, Gubbins, sum of diameters, probes, draws
+    std::vector<double> frame(2 * m_bins + 5, 0.0);
+    const double bin_scale = double(m_bins) / m_d_max;
+    for (unsigned int k = 0; k < n_local; k++)
+        {
+        const double* probe = &m_probes[size_t(k) * n_probe_values];
+        frame[2 * m_bins + 4] += draws[k];
+        if (std::isnan(probe[6]))
+            continue;
+        // diameters beyond d_max are counted in the last bin
+        const unsigned int bin_t = std::min((unsigned int)(probe[6] * bin_scale), m_bins - 1);
+        const unsigned int bin_g = std::min((unsigned int)(probe[7] * bin_scale), m_bins - 1);
+        frame[bin_t] += 1.0;
+        frame[m_bins + bin_g] += 1.0;
+        frame[2 * m_bins] += probe[6];
+        frame[2 * m_bins + 1] += probe[7];
+        frame[2 * m_bins + 2] += 1.0;
+        }
+    frame[2 * m_bins + 3] = n_local - frame[2 * m_bins + 2];
+#ifdef ENABLE_MPI
+    if (m_sysdef->isDomainDecomposed())
+        {
+        MPI_Allreduce(MPI_IN_PLACE,
+                      frame.data(),
+                      (int)frame.size(),
+                      MPI_DOUBLE,
+                      MPI_SUM,
+                      m_exec_conf->getMPICommunicator());
+        }
+#endif
+
+    for (unsigned int b = 0; b < m_bins; b++)
+        {
+        m_hist_torquato[b] += frame[b];
+        m_hist_gubbins[b] += frame[m_bins + b];
+        }
+    m_sum_torquato += frame[2 * m_bins];
+    m_sum_gubbins += frame[2 * m_bins + 1];
+    m_n_samples += frame[2 * m_bins + 2];
+    m_n_drawn += frame[2 * m_bins + 4];
+    m_n_frames++;
+
+    if (frame[2 * m_bins + 3] > 0.0)
+        {
+        m_exec_conf->msg->warning()
+            << "PoreSize: " << frame[2 * m_bins + 3] << " probes found no void in " << max_draws
+            << " draws." << endl;
+        }
+    }
+
+void PoreSizeAnalyzer::reset()
+    {
+    std::fill(m_hist_torquato.begin(), m_hist_torquato.end(), 0.0);
+    std::fill(m_hist_gubbins.begin(), m_hist_gubbins.end(), 0.0);
+    m_sum_torquato = 0.0;
+    m_sum_gubbins = 0.0;
+    m_n_samples = 0.0;
+    m_n_drawn = 0.0;
+    m_n_frames = 0;
+    }
+
+pybind11::array_t<double> PoreSizeAnalyzer::getBinCenters() const
+    {
+    pybind11::array_t<double> result(m_bins);
+    double* data = result.mutable_data();
+    for (unsigned int b = 0; b < m_bins; b++)
+        data[b] = (b + 0.5) * m_d_max / double(m_bins);
+    return result;
+    }
+
+pybind11::array_t<double> PoreSizeAnalyzer::getDensity(const std::vector<double>& hist) const
+    {
+    pybind11::array_t<double> result(m_bins);
+    double* data = result.mutable_data();
+    const double scale = m_n_samples > 0.0 ? double(m_bins) / (m_d_max * m_n_samples) : 0.0;
+    for (unsigned int b = 0; b < m_bins; b++)
+        data[b] = hist[b] * scale;
+    return result;
+    }
+
+pybind11::array_t<double> PoreSizeAnalyzer::getTorquato() const
+    {
+    return getDensity(m_hist_torquato);
+    }
+
+pybind11::array_t<double> PoreSizeAnalyzer::getGubbins() const
+    {
+    return getDensity(m_hist_gubbins);
+    }
+
+/*! All ranks must call this method.
+ */
+pybind11::object PoreSizeAnalyzer::getProbes()
+    {
+    std::vector<double> probes(m_probes);
+    bool root = true;
+#ifdef ENABLE_MPI
+    if (m_sysdef->isDomainDecomposed())
+        {
+        // the probes of the ranks are consecutive ranges of the probe index
+        root = m_exec_conf->isRoot();
+        const int n_ranks = m_exec_conf->getNRanks();
+        int n_local = (int)m_probes.size();
+        std::vector<int> counts(n_ranks), offsets(n_ranks, 0);
+        MPI_Gather(&n_local,
+                   1,
+                   MPI_INT,
+                   counts.data(),
+                   1,
+                   MPI_INT,
+                   0,
+                   m_exec_conf->getMPICommunicator());
+        for (int r = 1; r < n_ranks; r++)
+            offsets[r] = offsets[r - 1] + counts[r - 1];
+        if (root)
+            probes.resize(offsets[n_ranks - 1] + counts[n_ranks - 1]);
+        MPI_Gatherv(m_probes.data(),
+                    n_local,
+                    MPI_DOUBLE,
+                    probes.data(),
+                    counts.data(),
+                    offsets.data(),
+                    MPI_DOUBLE,
+                    0,
+                    m_exec_conf->getMPICommunicator());
+        }
+#endif
+    if (!root)
+        return pybind11::none();
+
+    pybind11::array_t<double> result(
+        std::vector<size_t> {probes.size() / n_probe_values, n_probe_values});
+    std::copy(probes.begin(), probes.end(), result.mutable_data());
+    return result;
+    }
+
+namespace detail
+    {
+void export_PoreSizeAnalyzer(pybind11::module& m)
+    {
+    pybind11::class_<PoreSizeAnalyzer, Analyzer, std::shared_ptr<PoreSizeAnalyzer>>(
+        m,
+        "PoreSizeAnalyzer")
+        .def(pybind11::init<std::shared_ptr<SystemDefinition>,
+                            std::shared_ptr<Trigger>,
+                            unsigned int,
+                            unsigned int,
+                            Scalar,
+                            const std::vector<unsigned int>&>())
+        .def("reset", &PoreSizeAnalyzer::reset)
+        .def("getBinCenters", &PoreSizeAnalyzer::getBinCenters)
+        .def("getTorquato", &PoreSizeAnalyzer::getTorquato)
+        .def("getGubbins", &PoreSizeAnalyzer::getGubbins)
+        .def("getProbes", &PoreSizeAnalyzer::getProbes)
+        .def_property_readonly("mean_torquato", &PoreSizeAnalyzer::getMeanTorquato)
+        .def_property_readonly("mean_gubbins", &PoreSizeAnalyzer::getMeanGubbins)
+        .def_property_readonly("porosity", &PoreSizeAnalyzer::getPorosity)
+        .def_property_readonly("n_frames", &PoreSizeAnalyzer::getNFrames)
+        .def_property_readonly("n_probes", &PoreSizeAnalyzer::getNProbes)
+        .def_property_readonly("bins", &PoreSizeAnalyzer::getBins)
+        .def_property_readonly("d_max", &PoreSizeAnalyzer::getDMax);
+    }
+
+    } // end namespace detail
+    } // end namespace md
+    } // end namespace hoomd
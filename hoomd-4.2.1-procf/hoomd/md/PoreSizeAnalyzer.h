@@ -0,0 +1,174 @@
+//~ ########## Created by the Rheoinformatic research group ##########
+//~ HOOMD-blue:
+// Copyright (c) 2009-2023 The Regents of the University of Michigan.
+// Part of HOOMD-blue, released under the BSD 3-Clause License.
+//~
+//~ This file:
+//~ Written by the Rheoinformatic research group (2026)
+
+// ########## Created by Rheoinformatic //~ [RHEOINF] ##########
+
+/*! \file PoreSizeAnalyzer.h
+    \brief Declares the PoreSizeAnalyzer class
+
+    PoreSizeAnalyzer samples the pore size distributions of Torquato and of Gubbins with random
+    probes during the simulation, with an AABB tree of the particles for the distance to the
+    nearest surface instead of a linked list and a general nonlinear optimizer per probe.
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include "hoomd/AABBTree.h"
+#include "hoomd/Analyzer.h"
+
+#include <memory>
+#include <pybind11/numpy.h>
+#include <pybind11/pybind11.h>
+#include <vector>
+
+#ifndef __PORE_SIZE_ANALYZER_H__
+#define __PORE_SIZE_ANALYZER_H__
+
+namespace hoomd
+    {
+namespace md
+    {
+//! Samples the pore size distributions of the space between the selected particles
+/*! The selected particles are spheres of radius R_j = d_j / 2. For a point p of the void space,
+    let delta(p) = min_j (|p - r_j| - R_j) be the distance to the nearest sphere surface. Each call
+    to analyze() draws n_probes uniform random points in the void (points inside a sphere are
+    drawn again) and computes for each probe:
+
+    - Torquato: the diameter 2 delta(p) of the largest empty sphere centered at p
+    - Gubbins: the diameter 2 delta(c) of the largest empty sphere that contains p,
+      maximizing delta(c) subject to |c - p| <= delta(c)
+
+    The largest sphere is found with a pattern search, with the directions away from the three
+    nearest surfaces, along the ridges where they are equidistant, and the 26 lattice directions,
+    halving the step when no direction improves delta(c) while keeping p inside. The search starts
+    from c = p and from the six points p +- delta(p) / 2 along the axes, to avoid most of the
+    smaller local maxima.
+
+    The spheres of all ranks are gathered on every rank into an AABB tree, searched with the
+    periodic images of the (possibly tilted) box. The probes are split over the ranks by index and
+    computed in parallel with TBB when available. Each probe uses its own random stream, so the
+    results do not depend on the number of ranks or threads.
+
+    The diameters accumulate into histograms over the frames since the last reset. The fraction
+    of draws that fall in the void estimates the porosity.
+
+    \ingroup analyzers
+*/
+class PYBIND11_EXPORT PoreSizeAnalyzer : public Analyzer
+    {
+    public:
+    //! Construct the analyzer
+    PoreSizeAnalyzer(std::shared_ptr<SystemDefinition> sysdef,
+                     std::shared_ptr<Trigger> trigger,
+                     unsigned int n_probes,
+                     unsigned int bins,
+                     Scalar d_max,
+                     const std::vector<unsigned int>& types);
+
+    //! Destructor
+    virtual ~PoreSizeAnalyzer();
+
+    //! Sample the pores of the current frame
+    virtual void analyze(uint64_t timestep);
+
+    //! Clear the accumulated histograms
+    void reset();
+
+    //! Get the pore diameters at the bin centers
+    pybind11::array_t<double> getBinCenters() const;
+
+    //! Get the probability density of the Torquato pore diameter
+    pybind11::array_t<double> getTorquato() const;
+
+    //! Get the probability density of the Gubbins pore diameter
+    pybind11::array_t<double> getGubbins() const;
+
+    //! Get probe, pore center, and both diameters of each probe of the last frame on the root rank
+    pybind11::object getProbes();
+
+    //! Get the mean Torquato pore diameter
+    double getMeanTorquato() const
+        {
+        return m_n_samples > 0.0 ? m_sum_torquato / m_n_samples : 0.0;
+        }
+
+    //! Get the mean Gubbins pore diameter
+    double getMeanGubbins() const
+        {
+        return m_n_samples > 0.0 ? m_sum_gubbins / m_n_samples : 0.0;
+        }
+
+    //! Get the fraction of the random draws that fell in the void
+    double getPorosity() const
+        {
+        return m_n_drawn > 0.0 ? m_n_samples / m_n_drawn : 0.0;
+        }
+
+    //! Get the number of frames accumulated since the last reset
+    uint64_t getNFrames() const
+        {
+        return m_n_frames;
+        }
+
+    //! Get the number of probes per frame
+    unsigned int getNProbes() const
+        {
+        return m_n_probes;
+        }
+
+    //! Get the number of bins
+    unsigned int getBins() const
+        {
+        return m_bins;
+        }
+
+    //! Get the largest diameter in the histograms
+    Scalar getDMax() const
+        {
+        return m_d_max;
+        }
+
+    private:
+    unsigned int m_n_probes;     //!< Number of probes per frame
+    unsigned int m_bins;         //!< Number of bins
+    Scalar m_d_max;              //!< Largest diameter in the histograms
+    std::vector<bool> m_include; //!< True for the selected types
+
+    hoomd::detail::AABBTree m_tree;           //!< Tree of the spheres
+    std::vector<hoomd::detail::AABB> m_aabbs; //!< Bounding boxes of the spheres
+    std::vector<vec3<double>> m_centers;      //!< Centers of the spheres of all ranks
+    std::vector<double> m_radii;              //!< Radii of the spheres of all ranks
+
+    std::vector<double> m_probes;        //!< Probe, center, and diameters of the local probes
+    std::vector<double> m_hist_torquato; //!< Accumulated Torquato diameters per bin
+    std::vector<double> m_hist_gubbins;  //!< Accumulated Gubbins diameters per bin
+    double m_sum_torquato;               //!< Accumulated sum of the Torquato diameters
+    double m_sum_gubbins;                //!< Accumulated sum of the Gubbins diameters
+    double m_n_samples;                  //!< Accumulated number of probes
+    double m_n_drawn;                    //!< Accumulated number of random draws
+    uint64_t m_n_frames;                 //!< Frames accumulated since the last reset
+
+    //! Gather the selected particles of all ranks and build the tree
+    void buildTree();
+
+    //! Get the probability density of a histogram
+    pybind11::array_t<double> getDensity(const std::vector<double>& hist) const;
+    };
+
+namespace detail
+    {
+//! Export PoreSizeAnalyzer to python
+void export_PoreSizeAnalyzer(pybind11::module& m);
+    } // end namespace detail
+
+    } // end namespace md
+    } // end namespace hoomd
+
+#endif // __PORE_SIZE_ANALYZER_H__
@@ -612,6 +612,15 @@ template<class evaluator> void PotentialPair<evaluator>::computeForces(uint64_t
     ArrayHandle<size_t> h_head_list(m_nlist->getHeadList(),
                                     access_location::host,
                                     access_mode::read);
+    //~ read the delta encoded copy of the neighbor list when it is enabled [RHEOINF]
+    const bool compressed = m_nlist->getCompressed();
+    ArrayHandle<uint16_t> h_nlist_compressed(m_nlist->getNListCompressedArray(),
+                                             access_location::host,
+                                             access_mode::read);
+    ArrayHandle<size_t> h_head_list_compressed(m_nlist->getHeadListCompressed(),
+                                               access_location::host,
+                                               access_mode::read);
+    //~
 
     ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
     ArrayHandle<Scalar> h_charge(m_pdata->getCharges(), access_location::host, access_mode::read);
@@ -678,10 +687,15 @@ template<class evaluator> void PotentialPair<evaluator>::computeForces(uint64_t
         // loop over all of the neighbors of this particle
         const size_t myHead = h_head_list.data[i];
         const unsigned int size = (unsigned int)h_n_neigh.data[i];
+        //~ add compressed nlist storage [RHEOINF]
+        detail::NeighborListDecoder decoder(
+            compressed ? h_nlist_compressed.data + h_head_list_compressed.data[i] : nullptr,
+            i);
+        //~
         for (unsigned int k = 0; k < size; k++)
             {
             // access the index of this neighbor (MEM TRANSFER: 1 scalar)
-            unsigned int j = h_nlist.data[myHead + k];
+            unsigned int j = compressed ? decoder.next() : h_nlist.data[myHead + k]; //~ add compressed nlist [RHEOINF]
             assert(j < m_pdata->getN() + m_pdata->getNGhosts());
 
             // calculate dr_ji (MEM TRANSFER: 3 scalars / FLOPS: 3)
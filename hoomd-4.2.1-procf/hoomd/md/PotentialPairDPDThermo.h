@@ -9,6 +9,10 @@
 #include "PotentialPair.h"
 #include "hoomd/Variant.h"
 #include "Lifetime.h" //~ add Lifetime.h [RHEOINF]
+#include "hoomd/CellList.h" //~ add cell list pair evaluation [RHEOINF]
+
+#include <memory> //~ [RHEOINF]
+#include <vector> //~ [RHEOINF]
 
 /*! \file PotentialPairDPDThermo.h
     \brief Defines the template class for a dpd thermostat and LJ pair potential
@@ -42,6 +46,26 @@ namespace md
      - And all the details about looping through the particles, computing dr, computing the virial,
    etc. are handled
 
+    //~ add cell list pair evaluation [RHEOINF]
+    <b>Cell list mode:</b>
+    When cell list mode is enabled, the neighbor list is not built. Instead, the pair loop searches
+   the 27 cells around each particle in a CellList whose width is the largest r_cut of this
+   potential, every step. The neighbor list is still used for its displacement check (and thus
+   for the MPI migration and ghost layer width), see NeighborList::trackDisplacements(). This
+   trades the memory traffic of a Verlet list for a wider candidate search, which pays off for
+   dense DPD systems with a short, uniform solvent cutoff. Only the CPU implementation supports it.
+    //~
+
+    //~ add ghost update overlap [RHEOINF]
+    <b>Overlapping the ghost update:</b>
+    With MPI, when overlap_comm is enabled, the pair loop over interior particles (those without
+   ghost neighbors, see NeighborList::setClassifyInterior()) runs in slices while the Communicator
+   waits for the ghost positions and velocities of each direction. computeForces() then only adds
+   the boundary particles. The overlap is used on steps without a neighbor list build (no particle
+   migration); on all other steps, and if anything about the list changed in between, the full
+   loop runs as before. Only the CPU implementation supports it.
+    //~
+
     \sa export_PotentialPairDPDThermo()
 */
 template<class evaluator> class PotentialPairDPDThermo : public PotentialPair<evaluator>
@@ -55,7 +79,7 @@ template<class evaluator> class PotentialPairDPDThermo : public PotentialPair<ev
                            std::shared_ptr<NeighborList> nlist,
                            bool bond_calc); //~ add bond_calc [RHEOINF]
     //! Destructor
-    virtual ~PotentialPairDPDThermo() {};
+    virtual ~PotentialPairDPDThermo(); //~ disconnect the ghost update overlap slot [RHEOINF]
 
     //! Set the temperature
     virtual void setT(std::shared_ptr<Variant> T);
@@ -78,6 +102,34 @@ template<class evaluator> class PotentialPairDPDThermo : public PotentialPair<ev
     std::shared_ptr<Lifetime> LTIME;
     //~
 
+    //~ add cell list pair evaluation [RHEOINF]
+    //! Enable/disable neighbor list free pair evaluation
+    void setCellListMode(bool cell_list);
+
+    //! Test if neighbor list free pair evaluation is enabled
+    bool getCellListMode()
+        {
+        return m_cell_list_mode;
+        }
+    //~
+
+    //~ add ghost update overlap [RHEOINF]
+    //! Enable/disable computing interior pairs during the ghost update
+    void setOverlapComm(bool overlap_comm);
+
+    //! Test if interior pairs are computed during the ghost update
+    bool getOverlapComm()
+        {
+        return m_overlap_comm;
+        }
+
+    //! Get the number of local particles computed during ghost updates
+    uint64_t getOverlapInteriorCount()
+        {
+        return m_overlap_interior_count;
+        }
+    //~
+
 #ifdef ENABLE_MPI
     //! Get ghost particle fields requested by this pair potential
     virtual CommFlags getRequestedCommFlags(uint64_t timestep);
@@ -86,8 +138,38 @@ template<class evaluator> class PotentialPairDPDThermo : public PotentialPair<ev
     protected:
     std::shared_ptr<Variant> m_T; //!< Temperature for the DPD thermostat
 
+    //~ add checkpoint state [RHEOINF]
+    //! Append the bond lifetime state after the force arrays
+    virtual void writeCheckpointState(hoomd::detail::CheckpointBuffer& buf);
+
+    //! Read the state written by writeCheckpointState()
+    virtual void readCheckpointState(hoomd::detail::CheckpointBuffer& buf);
+    //~
+
     bool m_bond_calc; //= false;      //~!< bond_calc flag (default false) [RHEOINF]
 
+    //~ add cell list pair evaluation [RHEOINF]
+    bool m_cell_list_mode;               //!< True if pairs are found from m_cl directly
+    std::shared_ptr<CellList> m_cl;      //!< Cell list searched in cell list mode
+    Scalar m_cl_width;                   //!< Nominal cell width last set on m_cl
+    std::vector<unsigned int> m_cl_neigh; //!< Candidate neighbors of the current particle
+    //~
+
+    //~ add ghost update overlap [RHEOINF]
+    bool m_overlap_comm;               //!< True if the overlap slot is connected
+    bool m_overlap_active;             //!< True if interior slices were computed on m_overlap_step
+    uint64_t m_overlap_step;           //!< Time step of the interior slices
+    uint64_t m_overlap_build_count;    //!< Neighbor list build count seen by the interior slices
+    unsigned int m_overlap_next;       //!< First entry of the interior order not yet computed
+    uint64_t m_overlap_interior_count; //!< Local particles computed during ghost updates
+
+    //! Compute a slice of the interior pairs while the ghost update is in flight
+    void slotGhostUpdateOverlap(uint64_t timestep, unsigned int stage, unsigned int n_stages);
+    //~
+
+    //! Loop over particles \a first to \a last (in interior order if \a ordered) [RHEOINF]
+    void computePairs(uint64_t timestep, unsigned int first, unsigned int last, bool ordered);
+
    //ofstream DiameterFile; //~ print diameters [RHEOINF]
 
     //! Actually compute the forces (overwrites PotentialPair::computeForces())
@@ -101,7 +183,12 @@ template<class evaluator>
 PotentialPairDPDThermo<evaluator>::PotentialPairDPDThermo(std::shared_ptr<SystemDefinition> sysdef,
                                                           std::shared_ptr<NeighborList> nlist,
                                                           bool bond_calc) //~ add bond_calc [RHEOINF]
-    : PotentialPair<evaluator>(sysdef, nlist), m_bond_calc(bond_calc) //~ add bond_calc [RHEOINF]
+    : PotentialPair<evaluator>(sysdef, nlist), m_bond_calc(bond_calc), //~ add bond_calc [RHEOINF]
+      m_cell_list_mode(false), m_cl_width(0.0), //~ add cell list pair evaluation [RHEOINF]
+      //~ add ghost update overlap [RHEOINF]
+      m_overlap_comm(false), m_overlap_active(false), m_overlap_step(0), m_overlap_build_count(0),
+      m_overlap_next(0), m_overlap_interior_count(0)
+    //~
     {
     //~ add bond_calc flag [RHEOINF]
     if(m_bond_calc)
@@ -111,6 +198,21 @@ PotentialPairDPDThermo<evaluator>::PotentialPairDPDThermo(std::shared_ptr<System
     //~
     }
 
+//~ disconnect the ghost update overlap slot [RHEOINF]
+template<class evaluator> PotentialPairDPDThermo<evaluator>::~PotentialPairDPDThermo()
+    {
+#ifdef ENABLE_MPI
+    if (m_overlap_comm && this->m_sysdef->isDomainDecomposed())
+        {
+        this->m_comm->getGhostUpdateOverlapSignal()
+            .template disconnect<PotentialPairDPDThermo<evaluator>,
+                                 &PotentialPairDPDThermo<evaluator>::slotGhostUpdateOverlap>(this);
+        this->m_nlist->setClassifyInterior(false);
+        }
+#endif
+    }
+//~
+
 /*! \param T the temperature the system is thermostated on this time step.
  */
 template<class evaluator> void PotentialPairDPDThermo<evaluator>::setT(std::shared_ptr<Variant> T)
@@ -124,6 +226,114 @@ template<class evaluator> std::shared_ptr<Variant> PotentialPairDPDThermo<evalua
     return m_T;
     }
 
+//~ add cell list pair evaluation [RHEOINF]
+/*! \param cell_list Set to true to find pairs from a cell list instead of the neighbor list
+ */
+template<class evaluator>
+void PotentialPairDPDThermo<evaluator>::setCellListMode(bool cell_list)
+    {
+    if (cell_list && this->m_exec_conf->isCUDAEnabled())
+        {
+        throw std::runtime_error("Cell list pair evaluation is not supported on the GPU.");
+        }
+
+    m_cell_list_mode = cell_list;
+    if (m_cell_list_mode && !m_cl)
+        {
+        m_cl = std::make_shared<CellList>(this->m_sysdef);
+        m_cl->setRadius(1);
+        m_cl->setComputeXYZF(true);
+        m_cl->setComputeTypeBody(false);
+        m_cl->setFlagIndex();
+        m_cl_width = Scalar(0.0);
+        }
+    else if (!m_cell_list_mode)
+        {
+        m_cl.reset();
+        m_cl_neigh.clear();
+        m_cl_neigh.shrink_to_fit();
+        // the neighbor list has not been built while it was bypassed
+        this->m_nlist->forceUpdate();
+        }
+    }
+//~
+
+//~ add ghost update overlap [RHEOINF]
+/*! \param overlap_comm Set to true to compute interior pairs while ghosts are communicated
+
+    Without domain decomposition there is no ghost update to overlap with and the setting has no
+    effect. Disabling the overlap releases this force's request for the interior/boundary
+    classification, so the neighbor list skips it when no other force overlaps.
+*/
+template<class evaluator>
+void PotentialPairDPDThermo<evaluator>::setOverlapComm(bool overlap_comm)
+    {
+    if (overlap_comm && this->m_exec_conf->isCUDAEnabled())
+        {
+        throw std::runtime_error("Overlapping the ghost update is not supported on the GPU.");
+        }
+
+#ifdef ENABLE_MPI
+    if (this->m_sysdef->isDomainDecomposed() && overlap_comm != m_overlap_comm)
+        {
+        if (overlap_comm)
+            {
+            this->m_comm->getGhostUpdateOverlapSignal()
+                .template connect<PotentialPairDPDThermo<evaluator>,
+                                  &PotentialPairDPDThermo<evaluator>::slotGhostUpdateOverlap>(
+                    this);
+            this->m_nlist->setClassifyInterior(true);
+            }
+        else
+            {
+            this->m_comm->getGhostUpdateOverlapSignal()
+                .template disconnect<PotentialPairDPDThermo<evaluator>,
+                                     &PotentialPairDPDThermo<evaluator>::slotGhostUpdateOverlap>(
+                    this);
+            this->m_nlist->setClassifyInterior(false);
+            }
+        }
+#endif
+
+    m_overlap_comm = overlap_comm;
+    m_overlap_active = false;
+    }
+
+/*! \param timestep Current time step
+    \param stage Index of the direction whose transfers are in flight
+    \param n_stages Number of directions in this ghost update
+
+    Stage s computes the s-th of n_stages equal slices of the interior particles. On the first
+    stage, the neighbor list built on an earlier step must still be valid for \a timestep,
+    otherwise nothing is computed here and computeForces() runs the full loop.
+*/
+template<class evaluator>
+void PotentialPairDPDThermo<evaluator>::slotGhostUpdateOverlap(uint64_t timestep,
+                                                               unsigned int stage,
+                                                               unsigned int n_stages)
+    {
+    if (stage == 0)
+        {
+        m_overlap_active = !m_cell_list_mode && this->m_nlist->isInteriorCurrent(timestep);
+        m_overlap_step = timestep;
+        m_overlap_build_count = this->m_nlist->getBuildCount();
+        m_overlap_next = 0;
+        }
+
+    if (!m_overlap_active || m_overlap_step != timestep)
+        return;
+
+    const unsigned int n_interior = this->m_nlist->getNInterior();
+    const unsigned int last = (unsigned int)((uint64_t)n_interior * (stage + 1) / n_stages);
+    if (last > m_overlap_next)
+        {
+        computePairs(timestep, m_overlap_next, last, true);
+        m_overlap_interior_count += last - m_overlap_next;
+        m_overlap_next = last;
+        }
+    }
+//~
+
 /*! \post The pair forces are computed for the given timestep. The neighborlist's compute method is
    called to ensure that it is up to date before proceeding.
 
@@ -131,12 +341,84 @@ template<class evaluator> std::shared_ptr<Variant> PotentialPairDPDThermo<evalua
 */
 template<class evaluator> void PotentialPairDPDThermo<evaluator>::computeForces(uint64_t timestep)
     {
-    // start by updating the neighborlist
-    this->m_nlist->compute(timestep);
+    //~ add cell list pair evaluation [RHEOINF]
+    /*// start by updating the neighborlist
+    this->m_nlist->compute(timestep);*/
+    const bool cell_list = m_cell_list_mode;
+    if (cell_list)
+        {
+        if (this->m_nlist->getExclusionsSet())
+            {
+            throw std::runtime_error("Cell list pair evaluation does not support exclusions.");
+            }
+
+        // keep the displacement check running, but skip the list build
+        this->m_nlist->trackDisplacements(timestep);
+
+        // the cells must be at least as wide as the largest cutoff of this potential
+        Scalar rmax = Scalar(0.0);
+            {
+            ArrayHandle<Scalar> h_rcutsq(this->m_rcutsq, access_location::host, access_mode::read);
+            for (unsigned int l = 0; l < this->m_rcutsq.getNumElements(); l++)
+                rmax = std::max(rmax, h_rcutsq.data[l]);
+            }
+        rmax = sqrt(rmax);
+        if (rmax > Scalar(0.0) && rmax != m_cl_width)
+            {
+            m_cl->setNominalWidth(rmax);
+            m_cl_width = rmax;
+            }
+        m_cl->compute(timestep);
+        }
+    else
+        {
+        // start by updating the neighborlist
+        this->m_nlist->compute(timestep);
+        }
+    //~
+
+    //~ add ghost update overlap [RHEOINF]
+    // if the interior pairs were computed during the ghost update with the same list, only the
+    // remaining particles are left
+    const bool overlapped = m_overlap_active && m_overlap_step == timestep && !cell_list
+                            && this->m_nlist->getBuildCount() == m_overlap_build_count;
+    m_overlap_active = false;
+    if (overlapped)
+        computePairs(timestep, m_overlap_next, this->m_pdata->getN(), true);
+    else
+        computePairs(timestep, 0, this->m_pdata->getN(), false);
+    }
+
+/*! \param timestep Current time step
+    \param first First particle (or entry of the interior order) to compute
+    \param last One past the last particle (or entry of the interior order) to compute
+    \param ordered True if particles are taken from NeighborList::getInteriorOrder()
+
+    The force arrays are zeroed when \a first is 0, and the per-step bond tracking runs once
+    \a last reaches the number of local particles.
+*/
+template<class evaluator>
+void PotentialPairDPDThermo<evaluator>::computePairs(uint64_t timestep,
+                                                     unsigned int first,
+                                                     unsigned int last,
+                                                     bool ordered)
+    {
+    const bool cell_list = m_cell_list_mode && !ordered;
+    const bool zero_forces = (first == 0);
+    const bool last_pass = (last == this->m_pdata->getN());
+
+    std::unique_ptr<ArrayHandle<unsigned int>> h_order;
+    if (ordered)
+        {
+        h_order.reset(new ArrayHandle<unsigned int>(this->m_nlist->getInteriorOrder(),
+                                                    access_location::host,
+                                                    access_mode::read));
+        }
+    //~
 
     // depending on the neighborlist settings, we can take advantage of newton's third law
     // to reduce computations at the cost of memory access complexity: set that flag now
-    bool third_law = this->m_nlist->getStorageMode() == NeighborList::half;
+    bool third_law = cell_list || this->m_nlist->getStorageMode() == NeighborList::half; //~ cell list mode finds each pair once [RHEOINF]
 
     // access the neighbor list, particle data, and system box
     ArrayHandle<unsigned int> h_n_neigh(this->m_nlist->getNNeighArray(),
@@ -148,6 +430,43 @@ template<class evaluator> void PotentialPairDPDThermo<evaluator>::computeForces(
     ArrayHandle<size_t> h_head_list(this->m_nlist->getHeadList(),
                                     access_location::host,
                                     access_mode::read);
+    //~ read the delta encoded copy of the neighbor list when it is enabled [RHEOINF]
+    const bool compressed = this->m_nlist->getCompressed();
+    ArrayHandle<uint16_t> h_nlist_compressed(this->m_nlist->getNListCompressedArray(),
+                                             access_location::host,
+                                             access_mode::read);
+    ArrayHandle<size_t> h_head_list_compressed(this->m_nlist->getHeadListCompressed(),
+                                               access_location::host,
+                                               access_mode::read);
+    //~
+
+    //~ access the cell list in cell list mode [RHEOINF]
+    std::unique_ptr<ArrayHandle<unsigned int>> h_cell_size;
+    std::unique_ptr<ArrayHandle<Scalar4>> h_cell_xyzf;
+    std::unique_ptr<ArrayHandle<unsigned int>> h_cell_adj;
+    Index3D ci;
+    Index2D cli;
+    Index2D cadji;
+    uint3 cl_dim = make_uint3(0, 0, 0);
+    Scalar3 cl_ghost_width = make_scalar3(0, 0, 0);
+    if (cell_list)
+        {
+        h_cell_size.reset(new ArrayHandle<unsigned int>(m_cl->getCellSizeArray(),
+                                                        access_location::host,
+                                                        access_mode::read));
+        h_cell_xyzf.reset(new ArrayHandle<Scalar4>(m_cl->getXYZFArray(),
+                                                   access_location::host,
+                                                   access_mode::read));
+        h_cell_adj.reset(new ArrayHandle<unsigned int>(m_cl->getCellAdjArray(),
+                                                       access_location::host,
+                                                       access_mode::read));
+        ci = m_cl->getCellIndexer();
+        cli = m_cl->getCellListIndexer();
+        cadji = m_cl->getCellAdjIndexer();
+        cl_dim = m_cl->getDim();
+        cl_ghost_width = m_cl->getGhostWidth();
+        }
+    //~
 
     ArrayHandle<Scalar4> h_pos(this->m_pdata->getPositions(),
                                access_location::host,
@@ -171,10 +490,12 @@ template<class evaluator> void PotentialPairDPDThermo<evaluator>::computeForces(
     //~
 
     // force arrays
-    ArrayHandle<Scalar4> h_force(this->m_force, access_location::host, access_mode::overwrite);
-    ArrayHandle<Scalar> h_virial(this->m_virial, access_location::host, access_mode::overwrite);
+    //~ later slices of an overlapped step add to the forces of the earlier ones [RHEOINF]
+    const access_mode::Enum force_mode = zero_forces ? access_mode::overwrite : access_mode::readwrite;
+    ArrayHandle<Scalar4> h_force(this->m_force, access_location::host, force_mode);
+    ArrayHandle<Scalar> h_virial(this->m_virial, access_location::host, force_mode);
     //~ add virial_ind [RHEOINF]
-    ArrayHandle<Scalar> h_virial_ind(this->m_virial_ind, access_location::host, access_mode::overwrite);
+    ArrayHandle<Scalar> h_virial_ind(this->m_virial_ind, access_location::host, force_mode);
     //~
 
     const BoxDim box = this->m_pdata->getBox();
@@ -187,17 +508,23 @@ template<class evaluator> void PotentialPairDPDThermo<evaluator>::computeForces(
     ArrayHandle<Scalar> h_rcutsq(this->m_rcutsq, access_location::host, access_mode::read);
 
     // need to start from a zero force, energy and virial
-    memset((void*)h_force.data, 0, sizeof(Scalar4) * this->m_force.getNumElements());
-    memset((void*)h_virial.data, 0, sizeof(Scalar) * this->m_virial.getNumElements());
-    //~ add virial_ind [RHEOINF] 
-    memset((void*)h_virial_ind.data, 0, sizeof(Scalar) * this->m_virial_ind.getNumElements());
-    //~
+    if (zero_forces) //~ only on the first slice [RHEOINF]
+        {
+        memset((void*)h_force.data, 0, sizeof(Scalar4) * this->m_force.getNumElements());
+        memset((void*)h_virial.data, 0, sizeof(Scalar) * this->m_virial.getNumElements());
+        //~ add virial_ind [RHEOINF]
+        memset((void*)h_virial_ind.data, 0, sizeof(Scalar) * this->m_virial_ind.getNumElements());
+        //~
+        }
 
     uint16_t seed = this->m_sysdef->getSeed();
 
     // for each particle
-    for (int i = 0; i < (int)this->m_pdata->getN(); i++)
+    /*for (int i = 0; i < (int)this->m_pdata->getN(); i++)*/
+    for (unsigned int ii = first; ii < last; ii++) //~ loop over a slice [RHEOINF]
         {
+        const int i = ordered ? (int)h_order->data[ii] : (int)ii; //~ [RHEOINF]
+
         // access the particle's position, velocity, and type (MEM TRANSFER: 7 scalars)
         Scalar3 pi = make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
         Scalar3 vi = make_scalar3(h_vel.data[i].x, h_vel.data[i].y, h_vel.data[i].z);
@@ -220,12 +547,61 @@ template<class evaluator> void PotentialPairDPDThermo<evaluator>::computeForces(
             viriali_ind[l] = 0.0;
         //~
 
+        //~ in cell list mode, collect the neighbors j > i of this particle from the 27 cells around it [RHEOINF]
+        if (cell_list)
+            {
+            m_cl_neigh.clear();
+
+            Scalar3 f = box.makeFraction(pi, cl_ghost_width);
+            int ib = (int)(f.x * cl_dim.x);
+            int jb = (int)(f.y * cl_dim.y);
+            int kb = (int)(f.z * cl_dim.z);
+
+            // need to handle the case where the particle is exactly at the box hi
+            if (ib == (int)cl_dim.x && per_.x)
+                ib = 0;
+            if (jb == (int)cl_dim.y && per_.y)
+                jb = 0;
+            if (kb == (int)cl_dim.z && per_.z)
+                kb = 0;
+
+            unsigned int my_cell = ci(ib, jb, kb);
+            for (unsigned int cur_adj = 0; cur_adj < cadji.getW(); cur_adj++)
+                {
+                unsigned int neigh_cell = h_cell_adj->data[cadji(cur_adj, my_cell)];
+                unsigned int cell_size = h_cell_size->data[neigh_cell];
+                for (unsigned int cur_offset = 0; cur_offset < cell_size; cur_offset++)
+                    {
+                    const Scalar4& cur_xyzf = h_cell_xyzf->data[cli(cur_offset, neigh_cell)];
+                    unsigned int cur_neigh = __scalar_as_int(cur_xyzf.w);
+                    if (cur_neigh <= (unsigned int)i)
+                        continue;
+
+                    unsigned int cur_neigh_type = __scalar_as_int(h_pos.data[cur_neigh].w);
+                    Scalar3 dx = box.minImage(pi - make_scalar3(cur_xyzf.x, cur_xyzf.y, cur_xyzf.z));
+                    if (dot(dx, dx) < h_rcutsq.data[this->m_typpair_idx(typei, cur_neigh_type)])
+                        m_cl_neigh.push_back(cur_neigh);
+                    }
+                }
+            }
+        //~
+
         // loop over all of the neighbors of this particle
-        const unsigned int size = (unsigned int)h_n_neigh.data[i];
+        /*const unsigned int size = (unsigned int)h_n_neigh.data[i];*/
+        const unsigned int size = cell_list ? (unsigned int)m_cl_neigh.size()
+                                            : (unsigned int)h_n_neigh.data[i]; //~ add cell list mode [RHEOINF]
+        //~ add compressed nlist storage [RHEOINF]
+        detail::NeighborListDecoder decoder(
+            compressed ? h_nlist_compressed.data + h_head_list_compressed.data[i] : nullptr,
+            i);
+        //~
         for (unsigned int k = 0; k < size; k++)
             {
             // access the index of this neighbor (MEM TRANSFER: 1 scalar)
-            unsigned int j = h_nlist.data[head_i + k];
+            /*unsigned int j = compressed ? decoder.next() : h_nlist.data[head_i + k];*/
+            unsigned int j = cell_list    ? m_cl_neigh[k]
+                             : compressed ? decoder.next()
+                                          : h_nlist.data[head_i + k]; //~ add compressed nlist and cell list mode [RHEOINF]
             assert(j < this->m_pdata->getN() + this->m_pdata->getNGhosts());
 
             // calculate dr_ji (MEM TRANSFER: 3 scalars / FLOPS: 3)
@@ -415,7 +791,7 @@ template<class evaluator> void PotentialPairDPDThermo<evaluator>::computeForces(
         }
 
     //~ add bond_calc [RHEOINF] 
-    if(m_bond_calc)
+    if(m_bond_calc && last_pass) //~ once all slices are done [RHEOINF]
 	{
     	this->LTIME->updatebondtime(timestep);
     	if(timestep%10000 == 0) // assumes the recording period is 10000
@@ -427,6 +803,38 @@ template<class evaluator> void PotentialPairDPDThermo<evaluator>::computeForces(
 
     }
 
+//~ add checkpoint state [RHEOINF]
+template<class evaluator>
+void PotentialPairDPDThermo<evaluator>::writeCheckpointState(
+    hoomd::detail::CheckpointBuffer& buf)
+    {
+    PotentialPair<evaluator>::writeCheckpointState(buf);
+    buf.write((uint8_t)(m_bond_calc && this->LTIME));
+    if (m_bond_calc && this->LTIME)
+        this->LTIME->writeCheckpointState(buf);
+    }
+
+/*! The bond lifetimes are distributed over the ranks by pair index, so they are restored with
+    and without domain decomposition.
+*/
+template<class evaluator>
+void PotentialPairDPDThermo<evaluator>::readCheckpointState(
+    hoomd::detail::CheckpointBuffer& buf)
+    {
+    PotentialPair<evaluator>::readCheckpointState(buf);
+    uint8_t has_lifetime;
+    buf.read(has_lifetime);
+    if (has_lifetime)
+        {
+        if (!(m_bond_calc && this->LTIME))
+            {
+            throw std::runtime_error("Checkpoint holds bond lifetimes, but bond_calc is not set.");
+            }
+        this->LTIME->readCheckpointState(buf);
+        }
+    }
+//~
+
 #ifdef ENABLE_MPI
 /*! \param timestep Current time step
  */
@@ -463,6 +871,14 @@ template<class T> void export_PotentialPairDPDThermo(pybind11::module& m, const
         .def(pybind11::init<std::shared_ptr<SystemDefinition>, std::shared_ptr<NeighborList>, bool>()) //~ add bool for bond_calc [RHEOINF]
         .def_property("bond_calc",  
 		&PotentialPairDPDThermo<T>::getBondCalcEnabled, &PotentialPairDPDThermo<T>::setBondCalcEnabled)  //~ add bond_calc [RHEOINF]
+        .def_property("cell_list",
+                      &PotentialPairDPDThermo<T>::getCellListMode,
+                      &PotentialPairDPDThermo<T>::setCellListMode) //~ add cell list pair evaluation [RHEOINF]
+        .def_property("overlap_comm",
+                      &PotentialPairDPDThermo<T>::getOverlapComm,
+                      &PotentialPairDPDThermo<T>::setOverlapComm) //~ add ghost update overlap [RHEOINF]
+        .def_property_readonly("overlap_interior_count",
+                               &PotentialPairDPDThermo<T>::getOverlapInteriorCount) //~ [RHEOINF]
         .def_property("kT", &PotentialPairDPDThermo<T>::getT, &PotentialPairDPDThermo<T>::setT);
     }
 
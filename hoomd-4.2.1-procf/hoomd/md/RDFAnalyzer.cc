@@ -0,0 +1,449 @@
+//~ ########## Created by the Rheoinformatic research group ##########
+//~ HOOMD-blue:
+// Copyright (c) 2009-2023 The Regents of the University of Michigan.
+// Part of HOOMD-blue, released under the BSD 3-Clause License.
+//~
+//~ This file:
+//~ Written by the Rheoinformatic research group (2026)
+
+// ########## Created by Rheoinformatic //~ [RHEOINF] ##########
+
+/*! \file RDFAnalyzer.cc
+    \brief Defines the RDFAnalyzer class
+*/
+
+#include "RDFAnalyzer.h"
+
+#include <algorithm>
+#include <pybind11/stl.h>
+#include <stdexcept>
+
+using namespace std;
+
+namespace hoomd
+    {
+namespace md
+    {
+/*! \param sysdef System definition
+    \param trigger Select the timesteps to accumulate
+    \param r_min Lower edge of the first bin
+    \param r_max Upper edge of the last bin
+    \param bins Number of bins
+    \param surface Set to true to bin in h_ij = r_ij - (d_i + d_j)/2
+    \param nlist Neighbor list to take the pairs from, or null to use an own cell list
+    \param types Indices of the selected types (all types when empty)
+*/
+RDFAnalyzer::RDFAnalyzer(std::shared_ptr<SystemDefinition> sysdef,
+                         std::shared_ptr<Trigger> trigger,
+                         Scalar r_min,
+                         Scalar r_max,
+                         unsigned int bins,
+                         bool surface,
+                         std::shared_ptr<NeighborList> nlist,
+                         const std::vector<unsigned int>& types)
+    : NeighborListPairAnalyzer(sysdef, trigger, nlist, types, "RDF", surface), m_r_min(r_min),
+      m_r_max(r_max), m_bins(bins), m_surface(surface), m_pair_idx(m_pdata->getNTypes()),
+      m_n_frames(0)
+    {
+    m_exec_conf->msg->notice(5) << "Constructing RDFAnalyzer" << endl;
+
+    if (m_bins == 0)
+        {
+        throw runtime_error("RDF: bins must be positive.");
+        }
+    if (!(m_r_max > m_r_min))
+        {
+        throw runtime_error("RDF: r_max must be larger than r_min.");
+        }
+    if (!m_surface && m_r_min < Scalar(0.0))
+        {
+        throw runtime_error("RDF: r_min cannot be negative without surface binning.");
+        }
+    m_dr = (m_r_max - m_r_min) / Scalar(m_bins);
+
+    // shell volume of each bin, for r binning
+    const bool twod = m_sysdef->getNDimensions() == 2;
+    m_shell_volume.resize(m_bins);
+    for (unsigned int b = 0; b < m_bins; b++)
+        {
+        double r_lo = m_r_min + b * m_dr;
+        double r_hi = r_lo + m_dr;
+        m_shell_volume[b] = twod ? M_PI * (r_hi * r_hi - r_lo * r_lo)
+                                 : 4.0 / 3.0 * M_PI * (r_hi * r_hi * r_hi - r_lo * r_lo * r_lo);
+        }
+
+    const size_t n_values = size_t(m_pair_idx.getNumElements()) * m_bins;
+    m_frame_counts.resize(n_values);
+    m_frame_g.resize(n_values);
+    m_counts.assign(n_values, 0.0);
+    m_g.assign(n_values, 0.0);
+
+    if (!m_nlist)
+        {
+        m_cl = std::make_shared<CellList>(m_sysdef);
+        m_cl->setRadius(1);
+        m_cl->setComputeXYZF(true);
+        m_cl->setComputeTypeBody(false);
+        m_cl->setFlagIndex();
+        }
+
+    updateSearchRange();
+
+#ifdef ENABLE_MPI
+    if (m_comm && !m_nlist)
+        {
+        m_comm->getGhostLayerWidthRequestSignal()
+            .connect<RDFAnalyzer, &RDFAnalyzer::getGhostLayerWidth>(this);
+        }
+#endif
+    }
+
+RDFAnalyzer::~RDFAnalyzer()
+    {
+    m_exec_conf->msg->notice(5) << "Destroying RDFAnalyzer" << endl;
+
+#ifdef ENABLE_MPI
+    if (m_comm && !m_nlist)
+        {
+        m_comm->getGhostLayerWidthRequestSignal()
+            .disconnect<RDFAnalyzer, &RDFAnalyzer::getGhostLayerWidth>(this);
+        }
+#endif
+    }
+
+/*! The search range is r_max, plus the largest diameter in surface mode (h_ij < r_max implies
+    r_ij < r_max + d_max). It is set on construction and extended if the diameters grow.
+*/
+void RDFAnalyzer::updateSearchRange()
+    {
+    Scalar r_search = m_r_max;
+    if (m_surface)
+        r_search += m_pdata->getMaxDiameter();
+
+    if (extendSearchRange(r_search) && m_cl)
+        m_cl->setNominalWidth(m_r_search);
+    }
+
+#ifdef ENABLE_MPI
+/*! \param type Particle type
+ */
+Scalar RDFAnalyzer::getGhostLayerWidth(unsigned int type)
+    {
+    return m_r_search;
+    }
+#endif
+
+/*! \param pair Index of the type pair
+    \param r Center-center distance
+    \param sigma Contact distance (d_i + d_j)/2
+    \param weight 1 for a pair counted once, 1/2 for a pair counted from both particles
+*/
+inline void RDFAnalyzer::binPair(unsigned int pair, Scalar r, Scalar sigma, double weight)
+    {
+    const Scalar x = m_surface ? r - sigma : r;
+    if (x < m_r_min || x >= m_r_max)
+        return;
+
+    unsigned int b = (unsigned int)((x - m_r_min) / m_dr);
+    if (b >= m_bins)
+        b = m_bins - 1;
+
+    const size_t k = size_t(pair) * m_bins + b;
+    m_frame_counts[k] += weight;
+    if (!m_surface)
+        {
+        m_frame_g[k] += weight / m_shell_volume[b];
+        }
+    else if (r > Scalar(0.0))
+        {
+        double shell = m_sysdef->getNDimensions() == 2 ? 2.0 * M_PI * r * m_dr
+                                                       : 4.0 * M_PI * r * r * m_dr;
+        m_frame_g[k] += weight / shell;
+        }
+    }
+
+/*! Half lists hold local-local pairs once and local-ghost pairs on both ranks, full lists hold
+    every pair from both particles.
+*/
+void RDFAnalyzer::accumulateNeighborList(uint64_t timestep)
+    {
+    computeNeighborList(timestep);
+
+    ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar> h_diameter(m_pdata->getDiameters(),
+                                   access_location::host,
+                                   access_mode::read);
+    ArrayHandle<unsigned int> h_n_neigh(m_nlist->getNNeighArray(),
+                                        access_location::host,
+                                        access_mode::read);
+    ArrayHandle<unsigned int> h_nlist(m_nlist->getNListArray(),
+                                      access_location::host,
+                                      access_mode::read);
+    ArrayHandle<size_t> h_head_list(m_nlist->getHeadList(),
+                                    access_location::host,
+                                    access_mode::read);
+
+    const BoxDim& box = m_pdata->getBox();
+    const bool full = m_nlist->getStorageMode() == NeighborList::full;
+    const Scalar r_search_sq = m_r_search * m_r_search;
+    const unsigned int N = m_pdata->getN();
+
+    for (unsigned int i = 0; i < N; i++)
+        {
+        const Scalar3 pos_i = make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
+        const unsigned int type_i = __scalar_as_int(h_pos.data[i].w);
+        if (!m_include[type_i])
+            continue;
+        const size_t head_i = h_head_list.data[i];
+
+        for (unsigned int k = 0; k < h_n_neigh.data[i]; k++)
+            {
+            const unsigned int j = h_nlist.data[head_i + k];
+            Scalar3 dx = pos_i - make_scalar3(h_pos.data[j].x, h_pos.data[j].y, h_pos.data[j].z);
+            dx = box.minImage(dx);
+            const Scalar rsq = dot(dx, dx);
+            if (rsq >= r_search_sq)
+                continue;
+
+            const unsigned int type_j = __scalar_as_int(h_pos.data[j].w);
+            if (!m_include[type_j])
+                continue;
+            const Scalar sigma = m_surface
+                                     ? Scalar(0.5) * (h_diameter.data[i] + h_diameter.data[j])
+                                     : Scalar(0.0);
+            const double weight = (full || j >= N) ? 0.5 : 1.0;
+            binPair(m_pair_idx(type_i, type_j), fast::sqrt(rsq), sigma, weight);
+            }
+        }
+    }
+
+/*! Every pair is found from both particles (or from both ranks), so each counts 1/2.
+ */
+void RDFAnalyzer::accumulateCellList(uint64_t timestep)
+    {
+    m_cl->compute(timestep);
+
+    const uint3 dim = m_cl->getDim();
+    const Scalar3 ghost_width = m_cl->getGhostWidth();
+
+    ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar> h_diameter(m_pdata->getDiameters(),
+                                   access_location::host,
+                                   access_mode::read);
+    ArrayHandle<unsigned int> h_cell_size(m_cl->getCellSizeArray(),
+                                          access_location::host,
+                                          access_mode::read);
+    ArrayHandle<Scalar4> h_cell_xyzf(m_cl->getXYZFArray(),
+                                     access_location::host,
+                                     access_mode::read);
+    ArrayHandle<unsigned int> h_cell_adj(m_cl->getCellAdjArray(),
+                                         access_location::host,
+                                         access_mode::read);
+
+    const BoxDim& box = m_pdata->getBox();
+    const uchar3 periodic = box.getPeriodic();
+    const Index3D ci = m_cl->getCellIndexer();
+    const Index2D cli = m_cl->getCellListIndexer();
+    const Index2D cadji = m_cl->getCellAdjIndexer();
+    const Scalar r_search_sq = m_r_search * m_r_search;
+    const unsigned int N = m_pdata->getN();
+
+    for (unsigned int i = 0; i < N; i++)
+        {
+        const Scalar3 pos_i = make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
+        const unsigned int type_i = __scalar_as_int(h_pos.data[i].w);
+        if (!m_include[type_i])
+            continue;
+
+        // find the bin of particle i, as NeighborListBinned does
+        Scalar3 f = box.makeFraction(pos_i, ghost_width);
+        int ib = (unsigned int)(f.x * dim.x);
+        int jb = (unsigned int)(f.y * dim.y);
+        int kb = (unsigned int)(f.z * dim.z);
+        if (ib == (int)dim.x && periodic.x)
+            ib = 0;
+        if (jb == (int)dim.y && periodic.y)
+            jb = 0;
+        if (kb == (int)dim.z && periodic.z)
+            kb = 0;
+        const unsigned int my_cell = ci(ib, jb, kb);
+
+        for (unsigned int cur_adj = 0; cur_adj < cadji.getW(); cur_adj++)
+            {
+            const unsigned int neigh_cell = h_cell_adj.data[cadji(cur_adj, my_cell)];
+            const unsigned int size = h_cell_size.data[neigh_cell];
+            for (unsigned int cur_offset = 0; cur_offset < size; cur_offset++)
+                {
+                const Scalar4& cur_xyzf = h_cell_xyzf.data[cli(cur_offset, neigh_cell)];
+                const unsigned int j = __scalar_as_int(cur_xyzf.w);
+                if (j == i || !m_include[__scalar_as_int(h_pos.data[j].w)])
+                    continue;
+
+                Scalar3 dx = pos_i - make_scalar3(cur_xyzf.x, cur_xyzf.y, cur_xyzf.z);
+                dx = box.minImage(dx);
+                const Scalar rsq = dot(dx, dx);
+                if (rsq >= r_search_sq)
+                    continue;
+
+                const unsigned int type_j = __scalar_as_int(h_pos.data[j].w);
+                const Scalar sigma = m_surface
+                                         ? Scalar(0.5) * (h_diameter.data[i] + h_diameter.data[j])
+                                         : Scalar(0.0);
+                binPair(m_pair_idx(type_i, type_j), fast::sqrt(rsq), sigma, 0.5);
+                }
+            }
+        }
+    }
+
+/*! \param timestep Current time step of the simulation
+ */
+void RDFAnalyzer::analyze(uint64_t timestep)
+    {
+    Analyzer::analyze(timestep);
+
+    const unsigned int n_types = m_pdata->getNTypes();
+    if (n_types != m_pair_idx.getW())
+        {
+        throw runtime_error("RDF: the number of particle types changed.");
+        }
+
+    updateSearchRange();
+
+    // minimum image pairs only
+    const BoxDim& box = m_pdata->getGlobalBox();
+    const bool twod = m_sysdef->getNDimensions() == 2;
+    const Scalar3 npd = box.getNearestPlaneDistance();
+    if (m_r_search * Scalar(2.0) > npd.x || m_r_search * Scalar(2.0) > npd.y
+        || (!twod && m_r_search * Scalar(2.0) > npd.z))
+        {
+        throw runtime_error("RDF: the search range is larger than half the box.");
+        }
+
+    // number of particles of each type, for the normalization
+    std::vector<unsigned long long> n_type(n_types, 0);
+        {
+        ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(),
+                                   access_location::host,
+                                   access_mode::read);
+        for (unsigned int i = 0; i < m_pdata->getN(); i++)
+            n_type[__scalar_as_int(h_pos.data[i].w)]++;
+        }
+#ifdef ENABLE_MPI
+    if (m_sysdef->isDomainDecomposed())
+        {
+        MPI_Allreduce(MPI_IN_PLACE,
+                      n_type.data(),
+                      n_types,
+                      MPI_UNSIGNED_LONG_LONG,
+                      MPI_SUM,
+                      m_exec_conf->getMPICommunicator());
+        }
+#endif
+
+    std::fill(m_frame_counts.begin(), m_frame_counts.end(), 0.0);
+    std::fill(m_frame_g.begin(), m_frame_g.end(), 0.0);
+    if (m_nlist)
+        accumulateNeighborList(timestep);
+    else
+        accumulateCellList(timestep);
+
+    const double volume = box.getVolume(twod);
+    for (unsigned int a = 0; a < n_types; a++)
+        {
+        for (unsigned int b = a; b < n_types; b++)
+            {
+            const double n_pairs = (a == b) ? 0.5 * double(n_type[a]) * double(n_type[a] - 1)
+                                            : double(n_type[a]) * double(n_type[b]);
+            const double norm = n_pairs > 0.0 ? volume / n_pairs : 0.0;
+            const size_t offset = size_t(m_pair_idx(a, b)) * m_bins;
+            for (unsigned int k = 0; k < m_bins; k++)
+                {
+                m_counts[offset + k] += m_frame_counts[offset + k];
+                m_g[offset + k] += m_frame_g[offset + k] * norm;
+                }
+            }
+        }
+    m_n_frames++;
+    }
+
+void RDFAnalyzer::reset()
+    {
+    std::fill(m_counts.begin(), m_counts.end(), 0.0);
+    std::fill(m_g.begin(), m_g.end(), 0.0);
+    m_n_frames = 0;
+    }
+
+/*! \param local Accumulator of this rank
+
+    All ranks must call this method.
+*/
+pybind11::array_t<double> RDFAnalyzer::reduceHistogram(const std::vector<double>& local)
+    {
+    std::vector<double> total(local);
+#ifdef ENABLE_MPI
+    if (m_sysdef->isDomainDecomposed())
+        {
+        MPI_Allreduce(MPI_IN_PLACE,
+                      total.data(),
+                      (int)total.size(),
+                      MPI_DOUBLE,
+                      MPI_SUM,
+                      m_exec_conf->getMPICommunicator());
+        }
+#endif
+
+    pybind11::array_t<double> result(
+        std::vector<size_t> {(size_t)m_pair_idx.getNumElements(), (size_t)m_bins});
+    double* data = result.mutable_data();
+    const double scale = m_n_frames > 0 ? 1.0 / double(m_n_frames) : 0.0;
+    for (size_t k = 0; k < total.size(); k++)
+        data[k] = total[k] * scale;
+    return result;
+    }
+
+pybind11::array_t<double> RDFAnalyzer::getRDF()
+    {
+    return reduceHistogram(m_g);
+    }
+
+pybind11::array_t<double> RDFAnalyzer::getPairCounts()
+    {
+    return reduceHistogram(m_counts);
+    }
+
+pybind11::array_t<double> RDFAnalyzer::getBinCenters() const
+    {
+    pybind11::array_t<double> result(m_bins);
+    double* data = result.mutable_data();
+    for (unsigned int b = 0; b < m_bins; b++)
+        data[b] = m_r_min + (b + 0.5) * m_dr;
+    return result;
+    }
+
+namespace detail
+    {
+void export_RDFAnalyzer(pybind11::module& m)
+    {
+    pybind11::class_<RDFAnalyzer, Analyzer, std::shared_ptr<RDFAnalyzer>>(m, "RDFAnalyzer")
+        .def(pybind11::init<std::shared_ptr<SystemDefinition>,
+                            std::shared_ptr<Trigger>,
+                            Scalar,
+                            Scalar,
+                            unsigned int,
+                            bool,
+                            std::shared_ptr<NeighborList>,
+                            const std::vector<unsigned int>&>())
+        .def("reset", &RDFAnalyzer::reset)
+        .def("getRDF", &RDFAnalyzer::getRDF)
+        .def("getPairCounts", &RDFAnalyzer::getPairCounts)
+        .def("getBinCenters", &RDFAnalyzer::getBinCenters)
+        .def_property_readonly("n_frames", &RDFAnalyzer::getNFrames)
+        .def_property_readonly("r_min", &RDFAnalyzer::getRMin)
+        .def_property_readonly("r_max", &RDFAnalyzer::getRMax)
+        .def_property_readonly("bins", &RDFAnalyzer::getBins)
+        .def_property_readonly("surface", &RDFAnalyzer::getSurface);
+    }
+
+    } // end namespace detail
+    } // end namespace md
+    } // end namespace hoomd
@@ -0,0 +1,174 @@
+//~ ########## Created by the Rheoinformatic research group ##########
+//~ HOOMD-blue:
+// Copyright (c) 2009-2023 The Regents of the University of Michigan.
+// Part of HOOMD-blue, released under the BSD 3-Clause License.
+//~
+//~ This file:
+//~ Written by the Rheoinformatic research group (2026)
+
+// ########## Created by Rheoinformatic //~ [RHEOINF] ##########
+
+/*! \file RDFAnalyzer.h
+    \brief Declares the RDFAnalyzer class
+
+    RDFAnalyzer accumulates the radial distribution function of every type pair during the
+    simulation, so g(r) no longer has to be computed after the fact from stored frames. Pairs come
+    from a NeighborList shared with a pair force or from the analyzer's own CellList. With surface
+    binning, pairs are binned in the surface-surface distance h_ij = r_ij - (d_i + d_j)/2 instead
+    of r_ij, which is the natural variable for polydisperse colloidal gels.
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include "NeighborListPairAnalyzer.h"
+#include "hoomd/CellList.h"
+#include "hoomd/Index1D.h"
+
+#include <memory>
+#include <pybind11/numpy.h>
+#include <pybind11/pybind11.h>
+#include <vector>
+
+#ifndef __RDF_ANALYZER_H__
+#define __RDF_ANALYZER_H__
+
+namespace hoomd
+    {
+namespace md
+    {
+//! Accumulates the radial distribution function per type pair
+/*! Each call to analyze() adds one frame to the accumulated histograms of every unordered type
+    pair (a, b), a <= b, stored in Index2DUpperTriangular order. Only the pairs of the selected
+    types are counted, the rows of other pairs stay zero. The binned variable x is r_ij, or
+    h_ij = r_ij - (d_i + d_j)/2 in surface mode, in [r_min, r_max).
+
+    Per frame, the pair counts n_ab(x) are normalized as
+        g_ab(x) = V / N_ab * sum_pairs 1 / dV(x)
+    where N_ab = N_a (N_a - 1) / 2 for a == b and N_a N_b otherwise, and dV is the volume of the
+    spherical shell (area of the annulus in 2D) of the bin. In surface mode the shell is taken at
+    the center distance of each pair, dV = 4 pi r_ij^2 dh (2 pi r_ij dh in 2D), because pairs with
+    the same h are at different r for different diameters. g_ab is the mean over the frames.
+
+    Pairs within the search range r_max (r_max plus the largest diameter in surface mode) are
+    found in one of two ways:
+    - with a NeighborList: RDFAnalyzer adds its search range to the neighbor list r_cut matrix
+      (see NeighborListPairAnalyzer), so the list (usually the one a pair force already builds)
+      holds every needed pair. Lists with exclusions are rejected, the excluded pairs would be
+      missing.
+    - without: RDFAnalyzer searches the 27 neighboring cells of its own CellList and requests a
+      ghost layer as wide as the search range.
+
+    Every rank accumulates the pairs of its local particles (pairs with a ghost count 1/2 on both
+    ranks). The histograms are summed over the ranks when they are read.
+
+    \ingroup analyzers
+*/
+class PYBIND11_EXPORT RDFAnalyzer : public NeighborListPairAnalyzer
+    {
+    public:
+    //! Construct the analyzer
+    RDFAnalyzer(std::shared_ptr<SystemDefinition> sysdef,
+                std::shared_ptr<Trigger> trigger,
+                Scalar r_min,
+                Scalar r_max,
+                unsigned int bins,
+                bool surface,
+                std::shared_ptr<NeighborList> nlist,
+                const std::vector<unsigned int>& types);
+
+    //! Destructor
+    virtual ~RDFAnalyzer();
+
+    //! Add the current frame to the histograms
+    virtual void analyze(uint64_t timestep);
+
+    //! Clear the accumulated histograms
+    void reset();
+
+    //! Get the accumulated g(x), shape (number of type pairs, bins)
+    pybind11::array_t<double> getRDF();
+
+    //! Get the mean number of pairs per frame in each bin, shape (number of type pairs, bins)
+    pybind11::array_t<double> getPairCounts();
+
+    //! Get the bin centers
+    pybind11::array_t<double> getBinCenters() const;
+
+    //! Get the number of accumulated frames
+    uint64_t getNFrames() const
+        {
+        return m_n_frames;
+        }
+
+    //! Get the lower edge of the first bin
+    Scalar getRMin() const
+        {
+        return m_r_min;
+        }
+
+    //! Get the upper edge of the last bin
+    Scalar getRMax() const
+        {
+        return m_r_max;
+        }
+
+    //! Get the number of bins
+    unsigned int getBins() const
+        {
+        return m_bins;
+        }
+
+    //! Test if pairs are binned in surface-surface distance
+    bool getSurface() const
+        {
+        return m_surface;
+        }
+
+#ifdef ENABLE_MPI
+    //! Request a ghost layer as wide as the search range (own cell list only)
+    Scalar getGhostLayerWidth(unsigned int type);
+#endif
+
+    private:
+    Scalar m_r_min;                     //!< Lower edge of the first bin
+    Scalar m_r_max;                     //!< Upper edge of the last bin
+    unsigned int m_bins;                //!< Number of bins
+    Scalar m_dr;                        //!< Bin width
+    bool m_surface;                     //!< True to bin in h_ij instead of r_ij
+    std::shared_ptr<CellList> m_cl;     //!< Own cell list (when m_nlist is null)
+    Index2DUpperTriangular m_pair_idx;  //!< Indexes the unordered type pairs
+    std::vector<double> m_shell_volume; //!< Shell volume of each bin (r binning)
+    std::vector<double> m_frame_counts; //!< Local pair counts of the current frame
+    std::vector<double> m_frame_g;      //!< Local pair counts over dV of the frame
+    std::vector<double> m_counts;       //!< Accumulated local pair counts
+    std::vector<double> m_g;            //!< Accumulated local, normalized g(x)
+    uint64_t m_n_frames;                //!< Number of accumulated frames
+
+    //! Set the search range from the bin range and the largest diameter
+    void updateSearchRange();
+
+    //! Accumulate the pairs of the shared neighbor list
+    void accumulateNeighborList(uint64_t timestep);
+
+    //! Accumulate the pairs found in the own cell list
+    void accumulateCellList(uint64_t timestep);
+
+    //! Bin one pair of the current frame
+    inline void binPair(unsigned int pair, Scalar r, Scalar sigma, double weight);
+
+    //! Sum an accumulator over the ranks and divide by the number of frames
+    pybind11::array_t<double> reduceHistogram(const std::vector<double>& local);
+    };
+
+namespace detail
+    {
+//! Export RDFAnalyzer to python
+void export_RDFAnalyzer(pybind11::module& m);
+    } // end namespace detail
+
+    } // end namespace md
+    } // end namespace hoomd
+
+#endif // __RDF_ANALYZER_H__
@@ -0,0 +1,225 @@
+//~ ########## Created by the Rheoinformatic research group ##########
+//~ HOOMD-blue:
+// Copyright (c) 2009-2023 The Regents of the University of Michigan.
+// Part of HOOMD-blue, released under the BSD 3-Clause License.
+//~
+//~ This file:
+//~ Written by the Rheoinformatic research group (2026)
+
+// ########## Created by Rheoinformatic //~ [RHEOINF] ##########
+
+/*! \file SlabProfileAnalyzer.cc
+    \brief Defines the SlabProfileAnalyzer class
+*/
+
+#include "SlabProfileAnalyzer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+using namespace std;
+
+namespace hoomd
+    {
+namespace md
+    {
+// sums of each type and slab in m_frame: n, M, P_x, P_y, P_z, K
+static const unsigned int n_sums = 6;
+
+/*! \param sysdef System definition
+    \param trigger Select the timesteps to accumulate
+    \param bins Number of slabs
+*/
+SlabProfileAnalyzer::SlabProfileAnalyzer(std::shared_ptr<SystemDefinition> sysdef,
+                                         std::shared_ptr<Trigger> trigger,
+                                         unsigned int bins)
+    : Analyzer(sysdef, trigger), m_bins(bins), m_types(0), m_n_frames(0)
+    {
+    m_exec_conf->msg->notice(5) << "Constructing SlabProfileAnalyzer" << endl;
+
+    if (m_exec_conf->isCUDAEnabled())
+        {
+        throw runtime_error("SlabProfile: only the CPU implementation is available.");
+        }
+    if (m_bins == 0)
+        {
+        throw runtime_error("SlabProfile: bins must be positive.");
+        }
+    resize();
+    }
+
+SlabProfileAnalyzer::~SlabProfileAnalyzer()
+    {
+    m_exec_conf->msg->notice(5) << "Destroying SlabProfileAnalyzer" << endl;
+    }
+
+void SlabProfileAnalyzer::resize()
+    {
+    m_types = m_pdata->getNTypes();
+    const size_t n = size_t(m_types) * m_bins;
+    m_frame.assign(n * n_sums, 0.0);
+    m_momentum.assign(n * 3, 0.0);
+    m_mass.assign(n, 0.0);
+    m_density.assign(n, 0.0);
+    m_peculiar.assign(n, 0.0);
+    m_dof.assign(n, 0.0);
+    m_n_frames = 0;
+    }
+
+/*! \param timestep Current time step of the simulation
+ */
+void SlabProfileAnalyzer::analyze(uint64_t timestep)
+    {
+    Analyzer::analyze(timestep);
+
+    if (m_pdata->getNTypes() != m_types)
+        {
+        m_exec_conf->msg->warning()
+            << "SlabProfile: the number of types changed, the profiles are reset." << endl;
+        resize();
+        }
+
+    ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar4> h_vel(m_pdata->getVelocities(), access_location::host, access_mode::read);
+
+    const BoxDim& box = m_pdata->getGlobalBox();
+    std::fill(m_frame.begin(), m_frame.end(), 0.0);
+    for (unsigned int i = 0; i < m_pdata->getN(); i++)
+        {
+        const Scalar4 postype = h_pos.data[i];
+        const Scalar4 velmass = h_vel.data[i];
+        const Scalar3 f = box.makeFraction(make_scalar3(postype.x, postype.y, postype.z));
+        const unsigned int k
+            = std::min((unsigned int)std::max(int(f.y * Scalar(m_bins)), 0), m_bins - 1);
+        const unsigned int type = __scalar_as_int(postype.w);
+
+        const double m = velmass.w;
+        const double vx = velmass.x;
+        const double vy = velmass.y;
+        const double vz = velmass.z;
+        double* sums = &m_frame[(size_t(type) * m_bins + k) * n_sums];
+        sums[0] += 1.0;
+        sums[1] += m;
+        sums[2] += m * vx;
+        sums[3] += m * vy;
+        sums[4] += m * vz;
+        sums[5] += m * (vx * vx + vy * vy + vz * vz);
+        }
+#ifdef ENABLE_MPI
+    if (m_sysdef->isDomainDecomposed())
+        {
+        // the streaming velocity of a slab needs the particles of all ranks
+        MPI_Allreduce(MPI_IN_PLACE,
+                      m_frame.data(),
+                      (int)m_frame.size(),
+                      MPI_DOUBLE,
+                      MPI_SUM,
+                      m_exec_conf->getMPICommunicator());
+        }
+#endif
+
+    const unsigned int dimensions = m_sysdef->getNDimensions();
+    const double slab_volume = box.getVolume(dimensions == 2) / double(m_bins);
+    for (size_t s = 0; s < m_mass.size(); s++)
+        {
+        const double* sums = &m_frame[s * n_sums];
+        const double n = sums[0];
+        const double M = sums[1];
+        m_density[s] += n / slab_volume;
+        if (n == 0.0)
+            continue;
+
+        const double P_sq = sums[2] * sums[2] + sums[3] * sums[3] + sums[4] * sums[4];
+        m_mass[s] += M;
+        for (unsigned int d = 0; d < 3; d++)
+            m_momentum[s * 3 + d] += sums[2 + d];
+        m_peculiar[s] += std::max(sums[5] - P_sq / M, 0.0);
+        m_dof[s] += double(dimensions) * (n - 1.0);
+        }
+    m_n_frames++;
+    }
+
+void SlabProfileAnalyzer::reset()
+    {
+    std::fill(m_momentum.begin(), m_momentum.end(), 0.0);
+    std::fill(m_mass.begin(), m_mass.end(), 0.0);
+    std::fill(m_density.begin(), m_density.end(), 0.0);
+    std::fill(m_peculiar.begin(), m_peculiar.end(), 0.0);
+    std::fill(m_dof.begin(), m_dof.end(), 0.0);
+    m_n_frames = 0;
+    }
+
+pybind11::array_t<double> SlabProfileAnalyzer::getBinCenters() const
+    {
+    const BoxDim& box = m_pdata->getGlobalBox();
+    const double L_y = box.getL().y;
+    const double y_lo = box.getLo().y;
+
+    pybind11::array_t<double> result(m_bins);
+    double* data = result.mutable_data();
+    for (unsigned int k = 0; k < m_bins; k++)
+        data[k] = y_lo + (k + 0.5) * L_y / double(m_bins);
+    return result;
+    }
+
+pybind11::array_t<double> SlabProfileAnalyzer::getVelocity() const
+    {
+    pybind11::array_t<double> result(std::vector<size_t> {m_types, m_bins, 3});
+    double* data = result.mutable_data();
+    for (size_t s = 0; s < m_mass.size(); s++)
+        {
+        for (unsigned int d = 0; d < 3; d++)
+            {
+            data[s * 3 + d] = m_mass[s] > 0.0 ? m_momentum[s * 3 + d] / m_mass[s]
+                                              : std::numeric_limits<double>::quiet_NaN();
+            }
+        }
+    return result;
+    }
+
+pybind11::array_t<double> SlabProfileAnalyzer::getDensity() const
+    {
+    pybind11::array_t<double> result(std::vector<size_t> {m_types, m_bins});
+    double* data = result.mutable_data();
+    const double scale = m_n_frames > 0 ? 1.0 / double(m_n_frames) : 0.0;
+    for (size_t s = 0; s < m_density.size(); s++)
+        data[s] = m_density[s] * scale;
+    return result;
+    }
+
+pybind11::array_t<double> SlabProfileAnalyzer::getTemperature() const
+    {
+    pybind11::array_t<double> result(std::vector<size_t> {m_types, m_bins});
+    double* data = result.mutable_data();
+    for (size_t s = 0; s < m_dof.size(); s++)
+        {
+        data[s] = m_dof[s] > 0.0 ? m_peculiar[s] / m_dof[s]
+                                 : std::numeric_limits<double>::quiet_NaN();
+        }
+    return result;
+    }
+
+namespace detail
+    {
+void export_SlabProfileAnalyzer(pybind11::module& m)
+    {
+    pybind11::class_<SlabProfileAnalyzer, Analyzer, std::shared_ptr<SlabProfileAnalyzer>>(
+        m,
+        "SlabProfileAnalyzer")
+        .def(pybind11::init<std::shared_ptr<SystemDefinition>,
+                            std::shared_ptr<Trigger>,
+                            unsigned int>())
+        .def("reset", &SlabProfileAnalyzer::reset)
+        .def("getBinCenters", &SlabProfileAnalyzer::getBinCenters)
+        .def("getVelocity", &SlabProfileAnalyzer::getVelocity)
+        .def("getDensity", &SlabProfileAnalyzer::getDensity)
+        .def("getTemperature", &SlabProfileAnalyzer::getTemperature)
+        .def_property_readonly("n_frames", &SlabProfileAnalyzer::getNFrames)
+        .def_property_readonly("bins", &SlabProfileAnalyzer::getBins);
+    }
+
+    } // end namespace detail
+    } // end namespace md
+    } // end namespace hoomd
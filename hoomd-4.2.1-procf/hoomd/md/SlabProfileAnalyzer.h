@@ -0,0 +1,121 @@
+//~ ########## Created by the Rheoinformatic research group ##########
+//~ HOOMD-blue:
+// Copyright (c) 2009-2023 The Regents of the University of Michigan.
+// Part of HOOMD-blue, released under the BSD 3-Clause License.
+//~
+//~ This file:
+//~ Written by the Rheoinformatic research group (2026)
+
+// ########## Created by Rheoinformatic //~ [RHEOINF] ##########
+
+/*! \file SlabProfileAnalyzer.h
+    \brief Declares the SlabProfileAnalyzer class
+
+    SlabProfileAnalyzer accumulates the velocity, number density, and peculiar temperature of each
+    type in slabs along the gradient (y) direction during the simulation, so the flow profiles no
+    longer need the velocities of every particle written to the trajectory.
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include "hoomd/Analyzer.h"
+
+#include <memory>
+#include <pybind11/numpy.h>
+#include <pybind11/pybind11.h>
+#include <vector>
+
+#ifndef __SLAB_PROFILE_ANALYZER_H__
+#define __SLAB_PROFILE_ANALYZER_H__
+
+namespace hoomd
+    {
+namespace md
+    {
+//! Accumulates per type profiles across slabs of the box along y
+/*! The box is split into bins slabs of equal thickness along its second lattice vector (planes of
+    constant y for the xy tilt of a sheared box). Each call to analyze() sums, for every type and
+    slab, the number of particles n, their mass M, momentum P, and twice their kinetic energy
+    K = sum m v^2, and reduces the sums over the ranks. The streaming velocity of the slab in that
+    frame is u = P / M, and the peculiar kinetic energy
+
+        K - P^2 / M = sum m (v - u)^2
+
+    has D (n - 1) degrees of freedom in D dimensions, since u is taken from the same particles.
+    Over the frames since the last reset:
+
+    - velocity: sum P / sum M, the mass-weighted mean velocity
+    - density: the mean of n / V_slab
+    - temperature: sum (K - P^2 / M) / sum D (n - 1), in energy units
+
+    \ingroup analyzers
+*/
+class PYBIND11_EXPORT SlabProfileAnalyzer : public Analyzer
+    {
+    public:
+    //! Construct the analyzer
+    SlabProfileAnalyzer(std::shared_ptr<SystemDefinition> sysdef,
+                        std::shared_ptr<Trigger> trigger,
+                        unsigned int bins);
+
+    //! Destructor
+    virtual ~SlabProfileAnalyzer();
+
+    //! Add the profiles of the current frame
+    virtual void analyze(uint64_t timestep);
+
+    //! Clear the accumulated sums
+    void reset();
+
+    //! Get the y coordinates of the slab centers
+    pybind11::array_t<double> getBinCenters() const;
+
+    //! Get the mean velocity of each type in each slab (n_types, bins, 3)
+    pybind11::array_t<double> getVelocity() const;
+
+    //! Get the mean number density of each type in each slab (n_types, bins)
+    pybind11::array_t<double> getDensity() const;
+
+    //! Get the peculiar kinetic temperature of each type in each slab (n_types, bins)
+    pybind11::array_t<double> getTemperature() const;
+
+    //! Get the number of frames accumulated since the last reset
+    uint64_t getNFrames() const
+        {
+        return m_n_frames;
+        }
+
+    //! Get the number of slabs
+    unsigned int getBins() const
+        {
+        return m_bins;
+        }
+
+    private:
+    unsigned int m_bins;  //!< Number of slabs
+    unsigned int m_types; //!< Number of particle types when the sums were sized
+
+    std::vector<double> m_frame;    //!< Sums of the current frame (n, M, P, K) per type and slab
+    std::vector<double> m_momentum; //!< Accumulated momentum per type and slab
+    std::vector<double> m_mass;     //!< Accumulated mass per type and slab
+    std::vector<double> m_density;  //!< Accumulated n / V_slab per type and slab
+    std::vector<double> m_peculiar; //!< Accumulated sum m (v - u)^2 per type and slab
+    std::vector<double> m_dof;      //!< Accumulated degrees of freedom per type and slab
+    uint64_t m_n_frames;            //!< Frames accumulated since the last reset
+
+    //! Resize the accumulators to the number of types
+    void resize();
+    };
+
+namespace detail
+    {
+//! Export SlabProfileAnalyzer to python
+void export_SlabProfileAnalyzer(pybind11::module& m);
+    } // end namespace detail
+
+    } // end namespace md
+    } // end namespace hoomd
+
+#endif // __SLAB_PROFILE_ANALYZER_H__
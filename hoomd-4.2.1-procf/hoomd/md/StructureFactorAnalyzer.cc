@@ -0,0 +1,628 @@
+//~ ########## Created by the Rheoinformatic research group ##########
+//~ HOOMD-blue:
+// Copyright (c) 2009-2023 The Regents of the University of Michigan.
+// Part of HOOMD-blue, released under the BSD 3-Clause License.
+//~
+//~ This file:
+//~ Written by the Rheoinformatic research group (2026)
+
+// ########## Created by Rheoinformatic //~ [RHEOINF] ##########
+
+/*! \file StructureFactorAnalyzer.cc
+    \brief Defines the StructureFactorAnalyzer class
+*/
+
+#include "StructureFactorAnalyzer.h"
+
+#ifdef ENABLE_MPI
+#include "hoomd/Communicator.h"
+#endif
+
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <pybind11/stl.h>
+#include <sstream>
+#include <stdexcept>
+
+using namespace std;
+
+namespace hoomd
+    {
+namespace md
+    {
+/*! \param sysdef System definition
+    \param trigger Select the timesteps to accumulate
+    \param nx Number of mesh points along the first lattice vector
+    \param ny Number of mesh points along the second lattice vector
+    \param nz Number of mesh points along the third lattice vector (1 in 2D)
+    \param bins Number of |q| bins
+    \param q_max Upper edge of the last bin
+    \param types Indices of the selected types (all types when empty)
+*/
+StructureFactorAnalyzer::StructureFactorAnalyzer(std::shared_ptr<SystemDefinition> sysdef,
+                                                 std::shared_ptr<Trigger> trigger,
+                                                 unsigned int nx,
+                                                 unsigned int ny,
+                                                 unsigned int nz,
+                                                 unsigned int bins,
+                                                 Scalar q_max,
+                                                 const std::vector<unsigned int>& types)
+    : Analyzer(sysdef, trigger), m_n_ghost_cells(make_uint3(0, 0, 0)),
+      m_grid_dim(make_uint3(0, 0, 0)), m_n_cells(0), m_n_inner_cells(0), m_ghost_offset(0),
+      m_bins(bins), m_q_max(q_max), m_need_initialize(true), m_box_changed(true),
+      m_kiss_fft_initialized(false),
+#ifdef ENABLE_MPI
+      m_dfft_initialized(false),
+#endif
+      m_n_frames(0)
+    {
+    m_exec_conf->msg->notice(5) << "Constructing StructureFactorAnalyzer" << endl;
+
+    if (m_exec_conf->isCUDAEnabled())
+        {
+        throw runtime_error("StructureFactor: only the CPU implementation is available.");
+        }
+    if (m_bins == 0)
+        {
+        throw runtime_error("StructureFactor: bins must be positive.");
+        }
+    if (!(m_q_max > Scalar(0.0)))
+        {
+        throw runtime_error("StructureFactor: q_max must be positive.");
+        }
+    if (m_sysdef->getNDimensions() == 2)
+        {
+        nz = 1;
+        }
+    if (nx == 0 || ny == 0 || nz == 0)
+        {
+        throw runtime_error("StructureFactor: the number of mesh points must be positive.");
+        }
+
+    m_include.assign(m_pdata->getNTypes(), types.empty());
+    for (unsigned int type : types)
+        {
+        if (type >= m_pdata->getNTypes())
+            {
+            throw runtime_error("StructureFactor: invalid particle type.");
+            }
+        m_include[type] = true;
+        }
+
+    m_global_dim = make_uint3(nx, ny, nz);
+    m_mesh_points = m_global_dim;
+
+#ifdef ENABLE_MPI
+    if (m_pdata->getDomainDecomposition())
+        {
+        const Index3D& didx = m_pdata->getDomainDecomposition()->getDomainIndexer();
+
+        // the distributed FFT needs powers of two, as in PPPMForceCompute
+        auto is_pow2 = [](unsigned int n) { return n && !(n & (n - 1)); };
+        if (!is_pow2(nx) || !is_pow2(ny) || !is_pow2(nz))
+            {
+            throw runtime_error("StructureFactor: the number of mesh points along every "
+                                "direction must be a power of two with MPI.");
+            }
+        if (nx % didx.getW() || ny % didx.getH() || nz % didx.getD())
+            {
+            ostringstream s;
+            s << "StructureFactor: the mesh (" << nx << ", " << ny << ", " << nz
+              << ") is not a multiple of the processor grid (" << didx.getW() << ", "
+              << didx.getH() << ", " << didx.getD() << ").";
+            throw runtime_error(s.str());
+            }
+
+        m_mesh_points.x /= didx.getW();
+        m_mesh_points.y /= didx.getH();
+        m_mesh_points.z /= didx.getD();
+        }
+#endif
+
+    m_sum_S.assign(m_bins, 0.0);
+    m_count.assign(m_bins, 0.0);
+
+    m_pdata->getBoxChangeSignal()
+        .connect<StructureFactorAnalyzer, &StructureFactorAnalyzer::slotBoxChanged>(this);
+    }
+
+StructureFactorAnalyzer::~StructureFactorAnalyzer()
+    {
+    m_exec_conf->msg->notice(5) << "Destroying StructureFactorAnalyzer" << endl;
+
+    if (m_kiss_fft_initialized)
+        {
+        kiss_fft_free(m_kiss_fft);
+        }
+#ifdef ENABLE_MPI
+    if (m_dfft_initialized)
+        {
+        dfft_destroy_plan(m_dfft_plan_forward);
+        }
+#endif
+    m_pdata->getBoxChangeSignal()
+        .disconnect<StructureFactorAnalyzer, &StructureFactorAnalyzer::slotBoxChanged>(this);
+    }
+
+/*! Particles leave their domain by at most half the neighbor list buffer between migrations, which
+    is less than half the ghost layer. The cloud-in-cell scheme adds one more cell.
+*/
+uint3 StructureFactorAnalyzer::computeGhostCellNum()
+    {
+    uint3 n_ghost_cells = make_uint3(0, 0, 0);
+#ifdef ENABLE_MPI
+    if (m_sysdef->isDomainDecomposed())
+        {
+        Index3D di = m_pdata->getDomainDecomposition()->getDomainIndexer();
+        Scalar r_out = Scalar(0.0);
+        auto comm = m_sysdef->getCommunicator().lock();
+        if (comm)
+            {
+            r_out = Scalar(0.5) * comm->getGhostLayerMaxWidth();
+            }
+
+        const BoxDim& box = m_pdata->getBox();
+        Scalar3 cell_width = box.getNearestPlaneDistance()
+                             / make_scalar3(m_mesh_points.x, m_mesh_points.y, m_mesh_points.z);
+        if (di.getW() > 1)
+            n_ghost_cells.x = 1 + (unsigned int)(r_out / cell_width.x) + 1;
+        if (di.getH() > 1)
+            n_ghost_cells.y = 1 + (unsigned int)(r_out / cell_width.y) + 1;
+        if (di.getD() > 1)
+            n_ghost_cells.z = 1 + (unsigned int)(r_out / cell_width.z) + 1;
+
+        if (n_ghost_cells.x > m_mesh_points.x || n_ghost_cells.y > m_mesh_points.y
+            || n_ghost_cells.z > m_mesh_points.z)
+            {
+            throw runtime_error("StructureFactor: the ghost layer is wider than the local mesh, "
+                                "use fewer ranks or more mesh points.");
+            }
+        }
+#endif
+    return n_ghost_cells;
+    }
+
+void StructureFactorAnalyzer::setupMesh()
+    {
+    m_n_ghost_cells = computeGhostCellNum();
+    m_grid_dim = make_uint3(m_mesh_points.x + 2 * m_n_ghost_cells.x,
+                            m_mesh_points.y + 2 * m_n_ghost_cells.y,
+                            m_mesh_points.z + 2 * m_n_ghost_cells.z);
+    m_n_cells = m_grid_dim.x * m_grid_dim.y * m_grid_dim.z;
+    m_n_inner_cells = m_mesh_points.x * m_mesh_points.y * m_mesh_points.z;
+    m_ghost_offset = 0;
+
+    bool local_fft = true;
+#ifdef ENABLE_MPI
+    local_fft = !m_pdata->getDomainDecomposition();
+
+    if (!local_fft)
+        {
+        m_grid_comm = std::unique_ptr<CommunicatorGrid<kiss_fft_cpx>>(
+            new CommunicatorGrid<kiss_fft_cpx>(m_sysdef,
+                                               m_mesh_points,
+                                               m_grid_dim,
+                                               m_n_ghost_cells,
+                                               true));
+
+        // same layout as the distributed FFT of PPPMForceCompute
+        int gdim[3];
+        int pdim[3];
+        Index3D decomp_idx = m_pdata->getDomainDecomposition()->getDomainIndexer();
+        pdim[0] = decomp_idx.getD();
+        pdim[1] = decomp_idx.getH();
+        pdim[2] = decomp_idx.getW();
+        gdim[0] = m_global_dim.z;
+        gdim[1] = m_global_dim.y;
+        gdim[2] = m_global_dim.x;
+        int embed[3];
+        embed[0] = m_grid_dim.z;
+        embed[1] = m_grid_dim.y;
+        embed[2] = m_grid_dim.x;
+        m_ghost_offset
+            = (m_n_ghost_cells.z * embed[1] + m_n_ghost_cells.y) * embed[2] + m_n_ghost_cells.x;
+        uint3 pcoord = m_pdata->getDomainDecomposition()->getGridPos();
+        int pidx[3];
+        pidx[0] = pcoord.z;
+        pidx[1] = pcoord.y;
+        pidx[2] = pcoord.x;
+        int row_m = 0;
+        ArrayHandle<unsigned int> h_cart_ranks(m_pdata->getDomainDecomposition()->getCartRanks(),
+                                               access_location::host,
+                                               access_mode::read);
+        if (m_dfft_initialized)
+            {
+            dfft_destroy_plan(m_dfft_plan_forward);
+            }
+        dfft_create_plan(&m_dfft_plan_forward,
+                         3,
+                         gdim,
+                         embed,
+                         NULL,
+                         pdim,
+                         pidx,
+                         row_m,
+                         0,
+                         1,
+                         m_exec_conf->getMPICommunicator(),
+                         (int*)h_cart_ranks.data);
+        m_dfft_initialized = true;
+        }
+#endif
+
+    if (local_fft && !m_kiss_fft_initialized)
+        {
+        int dims[3];
+        dims[0] = m_mesh_points.z;
+        dims[1] = m_mesh_points.y;
+        dims[2] = m_mesh_points.x;
+        m_kiss_fft = kiss_fftnd_alloc(dims, 3, 0, NULL, NULL);
+        m_kiss_fft_initialized = true;
+        }
+
+    // pad with offset
+    GlobalArray<kiss_fft_cpx> mesh(m_n_cells + m_ghost_offset, m_exec_conf);
+    m_mesh.swap(mesh);
+
+    GlobalArray<kiss_fft_cpx> fourier_mesh(m_n_inner_cells, m_exec_conf);
+    m_fourier_mesh.swap(fourier_mesh);
+
+    m_mode_bin.resize(m_n_inner_cells);
+    m_mode_deconv.resize(m_n_inner_cells);
+    m_mode_shot.resize(m_n_inner_cells);
+    }
+
+/*! The local modes are enumerated as in PPPMForceCompute::computeInfluenceFunction(): row major for
+    the local FFT and cyclic over the processor grid for the distributed FFT.
+*/
+void StructureFactorAnalyzer::computeModes()
+    {
+    const BoxDim& global_box = m_pdata->getGlobalBox();
+    const bool twod = m_sysdef->getNDimensions() == 2;
+
+    // reciprocal lattice vectors
+    Scalar3 a1 = global_box.getLatticeVector(0);
+    Scalar3 a2 = global_box.getLatticeVector(1);
+    Scalar3 a3 = global_box.getLatticeVector(2);
+    Scalar V_box = global_box.getVolume();
+    auto cross = [](Scalar3 a, Scalar3 b)
+    { return make_scalar3(a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x); };
+    Scalar3 b1 = Scalar(2.0 * M_PI) * cross(a2, a3) / V_box;
+    Scalar3 b2 = Scalar(2.0 * M_PI) * cross(a3, a1) / V_box;
+    Scalar3 b3 = Scalar(2.0 * M_PI) * cross(a1, a2) / V_box;
+
+    // all modes with |q| < q_max must lie inside the mesh
+    Scalar3 npd = global_box.getNearestPlaneDistance();
+    Scalar q_nyquist = Scalar(M_PI) * std::min(m_global_dim.x / npd.x, m_global_dim.y / npd.y);
+    if (!twod)
+        {
+        q_nyquist = std::min(q_nyquist, Scalar(M_PI) * m_global_dim.z / npd.z);
+        }
+    if (m_q_max > q_nyquist)
+        {
+        ostringstream s;
+        s << "StructureFactor: q_max (" << m_q_max << ") exceeds the Nyquist wave number ("
+          << q_nyquist << ") of the mesh.";
+        throw runtime_error(s.str());
+        }
+
+    bool local_fft = true;
+    uint3 pdim = make_uint3(1, 1, 1);
+    uint3 pidx = make_uint3(0, 0, 0);
+#ifdef ENABLE_MPI
+    local_fft = m_kiss_fft_initialized;
+    if (m_pdata->getDomainDecomposition())
+        {
+        const Index3D& didx = m_pdata->getDomainDecomposition()->getDomainIndexer();
+        pidx = m_pdata->getDomainDecomposition()->getGridPos();
+        pdim = make_uint3(didx.getW(), didx.getH(), didx.getD());
+        }
+#endif
+
+    auto sinc = [](Scalar x) { return x == Scalar(0.0) ? Scalar(1.0) : sin(x) / x; };
+    const Scalar dq = m_q_max / Scalar(m_bins);
+
+    for (unsigned int cell_idx = 0; cell_idx < m_n_inner_cells; ++cell_idx)
+        {
+        uint3 wave_idx;
+        unsigned int n_local = cell_idx / (m_mesh_points.y * m_mesh_points.x);
+        unsigned int m_local = (cell_idx / m_mesh_points.x) % m_mesh_points.y;
+        unsigned int l_local = cell_idx % m_mesh_points.x;
+        if (local_fft)
+            {
+            wave_idx = make_uint3(l_local, m_local, n_local);
+            }
+        else
+            {
+            // cyclic distribution
+            wave_idx = make_uint3(l_local * pdim.x + pidx.x,
+                                  m_local * pdim.y + pidx.y,
+                                  n_local * pdim.z + pidx.z);
+            }
+
+        // Miller indices
+        int3 n = make_int3(wave_idx.x, wave_idx.y, wave_idx.z);
+        if (n.x >= (int)(m_global_dim.x / 2 + m_global_dim.x % 2))
+            n.x -= (int)m_global_dim.x;
+        if (n.y >= (int)(m_global_dim.y / 2 + m_global_dim.y % 2))
+            n.y -= (int)m_global_dim.y;
+        if (n.z >= (int)(m_global_dim.z / 2 + m_global_dim.z % 2))
+            n.z -= (int)m_global_dim.z;
+
+        Scalar3 q = (Scalar)n.x * b1 + (Scalar)n.y * b2 + (Scalar)n.z * b3;
+        Scalar q_len = sqrt(dot(q, q));
+
+        m_mode_bin[cell_idx] = -1;
+        if ((n.x != 0 || n.y != 0 || n.z != 0) && q_len < m_q_max)
+            {
+            m_mode_bin[cell_idx] = std::min(int(q_len / dq), int(m_bins) - 1);
+            }
+
+        // cloud-in-cell window W = prod_d sinc^2(pi n_d / N_d), and the aliased shot noise
+        // C = prod_d (1 - 2/3 sin^2(pi n_d / N_d)) of uncorrelated positions (Jing 2005)
+        const Scalar s[3] = {Scalar(M_PI) * n.x / m_global_dim.x,
+                             Scalar(M_PI) * n.y / m_global_dim.y,
+                             Scalar(M_PI) * n.z / m_global_dim.z};
+        Scalar W = Scalar(1.0);
+        Scalar C = Scalar(1.0);
+        for (unsigned int d = 0; d < 3; d++)
+            {
+            W *= sinc(s[d]) * sinc(s[d]);
+            C *= Scalar(1.0) - Scalar(2.0 / 3.0) * sin(s[d]) * sin(s[d]);
+            }
+        m_mode_deconv[cell_idx] = Scalar(1.0) / (W * W);
+        m_mode_shot[cell_idx] = C;
+        }
+    }
+
+/*! The mesh points sit at the fractional coordinates i / N_d of the global box. Each particle adds
+    the weights (1 - w) and w of the cloud-in-cell scheme to the two nearest points along each
+    direction, so the mesh sums to the number of particles.
+*/
+unsigned int StructureFactorAnalyzer::assignParticles()
+    {
+    ArrayHandle<Scalar4> h_postype(m_pdata->getPositions(),
+                                   access_location::host,
+                                   access_mode::read);
+    ArrayHandle<kiss_fft_cpx> h_mesh(m_mesh, access_location::host, access_mode::overwrite);
+
+    const BoxDim& box = m_pdata->getBox();
+    memset(h_mesh.data, 0, sizeof(kiss_fft_cpx) * m_mesh.getNumElements());
+
+    const unsigned int grid[3] = {m_grid_dim.x, m_grid_dim.y, m_grid_dim.z};
+    const unsigned int points[3] = {m_mesh_points.x, m_mesh_points.y, m_mesh_points.z};
+    const unsigned int ghost[3] = {m_n_ghost_cells.x, m_n_ghost_cells.y, m_n_ghost_cells.z};
+
+    unsigned int n_assigned = 0;
+    for (unsigned int i = 0; i < m_pdata->getN(); i++)
+        {
+        Scalar4 postype = h_postype.data[i];
+        if (!m_include[__scalar_as_int(postype.w)])
+            continue;
+
+        // fractional coordinates of the local box, in units of the mesh spacing
+        Scalar3 f = box.makeFraction(make_scalar3(postype.x, postype.y, postype.z));
+        const Scalar reduced[3] = {f.x * points[0] + ghost[0],
+                                   f.y * points[1] + ghost[1],
+                                   f.z * points[2] + ghost[2]};
+
+        int idx[3][2];
+        Scalar weight[3][2];
+        bool inside = true;
+        for (unsigned int d = 0; d < 3; d++)
+            {
+            int i0 = int(floor(reduced[d]));
+            Scalar w = reduced[d] - Scalar(i0);
+            int i1 = i0 + 1;
+            if (!ghost[d])
+                {
+                // periodic direction of the local mesh
+                i0 = ((i0 % int(grid[d])) + int(grid[d])) % int(grid[d]);
+                i1 = (i0 + 1) % int(grid[d]);
+                }
+            if (i0 < 0 || i1 >= int(grid[d]))
+                {
+                inside = false;
+                }
+            idx[d][0] = i0;
+            idx[d][1] = i1;
+            weight[d][0] = Scalar(1.0) - w;
+            weight[d][1] = w;
+            }
+        if (!inside)
+            {
+            // outside the ghost layer, an error is thrown elsewhere (in Communicator)
+            continue;
+            }
+
+        for (unsigned int a = 0; a < 2; a++)
+            for (unsigned int b = 0; b < 2; b++)
+                for (unsigned int c = 0; c < 2; c++)
+                    {
+                    // store in row major order
+                    unsigned int cell
+                        = idx[0][a] + grid[0] * (idx[1][b] + grid[1] * idx[2][c]);
+                    h_mesh.data[cell].r += float(weight[0][a] * weight[1][b] * weight[2][c]);
+                    }
+        n_assigned++;
+        }
+
+    return n_assigned;
+    }
+
+/*! \param timestep Current time step of the simulation
+ */
+void StructureFactorAnalyzer::analyze(uint64_t timestep)
+    {
+    Analyzer::analyze(timestep);
+
+    if (m_need_initialize)
+        {
+        setupMesh();
+        m_need_initialize = false;
+        m_box_changed = true;
+        }
+    else
+        {
+        uint3 n_ghost_cells = computeGhostCellNum();
+        if (n_ghost_cells.x != m_n_ghost_cells.x || n_ghost_cells.y != m_n_ghost_cells.y
+            || n_ghost_cells.z != m_n_ghost_cells.z)
+            {
+            setupMesh();
+            m_box_changed = true;
+            }
+        }
+    if (m_box_changed)
+        {
+        computeModes();
+        m_box_changed = false;
+        }
+
+    unsigned int n_particles = assignParticles();
+
+    if (m_kiss_fft_initialized)
+        {
+        ArrayHandle<kiss_fft_cpx> h_mesh(m_mesh, access_location::host, access_mode::read);
+        ArrayHandle<kiss_fft_cpx> h_fourier_mesh(m_fourier_mesh,
+                                                 access_location::host,
+                                                 access_mode::overwrite);
+        kiss_fftnd(m_kiss_fft, h_mesh.data, h_fourier_mesh.data);
+        }
+
+#ifdef ENABLE_MPI
+    if (m_pdata->getDomainDecomposition())
+        {
+        // add the ghost cells to the inner cells of the neighbors
+        m_grid_comm->communicate(m_mesh);
+
+        ArrayHandle<kiss_fft_cpx> h_mesh(m_mesh, access_location::host, access_mode::read);
+        ArrayHandle<kiss_fft_cpx> h_fourier_mesh(m_fourier_mesh,
+                                                 access_location::host,
+                                                 access_mode::overwrite);
+        dfft_execute((cpx_t*)(h_mesh.data + m_ghost_offset),
+                     (cpx_t*)h_fourier_mesh.data,
+                     0,
+                     m_dfft_plan_forward);
+
+        MPI_Allreduce(MPI_IN_PLACE,
+                      &n_particles,
+                      1,
+                      MPI_UNSIGNED,
+                      MPI_SUM,
+                      m_exec_conf->getMPICommunicator());
+        }
+#endif
+
+    if (n_particles == 0)
+        {
+        return;
+        }
+
+    ArrayHandle<kiss_fft_cpx> h_fourier_mesh(m_fourier_mesh,
+                                             access_location::host,
+                                             access_mode::read);
+    for (unsigned int k = 0; k < m_n_inner_cells; ++k)
+        {
+        int bin = m_mode_bin[k];
+        if (bin < 0)
+            continue;
+
+        kiss_fft_cpx f = h_fourier_mesh.data[k];
+        double rho2 = double(f.r) * f.r + double(f.i) * f.i;
+        m_sum_S[bin] += (rho2 / double(n_particles) - m_mode_shot[k]) * m_mode_deconv[k] + 1.0;
+        m_count[bin] += 1.0;
+        }
+    m_n_frames++;
+    }
+
+void StructureFactorAnalyzer::reset()
+    {
+    std::fill(m_sum_S.begin(), m_sum_S.end(), 0.0);
+    std::fill(m_count.begin(), m_count.end(), 0.0);
+    m_n_frames = 0;
+    }
+
+/*! All ranks must call this method.
+ */
+void StructureFactorAnalyzer::reduceSums(std::vector<double>& sum_S, std::vector<double>& count)
+    {
+    sum_S = m_sum_S;
+    count = m_count;
+#ifdef ENABLE_MPI
+    if (m_sysdef->isDomainDecomposed())
+        {
+        MPI_Comm mpi_comm = m_exec_conf->getMPICommunicator();
+        MPI_Allreduce(MPI_IN_PLACE, sum_S.data(), (int)sum_S.size(), MPI_DOUBLE, MPI_SUM, mpi_comm);
+        MPI_Allreduce(MPI_IN_PLACE, count.data(), (int)count.size(), MPI_DOUBLE, MPI_SUM, mpi_comm);
+        }
+#endif
+    }
+
+pybind11::array_t<double> StructureFactorAnalyzer::getBinCenters() const
+    {
+    pybind11::array_t<double> result(m_bins);
+    double* data = result.mutable_data();
+    const double dq = double(m_q_max) / m_bins;
+    for (unsigned int b = 0; b < m_bins; b++)
+        {
+        data[b] = (b + 0.5) * dq;
+        }
+    return result;
+    }
+
+pybind11::array_t<double> StructureFactorAnalyzer::getStructureFactor()
+    {
+    std::vector<double> sum_S, count;
+    reduceSums(sum_S, count);
+
+    pybind11::array_t<double> result(m_bins);
+    double* data = result.mutable_data();
+    for (unsigned int b = 0; b < m_bins; b++)
+        {
+        data[b] = count[b] > 0.0 ? sum_S[b] / count[b] : std::numeric_limits<double>::quiet_NaN();
+        }
+    return result;
+    }
+
+pybind11::array_t<double> StructureFactorAnalyzer::getModeCounts()
+    {
+    std::vector<double> sum_S, count;
+    reduceSums(sum_S, count);
+
+    pybind11::array_t<double> result(m_bins);
+    double* data = result.mutable_data();
+    for (unsigned int b = 0; b < m_bins; b++)
+        {
+        data[b] = m_n_frames > 0 ? count[b] / double(m_n_frames) : 0.0;
+        }
+    return result;
+    }
+
+namespace detail
+    {
+void export_StructureFactorAnalyzer(pybind11::module& m)
+    {
+    pybind11::class_<StructureFactorAnalyzer,
+                     Analyzer,
+                     std::shared_ptr<StructureFactorAnalyzer>>(m, "StructureFactorAnalyzer")
+        .def(pybind11::init<std::shared_ptr<SystemDefinition>,
+                            std::shared_ptr<Trigger>,
+                            unsigned int,
+                            unsigned int,
+                            unsigned int,
+                            unsigned int,
+                            Scalar,
+                            const std::vector<unsigned int>&>())
+        .def("reset", &StructureFactorAnalyzer::reset)
+        .def("getBinCenters", &StructureFactorAnalyzer::getBinCenters)
+        .def("getStructureFactor", &StructureFactorAnalyzer::getStructureFactor)
+        .def("getModeCounts", &StructureFactorAnalyzer::getModeCounts)
+        .def_property_readonly("n_frames", &StructureFactorAnalyzer::getNFrames)
+        .def_property_readonly("bins", &StructureFactorAnalyzer::getBins)
+        .def_property_readonly("q_max", &StructureFactorAnalyzer::getQMax);
+    }
+
+    } // end namespace detail
+    } // end namespace md
+    } // end namespace hoomd
@@ -0,0 +1,178 @@
+//~ ########## Created by the Rheoinformatic research group ##########
+//~ HOOMD-blue:
+// Copyright (c) 2009-2023 The Regents of the University of Michigan.
+// Part of HOOMD-blue, released under the BSD 3-Clause License.
+//~
+//~ This file:
+//~ Written by the Rheoinformatic research group (2026)
+
+// ########## Created by Rheoinformatic //~ [RHEOINF] ##########
+
+/*! \file StructureFactorAnalyzer.h
+    \brief Declares the StructureFactorAnalyzer class
+
+    StructureFactorAnalyzer accumulates the static structure factor S(q) from the density mesh of
+    the selected particles, with the same (local or distributed) FFT as PPPMForceCompute, instead
+    of transforming a truncated g(r) after the run.
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include "hoomd/Analyzer.h"
+
+#ifdef ENABLE_MPI
+#include "CommunicatorGrid.h"
+#include "hoomd/extern/dfftlib/src/dfft_host.h"
+#endif
+
+#include "hoomd/extern/kiss_fftnd.h"
+
+#include <memory>
+#include <pybind11/numpy.h>
+#include <pybind11/pybind11.h>
+#include <vector>
+
+#ifndef __STRUCTURE_FACTOR_ANALYZER_H__
+#define __STRUCTURE_FACTOR_ANALYZER_H__
+
+namespace hoomd
+    {
+namespace md
+    {
+//! Accumulates the spherically averaged static structure factor on a mesh
+/*! The selected particles are assigned to a mesh of n_x * n_y * n_z points in fractional
+    coordinates of the global box with the cloud-in-cell (linear) scheme. The forward FFT of the
+    mesh gives rho(q) at the wave vectors q = n_1 b_1 + n_2 b_2 + n_3 b_3 of the reciprocal lattice,
+    so sheared (triclinic) boxes need no special treatment. The mesh smooths rho(q) by the window
+    W(q) = prod_d sinc^2(pi n_d / N_d) of the assignment and aliases the shot noise, so each mode
+    is corrected as in Jing, ApJ 620, 559 (2005):
+
+        S(q) = (|rho_mesh(q)|^2 / N - C(q)) / W(q)^2 + 1
+
+    with C(q) = prod_d (1 - 2/3 sin^2(pi n_d / N_d)). S(q) is averaged over the modes in each |q|
+    bin (0 < |q| < q_max) and over the frames. The correction is exact for uncorrelated positions
+    and accurate well below the Nyquist wave number, where W is close to 1. q_max must be below
+    the Nyquist wave number pi N_d / d_d of every direction, d_d being the distance between the
+    box faces, so that every shell is complete.
+
+    With MPI, the mesh is split over the domains as in PPPMForceCompute: ghost cells are added to
+    the neighboring domains with CommunicatorGrid and the FFT is distributed with dfftlib. Each
+    rank bins its own modes and the sums are reduced when read.
+
+    \ingroup analyzers
+*/
+class PYBIND11_EXPORT StructureFactorAnalyzer : public Analyzer
+    {
+    public:
+    //! Construct the analyzer
+    StructureFactorAnalyzer(std::shared_ptr<SystemDefinition> sysdef,
+                            std::shared_ptr<Trigger> trigger,
+                            unsigned int nx,
+                            unsigned int ny,
+                            unsigned int nz,
+                            unsigned int bins,
+                            Scalar q_max,
+                            const std::vector<unsigned int>& types);
+
+    //! Destructor
+    virtual ~StructureFactorAnalyzer();
+
+    //! Add S(q) of the current frame
+    virtual void analyze(uint64_t timestep);
+
+    //! Clear the accumulated sums
+    void reset();
+
+    //! Get the centers of the |q| bins
+    pybind11::array_t<double> getBinCenters() const;
+
+    //! Get the accumulated S(q) (NaN for bins without modes)
+    pybind11::array_t<double> getStructureFactor();
+
+    //! Get the number of modes in each bin per frame
+    pybind11::array_t<double> getModeCounts();
+
+    //! Get the number of frames accumulated since the last reset
+    uint64_t getNFrames() const
+        {
+        return m_n_frames;
+        }
+
+    //! Get the number of bins
+    unsigned int getBins() const
+        {
+        return m_bins;
+        }
+
+    //! Get the upper edge of the last bin
+    Scalar getQMax() const
+        {
+        return m_q_max;
+        }
+
+    private:
+    uint3 m_global_dim;    //!< Global number of mesh points
+    uint3 m_mesh_points;   //!< Number of mesh points of this domain
+    uint3 m_n_ghost_cells; //!< Number of ghost cells along each side
+    uint3 m_grid_dim;      //!< Dimensions of the local mesh including ghost cells
+    unsigned int m_n_cells;       //!< Number of local cells including ghost cells
+    unsigned int m_n_inner_cells; //!< Number of local cells without ghost cells
+    unsigned int m_ghost_offset;  //!< Offset of the first inner cell in the mesh
+    unsigned int m_bins;          //!< Number of |q| bins
+    Scalar m_q_max;               //!< Upper edge of the last bin
+    std::vector<bool> m_include;  //!< True for the selected types
+    bool m_need_initialize;       //!< True if the mesh needs to be set up
+    bool m_box_changed;           //!< True if the wave vectors need to be recomputed
+
+    kiss_fftnd_cfg m_kiss_fft = NULL; //!< Local FFT configuration
+    bool m_kiss_fft_initialized;      //!< True if a local FFT has been set up
+#ifdef ENABLE_MPI
+    dfft_plan m_dfft_plan_forward;                               //!< Distributed forward FFT
+    bool m_dfft_initialized;                                     //!< True if dfft is set up
+    std::unique_ptr<CommunicatorGrid<kiss_fft_cpx>> m_grid_comm; //!< Adds the ghost cells
+#endif
+
+    GlobalArray<kiss_fft_cpx> m_mesh;         //!< Density mesh
+    GlobalArray<kiss_fft_cpx> m_fourier_mesh; //!< Transformed density mesh
+    std::vector<int> m_mode_bin;              //!< Bin of each local mode (-1 if not binned)
+    std::vector<Scalar> m_mode_deconv;        //!< Inverse squared window of each local mode
+    std::vector<Scalar> m_mode_shot;          //!< Aliased shot noise of each local mode
+
+    std::vector<double> m_sum_S; //!< Sum of S over the modes of each bin
+    std::vector<double> m_count; //!< Number of modes added to each bin
+    uint64_t m_n_frames;         //!< Frames accumulated since the last reset
+
+    //! Flag the wave vectors for an update
+    void slotBoxChanged()
+        {
+        m_box_changed = true;
+        }
+
+    //! Number of ghost cells needed for the particles that left the domain
+    uint3 computeGhostCellNum();
+
+    //! Allocate the meshes and set up the FFT
+    void setupMesh();
+
+    //! Compute the bin and the window of every local mode
+    void computeModes();
+
+    //! Assign the selected local particles to the mesh, returns their number
+    unsigned int assignParticles();
+
+    //! Sum the accumulators over the ranks
+    void reduceSums(std::vector<double>& sum_S, std::vector<double>& count);
+    };
+
+namespace detail
+    {
+//! Export StructureFactorAnalyzer to python
+void export_StructureFactorAnalyzer(pybind11::module& m);
+    } // end namespace detail
+
+    } // end namespace md
+    } // end namespace hoomd
+
+#endif // __STRUCTURE_FACTOR_ANALYZER_H__
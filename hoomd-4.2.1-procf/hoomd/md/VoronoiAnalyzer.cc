@@ -0,0 +1,566 @@
+//~ ########## Created by the Rheoinformatic research group ##########
+//~ HOOMD-blue:
+// Copyright (c) 2009-2023 The Regents of the University of Michigan.
+// Part of HOOMD-blue, released under the BSD 3-Clause License.
+//~
+//~ This file:
+//~ Written by the Rheoinformatic research group (2026)
+
+// ########## Created by Rheoinformatic //~ [RHEOINF] ##########
+
+/*! \file VoronoiAnalyzer.cc
+    \brief Defines the VoronoiAnalyzer class
+*/
+
+#include "VoronoiAnalyzer.h"
+#include "hoomd/VectorMath.h"
+
+#ifdef ENABLE_MPI
+#include "hoomd/Communicator.h"
+#endif
+
+#ifdef ENABLE_TBB
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#endif
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <pybind11/stl.h>
+#include <stdexcept>
+
+using namespace std;
+
+namespace hoomd
+    {
+namespace md
+    {
+namespace
+    {
+//! Convex polyhedron around a particle at the origin
+/*! The faces are lists of vertex indices ordered counterclockwise when seen from outside, so the
+    volume is the sum of the signed volumes of the tetrahedra spanned by the origin and a fan
+    triangulation of every face (also when the origin is outside the cell).
+*/
+class ConvexCell
+    {
+    public:
+    //! Reset to the cube [-a, a]^3
+    void reset(double a)
+        {
+        m_verts.clear();
+        for (unsigned int k = 0; k < 8; k++)
+            m_verts.push_back(vec3<double>(k & 1 ? a : -a, k & 2 ? a : -a, k & 4 ? a : -a));
+        // vertex k has the coordinates of the bits of k, x + 2 y + 4 z
+        m_faces.assign({{0, 4, 6, 2},
+                        {1, 3, 7, 5},
+                        {0, 1, 5, 4},
+                        {2, 6, 7, 3},
+                        {0, 2, 3, 1},
+                        {4, 5, 7, 6}});
+        m_scale = a;
+        m_max_rsq = 3.0 * a * a;
+        }
+
+    //! Keep the part of the cell with d . x <= c
+    void clip(const vec3<double>& d, double c)
+        {
+        // signed distances (times |d|) of the vertices, cut only beyond the round-off
+        const double tol = 1e-12 * m_scale * sqrt(dot(d, d));
+        m_side.resize(m_verts.size());
+        double max_side = -1.0;
+        for (size_t v = 0; v < m_verts.size(); v++)
+            {
+            m_side[v] = dot(d, m_verts[v]) - c;
+            max_side = std::max(max_side, m_side[v]);
+            }
+        if (max_side <= tol)
+            return;
+
+        // the vertices inside are kept, each cut edge adds one vertex on the plane
+        m_new_verts.clear();
+        m_map.assign(m_verts.size(), -1);
+        for (size_t v = 0; v < m_verts.size(); v++)
+            {
+            if (m_side[v] <= 0.0)
+                {
+                m_map[v] = int(m_new_verts.size());
+                m_new_verts.push_back(m_verts[v]);
+                }
+            }
+        const size_t n_kept = m_new_verts.size();
+        m_cuts.clear();
+        auto cut = [&](unsigned int a, unsigned int b)
+        {
+            const unsigned int lo = std::min(a, b), hi = std::max(a, b);
+            for (const auto& e : m_cuts)
+                {
+                if (e[0] == lo && e[1] == hi)
+                    return e[2];
+                }
+            const unsigned int in = m_side[a] <= 0.0 ? a : b, out = in == a ? b : a;
+            const double t = m_side[in] / (m_side[in] - m_side[out]);
+            const unsigned int index = (unsigned int)m_new_verts.size();
+            m_new_verts.push_back(m_verts[in] + t * (m_verts[out] - m_verts[in]));
+            m_cuts.push_back({lo, hi, index});
+            return index;
+        };
+
+        m_new_faces.clear();
+        for (const auto& face : m_faces)
+            {
+            std::vector<unsigned int> polygon;
+            for (size_t k = 0; k < face.size(); k++)
+                {
+                const unsigned int a = face[k], b = face[(k + 1) % face.size()];
+                const bool in_a = m_side[a] <= 0.0, in_b = m_side[b] <= 0.0;
+                if (in_a)
+                    polygon.push_back(m_map[a]);
+                if (in_a != in_b)
+                    polygon.push_back(cut(a, b));
+                }
+            if (polygon.size() >= 3)
+                m_new_faces.push_back(polygon);
+            }
+
+        // the new face on the plane, counterclockwise around the outward normal d
+        if (m_new_verts.size() - n_kept >= 3)
+            {
+            vec3<double> center(0, 0, 0);
+            for (size_t v = n_kept; v < m_new_verts.size(); v++)
+                center += m_new_verts[v];
+            center = center / double(m_new_verts.size() - n_kept);
+            vec3<double> u = fabs(d.x) < fabs(d.y) ? cross(d, vec3<double>(1, 0, 0))
+                                                   : cross(d, vec3<double>(0, 1, 0));
+            const vec3<double> w = cross(d, u);
+
+            m_angles.clear();
+            for (size_t v = n_kept; v < m_new_verts.size(); v++)
+                {
+                const vec3<double> p = m_new_verts[v] - center;
+                m_angles.push_back(std::make_pair(atan2(dot(p, w), dot(p, u)), (unsigned int)v));
+                }
+            std::sort(m_angles.begin(), m_angles.end());
+            std::vector<unsigned int> polygon;
+            for (const auto& a : m_angles)
+                polygon.push_back(a.second);
+            m_new_faces.push_back(polygon);
+            }
+
+        m_verts.swap(m_new_verts);
+        m_faces.swap(m_new_faces);
+        m_max_rsq = 0.0;
+        for (const auto& v : m_verts)
+            m_max_rsq = std::max(m_max_rsq, dot(v, v));
+        }
+
+    //! Volume of the cell
+    double volume() const
+        {
+        double V = 0.0;
+        for (const auto& face : m_faces)
+            {
+            const vec3<double>& v0 = m_verts[face[0]];
+            for (size_t k = 1; k + 1 < face.size(); k++)
+                V += dot(v0, cross(m_verts[face[k]], m_verts[face[k + 1]]));
+            }
+        return V / 6.0;
+        }
+
+    //! Squared distance of the farthest vertex from the origin
+    double maxRadiusSq() const
+        {
+        return m_max_rsq;
+        }
+
+    private:
+    std::vector<vec3<double>> m_verts;             //!< Vertices
+    std::vector<std::vector<unsigned int>> m_faces; //!< Faces, counterclockwise from outside
+    double m_scale;                                //!< Size of the initial cube
+    double m_max_rsq;                              //!< Squared distance of the farthest vertex
+
+    // buffers reused by clip()
+    std::vector<double> m_side;
+    std::vector<int> m_map;
+    std::vector<vec3<double>> m_new_verts;
+    std::vector<std::vector<unsigned int>> m_new_faces;
+    std::vector<std::array<unsigned int, 3>> m_cuts;
+    std::vector<std::pair<double, unsigned int>> m_angles;
+    };
+
+//! Candidate neighbor of a cell
+struct VoronoiNeighbor
+    {
+    double rsq;     //!< Squared distance
+    vec3<double> d; //!< Minimum image separation r_j - r_i
+    double radius;  //!< Radius of the neighbor
+
+    bool operator<(const VoronoiNeighbor& other) const
+        {
+        return rsq < other.rsq;
+        }
+    };
+    } // end anonymous namespace
+
+/*! \param sysdef System definition
+    \param trigger Select the timesteps to compute the cells
+    \param r_max Search range for the neighbors
+    \param types Indices of the selected types (all types when empty)
+*/
+VoronoiAnalyzer::VoronoiAnalyzer(std::shared_ptr<SystemDefinition> sysdef,
+                                 std::shared_ptr<Trigger> trigger,
+                                 Scalar r_max,
+                                 const std::vector<unsigned int>& types)
+    : Analyzer(sysdef, trigger), m_r_max(r_max), m_n_cells(0), m_n_incomplete(0)
+    {
+    m_exec_conf->msg->notice(5) << "Constructing VoronoiAnalyzer" << endl;
+
+    if (m_exec_conf->isCUDAEnabled())
+        {
+        throw runtime_error("Voronoi: only the CPU implementation is available.");
+        }
+    if (m_sysdef->getNDimensions() != 3)
+        {
+        throw runtime_error("Voronoi: only 3D systems are supported.");
+        }
+    if (!(m_r_max > Scalar(0.0)))
+        {
+        throw runtime_error("Voronoi: r_max must be positive.");
+        }
+
+    m_include.assign(m_pdata->getNTypes(), types.empty());
+    for (unsigned int type : types)
+        {
+        if (type >= m_pdata->getNTypes())
+            {
+            throw runtime_error("Voronoi: invalid particle type.");
+            }
+        m_include[type] = true;
+        }
+    for (unsigned int k = 0; k < 4; k++)
+        m_moments[k] = 0.0;
+
+    m_cl = std::make_shared<CellList>(m_sysdef);
+    m_cl->setRadius(1);
+    m_cl->setComputeXYZF(true);
+    m_cl->setComputeTypeBody(false);
+    m_cl->setFlagIndex();
+    m_cl->setNominalWidth(m_r_max);
+
+#ifdef ENABLE_MPI
+    if (m_sysdef->isDomainDecomposed())
+        {
+        auto comm_weak = m_sysdef->getCommunicator();
+        assert(comm_weak.lock());
+        m_comm = comm_weak.lock();
+
+        m_comm->getCommFlagsRequestSignal()
+            .connect<VoronoiAnalyzer, &VoronoiAnalyzer::getRequestedCommFlags>(this);
+        m_comm->getGhostLayerWidthRequestSignal()
+            .connect<VoronoiAnalyzer, &VoronoiAnalyzer::getGhostLayerWidth>(this);
+        }
+#endif
+    }
+
+VoronoiAnalyzer::~VoronoiAnalyzer()
+    {
+    m_exec_conf->msg->notice(5) << "Destroying VoronoiAnalyzer" << endl;
+
+#ifdef ENABLE_MPI
+    if (m_comm)
+        {
+        m_comm->getCommFlagsRequestSignal()
+            .disconnect<VoronoiAnalyzer, &VoronoiAnalyzer::getRequestedCommFlags>(this);
+        m_comm->getGhostLayerWidthRequestSignal()
+            .disconnect<VoronoiAnalyzer, &VoronoiAnalyzer::getGhostLayerWidth>(this);
+        }
+#endif
+    }
+
+#ifdef ENABLE_MPI
+/*! \param timestep Current time step
+ */
+CommFlags VoronoiAnalyzer::getRequestedCommFlags(uint64_t timestep)
+    {
+    CommFlags flags(0);
+    flags[comm_flag::position] = 1;
+    flags[comm_flag::diameter] = 1;
+    return flags;
+    }
+
+/*! \param type Particle type
+ */
+Scalar VoronoiAnalyzer::getGhostLayerWidth(unsigned int type)
+    {
+    return m_r_max;
+    }
+#endif
+
+/*! \param timestep Current time step of the simulation
+ */
+void VoronoiAnalyzer::analyze(uint64_t timestep)
+    {
+    Analyzer::analyze(timestep);
+
+    if (m_pdata->getNTypes() != m_include.size())
+        {
+        throw runtime_error("Voronoi: the number of particle types changed.");
+        }
+
+    // minimum image neighbors only
+    const Scalar3 npd = m_pdata->getGlobalBox().getNearestPlaneDistance();
+    if (m_r_max * Scalar(2.0) > npd.x || m_r_max * Scalar(2.0) > npd.y
+        || m_r_max * Scalar(2.0) > npd.z)
+        {
+        throw runtime_error("Voronoi: r_max is larger than half the box.");
+        }
+
+    m_cl->compute(timestep);
+
+    const uint3 dim = m_cl->getDim();
+    const Scalar3 ghost_width = m_cl->getGhostWidth();
+
+    ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar> h_diameter(m_pdata->getDiameters(),
+                                   access_location::host,
+                                   access_mode::read);
+    ArrayHandle<unsigned int> h_tag(m_pdata->getTags(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_cell_size(m_cl->getCellSizeArray(),
+                                          access_location::host,
+                                          access_mode::read);
+    ArrayHandle<Scalar4> h_cell_xyzf(m_cl->getXYZFArray(),
+                                     access_location::host,
+                                     access_mode::read);
+    ArrayHandle<unsigned int> h_cell_adj(m_cl->getCellAdjArray(),
+                                         access_location::host,
+                                         access_mode::read);
+
+    const BoxDim& box = m_pdata->getBox();
+    const uchar3 periodic = box.getPeriodic();
+    const Index3D ci = m_cl->getCellIndexer();
+    const Index2D cli = m_cl->getCellListIndexer();
+    const Index2D cadji = m_cl->getCellAdjIndexer();
+    const double r_max = m_r_max;
+    const double r_max_sq = r_max * r_max;
+    const double radius_max = 0.5 * m_pdata->getMaxDiameter();
+    const unsigned int N = m_pdata->getN();
+
+    std::vector<double> volume(N, 0.0);
+    std::vector<char> incomplete(N, 0);
+
+    auto compute_cells = [&](unsigned int begin, unsigned int end)
+    {
+        ConvexCell cell;
+        std::vector<VoronoiNeighbor> neighbors;
+        for (unsigned int i = begin; i < end; i++)
+            {
+            const Scalar3 pos_i = make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
+            if (!m_include[__scalar_as_int(h_pos.data[i].w)])
+                continue;
+            const double radius_i = 0.5 * h_diameter.data[i];
+
+            // find the bin of particle i, as NeighborListBinned does
+            Scalar3 f = box.makeFraction(pos_i, ghost_width);
+            int ib = (unsigned int)(f.x * dim.x);
+            int jb = (unsigned int)(f.y * dim.y);
+            int kb = (unsigned int)(f.z * dim.z);
+            if (ib == (int)dim.x && periodic.x)
+                ib = 0;
+            if (jb == (int)dim.y && periodic.y)
+                jb = 0;
+            if (kb == (int)dim.z && periodic.z)
+                kb = 0;
+            const unsigned int my_cell = ci(ib, jb, kb);
+
+            neighbors.clear();
+            for (unsigned int cur_adj = 0; cur_adj < cadji.getW(); cur_adj++)
+                {
+                const unsigned int neigh_cell = h_cell_adj.data[cadji(cur_adj, my_cell)];
+                const unsigned int size = h_cell_size.data[neigh_cell];
+                for (unsigned int cur_offset = 0; cur_offset < size; cur_offset++)
+                    {
+                    const Scalar4& cur_xyzf = h_cell_xyzf.data[cli(cur_offset, neigh_cell)];
+                    const unsigned int j = __scalar_as_int(cur_xyzf.w);
+                    if (j == i || !m_include[__scalar_as_int(h_pos.data[j].w)])
+                        continue;
+
+                    const Scalar3 dx
+                        = box.minImage(make_scalar3(cur_xyzf.x, cur_xyzf.y, cur_xyzf.z) - pos_i);
+                    const vec3<double> d(dx);
+                    const double rsq = dot(d, d);
+                    if (rsq >= r_max_sq || rsq == 0.0)
+                        continue;
+                    neighbors.push_back({rsq, d, 0.5 * h_diameter.data[j]});
+                    }
+                }
+            std::sort(neighbors.begin(), neighbors.end());
+
+            // h >= (r^2 + R_i^2 - R_max^2) / 2r for every neighbor at r, which grows with r
+            auto nearest_plane = [&](double r)
+            { return (r * r + radius_i * radius_i - radius_max * radius_max) / (2.0 * r); };
+
+            cell.reset(r_max);
+            bool closed = false;
+            for (const VoronoiNeighbor& n : neighbors)
+                {
+                const double h_min = nearest_plane(sqrt(n.rsq));
+                if (h_min > 0.0 && h_min * h_min >= cell.maxRadiusSq())
+                    {
+                    closed = true;
+                    break;
+                    }
+                cell.clip(n.d, 0.5 * (n.rsq + radius_i * radius_i - n.radius * n.radius));
+                }
+            if (!closed)
+                {
+                const double h_min = nearest_plane(r_max);
+                closed = h_min > 0.0 && h_min * h_min >= cell.maxRadiusSq();
+                }
+
+            volume[i] = cell.volume();
+            incomplete[i] = !closed;
+            }
+    };
+
+#ifdef ENABLE_TBB
+    m_exec_conf->getTaskArena()->execute(
+        [&]
+        {
+            tbb::parallel_for(tbb::blocked_range<unsigned int>(0, N),
+                              [&](const tbb::blocked_range<unsigned int>& r)
+                              { compute_cells(r.begin(), r.end()); });
+        });
+#else
+    compute_cells(0, N);
+#endif
+
+    m_cell_tag.clear();
+    m_cell_volume.clear();
+    unsigned int counts[2] = {0, 0};
+    double sums[4] = {0.0, 0.0, 0.0, 0.0};
+    for (unsigned int i = 0; i < N; i++)
+        {
+        if (!m_include[__scalar_as_int(h_pos.data[i].w)])
+            continue;
+        m_cell_tag.push_back(h_tag.data[i]);
+        m_cell_volume.push_back(volume[i]);
+        counts[0]++;
+        counts[1] += incomplete[i];
+        sums[0] += volume[i];
+        }
+
+    // central moments in a second pass, after the mean is known
+#ifdef ENABLE_MPI
+    if (m_sysdef->isDomainDecomposed())
+        {
+        MPI_Allreduce(MPI_IN_PLACE,
+                      counts,
+                      2,
+                      MPI_UNSIGNED,
+                      MPI_SUM,
+                      m_exec_conf->getMPICommunicator());
+        MPI_Allreduce(MPI_IN_PLACE,
+                      sums,
+                      1,
+                      MPI_DOUBLE,
+                      MPI_SUM,
+                      m_exec_conf->getMPICommunicator());
+        }
+#endif
+    m_n_cells = counts[0];
+    m_n_incomplete = counts[1];
+    const double mean = m_n_cells > 0 ? sums[0] / double(m_n_cells) : 0.0;
+
+    for (unsigned int k = 0; k < 3; k++)
+        sums[k] = 0.0;
+    for (double V : m_cell_volume)
+        {
+        const double dV = V - mean;
+        sums[0] += dV * dV;
+        sums[1] += dV * dV * dV;
+        sums[2] += dV * dV * dV * dV;
+        }
+#ifdef ENABLE_MPI
+    if (m_sysdef->isDomainDecomposed())
+        {
+        MPI_Allreduce(MPI_IN_PLACE,
+                      sums,
+                      3,
+                      MPI_DOUBLE,
+                      MPI_SUM,
+                      m_exec_conf->getMPICommunicator());
+        }
+#endif
+    const double n = m_n_cells > 0 ? double(m_n_cells) : 1.0;
+    const double m2 = sums[0] / n, m3 = sums[1] / n, m4 = sums[2] / n;
+    m_moments[0] = mean;
+    m_moments[1] = m2;
+    m_moments[2] = m2 > 0.0 ? m3 / pow(m2, 1.5) : 0.0;
+    m_moments[3] = m2 > 0.0 ? m4 / (m2 * m2) : 0.0;
+
+    if (m_n_incomplete > 0)
+        {
+        m_exec_conf->msg->warning()
+            << "Voronoi: " << m_n_incomplete
+            << " cells may extend beyond r_max, increase r_max for exact volumes." << endl;
+        }
+    }
+
+/*! All ranks must call this method.
+ */
+pybind11::object VoronoiAnalyzer::getVolumes()
+    {
+    const unsigned int n_global = m_pdata->getNGlobal();
+    std::vector<double> volumes(n_global, 0.0);
+    for (size_t k = 0; k < m_cell_tag.size(); k++)
+        {
+        if (m_cell_tag[k] < n_global)
+            volumes[m_cell_tag[k]] = m_cell_volume[k];
+        }
+
+    bool root = true;
+#ifdef ENABLE_MPI
+    if (m_sysdef->isDomainDecomposed())
+        {
+        root = m_exec_conf->isRoot();
+        MPI_Reduce(root ? MPI_IN_PLACE : volumes.data(),
+                   volumes.data(),
+                   (int)n_global,
+                   MPI_DOUBLE,
+                   MPI_SUM,
+                   0,
+                   m_exec_conf->getMPICommunicator());
+        }
+#endif
+    if (!root)
+        return pybind11::none();
+    return pybind11::array_t<double>(volumes.size(), volumes.data());
+    }
+
+pybind11::array_t<double> VoronoiAnalyzer::getMoments() const
+    {
+    return pybind11::array_t<double>(4, m_moments);
+    }
+
+namespace detail
+    {
+void export_VoronoiAnalyzer(pybind11::module& m)
+    {
+    pybind11::class_<VoronoiAnalyzer, Analyzer, std::shared_ptr<VoronoiAnalyzer>>(
+        m,
+        "VoronoiAnalyzer")
+        .def(pybind11::init<std::shared_ptr<SystemDefinition>,
+                            std::shared_ptr<Trigger>,
+                            Scalar,
+                            const std::vector<unsigned int>&>())
+        .def("getVolumes", &VoronoiAnalyzer::getVolumes)
+        .def("getMoments", &VoronoiAnalyzer::getMoments)
+        .def_property_readonly("n_cells", &VoronoiAnalyzer::getNCells)
+        .def_property_readonly("n_incomplete", &VoronoiAnalyzer::getNIncomplete)
+        .def_property_readonly("r_max", &VoronoiAnalyzer::getRMax);
+    }
+
+    } // end namespace detail
+    } // end namespace md
+    } // end namespace hoomd
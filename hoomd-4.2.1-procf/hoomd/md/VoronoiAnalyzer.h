@@ -0,0 +1,130 @@
+//~ ########## Created by the Rheoinformatic research group ##########
+//~ HOOMD-blue:
+// Copyright (c) 2009-2023 The Regents of the University of Michigan.
+// Part of HOOMD-blue, released under the BSD 3-Clause License.
+//~
+//~ This file:
+//~ Written by the Rheoinformatic research group (2026)
+
+// ########## Created by Rheoinformatic //~ [RHEOINF] ##########
+
+/*! \file VoronoiAnalyzer.h
+    \brief Declares the VoronoiAnalyzer class
+
+    VoronoiAnalyzer computes the radical (Laguerre) Voronoi cell of every selected particle during
+    the simulation, in parallel over the domains and the threads of each rank, instead of passing
+    every stored frame through a serial tessellation after the run.
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include "hoomd/Analyzer.h"
+#include "hoomd/CellList.h"
+
+#include <memory>
+#include <pybind11/numpy.h>
+#include <pybind11/pybind11.h>
+#include <vector>
+
+#ifndef __VORONOI_ANALYZER_H__
+#define __VORONOI_ANALYZER_H__
+
+namespace hoomd
+    {
+namespace md
+    {
+//! Computes the radical Voronoi cell volume of every selected particle
+/*! The radical (power, or Laguerre) cell of particle i with radius R_i = d_i / 2 is the set of
+    points x closer to it in the power distance |x - r_i|^2 - R_i^2 than to any other selected
+    particle. It is bounded by the radical planes
+
+        (r_j - r_i) . (x - r_i) = (r_ij^2 + R_i^2 - R_j^2) / 2
+
+    so the cells of spheres of different sizes tile the box without cutting through the spheres.
+    With equal radii it is the ordinary Voronoi cell.
+
+    Each cell starts as a cube around the particle and is clipped by the radical planes of the
+    neighbors from the own CellList in order of distance, until the nearest possible plane of
+    the remaining neighbors lies beyond every vertex of the cell. Neighbors are the minimum images
+    in the (possibly tilted) periodic box. A cell that could still be cut by a particle beyond
+    the search range r_max is counted as incomplete. The cells are independent and computed in
+    parallel with TBB when available. With MPI, every rank computes the cells of its local
+    particles and requests a ghost layer of width r_max.
+
+    Each call to analyze() computes the volume of every cell and the mean, variance, skewness,
+    and (Pearson) kurtosis of the volumes of the frame over all ranks.
+
+    \ingroup analyzers
+*/
+class PYBIND11_EXPORT VoronoiAnalyzer : public Analyzer
+    {
+    public:
+    //! Construct the analyzer
+    VoronoiAnalyzer(std::shared_ptr<SystemDefinition> sysdef,
+                    std::shared_ptr<Trigger> trigger,
+                    Scalar r_max,
+                    const std::vector<unsigned int>& types);
+
+    //! Destructor
+    virtual ~VoronoiAnalyzer();
+
+    //! Compute the cells of the current frame
+    virtual void analyze(uint64_t timestep);
+
+    //! Get the cell volumes of the last frame by tag on the root rank (0 for other types)
+    pybind11::object getVolumes();
+
+    //! Get the mean, variance, skewness, and kurtosis of the volumes of the last frame
+    pybind11::array_t<double> getMoments() const;
+
+    //! Get the number of selected particles in the last frame
+    unsigned int getNCells() const
+        {
+        return m_n_cells;
+        }
+
+    //! Get the number of cells of the last frame that may be cut beyond r_max
+    unsigned int getNIncomplete() const
+        {
+        return m_n_incomplete;
+        }
+
+    //! Get the search range
+    Scalar getRMax() const
+        {
+        return m_r_max;
+        }
+
+    private:
+    Scalar m_r_max;                       //!< Search range
+    std::vector<bool> m_include;          //!< True for the selected types
+    std::shared_ptr<CellList> m_cl;       //!< Cell list of the candidate neighbors
+    std::vector<unsigned int> m_cell_tag; //!< Tags of the local selected particles
+    std::vector<double> m_cell_volume;    //!< Cell volumes of the local selected particles
+    double m_moments[4];                  //!< Mean, variance, skewness, and kurtosis
+    unsigned int m_n_cells;               //!< Number of cells in the last frame
+    unsigned int m_n_incomplete;          //!< Number of incomplete cells in the last frame
+
+#ifdef ENABLE_MPI
+    std::shared_ptr<Communicator> m_comm; //!< Communicator, to request the ghost layer
+
+    //! Request positions and diameters of the ghost particles
+    CommFlags getRequestedCommFlags(uint64_t timestep);
+
+    //! Request a ghost layer as wide as the search range
+    Scalar getGhostLayerWidth(unsigned int type);
+#endif
+    };
+
+namespace detail
+    {
+//! Export VoronoiAnalyzer to python
+void export_VoronoiAnalyzer(pybind11::module& m);
+    } // end namespace detail
+
+    } // end namespace md
+    } // end namespace hoomd
+
+#endif // __VORONOI_ANALYZER_H__
@@ -1,6 +1,8 @@
 # Copyright (c) 2009-2023 The Regents of the University of Michigan.
 # Part of HOOMD-blue, released under the BSD 3-Clause License.
 
+###### Modified by Rheoinformatic ##~ [RHEOINF] ######
+
 """Molecular dynamics.
 
 In molecular dynamics simulations, HOOMD-blue numerically integrates the degrees
@@ -14,12 +16,15 @@ MD updaters (`hoomd.md.update`) perform additional operations during the
 simulation, including rotational diffusion and establishing shear flow.
 Use MD computes (`hoomd.md.compute`) to compute the thermodynamic properties of
 the system state.
+MD analyzers (`hoomd.md.analyze`) accumulate structural and dynamical
+properties, such as the radial distribution function, during the simulation.
 
 See Also:
     Tutorial: :doc:`tutorial/01-Introducing-Molecular-Dynamics/00-index`
 """
 
 from hoomd.md import alchemy
+from hoomd.md import analyze ##~ add in-situ analyzers [RHEOINF]
 from hoomd.md import angle
 from hoomd.md import bond
 from hoomd.md import compute
@@ -0,0 +1,1465 @@
+########## Created by the Rheoinformatic research group ##########
+# HOOMD-blue:
+#   Copyright (c) 2009-2023 The Regents of the University of Michigan.
+#   Part of HOOMD-blue, released under the BSD 3-Clause License.
+#
+# This file:
+#   Written by the Rheoinformatic research group (2026)
+
+########## Created by Rheoinformatic ##~ [RHEOINF] ##########
+
+"""Accumulate properties of molecular dynamics simulations in situ.
+
+The MD analyzers accumulate structural and dynamical properties of the
+simulation state on the timesteps selected by their trigger, so they do not
+have to be computed after the fact from stored frames. Add them to
+`hoomd.Operations.writers` and read the accumulated results through their
+loggable quantities (see `hoomd.logging.Logger`) or the Python API.
+
+The analyzers are writers backed by C++ ``Analyzer`` objects, not computes:
+HOOMD runs computes only when another operation requests their values, while
+writers run on the timesteps selected by a `hoomd.trigger.Trigger`, which is
+what an accumulator sampling the simulation needs.
+
+.. invisible-code-block: python
+
+    simulation = hoomd.util.make_example_simulation()
+"""
+
+import hoomd
+import numpy as np
+from hoomd.md import _md
+from hoomd.md.nlist import NeighborList
+from hoomd.operation import Writer
+from hoomd.data.parameterdicts import ParameterDict
+from hoomd.data.typeconverter import OnlyTypes
+from hoomd.logging import log
+
+
+class RDF(Writer):
+    r"""Accumulate the radial distribution function per type pair [RHEOINF].
+
+    Args:
+        trigger (hoomd.trigger.trigger_like): Select the timesteps to
+            accumulate.
+        bins (int): Number of bins.
+        r_max (float): Upper edge of the last bin :math:`[\mathrm{length}]`.
+        r_min (float): Lower edge of the first bin :math:`[\mathrm{length}]`.
+            Defaults to 0.
+        surface (bool): When `True`, bin pairs in the surface-surface
+            distance :math:`h_{ij} = r_{ij} - (d_i + d_j)/2` computed from the
+            particle diameters instead of :math:`r_{ij}`. Defaults to `False`.
+        nlist (hoomd.md.nlist.NeighborList): Neighbor list to take the pairs
+            from, usually the one of a pair force. When `None` (the default),
+            `RDF` searches its own cell list.
+        types (list[str]): Particle types to count pairs of, e.g. only the
+            colloids. When `None` (the default), all types are counted.
+
+    `RDF` adds the pairs of every unordered type pair :math:`(a, b)` to a
+    histogram each time it is triggered and averages
+
+    .. math::
+
+        g_{ab}(x) = \frac{V}{N_{ab}} \sum_{i \in a, j \in b}
+        \frac{\delta_{\mathrm{bin}}(x_{ij})}{\Delta V}
+
+    over the frames, where :math:`N_{ab} = N_a (N_a - 1)/2` for
+    :math:`a = b` and :math:`N_a N_b` otherwise, and :math:`\Delta V` is the
+    volume of the spherical shell (the area of the annulus in 2D) of the bin.
+    :math:`x_{ij}` is :math:`r_{ij}`, or :math:`h_{ij}` with ``surface=True``.
+    With surface binning the shell is taken at the center distance of each
+    pair, :math:`\Delta V = 4 \pi r_{ij}^2 \Delta h`, because pairs at the
+    same :math:`h` are at different :math:`r` when the diameters differ
+    (polydisperse gels). :math:`h` may be negative for overlapping particles,
+    set ``r_min`` below 0 to include them.
+
+    Rows of type pairs outside ``types`` are zero. When given a neighbor list,
+    `RDF` adds its search range (``r_max``, plus the largest diameter with
+    ``surface=True``) to the list's cutoffs of the selected type pairs so the
+    list holds every needed pair. Neighbor lists with exclusions are not
+    supported. Otherwise, `RDF` bins the particles in its own cell list and
+    (with MPI) requests ghost particles out to the search range. The search
+    range must be less than half the box.
+
+    The histograms accumulate until `reset` is called. Log `rdf` and call
+    `reset` to write averages over consecutive time windows.
+
+    .. rubric:: Example:
+
+    .. code-block:: python
+
+        rdf = hoomd.md.analyze.RDF(trigger=hoomd.trigger.Periodic(100),
+                                   bins=50,
+                                   r_max=2.5)
+        simulation.operations.writers.append(rdf)
+
+    Note:
+        `RDF` is only implemented on the CPU.
+
+    Attributes:
+        bins (int): Number of bins (read only).
+        r_max (float): Upper edge of the last bin
+            :math:`[\mathrm{length}]` (read only).
+        r_min (float): Lower edge of the first bin
+            :math:`[\mathrm{length}]` (read only).
+        surface (bool): Bin in surface-surface distance (read only).
+    """
+
+    def __init__(self,
+                 trigger,
+                 bins,
+                 r_max,
+                 r_min=0.0,
+                 surface=False,
+                 nlist=None,
+                 types=None):
+        super().__init__(trigger)
+        self._param_dict.update(
+            ParameterDict(bins=int(bins),
+                          r_max=float(r_max),
+                          r_min=float(r_min),
+                          surface=bool(surface)))
+        self._nlist = OnlyTypes(NeighborList, allow_none=True)(nlist)
+        self._types = None if types is None else [str(t) for t in types]
+
+    def _attach_hook(self):
+        if not isinstance(self._simulation.device, hoomd.device.CPU):
+            raise RuntimeError("RDF is only implemented on the CPU.")
+
+        cpp_nlist = None
+        if self._nlist is not None:
+            self._nlist._attach(self._simulation)
+            cpp_nlist = self._nlist._cpp_obj
+        type_ids = []
+        if self._types is not None:
+            particle_types = self._simulation.state.particle_types
+            type_ids = [particle_types.index(t) for t in self._types]
+        self._cpp_obj = _md.RDFAnalyzer(self._simulation.state._cpp_sys_def,
+                                        self.trigger, self.r_min, self.r_max,
+                                        self.bins, self.surface, cpp_nlist,
+                                        type_ids)
+
+    def _detach_hook(self):
+        if self._nlist is not None:
+            self._nlist._detach()
+
+    @property
+    def nlist(self):
+        """hoomd.md.nlist.NeighborList: Neighbor list the pairs are taken \
+        from (read only)."""
+        return self._nlist
+
+    @property
+    def types(self):
+        """list[str]: Particle types counted, `None` for all types (read \
+        only)."""
+        return self._types
+
+    @property
+    def type_pairs(self):
+        """list[tuple[str, str]]: Type pair of each row of `rdf`."""
+        types = self._simulation.state.particle_types
+        return [(types[a], types[b])
+                for a in range(len(types))
+                for b in range(a, len(types))]
+
+    @log(category='sequence', requires_run=True)
+    def bin_centers(self):
+        """numpy.ndarray: Centers of the bins :math:`[\\mathrm{length}]`."""
+        return self._cpp_obj.getBinCenters()
+
+    @log(category='sequence', requires_run=True)
+    def rdf(self):
+        """numpy.ndarray: Accumulated :math:`g_{ab}(x)`, one row per type \
+        pair (see `type_pairs`)."""
+        return self._cpp_obj.getRDF()
+
+    @log(category='sequence', requires_run=True)
+    def pair_counts(self):
+        """numpy.ndarray: Mean number of pairs per frame in each bin, one row \
+        per type pair (see `type_pairs`)."""
+        return self._cpp_obj.getPairCounts()
+
+    @log(requires_run=True)
+    def n_frames(self):
+        """int: Number of frames accumulated since the last `reset`."""
+        return self._cpp_obj.n_frames
+
+    def reset(self):
+        """Clear the accumulated histograms.
+
+        .. rubric:: Example:
+
+        .. code-block:: python
+
+            rdf.reset()
+        """
+        if self._attached:
+            self._cpp_obj.reset()
+
+
+class MSD(Writer):
+    r"""Accumulate the mean-squared displacement per type [RHEOINF].
+
+    Args:
+        trigger (hoomd.trigger.trigger_like): Select the timesteps (frames) to
+            add to the correlator.
+        block_size (int): Number of lags per level :math:`p`. Defaults to 16.
+        n_levels (int): Largest number of levels. Defaults to 16.
+        subtract_affine (bool): When `True`, subtract the affine displacement
+            of the shear flow from the x displacements. Defaults to `True`.
+        types (list[str]): Particle types to follow, e.g. only the colloids.
+            When `None` (the default), all types are followed.
+
+    `MSD` correlates the unwrapped particle positions with the order-n
+    (multiple-tau) scheme: level :math:`l` keeps the last :math:`p - 1` frames
+    whose index is a multiple of :math:`p^l` and measures the lags of
+    :math:`k p^l` frames, :math:`k = 1 \ldots p - 1`. Each time it is
+    triggered, `MSD` averages
+
+    .. math::
+
+        \mathrm{MSD}_a(\tau) = \langle |\Delta \vec{r}(\tau)|^2 \rangle_a
+
+        \alpha_{2,a}(\tau) = \frac{d \langle |\Delta \vec{r}(\tau)|^4
+        \rangle_a}{(d + 2) \langle |\Delta \vec{r}(\tau)|^2 \rangle_a^2} - 1
+
+    over the particles of type :math:`a` and all time origins of the level,
+    where :math:`d` is the dimensionality. The lags are log spaced up to
+    :math:`(p - 1) p^{n_\mathrm{levels} - 1}` frames and the memory is
+    :math:`N (p - 1) n_\mathrm{levels}` positions, instead of one position
+    per frame.
+
+    The unwrapped positions follow from the particle images. Under shear
+    with `hoomd.update.BoxShear`, `MSD` tracks the accumulated strain
+    :math:`\gamma` through the tilt flips, and with ``subtract_affine=True``
+    removes :math:`(\gamma(t) - \gamma(t_0)) (y(t) + y(t_0))/2` from the x
+    displacement. With MPI, the correlator of each particle lives on a fixed
+    rank, so particles keep their history when they migrate between domains.
+    The number of particles of the selected types must not change.
+
+    The sums accumulate until `reset` is called, the stored frames are kept.
+
+    .. rubric:: Example:
+
+    .. code-block:: python
+
+        msd = hoomd.md.analyze.MSD(trigger=hoomd.trigger.Periodic(10),
+                                   block_size=8)
+        simulation.operations.writers.append(msd)
+
+    Note:
+        `MSD` is only implemented on the CPU.
+
+    Attributes:
+        block_size (int): Number of lags per level (read only).
+        n_levels (int): Largest number of levels (read only).
+        subtract_affine (bool): Subtract the affine shear displacement (read
+            only).
+    """
+
+    def __init__(self,
+                 trigger,
+                 block_size=16,
+                 n_levels=16,
+                 subtract_affine=True,
+                 types=None):
+        super().__init__(trigger)
+        self._param_dict.update(
+            ParameterDict(block_size=int(block_size),
+                          n_levels=int(n_levels),
+                          subtract_affine=bool(subtract_affine)))
+        self._types = None if types is None else [str(t) for t in types]
+
+    def _attach_hook(self):
+        if not isinstance(self._simulation.device, hoomd.device.CPU):
+            raise RuntimeError("MSD is only implemented on the CPU.")
+
+        type_ids = []
+        if self._types is not None:
+            particle_types = self._simulation.state.particle_types
+            type_ids = [particle_types.index(t) for t in self._types]
+        self._cpp_obj = _md.MSDAnalyzer(self._simulation.state._cpp_sys_def,
+                                        self.trigger, self.block_size,
+                                        self.n_levels, self.subtract_affine,
+                                        type_ids)
+
+    @property
+    def types(self):
+        """list[str]: Particle types followed, `None` for all types (read \
+        only)."""
+        return self._types
+
+    @log(category='sequence', requires_run=True)
+    def lag_steps(self):
+        """numpy.ndarray: Mean lag of each bin in timesteps, NaN for bins \
+        not reached yet."""
+        return self._cpp_obj.getLagSteps()
+
+    @log(category='sequence', requires_run=True)
+    def lag_counts(self):
+        """numpy.ndarray: Number of time origins of each bin since the last \
+        `reset`."""
+        return self._cpp_obj.getLagCounts()
+
+    @log(category='sequence', requires_run=True)
+    def msd(self):
+        """numpy.ndarray: Accumulated :math:`\\mathrm{MSD}_a(\\tau)`, one row \
+        per particle type :math:`[\\mathrm{length}^2]`."""
+        return self._cpp_obj.getMSD()
+
+    @log(category='sequence', requires_run=True)
+    def non_gaussian(self):
+        """numpy.ndarray: Accumulated :math:`\\alpha_{2,a}(\\tau)`, one row \
+        per particle type."""
+        return self._cpp_obj.getNonGaussian()
+
+    @log(requires_run=True)
+    def n_frames(self):
+        """int: Number of frames added since the last `reset`."""
+        return self._cpp_obj.n_frames
+
+    @log(requires_run=True)
+    def strain(self):
+        """float: Accumulated shear strain :math:`\\gamma`."""
+        return self._cpp_obj.strain
+
+    def reset(self):
+        """Clear the accumulated sums.
+
+        .. rubric:: Example:
+
+        .. code-block:: python
+
+            msd.reset()
+        """
+        if self._attached:
+            self._cpp_obj.reset()
+
+
+class StructureFactor(Writer):
+    r"""Accumulate the static structure factor on a mesh [RHEOINF].
+
+    Args:
+        trigger (hoomd.trigger.trigger_like): Select the timesteps to
+            accumulate.
+        mesh (int | tuple[int, int, int]): Number of mesh points along each
+            lattice vector of the box (the third is ignored in 2D).
+        bins (int): Number of :math:`|\vec{q}|` bins.
+        q_max (float): Upper edge of the last bin
+            :math:`[\mathrm{length}^{-1}]`.
+        types (list[str]): Particle types to include in the density, e.g.
+            only the colloids. When `None` (the default), all types are
+            included.
+
+    `StructureFactor` assigns the selected particles to the mesh with the
+    cloud-in-cell scheme, transforms it with the FFT of `hoomd.md.long_range`
+    (distributed over the ranks with MPI), and averages
+
+    .. math::
+
+        S(q) = \frac{1}{N} \left\langle \left| \sum_{j=1}^{N}
+        e^{-i \vec{q} \cdot \vec{r}_j} \right|^2 \right\rangle_{|\vec{q}|
+        \in \mathrm{bin}}
+
+    over the wave vectors :math:`\vec{q} = n_1 \vec{b}_1 + n_2 \vec{b}_2 + n_3
+    \vec{b}_3 \neq 0` of the reciprocal lattice in each bin and over the
+    frames. The mesh works in fractional coordinates, so the reciprocal
+    lattice follows sheared (triclinic) boxes. Each mode is corrected for the
+    window of the assignment and the aliased shot noise (Jing 2005), which is
+    accurate for :math:`q` well below the Nyquist wave number
+    :math:`\pi N_d / d_d` (:math:`d_d` is the distance between the box faces
+    along direction :math:`d`). ``q_max`` must not exceed the Nyquist wave
+    number of any direction. With MPI, the number of mesh points must be a
+    power of two and a multiple of the processor grid in each direction.
+
+    The sums accumulate until `reset` is called. Log `structure_factor` and
+    call `reset` to write averages over consecutive time windows.
+
+    .. rubric:: Example:
+
+    .. code-block:: python
+
+        sq = hoomd.md.analyze.StructureFactor(
+            trigger=hoomd.trigger.Periodic(100), mesh=32, bins=20, q_max=5.0)
+        simulation.operations.writers.append(sq)
+
+    Note:
+        `StructureFactor` is only implemented on the CPU.
+
+    Attributes:
+        mesh (tuple[int, int, int]): Number of mesh points (read only).
+        bins (int): Number of bins (read only).
+        q_max (float): Upper edge of the last bin
+            :math:`[\mathrm{length}^{-1}]` (read only).
+    """
+
+    def __init__(self, trigger, mesh, bins, q_max, types=None):
+        super().__init__(trigger)
+        if isinstance(mesh, int):
+            mesh = (mesh, mesh, mesh)
+        self._param_dict.update(
+            ParameterDict(mesh=(int, int, int), bins=int(bins),
+                          q_max=float(q_max)))
+        self.mesh = mesh
+        self._types = None if types is None else [str(t) for t in types]
+
+    def _attach_hook(self):
+        if not isinstance(self._simulation.device, hoomd.device.CPU):
+            raise RuntimeError("StructureFactor is only implemented on the CPU.")
+
+        type_ids = []
+        if self._types is not None:
+            particle_types = self._simulation.state.particle_types
+            type_ids = [particle_types.index(t) for t in self._types]
+        self._cpp_obj = _md.StructureFactorAnalyzer(
+            self._simulation.state._cpp_sys_def, self.trigger, *self.mesh,
+            self.bins, self.q_max, type_ids)
+
+    @property
+    def types(self):
+        """list[str]: Particle types included, `None` for all types (read \
+        only)."""
+        return self._types
+
+    @log(category='sequence', requires_run=True)
+    def bin_centers(self):
+        """numpy.ndarray: Centers of the bins \
+        :math:`[\\mathrm{length}^{-1}]`."""
+        return self._cpp_obj.getBinCenters()
+
+    @log(category='sequence', requires_run=True)
+    def structure_factor(self):
+        """numpy.ndarray: Accumulated :math:`S(q)`, NaN for bins without \
+        wave vectors."""
+        return self._cpp_obj.getStructureFactor()
+
+    @log(category='sequence', requires_run=True)
+    def mode_counts(self):
+        """numpy.ndarray: Number of wave vectors in each bin."""
+        return self._cpp_obj.getModeCounts()
+
+    @log(requires_run=True)
+    def n_frames(self):
+        """int: Number of frames accumulated since the last `reset`."""
+        return self._cpp_obj.n_frames
+
+    def reset(self):
+        """Clear the accumulated sums.
+
+        .. rubric:: Example:
+
+        .. code-block:: python
+
+            sq.reset()
+        """
+        if self._attached:
+            self._cpp_obj.reset()
+
+
+class Coordination(Writer):
+    r"""Count the contacts of every particle [RHEOINF].
+
+    Args:
+        trigger (hoomd.trigger.trigger_like): Select the timesteps to
+            accumulate.
+        nlist (hoomd.md.nlist.NeighborList): Neighbor list to take the pairs
+            from, usually the one of a pair force.
+        gap (float): Surface-surface distance below which two particles are
+            in contact :math:`[\mathrm{length}]`.
+        max_z (int): Last bin of the histogram, which also collects the
+            particles with more contacts. Defaults to 12.
+        types (list[str]): Particle types to count contacts between, e.g.
+            only the colloids. When `None` (the default), all types are
+            counted.
+
+    Particles :math:`i` and :math:`j` of the selected types are in contact
+    when
+
+    .. math::
+
+        h_{ij} = r_{ij} - \frac{d_i + d_j}{2} < \mathrm{gap},
+
+    with the diameters :math:`d_i` of the particles. Each time it is
+    triggered, `Coordination` counts the contacts :math:`Z_i` of every
+    particle, logs their mean `z_avg` over the selected particles, and adds
+    the frame to the distribution `z_histogram` of :math:`Z`.
+
+    `Coordination` adds ``gap`` plus the largest diameter to the neighbor
+    list's cutoffs of the selected type pairs, so the list holds every
+    contact. Neighbor lists with exclusions are not supported. Read the
+    coordination number of each particle with `cpu_local_coordination_arrays`.
+
+    The histogram accumulates until `reset` is called. Log `z_histogram` and
+    call `reset` to write distributions over consecutive time windows.
+
+    .. rubric:: Example:
+
+    .. code-block:: python
+
+        coordination = hoomd.md.analyze.Coordination(
+            trigger=hoomd.trigger.Periodic(100),
+            nlist=hoomd.md.nlist.Cell(buffer=0.4),
+            gap=0.1)
+        simulation.operations.writers.append(coordination)
+
+    `z_avg` can drive other operations, e.g. write a frame once the system
+    gels:
+
+    .. code-block:: python
+
+        class Gelled(hoomd.trigger.Trigger):
+
+            def __init__(self, coordination, z_gel):
+                self.coordination = coordination
+                self.z_gel = z_gel
+                super().__init__()
+
+            def compute(self, timestep):
+                return (self.coordination.n_frames > 0
+                        and self.coordination.z_avg > self.z_gel)
+
+    Note:
+        `Coordination` is only implemented on the CPU.
+
+    Attributes:
+        gap (float): Contact cutoff in the surface-surface distance
+            :math:`[\mathrm{length}]` (read only).
+        max_z (int): Last bin of the histogram (read only).
+    """
+
+    def __init__(self, trigger, nlist, gap, max_z=12, types=None):
+        super().__init__(trigger)
+        self._param_dict.update(ParameterDict(gap=float(gap),
+                                              max_z=int(max_z)))
+        self._nlist = OnlyTypes(NeighborList)(nlist)
+        self._types = None if types is None else [str(t) for t in types]
+        self._in_context_manager = False
+
+    def _attach_hook(self):
+        if not isinstance(self._simulation.device, hoomd.device.CPU):
+            raise RuntimeError("Coordination is only implemented on the CPU.")
+
+        self._nlist._attach(self._simulation)
+        type_ids = []
+        if self._types is not None:
+            particle_types = self._simulation.state.particle_types
+            type_ids = [particle_types.index(t) for t in self._types]
+        self._cpp_obj = _md.CoordinationAnalyzer(
+            self._simulation.state._cpp_sys_def, self.trigger,
+            self._nlist._cpp_obj, self.gap, self.max_z, type_ids)
+
+    def _detach_hook(self):
+        self._nlist._detach()
+
+    @property
+    def nlist(self):
+        """hoomd.md.nlist.NeighborList: Neighbor list the pairs are taken \
+        from (read only)."""
+        return self._nlist
+
+    @property
+    def types(self):
+        """list[str]: Particle types counted, `None` for all types (read \
+        only)."""
+        return self._types
+
+    @property
+    def cpu_local_coordination_arrays(self):
+        """hoomd.md.data.CoordinationLocalAccess: Expose the coordination \
+        numbers on the CPU.
+
+        Counts the contacts in the current configuration and provides direct
+        access to the coordination number of each particle. All data is MPI
+        rank-local and indexed like `hoomd.State.cpu_local_snapshot`. Particles
+        of types that are not counted have no contacts. Every rank must access
+        the arrays.
+
+        Note:
+            The local arrays are read only.
+
+        .. rubric:: Example:
+
+        .. code-block:: python
+
+            with coordination.cpu_local_coordination_arrays as arrays:
+                z = numpy.array(arrays.coordination, copy=True)
+        """
+        if not self._attached:
+            raise hoomd.error.DataAccessError("cpu_local_coordination_arrays")
+        if self._in_context_manager:
+            raise RuntimeError("Cannot enter cpu_local_coordination_arrays "
+                               "context manager inside another local data "
+                               "access context manager.")
+        self._cpp_obj.computeCoordination(self._simulation.timestep)
+        return hoomd.md.data.CoordinationLocalAccess(self,
+                                                     self._simulation.state)
+
+    @log(requires_run=True)
+    def z_avg(self):
+        """float: Mean coordination number of the selected particles in the \
+        last frame."""
+        return self._cpp_obj.z_avg
+
+    @log(category='sequence', requires_run=True)
+    def z_histogram(self):
+        """numpy.ndarray: Fraction of the selected particles with \
+        :math:`Z = 0, 1, \\ldots,` ``max_z`` contacts, averaged over the \
+        frames (the last bin includes :math:`Z > ` ``max_z``)."""
+        return self._cpp_obj.getHistogram()
+
+    @log(requires_run=True)
+    def n_frames(self):
+        """int: Number of frames accumulated since the last `reset`."""
+        return self._cpp_obj.n_frames
+
+    def reset(self):
+        """Clear the accumulated histogram.
+
+        .. rubric:: Example:
+
+        .. code-block:: python
+
+            coordination.reset()
+        """
+        if self._attached:
+            self._cpp_obj.reset()
+
+
+class Fabric(Writer):
+    r"""Accumulate the fabric tensor of the contacts [RHEOINF].
+
+    Args:
+        trigger (hoomd.trigger.trigger_like): Select the timesteps to
+            accumulate.
+        nlist (hoomd.md.nlist.NeighborList): Neighbor list to take the pairs
+            from, usually the one of a pair force.
+        gap (float): Surface-surface distance below which two particles are
+            in contact :math:`[\mathrm{length}]`.
+        types (list[str]): Particle types to count contacts between, e.g.
+            only the colloids. When `None` (the default), all types are
+            counted.
+
+    Particles :math:`i` and :math:`j` of the selected types are in contact
+    when :math:`h_{ij} = r_{ij} - (d_i + d_j)/2 < \mathrm{gap}` (see
+    `Coordination`). Each time it is triggered, `Fabric` sums the orientation
+    tensors of the contacts and logs
+
+    .. math::
+
+        R_{xy} = \frac{1}{N} \sum_{\mathrm{contacts}} n_x n_y,
+
+    with :math:`\vec{n} = \vec{r}_{ij} / r_{ij}` and :math:`N` the number of
+    selected particles, and accumulates the fabric tensor
+
+    .. math::
+
+        R_{\alpha\beta} = \langle n_\alpha n_\beta \rangle
+
+    averaged over the contacts of all frames. :math:`\vec{r}_{ij}` is the
+    minimum image in the current box, which includes the tilt of the box
+    sheared by `hoomd.update.BoxShear` (Lees-Edwards boundary conditions).
+
+    `Fabric` adds ``gap`` plus the largest diameter to the neighbor list's
+    cutoffs of the selected type pairs, so the list holds every contact.
+    Neighbor lists with exclusions are not supported.
+
+    The fabric tensor accumulates until `reset` is called. Log `rxy` every
+    frame for the time series of the contact anisotropy, and log
+    `fabric_tensor` and call `reset` to write averages over consecutive time
+    windows.
+
+    .. rubric:: Example:
+
+    .. code-block:: python
+
+        fabric = hoomd.md.analyze.Fabric(
+            trigger=hoomd.trigger.Periodic(100),
+            nlist=hoomd.md.nlist.Cell(buffer=0.4),
+            gap=0.1)
+        simulation.operations.writers.append(fabric)
+
+    Note:
+        `Fabric` is only implemented on the CPU.
+
+    Attributes:
+        gap (float): Contact cutoff in the surface-surface distance
+            :math:`[\mathrm{length}]` (read only).
+    """
+
+    def __init__(self, trigger, nlist, gap, types=None):
+        super().__init__(trigger)
+        self._param_dict.update(ParameterDict(gap=float(gap)))
+        self._nlist = OnlyTypes(NeighborList)(nlist)
+        self._types = None if types is None else [str(t) for t in types]
+
+    def _attach_hook(self):
+        if not isinstance(self._simulation.device, hoomd.device.CPU):
+            raise RuntimeError("Fabric is only implemented on the CPU.")
+
+        self._nlist._attach(self._simulation)
+        type_ids = []
+        if self._types is not None:
+            particle_types = self._simulation.state.particle_types
+            type_ids = [particle_types.index(t) for t in self._types]
+        self._cpp_obj = _md.FabricAnalyzer(self._simulation.state._cpp_sys_def,
+                                           self.trigger, self._nlist._cpp_obj,
+                                           self.gap, type_ids)
+
+    def _detach_hook(self):
+        self._nlist._detach()
+
+    @property
+    def nlist(self):
+        """hoomd.md.nlist.NeighborList: Neighbor list the pairs are taken \
+        from (read only)."""
+        return self._nlist
+
+    @property
+    def types(self):
+        """list[str]: Particle types counted, `None` for all types (read \
+        only)."""
+        return self._types
+
+    @log(requires_run=True)
+    def rxy(self):
+        """float: :math:`R_{xy}` of the last frame."""
+        return self._cpp_obj.rxy
+
+    @log(category='sequence', requires_run=True)
+    def fabric_tensor(self):
+        """numpy.ndarray: Accumulated :math:`R_{\\alpha\\beta}` as \
+        :math:`[R_{xx}, R_{xy}, R_{xz}, R_{yy}, R_{yz}, R_{zz}]`."""
+        return self._cpp_obj.getFabricTensor()
+
+    @log(requires_run=True)
+    def anisotropy(self):
+        r"""float: Anisotropy of the accumulated fabric tensor.
+
+        .. math::
+
+            a = \sqrt{\frac{D}{D - 1} R'_{\alpha\beta} R'_{\alpha\beta}}
+
+        with the deviatoric part :math:`R' = R - I/D` in :math:`D`
+        dimensions: 0 for isotropic contacts and 1 when all contacts are
+        aligned.
+        """
+        xx, xy, xz, yy, yz, zz = self._cpp_obj.getFabricTensor()
+        dimensions = 2 if self._simulation.state.box.is2D else 3
+        R = np.array([[xx, xy, xz], [xy, yy, yz], [xz, yz, zz]])
+        R = R[:dimensions, :dimensions]
+        if np.trace(R) == 0:
+            return 0.0
+        deviator = R - np.identity(dimensions) / dimensions
+        return float(
+            np.sqrt(dimensions / (dimensions - 1) * np.sum(deviator**2)))
+
+    @log(requires_run=True)
+    def n_contacts(self):
+        """float: Mean number of contacts per frame."""
+        return self._cpp_obj.n_contacts
+
+    @log(requires_run=True)
+    def n_frames(self):
+        """int: Number of frames accumulated since the last `reset`."""
+        return self._cpp_obj.n_frames
+
+    def reset(self):
+        """Clear the accumulated fabric tensor.
+
+        .. rubric:: Example:
+
+        .. code-block:: python
+
+            fabric.reset()
+        """
+        if self._attached:
+            self._cpp_obj.reset()
+
+
+class SlabProfile(Writer):
+    r"""Accumulate velocity, density, and temperature profiles along y \
+    [RHEOINF].
+
+    Args:
+        trigger (hoomd.trigger.trigger_like): Select the timesteps to
+            accumulate.
+        bins (int): Number of slabs.
+
+    `SlabProfile` splits the box into ``bins`` slabs of equal thickness along
+    the gradient direction :math:`y` (the slabs follow the :math:`xy` tilt of
+    a box sheared by `hoomd.update.BoxShear`). Each time it is triggered, it
+    sums the number :math:`n`, mass :math:`M = \sum m_i`, momentum
+    :math:`\vec{P} = \sum m_i \vec{v}_i`, and :math:`K = \sum m_i v_i^2` of
+    the particles of each type in each slab over all ranks. The streaming
+    velocity :math:`\vec{u} = \vec{P}/M` of the slab is subtracted in the
+    same frame, so the peculiar kinetic energy
+
+    .. math::
+
+        \sum_i m_i (\vec{v}_i - \vec{u})^2 = K - \frac{P^2}{M}
+
+    has :math:`D (n - 1)` degrees of freedom in :math:`D` dimensions. Over
+    the frames since the last `reset`, `SlabProfile` reports the
+    mass-weighted mean velocity :math:`\sum \vec{P} / \sum M`, the mean
+    number density :math:`n / V_\mathrm{slab}`, and the peculiar temperature
+
+    .. math::
+
+        kT = \frac{\sum_\mathrm{frames} (K - P^2/M)}
+                  {\sum_\mathrm{frames} D (n - 1)}
+
+    of each type in each slab. Slabs without particles of a type give NaN
+    velocities and temperatures.
+
+    The sums accumulate until `reset` is called. Log `velocity`, `density`,
+    and `temperature` and call `reset` to write profiles over consecutive
+    time windows.
+
+    .. rubric:: Example:
+
+    .. code-block:: python
+
+        profile = hoomd.md.analyze.SlabProfile(
+            trigger=hoomd.trigger.Periodic(100), bins=20)
+        simulation.operations.writers.append(profile)
+
+    Note:
+        `SlabProfile` is only implemented on the CPU.
+
+    Attributes:
+        bins (int): Number of slabs (read only).
+    """
+
+    def __init__(self, trigger, bins):
+        super().__init__(trigger)
+        self._param_dict.update(ParameterDict(bins=int(bins)))
+
+    def _attach_hook(self):
+        if not isinstance(self._simulation.device, hoomd.device.CPU):
+            raise RuntimeError("SlabProfile is only implemented on the CPU.")
+
+        self._cpp_obj = _md.SlabProfileAnalyzer(
+            self._simulation.state._cpp_sys_def, self.trigger, self.bins)
+
+    @log(category='sequence', requires_run=True)
+    def bin_centers(self):
+        """numpy.ndarray: :math:`y` coordinates of the slab centers \
+        :math:`[\\mathrm{length}]`."""
+        return self._cpp_obj.getBinCenters()
+
+    @log(category='sequence', requires_run=True)
+    def velocity(self):
+        """numpy.ndarray: Mean velocity ``(N_types, bins, 3)`` of each type \
+        in each slab :math:`[\\mathrm{velocity}]`."""
+        return self._cpp_obj.getVelocity()
+
+    @log(category='sequence', requires_run=True)
+    def density(self):
+        """numpy.ndarray: Mean number density ``(N_types, bins)`` of each \
+        type in each slab :math:`[\\mathrm{length}^{-D}]`."""
+        return self._cpp_obj.getDensity()
+
+    @log(category='sequence', requires_run=True)
+    def temperature(self):
+        """numpy.ndarray: Peculiar temperature ``(N_types, bins)`` of each \
+        type in each slab :math:`[\\mathrm{energy}]`."""
+        return self._cpp_obj.getTemperature()
+
+    @log(requires_run=True)
+    def n_frames(self):
+        """int: Number of frames accumulated since the last `reset`."""
+        return self._cpp_obj.n_frames
+
+    def reset(self):
+        """Clear the accumulated sums.
+
+        .. rubric:: Example:
+
+        .. code-block:: python
+
+            profile.reset()
+        """
+        if self._attached:
+            self._cpp_obj.reset()
+
+
+class Voronoi(Writer):
+    r"""Compute the radical Voronoi volume of every particle [RHEOINF].
+
+    Args:
+        trigger (hoomd.trigger.trigger_like): Select the timesteps to compute
+            the cells.
+        r_max (float): Range to search for the neighbors that bound a cell
+            :math:`[\mathrm{length}]`.
+        types (list[str]): Particle types to tessellate, e.g. only the
+            colloids. When `None` (the default), all types are tessellated.
+
+    The radical (Laguerre) cell of particle :math:`i` with radius
+    :math:`R_i = d_i / 2` is bounded by the planes
+
+    .. math::
+
+        (\vec{r}_j - \vec{r}_i) \cdot (\vec{x} - \vec{r}_i)
+        = \frac{r_{ij}^2 + R_i^2 - R_j^2}{2}
+
+    to the other particles :math:`j` of the selected types, so the cells of
+    spheres of different sizes fill the box without cutting through the
+    spheres. With equal diameters the cells are the ordinary Voronoi cells.
+    The cells are periodic and follow the tilt of a box sheared by
+    `hoomd.update.BoxShear`, so their volumes sum to the box volume when all
+    types are selected.
+
+    Each time it is triggered, `Voronoi` computes the cell of every selected
+    particle, in parallel over the MPI ranks and the threads of each rank,
+    and logs the mean, variance, skewness, and kurtosis of the volumes of the
+    frame. Each cell is clipped by the planes of its neighbors in order of
+    distance and is complete once no further neighbor can reach its farthest
+    vertex. A cell that particles beyond ``r_max`` could still cut is counted
+    in `n_incomplete` and a warning is issued; increase ``r_max`` in sparse
+    regions of the system. ``r_max`` must be less than half the box.
+
+    .. rubric:: Example:
+
+    .. code-block:: python
+
+        voronoi = hoomd.md.analyze.Voronoi(
+            trigger=hoomd.trigger.Periodic(1000), r_max=6.0, types=['A'])
+        simulation.operations.writers.append(voronoi)
+
+    Note:
+        `Voronoi` is only implemented on the CPU and in 3D.
+
+    Attributes:
+        r_max (float): Search range :math:`[\mathrm{length}]` (read only).
+    """
+
+    def __init__(self, trigger, r_max, types=None):
+        super().__init__(trigger)
+        self._param_dict.update(ParameterDict(r_max=float(r_max)))
+        self._types = None if types is None else [str(t) for t in types]
+
+    def _attach_hook(self):
+        if not isinstance(self._simulation.device, hoomd.device.CPU):
+            raise RuntimeError("Voronoi is only implemented on the CPU.")
+
+        type_ids = []
+        if self._types is not None:
+            particle_types = self._simulation.state.particle_types
+            type_ids = [particle_types.index(t) for t in self._types]
+        self._cpp_obj = _md.VoronoiAnalyzer(
+            self._simulation.state._cpp_sys_def, self.trigger, self.r_max,
+            type_ids)
+
+    @property
+    def types(self):
+        """list[str]: Particle types tessellated, `None` for all types (read \
+        only)."""
+        return self._types
+
+    @log(category='particle', requires_run=True)
+    def volumes(self):
+        """(*N_particles*, ) `numpy.ndarray` of ``float``: Cell volume of \
+        each particle in the last frame, 0 for the types that are not \
+        tessellated :math:`[\\mathrm{length}^3]`.
+
+        The array is ordered by tag and only available on the root rank,
+        `None` on the other ranks. Every rank must access the property.
+        """
+        return self._cpp_obj.getVolumes()
+
+    @log(requires_run=True)
+    def volume_mean(self):
+        """float: Mean cell volume of the last frame \
+        :math:`[\\mathrm{length}^3]`."""
+        return self._cpp_obj.getMoments()[0]
+
+    @log(requires_run=True)
+    def volume_variance(self):
+        """float: Variance of the cell volumes of the last frame \
+        :math:`[\\mathrm{length}^6]`."""
+        return self._cpp_obj.getMoments()[1]
+
+    @log(requires_run=True)
+    def volume_skewness(self):
+        """float: Skewness :math:`\\mu_3 / \\mu_2^{3/2}` of the cell volumes \
+        of the last frame."""
+        return self._cpp_obj.getMoments()[2]
+
+    @log(requires_run=True)
+    def volume_kurtosis(self):
+        """float: Kurtosis :math:`\\mu_4 / \\mu_2^2` of the cell volumes of \
+        the last frame (3 for a normal distribution)."""
+        return self._cpp_obj.getMoments()[3]
+
+    @log(requires_run=True)
+    def n_incomplete(self):
+        """int: Number of cells of the last frame that particles beyond \
+        ``r_max`` could still cut."""
+        return self._cpp_obj.n_incomplete
+
+
+class PoreSize(Writer):
+    r"""Sample the pore size distributions with random probes [RHEOINF].
+
+    Args:
+        trigger (hoomd.trigger.trigger_like): Select the timesteps to sample.
+        n_probes (int): Number of probes per frame.
+        d_max (float): Largest pore diameter in the histograms
+            :math:`[\mathrm{length}]`.
+        bins (int): Number of bins of the histograms. Defaults to 100.
+        types (list[str]): Particle types that bound the pores, e.g. only the
+            colloids. When `None` (the default), all types are used.
+
+    The particles of the selected types are spheres of radius
+    :math:`R_j = d_j / 2`. The distance from a point :math:`\vec{p}` of the
+    void to the nearest sphere surface is
+
+    .. math::
+
+        \delta(\vec{p}) = \min_j \left( |\vec{p} - \vec{r}_j| - R_j \right).
+
+    Each time it is triggered, `PoreSize` draws ``n_probes`` uniform random
+    points in the void (points inside a sphere are drawn again) and computes
+    two pore diameters for each probe:
+
+    * Torquato: :math:`2 \delta(\vec{p})`, the largest empty sphere centered
+      at the probe.
+    * Gubbins: :math:`2 \delta(\vec{c})`, the largest empty sphere that
+      contains the probe, maximizing :math:`\delta(\vec{c})` subject to
+      :math:`|\vec{c} - \vec{p}| \le \delta(\vec{c})`.
+
+    The distances come from an AABB tree of the spheres of all ranks in the
+    periodic (tilted) box. The largest sphere is found with a pattern search
+    that follows the nearest surfaces and the ridges between them, started
+    from the probe and six nearby points; like any local search it can miss
+    a larger sphere in a rare probe. The probes are split over the MPI ranks
+    and the threads of each rank, and each probe has its own random stream,
+    so the results do not depend on the number of ranks.
+
+    `torquato` and `gubbins` are the probability densities of the diameters
+    over the frames since the last `reset`, diameters beyond ``d_max`` are
+    counted in the last bin. The fraction of the draws that land in the void
+    estimates the `porosity`.
+
+    .. rubric:: Example:
+
+    .. code-block:: python
+
+        pores = hoomd.md.analyze.PoreSize(
+            trigger=hoomd.trigger.Periodic(10000), n_probes=10000,
+            d_max=20.0, types=['B'])
+        simulation.operations.writers.append(pores)
+
+    Note:
+        `PoreSize` is only implemented on the CPU and in 3D.
+
+    Attributes:
+        n_probes (int): Number of probes per frame (read only).
+        d_max (float): Largest pore diameter in the histograms
+            :math:`[\mathrm{length}]` (read only).
+        bins (int): Number of bins of the histograms (read only).
+    """
+
+    def __init__(self, trigger, n_probes, d_max, bins=100, types=None):
+        super().__init__(trigger)
+        self._param_dict.update(
+            ParameterDict(n_probes=int(n_probes),
+                          d_max=float(d_max),
+                          bins=int(bins)))
+        self._types = None if types is None else [str(t) for t in types]
+
+    def _attach_hook(self):
+        if not isinstance(self._simulation.device, hoomd.device.CPU):
+            raise RuntimeError("PoreSize is only implemented on the CPU.")
+
+        type_ids = []
+        if self._types is not None:
+            particle_types = self._simulation.state.particle_types
+            type_ids = [particle_types.index(t) for t in self._types]
+        self._cpp_obj = _md.PoreSizeAnalyzer(
+            self._simulation.state._cpp_sys_def, self.trigger, self.n_probes,
+            self.bins, self.d_max, type_ids)
+
+    @property
+    def types(self):
+        """list[str]: Particle types that bound the pores, `None` for all \
+        types (read only)."""
+        return self._types
+
+    @log(category='sequence', requires_run=True)
+    def bin_centers(self):
+        """numpy.ndarray: Pore diameters at the bin centers \
+        :math:`[\\mathrm{length}]`."""
+        return self._cpp_obj.getBinCenters()
+
+    @log(category='sequence', requires_run=True)
+    def torquato(self):
+        """numpy.ndarray: Probability density of the Torquato pore diameter \
+        :math:`[\\mathrm{length}^{-1}]`."""
+        return self._cpp_obj.getTorquato()
+
+    @log(category='sequence', requires_run=True)
+    def gubbins(self):
+        """numpy.ndarray: Probability density of the Gubbins pore diameter \
+        :math:`[\\mathrm{length}^{-1}]`."""
+        return self._cpp_obj.getGubbins()
+
+    @log(category='sequence', requires_run=True)
+    def probes(self):
+        """(*n_probes*, 8) `numpy.ndarray` of ``float``: Probe position, \
+        pore center, Torquato diameter, and Gubbins diameter of each probe of \
+        the last frame.
+
+        The array is only available on the root rank, `None` on the other
+        ranks. Every rank must access the property. Probes that found no void
+        are NaN.
+        """
+        return self._cpp_obj.getProbes()
+
+    @log(requires_run=True)
+    def mean_diameter_torquato(self):
+        """float: Mean Torquato pore diameter :math:`[\\mathrm{length}]`."""
+        return self._cpp_obj.mean_torquato
+
+    @log(requires_run=True)
+    def mean_diameter_gubbins(self):
+        """float: Mean Gubbins pore diameter :math:`[\\mathrm{length}]`."""
+        return self._cpp_obj.mean_gubbins
+
+    @log(requires_run=True)
+    def porosity(self):
+        """float: Fraction of the random draws in the void."""
+        return self._cpp_obj.porosity
+
+    @log(requires_run=True)
+    def n_frames(self):
+        """int: Number of frames accumulated since the last `reset`."""
+        return self._cpp_obj.n_frames
+
+    def reset(self):
+        """Clear the accumulated histograms.
+
+        .. rubric:: Example:
+
+        .. code-block:: python
+
+            pores.reset()
+        """
+        if self._attached:
+            self._cpp_obj.reset()
+
+
+class PairCorrelationMap(Writer):
+    r"""Accumulate 2D maps of the pair correlation in three planes [RHEOINF].
+
+    Args:
+        trigger (hoomd.trigger.trigger_like): Select the timesteps to
+            accumulate.
+        nlist (hoomd.md.nlist.NeighborList): Neighbor list to take the pairs
+            from, usually the one of a pair force.
+        r_max (float): Half width of the maps :math:`[\mathrm{length}]`.
+        bins (int): Number of bins along each axis of a map.
+        slice_width (float): Half thickness of the slices
+            :math:`[\mathrm{length}]`.
+        types (list[str]): Particle types to count pairs of, e.g. only the
+            colloids. When `None` (the default), all types are counted.
+        phase_bins (int): Number of phase bins per oscillation period.
+            Defaults to 1.
+        period (int): Oscillation period in timesteps. Required when
+            ``phase_bins`` is larger than 1.
+        t_start (int): Timestep of phase 0. Earlier frames are skipped.
+            Defaults to 0.
+
+    Each time it is triggered, `PairCorrelationMap` bins the separation
+    :math:`\vec{r}_{ij} = \vec{r}_j - \vec{r}_i` of every ordered pair of
+    particles of the selected types in three slices through the origin: the
+    flow-gradient plane :math:`(r_x, r_y)` when :math:`|r_z| \le w`, the
+    flow-vorticity plane :math:`(r_x, r_z)` when :math:`|r_y| \le w`, and the
+    gradient-vorticity plane :math:`(r_y, r_z)` when :math:`|r_x| \le w`, with
+    :math:`w` = ``slice_width``. Each map covers :math:`[-r_\mathrm{max},
+    r_\mathrm{max})` along both axes, and the pair correlation
+
+    .. math::
+
+        g(\vec{r}) = \frac{\sum_\mathrm{frames} n(\vec{r})}
+        {\sum_\mathrm{frames} N^2 \Delta V / V}
+
+    compares the number of pairs :math:`n` in a bin to that of an ideal gas
+    with the same number :math:`N` of selected particles in the box volume
+    :math:`V`, with the bin volume :math:`\Delta V = \Delta r^2 \, 2 w`.
+    :math:`\vec{r}_{ij}` is the minimum image in the current box, which
+    includes the tilt of the box sheared by `hoomd.update.BoxShear`
+    (Lees-Edwards boundary conditions).
+
+    Under oscillatory shear (e.g. ``vinf`` a `hoomd.variant.Sinusoid` with
+    angular frequency :math:`\omega` per timestep, so ``period`` is
+    :math:`2\pi/\omega` rounded to a whole number of timesteps), set
+    ``phase_bins`` to accumulate a separate set of maps for each phase
+    :math:`\lfloor n_\mathrm{phase} ((t - t_\mathrm{start}) \bmod
+    \mathrm{period}) / \mathrm{period} \rfloor` of the cycle. Choose a trigger
+    that samples every phase bin.
+
+    `PairCorrelationMap` adds :math:`\sqrt{2 r_\mathrm{max}^2 + w^2}` to the
+    neighbor list's cutoffs of the selected type pairs, so the list holds every
+    pair in the slices. The range must be less than half the box. Neighbor
+    lists with exclusions are not supported.
+
+    The maps accumulate until `reset` is called. Log `pair_correlation` and
+    call `reset` to write averages over consecutive time windows.
+
+    .. rubric:: Example:
+
+    .. code-block:: python
+
+        pcf = hoomd.md.analyze.PairCorrelationMap(
+            trigger=hoomd.trigger.Periodic(100),
+            nlist=hoomd.md.nlist.Cell(buffer=0.4),
+            r_max=2.0,
+            bins=40,
+            slice_width=0.25)
+        simulation.operations.writers.append(pcf)
+
+    Note:
+        `PairCorrelationMap` is only implemented on the CPU.
+
+    Attributes:
+        r_max (float): Half width of the maps :math:`[\mathrm{length}]`
+            (read only).
+        bins (int): Number of bins along each axis of a map (read only).
+        slice_width (float): Half thickness of the slices
+            :math:`[\mathrm{length}]` (read only).
+        phase_bins (int): Number of phase bins (read only).
+        period (int): Oscillation period in timesteps (read only).
+        t_start (int): Timestep of phase 0 (read only).
+    """
+
+    def __init__(self,
+                 trigger,
+                 nlist,
+                 r_max,
+                 bins,
+                 slice_width,
+                 types=None,
+                 phase_bins=1,
+                 period=0,
+                 t_start=0):
+        super().__init__(trigger)
+        self._param_dict.update(
+            ParameterDict(r_max=float(r_max),
+                          bins=int(bins),
+                          slice_width=float(slice_width),
+                          phase_bins=int(phase_bins),
+                          period=int(period),
+                          t_start=int(t_start)))
+        self._nlist = OnlyTypes(NeighborList)(nlist)
+        self._types = None if types is None else [str(t) for t in types]
+
+    def _attach_hook(self):
+        if not isinstance(self._simulation.device, hoomd.device.CPU):
+            raise RuntimeError(
+                "PairCorrelationMap is only implemented on the CPU.")
+
+        self._nlist._attach(self._simulation)
+        type_ids = []
+        if self._types is not None:
+            particle_types = self._simulation.state.particle_types
+            type_ids = [particle_types.index(t) for t in self._types]
+        self._cpp_obj = _md.PairCorrelationMapAnalyzer(
+            self._simulation.state._cpp_sys_def, self.trigger,
+            self._nlist._cpp_obj, self.r_max, self.bins, self.slice_width,
+            type_ids, self.phase_bins, self.period, self.t_start)
+
+    def _detach_hook(self):
+        self._nlist._detach()
+
+    @property
+    def nlist(self):
+        """hoomd.md.nlist.NeighborList: Neighbor list the pairs are taken \
+        from (read only)."""
+        return self._nlist
+
+    @property
+    def types(self):
+        """list[str]: Particle types counted, `None` for all types (read \
+        only)."""
+        return self._types
+
+    @property
+    def planes(self):
+        """list[str]: Axes of each map, in the order of the first index of \
+        `pair_correlation`."""
+        return ['xy', 'xz', 'yz']
+
+    @log(category='sequence', requires_run=True)
+    def bin_centers(self):
+        """numpy.ndarray: Separations at the bin centers along each axis of \
+        a map :math:`[\\mathrm{length}]`."""
+        return self._cpp_obj.getBinCenters()
+
+    @log(category='sequence', requires_run=True)
+    def pair_correlation(self):
+        """(3, *phase_bins*, *bins*, *bins*) `numpy.ndarray` of ``float``: \
+        Accumulated :math:`g(\\vec{r})` per plane (see `planes`) and phase.
+
+        ``pair_correlation[p, k, a, b]`` is the bin at the separation
+        ``(bin_centers[a], bin_centers[b])`` along the two axes of plane
+        ``p`` in phase bin ``k``. Every rank must access the property.
+        """
+        return self._cpp_obj.getMaps()
+
+    @log(category='sequence', requires_run=True)
+    def pair_counts(self):
+        """(3, *phase_bins*, *bins*, *bins*) `numpy.ndarray` of ``float``: \
+        Mean number of ordered pairs per frame in each bin.
+
+        Every rank must access the property.
+        """
+        return self._cpp_obj.getPairCounts()
+
+    @log(category='sequence', requires_run=True)
+    def phase_frames(self):
+        """numpy.ndarray: Number of frames accumulated in each phase bin."""
+        return self._cpp_obj.getPhaseFrames()
+
+    @log(requires_run=True)
+    def n_frames(self):
+        """int: Number of frames accumulated since the last `reset`."""
+        return self._cpp_obj.n_frames
+
+    def reset(self):
+        """Clear the accumulated maps.
+
+        .. rubric:: Example:
+
+        .. code-block:: python
+
+            pcf.reset()
+        """
+        if self._attached:
+            self._cpp_obj.reset()
+
+
+class NumberFluctuation(Writer):
+    r"""Compute the number fluctuations in windows of several sizes [RHEOINF].
+
+    Args:
+        trigger (hoomd.trigger.trigger_like): Select the timesteps to
+            analyze.
+        grid_spacing (float): Target cell width of the count grid
+            :math:`[\mathrm{length}]`.
+        window_widths (list[float]): Widths of the cubic windows
+            :math:`[\mathrm{length}]`.
+        types (list[str]): Particle types to count, e.g. only the colloids.
+            When `None` (the default), all types are counted.
+
+    Each time it is triggered, `NumberFluctuation` counts the particles of the
+    selected types in a grid of :math:`n_x \times n_y \times n_z` cells of
+    about ``grid_spacing`` over the box and builds its summed-area table, the
+    cumulative count of the cells below each corner. The number of particles
+    :math:`N` in a window of :math:`k_x \times k_y \times k_z` cells then
+    takes 8 lookups in the table for any window size. For each width
+    :math:`w`, :math:`k_a` is :math:`w` rounded to whole cells along each
+    axis, and the windows are placed at every cell of the grid, wrapping
+    around the periodic box, to compute
+
+    .. math::
+
+        \langle N \rangle \quad \mathrm{and} \quad
+        \sigma_N^2 = \langle N^2 \rangle - \langle N \rangle^2
+
+    over the windows. For a hyperuniform structure
+    :math:`\sigma_N^2 / \langle N \rangle` decreases with the window volume;
+    for an ideal gas it is 1 (up to the grid size). The number density
+    fluctuation of the analysis scripts is
+    :math:`\sigma_N^2 / (\langle N \rangle \, v)` with the window volume
+    :math:`v`.
+
+    The grid is defined in the fractional coordinates of the box, so in a
+    box sheared by `hoomd.update.BoxShear` the windows are tilted with the
+    box. With MPI, the grids of the ranks are summed and the window positions
+    are split over the ranks.
+
+    .. rubric:: Example:
+
+    .. code-block:: python
+
+        ndf = hoomd.md.analyze.NumberFluctuation(
+            trigger=hoomd.trigger.Periodic(1000),
+            grid_spacing=0.5,
+            window_widths=[1, 2, 4, 8])
+        simulation.operations.writers.append(ndf)
+
+    Note:
+        `NumberFluctuation` is only implemented on the CPU.
+
+    Attributes:
+        grid_spacing (float): Target cell width of the count grid
+            :math:`[\mathrm{length}]` (read only).
+    """
+
+    def __init__(self, trigger, grid_spacing, window_widths, types=None):
+        super().__init__(trigger)
+        self._param_dict.update(ParameterDict(grid_spacing=float(grid_spacing)))
+        self._window_widths = [float(w) for w in window_widths]
+        self._types = None if types is None else [str(t) for t in types]
+
+    def _attach_hook(self):
+        if not isinstance(self._simulation.device, hoomd.device.CPU):
+            raise RuntimeError(
+                "NumberFluctuation is only implemented on the CPU.")
+
+        type_ids = []
+        if self._types is not None:
+            particle_types = self._simulation.state.particle_types
+            type_ids = [particle_types.index(t) for t in self._types]
+        self._cpp_obj = _md.NumberFluctuationAnalyzer(
+            self._simulation.state._cpp_sys_def, self.trigger,
+            self.grid_spacing, self._window_widths, type_ids)
+
+    @property
+    def window_widths(self):
+        """list[float]: Widths of the windows :math:`[\\mathrm{length}]` \
+        (read only)."""
+        return self._window_widths
+
+    @property
+    def types(self):
+        """list[str]: Particle types counted, `None` for all types (read \
+        only)."""
+        return self._types
+
+    @log(category='sequence', requires_run=True)
+    def grid_size(self):
+        """numpy.ndarray: Number of cells :math:`[n_x, n_y, n_z]` of the \
+        grid in the last frame."""
+        return self._cpp_obj.getGridSize()
+
+    @log(category='sequence', requires_run=True)
+    def window_volumes(self):
+        """numpy.ndarray: Volume of the windows of each width in the last \
+        frame :math:`[\\mathrm{length}^3]`."""
+        return self._cpp_obj.getWindowVolumes()
+
+    @log(category='sequence', requires_run=True)
+    def mean(self):
+        """numpy.ndarray: :math:`\\langle N \\rangle` of the windows of each \
+        width in the last frame."""
+        return self._cpp_obj.getMean()
+
+    @log(category='sequence', requires_run=True)
+    def variance(self):
+        """numpy.ndarray: :math:`\\sigma_N^2` of the windows of each width \
+        in the last frame."""
+        return self._cpp_obj.getVariance()
+
+    @log(category='sequence', requires_run=True)
+    def number_fluctuation(self):
+        """numpy.ndarray: :math:`\\sigma_N^2 / \\langle N \\rangle` of the \
+        windows of each width in the last frame (0 for empty windows)."""
+        mean = self._cpp_obj.getMean()
+        variance = self._cpp_obj.getVariance()
+        return np.divide(variance,
+                         mean,
+                         out=np.zeros_like(variance),
+                         where=mean > 0)
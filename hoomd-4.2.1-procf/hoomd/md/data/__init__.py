@@ -1,6 +1,8 @@
 # Copyright (c) 2009-2023 The Regents of the University of Michigan.
 # Part of HOOMD-blue, released under the BSD 3-Clause License.
 
+###### Modified by Rheoinformatic ##~ [RHEOINF] ######
+
 """Force data local access.
 
 `ForceLocalAccess`, `ForceLocalAccessGPU`, and related classes provide direct
@@ -16,4 +18,5 @@ See Also:
 
 from .local_access import _ForceLocalAccessBase, _NeighborListLocalAccessBase
 from .local_access_cpu import ForceLocalAccess, NeighborListLocalAccess
+from .local_access_cpu import CoordinationLocalAccess ##~ [RHEOINF]
 from .local_access_gpu import ForceLocalAccessGPU, NeighborListLocalAccessGPU
@@ -1,6 +1,8 @@
 # Copyright (c) 2009-2023 The Regents of the University of Michigan.
 # Part of HOOMD-blue, released under the BSD 3-Clause License.
 
+###### Modified by Rheoinformatic ##~ [RHEOINF] ######
+
 """Access simulation state data directly."""
 
 from abc import abstractmethod
@@ -74,3 +76,35 @@ class _NeighborListLocalAccessBase(hoomd.data.local_access._LocalAccess):
     def __exit__(self, type, value, traceback):
         self._nlist_obj._in_context_manager = False
         self._exit()
+
+
+##~ add coordination number local access [RHEOINF]
+class _CoordinationLocalAccessBase(hoomd.data.local_access._LocalAccess):
+    __slots__ = ('_entered', '_accessed_fields', '_cpp_obj', '_analyzer_obj')
+
+    @property
+    @abstractmethod
+    def _cpp_cls(self):
+        pass
+
+    _fields = {}
+
+    # Prevents the usage of extensions
+    _global_fields = {'coordination': 'getCoordination'}
+
+    def __init__(self, analyzer_obj, state):
+        super().__init__()
+        self._analyzer_obj = analyzer_obj
+        self._cpp_obj = self._cpp_cls(
+            analyzer_obj._cpp_obj,
+            state._cpp_sys_def.getParticleData().getN())
+
+    def __enter__(self):
+        self._analyzer_obj._in_context_manager = True
+        self._enter()
+        return self
+
+    def __exit__(self, type, value, traceback):
+        self._analyzer_obj._in_context_manager = False
+        self._exit()
+##~
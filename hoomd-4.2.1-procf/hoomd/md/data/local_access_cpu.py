@@ -1,10 +1,14 @@
 # Copyright (c) 2009-2023 The Regents of the University of Michigan.
 # Part of HOOMD-blue, released under the BSD 3-Clause License.
 
+###### Modified by Rheoinformatic ##~ [RHEOINF] ######
+
 """Implement local access classes for the CPU."""
 
 from hoomd.md.data.local_access import _ForceLocalAccessBase, \
     _NeighborListLocalAccessBase
+from hoomd.md.data.local_access import \
+    _CoordinationLocalAccessBase  ##~ [RHEOINF]
 from hoomd.data.array import HOOMDArray
 from hoomd import _hoomd
 from hoomd.md import _md
@@ -58,3 +62,21 @@ class NeighborListLocalAccess(_NeighborListLocalAccessBase):
 
     _cpp_cls = _md.LocalNeighborListDataHost
     _array_cls = HOOMDArray
+
+
+##~ add coordination number local access [RHEOINF]
+class CoordinationLocalAccess(_CoordinationLocalAccessBase):
+    """Access the coordination numbers of `hoomd.md.analyze.Coordination` \
+    on the CPU [RHEOINF].
+
+    The coordination numbers are MPI rank-local and indexed like the local
+    particle arrays (see `hoomd.State.cpu_local_snapshot`).
+
+    Attributes:
+        coordination ((N_particles,) `hoomd.data.array` of ``unsigned int``):
+            Number of contacts of each local particle.
+    """
+
+    _cpp_cls = _md.LocalCoordinationDataHost
+    _array_cls = HOOMDArray
+##~
@@ -44,6 +44,16 @@ void export_PPPMForceCompute(pybind11::module& m);
 void export_wall_data(pybind11::module& m);
 void export_wall_field(pybind11::module& m);
 void export_LocalNeighborListDataHost(pybind11::module& m);
+void export_RDFAnalyzer(pybind11::module& m); //~ add RDFAnalyzer [RHEOINF]
+void export_MSDAnalyzer(pybind11::module& m); //~ add MSDAnalyzer [RHEOINF]
+void export_StructureFactorAnalyzer(pybind11::module& m); //~ add StructureFactorAnalyzer [RHEOINF]
+void export_CoordinationAnalyzer(pybind11::module& m); //~ add CoordinationAnalyzer [RHEOINF]
+void export_FabricAnalyzer(pybind11::module& m); //~ add FabricAnalyzer [RHEOINF]
+void export_SlabProfileAnalyzer(pybind11::module& m); //~ add SlabProfileAnalyzer [RHEOINF]
+void export_VoronoiAnalyzer(pybind11::module& m); //~ add VoronoiAnalyzer [RHEOINF]
+void export_PoreSizeAnalyzer(pybind11::module& m); //~ add PoreSizeAnalyzer [RHEOINF]
+void export_PairCorrelationMapAnalyzer(pybind11::module& m); //~ add PairCorrelationMapAnalyzer [RHEOINF]
+void export_NumberFluctuationAnalyzer(pybind11::module& m); //~ add NumberFluctuationAnalyzer [RHEOINF]
 
 void export_PotentialPairBuckingham(pybind11::module& m);
 void export_PotentialPairLJ(pybind11::module& m);
@@ -380,6 +390,16 @@ PYBIND11_MODULE(_md, m)
     export_ForceComposite(m);
     export_PPPMForceCompute(m);
     export_LocalNeighborListDataHost(m);
+    export_RDFAnalyzer(m); //~ add RDFAnalyzer [RHEOINF]
+    export_MSDAnalyzer(m); //~ add MSDAnalyzer [RHEOINF]
+    export_StructureFactorAnalyzer(m); //~ add StructureFactorAnalyzer [RHEOINF]
+    export_CoordinationAnalyzer(m); //~ add CoordinationAnalyzer [RHEOINF]
+    export_FabricAnalyzer(m); //~ add FabricAnalyzer [RHEOINF]
+    export_SlabProfileAnalyzer(m); //~ add SlabProfileAnalyzer [RHEOINF]
+    export_VoronoiAnalyzer(m); //~ add VoronoiAnalyzer [RHEOINF]
+    export_PoreSizeAnalyzer(m); //~ add PoreSizeAnalyzer [RHEOINF]
+    export_PairCorrelationMapAnalyzer(m); //~ add PairCorrelationMapAnalyzer [RHEOINF]
+    export_NumberFluctuationAnalyzer(m); //~ add NumberFluctuationAnalyzer [RHEOINF]
 
     export_PotentialExternalPeriodic(m);
     export_PotentialExternalElectricField(m);
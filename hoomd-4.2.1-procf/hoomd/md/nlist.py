@@ -1,6 +1,8 @@
 # Copyright (c) 2009-2023 The Regents of the University of Michigan.
 # Part of HOOMD-blue, released under the BSD 3-Clause License.
 
+###### Modified by Rheoinformatic ##~ [RHEOINF] ######
+
 r"""Neighbor list acceleration structures.
 
 Pair forces (`hoomd.md.pair`) use neighbor list data structures to find
@@ -71,6 +73,18 @@ of exclusions. The valid exclusion types are:
   a bond (j,k).
 * ``'1-4'``: Exclude particles *i* and *m* whenever there are bonds (i,j),
   (j,k), and (k,m).
+
+.. rubric:: Compressed storage
+
+Set `NeighborList.compressed` to `True` to keep a compressed copy of the
+neighbor list next to the regular one. After each build, the neighbors of every
+particle are sorted and stored as 16-bit index differences, with an escape code
+for the rare differences that do not fit. The CPU implementations of
+`hoomd.md.pair.Pair` and `hoomd.md.pair.DPDMorse` (and the other DPD pair
+forces) read the compressed copy, which reduces the memory traffic of the pair
+loop in dense systems. The compression relies on `hoomd.tune.ParticleSorter`
+(included in `hoomd.Operations` by default) to give neighboring particles
+nearby indices. `compressed` has no effect on GPU devices.
 """
 
 import hoomd
@@ -103,6 +117,8 @@ class NeighborList(Compute):
         mesh (Mesh): mesh data structure (optional)
         default_r_cut (float): Default cutoff distance :math:`[\mathrm{length}]`
             (optional).
+        compressed (bool): Keep a 16-bit delta encoded copy of the neighbor
+            list for the CPU pair loops (see above).
 
     .. py:attribute:: r_cut
 
@@ -114,8 +130,14 @@ class NeighborList(Compute):
         `float`])
     """
 
-    def __init__(self, buffer, exclusions, rebuild_check_delay, check_dist,
-                 mesh, default_r_cut):
+    def __init__(self,
+                 buffer,
+                 exclusions,
+                 rebuild_check_delay,
+                 check_dist,
+                 mesh,
+                 default_r_cut,
+                 compressed=False):  ##~ add compressed [RHEOINF]
 
         validate_exclusions = OnlyFrom([
             'bond', 'angle', 'constraint', 'dihedral', 'special_pair', 'body',
@@ -134,7 +156,8 @@ class NeighborList(Compute):
         params = ParameterDict(exclusions=[validate_exclusions],
                                buffer=float(buffer),
                                rebuild_check_delay=int(rebuild_check_delay),
-                               check_dist=bool(check_dist))
+                               check_dist=bool(check_dist),
+                               compressed=bool(compressed))  ##~ [RHEOINF]
         params["exclusions"] = exclusions
         self._param_dict.update(params)
 
@@ -322,6 +345,26 @@ class NeighborList(Compute):
         """
         return self._cpp_obj.num_builds
 
+    ##~ add compressed nlist storage [RHEOINF]
+    @log(requires_run=True, default=False)
+    def nlist_bytes(self):
+        """int: Bytes the neighbors occupy as 32-bit indices.
+
+        Counts the stored neighbors of the last build on this MPI rank
+        (available when `compressed` is `True`).
+        """
+        return self._cpp_obj.getNListBytes()
+
+    @log(requires_run=True, default=False)
+    def compressed_nlist_bytes(self):
+        """int: Bytes used by the compressed neighbor list.
+
+        Size of the delta encoded copy from the last build on this MPI rank
+        (available when `compressed` is `True`).
+        """
+        return self._cpp_obj.getCompressedNListBytes()
+    ##~
+
 
 class Cell(NeighborList):
     r"""Neighbor list computed via a cell list.
@@ -339,6 +382,8 @@ class Cell(NeighborList):
             mesh to determine the bond exclusions in addition to all other
             set exclusions.
         default_r_cut
+        compressed (bool): Keep a compressed copy of the neighbor list for
+            the CPU pair loops, see `NeighborList`.
 
     `Cell` finds neighboring particles using a fixed width cell list, allowing
     for *O(kN)* construction of the neighbor list where *k* is the number of
@@ -379,10 +424,11 @@ class Cell(NeighborList):
                  check_dist=True,
                  deterministic=False,
                  mesh=None,
-                 default_r_cut=0.0):
+                 default_r_cut=0.0,
+                 compressed=False):  ##~ add compressed [RHEOINF]
 
         super().__init__(buffer, exclusions, rebuild_check_delay, check_dist,
-                         mesh, default_r_cut)
+                         mesh, default_r_cut, compressed)
 
         self._param_dict.update(
             ParameterDict(deterministic=bool(deterministic)))
@@ -435,6 +481,8 @@ class Stencil(NeighborList):
         mesh (Mesh): When a mesh object is passed, the neighbor list uses the
             mesh to determine the bond exclusions in addition to all other
             set exclusions.
+        compressed (bool): Keep a compressed copy of the neighbor list for
+            the CPU pair loops, see `NeighborList`.
 
     `Stencil` finds neighboring particles using a fixed width cell list, for
     *O(kN)* construction of the neighbor list where *k* is the number of
@@ -487,10 +535,11 @@ class Stencil(NeighborList):
                  check_dist=True,
                  deterministic=False,
                  mesh=None,
-                 default_r_cut=0.0):
+                 default_r_cut=0.0,
+                 compressed=False):  ##~ add compressed [RHEOINF]
 
         super().__init__(buffer, exclusions, rebuild_check_delay, check_dist,
-                         mesh, default_r_cut)
+                         mesh, default_r_cut, compressed)
 
         params = ParameterDict(deterministic=bool(deterministic),
                                cell_width=float(cell_width))
@@ -520,6 +569,8 @@ class Tree(NeighborList):
         mesh (Mesh): When a mesh object is passed, the neighbor list uses the
             mesh to determine the bond exclusions in addition to all other
             set exclusions.
+        compressed (bool): Keep a compressed copy of the neighbor list for
+            the CPU pair loops, see `NeighborList`.
 
     `Tree` creates a neighbor list using a bounding volume hierarchy (BVH) tree
     traversal in :math:`O(N \\log N)` time. A BVH tree of axis-aligned bounding
@@ -560,10 +611,11 @@ class Tree(NeighborList):
                  rebuild_check_delay=1,
                  check_dist=True,
                  mesh=None,
-                 default_r_cut=0.0):
+                 default_r_cut=0.0,
+                 compressed=False):  ##~ add compressed [RHEOINF]
 
         super().__init__(buffer, exclusions, rebuild_check_delay, check_dist,
-                         mesh, default_r_cut)
+                         mesh, default_r_cut, compressed)
 
     def _attach_hook(self):
         if isinstance(self._simulation.device, hoomd.device.CPU):
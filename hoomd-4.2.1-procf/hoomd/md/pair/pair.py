@@ -704,7 +704,25 @@ class Morse(Pair):
             TypeParameterDict(D0=float, alpha=float, r0=float, f_contact=float, scaled_D0=bool(scaled_D0), len_keys=2)) ##~ add f_contact and scaled_D0 [RHEOINF]
         self._add_typeparam(params)
 
-class DPD(Pair):
+##~ add ghost update overlap [RHEOINF]
+class _GhostUpdateOverlap:
+    """Report the pairs computed while ghost particles are communicated."""
+
+    @property
+    def overlap_interior_count(self):
+        """int: Number of local particles whose pairs this rank computed
+        while ghost particles were communicated, summed over all steps (read
+        only). Stays 0 when ``overlap_comm`` is `False`, and with a single
+        rank. [RHEOINF]"""
+        if not self._attached:
+            return 0
+        return self._cpp_obj.overlap_interior_count
+
+
+##~
+
+
+class DPD(_GhostUpdateOverlap, Pair):  ##~ [RHEOINF]
     r"""Dissipative Particle Dynamics.
 
     Args:
@@ -712,6 +730,10 @@ class DPD(Pair):
         kT (`hoomd.variant` or `float`): Temperature of
             thermostat :math:`[\mathrm{energy}]`.
         default_r_cut (float): Default cutoff radius :math:`[\mathrm{length}]`.
+        cell_list (bool): Find pairs from a cell list every step instead of
+            building the neighbor list (CPU only). [RHEOINF]
+        overlap_comm (bool): Compute the pairs of interior particles while
+            ghost particles are communicated (MPI, CPU only). [RHEOINF]
 
     `DPD` computes the DPD pair force on every particle in the simulation state.
     DPD includes a an interaction potential, pairwise drag force, and pairwise
@@ -782,6 +804,28 @@ class DPD(Pair):
         Energy shifting/smoothing mode: ``"none"``.
 
         Type: `str`
+
+    .. py:attribute:: cell_list
+
+        When `True`, pairs are found by searching the 27 cells around each
+        particle in a cell list with the width of the largest ``r_cut``,
+        rebuilt every step, and the neighbor list is not built (it still sets
+        the ghost layer width and the MPI migration criterion). Neighbor list
+        exclusions are not supported in this mode. Only available on the CPU.
+        [RHEOINF]
+
+        Type: `bool`
+
+    .. py:attribute:: overlap_comm
+
+        When `True`, and the simulation is domain decomposed, the pairs of
+        particles with no ghost neighbors are computed while the ghost
+        positions and velocities are communicated, and only the remaining
+        particles are computed afterwards. This applies on steps without a
+        neighbor list build. Has no effect with a single rank or in
+        ``cell_list`` mode. Only available on the CPU. [RHEOINF]
+
+        Type: `bool`
     """
     _cpp_class_name = "PotentialPairDPDThermoDPD"
     _accepted_modes = ("none",)
@@ -791,6 +835,8 @@ class DPD(Pair):
         nlist,
         kT,
         default_r_cut=None,
+        cell_list=False, ##~ add cell list pair evaluation [RHEOINF]
+        overlap_comm=False, ##~ add ghost update overlap [RHEOINF]
     ):
         super().__init__(nlist=nlist,
                          default_r_cut=default_r_cut,
@@ -800,7 +846,9 @@ class DPD(Pair):
             'params', 'particle_types',
             TypeParameterDict(A=float, gamma=float, len_keys=2))
         self._add_typeparam(params)
-        param_dict = ParameterDict(kT=hoomd.variant.Variant)
+        param_dict = ParameterDict(kT=hoomd.variant.Variant,
+                                   cell_list=bool(cell_list), ##~ add cell_list [RHEOINF]
+                                   overlap_comm=bool(overlap_comm)) ##~ add overlap_comm [RHEOINF]
         param_dict["kT"] = kT
         self._param_dict.update(param_dict)
 
@@ -865,7 +913,7 @@ class DPDConservative(Pair):
         self._add_typeparam(params)
 
 
-class DPDLJ(Pair):
+class DPDLJ(_GhostUpdateOverlap, Pair):  ##~ [RHEOINF]
     r"""Dissipative Particle Dynamics with the LJ conservative force.
 
     Args:
@@ -874,6 +922,10 @@ class DPDLJ(Pair):
             thermostat :math:`[\mathrm{energy}]`.
         default_r_cut (float): Default cutoff radius :math:`[\mathrm{length}]`.
         mode (str): Energy shifting mode.
+        cell_list (bool): Find pairs from a cell list every step instead of
+            building the neighbor list (CPU only). [RHEOINF]
+        overlap_comm (bool): Compute the pairs of interior particles while
+            ghost particles are communicated (MPI, CPU only). [RHEOINF]
 
     `DPDLJ` computes the `DPD` thermostat combined with the `LJ` pair force
     on every particle in the simulation state with:
@@ -937,11 +989,33 @@ class DPDLJ(Pair):
         Energy shifting/smoothing mode: ``"none"`` or ``"shift"``.
 
         Type: `str`
+
+    .. py:attribute:: cell_list
+
+        When `True`, pairs are found by searching the 27 cells around each
+        particle in a cell list with the width of the largest ``r_cut``,
+        rebuilt every step, and the neighbor list is not built (it still sets
+        the ghost layer width and the MPI migration criterion). Neighbor list
+        exclusions are not supported in this mode. Only available on the CPU.
+        [RHEOINF]
+
+        Type: `bool`
+
+    .. py:attribute:: overlap_comm
+
+        When `True`, and the simulation is domain decomposed, the pairs of
+        particles with no ghost neighbors are computed while the ghost
+        positions and velocities are communicated, and only the remaining
+        particles are computed afterwards. This applies on steps without a
+        neighbor list build. Has no effect with a single rank or in
+        ``cell_list`` mode. Only available on the CPU. [RHEOINF]
+
+        Type: `bool`
     """
     _cpp_class_name = "PotentialPairDPDThermoLJ"
     _accepted_modes = ("none", "shift")
 
-    def __init__(self, nlist, kT, default_r_cut=None, mode='none'):
+    def __init__(self, nlist, kT, default_r_cut=None, mode='none', cell_list=False, overlap_comm=False): ##~ add cell_list, overlap_comm [RHEOINF]
 
         super().__init__(nlist=nlist,
                          default_r_cut=default_r_cut,
@@ -955,7 +1029,9 @@ class DPDLJ(Pair):
                               len_keys=2))
         self._add_typeparam(params)
 
-        d = ParameterDict(kT=hoomd.variant.Variant)
+        d = ParameterDict(kT=hoomd.variant.Variant,
+                          cell_list=bool(cell_list), ##~ add cell_list [RHEOINF]
+                          overlap_comm=bool(overlap_comm)) ##~ add overlap_comm [RHEOINF]
         self._param_dict.update(d)
 
         self.kT = kT
@@ -1903,7 +1979,7 @@ class LJGauss(Pair):
         self._add_typeparam(params)
 
 ##~ add DPDMorse() [RHEOINF] 
-class DPDMorse(Pair):
+class DPDMorse(_GhostUpdateOverlap, Pair):  ##~ [RHEOINF]
     r"""DPD Morse pair force. Added by Rheoinformatic research group for simulating attractive colloidal particles.
 
     Args:
@@ -1915,6 +1991,8 @@ class DPDMorse(Pair):
         scaled_D0 (bool): defauly value for on/off class attribute used to scale D0 by particle size (D0*((radius_i_radius_j)/2) [RHEOINF]
         a1 (float): default value for a1; NOTE: this is legacy code from before polydispersity, a1 is NO LONGER USED [RHEOINF]
         a2 (float): default value for a2; NOTE: this is legacy code from before polydispersity, a2 is NO LONGER USED [RHEOINF]
+        cell_list (bool): Find pairs from a cell list every step instead of building the neighbor list (CPU only). [RHEOINF]
+        overlap_comm (bool): Compute the pairs of interior particles while ghost particles are communicated (MPI, CPU only). [RHEOINF]
 
     `DPDMorse` computes the Morse pair force, semi-hard potential contact force, and short-range lubrication (squeezing) force approximation  on every particle in the simulation
     state:
@@ -1972,6 +2050,28 @@ Type: `TypeParameter` [`tuple` [``particle_type``, ``particle_type``],
         Energy shifting/smoothing mode: ``"none"``, ``"shift"``, or ``"xplor"``.
 
         Type: `str`
+
+    .. py:attribute:: cell_list
+
+        When `True`, pairs are found by searching the 27 cells around each
+        particle in a cell list with the width of the largest ``r_cut``,
+        rebuilt every step, and the neighbor list is not built (it still sets
+        the ghost layer width and the MPI migration criterion). Neighbor list
+        exclusions are not supported in this mode. Only available on the CPU.
+        [RHEOINF]
+
+        Type: `bool`
+
+    .. py:attribute:: overlap_comm
+
+        When `True`, and the simulation is domain decomposed, the pairs of
+        particles with no ghost neighbors are computed while the ghost
+        positions and velocities are communicated, and only the remaining
+        particles are computed afterwards. This applies on steps without a
+        neighbor list build. Has no effect with a single rank or in
+        ``cell_list`` mode. Only available on the CPU. [RHEOINF]
+
+        Type: `bool`
     """
     _cpp_class_name = "PotentialPairDPDThermoDPDMorse"
     _accepted_modes = ("none",)
@@ -1980,7 +2080,7 @@ Type: `TypeParameter` [`tuple` [``particle_type``, ``particle_type``],
     _default_a2 = 0.0
     _default_sys_kT = 0.1
 
-    def __init__(self, nlist, kT, default_r_cut=None, bond_calc=False, scaled_D0=None, a1=None, a2=None, sys_kT=None):
+    def __init__(self, nlist, kT, default_r_cut=None, bond_calc=False, scaled_D0=None, a1=None, a2=None, sys_kT=None, cell_list=False, overlap_comm=False): ##~ add cell_list, overlap_comm [RHEOINF]
         super().__init__(nlist=nlist,
                          default_r_cut=default_r_cut,
                          default_r_on=0,
@@ -2012,7 +2112,9 @@ Type: `TypeParameter` [`tuple` [``particle_type``, ``particle_type``],
                               sys_kT=float(sys_kT),
                               len_keys=2))
         self._add_typeparam(params)
-        param_dict = ParameterDict(kT=hoomd.variant.Variant)
+        param_dict = ParameterDict(kT=hoomd.variant.Variant,
+                                   cell_list=bool(cell_list), ##~ add cell_list [RHEOINF]
+                                   overlap_comm=bool(overlap_comm)) ##~ add overlap_comm [RHEOINF]
         param_dict["kT"] = kT
         self._param_dict.update(param_dict)
         #self._param_dict.update(
@@ -0,0 +1,137 @@
+########## Created by the Rheoinformatic research group ##########
+# HOOMD-blue:
+#   Copyright (c) 2009-2023 The Regents of the University of Michigan.
+#   Part of HOOMD-blue, released under the BSD 3-Clause License.
+#
+# This file:
+#   Written by the Rheoinformatic research group (2026)
+
+########## Created by Rheoinformatic ##~ [RHEOINF] ##########
+
+import hoomd
+import numpy as np
+import pytest
+
+
+class _Recorder(hoomd.custom.Action):
+    """Record the thermodynamic quantities of every step."""
+
+    flags = [hoomd.custom.Action.Flags.PRESSURE_TENSOR]
+
+    def __init__(self, thermo):
+        self.thermo = thermo
+        self.rows = []
+
+    def act(self, timestep):
+        self.rows.append((timestep, np.array(self.thermo.pressure_tensor),
+                          self.thermo.kinetic_temperature))
+
+
+def _make_sim(simulation_factory, lattice_snapshot_factory):
+    sim = simulation_factory(lattice_snapshot_factory(n=6, a=1.3, r=0.05))
+    sim.state.thermalize_particle_momenta(filter=hoomd.filter.All(), kT=1.0)
+    lj = hoomd.md.pair.LJ(nlist=hoomd.md.nlist.Cell(buffer=0.4),
+                          default_r_cut=2.5)
+    lj.params[('A', 'A')] = dict(epsilon=1, sigma=1)
+    nve = hoomd.md.methods.ConstantVolume(filter=hoomd.filter.All())
+    sim.operations.integrator = hoomd.md.Integrator(dt=0.005,
+                                                    methods=[nve],
+                                                    forces=[lj])
+    thermo = hoomd.md.compute.ThermodynamicQuantities(
+        filter=hoomd.filter.All())
+    sim.operations.computes.append(thermo)
+    return sim, thermo
+
+
+def _add_writers(sim, thermo, filename, mode):
+    logger = hoomd.logging.Logger(categories=['scalar', 'sequence'])
+    logger.add(thermo, quantities=['pressure_tensor', 'kinetic_temperature'])
+    binary_log = hoomd.write.BinaryLog(trigger=hoomd.trigger.Periodic(1),
+                                       filename=filename,
+                                       logger=logger,
+                                       mode=mode,
+                                       buffer_size=4)
+    sim.operations.writers.append(binary_log)
+    recorder = hoomd.write.CustomWriter(action=_Recorder(thermo),
+                                        trigger=hoomd.trigger.Periodic(1))
+    sim.operations.writers.append(recorder)
+    return binary_log, recorder.action
+
+
+def _check(log, rows):
+    pressure_tensor = [k for k in log if k.endswith('pressure_tensor')][0]
+    temperature = [k for k in log if k.endswith('kinetic_temperature')][0]
+    np.testing.assert_array_equal(log['timestep'], [r[0] for r in rows])
+    assert log[pressure_tensor].shape == (len(rows), 6)
+    np.testing.assert_array_equal(log[pressure_tensor], [r[1] for r in rows])
+    np.testing.assert_array_equal(log[temperature], [r[2] for r in rows])
+
+
+def test_binary_log_write_read(simulation_factory, lattice_snapshot_factory,
+                               tmp_path):
+    """Ensure that the file holds every logged row, also across runs."""
+    filename = tmp_path / "log.bin"
+    sim, thermo = _make_sim(simulation_factory, lattice_snapshot_factory)
+    binary_log, recorder = _add_writers(sim, thermo, filename, 'w')
+    assert binary_log.buffer_size == 4
+
+    # 10 rows: two full blocks and a partial one written at the end of run
+    sim.run(10)
+    if sim.device.communicator.rank == 0:
+        _check(hoomd.write.BinaryLog.read(filename), recorder.rows)
+
+    sim.run(3)
+    if sim.device.communicator.rank == 0:
+        _check(hoomd.write.BinaryLog.read(filename), recorder.rows)
+
+        # a partially written last block is ignored
+        with open(filename, 'ab') as f:
+            f.write(np.uint64(5).tobytes() + b'\0' * 12)
+        _check(hoomd.write.BinaryLog.read(filename), recorder.rows)
+
+
+def test_binary_log_append(simulation_factory, lattice_snapshot_factory,
+                           tmp_path):
+    """Ensure that a new writer appends to a file of the same quantities."""
+    filename = tmp_path / "log.bin"
+    sim, thermo = _make_sim(simulation_factory, lattice_snapshot_factory)
+    binary_log, recorder = _add_writers(sim, thermo, filename, 'w')
+    sim.run(5)
+    rows = list(recorder.rows)
+    sim.operations.writers.clear()
+
+    _, recorder = _add_writers(sim, thermo, filename, 'a')
+    sim.run(5)
+    if sim.device.communicator.rank == 0:
+        _check(hoomd.write.BinaryLog.read(filename), rows + recorder.rows)
+
+
+def test_binary_log_append_after_truncated_block(simulation_factory,
+                                                 lattice_snapshot_factory,
+                                                 tmp_path):
+    """Ensure that appending removes a truncated last block first."""
+    filename = tmp_path / "log.bin"
+    sim, thermo = _make_sim(simulation_factory, lattice_snapshot_factory)
+    binary_log, recorder = _add_writers(sim, thermo, filename, 'w')
+    sim.run(5)
+    rows = list(recorder.rows)
+    sim.operations.writers.clear()
+
+    # a block of 5 rows cut off while writing
+    if sim.device.communicator.rank == 0:
+        with open(filename, 'ab') as f:
+            f.write(np.uint64(5).tobytes() + b'\0' * 12)
+
+    _, recorder = _add_writers(sim, thermo, filename, 'a')
+    sim.run(5)
+    if sim.device.communicator.rank == 0:
+        _check(hoomd.write.BinaryLog.read(filename), rows + recorder.rows)
+
+
+def test_binary_log_rejects_categories(tmp_path):
+    """Ensure that only scalar and sequence quantities are accepted."""
+    logger = hoomd.logging.Logger(categories=['scalar', 'string'])
+    with pytest.raises(ValueError):
+        hoomd.write.BinaryLog(trigger=hoomd.trigger.Periodic(1),
+                              filename=tmp_path / "log.bin",
+                              logger=logger)
@@ -0,0 +1,94 @@
+########## Created by the Rheoinformatic research group ##########
+# HOOMD-blue:
+#   Copyright (c) 2009-2023 The Regents of the University of Michigan.
+#   Part of HOOMD-blue, released under the BSD 3-Clause License.
+#
+# This file:
+#   Written by the Rheoinformatic research group (2026)
+
+########## Created by Rheoinformatic ##~ [RHEOINF] ##########
+
+import hoomd
+import numpy as np
+import pytest
+try:
+    import gsd.hoomd  # noqa: F401 - the checkpoint topology is a gsd file
+except ImportError:
+    pytest.skip("gsd not available", allow_module_level=True)
+
+
+def _add_operations(sim):
+    nlist = hoomd.md.nlist.Cell(buffer=0.4)
+    lj = hoomd.md.pair.LJ(nlist=nlist, default_r_cut=2.5)
+    lj.params[('A', 'A')] = dict(epsilon=1, sigma=1)
+    mttk = hoomd.md.methods.thermostats.MTTK(kT=1.5, tau=0.5)
+    nvt = hoomd.md.methods.ConstantVolume(filter=hoomd.filter.All(),
+                                          thermostat=mttk)
+    sim.operations.integrator = hoomd.md.Integrator(dt=0.005,
+                                                    methods=[nvt],
+                                                    forces=[lj])
+    # the ramp starts at the current step: a restart must restore the saved one
+    shear = hoomd.update.BoxShear(trigger=hoomd.trigger.Periodic(1),
+                                  vinf=hoomd.variant.Ramp(
+                                      0, 0.5, sim.timestep, 40),
+                                  deltaT=0.005,
+                                  flip=True)
+    sim.operations.updaters.append(shear)
+    return mttk
+
+
+def test_checkpoint_restart_is_exact(simulation_factory,
+                                     lattice_snapshot_factory, tmp_path):
+    """Ensure that a restart continues the run bit for bit."""
+    path = tmp_path / "checkpoint"
+    snapshot = lattice_snapshot_factory(n=6, a=1.3, r=0.05)
+
+    sim = simulation_factory(snapshot)
+    sim.seed = 7
+    sim.state.thermalize_particle_momenta(filter=hoomd.filter.All(), kT=1.5)
+    mttk = _add_operations(sim)
+    sim.run(25)
+    hoomd.write.Checkpoint.write(sim, path)
+    sim.run(30)
+    reference = sim.state.get_snapshot()
+    reference_dof = mttk.translational_dof
+
+    restart = simulation_factory()
+    restart.create_state_from_checkpoint(path)
+    assert restart.timestep == 25
+    assert restart.seed == 7
+    mttk = _add_operations(restart)
+    restart.run(30)
+    snapshot = restart.state.get_snapshot()
+
+    assert restart.timestep == sim.timestep
+    assert mttk.translational_dof == reference_dof
+    assert restart.state.box == sim.state.box
+    if snapshot.communicator.rank == 0:
+        np.testing.assert_array_equal(snapshot.configuration.box,
+                                      reference.configuration.box)
+        np.testing.assert_array_equal(snapshot.particles.position,
+                                      reference.particles.position)
+        np.testing.assert_array_equal(snapshot.particles.velocity,
+                                      reference.particles.velocity)
+        np.testing.assert_array_equal(snapshot.particles.image,
+                                      reference.particles.image)
+
+
+def test_checkpoint_rejects_missing_operations(simulation_factory,
+                                               lattice_snapshot_factory,
+                                               tmp_path):
+    """Ensure that a restart without the checkpointed forces fails."""
+    path = tmp_path / "checkpoint"
+    sim = simulation_factory(lattice_snapshot_factory(n=6, a=1.3))
+    _add_operations(sim)
+    sim.run(2)
+    hoomd.write.Checkpoint.write(sim, path)
+
+    restart = simulation_factory()
+    restart.create_state_from_checkpoint(path)
+    nve = hoomd.md.methods.ConstantVolume(filter=hoomd.filter.All())
+    restart.operations.integrator = hoomd.md.Integrator(dt=0.005,
+                                                        methods=[nve])
+    with pytest.raises(RuntimeError):
+        restart.run(1)
@@ -0,0 +1,100 @@
+########## Created by the Rheoinformatic research group ##########
+# HOOMD-blue:
+#   Copyright (c) 2009-2023 The Regents of the University of Michigan.
+#   Part of HOOMD-blue, released under the BSD 3-Clause License.
+#
+# This file:
+#   Written by the Rheoinformatic research group (2026)
+
+########## Created by Rheoinformatic ##~ [RHEOINF] ##########
+
+import hoomd
+import numpy as np
+import pytest
+
+# simple cubic lattice: every particle has 6 nearest neighbors at r = 1
+N_CELLS = 6
+
+
+@pytest.mark.cpu
+@pytest.mark.parametrize("diameter, z", [(1.0, 6), (0.8, 0)])
+def test_coordination_simple_cubic(simulation_factory,
+                                   lattice_snapshot_factory, diameter, z):
+    """Ensure that the contacts are counted in the surface-surface gap."""
+    snapshot = lattice_snapshot_factory(n=N_CELLS, a=1.0)
+    if snapshot.communicator.rank == 0:
+        snapshot.particles.diameter[:] = diameter
+    sim = simulation_factory(snapshot)
+    coordination = hoomd.md.analyze.Coordination(
+        trigger=hoomd.trigger.Periodic(1),
+        nlist=hoomd.md.nlist.Cell(buffer=0.4),
+        gap=0.1,
+        max_z=8)
+    sim.operations.writers.append(coordination)
+    sim.run(2)
+
+    histogram = coordination.z_histogram
+    expected = np.zeros(9)
+    expected[z] = 1
+    if sim.device.communicator.rank == 0:
+        assert coordination.n_frames == 2
+        assert coordination.z_avg == pytest.approx(z)
+        np.testing.assert_allclose(histogram, expected)
+
+    coordination.reset()
+    assert coordination.n_frames == 0
+
+
+@pytest.mark.cpu
+def test_coordination_types(simulation_factory, lattice_snapshot_factory):
+    """Ensure that only contacts between the selected types are counted."""
+    snapshot = lattice_snapshot_factory(particle_types=['A', 'B'],
+                                        n=N_CELLS,
+                                        a=1.0)
+    if snapshot.communicator.rank == 0:
+        # alternate the types along x: each B has 4 B neighbors in y and z
+        x = np.round(snapshot.particles.position[:, 0] + N_CELLS / 2 - 0.5)
+        snapshot.particles.typeid[:] = x.astype(int) % 2
+    sim = simulation_factory(snapshot)
+    coordination = hoomd.md.analyze.Coordination(
+        trigger=hoomd.trigger.Periodic(1),
+        nlist=hoomd.md.nlist.Cell(buffer=0.4),
+        gap=0.1,
+        types=['B'])
+    sim.operations.writers.append(coordination)
+    sim.run(1)
+
+    histogram = coordination.z_histogram
+    if sim.device.communicator.rank == 0:
+        assert coordination.z_avg == pytest.approx(4)
+        assert histogram[4] == pytest.approx(1)
+
+    with coordination.cpu_local_coordination_arrays as arrays:
+        with sim.state.cpu_local_snapshot as data:
+            typeid = np.array(data.particles.typeid, copy=True)
+        z = np.array(arrays.coordination, copy=True)
+        np.testing.assert_array_equal(z[typeid == 1], 4)
+        np.testing.assert_array_equal(z[typeid == 0], 0)
+
+
+@pytest.mark.cpu
+def test_coordination_local_access(simulation_factory,
+                                   lattice_snapshot_factory):
+    """Ensure that the local arrays require an attached analyzer."""
+    sim = simulation_factory(lattice_snapshot_factory(n=N_CELLS, a=1.0))
+    coordination = hoomd.md.analyze.Coordination(
+        trigger=hoomd.trigger.Periodic(10),
+        nlist=hoomd.md.nlist.Cell(buffer=0.4),
+        gap=0.1)
+    sim.operations.writers.append(coordination)
+
+    with pytest.raises(hoomd.error.DataAccessError):
+        with coordination.cpu_local_coordination_arrays:
+            pass
+
+    # the arrays are computed on access, also between triggered steps
+    sim.run(1)
+    with coordination.cpu_local_coordination_arrays as arrays:
+        assert len(arrays.coordination) == sim.state._cpp_sys_def \
+            .getParticleData().getN()
+        np.testing.assert_array_equal(arrays.coordination, 6)
@@ -0,0 +1,64 @@
+########## Created by the Rheoinformatic research group ##########
+# HOOMD-blue:
+#   Copyright (c) 2009-2023 The Regents of the University of Michigan.
+#   Part of HOOMD-blue, released under the BSD 3-Clause License.
+#
+# This file:
+#   Written by the Rheoinformatic research group (2026)
+
+########## Created by Rheoinformatic ##~ [RHEOINF] ##########
+
+import hoomd
+import numpy as np
+import pytest
+
+# simple cubic lattice: every particle has 6 nearest neighbors at r = 1
+N_CELLS = 6
+N = N_CELLS**3
+
+
+@pytest.mark.cpu
+def test_fabric_simple_cubic(simulation_factory, lattice_snapshot_factory):
+    """Ensure that the contacts along the lattice axes give isotropic R."""
+    sim = simulation_factory(lattice_snapshot_factory(n=N_CELLS, a=1.0))
+    fabric = hoomd.md.analyze.Fabric(trigger=hoomd.trigger.Periodic(1),
+                                     nlist=hoomd.md.nlist.Cell(buffer=0.4),
+                                     gap=0.1)
+    sim.operations.writers.append(fabric)
+    sim.run(2)
+
+    assert fabric.n_frames == 2
+    assert fabric.n_contacts == pytest.approx(3 * N)
+    assert fabric.rxy == pytest.approx(0, abs=1e-6)
+    np.testing.assert_allclose(fabric.fabric_tensor,
+                               [1 / 3, 0, 0, 1 / 3, 0, 1 / 3],
+                               atol=1e-6)
+    assert fabric.anisotropy == pytest.approx(0, abs=1e-6)
+
+    fabric.reset()
+    assert fabric.n_frames == 0
+    np.testing.assert_array_equal(fabric.fabric_tensor, 0)
+
+
+@pytest.mark.cpu
+def test_fabric_tilted_box(simulation_factory, two_particle_snapshot_factory):
+    """Ensure that a contact across the y faces of a tilted box is found."""
+    snapshot = two_particle_snapshot_factory(L=10)
+    if snapshot.communicator.rank == 0:
+        snapshot.configuration.box = [10, 10, 10, 0.3, 0, 0]
+        # the image of particle 1 across the y face is shifted by xy * L_y
+        # in x: r_01 = (0.6, 0.8, 0), in contact
+        snapshot.particles.position[:] = [[0, 4.6, 0.1], [-2.4, -4.6, 0.1]]
+    sim = simulation_factory(snapshot)
+    fabric = hoomd.md.analyze.Fabric(trigger=hoomd.trigger.Periodic(1),
+                                     nlist=hoomd.md.nlist.Cell(buffer=0.4),
+                                     gap=0.1)
+    sim.operations.writers.append(fabric)
+    sim.run(1)
+
+    assert fabric.n_contacts == pytest.approx(1)
+    assert fabric.rxy == pytest.approx(0.48 / 2)
+    np.testing.assert_allclose(fabric.fabric_tensor,
+                               [0.36, 0.48, 0, 0.64, 0, 0],
+                               atol=1e-6)
+    assert fabric.anisotropy == pytest.approx(1)
@@ -1,6 +1,8 @@
 # Copyright (c) 2009-2023 The Regents of the University of Michigan.
 # Part of HOOMD-blue, released under the BSD 3-Clause License.
 
+###### Modified by Rheoinformatic ##~ [RHEOINF] ######
+
 import hoomd
 import numpy as np
 import pytest
@@ -541,3 +543,253 @@ def test_write_gsd_no_dynamic(simulation_factory, hoomd_snapshot, tmp_path):
             assert not f.chunk_exists(frame=1, name='configuration/box')
             assert not f.chunk_exists(frame=1, name='particles/N')
             assert not f.chunk_exists(frame=1, name='particles/position')
+
+
+##~ asynchronous writes [RHEOINF]
+def test_write_gsd_async(simulation_factory, hoomd_snapshot, tmp_path):
+    """Ensure that asynchronous GSD writes match synchronous ones."""
+    filenames = {}
+    for async_write in (False, True):
+        filenames[async_write] = tmp_path / f"test_async_{async_write}.gsd"
+
+        sim = simulation_factory(hoomd_snapshot)
+        sim.operations.integrator = lj_integrator()
+        gsd_writer = hoomd.write.GSD(filename=filenames[async_write],
+                                     trigger=hoomd.trigger.Periodic(3),
+                                     mode='wb',
+                                     dynamic=['property', 'momentum'],
+                                     async_write=async_write)
+        sim.operations.writers.append(gsd_writer)
+        assert gsd_writer.async_write == async_write
+
+        sim.run(10)
+        gsd_writer.flush()
+
+        # checkpoints flush the queued frames
+        hoomd.write.GSD.write(state=sim.state,
+                              mode='wb',
+                              filename=str(tmp_path / "checkpoint.gsd"))
+        sim.run(5)
+        gsd_writer.async_write = False
+        gsd_writer.flush()
+
+    if sim.device.communicator.rank == 0:
+        with gsd.hoomd.open(name=filenames[False], mode='r') as sync_traj, \
+                gsd.hoomd.open(name=filenames[True], mode='r') as async_traj:
+            assert len(async_traj) == len(sync_traj) == 5
+            for sync_frame, async_frame in zip(sync_traj, async_traj):
+                assert (async_frame.configuration.step
+                        == sync_frame.configuration.step)
+                np.testing.assert_array_equal(async_frame.particles.position,
+                                              sync_frame.particles.position)
+                np.testing.assert_array_equal(async_frame.particles.velocity,
+                                              sync_frame.particles.velocity)
+##~
+
+
+##~ parallel writes [RHEOINF]
+def test_write_gsd_parallel(simulation_factory, hoomd_snapshot, tmp_path):
+    """Ensure that MPI-IO GSD writes match gathered ones."""
+    filenames = {}
+    for parallel_write in (False, True):
+        filenames[parallel_write] = (tmp_path
+                                     / f"test_parallel_{parallel_write}.gsd")
+
+        sim = simulation_factory(hoomd_snapshot)
+        sim.operations.integrator = lj_integrator()
+        gsd_writer = hoomd.write.GSD(filename=filenames[parallel_write],
+                                     trigger=hoomd.trigger.Periodic(5),
+                                     mode='wb',
+                                     dynamic=['property', 'momentum'],
+                                     parallel_write=parallel_write)
+        sim.operations.writers.append(gsd_writer)
+        assert gsd_writer.parallel_write == parallel_write
+
+        sim.run(11)
+        gsd_writer.flush()
+
+    if sim.device.communicator.rank == 0:
+        with gsd.hoomd.open(name=filenames[False], mode='r') as gather_traj, \
+                gsd.hoomd.open(name=filenames[True],
+                               mode='r') as parallel_traj:
+            assert len(parallel_traj) == len(gather_traj) == 2
+            for gather_frame, parallel_frame in zip(gather_traj,
+                                                    parallel_traj):
+                assert (parallel_frame.configuration.step
+                        == gather_frame.configuration.step)
+                assert (parallel_frame.particles.N
+                        == gather_frame.particles.N)
+                np.testing.assert_array_equal(
+                    parallel_frame.particles.typeid,
+                    gather_frame.particles.typeid)
+                np.testing.assert_array_equal(
+                    parallel_frame.particles.position,
+                    gather_frame.particles.position)
+                np.testing.assert_array_equal(
+                    parallel_frame.particles.velocity,
+                    gather_frame.particles.velocity)
+                np.testing.assert_array_equal(parallel_frame.particles.image,
+                                              gather_frame.particles.image)
+##~
+
+
+##~ output groups [RHEOINF]
+def test_write_gsd_groups(simulation_factory, hoomd_snapshot, tmp_path):
+    """Ensure that output groups select the particles of each frame."""
+    filename = tmp_path / "test_groups.gsd"
+
+    sim = simulation_factory(hoomd_snapshot)
+    sim.operations.integrator = lj_integrator()
+    gsd_writer = hoomd.write.GSD(
+        filename=filename,
+        trigger=hoomd.trigger.Periodic(2),
+        filter=hoomd.filter.Type(['t2']),
+        mode='wb',
+        dynamic=['property', 'momentum'],
+        groups=[(hoomd.filter.Type(['t1']), hoomd.trigger.Periodic(6))])
+    sim.operations.writers.append(gsd_writer)
+    assert len(gsd_writer.groups) == 1
+
+    sim.run(12)
+    gsd_writer.flush()
+
+    snapshot = sim.state.get_snapshot()
+    if sim.device.communicator.rank == 0:
+        N = snapshot.particles.N
+        t2_tags = np.nonzero(snapshot.particles.typeid == 1)[0]
+        with gsd.hoomd.open(name=filename, mode='r') as traj:
+            steps = [frame.configuration.step for frame in traj]
+            assert steps == [2, 4, 6, 8, 10, 12]
+            for frame in traj:
+                tags = frame.log['gsd_groups/tag']
+                active = frame.log['gsd_groups/active']
+                if frame.configuration.step % 6 == 0:
+                    assert frame.particles.N == N
+                    np.testing.assert_array_equal(active, [1, 1])
+                    np.testing.assert_array_equal(tags, np.arange(N))
+                else:
+                    assert frame.particles.N == len(t2_tags)
+                    np.testing.assert_array_equal(active, [1, 0])
+                    np.testing.assert_array_equal(tags, t2_tags)
+                    np.testing.assert_array_equal(frame.particles.typeid,
+                                                  np.ones(len(t2_tags)))
+                assert frame.particles.velocity.shape == (frame.particles.N,
+                                                          3)
+##~
+
+
+##~ quantization [RHEOINF]
+def test_write_gsd_quantize(simulation_factory, hoomd_snapshot, tmp_path):
+    """Ensure that quantized positions and velocities are within tolerance."""
+    filename = tmp_path / "test_quantize.gsd"
+    position_tolerance = 0.01
+    velocity_tolerance = 0.05
+
+    sim = simulation_factory(hoomd_snapshot)
+    gsd_writer = hoomd.write.GSD(filename=filename,
+                                 trigger=hoomd.trigger.Periodic(1),
+                                 mode='wb',
+                                 dynamic=['property', 'momentum'],
+                                 position_tolerance=position_tolerance,
+                                 velocity_tolerance=velocity_tolerance)
+    sim.operations.writers.append(gsd_writer)
+    assert gsd_writer.position_tolerance == position_tolerance
+
+    sim.run(1)
+    gsd_writer.flush()
+
+    snapshot = sim.state.get_snapshot()
+    if sim.device.communicator.rank == 0:
+        with gsd.hoomd.open(name=filename, mode='r') as traj:
+            frame = traj[0]
+            L = snapshot.configuration.box[0:3]
+            delta = frame.particles.position - snapshot.particles.position
+            delta -= L * np.round(delta / L)
+            assert np.max(np.abs(delta)) <= position_tolerance + 1e-6
+            # multiples of the power of two step 2**-6
+            np.testing.assert_array_equal(
+                np.mod(frame.particles.position, 2.0**-6), 0)
+            delta = frame.particles.velocity - snapshot.particles.velocity
+            assert np.max(np.abs(delta)) <= velocity_tolerance + 1e-6
+
+    # GSDReader reads the quantized file
+    sim = simulation_factory()
+    sim.create_state_from_gsd(filename=filename)
+    assert sim.state.N_particles == hoomd_snapshot.particles.N
+##~
+
+
+##~ distributed read [RHEOINF]
+def test_create_state_from_gsd_distributed(simulation_factory, hoomd_snapshot,
+                                           tmp_path):
+    """Ensure that the distributed read matches the root rank read."""
+    filename = str(tmp_path / "test_distributed.gsd")
+    sim = simulation_factory(hoomd_snapshot)
+    hoomd.write.GSD.write(state=sim.state, filename=filename, mode='wb')
+
+    snapshots = {}
+    for distributed in (False, True):
+        sim = simulation_factory()
+        sim.create_state_from_gsd(filename=filename, distributed=distributed)
+        assert sim.state.N_particles == hoomd_snapshot.particles.N
+        snapshots[distributed] = sim.state.get_snapshot()
+
+    if snapshots[True].communicator.rank == 0:
+        assert_equivalent_snapshots(snapshots[False], snapshots[True])
+        assert snapshots[True].bonds.N == hoomd_snapshot.bonds.N
+        assert snapshots[True].pairs.N == hoomd_snapshot.pairs.N
+##~
+
+
+##~ output groups with a dynamic filter [RHEOINF]
+class _ParityFilter(hoomd.filter.CustomFilter):
+    """Select the even or odd tags."""
+
+    def __init__(self):
+        self.parity = 0
+
+    def __hash__(self):
+        return id(self)
+
+    def __eq__(self, other):
+        return self is other
+
+    def __call__(self, state):
+        with state.cpu_local_snapshot as snap:
+            tags = snap.particles.tag
+            return np.copy(tags[tags % 2 == self.parity])
+
+
+def test_write_gsd_groups_dynamic_filter(simulation_factory, hoomd_snapshot,
+                                         tmp_path):
+    """Ensure that frames follow a dynamic group that keeps its size."""
+    filename = tmp_path / "test_groups_dynamic.gsd"
+
+    sim = simulation_factory(hoomd_snapshot)
+    sim.operations.integrator = lj_integrator()
+    parity_filter = _ParityFilter()
+    sim.operations.updaters.append(
+        hoomd.update.FilterUpdater(1, [parity_filter]))
+    gsd_writer = hoomd.write.GSD(
+        filename=filename,
+        trigger=hoomd.trigger.Periodic(1),
+        filter=hoomd.filter.Tags([0, 1]),
+        mode='wb',
+        groups=[(parity_filter, hoomd.trigger.Periodic(1))])
+    sim.operations.writers.append(gsd_writer)
+
+    # the union has N/2 + 1 members for either parity
+    sim.run(1)
+    parity_filter.parity = 1
+    sim.run(1)
+    gsd_writer.flush()
+
+    if sim.device.communicator.rank == 0:
+        N = hoomd_snapshot.particles.N
+        with gsd.hoomd.open(name=filename, mode='r') as traj:
+            assert len(traj) == 2
+            for parity, frame in enumerate(traj):
+                expected = np.union1d([0, 1], np.arange(parity, N, 2))
+                np.testing.assert_array_equal(frame.log['gsd_groups/tag'],
+                                              expected)
+##~
@@ -0,0 +1,112 @@
+########## Created by the Rheoinformatic research group ##########
+# HOOMD-blue:
+#   Copyright (c) 2009-2023 The Regents of the University of Michigan.
+#   Part of HOOMD-blue, released under the BSD 3-Clause License.
+#
+# This file:
+#   Written by the Rheoinformatic research group (2026)
+
+########## Created by Rheoinformatic ##~ [RHEOINF] ##########
+
+import hoomd
+import numpy as np
+import pytest
+
+N_CELLS = 4
+DT = 0.1
+
+
+def _free_particles(simulation_factory, lattice_snapshot_factory, velocity):
+    """Simulation of non-interacting particles with the given velocities."""
+    snapshot = lattice_snapshot_factory(n=N_CELLS, a=1.0)
+    if snapshot.communicator.rank == 0:
+        snapshot.particles.velocity[:] = velocity(snapshot.particles.position)
+    sim = simulation_factory(snapshot)
+    nve = hoomd.md.methods.ConstantVolume(filter=hoomd.filter.All())
+    sim.operations.integrator = hoomd.md.Integrator(dt=DT, methods=[nve])
+    return sim
+
+
+@pytest.mark.cpu
+def test_msd_ballistic(simulation_factory, lattice_snapshot_factory):
+    """Ensure that the lags and the unwrapped displacements are correct."""
+    v = np.array([0.5, -0.2, 0.1])
+    sim = _free_particles(simulation_factory, lattice_snapshot_factory,
+                          lambda pos: v)
+    msd = hoomd.md.analyze.MSD(trigger=hoomd.trigger.Periodic(1),
+                               block_size=4,
+                               n_levels=3)
+    sim.operations.writers.append(msd)
+    # the particles cross the box several times
+    sim.run(100)
+
+    lags = msd.lag_steps
+    values = msd.msd
+    alpha = msd.non_gaussian
+    if sim.device.communicator.rank == 0:
+        assert msd.n_frames == 100
+        np.testing.assert_allclose(lags, [1, 2, 3, 4, 8, 12, 16, 32, 48])
+        np.testing.assert_allclose(values[0],
+                                   np.dot(v, v) * (lags * DT)**2,
+                                   rtol=1e-4)
+        # every particle moves by the same distance: alpha_2 = d/(d+2) - 1
+        np.testing.assert_allclose(alpha[0], 3 / 5 - 1, atol=1e-4)
+
+    msd.reset()
+    assert msd.n_frames == 0
+    assert np.all(np.isnan(msd.msd))
+
+
+@pytest.mark.cpu
+def test_msd_lag_counts(simulation_factory, lattice_snapshot_factory):
+    """Ensure that the first frame is a time origin of every level."""
+    sim = _free_particles(simulation_factory, lattice_snapshot_factory,
+                          lambda pos: 0 * pos)
+    msd = hoomd.md.analyze.MSD(trigger=hoomd.trigger.Periodic(1),
+                               block_size=4,
+                               n_levels=3)
+    sim.operations.writers.append(msd)
+    sim.run(100)
+
+    # frames 0 .. 99, level l correlates the multiples of 4^l: 100, 25, and 7
+    # frames give n - k origins at the lag of k frames of the level
+    np.testing.assert_array_equal(msd.lag_counts,
+                                  [99, 98, 97, 24, 23, 22, 6, 5, 4])
+    msd.reset()
+    np.testing.assert_array_equal(msd.lag_counts, 0)
+
+
+@pytest.mark.cpu
+@pytest.mark.parametrize("subtract_affine", [True, False])
+def test_msd_shear(simulation_factory, lattice_snapshot_factory,
+                   subtract_affine):
+    """Ensure that the affine flow is removed across tilt flips."""
+    erate = 0.1
+    L = N_CELLS
+    sim = _free_particles(
+        simulation_factory, lattice_snapshot_factory,
+        lambda pos: np.stack([erate * pos[:, 1], 0 * pos[:, 1], 0 * pos[:, 1]],
+                             axis=1))
+    shear = hoomd.update.BoxShear(trigger=hoomd.trigger.Periodic(1),
+                                  vinf=hoomd.variant.Constant(erate * L),
+                                  deltaT=DT,
+                                  flip=True)
+    sim.operations.updaters.append(shear)
+    msd = hoomd.md.analyze.MSD(trigger=hoomd.trigger.Periodic(1),
+                               block_size=4,
+                               n_levels=3,
+                               subtract_affine=subtract_affine)
+    sim.operations.writers.append(msd)
+    # the tilt grows by 0.01 per step and flips once
+    sim.run(100)
+
+    lags = msd.lag_steps
+    values = msd.msd
+    if sim.device.communicator.rank == 0:
+        np.testing.assert_allclose(msd.strain, 100 * erate * DT, atol=0.02)
+        if subtract_affine:
+            np.testing.assert_allclose(values[0], 0, atol=1e-8)
+        else:
+            y = (np.arange(N_CELLS) - N_CELLS / 2 + 0.5)
+            expected = erate**2 * np.mean(y**2) * (lags * DT)**2
+            np.testing.assert_allclose(values[0], expected, rtol=1e-4)
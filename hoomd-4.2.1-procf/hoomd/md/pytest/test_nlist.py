@@ -62,6 +62,7 @@ def test_common_params(nlist_params):
         "exclusions": ('bond',),
         "rebuild_check_delay": 1,
         "check_dist": True,
+        "compressed": False,
     }
     _assert_nlist_params(nlist, default_params_dict)
     new_params_dict = {
@@ -76,6 +77,8 @@ def test_common_params(nlist_params):
             np.random.randint(8),
         "check_dist":
             False,
+        "compressed":
+            True,
     }
     for param in new_params_dict.keys():
         setattr(nlist, param, new_params_dict[param])
@@ -191,6 +194,33 @@ def test_cell_properties(simulation_factory, lattice_snapshot_factory):
     assert nlist.allocated_particles_per_cell >= 1
 
 
+def test_compressed_forces(nlist_params, simulation_factory,
+                           lattice_snapshot_factory):
+    """The compressed neighbor list must give the same forces."""
+    nlist_cls, required_args = nlist_params
+    snap = lattice_snapshot_factory(n=6, a=1.2, r=0.1)
+    forces = []
+    for compressed in (False, True):
+        nlist = nlist_cls(**required_args, buffer=0.4, compressed=compressed)
+        lj = hoomd.md.pair.LJ(nlist, default_r_cut=2.5)
+        lj.params[('A', 'A')] = dict(epsilon=1, sigma=1)
+        lj.params[('A', 'B')] = dict(epsilon=1, sigma=1)
+        lj.params[('B', 'B')] = dict(epsilon=1, sigma=1)
+        integrator = hoomd.md.Integrator(0.005, forces=[lj])
+
+        sim = simulation_factory(snap)
+        sim.operations.integrator = integrator
+        sim.run(0)
+        forces.append(lj.forces)
+
+        if isinstance(sim.device, hoomd.device.CPU) and compressed:
+            assert nlist.compressed_nlist_bytes > 0
+            assert nlist.compressed_nlist_bytes < nlist.nlist_bytes
+
+    if forces[0] is not None:
+        np.testing.assert_allclose(forces[0], forces[1], rtol=1e-6, atol=1e-8)
+
+
 def test_logging():
     base_loggables = {
         'shortest_rebuild': {
@@ -200,6 +230,14 @@ def test_logging():
         'num_builds': {
             'category': LoggerCategories.scalar,
             'default': False
+        },
+        'nlist_bytes': {
+            'category': LoggerCategories.scalar,
+            'default': False
+        },
+        'compressed_nlist_bytes': {
+            'category': LoggerCategories.scalar,
+            'default': False
         }
     }
     logging_check(hoomd.md.nlist.NeighborList, ('md', 'nlist'), base_loggables)
@@ -0,0 +1,61 @@
+########## Created by the Rheoinformatic research group ##########
+# HOOMD-blue:
+#   Copyright (c) 2009-2023 The Regents of the University of Michigan.
+#   Part of HOOMD-blue, released under the BSD 3-Clause License.
+#
+# This file:
+#   Written by the Rheoinformatic research group (2026)
+
+########## Created by Rheoinformatic ##~ [RHEOINF] ##########
+
+import hoomd
+import numpy as np
+import pytest
+
+# simple cubic lattice shifted to the cell centers: one particle per cell
+N_CELLS = 6
+
+
+@pytest.mark.cpu
+def test_number_fluctuation_lattice(simulation_factory,
+                                    lattice_snapshot_factory):
+    """Ensure that every window of a lattice holds the same number."""
+    snapshot = lattice_snapshot_factory(n=N_CELLS, a=1.0)
+    if snapshot.communicator.rank == 0:
+        snapshot.particles.position[:] += 0.5
+    sim = simulation_factory(snapshot)
+    ndf = hoomd.md.analyze.NumberFluctuation(
+        trigger=hoomd.trigger.Periodic(1),
+        grid_spacing=1.0,
+        window_widths=[1, 2, 3.9])
+    sim.operations.writers.append(ndf)
+    sim.run(1)
+
+    np.testing.assert_array_equal(ndf.grid_size, [6, 6, 6])
+    np.testing.assert_allclose(ndf.window_volumes, [1, 8, 64])
+    np.testing.assert_allclose(ndf.mean, [1, 8, 64])
+    np.testing.assert_allclose(ndf.variance, 0, atol=1e-9)
+    np.testing.assert_allclose(ndf.number_fluctuation, 0, atol=1e-9)
+
+
+@pytest.mark.cpu
+def test_number_fluctuation_single_particle(simulation_factory,
+                                            two_particle_snapshot_factory):
+    """Ensure the variance of the windows around one selected particle."""
+    snapshot = two_particle_snapshot_factory(particle_types=['A', 'B'], L=4)
+    if snapshot.communicator.rank == 0:
+        snapshot.particles.typeid[:] = [0, 1]
+    sim = simulation_factory(snapshot)
+    ndf = hoomd.md.analyze.NumberFluctuation(
+        trigger=hoomd.trigger.Periodic(1),
+        grid_spacing=1.0,
+        window_widths=[1, 2, 4],
+        types=['A'])
+    sim.operations.writers.append(ndf)
+    sim.run(1)
+
+    # 1, 8, and all 64 of the 64 windows hold the particle
+    fraction = np.array([1, 8, 64]) / 64
+    np.testing.assert_allclose(ndf.mean, fraction)
+    np.testing.assert_allclose(ndf.variance, fraction - fraction**2)
+    np.testing.assert_allclose(ndf.number_fluctuation, 1 - fraction)
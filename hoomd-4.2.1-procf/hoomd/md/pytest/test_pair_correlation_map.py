@@ -0,0 +1,105 @@
+########## Created by the Rheoinformatic research group ##########
+# HOOMD-blue:
+#   Copyright (c) 2009-2023 The Regents of the University of Michigan.
+#   Part of HOOMD-blue, released under the BSD 3-Clause License.
+#
+# This file:
+#   Written by the Rheoinformatic research group (2026)
+
+########## Created by Rheoinformatic ##~ [RHEOINF] ##########
+
+import hoomd
+import numpy as np
+import pytest
+
+# simple cubic lattice: with 3 bins of width 1 from -1.5 to 1.5, every
+# particle has one neighbor in each bin of a plane except the center
+N_CELLS = 6
+N = N_CELLS**3
+
+
+@pytest.mark.cpu
+def test_pair_correlation_map_simple_cubic(simulation_factory,
+                                           lattice_snapshot_factory):
+    """Ensure that the lattice neighbors fill the outer bins of each map."""
+    sim = simulation_factory(lattice_snapshot_factory(n=N_CELLS, a=1.0))
+    pcf = hoomd.md.analyze.PairCorrelationMap(
+        trigger=hoomd.trigger.Periodic(1),
+        nlist=hoomd.md.nlist.Cell(buffer=0.4),
+        r_max=1.5,
+        bins=3,
+        slice_width=0.25)
+    sim.operations.writers.append(pcf)
+    sim.run(2)
+
+    expected = np.full((3, 1, 3, 3), float(N))
+    expected[:, :, 1, 1] = 0
+    np.testing.assert_allclose(pcf.bin_centers, [-1, 0, 1])
+    np.testing.assert_allclose(pcf.pair_counts, expected)
+    # V = N, so an ideal gas has N^2 / V * 1 * 0.5 = N / 2 pairs per bin
+    np.testing.assert_allclose(pcf.pair_correlation, expected / (N / 2))
+    np.testing.assert_array_equal(pcf.phase_frames, [2])
+    assert pcf.n_frames == 2
+
+    pcf.reset()
+    assert pcf.n_frames == 0
+    np.testing.assert_array_equal(pcf.pair_counts, 0)
+
+
+@pytest.mark.cpu
+def test_pair_correlation_map_tilted_box(simulation_factory,
+                                         two_particle_snapshot_factory):
+    """Ensure that a pair across the y faces of a tilted box is binned."""
+    snapshot = two_particle_snapshot_factory(L=10)
+    if snapshot.communicator.rank == 0:
+        snapshot.configuration.box = [10, 10, 10, 0.3, 0, 0]
+        # the image of particle 1 across the y face is shifted by xy * L_y
+        # in x: r_01 = (0.6, 0.8, 0)
+        snapshot.particles.position[:] = [[0, 4.6, 0.1], [-2.4, -4.6, 0.1]]
+    sim = simulation_factory(snapshot)
+    pcf = hoomd.md.analyze.PairCorrelationMap(
+        trigger=hoomd.trigger.Periodic(1),
+        nlist=hoomd.md.nlist.Cell(buffer=0.4),
+        r_max=1.5,
+        bins=3,
+        slice_width=0.25)
+    sim.operations.writers.append(pcf)
+    sim.run(1)
+
+    expected = np.zeros((3, 1, 3, 3))
+    expected[0, 0, 2, 2] = 1
+    expected[0, 0, 0, 0] = 1
+    np.testing.assert_allclose(pcf.pair_counts, expected)
+
+
+@pytest.mark.cpu
+def test_pair_correlation_map_phase_bins(simulation_factory,
+                                         lattice_snapshot_factory):
+    """Ensure that the frames are split over the phase bins."""
+    sim = simulation_factory(lattice_snapshot_factory(n=N_CELLS, a=1.0))
+    pcf = hoomd.md.analyze.PairCorrelationMap(
+        trigger=hoomd.trigger.Periodic(1),
+        nlist=hoomd.md.nlist.Cell(buffer=0.4),
+        r_max=1.5,
+        bins=3,
+        slice_width=0.25,
+        phase_bins=2,
+        period=4)
+    sim.operations.writers.append(pcf)
+    sim.run(8)
+
+    assert pcf.n_frames == 8
+    np.testing.assert_array_equal(pcf.phase_frames, [4, 4])
+    assert pcf.pair_correlation.shape == (3, 2, 3, 3)
+    np.testing.assert_allclose(pcf.pair_counts[:, 0], pcf.pair_counts[:, 1])
+
+    with pytest.raises(RuntimeError):
+        missing_period = hoomd.md.analyze.PairCorrelationMap(
+            trigger=hoomd.trigger.Periodic(1),
+            nlist=hoomd.md.nlist.Cell(buffer=0.4),
+            r_max=1.5,
+            bins=3,
+            slice_width=0.25,
+            phase_bins=2)
+        sim.operations.writers.append(missing_period)
+        sim.run(0)
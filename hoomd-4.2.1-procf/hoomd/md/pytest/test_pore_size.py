@@ -0,0 +1,94 @@
+########## Created by the Rheoinformatic research group ##########
+# HOOMD-blue:
+#   Copyright (c) 2009-2023 The Regents of the University of Michigan.
+#   Part of HOOMD-blue, released under the BSD 3-Clause License.
+#
+# This file:
+#   Written by the Rheoinformatic research group (2026)
+
+########## Created by Rheoinformatic ##~ [RHEOINF] ##########
+
+import hoomd
+import numpy as np
+import pytest
+
+# simple cubic lattice of spheres with radius R, the largest pores are
+# centered in the cubes between them
+N_CELLS = 4
+R = 0.3
+DELTA_CUBE = np.sqrt(3) / 2 - R
+
+
+def sphere_lattice(lattice_snapshot_factory):
+    snapshot = lattice_snapshot_factory(n=N_CELLS, a=1.0)
+    if snapshot.communicator.rank == 0:
+        snapshot.particles.diameter[:] = 2 * R
+    return snapshot
+
+
+@pytest.mark.cpu
+def test_pore_size_lattice(simulation_factory, lattice_snapshot_factory):
+    """Ensure that both pore sizes match the lattice geometry."""
+    sim = simulation_factory(sphere_lattice(lattice_snapshot_factory))
+    pores = hoomd.md.analyze.PoreSize(trigger=hoomd.trigger.Periodic(1),
+                                      n_probes=500,
+                                      d_max=2.0,
+                                      bins=40)
+    sim.operations.writers.append(pores)
+    sim.run(1)
+
+    probes = pores.probes
+    if sim.device.communicator.rank == 0:
+        assert probes.shape == (500, 8)
+        p = probes[:, :3]
+        centers = sim.state.get_snapshot().particles.position
+        L = N_CELLS
+        d = p[:, None, :] - centers[None, :, :]
+        d -= L * np.round(d / L)
+        delta = np.min(np.linalg.norm(d, axis=-1), axis=1) - R
+        assert np.all(delta > 0)
+        np.testing.assert_allclose(probes[:, 6], 2 * delta, rtol=1e-5)
+
+        # the pore center holds the probe, and no pore exceeds the cube
+        gubbins = probes[:, 7]
+        assert np.all(gubbins >= probes[:, 6] - 1e-6)
+        assert np.all(gubbins <= 2 * DELTA_CUBE + 1e-6)
+        inside = np.linalg.norm(probes[:, 3:6] - p, axis=1)
+        assert np.all(inside <= gubbins / 2 + 1e-6)
+
+        # probes in the sphere of a cube center belong to that pore
+        in_cube = np.linalg.norm(p - np.round(p), axis=1) < DELTA_CUBE - 0.01
+        assert np.any(in_cube)
+        np.testing.assert_allclose(gubbins[in_cube],
+                                   2 * DELTA_CUBE,
+                                   rtol=1e-2)
+
+    porosity = 1 - 4 / 3 * np.pi * R**3
+    np.testing.assert_allclose(pores.porosity, porosity, rtol=0.05)
+    assert pores.mean_diameter_gubbins > pores.mean_diameter_torquato
+
+
+@pytest.mark.cpu
+def test_pore_size_histograms(simulation_factory, lattice_snapshot_factory):
+    """Ensure that the histograms are normalized and reset."""
+    sim = simulation_factory(sphere_lattice(lattice_snapshot_factory))
+    pores = hoomd.md.analyze.PoreSize(trigger=hoomd.trigger.Periodic(1),
+                                      n_probes=200,
+                                      d_max=2.0,
+                                      bins=40)
+    sim.operations.writers.append(pores)
+    sim.run(2)
+
+    assert pores.n_frames == 2
+    width = pores.d_max / pores.bins
+    np.testing.assert_allclose(pores.bin_centers,
+                               (np.arange(40) + 0.5) * width)
+    np.testing.assert_allclose(np.sum(pores.torquato) * width, 1)
+    np.testing.assert_allclose(np.sum(pores.gubbins) * width, 1)
+    # no pore is larger than the sphere in the center of a cube
+    large = pores.bin_centers > 2 * DELTA_CUBE + width
+    assert np.all(pores.gubbins[large] == 0)
+
+    pores.reset()
+    assert pores.n_frames == 0
+    np.testing.assert_allclose(pores.torquato, 0)
@@ -1339,6 +1339,101 @@ def test_forces_multiple_lists(simulation_factory,
     assert lj._use_count == 0
 
 
+def test_dpd_cell_list(simulation_factory, lattice_snapshot_factory):
+    """Cell list pair evaluation must give the same DPD forces."""
+    snap = lattice_snapshot_factory(n=6, a=0.8, r=0.1)
+    forces = []
+    for cell_list in (False, True):
+        dpd = hoomd.md.pair.DPD(nlist=hoomd.md.nlist.Cell(buffer=0.4),
+                                kT=1.0,
+                                default_r_cut=1.0,
+                                cell_list=cell_list)
+        dpd.params[('A', 'A')] = dict(A=25.0, gamma=4.5)
+        integrator = hoomd.md.Integrator(0.005, forces=[dpd])
+
+        sim = simulation_factory(snap)
+        if isinstance(sim.device, hoomd.device.GPU) and cell_list:
+            with pytest.raises(RuntimeError):
+                sim.operations.integrator = integrator
+                sim.run(0)
+            return
+        sim.operations.integrator = integrator
+        sim.run(0)
+        assert dpd.cell_list == cell_list
+        forces.append(dpd.forces)
+
+    if forces[0] is not None:
+        np.testing.assert_allclose(forces[0], forces[1], rtol=1e-6, atol=1e-8)
+
+
+def test_dpd_overlap_comm(simulation_factory, lattice_snapshot_factory):
+    """Overlapping the ghost update must give the same DPD forces."""
+    snap = lattice_snapshot_factory(n=6, a=0.8, r=0.1)
+    forces = []
+    for overlap_comm in (False, True):
+        dpd = hoomd.md.pair.DPD(nlist=hoomd.md.nlist.Cell(buffer=0.4),
+                                kT=1.0,
+                                default_r_cut=1.0,
+                                overlap_comm=overlap_comm)
+        dpd.params[('A', 'A')] = dict(A=25.0, gamma=4.5)
+        integrator = hoomd.md.Integrator(0.005, forces=[dpd])
+        integrator.methods.append(
+            hoomd.md.methods.ConstantVolume(filter=hoomd.filter.All()))
+
+        sim = simulation_factory(snap)
+        if isinstance(sim.device, hoomd.device.GPU) and overlap_comm:
+            with pytest.raises(RuntimeError):
+                sim.operations.integrator = integrator
+                sim.run(0)
+            return
+        sim.operations.integrator = integrator
+        # steps without a neighbor list build use the overlapped loop
+        sim.run(5)
+        assert dpd.overlap_comm == overlap_comm
+        if sim.device.communicator.num_ranks == 1:
+            # no ghost update to overlap with
+            assert dpd.overlap_interior_count == 0
+        forces.append(dpd.forces)
+
+    if forces[0] is not None:
+        np.testing.assert_allclose(forces[0], forces[1], rtol=1e-5, atol=1e-7)
+
+
+def test_dpd_overlap_comm_mpi(device, simulation_factory,
+                              lattice_snapshot_factory):
+    """Overlapping the ghost update across ranks gives the same DPD forces."""
+    if device.communicator.num_ranks < 2:
+        pytest.skip("Test requires more than one rank")
+    if isinstance(device, hoomd.device.GPU):
+        pytest.skip("Overlapping the ghost update is not supported on the GPU")
+
+    # wide enough that every domain has interior and boundary particles
+    snap = lattice_snapshot_factory(n=10, a=0.8, r=0.1)
+    forces = []
+    for overlap_comm in (False, True):
+        dpd = hoomd.md.pair.DPD(nlist=hoomd.md.nlist.Cell(buffer=0.4),
+                                kT=1.0,
+                                default_r_cut=1.0,
+                                overlap_comm=overlap_comm)
+        dpd.params[('A', 'A')] = dict(A=25.0, gamma=4.5)
+        integrator = hoomd.md.Integrator(0.005, forces=[dpd])
+        integrator.methods.append(
+            hoomd.md.methods.ConstantVolume(filter=hoomd.filter.All()))
+
+        sim = simulation_factory(snap)
+        sim.operations.integrator = integrator
+        # the first step builds the list, the others use the overlapped loop
+        sim.run(5)
+        if overlap_comm:
+            assert dpd.overlap_interior_count > 0
+        else:
+            assert dpd.overlap_interior_count == 0
+        forces.append(dpd.forces)
+
+    if device.communicator.rank == 0:
+        np.testing.assert_allclose(forces[0], forces[1], rtol=1e-5, atol=1e-7)
+
+
 @pytest.mark.parametrize("forces_and_energies",
                          _forces_and_energies(),
                          ids=lambda x: x.pair_potential.__name__)
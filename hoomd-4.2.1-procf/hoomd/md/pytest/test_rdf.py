@@ -0,0 +1,85 @@
+########## Created by the Rheoinformatic research group ##########
+# HOOMD-blue:
+#   Copyright (c) 2009-2023 The Regents of the University of Michigan.
+#   Part of HOOMD-blue, released under the BSD 3-Clause License.
+#
+# This file:
+#   Written by the Rheoinformatic research group (2026)
+
+########## Created by Rheoinformatic ##~ [RHEOINF] ##########
+
+import hoomd
+import numpy as np
+import pytest
+
+# simple cubic lattice: every particle has 6 nearest neighbors at r = 1
+N_CELLS = 6
+N = N_CELLS**3
+
+
+@pytest.mark.cpu
+@pytest.mark.parametrize("use_nlist", [False, True])
+def test_rdf_simple_cubic(simulation_factory, lattice_snapshot_factory,
+                          use_nlist):
+    """Ensure that the nearest neighbor shell is counted once per pair."""
+    sim = simulation_factory(lattice_snapshot_factory(n=N_CELLS, a=1.0))
+    nlist = hoomd.md.nlist.Cell(buffer=0.4) if use_nlist else None
+    rdf = hoomd.md.analyze.RDF(trigger=hoomd.trigger.Periodic(1),
+                               bins=4,
+                               r_max=1.2,
+                               nlist=nlist)
+    sim.operations.writers.append(rdf)
+    sim.run(2)
+
+    counts = rdf.pair_counts
+    g = rdf.rdf
+    if sim.device.communicator.rank == 0:
+        assert rdf.n_frames == 2
+        assert rdf.type_pairs == [('A', 'A')]
+        np.testing.assert_allclose(rdf.bin_centers, [0.15, 0.45, 0.75, 1.05])
+        np.testing.assert_allclose(counts[0], [0, 0, 0, 3 * N])
+
+        volume = N_CELLS**3
+        shell = 4 / 3 * np.pi * (1.2**3 - 0.9**3)
+        expected = volume / (N * (N - 1) / 2) * 3 * N / shell
+        np.testing.assert_allclose(g[0, 3], expected, rtol=1e-6)
+
+    rdf.reset()
+    assert rdf.n_frames == 0
+    np.testing.assert_array_equal(rdf.pair_counts, 0)
+
+
+@pytest.mark.cpu
+def test_rdf_surface(simulation_factory, lattice_snapshot_factory):
+    """Ensure that surface binning subtracts the mean diameter of the pair."""
+    snapshot = lattice_snapshot_factory(particle_types=['A', 'B'],
+                                        n=N_CELLS,
+                                        a=1.0)
+    if snapshot.communicator.rank == 0:
+        # alternate the types along x, with diameters 0.6 and 1.0
+        x = np.round(snapshot.particles.position[:, 0] + N_CELLS / 2 - 0.5)
+        b = (x.astype(int) % 2) == 1
+        snapshot.particles.typeid[:] = b
+        snapshot.particles.diameter[:] = np.where(b, 1.0, 0.6)
+    sim = simulation_factory(snapshot)
+    rdf = hoomd.md.analyze.RDF(trigger=hoomd.trigger.Periodic(1),
+                               bins=5,
+                               r_max=0.5,
+                               r_min=-0.5,
+                               surface=True)
+    sim.operations.writers.append(rdf)
+    sim.run(1)
+
+    counts = rdf.pair_counts
+    if sim.device.communicator.rank == 0:
+        assert rdf.type_pairs == [('A', 'A'), ('A', 'B'), ('B', 'B')]
+        centers = rdf.bin_centers
+        np.testing.assert_allclose(centers, [-0.4, -0.2, 0.0, 0.2, 0.4],
+                                   atol=1e-12)
+        # AA neighbors along y and z: h = 1 - 0.6
+        np.testing.assert_allclose(counts[0], [0, 0, 0, 0, N])
+        # AB neighbors along x: h = 1 - 0.8
+        np.testing.assert_allclose(counts[1], [0, 0, 0, N, 0])
+        # BB neighbors along y and z: h = 0, and diagonals in the y-z plane:
+        # h = sqrt(2) - 1
+        np.testing.assert_allclose(counts[2], [0, 0, N, 0, N])
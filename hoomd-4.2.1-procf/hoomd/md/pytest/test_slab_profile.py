@@ -0,0 +1,91 @@
+########## Created by the Rheoinformatic research group ##########
+# HOOMD-blue:
+#   Copyright (c) 2009-2023 The Regents of the University of Michigan.
+#   Part of HOOMD-blue, released under the BSD 3-Clause License.
+#
+# This file:
+#   Written by the Rheoinformatic research group (2026)
+
+########## Created by Rheoinformatic ##~ [RHEOINF] ##########
+
+import hoomd
+import numpy as np
+import pytest
+
+# simple cubic lattice with one layer of particles in each slab
+N_CELLS = 6
+SHEAR_RATE = 0.1
+DV = 0.2
+
+
+def sheared_lattice(lattice_snapshot_factory, particle_types=['A']):
+    """Lattice with v_x = SHEAR_RATE * y +- DV alternating along z."""
+    snapshot = lattice_snapshot_factory(particle_types=particle_types,
+                                        n=N_CELLS,
+                                        a=1.0)
+    if snapshot.communicator.rank == 0:
+        pos = snapshot.particles.position
+        iz = np.round(pos[:, 2] + N_CELLS / 2 - 0.5).astype(int)
+        snapshot.particles.velocity[:] = 0
+        snapshot.particles.velocity[:, 0] = (SHEAR_RATE * pos[:, 1]
+                                             + DV * (-1)**iz)
+    return snapshot
+
+
+@pytest.mark.cpu
+def test_slab_profile_shear(simulation_factory, lattice_snapshot_factory):
+    """Ensure that the streaming velocity is subtracted in each slab."""
+    sim = simulation_factory(sheared_lattice(lattice_snapshot_factory))
+    profile = hoomd.md.analyze.SlabProfile(trigger=hoomd.trigger.Periodic(1),
+                                           bins=N_CELLS)
+    sim.operations.writers.append(profile)
+    sim.run(2)
+
+    y = np.arange(N_CELLS) - N_CELLS / 2 + 0.5
+    assert profile.n_frames == 2
+    np.testing.assert_allclose(profile.bin_centers, y)
+
+    velocity = profile.velocity
+    assert velocity.shape == (1, N_CELLS, 3)
+    np.testing.assert_allclose(velocity[0, :, 0], SHEAR_RATE * y, atol=1e-6)
+    np.testing.assert_allclose(velocity[0, :, 1:], 0, atol=1e-6)
+    np.testing.assert_allclose(profile.density, 1, rtol=1e-6)
+
+    # 36 particles per slab, 3 * 35 degrees of freedom
+    n_slab = N_CELLS**2
+    expected = n_slab * DV**2 / (3 * (n_slab - 1))
+    np.testing.assert_allclose(profile.temperature, expected, rtol=1e-4)
+
+    profile.reset()
+    assert profile.n_frames == 0
+    assert np.all(np.isnan(profile.temperature))
+
+
+@pytest.mark.cpu
+def test_slab_profile_types(simulation_factory, lattice_snapshot_factory):
+    """Ensure that each type has its own profiles."""
+    snapshot = sheared_lattice(lattice_snapshot_factory, ['A', 'B'])
+    if snapshot.communicator.rank == 0:
+        # alternate the types along x, B particles are heavier
+        x = np.round(snapshot.particles.position[:, 0] + N_CELLS / 2 - 0.5)
+        snapshot.particles.typeid[:] = x.astype(int) % 2
+        snapshot.particles.mass[:] = 1 + snapshot.particles.typeid
+    sim = simulation_factory(snapshot)
+    profile = hoomd.md.analyze.SlabProfile(trigger=hoomd.trigger.Periodic(1),
+                                           bins=N_CELLS)
+    sim.operations.writers.append(profile)
+    sim.run(1)
+
+    y = np.arange(N_CELLS) - N_CELLS / 2 + 0.5
+    velocity = profile.velocity
+    assert velocity.shape == (2, N_CELLS, 3)
+    np.testing.assert_allclose(velocity[:, :, 0],
+                               [SHEAR_RATE * y, SHEAR_RATE * y],
+                               atol=1e-6)
+    np.testing.assert_allclose(profile.density, 0.5, rtol=1e-6)
+
+    n_slab = N_CELLS**2 // 2
+    expected = n_slab * DV**2 / (3 * (n_slab - 1))
+    temperature = profile.temperature
+    np.testing.assert_allclose(temperature[0], expected, rtol=1e-4)
+    np.testing.assert_allclose(temperature[1], 2 * expected, rtol=1e-4)
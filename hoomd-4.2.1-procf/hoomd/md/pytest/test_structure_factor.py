@@ -0,0 +1,92 @@
+########## Created by the Rheoinformatic research group ##########
+# HOOMD-blue:
+#   Copyright (c) 2009-2023 The Regents of the University of Michigan.
+#   Part of HOOMD-blue, released under the BSD 3-Clause License.
+#
+# This file:
+#   Written by the Rheoinformatic research group (2026)
+
+########## Created by Rheoinformatic ##~ [RHEOINF] ##########
+
+import hoomd
+import numpy as np
+import pytest
+
+L = 8.0
+N = 400
+MESH = 32
+BINS = 2
+Q_MAX = 2.0
+
+
+def _random_snapshot(device, xy):
+    """Uncorrelated positions in a (possibly sheared) cubic box."""
+    snapshot = hoomd.Snapshot(device.communicator)
+    if snapshot.communicator.rank == 0:
+        snapshot.configuration.box = [L, L, L, xy, 0, 0]
+        snapshot.particles.N = N
+        snapshot.particles.types = ['A']
+        rng = np.random.default_rng(7)
+        f = rng.uniform(-0.5, 0.5, size=(N, 3))
+        snapshot.particles.position[:] = f @ _lattice(xy).T
+    return snapshot
+
+
+def _lattice(xy):
+    """Box matrix with the lattice vectors as columns."""
+    return np.array([[L, xy * L, 0], [0, L, 0], [0, 0, L]])
+
+
+def _direct_structure_factor(position, xy):
+    """Bin averages of |sum_j exp(-i q.r_j)|^2 / N over the reciprocal lattice."""
+    b = 2 * np.pi * np.linalg.inv(_lattice(xy)).T
+    n = np.arange(-8, 9)
+    miller = np.stack(np.meshgrid(n, n, n), axis=-1).reshape(-1, 3)
+    q = miller @ b.T
+    q_len = np.linalg.norm(q, axis=1)
+    keep = (q_len > 0) & (q_len < Q_MAX)
+    q, q_len = q[keep], q_len[keep]
+    s = np.abs(np.exp(-1j * position @ q.T).sum(axis=0))**2 / len(position)
+    bins = np.minimum((q_len / (Q_MAX / BINS)).astype(int), BINS - 1)
+    return (np.bincount(bins, weights=s, minlength=BINS)
+            / np.bincount(bins, minlength=BINS))
+
+
+@pytest.mark.cpu
+@pytest.mark.parametrize("xy", [0.0, 0.3])
+def test_structure_factor_direct(simulation_factory, device, xy):
+    """Ensure that the mesh S(q) matches the direct sum, also when sheared."""
+    snapshot = _random_snapshot(device, xy)
+    sim = simulation_factory(snapshot)
+    sq = hoomd.md.analyze.StructureFactor(trigger=hoomd.trigger.Periodic(1),
+                                          mesh=MESH,
+                                          bins=BINS,
+                                          q_max=Q_MAX)
+    sim.operations.writers.append(sq)
+    sim.run(1)
+
+    values = sq.structure_factor
+    counts = sq.mode_counts
+    if sim.device.communicator.rank == 0:
+        assert sq.n_frames == 1
+        np.testing.assert_allclose(sq.bin_centers, [0.5, 1.5])
+        assert np.all(counts > 0)
+        expected = _direct_structure_factor(snapshot.particles.position, xy)
+        np.testing.assert_allclose(values, expected, rtol=0.05)
+
+    sq.reset()
+    assert sq.n_frames == 0
+    assert np.all(np.isnan(sq.structure_factor))
+
+
+@pytest.mark.cpu
+def test_structure_factor_nyquist(simulation_factory, device):
+    """Ensure that q_max above the Nyquist wave number of the mesh fails."""
+    sim = simulation_factory(_random_snapshot(device, 0.0))
+    sq = hoomd.md.analyze.StructureFactor(trigger=hoomd.trigger.Periodic(1),
+                                          mesh=4,
+                                          bins=BINS,
+                                          q_max=Q_MAX)
+    sim.operations.writers.append(sq)
+    with pytest.raises(RuntimeError):
+        sim.run(1)
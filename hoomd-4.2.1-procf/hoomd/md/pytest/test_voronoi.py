@@ -0,0 +1,116 @@
+########## Created by the Rheoinformatic research group ##########
+# HOOMD-blue:
+#   Copyright (c) 2009-2023 The Regents of the University of Michigan.
+#   Part of HOOMD-blue, released under the BSD 3-Clause License.
+#
+# This file:
+#   Written by the Rheoinformatic research group (2026)
+
+########## Created by Rheoinformatic ##~ [RHEOINF] ##########
+
+import hoomd
+import numpy as np
+import pytest
+
+N_CELLS = 6
+
+
+def layered_lattice(lattice_snapshot_factory):
+    """Simple cubic lattice with layers of A (d=1.2) and B (d=0.8) in x."""
+    snapshot = lattice_snapshot_factory(particle_types=['A', 'B'],
+                                        n=N_CELLS,
+                                        a=1.0)
+    if snapshot.communicator.rank == 0:
+        x = np.round(snapshot.particles.position[:, 0] + N_CELLS / 2 - 0.5)
+        snapshot.particles.typeid[:] = x.astype(int) % 2
+        snapshot.particles.diameter[:] = np.where(
+            snapshot.particles.typeid == 0, 1.2, 0.8)
+    return snapshot
+
+
+@pytest.mark.cpu
+def test_voronoi_lattice(simulation_factory, lattice_snapshot_factory):
+    """Ensure that the cells of a simple cubic lattice are unit cubes."""
+    snapshot = lattice_snapshot_factory(n=N_CELLS, a=1.0)
+    sim = simulation_factory(snapshot)
+    voronoi = hoomd.md.analyze.Voronoi(trigger=hoomd.trigger.Periodic(1),
+                                       r_max=2.5)
+    sim.operations.writers.append(voronoi)
+    sim.run(1)
+
+    volumes = voronoi.volumes
+    if sim.device.communicator.rank == 0:
+        assert volumes.shape == (N_CELLS**3,)
+        np.testing.assert_allclose(volumes, 1, rtol=1e-6)
+    np.testing.assert_allclose(voronoi.volume_mean, 1, rtol=1e-6)
+    np.testing.assert_allclose(voronoi.volume_variance, 0, atol=1e-10)
+    assert voronoi.n_incomplete == 0
+
+
+@pytest.mark.cpu
+def test_voronoi_radical(simulation_factory, lattice_snapshot_factory):
+    """Ensure that the radical planes shift with the diameters."""
+    sim = simulation_factory(layered_lattice(lattice_snapshot_factory))
+    voronoi = hoomd.md.analyze.Voronoi(trigger=hoomd.trigger.Periodic(1),
+                                       r_max=2.5)
+    sim.operations.writers.append(voronoi)
+    sim.run(1)
+
+    # the plane between A and B is R_A + (1 - R_A - R_B) / 2 = 0.6 from A
+    volumes = voronoi.volumes
+    if sim.device.communicator.rank == 0:
+        typeid = sim.state.get_snapshot().particles.typeid
+        np.testing.assert_allclose(volumes[typeid == 0], 1.2, rtol=1e-6)
+        np.testing.assert_allclose(volumes[typeid == 1], 0.8, rtol=1e-6)
+        np.testing.assert_allclose(np.sum(volumes), N_CELLS**3, rtol=1e-6)
+
+    # two equally populated values: no skewness, kurtosis 1
+    np.testing.assert_allclose(voronoi.volume_mean, 1, rtol=1e-6)
+    np.testing.assert_allclose(voronoi.volume_variance, 0.04, rtol=1e-6)
+    np.testing.assert_allclose(voronoi.volume_skewness, 0, atol=1e-6)
+    np.testing.assert_allclose(voronoi.volume_kurtosis, 1, rtol=1e-6)
+
+
+@pytest.mark.cpu
+def test_voronoi_types(simulation_factory, lattice_snapshot_factory):
+    """Ensure that only the selected types bound the cells."""
+    sim = simulation_factory(layered_lattice(lattice_snapshot_factory))
+    voronoi = hoomd.md.analyze.Voronoi(trigger=hoomd.trigger.Periodic(1),
+                                       r_max=2.5,
+                                       types=['A'])
+    sim.operations.writers.append(voronoi)
+    sim.run(1)
+
+    volumes = voronoi.volumes
+    if sim.device.communicator.rank == 0:
+        typeid = sim.state.get_snapshot().particles.typeid
+        np.testing.assert_allclose(volumes[typeid == 0], 2, rtol=1e-6)
+        np.testing.assert_allclose(volumes[typeid == 1], 0)
+    np.testing.assert_allclose(voronoi.volume_mean, 2, rtol=1e-6)
+    assert voronoi.types == ['A']
+
+
+@pytest.mark.cpu
+def test_voronoi_random(simulation_factory, two_particle_snapshot_factory):
+    """Ensure that the cells of a random polydisperse system fill the box."""
+    L = 8.0
+    snapshot = two_particle_snapshot_factory(d=1.0, L=L)
+    if snapshot.communicator.rank == 0:
+        rng = np.random.default_rng(3)
+        N = 400
+        snapshot.particles.N = N
+        snapshot.particles.position[:] = rng.uniform(-L / 2, L / 2, (N, 3))
+        snapshot.particles.diameter[:] = rng.uniform(0.6, 1.2, N)
+        snapshot.particles.typeid[:] = 0
+    sim = simulation_factory(snapshot)
+    voronoi = hoomd.md.analyze.Voronoi(trigger=hoomd.trigger.Periodic(1),
+                                       r_max=3.5)
+    sim.operations.writers.append(voronoi)
+    sim.run(1)
+
+    assert voronoi.n_incomplete == 0
+    np.testing.assert_allclose(voronoi.volume_mean, L**3 / 400, rtol=1e-6)
+    volumes = voronoi.volumes
+    if sim.device.communicator.rank == 0:
+        assert np.all(volumes > 0)
+        np.testing.assert_allclose(np.sum(volumes), L**3, rtol=1e-6)
@@ -5,9 +5,11 @@
 
 #include "Action.h"
 #include "Analyzer.h"
+#include "BinaryLogWriter.h" //~ add binary logs [RHEOINF]
 #include "BondedGroupData.h"
 #include "BoxResizeUpdater.h"
 #include "BoxShearUpdater.h" //~ add BoxShear [RHEOINF]
+#include "Checkpoint.h" //~ add checkpoint files [RHEOINF]
 #include "CellList.h"
 #include "CellListStencil.h"
 #include "ClockSource.h"
@@ -313,6 +315,8 @@ PYBIND11_MODULE(_hoomd, m)
     export_DCDDumpWriter(m);
     export_GSDDumpWriter(m);
     export_GSDDequeWriter(m);
+    export_CheckpointFile(m); //~ add checkpoint files [RHEOINF]
+    export_BinaryLogWriter(m); //~ add binary logs [RHEOINF]
 
     // updaters
     export_Updater(m);
@@ -1,6 +1,8 @@
 # Copyright (c) 2009-2023 The Regents of the University of Michigan.
 # Part of HOOMD-blue, released under the BSD 3-Clause License.
 
+###### Modified by Rheoinformatic ##~ [RHEOINF] ######
+
 import hoomd
 import pytest
 from hoomd.conftest import operation_pickling_check
@@ -114,3 +116,45 @@ def test_balance_action(device, simulation_factory, lattice_snapshot_factory):
 
     # the load balance should move the split place down toward the particles
     assert sim.state.domain_decomposition_split_fractions[2][0] < 0.5
+
+
+##~ add cost-weighted load balancing [RHEOINF]
+def test_balance_weighting(simulation_factory, lattice_snapshot_factory):
+    balance = hoomd.tune.LoadBalancer(hoomd.trigger.Periodic(3))
+    assert balance.weighting == 'particles'
+    balance.weighting = 'time'
+    assert balance.weighting == 'time'
+    with pytest.raises(ValueError):
+        balance.weighting = 'bonds'
+    balance.type_weights['A'] = 4.0
+
+    sim = simulation_factory(lattice_snapshot_factory())
+    sim.operations.tuners.append(balance)
+    sim.run(5)
+    assert balance.weighting == 'time'
+    assert balance.type_weights['A'] == 4.0
+
+
+def test_balance_type_weights(device, simulation_factory,
+                              lattice_snapshot_factory):
+    """Test that heavy particle types attract the domain boundary."""
+    if device.communicator.num_ranks != 2:
+        pytest.skip("Test supports only 2 ranks")
+
+    # the same number of particles in both domains, the lower ones are heavy
+    snapshot = lattice_snapshot_factory(particle_types=['A', 'B'])
+    if snapshot.communicator.rank == 0:
+        lower = snapshot.particles.position[:, 2] < 0
+        snapshot.particles.typeid[lower] = 1
+    sim = simulation_factory(snapshot, domain_decomposition=(1, 1, 2))
+
+    balance = hoomd.tune.LoadBalancer(trigger=hoomd.trigger.Periodic(1),
+                                      weighting='type')
+    balance.type_weights['A'] = 1.0
+    balance.type_weights['B'] = 10.0
+    sim.operations.tuners.append(balance)
+    sim.run(1)
+
+    # the split plane moves down into the heavy particles
+    assert sim.state.domain_decomposition_split_fractions[2][0] < 0.5
+##~
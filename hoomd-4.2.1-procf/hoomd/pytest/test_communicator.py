@@ -2,6 +2,7 @@
 # Part of HOOMD-blue, released under the BSD 3-Clause License.
 
 import hoomd
+import numpy
 import pytest
 import time
 try:
@@ -77,3 +78,85 @@ def test_communicator_mpi4py():
     communicator = hoomd.communicator.Communicator(mpi_comm=MPI.COMM_WORLD)
     assert world_communicator.num_ranks == communicator.num_ranks
     assert world_communicator.rank == communicator.rank
+
+
+def test_communicator_ghost_payload(simulation_factory,
+                                    lattice_snapshot_factory):
+    """Compact ghost payloads must give the same DPD forces."""
+    communicator = hoomd.communicator.Communicator(compact_ghosts=True,
+                                                   ghost_velocity_float=True)
+    assert communicator.compact_ghosts
+    assert communicator.ghost_velocity_float
+
+    snap = lattice_snapshot_factory(particle_types=['A', 'B'],
+                                    n=6,
+                                    a=0.8,
+                                    r=0.1)
+    if snap.communicator.rank == 0:
+        snap.particles.typeid[::2] = 1
+        snap.particles.diameter[::2] = 2.0
+        snap.particles.diameter[::3] = 1.5
+        snap.particles.charge[:] = 0.5
+
+    forces = []
+    for compact in (False, True):
+        sim = simulation_factory()
+        device_communicator = sim.device.communicator
+        device_communicator.compact_ghosts = compact
+        device_communicator.ghost_velocity_float = compact
+        try:
+            sim.create_state_from_snapshot(snap)
+        finally:
+            device_communicator.compact_ghosts = False
+            device_communicator.ghost_velocity_float = False
+
+        dpd = hoomd.md.pair.DPD(nlist=hoomd.md.nlist.Cell(buffer=0.4),
+                                kT=1.0,
+                                default_r_cut=1.0)
+        dpd.params[(['A', 'B'], ['A', 'B'])] = dict(A=25.0, gamma=4.5)
+        sim.operations.integrator = hoomd.md.Integrator(
+            0.005,
+            forces=[dpd],
+            methods=[hoomd.md.methods.ConstantVolume(hoomd.filter.All())])
+        sim.run(5)
+        forces.append(dpd.forces)
+
+    if forces[0] is not None:
+        # ghost velocities are single precision with ghost_velocity_float
+        numpy.testing.assert_allclose(forces[0],
+                                      forces[1],
+                                      rtol=1e-4,
+                                      atol=1e-5)
+
+
+def test_communicator_neighbor_collectives(simulation_factory,
+                                           lattice_snapshot_factory):
+    """Neighborhood collective ghost updates must give the same forces."""
+    communicator = hoomd.communicator.Communicator(neighbor_collectives=True)
+    assert communicator.neighbor_collectives
+
+    snap = lattice_snapshot_factory(n=6, a=0.8, r=0.1)
+
+    forces = []
+    for neighbor_collectives in (False, True):
+        sim = simulation_factory()
+        device_communicator = sim.device.communicator
+        device_communicator.neighbor_collectives = neighbor_collectives
+        try:
+            sim.create_state_from_snapshot(snap)
+        finally:
+            device_communicator.neighbor_collectives = False
+
+        dpd = hoomd.md.pair.DPD(nlist=hoomd.md.nlist.Cell(buffer=0.4),
+                                kT=1.0,
+                                default_r_cut=1.0)
+        dpd.params[('A', 'A')] = dict(A=25.0, gamma=4.5)
+        sim.operations.integrator = hoomd.md.Integrator(
+            0.005,
+            forces=[dpd],
+            methods=[hoomd.md.methods.ConstantVolume(hoomd.filter.All())])
+        sim.run(20)
+        forces.append(dpd.forces)
+
+    if forces[0] is not None:
+        numpy.testing.assert_allclose(forces[0], forces[1], rtol=1e-10)
@@ -1,10 +1,13 @@
 # Copyright (c) 2009-2023 The Regents of the University of Michigan.
 # Part of HOOMD-blue, released under the BSD 3-Clause License.
 
+###### Modified by Rheoinformatic ##~ [RHEOINF] ######
+
 """Test ParticleSorter."""
 
 from hoomd.conftest import operation_pickling_check
 import hoomd
+import numpy as np ##~ [RHEOINF]
 
 
 def test_attributes():
@@ -14,6 +17,8 @@ def test_attributes():
 
     assert sorter.trigger is trigger
     assert sorter.grid == 32
+    assert not sorter.type_major ##~ [RHEOINF]
+    assert not sorter.adaptive ##~ [RHEOINF]
 
 
 def test_attributes_attached(simulation_factory, two_particle_snapshot_factory):
@@ -27,6 +32,8 @@ def test_attributes_attached(simulation_factory, two_particle_snapshot_factory):
 
     assert sorter.trigger is trigger
     assert sorter.grid == 32
+    assert not sorter.type_major ##~ [RHEOINF]
+    assert not sorter.adaptive ##~ [RHEOINF]
 
 
 def test_default_sorter(simulation_factory, two_particle_snapshot_factory):
@@ -44,3 +51,42 @@ def test_pickling(simulation_factory, two_particle_snapshot_factory):
     # simulation
     sorter = sim.operations.tuners.pop()
     operation_pickling_check(sorter, sim)
+
+
+##~ add type-major ordering and adaptive sorting [RHEOINF]
+def test_type_major(simulation_factory, lattice_snapshot_factory):
+    """Test that type-major sorting groups particles by type."""
+    snap = lattice_snapshot_factory(particle_types=['A', 'B'], n=8, a=1.5)
+    if snap.communicator.rank == 0:
+        snap.particles.typeid[::3] = 1
+    sim = simulation_factory(snap)
+    if isinstance(sim.device, hoomd.device.GPU):
+        return
+    sim.operations.tuners.clear()
+    sorter = hoomd.tune.ParticleSorter(trigger=hoomd.trigger.Periodic(1),
+                                       type_major=True)
+    sim.operations.tuners.append(sorter)
+    sim.run(1)
+
+    assert sorter.type_major
+    assert sorter.num_sorts > 0
+    with sim.state.cpu_local_snapshot as data:
+        typeid = np.array(data.particles.typeid, copy=True)
+    # highest type id first
+    assert np.all(np.diff(typeid.astype(int)) <= 0)
+
+
+def test_adaptive(simulation_factory, lattice_snapshot_factory):
+    """Test that the adaptive sorter always sorts on the first check."""
+    sim = simulation_factory(lattice_snapshot_factory(n=6, a=1.5))
+    sim.operations.tuners.clear()
+    sorter = hoomd.tune.ParticleSorter(trigger=hoomd.trigger.Periodic(1),
+                                       adaptive=True)
+    sim.operations.tuners.append(sorter)
+    sim.run(1)
+
+    assert sorter.adaptive
+    assert sorter.num_sorts == 1
+    sim.run(5)
+    assert sorter.num_sorts >= 1
+##~
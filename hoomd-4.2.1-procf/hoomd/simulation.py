@@ -1,6 +1,8 @@
 # Copyright (c) 2009-2023 The Regents of the University of Michigan.
 # Part of HOOMD-blue, released under the BSD 3-Clause License.
 
+###### Modified by Rheoinformatic ##~ [RHEOINF] ######
+
 """Define the Simulation class.
 
 .. invisible-code-block: python
@@ -62,6 +64,7 @@ class Simulation(metaclass=Loggable):
         self._operations._simulation = self
         self._timestep = None
         self._seed = None
+        self._checkpoint = None  ##~ checkpoint awaiting its operations [RHEOINF]
         if seed is not None:
             self.seed = seed
 
@@ -167,6 +170,15 @@ class Simulation(metaclass=Loggable):
                 if isinstance(self.device, hoomd.device.CPU):
                     cpp_communicator = _hoomd.Communicator(
                         self.state._cpp_sys_def, decomposition)
+                    ##~ add ghost payload options [RHEOINF]
+                    communicator = self.device.communicator
+                    cpp_communicator.compact_ghosts = \
+                        communicator.compact_ghosts
+                    cpp_communicator.ghost_velocity_float = \
+                        communicator.ghost_velocity_float
+                    cpp_communicator.neighbor_collectives = \
+                        communicator.neighbor_collectives
+                    ##~
                 else:
                     cpp_communicator = _hoomd.CommunicatorGPU(
                         self.state._cpp_sys_def, decomposition)
@@ -188,7 +200,11 @@ class Simulation(metaclass=Loggable):
     def create_state_from_gsd(self,
                               filename,
                               frame=-1,
-                              domain_decomposition=(None, None, None)):
+                              ##~ add distributed read [RHEOINF]
+                              #domain_decomposition=(None, None, None)):
+                              domain_decomposition=(None, None, None),
+                              distributed=False):
+                              ##~
         """Create the simulation state from a GSD file.
 
         Args:
@@ -205,6 +221,14 @@ class Simulation(metaclass=Loggable):
                 to include in each domain. The sum of each list of floats must
                 be 1.0 (e.g. ``([0.25, 0.75], [0.2, 0.8], [1.0])``).
 
+            distributed (bool): Read the particles on all MPI ranks instead of
+                the root rank [RHEOINF]. Each rank reads a contiguous slab of
+                the per-particle data, and sends each particle to the rank
+                that owns it. No rank holds the whole frame, which keeps the
+                memory use and startup time of very large systems (tens of
+                millions of particles) bounded. The topology is still read by
+                the root rank. Defaults to `False`.
+
         When `timestep` is `None` before calling, `create_state_from_gsd`
         sets `timestep` to the value in the selected GSD frame in the file.
 
@@ -227,18 +251,54 @@ class Simulation(metaclass=Loggable):
             raise RuntimeError("Cannot initialize more than once\n")
         filename = _hoomd.mpi_bcast_str(filename, self.device._cpp_exec_conf)
         # Grab snapshot and timestep
+        ##~ add distributed read [RHEOINF]
+        #reader = _hoomd.GSDReader(self.device._cpp_exec_conf, filename,
+        #                          abs(frame), frame < 0)
         reader = _hoomd.GSDReader(self.device._cpp_exec_conf, filename,
-                                  abs(frame), frame < 0)
+                                  abs(frame), frame < 0, distributed)
+        ##~
         snapshot = Snapshot._from_cpp_snapshot(reader.getSnapshot(),
                                                self.device.communicator)
 
         step = reader.getTimeStep() if self.timestep is None else self.timestep
         self._state = State(self, snapshot, domain_decomposition)
 
+        ##~ the snapshot has no particles, read them on all ranks [RHEOINF]
+        if distributed:
+            reader.readParticlesDistributed(self._state._cpp_sys_def)
+        ##~
+
         reader.clearSnapshot()
 
         self._init_system(step)
 
+    ##~ add checkpoint restarts [RHEOINF]
+    def create_state_from_checkpoint(self, path):
+        """Create the simulation state from a checkpoint directory [RHEOINF].
+
+        Args:
+            path (str): Directory written by `hoomd.write.Checkpoint.write`.
+
+        `create_state_from_checkpoint` sets `timestep`, `seed`, the exact box,
+        the domain decomposition, and the local particles of every rank to the
+        values in the checkpoint. Add the same operations as the simulation
+        that wrote it; their saved state is restored at the start of the next
+        `run`. Restart with the same number of MPI ranks.
+
+        .. rubric:: Example:
+
+        .. skip: next
+
+        .. code-block:: python
+
+            simulation.create_state_from_checkpoint(path=checkpoint_path)
+        """
+        if self._state is not None:
+            raise RuntimeError("Cannot initialize more than once\n")
+        hoomd.write.checkpoint._read_checkpoint(self, path)
+
+    ##~
+
     def create_state_from_snapshot(self,
                                    snapshot,
                                    domain_decomposition=(None, None, None)):
@@ -554,6 +614,11 @@ class Simulation(metaclass=Loggable):
         if not self.operations._scheduled:
             self.operations._schedule()
 
+        ##~ restore the object state of a checkpoint [RHEOINF]
+        if self._checkpoint is not None:
+            hoomd.write.checkpoint._restore_operations(self)
+        ##~
+
         steps_int = int(steps)
         if steps_int < 0 or steps_int > TIMESTEP_MAX - 1:
             raise ValueError(f"steps must be in the range [0, "
@@ -561,6 +626,14 @@ class Simulation(metaclass=Loggable):
 
         self._cpp_sys.run(steps_int, write_at_start)
 
+        ##~ finish the frames queued by asynchronous GSD writers [RHEOINF]
+        hoomd.write.gsd._flush_async_gsd_writers(self, wait_only=True)
+        ##~
+
+        ##~ write the rows buffered by binary logs [RHEOINF]
+        hoomd.write.binary_log._flush_binary_logs(self)
+        ##~
+
     def __del__(self):
         """Clean up dangling references to simulation."""
         # _operations may not be set, check before unscheduling
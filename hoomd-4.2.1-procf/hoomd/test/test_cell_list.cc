@@ -583,3 +583,63 @@ UP_TEST(CellListGPU_large)
         new ExecutionConfiguration(ExecutionConfiguration::GPU)));
     }
 #endif
+
+//~ add multi-threaded cell list build [RHEOINF]
+#ifdef ENABLE_TBB
+//! Validate that the multi-threaded build gives exactly the serial cell list
+UP_TEST(CellList_parallel)
+    {
+    std::shared_ptr<ExecutionConfiguration> exec_conf(
+        new ExecutionConfiguration(ExecutionConfiguration::CPU));
+    unsigned int N = 10000;
+    RandomInitializer rand_init(N, Scalar(0.2), Scalar(0.9), "A");
+    std::shared_ptr<SnapshotSystemData<Scalar>> snap;
+    snap = rand_init.getSnapshot();
+    std::shared_ptr<SystemDefinition> sysdef(new SystemDefinition(snap, exec_conf));
+
+    std::shared_ptr<CellList> cl(new CellList(sysdef));
+    cl->setNominalWidth(Scalar(3.0));
+    cl->setRadius(1);
+    cl->setFlagIndex();
+    cl->setComputeIdx(true);
+
+    // serial build
+    exec_conf->setNumThreads(1);
+    cl->compute(0);
+    unsigned int ncell = cl->getCellIndexer().getNumElements();
+    vector<unsigned int> serial_size(ncell);
+    vector<unsigned int> serial_idx(cl->getIndexArray().getNumElements());
+        {
+        ArrayHandle<unsigned int> h_cell_size(cl->getCellSizeArray(),
+                                              access_location::host,
+                                              access_mode::read);
+        ArrayHandle<unsigned int> h_idx(cl->getIndexArray(),
+                                        access_location::host,
+                                        access_mode::read);
+        std::copy(h_cell_size.data, h_cell_size.data + ncell, serial_size.begin());
+        std::copy(h_idx.data, h_idx.data + serial_idx.size(), serial_idx.begin());
+        }
+
+    // parallel build
+    exec_conf->setNumThreads(4);
+    cl->compute(1);
+    ArrayHandle<unsigned int> h_cell_size(cl->getCellSizeArray(),
+                                          access_location::host,
+                                          access_mode::read);
+    ArrayHandle<unsigned int> h_idx(cl->getIndexArray(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar4> h_xyzf(cl->getXYZFArray(), access_location::host, access_mode::read);
+    Index2D cli = cl->getCellListIndexer();
+    for (unsigned int cell = 0; cell < ncell; cell++)
+        {
+        CHECK_EQUAL_UINT(h_cell_size.data[cell], serial_size[cell]);
+        for (unsigned int offset = 0; offset < h_cell_size.data[cell]; offset++)
+            {
+            // same members in the same (increasing index) order
+            CHECK_EQUAL_UINT(h_idx.data[cli(offset, cell)], serial_idx[cli(offset, cell)]);
+            CHECK_EQUAL_UINT(__scalar_as_int(h_xyzf.data[cli(offset, cell)].w),
+                             serial_idx[cli(offset, cell)]);
+            }
+        }
+    }
+#endif
+//~
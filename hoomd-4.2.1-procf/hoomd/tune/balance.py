@@ -1,9 +1,14 @@
 # Copyright (c) 2009-2023 The Regents of the University of Michigan.
 # Part of HOOMD-blue, released under the BSD 3-Clause License.
 
+###### Modified by Rheoinformatic ##~ [RHEOINF] ######
+
 """Define LoadBalancer."""
 
 from hoomd.data.parameterdicts import ParameterDict
+from hoomd.data.parameterdicts import TypeParameterDict ##~ [RHEOINF]
+from hoomd.data.typeparam import TypeParameter ##~ [RHEOINF]
+from hoomd.data.typeconverter import OnlyFrom ##~ [RHEOINF]
 from hoomd.operation import Tuner
 from hoomd import _hoomd
 import hoomd
@@ -21,6 +26,8 @@ class LoadBalancer(Tuner):
         tolerance (float): Load imbalance tolerance.
         max_iterations (int): Maximum number of iterations to
             attempt in a single step.
+        weighting (str): Load measure, one of ``'particles'``, ``'time'``,
+            or ``'type'``. Defaults to ``'particles'``. [RHEOINF]
 
     `LoadBalancer` adjusts the boundaries of the MPI domains to distribute
     the particle load close to evenly between them. The load imbalance is
@@ -74,6 +81,23 @@ class LoadBalancer(Tuner):
     Balancing is ignored if there is no domain decomposition available (MPI is
     not built or is running on a single rank).
 
+    .. rubric:: Cost-weighted balancing [RHEOINF]
+
+    Particle counts are a poor measure of the load when the cost per particle
+    varies, e.g. in phase-separated colloid gels where a rank holding a dense
+    colloid cluster computes many colloid-colloid pairs with large cutoffs.
+    Set *weighting* to balance a cost per particle instead, so that
+    :math:`N_i` above becomes the summed weight of the particles on rank
+    :math:`i` and :math:`N` the total weight:
+
+    * ``'time'``: the wall time each rank spends computing forces (including
+      the neighbor list builds) is measured between balancing steps and
+      divided evenly among the particles of the rank. The first balancing step
+      uses the particle count. Use it on the CPU; GPU kernels run
+      asynchronously, so the measured time does not reflect the load.
+    * ``'type'``: each particle weighs `type_weights` of its type, e.g. a
+      colloid costs many times a solvent particle.
+
     Attributes:
         trigger (hoomd.trigger.Trigger): Select the timesteps on which to
             perform load balancing.
@@ -83,6 +107,11 @@ class LoadBalancer(Tuner):
         tolerance (float): Load imbalance tolerance.
         max_iterations (int): Maximum number of iterations to
             attempt in a single step.
+        weighting (str): Load measure, one of ``'particles'``, ``'time'``,
+            or ``'type'``. [RHEOINF]
+        type_weights (`TypeParameter` [``particle type``, `float`]): Cost
+            weight of a particle of each type (used with
+            ``weighting='type'``). Defaults to 1.0. [RHEOINF]
     """
 
     def __init__(self,
@@ -91,22 +120,35 @@ class LoadBalancer(Tuner):
                  y=True,
                  z=True,
                  tolerance=1.02,
-                 max_iterations=1):
+                 max_iterations=1,
+                 weighting='particles'): ##~ add cost weighting [RHEOINF]
         super().__init__(trigger)
 
         defaults = dict(x=x,
                         y=y,
                         z=z,
                         tolerance=tolerance,
-                        max_iterations=max_iterations)
-        load_balancer_params = ParameterDict(x=bool,
-                                             y=bool,
-                                             z=bool,
-                                             max_iterations=int,
-                                             tolerance=float)
+                        max_iterations=max_iterations,
+                        weighting=weighting) ##~ [RHEOINF]
+        load_balancer_params = ParameterDict(
+            x=bool,
+            y=bool,
+            z=bool,
+            max_iterations=int,
+            tolerance=float,
+            weighting=OnlyFrom(['particles', 'time', 'type'])) ##~ [RHEOINF]
         self._param_dict.update(load_balancer_params)
         self._param_dict.update(defaults)
 
+        ##~ add cost weighting per type [RHEOINF]
+        type_weights = TypeParameter('type_weights',
+                                     type_kind='particle_types',
+                                     param_dict=TypeParameterDict(float,
+                                                                  len_keys=1))
+        type_weights.default = 1.0
+        self._extend_typeparam([type_weights])
+        ##~
+
     def _attach_hook(self):
         if isinstance(self._simulation.device, hoomd.device.GPU):
             cpp_cls = getattr(_hoomd, 'LoadBalancerGPU')
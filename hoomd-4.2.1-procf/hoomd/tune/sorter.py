@@ -1,11 +1,14 @@
 # Copyright (c) 2009-2023 The Regents of the University of Michigan.
 # Part of HOOMD-blue, released under the BSD 3-Clause License.
 
+###### Modified by Rheoinformatic ##~ [RHEOINF] ######
+
 """Define the ParticleSorter class."""
 
 from hoomd.data.parameterdicts import ParameterDict
 from hoomd.data.typeconverter import OnlyTypes
 from hoomd.operation import Tuner
+from hoomd.logging import log ##~ [RHEOINF]
 from hoomd import _hoomd
 import hoomd
 from math import log2, ceil
@@ -22,11 +25,33 @@ class ParticleSorter(Tuner):
             value of `None` sets ``grid=4096`` in 2D simulations and
             ``grid=256`` in 3D simulations.
 
+        type_major (bool): Group the particles by type (highest type id
+            first) and sort each group along the space-filling curve. Defaults
+            to `False`. [RHEOINF]
+
+        adaptive (bool): Use the trigger to schedule checks and sort only when
+            the measured slow down pays for a sort. Defaults to `False`.
+            [RHEOINF]
+
     `ParticleSorter` improves simulation performance by sorting the particles in
     memory along a space-filling curve. This takes particles that are close in
     space and places them close in memory, leading to a higher rate of
     cache hits when computing pair potentials.
 
+    With ``type_major=True``, the particles of each type are stored
+    contiguously. In the colloid templates the solvent is type 0, so the
+    colloids (large cutoffs, many neighbors) come first in their own
+    space-filling curve order, followed by the solvent. Type-major ordering is
+    not implemented on the GPU. [RHEOINF]
+
+    With ``adaptive=True``, the trigger only schedules checks (use a short
+    period, e.g. ``hoomd.trigger.Periodic(100)``). At each check the sorter
+    measures the wall time per step since the previous check (dominated by the
+    force loop) and accumulates how much slower it is than the fastest time
+    per step seen since the last sort. It sorts once that lost time exceeds
+    the measured cost of the last sort. The first check always sorts.
+    [RHEOINF]
+
     Note:
         New `hoomd.Operations` instances include a `ParticleSorter`
         constructed with default parameters.
@@ -39,18 +64,33 @@ class ParticleSorter(Tuner):
             of `grid` provide more accurate space-filling curves, but consume
             more memory (``grid**D * 4`` bytes, where *D* is the dimensionality
             of the system).
+
+        type_major (bool): Group the particles by type before sorting along
+            the space-filling curve. [RHEOINF]
+
+        adaptive (bool): Sort only when the measured slow down pays for a
+            sort. [RHEOINF]
     """
 
-    def __init__(self, trigger=200, grid=None):
+    def __init__(self, trigger=200, grid=None, type_major=False, adaptive=False): ##~ add type_major, adaptive [RHEOINF]
         super().__init__(trigger)
         sorter_params = ParameterDict(
             grid=OnlyTypes(int,
                            postprocess=ParticleSorter._to_power_of_two,
                            preprocess=ParticleSorter._natural_number,
-                           allow_none=True))
+                           allow_none=True),
+            type_major=bool(type_major), ##~ [RHEOINF]
+            adaptive=bool(adaptive)) ##~ [RHEOINF]
         self._param_dict.update(sorter_params)
         self.grid = grid
 
+    ##~ add num_sorts [RHEOINF]
+    @log(requires_run=True)
+    def num_sorts(self):
+        """int: Number of sorts performed since the sorter was attached."""
+        return self._cpp_obj.num_sorts
+    ##~
+
     @staticmethod
     def _to_power_of_two(value):
         return int(2.**ceil(log2(value)))
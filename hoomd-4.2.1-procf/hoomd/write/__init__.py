@@ -1,6 +1,8 @@
 # Copyright (c) 2009-2023 The Regents of the University of Michigan.
 # Part of HOOMD-blue, released under the BSD 3-Clause License.
 
+###### Modified by Rheoinformatic ##~ [RHEOINF] ######
+
 """Writers.
 
 Writers write the state of the simulation, logger quantities, or calculated
@@ -12,6 +14,10 @@ results to output files or streams:
 * Combine `GSD` with a `hoomd.logging.Logger` to save system properties or
   per-particle calculated results.
 * Use `HDF5Log` to store logged data in HDF5 resizable datasets.
+* Use `BinaryLog` to log scalar and array quantities at high frequency to a
+  columnar binary file [RHEOINF].
+* Use `Checkpoint` to save the complete state for bit-exact restarts
+  [RHEOINF].
 * Use `Table` to display the status of the simulation periodically to standard
   out.
 * Implement custom output formats with `CustomWriter`.
@@ -34,3 +40,5 @@ from hoomd.write.gsd_burst import Burst
 from hoomd.write.dcd import DCD
 from hoomd.write.table import Table
 from hoomd.write.hdf5 import HDF5Log
+from hoomd.write.checkpoint import Checkpoint ##~ add checkpoints [RHEOINF]
+from hoomd.write.binary_log import BinaryLog ##~ add binary logs [RHEOINF]
@@ -0,0 +1,204 @@
+########## Created by the Rheoinformatic research group ##########
+# HOOMD-blue:
+#   Copyright (c) 2009-2023 The Regents of the University of Michigan.
+#   Part of HOOMD-blue, released under the BSD 3-Clause License.
+#
+# This file:
+#   Written by the Rheoinformatic research group (2026)
+
+########## Created by Rheoinformatic ##~ [RHEOINF] ##########
+
+"""Write logged quantities to a columnar binary time series.
+
+.. invisible-code-block: python
+
+    simulation = hoomd.util.make_example_simulation()
+    binary_log_filename = tmp_path / 'log.bin'
+"""
+
+import struct
+
+import numpy as np
+
+from hoomd import _hoomd
+from hoomd.data.parameterdicts import ParameterDict
+from hoomd.logging import Logger, LoggerCategories
+from hoomd.operation import Writer
+
+_MAGIC = b'HOOMDBLG'
+_VERSION = 1
+
+
+def _read(filename):
+    """Read a binary log file into a dictionary of arrays."""
+    with open(filename, 'rb') as f:
+        data = f.read()
+
+    offset = 0
+
+    def unpack(fmt):
+        nonlocal offset
+        values = struct.unpack_from('=' + fmt, data, offset)
+        offset += struct.calcsize('=' + fmt)
+        return values
+
+    if data[:len(_MAGIC)] != _MAGIC:
+        raise RuntimeError(f"{filename} is not a binary log file.")
+    offset = len(_MAGIC)
+    version, n_columns = unpack('II')
+    if version != _VERSION:
+        raise RuntimeError(f"{filename} has unsupported version {version}.")
+
+    names = []
+    shapes = []
+    for _ in range(n_columns):
+        (name_length,) = unpack('I')
+        names.append(data[offset:offset + name_length].decode('utf-8'))
+        offset += name_length
+        (ndim,) = unpack('I')
+        shapes.append(unpack('I' * ndim))
+
+    widths = [int(np.prod(shape, dtype=np.int64)) for shape in shapes]
+    timesteps = []
+    columns = [[] for _ in range(n_columns)]
+    while offset + 8 <= len(data):
+        (n_rows,) = unpack('Q')
+        block_size = 8 * n_rows * (1 + sum(widths))
+        if offset + block_size > len(data):
+            # the last block was not completely written
+            break
+
+        timesteps.append(
+            np.frombuffer(data, dtype=np.uint64, count=n_rows, offset=offset))
+        offset += 8 * n_rows
+        for c in range(n_columns):
+            values = np.frombuffer(data,
+                                   dtype=np.float64,
+                                   count=n_rows * widths[c],
+                                   offset=offset)
+            columns[c].append(values.reshape((n_rows,) + shapes[c]))
+            offset += 8 * n_rows * widths[c]
+
+    log = {'timestep': np.concatenate(timesteps or [np.empty(0, np.uint64)])}
+    for c, name in enumerate(names):
+        log[name] = np.concatenate(
+            columns[c] or [np.empty((0,) + shapes[c], np.float64)])
+    return log
+
+
+def _flush_binary_logs(simulation):
+    """Write the rows buffered by the binary logs of the simulation."""
+    for writer in simulation.operations.writers:
+        if isinstance(writer, BinaryLog) and writer._attached:
+            writer.flush()
+
+
+class BinaryLog(Writer):
+    """Write logged quantities to a columnar binary time series [RHEOINF].
+
+    Args:
+        trigger (hoomd.trigger.trigger_like): Select the timesteps to log.
+        filename (str): File name to write.
+        logger (hoomd.logging.Logger): Provide the quantities to write. Only
+            the ``scalar`` and ``sequence`` categories are accepted.
+        mode (str): ``'a'`` (the default) appends to an existing file that
+            logs the same quantities, after removing a truncated last block.
+            ``'w'`` overwrites the file.
+        buffer_size (int): Number of rows buffered in memory before they are
+            appended to the file as one block. Defaults to 1000.
+
+    `BinaryLog` is meant for logging quantities such as
+    ``pressure_tensor`` and ``virial_ind_tensor`` every few steps. C++ copies
+    each row into column buffers (as float64) and appends the buffered rows to
+    the file as one block, with no text formatting or per-frame file
+    structure. The buffered rows are also written at the end of every
+    `hoomd.Simulation.run` and by `flush`.
+
+    Read the file with `BinaryLog.read`:
+
+    .. code-block:: python
+
+        logger = hoomd.logging.Logger(categories=['scalar', 'sequence'])
+        logger.add(simulation, quantities=['timestep'])
+        binary_log = hoomd.write.BinaryLog(
+            trigger=hoomd.trigger.Periodic(1),
+            filename=binary_log_filename,
+            logger=logger,
+            mode='w')
+        simulation.operations.writers.append(binary_log)
+        simulation.run(10)
+
+        log = hoomd.write.BinaryLog.read(binary_log_filename)
+        steps = log['Simulation/timestep']
+
+    The file starts with a header naming the columns (the logger namespaces
+    joined with ``/``) and their shapes, followed by blocks holding the number
+    of rows, the timesteps, and the rows of each column in turn. The logged
+    quantities and their shapes are fixed by the first row.
+
+    Note:
+        Only the root rank writes. Unavailable (`None`) quantities are
+        written as NaN.
+
+    Attributes:
+        filename (str): File name to write (read only).
+        mode (str): File open mode (read only).
+        buffer_size (int): Number of rows buffered before a block is written.
+    """
+
+    accepted_categories = LoggerCategories.any(['scalar', 'sequence'])
+
+    def __init__(self, trigger, filename, logger, mode='a', buffer_size=1000):
+        super().__init__(trigger)
+        if mode not in ('w', 'a'):
+            raise ValueError(f"mode must be 'w' or 'a', got {mode}.")
+        if not isinstance(logger, Logger):
+            raise ValueError("logger must be a hoomd.logging.Logger.")
+        invalid = logger.categories & ~self.accepted_categories
+        if invalid != LoggerCategories.NONE:
+            invalid_str = LoggerCategories._get_string_list(invalid)
+            raise ValueError(
+                f"BinaryLog cannot log the {invalid_str} categories.")
+
+        self._param_dict.update(
+            ParameterDict(filename=str(filename),
+                          mode=str(mode),
+                          buffer_size=int(buffer_size)))
+        self._logger = logger
+
+    def _attach_hook(self):
+        self._cpp_obj = _hoomd.BinaryLogWriter(
+            self._simulation.state._cpp_sys_def, self.trigger, self.filename,
+            self._logger, self.mode, self.buffer_size)
+
+    @property
+    def logger(self):
+        """hoomd.logging.Logger: Provide the quantities to write."""
+        return self._logger
+
+    def flush(self):
+        """Write the buffered rows to the file.
+
+        .. rubric:: Example:
+
+        .. code-block:: python
+
+            binary_log.flush()
+        """
+        if self._attached:
+            self._cpp_obj.flush()
+
+    @staticmethod
+    def read(filename):
+        """Read a binary log file.
+
+        Args:
+            filename (str): File written by `BinaryLog`.
+
+        Returns:
+            dict[str, numpy.ndarray]: ``'timestep'`` holds the logged
+            timesteps. Each logged quantity is an array with one row per
+            timestep (float64, shape ``(N,)`` for scalars and ``(N,) + shape``
+            for sequences). A truncated last block is ignored.
+        """
+        return _read(filename)
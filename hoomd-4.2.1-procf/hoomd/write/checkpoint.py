@@ -0,0 +1,282 @@
+########## Created by the Rheoinformatic research group ##########
+# HOOMD-blue:
+#   Copyright (c) 2009-2023 The Regents of the University of Michigan.
+#   Part of HOOMD-blue, released under the BSD 3-Clause License.
+#
+# This file:
+#   Written by the Rheoinformatic research group (2026)
+
+########## Created by Rheoinformatic ##~ [RHEOINF] ##########
+
+"""Write binary checkpoints for bit-exact restarts.
+
+A checkpoint is a directory holding:
+
+* ``manifest.json``: the timestep, seed, number of ranks, domain decomposition,
+  and the state of operations that is not per-particle (variants, thermostat
+  and barostat degrees of freedom).
+* ``state.gsd``: the system topology (types, bonds, ...).
+* ``rank-NNNNN.bin``: one binary file per MPI rank with the exact global box,
+  the domain boundaries, the local particles in their in-memory order, and the
+  serialized state of the forces (including bond lifetimes) and neighbor lists.
+
+.. invisible-code-block: python
+
+    simulation = hoomd.util.make_example_simulation()
+    checkpoint_path = tmp_path / 'checkpoint'
+"""
+
+import base64
+import json
+import os
+import pickle
+
+import hoomd
+from hoomd import _hoomd
+from hoomd.write.gsd import GSD
+
+_FORMAT = 'hoomd-checkpoint'
+_VERSION = 1
+_MANIFEST = 'manifest.json'
+_STATE = 'state.gsd'
+
+
+def _rank_file(rank):
+    return f'rank-{rank:05d}.bin'
+
+
+def _encode_variant(variant):
+    """Pickle a variant into a string, None when it cannot be pickled."""
+    try:
+        return base64.b64encode(pickle.dumps(variant)).decode('ascii')
+    except (pickle.PicklingError, TypeError, AttributeError):
+        return None
+
+
+def _decode_variant(data):
+    return pickle.loads(base64.b64decode(data.encode('ascii')))
+
+
+def _section_objects(simulation):
+    """Map section names to the attached C++ objects stored per rank."""
+    objects = {}
+    integrator = simulation.operations.integrator
+    if integrator is None or not integrator._attached:
+        return objects
+
+    nlists = []
+    for i, force in enumerate(getattr(integrator, 'forces', [])):
+        if hasattr(force._cpp_obj, 'getCheckpointState'):
+            objects[f'force/{i}'] = force._cpp_obj
+        nlist = getattr(force, 'nlist', None)
+        if (nlist is not None and nlist._attached
+                and not any(nlist is other for other in nlists)):
+            nlists.append(nlist)
+
+    for i, nlist in enumerate(nlists):
+        objects[f'nlist/{i}'] = nlist._cpp_obj
+
+    return objects
+
+
+def _operation_state(simulation):
+    """Collect the operation state that is the same on every rank."""
+    state = {'integrator': None, 'updaters': []}
+
+    integrator = simulation.operations.integrator
+    if integrator is not None:
+        methods = []
+        for method in getattr(integrator, 'methods', []):
+            entry = {}
+            thermostat = getattr(method, 'thermostat', None)
+            if isinstance(thermostat, hoomd.md.methods.thermostats.MTTK):
+                entry['translational_dof'] = list(thermostat.translational_dof)
+                entry['rotational_dof'] = list(thermostat.rotational_dof)
+            if isinstance(method, hoomd.md.methods.ConstantPressure):
+                entry['barostat_dof'] = list(method.barostat_dof)
+            methods.append(entry)
+
+        vinf = getattr(integrator, 'vinf', None)
+        state['integrator'] = {
+            'vinf': None if vinf is None else _encode_variant(vinf),
+            'methods': methods
+        }
+
+    for updater in simulation.operations.updaters:
+        entry = {}
+        if isinstance(updater, hoomd.update.BoxShear):
+            entry['vinf'] = _encode_variant(updater.vinf)
+        state['updaters'].append(entry)
+
+    return state
+
+
+def _apply_operation_state(simulation, state):
+    """Set the operation state read from a manifest."""
+    integrator = simulation.operations.integrator
+    saved = state.get('integrator')
+    if integrator is not None and saved is not None:
+        if saved['vinf'] is not None and hasattr(integrator, 'vinf'):
+            integrator.vinf = _decode_variant(saved['vinf'])
+
+        methods = getattr(integrator, 'methods', [])
+        for method, entry in zip(methods, saved['methods']):
+            thermostat = getattr(method, 'thermostat', None)
+            if 'translational_dof' in entry and isinstance(
+                    thermostat, hoomd.md.methods.thermostats.MTTK):
+                thermostat.translational_dof = tuple(
+                    entry['translational_dof'])
+                thermostat.rotational_dof = tuple(entry['rotational_dof'])
+            if 'barostat_dof' in entry and isinstance(
+                    method, hoomd.md.methods.ConstantPressure):
+                method.barostat_dof = tuple(entry['barostat_dof'])
+
+    for updater, entry in zip(simulation.operations.updaters,
+                              state['updaters']):
+        if entry.get('vinf') is not None and isinstance(
+                updater, hoomd.update.BoxShear):
+            updater.vinf = _decode_variant(entry['vinf'])
+
+
+def _read_checkpoint(simulation, path):
+    """Create the simulation state from a checkpoint directory."""
+    path = _hoomd.mpi_bcast_str(str(path), simulation.device._cpp_exec_conf)
+    with open(os.path.join(path, _MANIFEST)) as f:
+        manifest = json.load(f)
+
+    if manifest.get('format') != _FORMAT or manifest.get('version') != _VERSION:
+        raise RuntimeError(f"{path} is not a version {_VERSION} checkpoint.")
+
+    communicator = simulation.device.communicator
+    if manifest['num_ranks'] != communicator.num_ranks:
+        raise RuntimeError(f"The checkpoint was written by "
+                           f"{manifest['num_ranks']} ranks, restart with the "
+                           f"same number of ranks.")
+
+    simulation.timestep = manifest['timestep']
+    if manifest['seed'] is not None:
+        simulation.seed = manifest['seed']
+    simulation.create_state_from_gsd(os.path.join(path, manifest['state']),
+                                     domain_decomposition=tuple(
+                                         manifest['domain_decomposition']))
+
+    checkpoint_file = _hoomd.CheckpointFile(
+        simulation.state._cpp_sys_def,
+        os.path.join(path, manifest['ranks'][communicator.rank]))
+    checkpoint_file.read()
+
+    simulation._checkpoint = (checkpoint_file, manifest)
+
+
+def _restore_operations(simulation):
+    """Restore the operation state of a pending checkpoint.
+
+    Called by `hoomd.Simulation.run` once the operations are attached.
+    """
+    checkpoint_file, manifest = simulation._checkpoint
+    simulation._checkpoint = None
+
+    objects = _section_objects(simulation)
+    for name in checkpoint_file.getSectionNames():
+        if name not in objects:
+            raise RuntimeError(f"The checkpoint stores {name}, which the "
+                               f"simulation does not have. Add the same "
+                               f"operations before the first run.")
+        objects[name].setCheckpointState(checkpoint_file.getSection(name))
+
+    _apply_operation_state(simulation, manifest['operations'])
+
+
+class Checkpoint:
+    """Write binary checkpoints for bit-exact restarts [RHEOINF].
+
+    `Checkpoint.write` stores the complete state of a simulation: the exact
+    global box (including the tilt accumulated by `hoomd.update.BoxShear`), the
+    particles of every rank in their in-memory order at full precision, the
+    timestep and seed, the force and neighbor list arrays with their rebuild
+    bookkeeping, the bond lifetime counters of DPD pair forces with
+    ``bond_calc=True``, the MTTK thermostat and barostat degrees of freedom, and
+    the variants of the integrator and `hoomd.update.BoxShear`.
+
+    Restore the state with `hoomd.Simulation.create_state_from_checkpoint`,
+    then add the same operations (in the same order) and call
+    `hoomd.Simulation.run`. The saved object state is applied when the
+    operations attach. Restarting with the same number of MPI ranks continues
+    the run bit for bit, as if it had never stopped.
+
+    Write checkpoints between calls to `hoomd.Simulation.run`:
+
+    .. code-block:: python
+
+        for chunk in range(10):
+            simulation.run(1_000)
+            hoomd.write.Checkpoint.write(simulation, checkpoint_path)
+
+    The manifest is written last and removed first, so an interrupted write
+    never leaves a directory that reads as a valid checkpoint. Alternate between
+    two directories to always keep the previous checkpoint.
+
+    Note:
+        The checkpoint files are native binary: restart with the same build
+        (precision and architecture) of HOOMD-blue. With domain decomposition,
+        systems with bonds, angles, dihedrals, impropers, constraints, or
+        special pairs are not supported.
+
+    Note:
+        Variants are functions of the timestep; restoring the exact timestep and
+        the saved variant objects restores their phase. Custom Python variants
+        that cannot be pickled are not saved.
+    """
+
+    @staticmethod
+    def write(simulation, path):
+        """Write a checkpoint of the simulation to a directory.
+
+        Args:
+            simulation (hoomd.Simulation): Simulation to checkpoint.
+            path (str): Directory to write (created when needed).
+        """
+        if simulation.state is None:
+            raise RuntimeError("Cannot write a checkpoint before the state is "
+                               "set.")
+
+        path = _hoomd.mpi_bcast_str(str(path),
+                                    simulation.device._cpp_exec_conf)
+        communicator = simulation.device.communicator
+        manifest_file = os.path.join(path, _MANIFEST)
+        if communicator.rank == 0:
+            os.makedirs(path, exist_ok=True)
+            if os.path.exists(manifest_file):
+                os.remove(manifest_file)
+        communicator.barrier()
+
+        GSD.write(state=simulation.state,
+                  filename=os.path.join(path, _STATE),
+                  mode='wb')
+
+        checkpoint_file = _hoomd.CheckpointFile(
+            simulation.state._cpp_sys_def,
+            os.path.join(path, _rank_file(communicator.rank)))
+        for name, cpp_obj in _section_objects(simulation).items():
+            checkpoint_file.setSection(name, cpp_obj.getCheckpointState())
+        checkpoint_file.write(simulation.timestep)
+        communicator.barrier()
+
+        if communicator.rank == 0:
+            manifest = {
+                'format': _FORMAT,
+                'version': _VERSION,
+                'timestep': simulation.timestep,
+                'seed': simulation.seed,
+                'num_ranks': communicator.num_ranks,
+                'domain_decomposition':
+                    list(simulation.state.domain_decomposition),
+                'state': _STATE,
+                'ranks': [
+                    _rank_file(rank) for rank in range(communicator.num_ranks)
+                ],
+                'operations': _operation_state(simulation)
+            }
+            with open(manifest_file, 'w') as f:
+                json.dump(manifest, f, indent=1)
+        communicator.barrier()
@@ -1,10 +1,12 @@
 # Copyright (c) 2009-2023 The Regents of the University of Michigan.
 # Part of HOOMD-blue, released under the BSD 3-Clause License.
 
+###### Modified by Rheoinformatic ##~ [RHEOINF] ######
+
 """Write GSD files storing simulation trajectories and logging data."""
 
 from collections.abc import Mapping, Collection
-from hoomd.trigger import Periodic
+from hoomd.trigger import Periodic, Trigger  ##~ [RHEOINF]
 from hoomd import _hoomd
 from hoomd.util import _dict_flatten
 from hoomd.data.typeconverter import OnlyFrom, RequiredArg
@@ -32,6 +34,27 @@ def _flush_open_gsd_writers():
 atexit.register(_flush_open_gsd_writers)
 
 
+##~ write out the frames queued by asynchronous writers [RHEOINF]
+def _flush_async_gsd_writers(simulation=None, wait_only=False):
+    """Flush the open asynchronous gsd writers (of the given simulation).
+
+    With ``wait_only``, only wait for the queued frames to reach the gsd
+    write buffer (the same state a synchronous writer is in).
+    """
+    for weak_writer in _open_gsd_writers:
+        writer = weak_writer()
+        if (writer is not None and writer._attached and writer.async_write
+                and (simulation is None
+                     or writer._simulation is simulation)):
+            if wait_only:
+                writer._cpp_obj.wait_for_pending_frames()
+            else:
+                writer.flush()
+
+
+##~
+
+
 def _array_to_strings(value):
     if isinstance(value, np.ndarray):
         string_list = []
@@ -65,6 +88,20 @@ class GSD(Writer):
             all frames. Defaults to ``['property']``.
         logger (hoomd.logging.Logger): Provide log quantities to write. Defaults
             to `None`.
+        async_write (bool): When `True`, write frames to the file from a
+            background thread. Defaults to `False`. [RHEOINF]
+        parallel_write (bool): When `True` (and with MPI domain
+            decomposition), each rank writes its own particles to the file
+            with collective MPI-IO. Defaults to `False`. [RHEOINF]
+        groups (list[tuple]): Additional ``(filter, trigger)`` or
+            ``(filter, trigger, dynamic)`` output groups written to the same
+            file. Defaults to `None`. [RHEOINF]
+        position_tolerance (float): Maximum error when rounding written
+            positions :math:`[\mathrm{length}]` (0 writes full precision).
+            Defaults to 0. [RHEOINF]
+        velocity_tolerance (float): Maximum error when rounding written
+            velocities :math:`[\mathrm{velocity}]` (0 writes full
+            precision). Defaults to 0. [RHEOINF]
 
     `GSD` writes the simulation trajectory to the specified file in the GSD
     format. `GSD` can store all particle, bond, angle, dihedral, improper,
@@ -155,6 +192,61 @@ class GSD(Writer):
         writes only the selected particles in ascending tag order and does
         **not** write out **topology**.
 
+    Note:
+        With ``async_write=True``, `GSD` copies each frame into memory and rank
+        0 writes it to the file in a background thread while the simulation
+        continues. At most one frame waits in the queue while another is
+        written, so a slow file system stalls the run instead of growing
+        memory use. `Simulation.run` and `GSD.write` (checkpoints) wait for
+        the queued frames before they return, and `flush()` writes them out.
+        The gather of particle data to rank 0 is unchanged. [RHEOINF]
+
+    Note:
+        By default, `GSD` gathers the particles of all MPI ranks to rank 0
+        and sorts them by tag before writing. With ``parallel_write=True``,
+        rank 0 writes only the frame header, type names, logged quantities,
+        topology, and the index, while all ranks write their particles
+        directly into the per-particle chunks (rows in ascending tag order,
+        as in a gathered frame) with one collective MPI-IO write per chunk.
+        The file layout is unchanged and readable by the ``gsd`` package.
+        This needs a file system that supports MPI-IO from all ranks. These
+        frames are written synchronously, also with ``async_write=True``.
+        Set ``parallel_write`` before the first frame is written.
+        [RHEOINF]
+
+    Note:
+        Use ``groups`` to write some particles more often than others in one
+        file, e.g. colloids every frame and the solvent occasionally::
+
+            gsd_writer = hoomd.write.GSD(
+                trigger=hoomd.trigger.Periodic(1000),
+                filename='trajectory.gsd',
+                filter=hoomd.filter.Type(['B']),
+                dynamic=['property', 'momentum'],
+                groups=[(hoomd.filter.Type(['A']),
+                         hoomd.trigger.Periodic(100000), ['property'])])
+
+        ``filter``, ``trigger``, and ``dynamic`` form group 0. Each frame
+        holds the particles of all groups whose trigger fires (in ascending
+        tag order) with the union of their ``dynamic`` fields (default:
+        ``['property']``). Every frame includes ``particles/N`` and the log
+        chunks ``log/gsd_groups/active`` (1 for each group in the frame) and
+        ``log/gsd_groups/tag`` (the tag of the particle in each row). Frames
+        with other groups than frame 0 include all non-default fields, as
+        readers cannot take them from frame 0. Set ``groups`` when
+        constructing `GSD`. [RHEOINF]
+
+    Note:
+        With ``position_tolerance`` or ``velocity_tolerance``, `GSD` rounds
+        positions or velocities to a fixed-point grid: multiples of the
+        largest power of two step not above twice the tolerance, so the
+        rounding error is at most the tolerance. Rounded values are still
+        stored as 32-bit floats (any GSD reader reads them unchanged), but
+        their low mantissa bits are zero, so compressing file systems and
+        tools such as ``zstd`` or ``gzip`` shrink the files substantially.
+        Only the written values are rounded, not the simulation state.
+        [RHEOINF]
+
     Tip:
         All logged data fields must be present in the first frame in the gsd
         file to provide the default value. To achieve this, set the `logger`
@@ -179,6 +271,14 @@ class GSD(Writer):
             diameters.
         maximum_write_buffer_size (int): Size (in bytes) to buffer in memory
            before writing to the file.
+        async_write (bool): When `True`, write frames to the file from a
+            background thread. [RHEOINF]
+        parallel_write (bool): When `True`, each rank writes its own
+            particles with collective MPI-IO. [RHEOINF]
+        position_tolerance (float): Maximum error when rounding written
+            positions :math:`[\mathrm{length}]`. [RHEOINF]
+        velocity_tolerance (float): Maximum error when rounding written
+            velocities :math:`[\mathrm{velocity}]`. [RHEOINF]
     """
 
     def __init__(self,
@@ -188,7 +288,12 @@ class GSD(Writer):
                  mode='ab',
                  truncate=False,
                  dynamic=None,
-                 logger=None):
+                 logger=None,
+                 async_write=False,
+                 parallel_write=False,
+                 groups=None,
+                 position_tolerance=0.0,
+                 velocity_tolerance=0.0):  ##~ [RHEOINF]
 
         super().__init__(trigger)
 
@@ -223,10 +328,36 @@ class GSD(Writer):
                           dynamic=[dynamic_validation],
                           write_diameter=False,
                           maximum_write_buffer_size=64 * 1024 * 1024,
+                          async_write=bool(async_write),  ##~ [RHEOINF]
+                          parallel_write=bool(parallel_write),  ##~ [RHEOINF]
+                          position_tolerance=float(
+                              position_tolerance),  ##~ [RHEOINF]
+                          velocity_tolerance=float(
+                              velocity_tolerance),  ##~ [RHEOINF]
                           _defaults=dict(filter=filter, dynamic=dynamic)))
 
         self._logger = None if logger is None else _GSDLogWriter(logger)
 
+        ##~ validate the output groups [RHEOINF]
+        self._groups = []
+        for group in [] if groups is None else groups:
+            if len(group) not in (2, 3):
+                raise ValueError("GSD.groups entries must be (filter, trigger)"
+                                 " or (filter, trigger, dynamic) tuples.")
+            group_filter, group_trigger = group[0], group[1]
+            group_dynamic = ['property'] if len(group) == 2 else group[2]
+            if not isinstance(group_filter, ParticleFilter):
+                raise TypeError("GSD.groups filters must be ParticleFilter "
+                                "instances.")
+            if isinstance(group_trigger, int):
+                group_trigger = Periodic(group_trigger)
+            if not isinstance(group_trigger, Trigger):
+                raise TypeError("GSD.groups triggers must be Trigger "
+                                "instances or integers.")
+            group_dynamic = [dynamic_validation(d) for d in group_dynamic]
+            self._groups.append((group_filter, group_trigger, group_dynamic))
+        ##~
+
     def _attach_hook(self):
         self._cpp_obj = _hoomd.GSDDumpWriter(
             self._simulation.state._cpp_sys_def, self.trigger, self.filename,
@@ -235,6 +366,13 @@ class GSD(Writer):
 
         self._cpp_obj.log_writer = self.logger
 
+        ##~ [RHEOINF]
+        for group_filter, group_trigger, group_dynamic in self._groups:
+            self._cpp_obj.add_output_group(
+                self._simulation.state._get_group(group_filter), group_trigger,
+                group_dynamic)
+        ##~
+
         # Maintain a list of open gsd writers
         weak_writer = weakref.ref(self)
         _open_gsd_writers.append(weak_writer)
@@ -257,6 +395,10 @@ class GSD(Writer):
         if mode != 'wb' and mode != 'xb':
             raise ValueError(f"Invalid GSD.write file mode: {mode}")
 
+        ##~ make the trajectory consistent with the checkpoint [RHEOINF]
+        _flush_async_gsd_writers(state._simulation)
+        ##~
+
         writer = _hoomd.GSDDumpWriter(state._cpp_sys_def, Periodic(1),
                                       str(filename), state._get_group(filter),
                                       mode, False)
@@ -266,6 +408,15 @@ class GSD(Writer):
         writer.analyze(state._simulation.timestep)
         writer.flush()
 
+    ##~ output groups [RHEOINF]
+    @property
+    def groups(self):
+        """list[tuple]: The additional ``(filter, trigger, dynamic)`` output
+        groups (read only). [RHEOINF]"""
+        return list(self._groups)
+
+    ##~
+
     @property
     def logger(self):
         """hoomd.logging.Logger: Provide log quantities to write.
@@ -0,0 +1,62 @@
+## benchmark: cost of logging thermodynamic quantities every step with
+## hoomd.write.Table (text, scalars only), a log-only hoomd.write.GSD file
+## (filter=Null), and hoomd.write.BinaryLog (columnar binary time series)
+## reports TPS and the logging cost per row (microseconds) relative to no output
+## usage: python3 bench-binary-log.py [L_X] [phi] [output_dir]
+
+
+######### MODULE LIBRARY
+# Use HOOMD-blue
+import hoomd
+import hoomd.md # molecular dynamics
+# Other
+import os
+import sys
+import dpd_bench_system as bench
+
+
+######### SIMULATION INPUTS
+L_X = float(sys.argv[1]) if len(sys.argv) > 1 else 30 # box size
+phi = float(sys.argv[2]) if len(sys.argv) > 2 else 0.2 # colloid volume fraction
+output_dir = sys.argv[3] if len(sys.argv) > 3 else '.' # where to write the logs
+n_warmup = 500 # steps before timing (autotuning)
+n_steps = 2000 # timed steps, one logged row each
+buffer = 0.05 # nlist buffer (as in the sim-templates)
+
+
+######### BENCHMARK
+device = hoomd.device.CPU()
+snapshot = bench.make_snapshot(L_X, phi, device=device)
+
+def make_writer(label, thermo):
+  if label == "Table":
+    # Table cannot log sequences: log the scalar pressure and temperature
+    logger = hoomd.logging.Logger(categories=['scalar'])
+    logger.add(thermo, quantities=['pressure', 'kinetic_temperature'])
+    out = open(os.path.join(output_dir, 'bench-binary-log.txt'), 'w')
+    return hoomd.write.Table(trigger=hoomd.trigger.Periodic(1), logger=logger, output=out)
+  logger = hoomd.logging.Logger(categories=['scalar', 'sequence'])
+  logger.add(thermo, quantities=['pressure_tensor', 'virial_ind_tensor', 'kinetic_temperature'])
+  if label == "GSD log":
+    return hoomd.write.GSD(trigger=hoomd.trigger.Periodic(1),
+      filename=os.path.join(output_dir, 'bench-binary-log.gsd'), mode='wb',
+      filter=hoomd.filter.Null(), logger=logger)
+  return hoomd.write.BinaryLog(trigger=hoomd.trigger.Periodic(1),
+    filename=os.path.join(output_dir, 'bench-binary-log.bin'), logger=logger, mode='w')
+
+tps_none = None
+for label in ["no output", "Table", "GSD log", "BinaryLog"]:
+  nl = hoomd.md.nlist.Tree(buffer=buffer)
+  morse = bench.make_dpd_morse(nl)
+  sim = bench.make_simulation(snapshot, [morse], device=device)
+  thermo = hoomd.md.compute.ThermodynamicQuantities(filter=hoomd.filter.All())
+  sim.operations.computes.append(thermo)
+  if label != "no output":
+    sim.operations.writers.append(make_writer(label, thermo))
+  tps, elapsed = bench.time_run(sim, n_warmup, n_steps)
+  values = dict(TPS=round(tps, 2))
+  if tps_none is None:
+    tps_none = tps
+  else:
+    values['us_per_row'] = round((1/tps - 1/tps_none) * 1e6, 1)
+  bench.report(device, label, values)
@@ -0,0 +1,41 @@
+## benchmark: neighbor-list-free (cell list) pair evaluation vs. Tree and Cell
+## (binned) neighbor lists for the DPDMorse pair force
+## in cell list mode the pair loop searches the 27 cells around each particle
+## every step, so it is fastest for a pure solvent (uniform r_c = 1); with
+## colloids the cell width grows to the largest cutoff (r_c + 2R)
+## usage: python3 bench-cell-pair-mode.py [L_X] [phi]
+##        mpirun -n 8 python3 bench-cell-pair-mode.py 40 0.0
+
+
+######### MODULE LIBRARY
+# Use HOOMD-blue
+import hoomd
+import hoomd.md # molecular dynamics
+# Other
+import sys
+import dpd_bench_system as bench
+
+
+######### SIMULATION INPUTS
+L_X = float(sys.argv[1]) if len(sys.argv) > 1 else 30 # box size
+phi = float(sys.argv[2]) if len(sys.argv) > 2 else 0.0 # colloid volume fraction
+n_warmup = 200 # steps before timing (autotuning, sorting)
+n_steps = 1000 # timed steps
+buffer = 0.05 # nlist buffer (as in the sim-templates)
+
+
+######### BENCHMARK
+device = hoomd.device.CPU()
+snapshot = bench.make_snapshot(L_X, phi, device=device)
+## label, nlist class, cell list mode
+modes = [("Tree nlist", hoomd.md.nlist.Tree, False),
+  ("Cell (binned) nlist", hoomd.md.nlist.Cell, False),
+  ("cell list mode", hoomd.md.nlist.Cell, True)]
+for label, nlist_cls, cell_list in modes:
+  nl = nlist_cls(buffer=buffer)
+  morse = bench.make_dpd_morse(nl, cell_list=cell_list)
+  sim = bench.make_simulation(snapshot, [morse], device=device)
+  tps, elapsed = bench.time_run(sim, n_warmup, n_steps)
+  ## in cell list mode num_builds counts the displacement-check triggers (no list is built)
+  values = dict(TPS=round(tps, 2), builds=nl.num_builds)
+  bench.report(device, label, values)
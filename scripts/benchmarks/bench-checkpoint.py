@@ -0,0 +1,70 @@
+## benchmark: restart from a GSD file vs. from a binary checkpoint
+## (hoomd.write.Checkpoint); times writing, restarting (state creation and the
+## first step), and reports how far the restarted run drifts from the
+## uninterrupted one (0 for an exact restart)
+## usage: python3 bench-checkpoint.py [L_X] [phi] [output_dir]
+
+
+######### MODULE LIBRARY
+# Use HOOMD-blue
+import hoomd
+import hoomd.md # molecular dynamics
+# Other
+import os
+import sys
+import time # wall-clock timing
+import numpy as np
+import dpd_bench_system as bench
+
+
+######### SIMULATION INPUTS
+L_X = float(sys.argv[1]) if len(sys.argv) > 1 else 30 # box size
+phi = float(sys.argv[2]) if len(sys.argv) > 2 else 0.2 # colloid volume fraction
+output_dir = sys.argv[3] if len(sys.argv) > 3 else '.' # where to write the restart files
+n_warmup = 500 # steps before the restart point
+n_steps = 1000 # steps run after the restart point
+buffer = 0.05 # nlist buffer (as in the sim-templates)
+
+
+######### BENCHMARK
+device = hoomd.device.CPU()
+snapshot = bench.make_snapshot(L_X, phi, device=device)
+
+def make_forces():
+  nl = hoomd.md.nlist.Tree(buffer=buffer)
+  return [bench.make_dpd_morse(nl, bond_calc=True)]
+
+## uninterrupted reference run, writing both restart files at the restart point
+sim = bench.make_simulation(snapshot, make_forces(), device=device)
+sim.run(n_warmup)
+gsd_file = os.path.join(output_dir, 'bench-checkpoint.gsd')
+checkpoint_dir = os.path.join(output_dir, 'bench-checkpoint')
+t0 = time.perf_counter()
+hoomd.write.GSD.write(state=sim.state, filename=gsd_file, mode='wb')
+gsd_write = time.perf_counter() - t0
+t0 = time.perf_counter()
+hoomd.write.Checkpoint.write(sim, checkpoint_dir)
+checkpoint_write = time.perf_counter() - t0
+sim.run(n_steps)
+reference = sim.state.get_snapshot()
+
+## restart from each file and continue the run
+for label, write_time in [("GSD", gsd_write), ("checkpoint", checkpoint_write)]:
+  restart = hoomd.Simulation(device=device, seed=sim.seed)
+  t0 = time.perf_counter()
+  if label == "GSD":
+    restart.create_state_from_gsd(gsd_file)
+  else:
+    restart.create_state_from_checkpoint(checkpoint_dir)
+  nve = hoomd.md.methods.ConstantVolume(filter=hoomd.filter.All(), thermostat=None)
+  restart.operations.integrator = hoomd.md.Integrator(dt=bench.dt_Integration,
+    forces=make_forces(), methods=[nve])
+  restart.run(1)
+  restart_time = time.perf_counter() - t0
+  restart.run(n_steps - 1)
+  snap = restart.state.get_snapshot()
+  values = dict(write_s=round(write_time, 3), restart_s=round(restart_time, 3))
+  if device.communicator.rank == 0:
+    delta = snap.particles.position - reference.particles.position
+    values['max_drift'] = float(np.max(np.abs(delta)))
+  bench.report(device, label, values)
@@ -0,0 +1,77 @@
+## benchmark: cost of the colloid coordination numbers of a DPD gel counted in
+## situ with hoomd.md.analyze.Coordination (on the DPDMorse neighbor list) vs.
+## taking a snapshot and an O(N^2) loop over the colloids for every frame
+## reports TPS and the analysis cost per frame (milliseconds) relative to none
+## usage: python3 bench-coordination.py [L_X] [phi] [period]
+
+
+######### MODULE LIBRARY
+# Use HOOMD-blue
+import hoomd
+import hoomd.md # molecular dynamics
+# Maths
+import numpy as np
+# Other
+import sys
+import dpd_bench_system as bench
+
+
+######### SIMULATION INPUTS
+L_X = float(sys.argv[1]) if len(sys.argv) > 1 else 30 # box size
+phi = float(sys.argv[2]) if len(sys.argv) > 2 else 0.2 # colloid volume fraction
+period = int(sys.argv[3]) if len(sys.argv) > 3 else 10 # steps between frames
+n_warmup = 500 # steps before timing (autotuning)
+n_steps = 2000 # timed steps
+buffer = 0.05 # nlist buffer (as in the sim-templates)
+gap = round(3/bench.kappa, 2) # contact cut-off: the attraction range (as in the analysis scripts)
+max_z = 12 # last bin of the Z distribution
+
+
+######### BENCHMARK
+device = hoomd.device.CPU()
+snapshot = bench.make_snapshot(L_X, phi, device=device)
+
+class SnapshotZ(hoomd.custom.Action):
+  """Z distribution of the colloids from a snapshot with an O(N^2) loop"""
+
+  def __init__(self):
+    self.hist = np.zeros(max_z + 1)
+
+  def act(self, timestep):
+    snap = self._state.get_snapshot()
+    if snap.communicator.rank == 0:
+      colloid = snap.particles.typeid == 1
+      pos = snap.particles.position[colloid]
+      d = snap.particles.diameter[colloid]
+      L = snap.configuration.box[:3]
+      Z = np.zeros(len(pos), dtype=int)
+      for i in range(len(pos) - 1):
+        dr = pos[i+1:] - pos[i]
+        dr -= L * np.round(dr / L)
+        h = np.linalg.norm(dr, axis=1) - 0.5*(d[i] + d[i+1:])
+        contact = np.nonzero(h < gap)[0]
+        Z[i] += len(contact)
+        Z[i + 1 + contact] += 1
+      self.hist += np.bincount(np.minimum(Z, max_z), minlength=max_z + 1)
+
+tps_none = None
+for label in ["no Z", "Coordination force nlist", "snapshot O(N^2)"]:
+  nl = hoomd.md.nlist.Tree(buffer=buffer)
+  morse = bench.make_dpd_morse(nl)
+  sim = bench.make_simulation(snapshot, [morse], device=device)
+  trigger = hoomd.trigger.Periodic(period)
+  if label == "snapshot O(N^2)":
+    sim.operations.writers.append(hoomd.write.CustomWriter(action=SnapshotZ(), trigger=trigger))
+  elif label != "no Z":
+    coordination = hoomd.md.analyze.Coordination(trigger=trigger, nlist=nl, gap=gap,
+      max_z=max_z, types=['B'])
+    sim.operations.writers.append(coordination)
+  tps, elapsed = bench.time_run(sim, n_warmup, n_steps)
+  values = dict(TPS=round(tps, 2))
+  if tps_none is None:
+    tps_none = tps
+  else:
+    values['ms_per_frame'] = round((1/tps - 1/tps_none) * period * 1e3, 2)
+    if label != "snapshot O(N^2)":
+      values['Z_avg'] = round(coordination.z_avg, 3)
+  bench.report(device, label, values)
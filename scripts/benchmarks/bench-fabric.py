@@ -0,0 +1,86 @@
+## benchmark: cost of the colloid fabric tensor of a sheared DPD gel accumulated
+## in situ with hoomd.md.analyze.Fabric (on the DPDMorse neighbor list) vs.
+## taking a snapshot and an O(N^2) loop over the colloids (as fabric_tensor in
+## the shear analysis scripts) for every frame
+## reports TPS and the analysis cost per frame (milliseconds) relative to none
+## usage: python3 bench-fabric.py [L_X] [phi] [period]
+
+
+######### MODULE LIBRARY
+# Use HOOMD-blue
+import hoomd
+import hoomd.md # molecular dynamics
+# Maths
+import numpy as np
+# Other
+import sys
+import dpd_bench_system as bench
+
+
+######### SIMULATION INPUTS
+L_X = float(sys.argv[1]) if len(sys.argv) > 1 else 30 # box size
+phi = float(sys.argv[2]) if len(sys.argv) > 2 else 0.2 # colloid volume fraction
+period = int(sys.argv[3]) if len(sys.argv) > 3 else 10 # steps between frames
+n_warmup = 500 # steps before timing (autotuning)
+n_steps = 2000 # timed steps
+buffer = 0.05 # nlist buffer (as in the sim-templates)
+shear_rate = 0.1 # steady shear (as in the shear sim-templates)
+gap = 0.3 # contact cut-off (as in the shear analysis scripts)
+
+
+######### BENCHMARK
+device = hoomd.device.CPU()
+snapshot = bench.make_snapshot(L_X, phi, device=device)
+vinf = hoomd.variant.Constant(shear_rate * L_X)
+
+class SnapshotFabric(hoomd.custom.Action):
+  """R_xy of the colloids from a snapshot with an O(N^2) loop in the tilted box"""
+
+  def __init__(self):
+    self.rxy = []
+
+  def act(self, timestep):
+    snap = self._state.get_snapshot()
+    if snap.communicator.rank == 0:
+      colloid = snap.particles.typeid == 1
+      pos = snap.particles.position[colloid]
+      d = snap.particles.diameter[colloid]
+      L = snap.configuration.box[:3]
+      xy = snap.configuration.box[3]
+      rxy = 0.0
+      for i in range(len(pos) - 1):
+        dr = pos[i] - pos[i+1:]
+        dr[:, 2] -= L[2] * np.round(dr[:, 2] / L[2])
+        img = L[1] * np.round(dr[:, 1] / L[1])
+        dr[:, 1] -= img
+        dr[:, 0] -= img * xy
+        dr[:, 0] -= L[0] * np.round(dr[:, 0] / L[0])
+        r2 = np.sum(dr**2, axis=1)
+        contact = np.sqrt(r2) - 0.5*(d[i] + d[i+1:]) < gap
+        rxy += np.sum(dr[contact, 0] * dr[contact, 1] / r2[contact])
+      self.rxy.append(rxy / len(pos))
+
+tps_none = None
+for label in ["no fabric", "Fabric force nlist", "snapshot O(N^2)"]:
+  nl = hoomd.md.nlist.Tree(buffer=buffer)
+  morse = bench.make_dpd_morse(nl)
+  sim = bench.make_simulation(snapshot, [morse], device=device)
+  sim.operations.integrator.vinf = vinf
+  sim.operations.updaters.append(hoomd.update.BoxShear(trigger=1, vinf=vinf,
+    deltaT=bench.dt_Integration, flip=True))
+  trigger = hoomd.trigger.Periodic(period)
+  if label == "snapshot O(N^2)":
+    sim.operations.writers.append(hoomd.write.CustomWriter(action=SnapshotFabric(),
+      trigger=trigger))
+  elif label != "no fabric":
+    fabric = hoomd.md.analyze.Fabric(trigger=trigger, nlist=nl, gap=gap, types=['B'])
+    sim.operations.writers.append(fabric)
+  tps, elapsed = bench.time_run(sim, n_warmup, n_steps)
+  values = dict(TPS=round(tps, 2))
+  if tps_none is None:
+    tps_none = tps
+  else:
+    values['ms_per_frame'] = round((1/tps - 1/tps_none) * period * 1e3, 2)
+    if label != "snapshot O(N^2)":
+      values['anisotropy'] = round(fabric.anisotropy, 4)
+  bench.report(device, label, values)
@@ -0,0 +1,44 @@
+## benchmark: direction by direction vs. neighborhood collective ghost updates
+## with neighbor_collectives, the per step ghost update is a single
+## MPI_Neighbor_alltoallv over the (up to 26) neighbor domains instead of
+## up to 6 sequential exchanges (x, then y, then z, forwarding corners)
+## the gain is largest for many ranks with small domains (latency bound)
+## usage: mpirun -n 64 python3 bench-ghost-exchange.py [L_X] [phi]
+
+
+######### MODULE LIBRARY
+# Use HOOMD-blue
+import hoomd
+import hoomd.md # molecular dynamics
+# Other
+import sys
+import dpd_bench_system as bench
+
+
+######### SIMULATION INPUTS
+L_X = float(sys.argv[1]) if len(sys.argv) > 1 else 24 # box size (small domains)
+phi = float(sys.argv[2]) if len(sys.argv) > 2 else 0.2 # colloid volume fraction
+n_warmup = 200 # steps before timing (autotuning, sorting)
+n_steps = 1000 # timed steps
+buffer = 0.05 # nlist buffer (as in the sim-templates)
+
+
+######### BENCHMARK
+device = hoomd.device.CPU()
+snapshot = bench.make_snapshot(L_X, phi, device=device)
+if device.communicator.num_ranks == 1:
+  print("note: a single rank has no ghost particles")
+## label, neighbor_collectives
+modes = [("direction by direction", False),
+  ("neighbor_collectives", True)]
+for label, neighbor_collectives in modes:
+  ## the option is read when the state is created
+  device.communicator.neighbor_collectives = neighbor_collectives
+  nl = hoomd.md.nlist.Tree(buffer=buffer)
+  morse = bench.make_dpd_morse(nl)
+  sim = bench.make_simulation(snapshot, [morse], device=device)
+  tps, elapsed = bench.time_run(sim, n_warmup, n_steps)
+  ## domains per rank: smaller domains -> more latency bound ghost updates
+  values = dict(TPS=round(tps, 2), builds=nl.num_builds,
+    ranks=device.communicator.num_ranks)
+  bench.report(device, label, values)
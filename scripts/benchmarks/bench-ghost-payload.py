@@ -0,0 +1,45 @@
+## benchmark: compact ghost payloads for the DPDMorse pair force
+## compact_ghosts sends ghost diameters/charges once per type when all ghosts
+## of a type share one value (the solvent); ghost_velocity_float sends the per
+## step ghost velocities as 3 floats (12 bytes) instead of a Scalar4 (32 bytes
+## in double precision builds)
+## only meaningful with several MPI ranks (a single rank has no ghosts)
+## usage: mpirun -n 8 python3 bench-ghost-payload.py [L_X] [phi]
+
+
+######### MODULE LIBRARY
+# Use HOOMD-blue
+import hoomd
+import hoomd.md # molecular dynamics
+# Other
+import sys
+import dpd_bench_system as bench
+
+
+######### SIMULATION INPUTS
+L_X = float(sys.argv[1]) if len(sys.argv) > 1 else 40 # box size
+phi = float(sys.argv[2]) if len(sys.argv) > 2 else 0.2 # colloid volume fraction
+n_warmup = 200 # steps before timing (autotuning, sorting)
+n_steps = 1000 # timed steps
+buffer = 0.05 # nlist buffer (as in the sim-templates)
+
+
+######### BENCHMARK
+device = hoomd.device.CPU()
+snapshot = bench.make_snapshot(L_X, phi, device=device)
+if device.communicator.num_ranks == 1:
+  print("note: a single rank has no ghost particles")
+## label, compact_ghosts, ghost_velocity_float
+modes = [("full ghost payload", False, False),
+  ("compact_ghosts", True, False),
+  ("compact_ghosts + ghost_velocity_float", True, True)]
+for label, compact_ghosts, ghost_velocity_float in modes:
+  ## the options are read when the state is created
+  device.communicator.compact_ghosts = compact_ghosts
+  device.communicator.ghost_velocity_float = ghost_velocity_float
+  nl = hoomd.md.nlist.Tree(buffer=buffer)
+  morse = bench.make_dpd_morse(nl)
+  sim = bench.make_simulation(snapshot, [morse], device=device)
+  tps, elapsed = bench.time_run(sim, n_warmup, n_steps)
+  values = dict(TPS=round(tps, 2), builds=nl.num_builds)
+  bench.report(device, label, values)
@@ -0,0 +1,52 @@
+## benchmark: synchronous vs. asynchronous GSD trajectory writes
+## writes position, velocity, and image (dynamic=['property','momentum'])
+## every write_period steps; with async_write=True rank 0 writes the file
+## from a background thread while the simulation continues
+## usage: python3 bench-gsd-async.py [L_X] [phi] [write_period] [output_dir]
+
+
+######### MODULE LIBRARY
+# Use HOOMD-blue
+import hoomd
+import hoomd.md # molecular dynamics
+# Other
+import os
+import sys
+import dpd_bench_system as bench
+
+
+######### SIMULATION INPUTS
+L_X = float(sys.argv[1]) if len(sys.argv) > 1 else 30 # box size
+phi = float(sys.argv[2]) if len(sys.argv) > 2 else 0.2 # colloid volume fraction
+write_period = int(sys.argv[3]) if len(sys.argv) > 3 else 10 # steps between frames
+output_dir = sys.argv[4] if len(sys.argv) > 4 else '.' # where to write the trajectories
+n_warmup = 500 # steps before timing (autotuning)
+n_steps = 2000 # timed steps
+buffer = 0.05 # nlist buffer (as in the sim-templates)
+
+
+######### BENCHMARK
+device = hoomd.device.CPU()
+snapshot = bench.make_snapshot(L_X, phi, device=device)
+## label, async_write (None: no GSD output)
+modes = [("no output", None),
+  ("async_write = False", False),
+  ("async_write = True", True)]
+for label, async_write in modes:
+  nl = hoomd.md.nlist.Tree(buffer=buffer)
+  morse = bench.make_dpd_morse(nl)
+  sim = bench.make_simulation(snapshot, [morse], device=device)
+  filename = os.path.join(output_dir, 'bench-gsd-async-' + str(async_write) + '.gsd')
+  if async_write is not None:
+    gsd_writer = hoomd.write.GSD(trigger=hoomd.trigger.Periodic(write_period),
+      filename=filename, mode='wb', dynamic=['property','momentum'],
+      async_write=async_write)
+    sim.operations.writers.append(gsd_writer)
+  tps, elapsed = bench.time_run(sim, n_warmup, n_steps)
+  values = dict(TPS=round(tps, 2))
+  if async_write is not None:
+    gsd_writer.flush()
+    if device.communicator.rank == 0:
+      values['file_MB'] = round(os.path.getsize(filename)/1e6, 1)
+    sim.operations.writers.remove(gsd_writer)
+  bench.report(device, label, values)
@@ -0,0 +1,47 @@
+## benchmark: initialization from a GSD file read on rank 0 vs. read by all
+## ranks (distributed=True in Simulation.create_state_from_gsd); times the state
+## creation and reports the peak memory of rank 0, which holds the whole frame
+## (and the global snapshot) only in the root rank read
+## run each mode in its own process, the peak memory never decreases
+## usage: mpirun -n 64 python3 bench-gsd-distributed-init.py [L_X] [phi] [mode] [output_dir]
+## mode: 'write' (create the file), 'root', or 'distributed'
+
+
+######### MODULE LIBRARY
+# Use HOOMD-blue
+import hoomd
+# Other
+import os
+import resource # peak memory
+import sys
+import time # wall-clock timing
+import dpd_bench_system as bench
+
+
+######### SIMULATION INPUTS
+L_X = float(sys.argv[1]) if len(sys.argv) > 1 else 100 # box size
+phi = float(sys.argv[2]) if len(sys.argv) > 2 else 0.2 # colloid volume fraction
+mode = sys.argv[3] if len(sys.argv) > 3 else 'distributed' # 'write', 'root', or 'distributed'
+output_dir = sys.argv[4] if len(sys.argv) > 4 else '.' # where the GSD file is (a parallel file system)
+
+
+######### BENCHMARK
+device = hoomd.device.CPU()
+gsd_file = os.path.join(output_dir, 'bench-gsd-distributed-init.gsd')
+
+if mode == 'write':
+  snapshot = bench.make_snapshot(L_X, phi, device=device)
+  sim = hoomd.Simulation(device=device, seed=42)
+  sim.create_state_from_snapshot(snapshot)
+  hoomd.write.GSD.write(state=sim.state, filename=gsd_file, mode='wb')
+  bench.report(device, "write", dict(N=sim.state.N_particles))
+else:
+  sim = hoomd.Simulation(device=device, seed=42)
+  device.communicator.barrier()
+  t0 = time.perf_counter()
+  sim.create_state_from_gsd(gsd_file, distributed=(mode == 'distributed'))
+  device.communicator.barrier()
+  init_time = time.perf_counter() - t0
+  peak_mb = resource.getrusage(resource.RUSAGE_SELF).ru_maxrss / 1024
+  bench.report(device, mode, dict(N=sim.state.N_particles, init_s=round(init_time, 3),
+    rank0_peak_MB=round(peak_mb, 1)))
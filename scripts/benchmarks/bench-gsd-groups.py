@@ -0,0 +1,55 @@
+## benchmark: one GSD writer for all particles vs. per-type output groups
+## 'all particles' writes solvent and colloids every write_period steps;
+## 'output groups' writes the colloids (B) every write_period steps and adds
+## the solvent (A) only every solvent_period steps, in the same file
+## usage: python3 bench-gsd-groups.py [L_X] [phi] [write_period] [solvent_period] [output_dir]
+
+
+######### MODULE LIBRARY
+# Use HOOMD-blue
+import hoomd
+import hoomd.md # molecular dynamics
+# Other
+import os
+import sys
+import dpd_bench_system as bench
+
+
+######### SIMULATION INPUTS
+L_X = float(sys.argv[1]) if len(sys.argv) > 1 else 30 # box size
+phi = float(sys.argv[2]) if len(sys.argv) > 2 else 0.2 # colloid volume fraction
+write_period = int(sys.argv[3]) if len(sys.argv) > 3 else 10 # steps between colloid frames
+solvent_period = int(sys.argv[4]) if len(sys.argv) > 4 else 500 # steps between solvent frames
+output_dir = sys.argv[5] if len(sys.argv) > 5 else '.' # where to write the trajectories
+n_warmup = 500 # steps before timing (autotuning)
+n_steps = 2000 # timed steps
+buffer = 0.05 # nlist buffer (as in the sim-templates)
+
+
+######### BENCHMARK
+device = hoomd.device.CPU()
+snapshot = bench.make_snapshot(L_X, phi, device=device)
+## label, use output groups
+modes = [("all particles", False),
+  ("output groups", True)]
+for label, use_groups in modes:
+  nl = hoomd.md.nlist.Tree(buffer=buffer)
+  morse = bench.make_dpd_morse(nl)
+  sim = bench.make_simulation(snapshot, [morse], device=device)
+  filename = os.path.join(output_dir, 'bench-gsd-groups-' + str(use_groups) + '.gsd')
+  if use_groups:
+    gsd_writer = hoomd.write.GSD(trigger=hoomd.trigger.Periodic(write_period),
+      filename=filename, filter=hoomd.filter.Type(['B']), mode='wb',
+      dynamic=['property','momentum'],
+      groups=[(hoomd.filter.Type(['A']), hoomd.trigger.Periodic(solvent_period), ['property'])])
+  else:
+    gsd_writer = hoomd.write.GSD(trigger=hoomd.trigger.Periodic(write_period),
+      filename=filename, filter=hoomd.filter.All(), mode='wb',
+      dynamic=['property','momentum'])
+  sim.operations.writers.append(gsd_writer)
+  tps, elapsed = bench.time_run(sim, n_warmup, n_steps)
+  gsd_writer.flush()
+  values = dict(TPS=round(tps, 2))
+  if device.communicator.rank == 0:
+    values['file_MB'] = round(os.path.getsize(filename)/1e6, 1)
+  bench.report(device, label, values)
@@ -0,0 +1,54 @@
+## benchmark: gathered vs. parallel (MPI-IO) GSD trajectory writes
+## by default every frame is gathered to rank 0 and sorted by tag before rank 0
+## writes it; with parallel_write=True each rank writes its own particles to
+## the file with collective MPI-IO and rank 0 writes only the headers and index
+## usage: mpirun -n 64 python3 bench-gsd-parallel.py [L_X] [phi] [write_period] [output_dir]
+
+
+######### MODULE LIBRARY
+# Use HOOMD-blue
+import hoomd
+import hoomd.md # molecular dynamics
+# Other
+import os
+import sys
+import dpd_bench_system as bench
+
+
+######### SIMULATION INPUTS
+L_X = float(sys.argv[1]) if len(sys.argv) > 1 else 60 # box size
+phi = float(sys.argv[2]) if len(sys.argv) > 2 else 0.2 # colloid volume fraction
+write_period = int(sys.argv[3]) if len(sys.argv) > 3 else 10 # steps between frames
+output_dir = sys.argv[4] if len(sys.argv) > 4 else '.' # where to write (a parallel file system)
+n_warmup = 500 # steps before timing (autotuning)
+n_steps = 1000 # timed steps
+buffer = 0.05 # nlist buffer (as in the sim-templates)
+
+
+######### BENCHMARK
+device = hoomd.device.CPU()
+snapshot = bench.make_snapshot(L_X, phi, device=device)
+if device.communicator.num_ranks == 1:
+  print("note: parallel_write only applies with several MPI ranks")
+## label, parallel_write (None: no GSD output)
+modes = [("no output", None),
+  ("parallel_write = False", False),
+  ("parallel_write = True", True)]
+for label, parallel_write in modes:
+  nl = hoomd.md.nlist.Tree(buffer=buffer)
+  morse = bench.make_dpd_morse(nl)
+  sim = bench.make_simulation(snapshot, [morse], device=device)
+  filename = os.path.join(output_dir, 'bench-gsd-parallel-' + str(parallel_write) + '.gsd')
+  if parallel_write is not None:
+    gsd_writer = hoomd.write.GSD(trigger=hoomd.trigger.Periodic(write_period),
+      filename=filename, mode='wb', dynamic=['property','momentum'],
+      parallel_write=parallel_write)
+    sim.operations.writers.append(gsd_writer)
+  tps, elapsed = bench.time_run(sim, n_warmup, n_steps)
+  values = dict(TPS=round(tps, 2))
+  if parallel_write is not None:
+    gsd_writer.flush()
+    if device.communicator.rank == 0:
+      values['file_MB'] = round(os.path.getsize(filename)/1e6, 1)
+    sim.operations.writers.remove(gsd_writer)
+  bench.report(device, label, values)
@@ -0,0 +1,54 @@
+## benchmark: full precision vs. quantized GSD positions and velocities
+## quantized values are still 32-bit floats (readable by any GSD reader) with
+## zero low mantissa bits; the compressed size shows what a compressing file
+## system (or zstd/gzip of the finished file) saves
+## usage: python3 bench-gsd-quantize.py [L_X] [phi] [position_tolerance] [velocity_tolerance] [output_dir]
+
+
+######### MODULE LIBRARY
+# Use HOOMD-blue
+import hoomd
+import hoomd.md # molecular dynamics
+# Other
+import os
+import sys
+import zlib
+import dpd_bench_system as bench
+
+
+######### SIMULATION INPUTS
+L_X = float(sys.argv[1]) if len(sys.argv) > 1 else 30 # box size
+phi = float(sys.argv[2]) if len(sys.argv) > 2 else 0.2 # colloid volume fraction
+position_tolerance = float(sys.argv[3]) if len(sys.argv) > 3 else 1e-3 # max position error
+velocity_tolerance = float(sys.argv[4]) if len(sys.argv) > 4 else 1e-2 # max velocity error
+output_dir = sys.argv[5] if len(sys.argv) > 5 else '.' # where to write the trajectories
+write_period = 10 # steps between frames
+n_warmup = 500 # steps before timing (autotuning)
+n_steps = 2000 # timed steps
+buffer = 0.05 # nlist buffer (as in the sim-templates)
+
+
+######### BENCHMARK
+device = hoomd.device.CPU()
+snapshot = bench.make_snapshot(L_X, phi, device=device)
+## label, position tolerance, velocity tolerance
+modes = [("full precision", 0.0, 0.0),
+  ("quantized", position_tolerance, velocity_tolerance)]
+for label, pos_tol, vel_tol in modes:
+  nl = hoomd.md.nlist.Tree(buffer=buffer)
+  morse = bench.make_dpd_morse(nl)
+  sim = bench.make_simulation(snapshot, [morse], device=device)
+  filename = os.path.join(output_dir, 'bench-gsd-quantize-' + str(pos_tol) + '.gsd')
+  gsd_writer = hoomd.write.GSD(trigger=hoomd.trigger.Periodic(write_period),
+    filename=filename, mode='wb', dynamic=['property','momentum'],
+    position_tolerance=pos_tol, velocity_tolerance=vel_tol)
+  sim.operations.writers.append(gsd_writer)
+  tps, elapsed = bench.time_run(sim, n_warmup, n_steps)
+  gsd_writer.flush()
+  values = dict(TPS=round(tps, 2))
+  if device.communicator.rank == 0:
+    with open(filename, 'rb') as f:
+      data = f.read()
+    values['file_MB'] = round(len(data)/1e6, 1)
+    values['zlib_MB'] = round(len(zlib.compress(data, 1))/1e6, 1)
+  bench.report(device, label, values)
@@ -0,0 +1,58 @@
+## benchmark: particle count vs. cost-weighted load balancing
+## colloids are only kept in one half of the box (x < 0) to mimic a
+## phase-separated gel: balancing the particle count leaves the ranks holding
+## colloids (large cutoffs, contact and lubrication) with more work
+## weighting='time' balances the measured force compute time per rank,
+## weighting='type' balances a fixed cost weight per particle type
+## usage: mpirun -n 8 python3 bench-load-balance.py [L_X] [phi] [colloid_weight]
+
+
+######### MODULE LIBRARY
+# Use HOOMD-blue
+import hoomd
+import hoomd.md # molecular dynamics
+# Other
+import sys
+import dpd_bench_system as bench
+
+
+######### SIMULATION INPUTS
+L_X = float(sys.argv[1]) if len(sys.argv) > 1 else 40 # box size
+phi = float(sys.argv[2]) if len(sys.argv) > 2 else 0.2 # colloid volume fraction (before halving)
+colloid_weight = float(sys.argv[3]) if len(sys.argv) > 3 else 20 # cost of a colloid (type)
+n_warmup = 2000 # steps before timing (autotuning, balancing)
+n_steps = 1000 # timed steps
+balance_period = 100 # steps between balancing
+buffer = 0.05 # nlist buffer (as in the sim-templates)
+
+
+######### BENCHMARK
+device = hoomd.device.CPU()
+snapshot = bench.make_snapshot(L_X, phi, device=device)
+if snapshot.communicator.rank == 0:
+  ## turn the colloids in the upper half of the box into solvent particles
+  upper = (snapshot.particles.typeid == 1) & (snapshot.particles.position[:,0] > 0)
+  snapshot.particles.typeid[upper] = 0
+  snapshot.particles.mass[upper] = 1.0
+  snapshot.particles.diameter[upper] = 2.0*bench.R_S
+if device.communicator.num_ranks == 1:
+  print("note: a single rank has no domains to balance")
+## label, weighting (None: no load balancer)
+modes = [("no balancing", None),
+  ("weighting = particles", "particles"),
+  ("weighting = type", "type"),
+  ("weighting = time", "time")]
+for label, weighting in modes:
+  nl = hoomd.md.nlist.Tree(buffer=buffer)
+  morse = bench.make_dpd_morse(nl)
+  sim = bench.make_simulation(snapshot, [morse], device=device)
+  if weighting is not None:
+    balance = hoomd.tune.LoadBalancer(trigger=hoomd.trigger.Periodic(balance_period),
+      x=True, y=False, z=False, weighting=weighting)
+    balance.type_weights['A'] = 1.0
+    balance.type_weights['B'] = colloid_weight
+    sim.operations.tuners.append(balance)
+  tps, elapsed = bench.time_run(sim, n_warmup, n_steps)
+  values = dict(TPS=round(tps, 2),
+    x_splits=[round(f, 3) for f in sim.state.domain_decomposition_split_fractions[0]])
+  bench.report(device, label, values)
@@ -0,0 +1,79 @@
+## benchmark: cost of the colloid MSD of a DPD gel accumulated in situ with
+## hoomd.md.analyze.MSD (order-n multiple-tau correlator) vs. storing the
+## unwrapped colloid positions of every frame from snapshots and computing the
+## MSD over all pairs of frames after the run (as msd_calculation does)
+## reports TPS, the analysis time after the run, and the stored positions
+## usage: python3 bench-msd.py [L_X] [phi] [period]
+
+
+######### MODULE LIBRARY
+# Use HOOMD-blue
+import hoomd
+import hoomd.md # molecular dynamics
+# Maths
+import numpy as np
+# Other
+import sys
+import time
+import dpd_bench_system as bench
+
+
+######### SIMULATION INPUTS
+L_X = float(sys.argv[1]) if len(sys.argv) > 1 else 30 # box size
+phi = float(sys.argv[2]) if len(sys.argv) > 2 else 0.2 # colloid volume fraction
+period = int(sys.argv[3]) if len(sys.argv) > 3 else 10 # steps between frames
+n_warmup = 500 # steps before timing (autotuning)
+n_steps = 4000 # timed steps
+buffer = 0.05 # nlist buffer (as in the sim-templates)
+block_size = 8 # lags per level of the correlator
+n_levels = 8 # levels of the correlator
+
+
+######### BENCHMARK
+device = hoomd.device.CPU()
+snapshot = bench.make_snapshot(L_X, phi, device=device)
+
+class SnapshotFrames(hoomd.custom.Action):
+  """store the unwrapped colloid positions of every frame"""
+
+  def __init__(self):
+    self.frames = []
+
+  def act(self, timestep):
+    snap = self._state.get_snapshot()
+    if snap.communicator.rank == 0:
+      colloid = snap.particles.typeid == 1
+      L = snap.configuration.box[:3]
+      self.frames.append(snap.particles.position[colloid] + snap.particles.image[colloid] * L)
+
+  def msd(self):
+    """MSD over all pairs of frames, O(frames^2)"""
+    pos = np.array(self.frames)
+    return np.array([np.mean(np.sum((pos[lag:] - pos[:-lag])**2, axis=2))
+      for lag in range(1, len(pos))])
+
+for label in ["no MSD", "MSD multiple-tau", "snapshot every frame"]:
+  nl = hoomd.md.nlist.Tree(buffer=buffer)
+  morse = bench.make_dpd_morse(nl)
+  sim = bench.make_simulation(snapshot, [morse], device=device)
+  trigger = hoomd.trigger.Periodic(period)
+  if label == "snapshot every frame":
+    action = SnapshotFrames()
+    sim.operations.writers.append(hoomd.write.CustomWriter(action=action, trigger=trigger))
+  elif label != "no MSD":
+    msd = hoomd.md.analyze.MSD(trigger=trigger, block_size=block_size, n_levels=n_levels,
+      types=['B'])
+    sim.operations.writers.append(msd)
+  tps, elapsed = bench.time_run(sim, n_warmup, n_steps)
+  values = dict(TPS=round(tps, 2))
+  n_colloids = np.sum(snapshot.particles.typeid == 1) if snapshot.communicator.rank == 0 else 0
+  t_start = time.perf_counter()
+  if label == "snapshot every frame":
+    action.msd()
+    values['stored_positions'] = len(action.frames) * n_colloids
+  elif label != "no MSD":
+    msd.msd
+    levels_used = np.count_nonzero(~np.isnan(msd.lag_steps[::block_size - 1]))
+    values['stored_positions'] = levels_used * (block_size - 1) * n_colloids
+  values['post_run_s'] = round(time.perf_counter() - t_start, 3)
+  bench.report(device, label, values)
@@ -0,0 +1,39 @@
+## benchmark: compressed (16-bit delta encoded) vs. 32-bit neighbor list storage
+## for a dense DPD system (rho = 3, r_c = 1)
+## reports the pair-loop throughput (TPS) and the memory used to store the neighbors
+## usage: python3 bench-nlist-compressed.py [L_X] [phi]
+##        mpirun -n 8 python3 bench-nlist-compressed.py 40 0.2
+
+
+######### MODULE LIBRARY
+# Use HOOMD-blue
+import hoomd
+import hoomd.md # molecular dynamics
+# Other
+import sys
+import dpd_bench_system as bench
+
+
+######### SIMULATION INPUTS
+L_X = float(sys.argv[1]) if len(sys.argv) > 1 else 30 # box size
+phi = float(sys.argv[2]) if len(sys.argv) > 2 else 0.0 # colloid volume fraction
+n_warmup = 200 # steps before timing (autotuning, sorting)
+n_steps = 1000 # timed steps
+buffer = 0.05 # nlist buffer (as in the sim-templates)
+
+
+######### BENCHMARK
+device = hoomd.device.CPU()
+snapshot = bench.make_snapshot(L_X, phi, device=device)
+for nlist_cls in (hoomd.md.nlist.Tree, hoomd.md.nlist.Cell):
+  for compressed in (False, True):
+    nl = nlist_cls(buffer=buffer, compressed=compressed)
+    morse = bench.make_dpd_morse(nl)
+    sim = bench.make_simulation(snapshot, [morse], device=device)
+    tps, elapsed = bench.time_run(sim, n_warmup, n_steps)
+    values = dict(TPS=round(tps, 2), builds=nl.num_builds)
+    if compressed:
+      # rank-local neighbor storage of the last build
+      values['nlist_MB_32bit'] = round(nl.nlist_bytes / 1e6, 3)
+      values['nlist_MB_compressed'] = round(nl.compressed_nlist_bytes / 1e6, 3)
+    bench.report(device, nlist_cls.__name__ + " compressed=" + str(compressed), values)
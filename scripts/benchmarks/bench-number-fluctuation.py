@@ -0,0 +1,77 @@
+## benchmark: cost of the colloid number fluctuations over many window sizes of
+## a DPD gel computed in situ with hoomd.md.analyze.NumberFluctuation (summed-area
+## table of a count grid, sliding periodic windows) vs. taking a snapshot and a
+## new histogram of the colloids per window size (as ndfluc_py in the gelation
+## analysis scripts) for every frame
+## reports TPS and the analysis cost per frame (milliseconds) relative to none
+## usage: python3 bench-number-fluctuation.py [L_X] [phi] [period]
+
+
+######### MODULE LIBRARY
+# Use HOOMD-blue
+import hoomd
+import hoomd.md # molecular dynamics
+# Maths
+import numpy as np
+# Other
+import sys
+import dpd_bench_system as bench
+
+
+######### SIMULATION INPUTS
+L_X = float(sys.argv[1]) if len(sys.argv) > 1 else 30 # box size
+phi = float(sys.argv[2]) if len(sys.argv) > 2 else 0.2 # colloid volume fraction
+period = int(sys.argv[3]) if len(sys.argv) > 3 else 100 # steps between frames
+n_warmup = 500 # steps before timing (autotuning)
+n_steps = 2000 # timed steps
+buffer = 0.05 # nlist buffer (as in the sim-templates)
+grid_spacing = 0.5 # cell width of the count grid
+window_widths = list(range(1, int(L_X // 2) + 1)) # window widths (bin sizes)
+
+
+######### BENCHMARK
+device = hoomd.device.CPU()
+snapshot = bench.make_snapshot(L_X, phi, device=device)
+
+class SnapshotFluctuation(hoomd.custom.Action):
+  """variance of the colloid counts in the tiled windows of each width from a snapshot"""
+
+  def __init__(self):
+    self.variance = []
+
+  def act(self, timestep):
+    snap = self._state.get_snapshot()
+    if snap.communicator.rank == 0:
+      pos = snap.particles.position[snap.particles.typeid == 1]
+      L = snap.configuration.box[:3]
+      variance = []
+      for width in window_widths:
+        n_layers = np.maximum(np.rint(L / width).astype(int), 1)
+        hist, _ = np.histogramdd(pos + 0.5 * L, bins=n_layers,
+          range=[(0, L[0]), (0, L[1]), (0, L[2])])
+        variance.append(np.mean(hist**2) - np.mean(hist)**2)
+      self.variance.append(variance)
+
+tps_none = None
+for label in ["no fluctuation", "NumberFluctuation", "snapshot histograms"]:
+  nl = hoomd.md.nlist.Tree(buffer=buffer)
+  morse = bench.make_dpd_morse(nl)
+  sim = bench.make_simulation(snapshot, [morse], device=device)
+  trigger = hoomd.trigger.Periodic(period)
+  if label == "snapshot histograms":
+    sim.operations.writers.append(hoomd.write.CustomWriter(action=SnapshotFluctuation(),
+      trigger=trigger))
+  elif label != "no fluctuation":
+    ndf = hoomd.md.analyze.NumberFluctuation(trigger=trigger, grid_spacing=grid_spacing,
+      window_widths=window_widths, types=['B'])
+    sim.operations.writers.append(ndf)
+  tps, elapsed = bench.time_run(sim, n_warmup, n_steps)
+  values = dict(TPS=round(tps, 2))
+  if tps_none is None:
+    tps_none = tps
+  else:
+    values['ms_per_frame'] = round((1/tps - 1/tps_none) * period * 1e3, 2)
+    if label == "NumberFluctuation":
+      # sigma^2 / <N> of the largest window
+      values['ndf_largest'] = round(float(ndf.number_fluctuation[-1]), 4)
+  bench.report(device, label, values)
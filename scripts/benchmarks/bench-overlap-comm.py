@@ -0,0 +1,37 @@
+## benchmark: overlapping the ghost update with the interior DPDMorse pair loop
+## with overlap_comm, the pairs of particles without ghost neighbors are
+## computed while each direction's ghost positions/velocities are in flight;
+## only meaningful with several MPI ranks (a single rank has no ghost update)
+## usage: mpirun -n 8 python3 bench-overlap-comm.py [L_X] [phi]
+
+
+######### MODULE LIBRARY
+# Use HOOMD-blue
+import hoomd
+import hoomd.md # molecular dynamics
+# Other
+import sys
+import dpd_bench_system as bench
+
+
+######### SIMULATION INPUTS
+L_X = float(sys.argv[1]) if len(sys.argv) > 1 else 40 # box size
+phi = float(sys.argv[2]) if len(sys.argv) > 2 else 0.2 # colloid volume fraction
+n_warmup = 200 # steps before timing (autotuning, sorting)
+n_steps = 1000 # timed steps
+buffer = 0.05 # nlist buffer (as in the sim-templates)
+
+
+######### BENCHMARK
+device = hoomd.device.CPU()
+snapshot = bench.make_snapshot(L_X, phi, device=device)
+if device.communicator.num_ranks == 1:
+  print("note: a single rank has no ghost update to overlap with")
+for label, overlap_comm in [("blocking ghost update", False), ("overlap_comm", True)]:
+  nl = hoomd.md.nlist.Tree(buffer=buffer)
+  morse = bench.make_dpd_morse(nl, overlap_comm=overlap_comm)
+  sim = bench.make_simulation(snapshot, [morse], device=device)
+  tps, elapsed = bench.time_run(sim, n_warmup, n_steps)
+  ## the overlap is only used on steps without a neighbor list build
+  values = dict(TPS=round(tps, 2), builds=nl.num_builds)
+  bench.report(device, label, values)
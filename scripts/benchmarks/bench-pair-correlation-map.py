@@ -0,0 +1,103 @@
+## benchmark: cost of the colloid pair correlation maps (xy, xz, yz slices) of a
+## sheared DPD gel accumulated in situ with hoomd.md.analyze.PairCorrelationMap
+## (on the DPDMorse neighbor list, steady shear and phase-binned oscillatory
+## shear) vs. taking a snapshot and an O(N^2) loop over the colloids (as
+## pcf_calc in the shear analysis scripts) for every frame
+## reports TPS and the analysis cost per frame (milliseconds) relative to none
+## usage: python3 bench-pair-correlation-map.py [L_X] [phi] [period]
+
+
+######### MODULE LIBRARY
+# Use HOOMD-blue
+import hoomd
+import hoomd.md # molecular dynamics
+# Maths
+import numpy as np
+# Other
+import sys
+import dpd_bench_system as bench
+
+
+######### SIMULATION INPUTS
+L_X = float(sys.argv[1]) if len(sys.argv) > 1 else 30 # box size
+phi = float(sys.argv[2]) if len(sys.argv) > 2 else 0.2 # colloid volume fraction
+period = int(sys.argv[3]) if len(sys.argv) > 3 else 10 # steps between frames
+n_warmup = 500 # steps before timing (autotuning)
+n_steps = 2000 # timed steps
+buffer = 0.05 # nlist buffer (as in the sim-templates)
+shear_rate = 0.1 # steady shear (as in the shear sim-templates)
+osc_period = 1000 # oscillation period in steps
+phase_bins = 8 # phase bins per oscillation
+r_max = 3.0 # half width of the maps (as dims_max in the shear analysis scripts)
+bins = 60 # bins along each axis of a map
+slice_width = 0.5 # half thickness of the slices
+
+
+######### BENCHMARK
+device = hoomd.device.CPU()
+snapshot = bench.make_snapshot(L_X, phi, device=device)
+bin_size = 2 * r_max / bins
+
+class SnapshotMap(hoomd.custom.Action):
+  """xy, xz, and yz pair counts of the colloids from a snapshot with an O(N^2) loop in the tilted box"""
+
+  def __init__(self):
+    self.counts = np.zeros((3, bins, bins))
+
+  def act(self, timestep):
+    snap = self._state.get_snapshot()
+    if snap.communicator.rank == 0:
+      pos = snap.particles.position[snap.particles.typeid == 1]
+      L = snap.configuration.box[:3]
+      xy = snap.configuration.box[3]
+      for i in range(len(pos)):
+        dr = np.delete(pos, i, axis=0) - pos[i]
+        dr[:, 2] -= L[2] * np.round(dr[:, 2] / L[2])
+        img = L[1] * np.round(dr[:, 1] / L[1])
+        dr[:, 1] -= img
+        dr[:, 0] -= img * xy
+        dr[:, 0] -= L[0] * np.round(dr[:, 0] / L[0])
+        for plane, (s, u, v) in enumerate([(2, 0, 1), (1, 0, 2), (0, 1, 2)]):
+          sel = (np.abs(dr[:, s]) <= slice_width) & (np.abs(dr[:, u]) < r_max) \
+            & (np.abs(dr[:, v]) < r_max)
+          a = ((dr[sel, u] + r_max) / bin_size).astype(int)
+          b = ((dr[sel, v] + r_max) / bin_size).astype(int)
+          np.add.at(self.counts[plane], (a, b), 1)
+
+tps_none = None
+for label in ["no map", "PairCorrelationMap force nlist",
+  "PairCorrelationMap oscillatory phase bins", "snapshot O(N^2)"]:
+  nl = hoomd.md.nlist.Tree(buffer=buffer)
+  morse = bench.make_dpd_morse(nl)
+  sim = bench.make_simulation(snapshot, [morse], device=device)
+  if label == "PairCorrelationMap oscillatory phase bins":
+    vinf = hoomd.variant.Sinusoid(value=shear_rate * L_X, t_start=sim.timestep,
+      omega=2 * np.pi / osc_period)
+  else:
+    vinf = hoomd.variant.Constant(shear_rate * L_X)
+  sim.operations.integrator.vinf = vinf
+  sim.operations.updaters.append(hoomd.update.BoxShear(trigger=1, vinf=vinf,
+    deltaT=bench.dt_Integration, flip=True))
+  trigger = hoomd.trigger.Periodic(period)
+  if label == "snapshot O(N^2)":
+    sim.operations.writers.append(hoomd.write.CustomWriter(action=SnapshotMap(),
+      trigger=trigger))
+  elif label == "PairCorrelationMap oscillatory phase bins":
+    pcf = hoomd.md.analyze.PairCorrelationMap(trigger=trigger, nlist=nl, r_max=r_max,
+      bins=bins, slice_width=slice_width, types=['B'], phase_bins=phase_bins,
+      period=osc_period, t_start=sim.timestep)
+    sim.operations.writers.append(pcf)
+  elif label != "no map":
+    pcf = hoomd.md.analyze.PairCorrelationMap(trigger=trigger, nlist=nl, r_max=r_max,
+      bins=bins, slice_width=slice_width, types=['B'])
+    sim.operations.writers.append(pcf)
+  tps, elapsed = bench.time_run(sim, n_warmup, n_steps)
+  values = dict(TPS=round(tps, 2))
+  if tps_none is None:
+    tps_none = tps
+  else:
+    values['ms_per_frame'] = round((1/tps - 1/tps_none) * period * 1e3, 2)
+    if label != "snapshot O(N^2)":
+      # peak of the flow-gradient map (the contact shell)
+      values['max_g_xy'] = round(float(np.max(pcf.pair_correlation[0])), 3)
+  bench.report(device, label, values)
@@ -0,0 +1,98 @@
+## benchmark: cost of the colloid pore size distributions of a DPD gel sampled
+## in situ with hoomd.md.analyze.PoreSize (AABB tree and pattern search) vs.
+## taking a snapshot, the distance to every colloid surface for each probe, and
+## a constrained optimizer for the Gubbins sphere of each probe (scipy SLSQP in
+## place of solvopt in pore_size_calc, skipped when scipy is not installed)
+## reports TPS, the analysis cost per frame (milliseconds) relative to none,
+## and the mean pore diameters
+## usage: python3 bench-pore-size.py [L_X] [phi] [period] [n_probes]
+
+
+######### MODULE LIBRARY
+# Use HOOMD-blue
+import hoomd
+import hoomd.md # molecular dynamics
+# Maths
+import numpy as np
+# Other
+import sys
+import dpd_bench_system as bench
+try:
+  from scipy.optimize import minimize
+except ImportError:
+  minimize = None
+
+
+######### SIMULATION INPUTS
+L_X = float(sys.argv[1]) if len(sys.argv) > 1 else 30 # box size
+phi = float(sys.argv[2]) if len(sys.argv) > 2 else 0.2 # colloid volume fraction
+period = int(sys.argv[3]) if len(sys.argv) > 3 else 500 # steps between frames
+n_probes = int(sys.argv[4]) if len(sys.argv) > 4 else 1000 # probes per frame
+n_warmup = 500 # steps before timing (autotuning)
+n_steps = 2000 # timed steps
+buffer = 0.05 # nlist buffer (as in the sim-templates)
+d_max = 20.0 # largest pore diameter in the histograms
+
+
+######### BENCHMARK
+device = hoomd.device.CPU()
+snapshot = bench.make_snapshot(L_X, phi, device=device)
+
+class SnapshotPoreSize(hoomd.custom.Action):
+  """Torquato and Gubbins pore diameters of random probes from a snapshot"""
+
+  def __init__(self):
+    self.rng = np.random.default_rng(1)
+    self.torquato = []
+    self.gubbins = []
+
+  def act(self, timestep):
+    snap = self._state.get_snapshot()
+    if snap.communicator.rank == 0:
+      colloid = snap.particles.typeid == 1
+      pos = snap.particles.position[colloid]
+      R = snap.particles.diameter[colloid] / 2
+      L = snap.configuration.box[:3]
+      def delta(c):
+        dr = pos - c
+        dr -= L * np.round(dr / L)
+        return np.min(np.linalg.norm(dr, axis=1) - R)
+      for k in range(n_probes):
+        d_p = -1
+        while d_p <= 0:
+          p = (self.rng.random(3) - 0.5) * L
+          d_p = delta(p)
+        self.torquato.append(2 * d_p)
+        result = minimize(lambda c: -delta(c), p, method='SLSQP',
+          constraints=[dict(type='ineq', fun=lambda c: delta(c) - np.linalg.norm(c - p))])
+        self.gubbins.append(2 * max(-result.fun, d_p))
+
+labels = ["no PoreSize", "PoreSize"]
+if minimize is not None:
+  labels.append("snapshot SLSQP")
+tps_none = None
+for label in labels:
+  nl = hoomd.md.nlist.Tree(buffer=buffer)
+  morse = bench.make_dpd_morse(nl)
+  sim = bench.make_simulation(snapshot, [morse], device=device)
+  trigger = hoomd.trigger.Periodic(period)
+  if label == "snapshot SLSQP":
+    action = SnapshotPoreSize()
+    sim.operations.writers.append(hoomd.write.CustomWriter(action=action, trigger=trigger))
+  elif label != "no PoreSize":
+    pores = hoomd.md.analyze.PoreSize(trigger=trigger, n_probes=n_probes, d_max=d_max,
+      types=['B'])
+    sim.operations.writers.append(pores)
+  tps, elapsed = bench.time_run(sim, n_warmup, n_steps)
+  values = dict(TPS=round(tps, 2))
+  if tps_none is None:
+    tps_none = tps
+  else:
+    values['ms_per_frame'] = round((1/tps - 1/tps_none) * period * 1e3, 2)
+    if label == "PoreSize":
+      values['d_torquato'] = round(pores.mean_diameter_torquato, 3)
+      values['d_gubbins'] = round(pores.mean_diameter_gubbins, 3)
+    else:
+      values['d_torquato'] = round(float(np.mean(action.torquato)), 3)
+      values['d_gubbins'] = round(float(np.mean(action.gubbins)), 3)
+  bench.report(device, label, values)
@@ -0,0 +1,72 @@
+## benchmark: cost of the colloid-colloid g(h) of a DPD gel accumulated in situ
+## with hoomd.md.analyze.RDF (own cell list, and the neighbor list of the
+## DPDMorse force) vs. taking a snapshot and an O(N^2) loop over the colloids
+## (as gofr_calc does for every stored frame)
+## reports TPS and the analysis cost per frame (milliseconds) relative to none
+## usage: python3 bench-rdf.py [L_X] [phi] [period]
+
+
+######### MODULE LIBRARY
+# Use HOOMD-blue
+import hoomd
+import hoomd.md # molecular dynamics
+# Maths
+import numpy as np
+# Other
+import sys
+import dpd_bench_system as bench
+
+
+######### SIMULATION INPUTS
+L_X = float(sys.argv[1]) if len(sys.argv) > 1 else 30 # box size
+phi = float(sys.argv[2]) if len(sys.argv) > 2 else 0.2 # colloid volume fraction
+period = int(sys.argv[3]) if len(sys.argv) > 3 else 10 # steps between frames
+n_warmup = 500 # steps before timing (autotuning)
+n_steps = 2000 # timed steps
+buffer = 0.05 # nlist buffer (as in the sim-templates)
+h_max = 1.0 # largest surface-surface distance binned (colloid diameter is 2)
+bins = 50 # number of bins
+
+
+######### BENCHMARK
+device = hoomd.device.CPU()
+snapshot = bench.make_snapshot(L_X, phi, device=device)
+
+class SnapshotRDF(hoomd.custom.Action):
+  """g(h) of the colloids from a snapshot with an O(N^2) loop"""
+
+  def __init__(self):
+    self.hist = np.zeros(bins)
+
+  def act(self, timestep):
+    snap = self._state.get_snapshot()
+    if snap.communicator.rank == 0:
+      colloid = snap.particles.typeid == 1
+      pos = snap.particles.position[colloid]
+      d = snap.particles.diameter[colloid]
+      L = snap.configuration.box[:3]
+      for i in range(len(pos) - 1):
+        dr = pos[i+1:] - pos[i]
+        dr -= L * np.round(dr / L)
+        h = np.linalg.norm(dr, axis=1) - 0.5*(d[i] + d[i+1:])
+        self.hist += np.histogram(h, bins=bins, range=(-0.5*h_max, h_max))[0]
+
+tps_none = None
+for label in ["no RDF", "RDF cell list", "RDF force nlist", "snapshot O(N^2)"]:
+  nl = hoomd.md.nlist.Tree(buffer=buffer)
+  morse = bench.make_dpd_morse(nl)
+  sim = bench.make_simulation(snapshot, [morse], device=device)
+  trigger = hoomd.trigger.Periodic(period)
+  if label == "snapshot O(N^2)":
+    sim.operations.writers.append(hoomd.write.CustomWriter(action=SnapshotRDF(), trigger=trigger))
+  elif label != "no RDF":
+    rdf = hoomd.md.analyze.RDF(trigger=trigger, bins=bins, r_max=h_max, r_min=-0.5*h_max,
+      surface=True, types=['B'], nlist=nl if label == "RDF force nlist" else None)
+    sim.operations.writers.append(rdf)
+  tps, elapsed = bench.time_run(sim, n_warmup, n_steps)
+  values = dict(TPS=round(tps, 2))
+  if tps_none is None:
+    tps_none = tps
+  else:
+    values['ms_per_frame'] = round((1/tps - 1/tps_none) * period * 1e3, 2)
+  bench.report(device, label, values)
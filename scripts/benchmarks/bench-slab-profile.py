@@ -0,0 +1,86 @@
+## benchmark: cost of the velocity, density, and temperature profiles of a
+## sheared DPD gel accumulated in situ with hoomd.md.analyze.SlabProfile vs.
+## taking a snapshot and binning the velocities in y (as vel_profile and
+## corrected_temperature in the shear analysis scripts) for every frame
+## reports TPS and the analysis cost per frame (milliseconds) relative to none
+## usage: python3 bench-slab-profile.py [L_X] [phi] [period] [bins]
+
+
+######### MODULE LIBRARY
+# Use HOOMD-blue
+import hoomd
+import hoomd.md # molecular dynamics
+# Maths
+import numpy as np
+# Other
+import sys
+import dpd_bench_system as bench
+
+
+######### SIMULATION INPUTS
+L_X = float(sys.argv[1]) if len(sys.argv) > 1 else 30 # box size
+phi = float(sys.argv[2]) if len(sys.argv) > 2 else 0.2 # colloid volume fraction
+period = int(sys.argv[3]) if len(sys.argv) > 3 else 10 # steps between frames
+bins = int(sys.argv[4]) if len(sys.argv) > 4 else 20 # number of y layers
+n_warmup = 500 # steps before timing (autotuning)
+n_steps = 2000 # timed steps
+buffer = 0.05 # nlist buffer (as in the sim-templates)
+shear_rate = 0.1 # steady shear (as in the shear sim-templates)
+
+
+######### BENCHMARK
+device = hoomd.device.CPU()
+snapshot = bench.make_snapshot(L_X, phi, device=device)
+vinf = hoomd.variant.Constant(shear_rate * L_X)
+
+class SnapshotProfile(hoomd.custom.Action):
+  """per type velocity, density, and peculiar kT profiles from a snapshot"""
+
+  def __init__(self):
+    self.n = np.zeros((2, bins))
+    self.mv = np.zeros((2, bins, 3))
+    self.peculiar = np.zeros((2, bins))
+
+  def act(self, timestep):
+    snap = self._state.get_snapshot()
+    if snap.communicator.rank == 0:
+      L_Y = snap.configuration.box[1]
+      k = np.clip(((snap.particles.position[:, 1] / L_Y + 0.5) * bins).astype(int), 0, bins - 1)
+      m = snap.particles.mass
+      v = snap.particles.velocity
+      for t in range(2):
+        sel = snap.particles.typeid == t
+        n = np.bincount(k[sel], minlength=bins)
+        M = np.bincount(k[sel], weights=m[sel], minlength=bins)
+        P = np.stack([np.bincount(k[sel], weights=m[sel]*v[sel, d], minlength=bins)
+          for d in range(3)], axis=-1)
+        K = np.bincount(k[sel], weights=m[sel]*np.sum(v[sel]**2, axis=1), minlength=bins)
+        u = P / np.maximum(M, 1e-12)[:, None]
+        self.n[t] += n
+        self.mv[t] += P
+        self.peculiar[t] += K - np.sum(P * u, axis=1)
+
+tps_none = None
+for label in ["no profile", "SlabProfile", "snapshot binning"]:
+  nl = hoomd.md.nlist.Tree(buffer=buffer)
+  morse = bench.make_dpd_morse(nl)
+  sim = bench.make_simulation(snapshot, [morse], device=device)
+  sim.operations.integrator.vinf = vinf
+  sim.operations.updaters.append(hoomd.update.BoxShear(trigger=1, vinf=vinf,
+    deltaT=bench.dt_Integration, flip=True))
+  trigger = hoomd.trigger.Periodic(period)
+  if label == "snapshot binning":
+    sim.operations.writers.append(hoomd.write.CustomWriter(action=SnapshotProfile(),
+      trigger=trigger))
+  elif label != "no profile":
+    profile = hoomd.md.analyze.SlabProfile(trigger=trigger, bins=bins)
+    sim.operations.writers.append(profile)
+  tps, elapsed = bench.time_run(sim, n_warmup, n_steps)
+  values = dict(TPS=round(tps, 2))
+  if tps_none is None:
+    tps_none = tps
+  else:
+    values['ms_per_frame'] = round((1/tps - 1/tps_none) * period * 1e3, 2)
+    if label == "SlabProfile":
+      values['solvent_kT'] = round(float(np.nanmean(profile.temperature[0])), 4)
+  bench.report(device, label, values)
@@ -0,0 +1,43 @@
+## benchmark: particle sorting options (hoomd.tune.ParticleSorter) for a
+## colloid + solvent DPD system
+## compares the default Hilbert sort every 200 steps, type-major ordering
+## (colloids first, then solvent), and adaptive sorting (checks every 100 steps,
+## sorts when the measured slow down pays for a sort)
+## usage: python3 bench-sorter.py [L_X] [phi]
+##        mpirun -n 8 python3 bench-sorter.py 40 0.2
+
+
+######### MODULE LIBRARY
+# Use HOOMD-blue
+import hoomd
+import hoomd.md # molecular dynamics
+# Other
+import sys
+import dpd_bench_system as bench
+
+
+######### SIMULATION INPUTS
+L_X = float(sys.argv[1]) if len(sys.argv) > 1 else 30 # box size
+phi = float(sys.argv[2]) if len(sys.argv) > 2 else 0.2 # colloid volume fraction
+n_warmup = 200 # steps before timing (autotuning, first sort)
+n_steps = 5000 # timed steps (long enough for the particles to unsort)
+buffer = 0.05 # nlist buffer (as in the sim-templates)
+
+
+######### BENCHMARK
+device = hoomd.device.CPU()
+snapshot = bench.make_snapshot(L_X, phi, device=device)
+## label, sorter keyword arguments
+modes = [("default (Periodic(200))", dict(trigger=200)),
+  ("type-major", dict(trigger=200, type_major=True)),
+  ("adaptive", dict(trigger=100, adaptive=True)),
+  ("adaptive + type-major", dict(trigger=100, adaptive=True, type_major=True))]
+for label, kwargs in modes:
+  nl = hoomd.md.nlist.Tree(buffer=buffer)
+  morse = bench.make_dpd_morse(nl)
+  sim = bench.make_simulation(snapshot, [morse], device=device)
+  sim.operations.tuners.clear()
+  sorter = hoomd.tune.ParticleSorter(**kwargs)
+  sim.operations.tuners.append(sorter)
+  tps, elapsed = bench.time_run(sim, n_warmup, n_steps)
+  bench.report(device, label, dict(TPS=round(tps, 2), sorts=sorter.num_sorts))
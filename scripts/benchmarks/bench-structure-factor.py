@@ -0,0 +1,75 @@
+## benchmark: cost of the colloid S(q) of a DPD gel accumulated in situ with
+## hoomd.md.analyze.StructureFactor (density mesh and FFT) vs. taking a
+## snapshot and summing exp(-i q.r) over the colloids for every wave vector
+## reports TPS and the analysis cost per frame (milliseconds) relative to none
+## usage: python3 bench-structure-factor.py [L_X] [phi] [period] [mesh]
+
+
+######### MODULE LIBRARY
+# Use HOOMD-blue
+import hoomd
+import hoomd.md # molecular dynamics
+# Maths
+import numpy as np
+# Other
+import sys
+import dpd_bench_system as bench
+
+
+######### SIMULATION INPUTS
+L_X = float(sys.argv[1]) if len(sys.argv) > 1 else 30 # box size
+phi = float(sys.argv[2]) if len(sys.argv) > 2 else 0.2 # colloid volume fraction
+period = int(sys.argv[3]) if len(sys.argv) > 3 else 10 # steps between frames
+mesh = int(sys.argv[4]) if len(sys.argv) > 4 else 64 # mesh points per direction
+n_warmup = 500 # steps before timing (autotuning)
+n_steps = 2000 # timed steps
+buffer = 0.05 # nlist buffer (as in the sim-templates)
+q_max = 0.5 * np.pi * mesh / L_X # half the Nyquist wave number
+bins = 40 # number of bins
+
+
+######### BENCHMARK
+device = hoomd.device.CPU()
+snapshot = bench.make_snapshot(L_X, phi, device=device)
+
+class SnapshotSq(hoomd.custom.Action):
+  """S(q) of the colloids from a snapshot, summed directly over the wave vectors"""
+
+  def __init__(self):
+    self.sum_S = np.zeros(bins)
+
+  def act(self, timestep):
+    snap = self._state.get_snapshot()
+    if snap.communicator.rank == 0:
+      pos = snap.particles.position[snap.particles.typeid == 1]
+      L = snap.configuration.box[:3]
+      n_max = int(q_max * L[0] / (2*np.pi))
+      n = np.arange(-n_max, n_max + 1)
+      q = 2*np.pi * np.stack(np.meshgrid(n, n, n), axis=-1).reshape(-1, 3) / L
+      q_len = np.linalg.norm(q, axis=1)
+      keep = (q_len > 0) & (q_len < q_max)
+      q, b = q[keep], (q_len[keep] / (q_max / bins)).astype(int)
+      for q_chunk, b_chunk in zip(np.array_split(q, max(1, len(q) // 256)),
+                                  np.array_split(b, max(1, len(q) // 256))):
+        S = np.abs(np.exp(-1j * pos @ q_chunk.T).sum(axis=0))**2 / len(pos)
+        np.add.at(self.sum_S, b_chunk, S)
+
+tps_none = None
+for label in ["no S(q)", "S(q) mesh FFT", "snapshot direct sum"]:
+  nl = hoomd.md.nlist.Tree(buffer=buffer)
+  morse = bench.make_dpd_morse(nl)
+  sim = bench.make_simulation(snapshot, [morse], device=device)
+  trigger = hoomd.trigger.Periodic(period)
+  if label == "snapshot direct sum":
+    sim.operations.writers.append(hoomd.write.CustomWriter(action=SnapshotSq(), trigger=trigger))
+  elif label != "no S(q)":
+    sq = hoomd.md.analyze.StructureFactor(trigger=trigger, mesh=mesh, bins=bins, q_max=q_max,
+      types=['B'])
+    sim.operations.writers.append(sq)
+  tps, elapsed = bench.time_run(sim, n_warmup, n_steps)
+  values = dict(TPS=round(tps, 2))
+  if tps_none is None:
+    tps_none = tps
+  else:
+    values['ms_per_frame'] = round((1/tps - 1/tps_none) * period * 1e3, 2)
+  bench.report(device, label, values)
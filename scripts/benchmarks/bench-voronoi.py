@@ -0,0 +1,81 @@
+## benchmark: cost of the colloid radical Voronoi volumes of a DPD gel computed
+## in situ with hoomd.md.analyze.Voronoi vs. taking a snapshot and passing the
+## colloids through pyvoro (as sim-voronoi in the gelation analysis scripts,
+## skipped when pyvoro is not installed) for every frame
+## reports TPS, the analysis cost per frame (milliseconds) relative to none,
+## and the volume statistics of the last frame
+## usage: python3 bench-voronoi.py [L_X] [phi] [period] [r_max]
+
+
+######### MODULE LIBRARY
+# Use HOOMD-blue
+import hoomd
+import hoomd.md # molecular dynamics
+# Maths
+import numpy as np
+# Other
+import sys
+import dpd_bench_system as bench
+try:
+  import pyvoro
+except ImportError:
+  pyvoro = None
+
+
+######### SIMULATION INPUTS
+L_X = float(sys.argv[1]) if len(sys.argv) > 1 else 30 # box size
+phi = float(sys.argv[2]) if len(sys.argv) > 2 else 0.2 # colloid volume fraction
+period = int(sys.argv[3]) if len(sys.argv) > 3 else 100 # steps between frames
+r_max = float(sys.argv[4]) if len(sys.argv) > 4 else 8.0 # neighbor search range
+n_warmup = 500 # steps before timing (autotuning)
+n_steps = 2000 # timed steps
+buffer = 0.05 # nlist buffer (as in the sim-templates)
+Lbuffer = 0.1 # pyvoro container padding (as in sim-voronoi)
+
+
+######### BENCHMARK
+device = hoomd.device.CPU()
+snapshot = bench.make_snapshot(L_X, phi, device=device)
+
+class SnapshotVoronoi(hoomd.custom.Action):
+  """colloid radical Voronoi volumes from a snapshot with pyvoro"""
+
+  def __init__(self):
+    self.volumes = None
+
+  def act(self, timestep):
+    snap = self._state.get_snapshot()
+    if snap.communicator.rank == 0:
+      L = snap.configuration.box[:3]
+      colloids = snap.particles.typeid == 1
+      cells = pyvoro.compute_voronoi(snap.particles.position[colloids],
+        [[-l/2 - Lbuffer, l/2 + Lbuffer] for l in L], 2.0,
+        radii=snap.particles.diameter[colloids] / 2)
+      self.volumes = np.array([cell['volume'] for cell in cells])
+
+labels = ["no Voronoi", "Voronoi"]
+if pyvoro is not None:
+  labels.append("snapshot pyvoro")
+tps_none = None
+for label in labels:
+  nl = hoomd.md.nlist.Tree(buffer=buffer)
+  morse = bench.make_dpd_morse(nl)
+  sim = bench.make_simulation(snapshot, [morse], device=device)
+  trigger = hoomd.trigger.Periodic(period)
+  if label == "snapshot pyvoro":
+    sim.operations.writers.append(hoomd.write.CustomWriter(action=SnapshotVoronoi(),
+      trigger=trigger))
+  elif label != "no Voronoi":
+    voronoi = hoomd.md.analyze.Voronoi(trigger=trigger, r_max=r_max, types=['B'])
+    sim.operations.writers.append(voronoi)
+  tps, elapsed = bench.time_run(sim, n_warmup, n_steps)
+  values = dict(TPS=round(tps, 2))
+  if tps_none is None:
+    tps_none = tps
+  else:
+    values['ms_per_frame'] = round((1/tps - 1/tps_none) * period * 1e3, 2)
+    if label == "Voronoi":
+      values['volume_mean'] = round(voronoi.volume_mean, 4)
+      values['volume_skewness'] = round(voronoi.volume_skewness, 4)
+      values['n_incomplete'] = voronoi.n_incomplete
+  bench.report(device, label, values)
@@ -0,0 +1,116 @@
+## shared setup for the performance benchmarks in this folder
+## builds an in-memory DPD system with 1 solvent type (A) and
+## 1 colloid type (B) that matches the DPD sim-templates
+## (no GSD files are read or written)
+
+
+######### MODULE LIBRARY
+# Use HOOMD-blue
+import hoomd
+import hoomd.md # molecular dynamics
+# Maths
+import numpy as np
+import math
+# Other
+import time # wall-clock timing
+
+
+######### SIMULATION INPUTS (defaults, can be overridden by each benchmark)
+rho = 3 # number density (per unit volume)
+KT = 0.1 # system temperature
+D0 = 12.0 * KT # attraction strength
+kappa = 30 # range of attraction
+eta0 = 0.3 # background viscosity
+gamma = 4.5 # DPD controlling parameter for viscous resistance (dissipative force)
+r_c = 1.0 # cut-off radius parameter
+r0 = 0.0 # minimum inter-particle distance
+f_contact = 10000.0 * KT / r_c # colloid-colloid hard-sphere interactions
+R_S = 0.5 # solvent particle radius
+R_C1 = 1 # colloid particle radius
+dt_Integration = 0.001 # DPD timestep
+
+
+def make_snapshot(L_X, phi=0.0, seed_value=42, device=None):
+  """Create a cubic DPD snapshot of side L_X at volume fraction phi
+
+  Colloids are placed on a cubic lattice (so they do not overlap) and
+  solvents are placed at random
+  """
+  np.random.seed(seed_value)
+  V_total = L_X**3
+  V_C1 = (4./3.) * math.pi * R_C1 ** 3
+  N_C1 = int(round(phi * V_total / V_C1))
+  N_Solvents = int(math.floor(rho * (1 - phi) * V_total))
+  N_total = N_C1 + N_Solvents
+
+  communicator = device.communicator if device is not None else None
+  snapshot = hoomd.Snapshot(communicator)
+  if snapshot.communicator.rank == 0:
+    snapshot.configuration.box = [L_X, L_X, L_X, 0, 0, 0]
+    snapshot.particles.N = N_total
+    snapshot.particles.types = ['A','B']
+    typeid = np.zeros(N_total, dtype=np.uint32)
+    typeid[:N_C1] = 1
+    snapshot.particles.typeid[:] = typeid
+    mass = np.ones(N_total)
+    mass[:N_C1] = V_C1 * rho
+    snapshot.particles.mass[:] = mass
+    diameter = np.full(N_total, 2.0*R_S)
+    diameter[:N_C1] = 2.0*R_C1
+    snapshot.particles.diameter[:] = diameter
+
+    pos_arr = np.random.uniform(-0.5*L_X, 0.5*L_X, (N_total,3))
+    if N_C1 > 0:
+      # colloids on a cubic lattice
+      n_side = int(math.ceil(N_C1 ** (1./3.)))
+      a = L_X / n_side
+      grid = np.indices((n_side,n_side,n_side)).reshape(3,-1).T[:N_C1]
+      pos_arr[:N_C1] = -0.5*L_X + a*(grid + 0.5)
+    snapshot.particles.position[:] = pos_arr
+  return snapshot
+
+
+def make_dpd_morse(nl, bond_calc=False, cell_list=False, overlap_comm=False):
+  """DPDMorse pair force with the parameters of the DPD sim-templates"""
+  r_sc1_cut = (r_c**3 + R_C1**3) ** (1/3)
+  morse = hoomd.md.pair.DPDMorse(nlist=nl, kT=KT, default_r_cut=1.0 * r_c, bond_calc=bond_calc,
+    cell_list=cell_list, overlap_comm=overlap_comm)
+  morse.params[('A','A')] = dict(A0=25.0 * KT / r_c, gamma=gamma,
+    D0=0, alpha=kappa, r0=r0, eta=0.0, f_contact=0.0,
+    a1=0.0, a2=0.0, rcut=r_c)
+  morse.r_cut[('A','A')] = r_c
+  morse.params[('A','B')] = dict(A0=25.0 * KT / r_sc1_cut, gamma=gamma,
+    D0=0, alpha=kappa, r0=r0, eta=0.0, f_contact=0.0,
+    a1=0.0, a2=R_C1, rcut=r_sc1_cut - (0.0 + R_C1))
+  morse.r_cut[('A','B')] = r_sc1_cut
+  morse.params[('B','B')] = dict(A0=0.0, gamma=gamma,
+    D0=D0, alpha=kappa, r0=r0, eta=eta0, f_contact=f_contact,
+    a1=R_C1, a2=R_C1, rcut=r_c)
+  morse.r_cut[('B','B')] = (r_c + R_C1 + R_C1)
+  return morse
+
+
+def make_simulation(snapshot, forces, device=None, seed_value=42):
+  """NVE DPD simulation (the DPD thermostat is in the pair force)"""
+  if device is None:
+    device = hoomd.device.CPU()
+  sim = hoomd.Simulation(device=device, seed=seed_value)
+  sim.create_state_from_snapshot(snapshot)
+  nve = hoomd.md.methods.ConstantVolume(filter=hoomd.filter.All(), thermostat=None)
+  sim.operations.integrator = hoomd.md.Integrator(dt=dt_Integration, forces=forces, methods=[nve])
+  return sim
+
+
+def time_run(sim, n_warmup, n_steps):
+  """Run n_warmup steps, then time n_steps; returns (TPS, seconds)"""
+  sim.run(n_warmup)
+  t0 = time.perf_counter()
+  sim.run(n_steps)
+  elapsed = time.perf_counter() - t0
+  return n_steps / elapsed, elapsed
+
+
+def report(device, label, values):
+  """Print one benchmark result line on rank 0"""
+  if device.communicator.rank == 0:
+    print(label + ": " + ", ".join(k + " = " + str(v) for k, v in values.items()), flush=True)